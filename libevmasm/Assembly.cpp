@@ -28,12 +28,18 @@
 #include <libevmasm/Inliner.h>
 #include <libevmasm/JumpdestRemover.h>
 #include <libevmasm/BlockDeduplicator.h>
+#include <libevmasm/BlockLayout.h>
 #include <libevmasm/ConstantOptimiser.h>
+#include <libevmasm/FunctionInliner.h>
 #include <libevmasm/GasMeter.h>
+#include <libevmasm/Superoptimiser.h>
 
 #include <liblangutil/CharStream.h>
 #include <liblangutil/Exceptions.h>
 
+#include <libsolutil/Profiler.h>
+#include <libsolutil/ThreadPool.h>
+
 #include <json/json.h>
 
 #include <range/v3/algorithm/any_of.hpp>
@@ -65,7 +71,7 @@ unsigned Assembly::codeSize(unsigned subTagSize) const
 	{
 		size_t ret = 1;
 		for (auto const& i: m_data)
-			ret += i.second.size();
+			ret += i.second->size();
 
 		for (AssemblyItem const& i: m_items)
 			ret += i.bytesRequired(tagSize, Precision::Approximate);
@@ -198,7 +204,7 @@ void Assembly::assemblyStream(
 		_out << _prefix << "stop" << endl;
 		for (auto const& i: m_data)
 			if (u256(i.first) >= m_subs.size())
-				_out << _prefix << "data_" << toHex(u256(i.first)) << " " << util::toHex(i.second) << endl;
+				_out << _prefix << "data_" << toHex(u256(i.first)) << " " << util::toHex(*i.second) << endl;
 
 		for (size_t i = 0; i < m_subs.size(); ++i)
 		{
@@ -346,7 +352,7 @@ Json::Value Assembly::assemblyJSON(map<string, unsigned> const& _sourceIndices)
 		Json::Value& data = root[".data"];
 		for (auto const& i: m_data)
 			if (u256(i.first) >= m_subs.size())
-				data[toStringInHex((u256)i.first)] = util::toHex(i.second);
+				data[toStringInHex((u256)i.first)] = util::toHex(*i.second);
 
 		for (size_t i = 0; i < m_subs.size(); ++i)
 		{
@@ -419,6 +425,7 @@ Assembly& Assembly::optimise(bool _enable, EVMVersion _evmVersion, bool _isCreat
 
 Assembly& Assembly::optimise(OptimiserSettings const& _settings)
 {
+	util::Profiler::Scope profilerScope{"EVM assembly optimiser"};
 	optimiseInternal(_settings, {});
 	return *this;
 }
@@ -432,16 +439,26 @@ map<u256, u256> const& Assembly::optimiseInternal(
 		return *m_tagReplacements;
 
 	// Run optimisation for sub-assemblies.
+	OptimiserSettings subSettings = _settings;
+	// Disable creation mode for sub-assemblies.
+	subSettings.isCreation = false;
+	if (_settings.parallelism > 1 && m_subs.size() > 1 && subsOptimisableIndependently())
+	{
+		// The sub-assemblies of the subs are optimised on the same thread.
+		subSettings.parallelism = 1;
+		// Rethrows the exception of the first failing sub-assembly.
+		parallelFor(m_subs.size(), _settings.parallelism, [&](size_t _subId) {
+			m_subs[_subId]->optimiseInternal(subSettings, JumpdestRemover::referencedTags(m_items, _subId));
+		});
+	}
 	for (size_t subId = 0; subId < m_subs.size(); ++subId)
 	{
-		OptimiserSettings settings = _settings;
-		// Disable creation mode for sub-assemblies.
-		settings.isCreation = false;
+		// Returns the cached result if the sub-assembly was already optimised above.
 		map<u256, u256> const& subTagReplacements = m_subs[subId]->optimiseInternal(
-			settings,
+			subSettings,
 			JumpdestRemover::referencedTags(m_items, subId)
 		);
-		// Apply the replacements (can be empty).
+		// Apply the replacements (can be empty) in the order of the sub-assemblies.
 		BlockDeduplicator::applyTagReplacement(m_items, subTagReplacements, subId);
 	}
 
@@ -457,9 +474,19 @@ map<u256, u256> const& Assembly::optimiseInternal(
 				_tagsReferencedFromOutside,
 				_settings.expectedExecutionsPerDeployment,
 				_settings.isCreation,
-				_settings.evmVersion
+				_settings.evmVersion,
+				_settings.isCreation ? nullptr : _settings.executionProfile.get()
 			}.optimise();
 
+		if (_settings.runFunctionInliner && FunctionInliner{m_items, _tagsReferencedFromOutside}.optimise())
+			count++;
+
+		if (
+			_settings.runBlockLayout &&
+			BlockLayout{*this, _settings.isCreation ? nullptr : _settings.executionProfile.get()}.optimise()
+		)
+			count++;
+
 		if (_settings.runJumpdestRemover)
 		{
 			JumpdestRemover jumpdestOpt{m_items};
@@ -477,6 +504,9 @@ map<u256, u256> const& Assembly::optimiseInternal(
 			}
 		}
 
+		if (_settings.runSuperoptimiser && Superoptimiser{m_items}.optimise())
+			count++;
+
 		// This only modifies PushTags, we have to run again to actually remove code.
 		if (_settings.runDeduplicate)
 		{
@@ -560,13 +590,41 @@ map<u256, u256> const& Assembly::optimiseInternal(
 			_settings.isCreation,
 			_settings.isCreation ? 1 : _settings.expectedExecutionsPerDeployment,
 			_settings.evmVersion,
-			*this
+			*this,
+			_settings.isCreation ? nullptr : _settings.executionProfile.get()
 		);
 
 	m_tagReplacements = move(tagReplacements);
 	return *m_tagReplacements;
 }
 
+bool Assembly::subsOptimisableIndependently() const
+{
+	map<Assembly const*, size_t> reachedFrom;
+	for (size_t subId = 0; subId < m_subs.size(); ++subId)
+	{
+		vector<Assembly const*> toVisit{m_subs[subId].get()};
+		while (!toVisit.empty())
+		{
+			Assembly const* assembly = toVisit.back();
+			toVisit.pop_back();
+			// Optimised assemblies are not modified again.
+			if (assembly->m_tagReplacements)
+				continue;
+			auto [it, inserted] = reachedFrom.emplace(assembly, subId);
+			if (!inserted)
+			{
+				if (it->second != subId)
+					return false;
+				continue;
+			}
+			for (auto const& sub: assembly->m_subs)
+				toVisit.push_back(sub.get());
+		}
+	}
+	return true;
+}
+
 LinkerObject const& Assembly::assemble() const
 {
 	assertThrow(!m_invalid, AssemblyException, "Attempted to assemble invalid Assembly object.");
@@ -617,7 +675,10 @@ LinkerObject const& Assembly::assemble() const
 
 	unsigned bytesRequiredForCode = codeSize(static_cast<unsigned>(subTagSize));
 	m_tagPositionsInBytecode = vector<size_t>(m_usedTags, numeric_limits<size_t>::max());
-	map<size_t, pair<size_t, size_t>> tagRef;
+	/// Index of the item of each tag, used for the debug data of named tags.
+	vector<size_t> tagItemIndices(m_usedTags, numeric_limits<size_t>::max());
+	/// Code locations of the pushed tags in increasing order, together with the sub assembly and id of the tag.
+	vector<pair<size_t, pair<size_t, size_t>>> tagRef;
 	multimap<h256, unsigned> dataRef;
 	multimap<size_t, size_t> subRef;
 	vector<unsigned> sizeRef; ///< Pointers to code locations where the size of the program is inserted
@@ -632,7 +693,7 @@ LinkerObject const& Assembly::assemble() const
 	uint8_t dataRefPush = static_cast<uint8_t>(pushInstruction(bytesPerDataRef));
 	ret.bytecode.reserve(bytesRequiredIncludingData);
 
-	for (AssemblyItem const& i: m_items)
+	for (auto&& [itemIndex, i]: m_items | ranges::views::enumerate)
 	{
 		// store position of the invalid jump destination
 		if (i.type() != Tag && m_tagPositionsInBytecode[0] == numeric_limits<size_t>::max())
@@ -655,7 +716,7 @@ LinkerObject const& Assembly::assemble() const
 		case PushTag:
 		{
 			ret.bytecode.push_back(tagPush);
-			tagRef[ret.bytecode.size()] = i.splitForeignPushTag();
+			tagRef.emplace_back(ret.bytecode.size(), i.splitForeignPushTag());
 			ret.bytecode.resize(ret.bytecode.size() + bytesPerTag);
 			break;
 		}
@@ -744,6 +805,7 @@ LinkerObject const& Assembly::assemble() const
 			assertThrow(ret.bytecode.size() < 0xffffffffL, AssemblyException, "Tag too large.");
 			assertThrow(m_tagPositionsInBytecode[tagId] == numeric_limits<size_t>::max(), AssemblyException, "Duplicate tag position.");
 			m_tagPositionsInBytecode[tagId] = ret.bytecode.size();
+			tagItemIndices[tagId] = static_cast<size_t>(itemIndex);
 			ret.bytecode.push_back(static_cast<uint8_t>(Instruction::JUMPDEST));
 			break;
 		}
@@ -791,16 +853,10 @@ LinkerObject const& Assembly::assemble() const
 	for (auto const& [name, tagInfo]: m_namedTags)
 	{
 		size_t position = m_tagPositionsInBytecode.at(tagInfo.id);
-		optional<size_t> tagIndex;
-		for (auto&& [index, item]: m_items | ranges::views::enumerate)
-			if (item.type() == Tag && static_cast<size_t>(item.data()) == tagInfo.id)
-			{
-				tagIndex = index;
-				break;
-			}
+		size_t tagIndex = tagItemIndices.at(tagInfo.id);
 		ret.functionDebugData[name] = {
 			position == numeric_limits<size_t>::max() ? nullopt : optional<size_t>{position},
-			tagIndex,
+			tagIndex == numeric_limits<size_t>::max() ? nullopt : optional<size_t>{tagIndex},
 			tagInfo.sourceID,
 			tagInfo.params,
 			tagInfo.returns
@@ -817,7 +873,7 @@ LinkerObject const& Assembly::assemble() const
 			bytesRef r(ret.bytecode.data() + ref->second, bytesPerDataRef);
 			toBigEndian(ret.bytecode.size(), r);
 		}
-		ret.bytecode += dataItem.second;
+		ret.bytecode += *dataItem.second;
 	}
 
 	ret.bytecode += m_auxiliaryData;
@@ -23,6 +23,7 @@
 #include <libevmasm/AssemblyItem.h>
 #include <libevmasm/LinkerObject.h>
 #include <libevmasm/Exceptions.h>
+#include <libevmasm/ExecutionProfile.h>
 
 #include <liblangutil/DebugInfoSelection.h>
 #include <liblangutil/EVMVersion.h>
@@ -54,8 +55,10 @@ public:
 	AssemblyItem newPushTag() { assertThrow(m_usedTags < 0xffffffff, AssemblyException, ""); return AssemblyItem(PushTag, m_usedTags++); }
 	/// Returns a tag identified by the given name. Creates it if it does not yet exist.
 	AssemblyItem namedTag(std::string const& _name, size_t _params, size_t _returns, std::optional<uint64_t> _sourceID);
-	AssemblyItem newData(bytes const& _data) { util::h256 h(util::keccak256(util::asString(_data))); m_data[h] = _data; return AssemblyItem(PushData, h); }
-	bytes const& data(util::h256 const& _i) const { return m_data.at(_i); }
+	AssemblyItem newData(bytes const& _data) { return newData(std::make_shared<bytes const>(_data), util::keccak256(_data)); }
+	/// Adds @a _data, whose hash is @a _hash, without copying it.
+	AssemblyItem newData(std::shared_ptr<bytes const> _data, util::h256 const& _hash) { m_data[_hash] = std::move(_data); return AssemblyItem(PushData, _hash); }
+	bytes const& data(util::h256 const& _i) const { return *m_data.at(_i); }
 	AssemblyItem newSub(AssemblyPointer const& _sub) { m_subs.push_back(_sub); return AssemblyItem(PushSub, m_subs.size() - 1); }
 	Assembly const& sub(size_t _sub) const { return *m_subs.at(_sub); }
 	Assembly& sub(size_t _sub) { return *m_subs.at(_sub); }
@@ -124,10 +127,18 @@ public:
 		bool runDeduplicate = false;
 		bool runCSE = false;
 		bool runConstantOptimiser = false;
+		bool runSuperoptimiser = false;
+		bool runBlockLayout = false;
+		bool runFunctionInliner = false;
 		langutil::EVMVersion evmVersion;
 		/// This specifies an estimate on how often each opcode in this assembly will be executed,
 		/// i.e. use a small value to optimise for size and a large value to optimise for runtime gas usage.
 		size_t expectedExecutionsPerDeployment = frontend::OptimiserSettings{}.expectedExecutionsPerDeployment;
+		/// Maximum number of threads used to optimise independent sub-assemblies.
+		size_t parallelism = 1;
+		/// Execution counts that replace @a expectedExecutionsPerDeployment for the runtime code
+		/// generated from the profiled source ranges.
+		std::shared_ptr<ExecutionProfile const> executionProfile;
 	};
 
 	/// Modify and return the current assembly such that creation and execution gas usage
@@ -172,6 +183,10 @@ protected:
 
 	unsigned codeSize(unsigned subTagSize) const;
 
+	/// @returns true if none of the sub-assemblies that still need to be optimised
+	/// is reachable from more than one of the direct sub-assemblies.
+	bool subsOptimisableIndependently() const;
+
 private:
 	static Json::Value createJsonValue(
 		std::string _name,
@@ -201,7 +216,7 @@ protected:
 
 	std::map<std::string, NamedTagInfo> m_namedTags;
 	AssemblyItems m_items;
-	std::map<util::h256, bytes> m_data;
+	std::map<util::h256, std::shared_ptr<bytes const>> m_data;
 	/// Data that is appended to the very end of the contract.
 	bytes m_auxiliaryData;
 	std::vector<std::shared_ptr<Assembly>> m_subs;
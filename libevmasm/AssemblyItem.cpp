@@ -369,6 +369,8 @@ std::string AssemblyItem::computeSourceMapping(
 	int prevSourceIndex = -1;
 	int prevModifierDepth = -1;
 	char prevJump = 0;
+	// Consecutive items mostly share the source name, so its index is only looked up when it changes.
+	string const* prevSourceName = nullptr;
 
 	for (auto const& item: _items)
 	{
@@ -377,10 +379,13 @@ std::string AssemblyItem::computeSourceMapping(
 
 		SourceLocation const& location = item.location();
 		int length = location.start != -1 && location.end != -1 ? location.end - location.start : -1;
-		int sourceIndex =
-			(location.sourceName && _sourceIndicesMap.count(*location.sourceName)) ?
-			static_cast<int>(_sourceIndicesMap.at(*location.sourceName)) :
-			-1;
+		int sourceIndex = prevSourceIndex;
+		if (location.sourceName.get() != prevSourceName)
+		{
+			auto it = location.sourceName ? _sourceIndicesMap.find(*location.sourceName) : _sourceIndicesMap.end();
+			sourceIndex = it != _sourceIndicesMap.end() ? static_cast<int>(it->second) : -1;
+			prevSourceName = location.sourceName.get();
+		}
 		char jump = '-';
 		if (item.getJumpType() == evmasm::AssemblyItem::JumpType::IntoFunction)
 			jump = 'i';
@@ -27,18 +27,49 @@
 #include <libevmasm/AssemblyItem.h>
 #include <libevmasm/SemanticInformation.h>
 
-#include <functional>
-#include <set>
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
 
 using namespace std;
 using namespace solidity;
 using namespace solidity::evmasm;
 
 
+namespace
+{
+
+uint64_t constexpr fnvPrime = 1099511628211u;
+uint64_t constexpr fnvEmptyHash = 14695981039346656037u;
+
+void hashCombine(uint64_t& _hash, uint64_t _value)
+{
+	for (size_t i = 0; i < 8; ++i)
+	{
+		_hash *= fnvPrime;
+		_hash ^= (_value >> (8 * i)) & 0xFF;
+	}
+}
+
+/// @returns a hash of @a _item that is compatible with AssemblyItem::operator==.
+uint64_t itemHash(AssemblyItem const& _item)
+{
+	uint64_t hash = fnvEmptyHash;
+	hashCombine(hash, static_cast<uint64_t>(_item.type()));
+	if (_item.type() == Operation)
+		hashCombine(hash, static_cast<uint64_t>(_item.instruction()));
+	else if (_item.type() != VerbatimBytecode)
+		hashCombine(hash, static_cast<uint64_t>(_item.data() & numeric_limits<uint64_t>::max()));
+	return hash;
+}
+
+}
+
 bool BlockDeduplicator::deduplicate()
 {
-	// Compares indices based on the suffix that starts there, ignoring tags and stopping at
-	// opcodes that stop the control flow.
+	// Compares blocks based on the suffix that starts at their tag, ignoring tags and stopping at
+	// opcodes that stop the control flow. Blocks are bucketed by a hash of this suffix, so only
+	// blocks with equal hashes are compared item by item.
 
 	// Virtual tag that signifies "the current block" and which is used to optimise loops.
 	// We abort if this virtual tag actually exists.
@@ -49,52 +80,94 @@ bool BlockDeduplicator::deduplicate()
 	)
 		return false;
 
-	function<bool(size_t, size_t)> comparator = [&](size_t _i, size_t _j)
+	struct Block
 	{
-		if (_i == _j)
-			return false;
-
-		// To compare recursive loops, we have to already unify PushTag opcodes of the
-		// block's own tag.
-		AssemblyItem pushFirstTag{pushSelf};
-		AssemblyItem pushSecondTag{pushSelf};
-
-		if (_i < m_items.size() && m_items.at(_i).type() == Tag)
-			pushFirstTag = m_items.at(_i).pushTag();
-		if (_j < m_items.size() && m_items.at(_j).type() == Tag)
-			pushSecondTag = m_items.at(_j).pushTag();
-
-		using diff_type = BlockIterator::difference_type;
-		BlockIterator first{m_items.begin() + diff_type(_i), m_items.end(), &pushFirstTag, &pushSelf};
-		BlockIterator second{m_items.begin() + diff_type(_j), m_items.end(), &pushSecondTag, &pushSelf};
-		BlockIterator end{m_items.end(), m_items.end()};
-
-		if (first != end && (*first).type() == Tag)
-			++first;
-		if (second != end && (*second).type() == Tag)
-			++second;
-
-		return std::lexicographical_compare(first, end, second, end);
+		/// Position of the tag of the block.
+		size_t begin;
+		/// Position after the item that stops the control flow.
+		size_t end;
+		uint64_t hash = 0;
+		bool hashValid = false;
+	};
+	vector<Block> blocks;
+	for (size_t i = 0; i < m_items.size(); ++i)
+		if (m_items[i].type() == Tag)
+		{
+			size_t blockEnd = i + 1;
+			while (blockEnd < m_items.size())
+			{
+				AssemblyItem const& item = m_items[blockEnd++];
+				if (SemanticInformation::altersControlFlow(item) && item != AssemblyItem{Instruction::JUMPI})
+					break;
+			}
+			blocks.push_back({i, blockEnd});
+		}
+
+	// To compare recursive loops, we have to already unify PushTag opcodes of the
+	// block's own tag.
+	auto const itemInBlock = [&](Block const& _block, size_t _position) -> AssemblyItem const& {
+		AssemblyItem const& item = m_items[_position];
+		if (item.type() == PushTag && item == m_items[_block.begin].pushTag())
+			return pushSelf;
+		return item;
+	};
+	auto const hashBlock = [&](Block const& _block) {
+		uint64_t hash = fnvEmptyHash;
+		for (size_t i = _block.begin + 1; i < _block.end; ++i)
+			if (m_items[i].type() != Tag)
+				hashCombine(hash, itemHash(itemInBlock(_block, i)));
+		return hash;
+	};
+	auto const equalBlocks = [&](Block const& _first, Block const& _second) {
+		size_t i = _first.begin + 1;
+		size_t j = _second.begin + 1;
+		while (true)
+		{
+			while (i < _first.end && m_items[i].type() == Tag)
+				++i;
+			while (j < _second.end && m_items[j].type() == Tag)
+				++j;
+			if (i == _first.end || j == _second.end)
+				return i == _first.end && j == _second.end;
+			if (itemInBlock(_first, i) != itemInBlock(_second, j))
+				return false;
+			++i;
+			++j;
+		}
 	};
 
 	size_t iterations = 0;
 	for (; ; ++iterations)
 	{
-		//@todo this should probably be optimized.
-		set<size_t, function<bool(size_t, size_t)>> blocksSeen(comparator);
-		for (size_t i = 0; i < m_items.size(); ++i)
+		// Blocks with the same hash that are not equal to any earlier block.
+		unordered_map<uint64_t, vector<Block const*>> blocksSeen;
+		for (Block& block: blocks)
 		{
-			if (m_items.at(i).type() != Tag)
-				continue;
-			auto it = blocksSeen.find(i);
-			if (it == blocksSeen.end())
-				blocksSeen.insert(i);
+			if (!block.hashValid)
+			{
+				block.hash = hashBlock(block);
+				block.hashValid = true;
+			}
+			vector<Block const*>& candidates = blocksSeen[block.hash];
+			auto it = find_if(candidates.begin(), candidates.end(), [&](Block const* _candidate) {
+				return equalBlocks(*_candidate, block);
+			});
+			if (it == candidates.end())
+				candidates.push_back(&block);
 			else
-				m_replacedTags[m_items.at(i).data()] = m_items.at(*it).data();
+				m_replacedTags[m_items.at(block.begin).data()] = m_items.at((*it)->begin).data();
 		}
 
-		if (!applyTagReplacement(m_items, m_replacedTags))
+		vector<size_t> replacedItems;
+		if (!applyTagReplacement(m_items, m_replacedTags, size_t(-1), &replacedItems))
 			break;
+		// Only the blocks containing a replaced tag have to be hashed again.
+		for (Block& block: blocks)
+		{
+			auto replaced = lower_bound(replacedItems.begin(), replacedItems.end(), block.begin + 1);
+			if (replaced != replacedItems.end() && *replaced < block.end)
+				block.hashValid = false;
+		}
 	}
 	return iterations > 0;
 }
@@ -102,12 +175,13 @@ bool BlockDeduplicator::deduplicate()
 bool BlockDeduplicator::applyTagReplacement(
 	AssemblyItems& _items,
 	map<u256, u256> const& _replacements,
-	size_t _subId
+	size_t _subId,
+	vector<size_t>* _replacedItems
 )
 {
 	bool changed = false;
-	for (AssemblyItem& item: _items)
-		if (item.type() == PushTag)
+	for (size_t position = 0; position < _items.size(); ++position)
+		if (AssemblyItem& item = _items[position]; item.type() == PushTag)
 		{
 			size_t subId;
 			size_t tagId;
@@ -123,30 +197,9 @@ bool BlockDeduplicator::applyTagReplacement(
 			{
 				changed = true;
 				item.setPushTagSubIdAndTag(subId, static_cast<size_t>(it->second));
+				if (_replacedItems)
+					_replacedItems->push_back(position);
 			}
 		}
 	return changed;
 }
-
-BlockDeduplicator::BlockIterator& BlockDeduplicator::BlockIterator::operator++()
-{
-	if (it == end)
-		return *this;
-	if (SemanticInformation::altersControlFlow(*it) && *it != AssemblyItem{Instruction::JUMPI})
-		it = end;
-	else
-	{
-		++it;
-		while (it != end && it->type() == Tag)
-			++it;
-	}
-	return *this;
-}
-
-AssemblyItem const& BlockDeduplicator::BlockIterator::operator*() const
-{
-	if (replaceItem && replaceWith && *it == *replaceItem)
-		return *replaceWith;
-	else
-		return *it;
-}
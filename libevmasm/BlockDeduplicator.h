@@ -55,42 +55,16 @@ public:
 	/// Replaces all PushTag operations insied @a _items that match a key in
 	/// @a _replacements by the respective value. If @a _subID is not -1, only
 	/// apply the replacement for foreign tags from this sub id.
+	/// If @a _replacedItems is given, the positions of the replaced items are appended to it.
 	/// @returns true iff a replacement was performed.
 	static bool applyTagReplacement(
 		AssemblyItems& _items,
 		std::map<u256, u256> const& _replacements,
-		size_t _subID = size_t(-1)
+		size_t _subID = size_t(-1),
+		std::vector<size_t>* _replacedItems = nullptr
 	);
 
 private:
-	/// Iterator that skips tags and skips to the end if (all branches of) the control
-	/// flow does not continue to the next instruction.
-	/// If the arguments are supplied to the constructor, replaces items on the fly.
-	struct BlockIterator
-	{
-	public:
-		using iterator_category = std::forward_iterator_tag;
-		using value_type = AssemblyItem const;
-		using difference_type = std::ptrdiff_t;
-		using pointer = AssemblyItem const*;
-		using reference = AssemblyItem const&;
-		BlockIterator(
-			AssemblyItems::const_iterator _it,
-			AssemblyItems::const_iterator _end,
-			AssemblyItem const* _replaceItem = nullptr,
-			AssemblyItem const* _replaceWith = nullptr
-		):
-			it(_it), end(_end), replaceItem(_replaceItem), replaceWith(_replaceWith) {}
-		BlockIterator& operator++();
-		bool operator==(BlockIterator const& _other) const { return it == _other.it; }
-		bool operator!=(BlockIterator const& _other) const { return it != _other.it; }
-		AssemblyItem const& operator*() const;
-		AssemblyItems::const_iterator it;
-		AssemblyItems::const_iterator end;
-		AssemblyItem const* replaceItem;
-		AssemblyItem const* replaceWith;
-	};
-
 	std::map<u256, u256> m_replacedTags;
 	AssemblyItems& m_items;
 };
@@ -0,0 +1,135 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Moves cold code behind conditional jumps to the end of the assembly.
+ */
+
+#include <libevmasm/BlockLayout.h>
+
+#include <libevmasm/Assembly.h>
+#include <libevmasm/AssemblyItem.h>
+#include <libevmasm/ExecutionProfile.h>
+#include <libevmasm/SemanticInformation.h>
+
+#include <libsolutil/CommonData.h>
+
+#include <limits>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::evmasm;
+
+namespace
+{
+
+/// @returns true if execution never continues with the item after @a _item.
+bool endsBlock(AssemblyItem const& _item)
+{
+	return
+		_item.type() == Operation &&
+		(_item.instruction() == Instruction::JUMP || SemanticInformation::terminatesControlFlow(_item.instruction()));
+}
+
+}
+
+bool BlockLayout::optimise()
+{
+	AssemblyItems& items = m_assembly.items();
+	// Code moved to the end must not be reached by falling off the original code.
+	if (items.empty() || !endsBlock(items.back()))
+		return false;
+
+	AssemblyItems hotItems;
+	AssemblyItems coldItems;
+	hotItems.reserve(items.size());
+	for (size_t pos = 0; pos < items.size(); ++pos)
+		if (optional<size_t> end = coldCodeEnd(items, pos))
+		{
+			AssemblyItem coldTag = m_assembly.newTag();
+			AssemblyItem pushColdTag = coldTag.pushTag();
+			pushColdTag.setLocation(items[pos + 1].location());
+			coldTag.setLocation(items[pos + 3].location());
+
+			hotItems.emplace_back(move(pushColdTag));
+			hotItems.emplace_back(items[pos + 2]);
+			coldItems.emplace_back(move(coldTag));
+			coldItems.insert(
+				coldItems.end(),
+				make_move_iterator(items.begin() + static_cast<ptrdiff_t>(pos + 3)),
+				make_move_iterator(items.begin() + static_cast<ptrdiff_t>(*end))
+			);
+			// Continue with the tag after the cold code.
+			pos = *end - 1;
+		}
+		else
+			hotItems.emplace_back(move(items[pos]));
+
+	if (coldItems.empty())
+	{
+		// Nothing was matched, so all items were moved to hotItems in order.
+		items = move(hotItems);
+		return false;
+	}
+	hotItems += move(coldItems);
+	items = move(hotItems);
+	return true;
+}
+
+optional<size_t> BlockLayout::coldCodeEnd(AssemblyItems const& _items, size_t _pos) const
+{
+	if (
+		_pos + 4 >= _items.size() ||
+		_items[_pos] != Instruction::ISZERO ||
+		_items[_pos + 1].type() != PushTag ||
+		_items[_pos + 1].splitForeignPushTag().first != numeric_limits<size_t>::max() ||
+		_items[_pos + 2] != Instruction::JUMPI
+	)
+		return nullopt;
+
+	AssemblyItem const target = _items[_pos + 1].tag();
+	// The cold code is a single block: it may not be entered other than through the jump.
+	for (size_t end = _pos + 3; end < _items.size(); ++end)
+		if (_items[end].type() == Tag)
+		{
+			if (
+				_items[end] == target &&
+				end > _pos + 3 &&
+				endsBlock(_items[end - 1]) &&
+				isCold(_items, _pos + 2, _pos + 3, end)
+			)
+				return end;
+			return nullopt;
+		}
+	return nullopt;
+}
+
+bool BlockLayout::isCold(AssemblyItems const& _items, size_t _jump, size_t _begin, size_t _end) const
+{
+	AssemblyItem const& last = _items[_end - 1];
+	if (last == Instruction::REVERT || last == Instruction::INVALID)
+		return true;
+
+	if (m_executionProfile)
+	{
+		optional<size_t> jumpExecutions = m_executionProfile->executions(_items[_jump].location());
+		optional<size_t> codeExecutions = m_executionProfile->executions(_items[_begin].location());
+		if (jumpExecutions && codeExecutions)
+			return *codeExecutions < *jumpExecutions;
+	}
+	return false;
+}
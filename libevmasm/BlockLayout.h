@@ -0,0 +1,64 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Moves cold code behind conditional jumps to the end of the assembly.
+ */
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+namespace solidity::evmasm
+{
+class Assembly;
+class AssemblyItem;
+using AssemblyItems = std::vector<AssemblyItem>;
+class ExecutionProfile;
+
+/**
+ * Optimisation stage that turns conditional jumps over cold code into fall-throughs.
+ *
+ * The pattern
+ *   ISZERO PUSH tag_after JUMPI <cold code> tag_after:
+ * where the cold code cannot fall through is replaced by
+ *   PUSH tag_cold JUMPI tag_after:
+ * and the cold code is moved to the end of the assembly behind tag_cold:.
+ * Code counts as cold if it ends in REVERT or INVALID, or if the execution profile
+ * reports fewer executions for it than for the conditional jump.
+ */
+class BlockLayout
+{
+public:
+	explicit BlockLayout(Assembly& _assembly, ExecutionProfile const* _executionProfile = nullptr):
+		m_assembly(_assembly), m_executionProfile(_executionProfile) {}
+
+	/// @returns true if something was changed
+	bool optimise();
+
+private:
+	/// @returns the position of the tag following the cold code, if the pattern starts at @a _pos.
+	std::optional<size_t> coldCodeEnd(AssemblyItems const& _items, size_t _pos) const;
+	/// @returns true if the code from @a _begin to @a _end after the jump at @a _jump is cold.
+	bool isCold(AssemblyItems const& _items, size_t _jump, size_t _begin, size_t _end) const;
+
+	Assembly& m_assembly;
+	ExecutionProfile const* m_executionProfile = nullptr;
+};
+
+}
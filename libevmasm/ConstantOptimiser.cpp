@@ -22,8 +22,13 @@
 
 #include <libevmasm/ConstantOptimiser.h>
 #include <libevmasm/Assembly.h>
+#include <libevmasm/ExecutionProfile.h>
 #include <libevmasm/GasMeter.h>
 
+#include <map>
+#include <mutex>
+#include <tuple>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::evmasm;
@@ -32,7 +37,8 @@ unsigned ConstantOptimisationMethod::optimiseConstants(
 	bool _isCreation,
 	size_t _runs,
 	langutil::EVMVersion _evmVersion,
-	Assembly& _assembly
+	Assembly& _assembly,
+	ExecutionProfile const* _executionProfile
 )
 {
 	// TODO: design the optimiser in a way this is not needed
@@ -40,9 +46,19 @@ unsigned ConstantOptimisationMethod::optimiseConstants(
 
 	unsigned optimisations = 0;
 	map<AssemblyItem, size_t> pushes;
+	map<u256, size_t> profiledRuns;
 	for (AssemblyItem const& item: _items)
 		if (item.type() == Push)
+		{
 			pushes[item]++;
+			if (_executionProfile)
+			{
+				size_t runs = _executionProfile->executions(item.location()).value_or(_runs);
+				auto [it, inserted] = profiledRuns.emplace(item.data(), runs);
+				if (!inserted)
+					it->second = max(it->second, runs);
+			}
+		}
 	map<u256, AssemblyItems> pendingReplacements;
 	for (auto it: pushes)
 	{
@@ -52,7 +68,7 @@ unsigned ConstantOptimisationMethod::optimiseConstants(
 		Params params;
 		params.multiplicity = it.second;
 		params.isCreation = _isCreation;
-		params.runs = _runs;
+		params.runs = _executionProfile ? profiledRuns.at(item.data()) : _runs;
 		params.evmVersion = _evmVersion;
 		LiteralMethod lit(params, item.data());
 		bigint literalGas = lit.gasNeeded();
@@ -187,6 +203,39 @@ AssemblyItems const& CodeCopyMethod::copyRoutine()
 	return copyRoutine;
 }
 
+ComputeMethod::ComputeMethod(Params const& _params, u256 const& _value):
+	ConstantOptimisationMethod(_params, _value)
+{
+	using Key = tuple<u256, bool, size_t, size_t, langutil::EVMVersion>;
+	// The representations do not depend on the assembly, so they are shared between all
+	// assemblies and threads. The cache is cleared once it gets too large.
+	static mutex cacheMutex;
+	static map<Key, AssemblyItems> cache;
+	size_t constexpr maxCacheSize = 0x10000;
+
+	Key key{m_value, m_params.isCreation, m_params.runs, m_params.multiplicity, m_params.evmVersion};
+	{
+		lock_guard<mutex> lock(cacheMutex);
+		if (auto it = cache.find(key); it != cache.end())
+		{
+			m_routine = it->second;
+			return;
+		}
+	}
+
+	m_routine = findRepresentation(m_value);
+	assertThrow(
+		checkRepresentation(m_value, m_routine),
+		OptimizerException,
+		"Invalid constant expression created."
+	);
+
+	lock_guard<mutex> lock(cacheMutex);
+	if (cache.size() >= maxCacheSize)
+		cache.clear();
+	cache.emplace(move(key), m_routine);
+}
+
 AssemblyItems ComputeMethod::findRepresentation(u256 const& _value)
 {
 	if (_value < 0x10000)
@@ -36,6 +36,7 @@ namespace solidity::evmasm
 class AssemblyItem;
 using AssemblyItems = std::vector<AssemblyItem>;
 class Assembly;
+class ExecutionProfile;
 
 /**
  * Abstract base class for one way to change how constants are represented in the code.
@@ -45,12 +46,15 @@ class ConstantOptimisationMethod
 public:
 	/// Tries to optimised how constants are represented in the source code and modifies
 	/// @a _assembly.
+	/// If @a _executionProfile is given, a constant is weighted with the highest execution count
+	/// among its occurrences, where occurrences outside of profiled ranges count as @a _runs.
 	/// @returns zero if no optimisations could be performed.
 	static unsigned optimiseConstants(
 		bool _isCreation,
 		size_t _runs,
 		langutil::EVMVersion _evmVersion,
-		Assembly& _assembly
+		Assembly& _assembly,
+		ExecutionProfile const* _executionProfile = nullptr
 	);
 
 protected:
@@ -131,16 +135,9 @@ protected:
 class ComputeMethod: public ConstantOptimisationMethod
 {
 public:
-	explicit ComputeMethod(Params const& _params, u256 const& _value):
-		ConstantOptimisationMethod(_params, _value)
-	{
-		m_routine = findRepresentation(m_value);
-		assertThrow(
-			checkRepresentation(m_value, m_routine),
-			OptimizerException,
-			"Invalid constant expression created."
-		);
-	}
+	/// Finds a representation of @a _value, or reuses the one found for the same value and
+	/// parameters before, in any assembly.
+	explicit ComputeMethod(Params const& _params, u256 const& _value);
 
 	bigint gasNeeded() const override { return gasNeeded(m_routine); }
 	AssemblyItems execute(Assembly&) const override
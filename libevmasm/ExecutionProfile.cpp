@@ -0,0 +1,82 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Execution counts of source ranges, used by the optimiser in place of the global
+ * estimate of executions per deployment.
+ */
+
+#include <libevmasm/ExecutionProfile.h>
+
+#include <libevmasm/Exceptions.h>
+
+#include <libsolutil/Assertions.h>
+#include <libsolutil/CommonData.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::evmasm;
+using namespace solidity::langutil;
+
+void ExecutionProfile::add(string const& _sourceName, int _start, int _end, size_t _count)
+{
+	assertThrow(0 <= _start && _start <= _end, OptimizerException, "Invalid profile range.");
+	m_ranges[_sourceName][{_start, _end}] = _count;
+}
+
+optional<size_t> ExecutionProfile::executions(SourceLocation const& _location) const
+{
+	if (!_location.hasText() || !_location.sourceName)
+		return nullopt;
+	auto const* ranges = util::valueOrNullptr(m_ranges, *_location.sourceName);
+	if (!ranges)
+		return nullopt;
+
+	optional<size_t> count;
+	int innermostLength = 0;
+	// Ranges are ordered by their start, so no range starting after the location can contain it.
+	for (auto const& [range, rangeCount]: *ranges)
+	{
+		auto const& [start, end] = range;
+		if (start > _location.start)
+			break;
+		if (_location.end <= end && (!count || end - start < innermostLength))
+		{
+			count = rangeCount;
+			innermostLength = end - start;
+		}
+	}
+	return count;
+}
+
+Json::Value ExecutionProfile::toJson() const
+{
+	Json::Value profile{Json::objectValue};
+	for (auto const& [sourceName, ranges]: m_ranges)
+	{
+		Json::Value& entries = profile[sourceName] = Json::arrayValue;
+		for (auto const& [range, count]: ranges)
+		{
+			Json::Value entry{Json::objectValue};
+			entry["start"] = range.first;
+			entry["length"] = range.second - range.first;
+			entry["count"] = Json::UInt64(count);
+			entries.append(move(entry));
+		}
+	}
+	return profile;
+}
@@ -0,0 +1,66 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Execution counts of source ranges, used by the optimiser in place of the global
+ * estimate of executions per deployment.
+ */
+#pragma once
+
+#include <liblangutil/SourceLocation.h>
+
+#include <json/json.h>
+
+#include <cstddef>
+#include <map>
+#include <optional>
+#include <string>
+#include <utility>
+
+namespace solidity::evmasm
+{
+
+/**
+ * Number of times the code generated for ranges of the source was executed, for example
+ * collected from transaction traces through the source mappings.
+ * The code of a range counts as executed as often as the innermost range containing it.
+ */
+class ExecutionProfile
+{
+public:
+	/// Records that the code of the range @a _start to @a _end in source @a _sourceName
+	/// was executed @a _count times. Replaces an earlier count of the same range.
+	void add(std::string const& _sourceName, int _start, int _end, size_t _count);
+
+	/// @returns the count of the innermost range that contains @a _location
+	/// or nullopt if there is no such range.
+	std::optional<size_t> executions(langutil::SourceLocation const& _location) const;
+
+	bool empty() const { return m_ranges.empty(); }
+
+	/// @returns the profile in the format of the ``executionProfile`` optimizer setting.
+	Json::Value toJson() const;
+
+	bool operator==(ExecutionProfile const& _other) const { return m_ranges == _other.m_ranges; }
+	bool operator!=(ExecutionProfile const& _other) const { return !(*this == _other); }
+
+private:
+	/// Source name -> (start, end) -> execution count.
+	std::map<std::string, std::map<std::pair<int, int>, size_t>> m_ranges;
+};
+
+}
@@ -55,6 +55,35 @@ bool ExpressionClasses::Expression::operator<(ExpressionClasses::Expression cons
 			std::tie(_other.item->data(), _other.arguments, _other.sequenceNumber);
 }
 
+bool ExpressionClasses::Expression::operator==(ExpressionClasses::Expression const& _other) const
+{
+	assertThrow(!!item && !!_other.item, OptimizerException, "");
+	if (item->type() != _other.item->type())
+		return false;
+	else if (item->type() == Operation && item->instruction() != _other.item->instruction())
+		return false;
+	else if (item->type() != Operation && item->data() != _other.item->data())
+		return false;
+	else
+		return arguments == _other.arguments && sequenceNumber == _other.sequenceNumber;
+}
+
+size_t ExpressionClasses::ExpressionHash::operator()(ExpressionClasses::Expression const& _expression) const
+{
+	assertThrow(!!_expression.item, OptimizerException, "");
+	AssemblyItem const& item = *_expression.item;
+	size_t hash = static_cast<size_t>(item.type());
+	auto const combine = [&](size_t _value) { hash ^= _value + 0x9e3779b9 + (hash << 6) + (hash >> 2); };
+	if (item.type() == Operation)
+		combine(static_cast<size_t>(item.instruction()));
+	else
+		combine(static_cast<size_t>(item.data() & numeric_limits<size_t>::max()));
+	for (Id argument: _expression.arguments)
+		combine(argument);
+	combine(_expression.sequenceNumber);
+	return hash;
+}
+
 ExpressionClasses::Id ExpressionClasses::find(
 	AssemblyItem const& _item,
 	Ids const& _arguments,
@@ -183,7 +212,8 @@ string ExpressionClasses::fullDAGToString(ExpressionClasses::Id _id) const
 
 ExpressionClasses::Id ExpressionClasses::tryToSimplify(Expression const& _expr)
 {
-	static Rules rules;
+	// The rules store the state of the current match, so each thread needs its own copy.
+	static thread_local Rules rules;
 	assertThrow(rules.isInitialized(), OptimizerException, "Rule list not properly initialized.");
 
 	if (
@@ -0,0 +1,194 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Inlines functions with a single call site and removes unreachable code.
+ */
+
+#include <libevmasm/FunctionInliner.h>
+
+#include <libevmasm/AssemblyItem.h>
+#include <libevmasm/SemanticInformation.h>
+
+#include <libsolutil/CommonData.h>
+
+#include <limits>
+#include <map>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::evmasm;
+
+namespace
+{
+
+/// @returns the tag id, if @a _item is a PushTag into the current assembly, nullopt otherwise.
+optional<size_t> localPushTag(AssemblyItem const& _item)
+{
+	if (_item.type() != PushTag)
+		return nullopt;
+	auto [subId, tag] = _item.splitForeignPushTag();
+	if (subId != numeric_limits<size_t>::max())
+		return nullopt;
+	return tag;
+}
+
+}
+
+bool FunctionInliner::optimise()
+{
+	bool changed = removeUnreachableBlocks();
+	while (inlineSingleCallFunction())
+		changed = true;
+	return changed;
+}
+
+vector<FunctionInliner::Block> FunctionInliner::blocks() const
+{
+	vector<Block> result;
+	for (size_t i = 0; i < m_items.size(); ++i)
+	{
+		AssemblyItem const& item = m_items[i];
+		if (item.type() == Tag || result.empty())
+		{
+			if (!result.empty())
+				result.back().end = i;
+			Block& block = result.emplace_back();
+			block.begin = i;
+			if (item.type() == Tag)
+			{
+				auto [subId, tag] = item.splitForeignPushTag();
+				assertThrow(subId == numeric_limits<size_t>::max(), OptimizerException, "Sub-assembly tag used as label.");
+				block.tag = tag;
+			}
+		}
+		if (
+			item == Instruction::JUMP ||
+			(item.type() == Operation && SemanticInformation::terminatesControlFlow(item.instruction()))
+		)
+			result.back().fallsThrough = false;
+	}
+	if (!result.empty())
+		result.back().end = m_items.size();
+	return result;
+}
+
+bool FunctionInliner::removeUnreachableBlocks()
+{
+	vector<Block> const allBlocks = blocks();
+	map<size_t, size_t> blockByTag;
+	for (size_t i = 0; i < allBlocks.size(); ++i)
+		if (allBlocks[i].tag)
+			blockByTag[*allBlocks[i].tag] = i;
+
+	vector<bool> reachable(allBlocks.size(), false);
+	vector<size_t> toVisit;
+	if (!allBlocks.empty())
+		toVisit.push_back(0);
+	for (size_t tag: m_tagsReferencedFromOutside)
+		if (size_t const* block = util::valueOrNullptr(blockByTag, tag))
+			toVisit.push_back(*block);
+	while (!toVisit.empty())
+	{
+		size_t index = toVisit.back();
+		toVisit.pop_back();
+		if (reachable[index])
+			continue;
+		reachable[index] = true;
+		Block const& block = allBlocks[index];
+		for (size_t i = block.begin; i < block.end; ++i)
+			if (optional<size_t> tag = localPushTag(m_items[i]))
+				if (size_t const* target = util::valueOrNullptr(blockByTag, *tag))
+					toVisit.push_back(*target);
+		if (block.fallsThrough && index + 1 < allBlocks.size())
+			toVisit.push_back(index + 1);
+	}
+
+	if (find(reachable.begin(), reachable.end(), false) == reachable.end())
+		return false;
+	AssemblyItems newItems;
+	for (size_t i = 0; i < allBlocks.size(); ++i)
+		if (reachable[i])
+			newItems.insert(
+				newItems.end(),
+				m_items.begin() + static_cast<ptrdiff_t>(allBlocks[i].begin),
+				m_items.begin() + static_cast<ptrdiff_t>(allBlocks[i].end)
+			);
+	m_items = move(newItems);
+	return true;
+}
+
+bool FunctionInliner::inlineSingleCallFunction()
+{
+	vector<Block> const allBlocks = blocks();
+	map<size_t, size_t> blockByTag;
+	for (size_t i = 0; i < allBlocks.size(); ++i)
+		if (allBlocks[i].tag)
+			blockByTag[*allBlocks[i].tag] = i;
+	map<size_t, size_t> pushCount;
+	for (AssemblyItem const& item: m_items)
+		if (optional<size_t> tag = localPushTag(item))
+			++pushCount[*tag];
+
+	for (size_t call = 0; call + 1 < m_items.size(); ++call)
+	{
+		optional<size_t> tag = localPushTag(m_items[call]);
+		if (
+			!tag ||
+			m_items[call + 1] != Instruction::JUMP ||
+			m_items[call + 1].getJumpType() != AssemblyItem::JumpType::IntoFunction ||
+			pushCount.at(*tag) != 1 ||
+			m_tagsReferencedFromOutside.count(*tag)
+		)
+			continue;
+		size_t const* entry = util::valueOrNullptr(blockByTag, *tag);
+		// The function must not be entered by falling through into it.
+		if (!entry || *entry == 0 || allBlocks[*entry - 1].fallsThrough)
+			continue;
+		size_t last = *entry;
+		while (allBlocks[last].fallsThrough && last + 1 < allBlocks.size())
+			++last;
+		// Moving code that falls through to the end of the assembly would continue it after the call site.
+		if (allBlocks[last].fallsThrough)
+			continue;
+		size_t const begin = allBlocks[*entry].begin;
+		size_t const end = allBlocks[last].end;
+		if (begin <= call && call < end)
+			continue;
+
+		// The tag of the function is dropped, since its only reference is the call.
+		AssemblyItems newItems;
+		auto const items = m_items.begin();
+		if (call < begin)
+		{
+			newItems.insert(newItems.end(), items, items + static_cast<ptrdiff_t>(call));
+			newItems.insert(newItems.end(), items + static_cast<ptrdiff_t>(begin + 1), items + static_cast<ptrdiff_t>(end));
+			newItems.insert(newItems.end(), items + static_cast<ptrdiff_t>(call + 2), items + static_cast<ptrdiff_t>(begin));
+			newItems.insert(newItems.end(), items + static_cast<ptrdiff_t>(end), m_items.end());
+		}
+		else
+		{
+			newItems.insert(newItems.end(), items, items + static_cast<ptrdiff_t>(begin));
+			newItems.insert(newItems.end(), items + static_cast<ptrdiff_t>(end), items + static_cast<ptrdiff_t>(call));
+			newItems.insert(newItems.end(), items + static_cast<ptrdiff_t>(begin + 1), items + static_cast<ptrdiff_t>(end));
+			newItems.insert(newItems.end(), items + static_cast<ptrdiff_t>(call + 2), m_items.end());
+		}
+		m_items = move(newItems);
+		return true;
+	}
+	return false;
+}
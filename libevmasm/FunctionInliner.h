@@ -0,0 +1,78 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Inlines functions with a single call site and removes unreachable code.
+ */
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <set>
+#include <vector>
+
+namespace solidity::evmasm
+{
+class AssemblyItem;
+using AssemblyItems = std::vector<AssemblyItem>;
+
+/**
+ * Optimisation stage working on the whole assembly instead of single blocks.
+ *
+ * It first removes all blocks that cannot be reached from the start of the code or from a tag
+ * referenced from outside, following fall-throughs and the tags pushed by reachable code only.
+ * Unlike the removal of unreferenced tags, this also removes functions that are never called
+ * but contain loops or branches, whose tags are only pushed by the functions themselves.
+ *
+ * It then inlines every function with a single call site, i.e. whose tag is pushed only once,
+ * directly before a jump into the function. The blocks falling through from the function tag
+ * up to the first jump or terminating instruction are moved to the call site, replacing
+ * PUSH tag_f JUMP, so that the following steps can optimise the code around the former call
+ * as one block. Unlike the size and gas heuristics of the Inliner, which only inline single
+ * blocks, this is never more expensive, since the code is moved and not copied.
+ */
+class FunctionInliner
+{
+public:
+	FunctionInliner(AssemblyItems& _items, std::set<size_t> const& _tagsReferencedFromOutside):
+		m_items(_items), m_tagsReferencedFromOutside(_tagsReferencedFromOutside) {}
+
+	/// @returns true if something was changed
+	bool optimise();
+
+private:
+	/// Items from one tag to the next one.
+	struct Block
+	{
+		size_t begin = 0;
+		size_t end = 0;
+		/// The tag at the start of the block, nullopt for the code before the first tag.
+		std::optional<size_t> tag;
+		bool fallsThrough = true;
+	};
+
+	std::vector<Block> blocks() const;
+	bool removeUnreachableBlocks();
+	/// Inlines the first function with a single call site.
+	/// @returns false if there is no such function.
+	bool inlineSingleCallFunction();
+
+	AssemblyItems& m_items;
+	std::set<size_t> const& m_tagsReferencedFromOutside;
+};
+
+}
@@ -75,9 +75,6 @@ GasMeter::GasConsumption GasMeter::estimateMax(AssemblyItem const& _item, bool _
 				gas = GasCosts::totalSstoreSetGas(m_evmVersion);
 			break;
 		}
-		case Instruction::SLOAD:
-			gas = GasCosts::sloadGas(m_evmVersion);
-			break;
 		case Instruction::RETURN:
 		case Instruction::REVERT:
 			gas = runGas(_item.instruction());
@@ -110,12 +107,6 @@ GasMeter::GasConsumption GasMeter::estimateMax(AssemblyItem const& _item, bool _
 			gas += memoryGas(0, -2);
 			gas += wordGas(GasCosts::copyGas, m_state->relativeStackElement(-2));
 			break;
-		case Instruction::EXTCODESIZE:
-			gas = GasCosts::extCodeGas(m_evmVersion);
-			break;
-		case Instruction::EXTCODEHASH:
-			gas = GasCosts::balanceGas(m_evmVersion);
-			break;
 		case Instruction::EXTCODECOPY:
 			gas = GasCosts::extCodeGas(m_evmVersion);
 			gas += memoryGas(-1, -3);
@@ -191,17 +182,8 @@ GasMeter::GasConsumption GasMeter::estimateMax(AssemblyItem const& _item, bool _
 			else
 				gas += GasCosts::expByteGas(m_evmVersion) * 32;
 			break;
-		case Instruction::BALANCE:
-			gas = GasCosts::balanceGas(m_evmVersion);
-			break;
-		case Instruction::CHAINID:
-			gas = runGas(Instruction::CHAINID);
-			break;
-		case Instruction::SELFBALANCE:
-			gas = runGas(Instruction::SELFBALANCE);
-			break;
 		default:
-			gas = runGas(_item.instruction());
+			gas = runGas(_item.instruction(), m_evmVersion);
 			break;
 		}
 		break;
@@ -272,6 +254,45 @@ unsigned GasMeter::runGas(Instruction _instruction)
 	return 0;
 }
 
+unsigned GasMeter::runGas(Instruction _instruction, langutil::EVMVersion _evmVersion)
+{
+	switch (_instruction)
+	{
+	case Instruction::SLOAD:
+		return GasCosts::sloadGas(_evmVersion);
+	case Instruction::SSTORE:
+		return GasCosts::totalSstoreSetGas(_evmVersion);
+	case Instruction::BALANCE:
+	case Instruction::EXTCODEHASH:
+		return GasCosts::balanceGas(_evmVersion);
+	case Instruction::EXTCODESIZE:
+	case Instruction::EXTCODECOPY:
+		return GasCosts::extCodeGas(_evmVersion);
+	case Instruction::CALL:
+	case Instruction::CALLCODE:
+	case Instruction::DELEGATECALL:
+	case Instruction::STATICCALL:
+		return GasCosts::callGas(_evmVersion);
+	case Instruction::SELFDESTRUCT:
+		return GasCosts::selfdestructGas(_evmVersion);
+	case Instruction::CREATE:
+	case Instruction::CREATE2:
+		return GasCosts::createGas;
+	case Instruction::EXP:
+		return GasCosts::expGas;
+	case Instruction::KECCAK256:
+		return GasCosts::keccak256Gas;
+	case Instruction::LOG0:
+	case Instruction::LOG1:
+	case Instruction::LOG2:
+	case Instruction::LOG3:
+	case Instruction::LOG4:
+		return GasCosts::logGas + GasCosts::logTopicGas * getLogNumber(_instruction);
+	default:
+		return runGas(_instruction);
+	}
+}
+
 u256 GasMeter::dataGas(bytes const& _data, bool _inCreation, langutil::EVMVersion _evmVersion)
 {
 	bigint gas = 0;
@@ -222,6 +222,11 @@ public:
 	/// @returns gas costs for simple instructions with constant gas costs (that do not
 	/// change with EVM versions)
 	static unsigned runGas(Instruction _instruction);
+	/// @returns the gas costs of @a _instruction in @a _evmVersion, excluding the costs that depend
+	/// on its arguments like memory expansion, copied words or exponent bytes. Accounts and storage
+	/// slots are assumed to be accessed for the first time and storage slots to be set from zero.
+	/// Used by all gas estimates, so that they agree on the costs of instructions.
+	static unsigned runGas(Instruction _instruction, langutil::EVMVersion _evmVersion);
 
 	/// @returns the gas cost of the supplied data, depending whether it is in creation code, or not.
 	/// In case of @a _inCreation, the data is only sent as a transaction and is not stored, whereas
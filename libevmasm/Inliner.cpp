@@ -191,9 +191,14 @@ bool Inliner::shouldInlineFullFunctionBody(size_t _tag, ranges::span<AssemblyIte
 			m_evmVersion
 		);
 
+	size_t runs = m_runs;
+	if (m_executionProfile && !_block.empty())
+		if (optional<size_t> executions = m_executionProfile->executions(_block.front().location()))
+			runs = *executions;
+
 	// If the estimated runtime cost over the lifetime of the contract plus the deposit cost in the uninlined case
 	// exceed the inlined deposit costs, it is beneficial to inline.
-	if (bigint(m_runs) * uninlinedExecutionCost + uninlinedDepositCost > inlinedDepositCost)
+	if (bigint(runs) * uninlinedExecutionCost + uninlinedDepositCost > inlinedDepositCost)
 		return true;
 
 	return false;
@@ -42,13 +42,15 @@ public:
 		std::set<size_t> const& _tagsReferencedFromOutside,
 		size_t _runs,
 		bool _isCreation,
-		langutil::EVMVersion _evmVersion
+		langutil::EVMVersion _evmVersion,
+		ExecutionProfile const* _executionProfile = nullptr
 	):
 	m_items(_items),
 	m_tagsReferencedFromOutside(_tagsReferencedFromOutside),
 	m_runs(_runs),
 	m_isCreation(_isCreation),
-	m_evmVersion(_evmVersion)
+	m_evmVersion(_evmVersion),
+	m_executionProfile(_executionProfile)
 	{
 	}
 	virtual ~Inliner() = default;
@@ -79,6 +81,8 @@ private:
 	size_t const m_runs = Assembly::OptimiserSettings{}.expectedExecutionsPerDeployment;
 	bool const m_isCreation = false;
 	langutil::EVMVersion const m_evmVersion;
+	/// If set, the execution count of a function body replaces @a m_runs for that function.
+	ExecutionProfile const* m_executionProfile = nullptr;
 };
 
 }
@@ -96,15 +96,6 @@ struct SimplePeepholeOptimizerMethod
 	}
 };
 
-struct Identity: SimplePeepholeOptimizerMethod<Identity, 1>
-{
-	static bool applySimple(AssemblyItem const& _item, std::back_insert_iterator<AssemblyItems> _out)
-	{
-		*_out = _item;
-		return true;
-	}
-};
-
 struct PushPop: SimplePeepholeOptimizerMethod<PushPop, 2>
 {
 	static bool applySimple(AssemblyItem const& _push, AssemblyItem const& _pop, std::back_insert_iterator<AssemblyItems>)
@@ -367,16 +358,44 @@ struct UnreachableCode
 	}
 };
 
-void applyMethods(OptimiserState&)
+bool applyMethods(OptimiserState&)
 {
-	assertThrow(false, OptimizerException, "Peephole optimizer failed to apply identity.");
+	return false;
 }
 
 template <typename Method, typename... OtherMethods>
-void applyMethods(OptimiserState& _state, Method, OtherMethods... _other)
+bool applyMethods(OptimiserState& _state, Method, OtherMethods... _other)
+{
+	return Method::apply(_state) || applyMethods(_state, _other...);
+}
+
+/// Applies the first method that matches at the current position, only trying the methods
+/// that can match a window starting with the current item, in the same order as they are
+/// tried in general.
+/// @returns false if no method matches.
+bool applyMatchingMethods(OptimiserState& _state)
 {
-	if (!Method::apply(_state))
-		applyMethods(_state, _other...);
+	switch (_state.items[_state.i].type())
+	{
+	case Operation:
+		return applyMethods(
+			_state,
+			PushPop(), OpPop(), DoubleSwap(), CommutativeSwap(), SwapComparison(),
+			DupSwap(), IsZeroIsZeroJumpI(), UnreachableCode()
+		);
+	case Push:
+		return applyMethods(_state, PushPop(), DoublePush(), TagConjunctions(), TruthyAnd());
+	case PushTag:
+		return applyMethods(_state, PushPop(), JumpToNext(), TagConjunctions());
+	case PushSub:
+	case PushSubSize:
+	case PushProgramSize:
+	case PushData:
+	case PushLibraryAddress:
+		return applyMethods(_state, PushPop());
+	default:
+		return false;
+	}
 }
 
 size_t numberOfPops(AssemblyItems const& _items)
@@ -390,14 +409,18 @@ bool PeepholeOptimiser::optimise()
 {
 	// Avoid referencing immutables too early by using approx. counting in bytesRequired()
 	auto const approx = evmasm::Precision::Approximate;
+	m_optimisedItems.clear();
+	m_optimisedItems.reserve(m_items.size());
 	OptimiserState state {m_items, 0, std::back_inserter(m_optimisedItems)};
+	bool applied = false;
 	while (state.i < m_items.size())
-		applyMethods(
-			state,
-			PushPop(), OpPop(), DoublePush(), DoubleSwap(), CommutativeSwap(), SwapComparison(),
-			DupSwap(), IsZeroIsZeroJumpI(), JumpToNext(), UnreachableCode(),
-			TagConjunctions(), TruthyAnd(), Identity()
-		);
+		if (applyMatchingMethods(state))
+			applied = true;
+		else
+			*state.out = m_items[state.i++];
+	// The items are unchanged if no method matched.
+	if (!applied)
+		return false;
 	if (m_optimisedItems.size() < m_items.size() || (
 		m_optimisedItems.size() == m_items.size() && (
 			evmasm::bytesRequired(m_optimisedItems, 3, approx) < evmasm::bytesRequired(m_items, 3, approx) ||
@@ -0,0 +1,236 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Replaces short sequences of stack instructions by cheaper equivalent sequences
+ * found through an exhaustive search.
+ */
+
+#include <libevmasm/Superoptimiser.h>
+
+#include <libevmasm/AssemblyItem.h>
+#include <libevmasm/Exceptions.h>
+#include <libevmasm/GasMeter.h>
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::evmasm;
+
+namespace
+{
+
+bool isStackShuffle(AssemblyItem const& _item)
+{
+	return _item.type() == Operation && (
+		isSwapInstruction(_item.instruction()) ||
+		isDupInstruction(_item.instruction()) ||
+		_item.instruction() == Instruction::POP
+	);
+}
+
+/// Number of stack slots accessed by @a _instruction.
+size_t requiredDepth(Instruction _instruction)
+{
+	if (_instruction == Instruction::POP)
+		return 1;
+	else if (isDupInstruction(_instruction))
+		return getDupNumber(_instruction);
+	else
+		return getSwapNumber(_instruction) + 1;
+}
+
+/// Symbolic stack whose values are the positions they had before the window, the top is at the back.
+using Stack = vector<size_t>;
+
+/// Applies @a _instruction to @a _stack, which has to contain at least the accessed slots.
+void apply(Stack& _stack, Instruction _instruction)
+{
+	assertThrow(_stack.size() >= requiredDepth(_instruction), OptimizerException, "");
+	if (_instruction == Instruction::POP)
+		_stack.pop_back();
+	else if (isDupInstruction(_instruction))
+		_stack.push_back(_stack[_stack.size() - getDupNumber(_instruction)]);
+	else
+		swap(_stack.back(), _stack[_stack.size() - 1 - getSwapNumber(_instruction)]);
+}
+
+unsigned gas(vector<Instruction> const& _instructions)
+{
+	unsigned result = 0;
+	for (Instruction instruction: _instructions)
+		result += GasMeter::runGas(instruction);
+	return result;
+}
+
+optional<vector<Instruction>> searchStackShuffle(vector<Instruction> const& _window)
+{
+	// Determine the effect of the window on the slots it accesses.
+	Stack target;
+	size_t depth = 0;
+	for (Instruction instruction: _window)
+	{
+		while (target.size() < requiredDepth(instruction))
+			target.insert(target.begin(), depth++);
+		apply(target, instruction);
+	}
+	if (depth > Superoptimiser::maxStackDepth)
+		return nullopt;
+
+	Stack initial;
+	for (size_t i = depth; i > 0; --i)
+		initial.push_back(i - 1);
+	if (initial == target)
+		return vector<Instruction>{};
+
+	// Breadth-first search for the shortest sequences, preferring the cheapest one among them.
+	struct Node
+	{
+		size_t length;
+		unsigned gas;
+		size_t parent;
+		Instruction instruction;
+	};
+	vector<Node> nodes{{0, 0, 0, Instruction::STOP}};
+	map<Stack, size_t> nodeByStack{{initial, 0}};
+	vector<Stack const*> currentLevel{&nodeByStack.begin()->first};
+	size_t const maxStackSize = max(initial.size(), target.size()) + 1;
+	// Values that are no longer on the stack cannot be restored. Each DUP adds one copy of a value
+	// and each POP removes one, so the number of missing and excess copies bounds the length.
+	auto const canReach = [&](Stack const& _stack, size_t _remainingLength) {
+		size_t changesNeeded = 0;
+		for (size_t value = 0; value < depth; ++value)
+		{
+			size_t const available = static_cast<size_t>(count(_stack.begin(), _stack.end(), value));
+			size_t const needed = static_cast<size_t>(count(target.begin(), target.end(), value));
+			if (needed > 0 && available == 0)
+				return false;
+			changesNeeded += available > needed ? available - needed : needed - available;
+		}
+		return changesNeeded <= _remainingLength;
+	};
+	optional<size_t> found;
+	for (size_t length = 1; length < _window.size() && !found && !currentLevel.empty(); ++length)
+	{
+		vector<Stack const*> nextLevel;
+		for (Stack const* stack: currentLevel)
+		{
+			size_t const parent = nodeByStack.at(*stack);
+			vector<Instruction> candidates;
+			if (!stack->empty())
+				candidates.push_back(Instruction::POP);
+			for (size_t n = 1; n <= min<size_t>(stack->size(), 16); ++n)
+				if (stack->size() < maxStackSize)
+					candidates.push_back(dupInstruction(static_cast<unsigned>(n)));
+			for (size_t n = 1; n < min<size_t>(stack->size(), 17); ++n)
+				candidates.push_back(swapInstruction(static_cast<unsigned>(n)));
+
+			for (Instruction instruction: candidates)
+			{
+				Stack next = *stack;
+				apply(next, instruction);
+				if (!canReach(next, _window.size() - 1 - length))
+					continue;
+				unsigned const nextGas = nodes[parent].gas + GasMeter::runGas(instruction);
+				auto [it, inserted] = nodeByStack.emplace(move(next), nodes.size());
+				if (inserted)
+				{
+					nodes.push_back({length, nextGas, parent, instruction});
+					nextLevel.push_back(&it->first);
+				}
+				else if (nodes[it->second].length == length && nextGas < nodes[it->second].gas)
+					nodes[it->second] = {length, nextGas, parent, instruction};
+			}
+		}
+		if (auto it = nodeByStack.find(target); it != nodeByStack.end())
+			found = it->second;
+		currentLevel = move(nextLevel);
+	}
+	if (!found || nodes[*found].gas > gas(_window))
+		return nullopt;
+
+	vector<Instruction> result;
+	for (size_t node = *found; node != 0; node = nodes[node].parent)
+		result.push_back(nodes[node].instruction);
+	reverse(result.begin(), result.end());
+	return result;
+}
+
+}
+
+optional<vector<Instruction>> Superoptimiser::cheaperStackShuffle(vector<Instruction> const& _window)
+{
+	// The same windows occur in many places and assemblies, so the results are cached.
+	// The cache is cleared once it gets too large.
+	static mutex cacheMutex;
+	static map<vector<Instruction>, optional<vector<Instruction>>> cache;
+	size_t constexpr maxCacheSize = 0x10000;
+	{
+		lock_guard<mutex> lock(cacheMutex);
+		if (auto it = cache.find(_window); it != cache.end())
+			return it->second;
+	}
+
+	optional<vector<Instruction>> result = searchStackShuffle(_window);
+
+	lock_guard<mutex> lock(cacheMutex);
+	if (cache.size() >= maxCacheSize)
+		cache.clear();
+	cache.emplace(_window, result);
+	return result;
+}
+
+bool Superoptimiser::optimise()
+{
+	bool changed = false;
+	AssemblyItems optimisedItems;
+	optimisedItems.reserve(m_items.size());
+	for (size_t i = 0; i < m_items.size();)
+	{
+		size_t windowEnd = i;
+		while (windowEnd < m_items.size() && windowEnd - i < maxWindowSize && isStackShuffle(m_items[windowEnd]))
+			++windowEnd;
+
+		// Try the longest window first.
+		optional<vector<Instruction>> replacement;
+		for (; windowEnd >= i + 2; --windowEnd)
+		{
+			vector<Instruction> window;
+			for (size_t j = i; j < windowEnd; ++j)
+				window.push_back(m_items[j].instruction());
+			replacement = cheaperStackShuffle(window);
+			if (replacement)
+				break;
+		}
+
+		if (replacement)
+		{
+			for (Instruction instruction: *replacement)
+				optimisedItems.emplace_back(instruction, m_items[i].location());
+			i = windowEnd;
+			changed = true;
+		}
+		else
+			optimisedItems.push_back(m_items[i++]);
+	}
+	if (changed)
+		m_items = move(optimisedItems);
+	return changed;
+}
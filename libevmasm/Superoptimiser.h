@@ -0,0 +1,63 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Replaces short sequences of stack instructions by cheaper equivalent sequences
+ * found through an exhaustive search.
+ */
+#pragma once
+
+#include <libevmasm/Instruction.h>
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+namespace solidity::evmasm
+{
+class AssemblyItem;
+using AssemblyItems = std::vector<AssemblyItem>;
+
+/**
+ * Optimisation stage that searches for the cheapest sequence of SWAP, DUP and POP instructions
+ * that has the same effect on the stack as a window of up to @a maxWindowSize such instructions.
+ * The results of the search only depend on the instructions in the window and are shared by
+ * all assemblies.
+ */
+class Superoptimiser
+{
+public:
+	explicit Superoptimiser(AssemblyItems& _items): m_items(_items) {}
+
+	/// @returns true if something was changed
+	bool optimise();
+
+	/// @returns a sequence of stack instructions with the same effect as @a _window that
+	/// consists of fewer instructions and does not cost more gas, if one exists.
+	/// @a _window may only contain SWAP, DUP and POP instructions.
+	static std::optional<std::vector<Instruction>> cheaperStackShuffle(std::vector<Instruction> const& _window);
+
+	/// Maximum number of instructions replaced at once.
+	static size_t constexpr maxWindowSize = 6;
+	/// Maximum number of stack slots a window may access to be considered.
+	static size_t constexpr maxStackDepth = 5;
+
+private:
+	AssemblyItems& m_items;
+};
+
+}
@@ -51,6 +51,8 @@
 #include <liblangutil/CharStream.h>
 #include <liblangutil/Exceptions.h>
 
+#include <cstring>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::langutil;
@@ -82,19 +84,13 @@ char CharStream::setPosition(size_t _location)
 string CharStream::lineAtPosition(int _position) const
 {
 	// if _position points to \n, it returns the line before the \n
-	using size_type = string::size_type;
-	size_type searchStart = min<size_type>(m_source.size(), size_type(_position));
+	size_t searchStart = min<size_t>(m_source.size(), size_t(_position));
 	if (searchStart > 0)
 		searchStart--;
-	size_type lineStart = m_source.rfind('\n', searchStart);
-	if (lineStart == string::npos)
-		lineStart = 0;
-	else
-		lineStart++;
-	string line = m_source.substr(
-		lineStart,
-		min(m_source.find('\n', lineStart), m_source.size()) - lineStart
-	);
+	vector<size_t> const& starts = lineStarts();
+	auto const lineStart = prev(upper_bound(starts.begin(), starts.end(), searchStart + 1));
+	size_t const lineEnd = next(lineStart) != starts.end() ? *next(lineStart) - 1 : m_source.size();
+	string line = m_source.substr(*lineStart, lineEnd - *lineStart);
 	if (!line.empty() && line.back() == '\r')
 		line.pop_back();
 	return line;
@@ -102,19 +98,11 @@ string CharStream::lineAtPosition(int _position) const
 
 LineColumn CharStream::translatePositionToLineColumn(int _position) const
 {
-	using size_type = string::size_type;
-	using diff_type = string::difference_type;
-	size_type searchPosition = min<size_type>(m_source.size(), size_type(_position));
-	int lineNumber = static_cast<int>(count(m_source.begin(), m_source.begin() + diff_type(searchPosition), '\n'));
-	size_type lineStart;
-	if (searchPosition == 0)
-		lineStart = 0;
-	else
-	{
-		lineStart = m_source.rfind('\n', searchPosition - 1);
-		lineStart = lineStart == string::npos ? 0 : lineStart + 1;
-	}
-	return LineColumn{lineNumber, static_cast<int>(searchPosition - lineStart)};
+	size_t const searchPosition = min<size_t>(m_source.size(), size_t(_position));
+	vector<size_t> const& starts = lineStarts();
+	// The line is the last one that starts at or before the position.
+	auto const line = prev(upper_bound(starts.begin(), starts.end(), searchPosition));
+	return LineColumn{static_cast<int>(line - starts.begin()), static_cast<int>(searchPosition - *line)};
 }
 
 string_view CharStream::text(SourceLocation const& _location) const
@@ -147,7 +135,15 @@ string CharStream::singleLineSnippet(string const& _sourceCode, SourceLocation c
 
 optional<int> CharStream::translateLineColumnToPosition(LineColumn const& _lineColumn) const
 {
-	return translateLineColumnToPosition(m_source, _lineColumn);
+	vector<size_t> const& starts = lineStarts();
+	if (_lineColumn.line < 0 || static_cast<size_t>(_lineColumn.line) >= starts.size() || _lineColumn.column < 0)
+		return nullopt;
+
+	size_t const line = static_cast<size_t>(_lineColumn.line);
+	size_t const endOfLine = line + 1 < starts.size() ? starts[line + 1] - 1 : m_source.size();
+	if (starts[line] + static_cast<size_t>(_lineColumn.column) > endOfLine)
+		return nullopt;
+	return static_cast<int>(starts[line] + static_cast<size_t>(_lineColumn.column));
 }
 
 optional<int> CharStream::translateLineColumnToPosition(std::string const& _text, LineColumn const& _input)
@@ -173,3 +169,16 @@ optional<int> CharStream::translateLineColumnToPosition(std::string const& _text
 	return offset + static_cast<size_t>(_input.column);
 }
 
+vector<size_t> const& CharStream::lineStarts() const
+{
+	if (m_lineStarts.empty())
+	{
+		m_lineStarts.push_back(0);
+		// memchr() is usually much faster than comparing the characters one by one.
+		char const* const begin = m_source.data();
+		char const* const end = begin + m_source.size();
+		for (char const* it = begin; (it = static_cast<char const*>(memchr(it, '\n', size_t(end - it)))); )
+			m_lineStarts.push_back(size_t(++it - begin));
+	}
+	return m_lineStarts;
+}
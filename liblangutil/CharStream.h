@@ -55,6 +55,7 @@
 #include <string>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 namespace solidity::langutil
 {
@@ -97,12 +98,14 @@ public:
 	///@{
 	///@name Error printing helper functions
 	/// Functions that help pretty-printing parse errors
-	/// Do only use in error cases, they are quite expensive.
+	/// The first call builds an index of the line starts, after which
+	/// the translation takes logarithmic time in the number of lines.
 	std::string lineAtPosition(int _position) const;
 	LineColumn translatePositionToLineColumn(int _position) const;
 	///@}
 
 	/// Translates a line:column to the absolute position.
+	/// Uses the same index of line starts as translatePositionToLineColumn().
 	std::optional<int> translateLineColumnToPosition(LineColumn const& _lineColumn) const;
 
 	/// Translates a line:column to the absolute position for the given input text.
@@ -136,9 +139,15 @@ public:
 	static std::string singleLineSnippet(std::string const& _sourceCode, SourceLocation const& _location);
 
 private:
+	/// @returns the offsets at which the lines of the source start, beginning with zero.
+	/// The offsets are computed on the first call, which is not thread-safe.
+	std::vector<size_t> const& lineStarts() const;
+
 	std::string m_source;
 	std::string m_name;
 	size_t m_position{0};
+	/// Cache for lineStarts(), empty until first use.
+	mutable std::vector<size_t> m_lineStarts;
 };
 
 }
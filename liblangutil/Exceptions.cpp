@@ -37,7 +37,10 @@ Error::Error(
 	SecondarySourceLocation const& _secondaryLocation
 ):
 	m_errorId(_errorId),
-	m_type(_type)
+	m_type(_type),
+	m_description(_description),
+	m_location(_location),
+	m_secondaryLocation(_secondaryLocation)
 {
 	switch (m_type)
 	{
@@ -66,23 +69,21 @@ Error::Error(
 		m_typeName = "Warning";
 		break;
 	}
-
-	if (_location.isValid())
-		*this << errinfo_sourceLocation(_location);
-	if (!_secondaryLocation.infos.empty())
-		*this << errinfo_secondarySourceLocation(_secondaryLocation);
-	if (!_description.empty())
-		*this << util::errinfo_comment(_description);
 }
 
 SourceLocation const* Error::sourceLocation() const noexcept
 {
-	return boost::get_error_info<errinfo_sourceLocation>(*this);
+	return m_location.isValid() ? &m_location : nullptr;
 }
 
 SecondarySourceLocation const* Error::secondarySourceLocation() const noexcept
 {
-	return boost::get_error_info<errinfo_secondarySourceLocation>(*this);
+	return m_secondaryLocation.infos.empty() ? nullptr : &m_secondaryLocation;
+}
+
+string const* Error::comment() const noexcept
+{
+	return m_description.empty() ? nullptr : &m_description;
 }
 
 optional<Error::Severity> Error::severityFromString(string _input)
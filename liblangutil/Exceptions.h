@@ -199,6 +199,8 @@ public:
 
 	SourceLocation const* sourceLocation() const noexcept;
 	SecondarySourceLocation const* secondarySourceLocation() const noexcept;
+	/// @returns the description of the error, or nullptr if it is empty.
+	std::string const* comment() const noexcept override;
 
 	/// helper functions
 	static Error const* containsErrorOfType(ErrorList const& _list, Error::Type _type)
@@ -267,6 +269,11 @@ private:
 	ErrorId m_errorId;
 	Type m_type;
 	std::string m_typeName;
+	/// The description and the locations are members instead of being attached as boost::error_info,
+	/// which allocates a container and a node for each of them and has to look them up by type.
+	std::string m_description;
+	SourceLocation m_location;
+	SecondarySourceLocation m_secondaryLocation;
 };
 
 }
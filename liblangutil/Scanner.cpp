@@ -247,11 +247,16 @@ Token Scanner::selectToken(char _next, Token _then, Token _else)
 
 bool Scanner::skipWhitespace()
 {
-	size_t const startPosition = sourcePos();
-	while (isWhiteSpace(m_char))
-		advance();
-	// Return whether or not we skipped any characters.
-	return sourcePos() != startPosition;
+	if (!isWhiteSpace(m_char))
+		return false;
+	// The current character is not necessarily the one in the source (see skipMultiLineComment()),
+	// but all following characters are read directly from the source without going through advance().
+	string const& source = m_source.source();
+	size_t position = sourcePos() + 1;
+	while (position < source.size() && isWhiteSpace(source[position]))
+		++position;
+	m_char = m_source.setPosition(position);
+	return true;
 }
 
 bool Scanner::skipWhitespaceExceptUnicodeLinebreak()
@@ -311,9 +316,21 @@ Token Scanner::skipSingleLineComment()
 	// Line terminator is not part of the comment. If it is a
 	// non-ascii line terminator, it will result in a parser error.
 	size_t startPosition = m_source.position();
-	while (!isUnicodeLinebreak())
-		if (!advance())
+	// Only jump to bytes that can start a line terminator and do the full check there.
+	string const& source = m_source.source();
+	for (size_t position = startPosition; ; ++position)
+	{
+		while (position < source.size())
+		{
+			auto const c = uint8_t(source[position]);
+			if ((0x0a <= c && c <= 0x0d) || c == 0xc2 || c == 0xe2)
+				break;
+			++position;
+		}
+		m_char = m_source.setPosition(position);
+		if (position == source.size() || isUnicodeLinebreak())
 			break;
+	}
 
 	ScannerError unicodeDirectionError = validateBiDiMarkup(m_source, startPosition);
 	if (unicodeDirectionError != ScannerError::NoError)
@@ -391,26 +408,24 @@ size_t Scanner::scanSingleLineDocComment()
 Token Scanner::skipMultiLineComment()
 {
 	size_t startPosition = m_source.position();
-	while (!isSourcePastEndOfInput())
+	size_t terminator = string_view(m_source.source()).find("*/", startPosition);
+	if (terminator == string_view::npos)
 	{
-		char prevChar = m_char;
-		advance();
+		m_char = m_source.setPosition(m_source.size());
+		// Unterminated multi-line comment.
+		return setError(ScannerError::IllegalCommentTerminator);
+	}
 
-		// If we have reached the end of the multi-line comment, we
-		// consume the '/' and insert a whitespace. This way all
-		// multi-line comments are treated as whitespace.
-		if (prevChar == '*' && m_char == '/')
-		{
-			ScannerError unicodeDirectionError = validateBiDiMarkup(m_source, startPosition);
-			if (unicodeDirectionError != ScannerError::NoError)
-				return setError(unicodeDirectionError);
+	// We have reached the end of the multi-line comment. We
+	// consume the '/' and insert a whitespace. This way all
+	// multi-line comments are treated as whitespace.
+	m_source.setPosition(terminator + 1);
+	ScannerError unicodeDirectionError = validateBiDiMarkup(m_source, startPosition);
+	if (unicodeDirectionError != ScannerError::NoError)
+		return setError(unicodeDirectionError);
 
-			m_char = ' ';
-			return Token::Whitespace;
-		}
-	}
-	// Unterminated multi-line comment.
-	return setError(ScannerError::IllegalCommentTerminator);
+	m_char = ' ';
+	return Token::Whitespace;
 }
 
 Token Scanner::scanMultiLineDocComment()
@@ -1010,10 +1025,17 @@ tuple<Token, unsigned, unsigned> Scanner::scanIdentifierOrKeyword()
 {
 	solAssert(isIdentifierStart(m_char), "");
 	LiteralScope literal(this, LITERAL_TYPE_STRING);
-	addLiteralCharAndAdvance();
-	// Scan the rest of the identifier characters.
-	while (isIdentifierPart(m_char) || (m_char == '.' && m_kind == ScannerKind::Yul))
-		addLiteralCharAndAdvance();
+	// Find the end of the identifier in the source and copy all of it to the literal at once.
+	string const& source = m_source.source();
+	size_t const startPosition = sourcePos();
+	size_t endPosition = startPosition + 1;
+	while (
+		endPosition < source.size() &&
+		(isIdentifierPart(source[endPosition]) || (source[endPosition] == '.' && m_kind == ScannerKind::Yul))
+	)
+		++endPosition;
+	m_tokens[NextNext].literal.assign(source, startPosition, endPosition - startPosition);
+	m_char = m_source.setPosition(endPosition);
 	literal.complete();
 	auto const token = TokenTraits::fromIdentifierOrKeyword(m_tokens[NextNext].literal);
 	if (m_kind == ScannerKind::Yul)
@@ -22,12 +22,25 @@
 #include <boost/algorithm/string.hpp>
 
 #include <iostream>
+#include <mutex>
+#include <unordered_set>
 
 using namespace solidity;
 using namespace solidity::langutil;
 using namespace std;
 
-SourceLocation solidity::langutil::parseSourceLocation(string const& _input, vector<shared_ptr<string const>> const& _sourceNames)
+string const* SourceName::intern(string const& _name)
+{
+	static mutex internMutex;
+	// Never destroyed, so that locations stay valid in the destructors of other static objects.
+	// The elements of the set do not move when it grows.
+	static unordered_set<string>* names = new unordered_set<string>();
+
+	lock_guard<mutex> lock(internMutex);
+	return &*names->insert(_name).first;
+}
+
+SourceLocation solidity::langutil::parseSourceLocation(string const& _input, vector<SourceName> const& _sourceNames)
 {
 	// Expected input: "start:length:sourceindex"
 	enum SrcElem: size_t { Start, Length, Index };
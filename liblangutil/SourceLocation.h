@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <iosfwd>
 #include <memory>
 #include <string>
@@ -32,6 +33,35 @@
 namespace solidity::langutil
 {
 
+/**
+ * Name of the source a location refers to. The names are interned for the whole process and never
+ * released, so that copying a location does not have to update a reference count and two locations
+ * refer to the same source iff the addresses of their names are equal.
+ */
+class SourceName
+{
+public:
+	SourceName() = default;
+	SourceName(std::nullptr_t) {}
+	explicit SourceName(std::string const& _name): m_name(intern(_name)) {}
+	SourceName(std::shared_ptr<std::string const> const& _name): m_name(_name ? intern(*_name) : nullptr) {}
+	SourceName(std::shared_ptr<std::string> const& _name): m_name(_name ? intern(*_name) : nullptr) {}
+
+	explicit operator bool() const { return m_name != nullptr; }
+	std::string const& operator*() const { return *m_name; }
+	std::string const* operator->() const { return m_name; }
+	std::string const* get() const { return m_name; }
+
+	friend bool operator==(SourceName _a, SourceName _b) { return _a.m_name == _b.m_name; }
+	friend bool operator!=(SourceName _a, SourceName _b) { return _a.m_name != _b.m_name; }
+
+private:
+	/// @returns the interned copy of @a _name. Thread-safe.
+	static std::string const* intern(std::string const& _name);
+
+	std::string const* m_name = nullptr;
+};
+
 /**
  * Representation of an interval of source positions.
  * The interval includes start and excludes end.
@@ -73,14 +103,7 @@ struct SourceLocation
 		return _other.start < end && start < _other.end;
 	}
 
-	bool equalSources(SourceLocation const& _other) const
-	{
-		if (!!sourceName != !!_other.sourceName)
-			return false;
-		if (sourceName && *sourceName != *_other.sourceName)
-			return false;
-		return true;
-	}
+	bool equalSources(SourceLocation const& _other) const { return sourceName == _other.sourceName; }
 
 	bool isValid() const { return sourceName || start != -1 || end != -1; }
 
@@ -108,12 +131,12 @@ struct SourceLocation
 
 	int start = -1;
 	int end = -1;
-	std::shared_ptr<std::string const> sourceName;
+	SourceName sourceName;
 };
 
 SourceLocation parseSourceLocation(
 	std::string const& _input,
-	std::vector<std::shared_ptr<std::string const>> const& _sourceNames
+	std::vector<SourceName> const& _sourceNames
 );
 
 /// Stream output for Location (used e.g. in boost exceptions).
@@ -27,24 +27,51 @@ using namespace std;
 using namespace solidity;
 using namespace solidity::langutil;
 
-SourceReferenceExtractor::Message SourceReferenceExtractor::extract(
+namespace
+{
+
+SourceReferenceExtractor::Message extractMessage(
 	CharStreamProvider const& _charStreamProvider,
-	util::Exception const& _exception,
+	SourceLocation const* _location,
+	string const* _message,
+	SecondarySourceLocation const* _secondaryLocation,
 	string _severity
 )
 {
-	SourceLocation const* location = boost::get_error_info<errinfo_sourceLocation>(_exception);
-
-	string const* message = boost::get_error_info<util::errinfo_comment>(_exception);
-	SourceReference primary = extract(_charStreamProvider, location, message ? *message : "");
+	SourceReference primary = SourceReferenceExtractor::extract(_charStreamProvider, _location, _message ? *_message : "");
 
 	std::vector<SourceReference> secondary;
-	auto secondaryLocation = boost::get_error_info<errinfo_secondarySourceLocation>(_exception);
-	if (secondaryLocation && !secondaryLocation->infos.empty())
-		for (auto const& info: secondaryLocation->infos)
-			secondary.emplace_back(extract(_charStreamProvider, &info.second, info.first));
+	if (_secondaryLocation && !_secondaryLocation->infos.empty())
+		for (auto const& info: _secondaryLocation->infos)
+			secondary.emplace_back(SourceReferenceExtractor::extract(_charStreamProvider, &info.second, info.first));
+
+	return SourceReferenceExtractor::Message{std::move(primary), std::move(_severity), std::move(secondary), nullopt};
+}
+
+}
+
+SourceReferenceExtractor::Message SourceReferenceExtractor::extract(
+	CharStreamProvider const& _charStreamProvider,
+	util::Exception const& _exception,
+	string _severity
+)
+{
+	if (auto const* error = dynamic_cast<Error const*>(&_exception))
+		return extractMessage(
+			_charStreamProvider,
+			error->sourceLocation(),
+			error->comment(),
+			error->secondarySourceLocation(),
+			std::move(_severity)
+		);
 
-	return Message{std::move(primary), _severity, std::move(secondary), nullopt};
+	return extractMessage(
+		_charStreamProvider,
+		boost::get_error_info<errinfo_sourceLocation>(_exception),
+		boost::get_error_info<util::errinfo_comment>(_exception),
+		boost::get_error_info<errinfo_secondarySourceLocation>(_exception),
+		std::move(_severity)
+	);
 }
 
 SourceReferenceExtractor::Message SourceReferenceExtractor::extract(
@@ -52,8 +79,13 @@ SourceReferenceExtractor::Message SourceReferenceExtractor::extract(
 	Error const& _error
 )
 {
-	string severity = Error::formatErrorSeverity(Error::errorSeverity(_error.type()));
-	Message message = extract(_charStreamProvider, _error, severity);
+	Message message = extractMessage(
+		_charStreamProvider,
+		_error.sourceLocation(),
+		_error.comment(),
+		_error.secondarySourceLocation(),
+		Error::formatErrorSeverity(Error::errorSeverity(_error.type()))
+	);
 	message.errorId = _error.errorId();
 	return message;
 }
@@ -91,6 +91,37 @@ public:
 			m_seenErrors[{_error, _location}] = _description;
 	}
 
+	/// Appends the errors in @a _errors that were not seen yet, so that the reports of
+	/// independent analyses can be merged. Unlike the functions above, this keeps the first
+	/// description of an error that was seen with a different one.
+	/// Errors without a location are only dropped if an equal one was already reported.
+	void append(ErrorList const& _errors)
+	{
+		for (auto const& error: _errors)
+		{
+			SourceLocation location = error->sourceLocation() ? *error->sourceLocation() : SourceLocation{};
+			std::string description = error->comment() ? *error->comment() : std::string{};
+			if (!error->sourceLocation())
+			{
+				bool reported = false;
+				for (auto const& uniqueError: m_uniqueErrors)
+					if (
+						uniqueError->errorId() == error->errorId() &&
+						!uniqueError->sourceLocation() &&
+						uniqueError->comment() &&
+						*uniqueError->comment() == description
+					)
+						reported = true;
+				if (reported)
+					continue;
+			}
+			else if (m_seenErrors.count({error->errorId(), location}))
+				continue;
+			m_errorReporter.append({error});
+			markAsSeen(error->errorId(), location, description);
+		}
+	}
+
 	ErrorList const& errors() const { return m_errorReporter.errors(); }
 
 	void clear() { m_errorReporter.clear(); }
@@ -18,6 +18,9 @@
 
 #include <libsmtutil/CHCSmtLib2Interface.h>
 
+#include <libsmtutil/SMTSolverProcess.h>
+
+#include <libsolutil/Algorithms.h>
 #include <libsolutil/Keccak256.h>
 
 #include <boost/algorithm/string/join.hpp>
@@ -40,12 +43,14 @@ using namespace solidity::smtutil;
 CHCSmtLib2Interface::CHCSmtLib2Interface(
 	map<h256, string> const& _queryResponses,
 	ReadCallback::Callback _smtCallback,
-	optional<unsigned> _queryTimeout
+	optional<unsigned> _queryTimeout,
+	optional<string> _solverCommand
 ):
 	CHCSolverInterface(_queryTimeout),
 	m_smtlib2(make_unique<SMTLib2Interface>(_queryResponses, _smtCallback, m_queryTimeout)),
 	m_queryResponses(move(_queryResponses)),
-	m_smtCallback(_smtCallback)
+	m_smtCallback(_smtCallback),
+	m_solverCommand(move(_solverCommand))
 {
 	reset();
 }
@@ -54,6 +59,8 @@ void CHCSmtLib2Interface::reset()
 {
 	m_accumulatedOutput.clear();
 	m_variables.clear();
+	m_relations.clear();
+	m_rules.clear();
 	m_unhandledQueries.clear();
 	m_sortNames.clear();
 }
@@ -68,6 +75,7 @@ void CHCSmtLib2Interface::registerRelation(Expression const& _expr)
 		string domain = toSmtLibSort(fSort->domain);
 		// Relations are predicates which have implicit codomain Bool.
 		m_variables.insert(_expr.name);
+		m_relations.insert(_expr.name);
 		write(
 			"(declare-fun |" +
 			_expr.name +
@@ -80,14 +88,45 @@ void CHCSmtLib2Interface::registerRelation(Expression const& _expr)
 
 void CHCSmtLib2Interface::addRule(Expression const& _expr, std::string const& /*_name*/)
 {
+	// Rules are either implications `body => head` or facts.
+	bool isImplication = _expr.name == "=>";
+	Expression const& head = isImplication ? _expr.arguments.at(1) : _expr;
+	Rule rule{m_accumulatedOutput.size(), 0, m_relations.count(head.name) ? head.name : "", {}};
+	if (isImplication)
+		BreadthFirstSearch<Expression const*>{{&_expr.arguments.at(0)}}.run([&](auto&& _node, auto&& _addChild) {
+			if (m_relations.count(_node->name))
+				rule.body.insert(_node->name);
+			for (auto const& arg: _node->arguments)
+				_addChild(&arg);
+		});
+
 	write(
 		"(assert\n(forall " + forall() + "\n" +
 		m_smtlib2->toSExpr(_expr) +
 		"))\n\n"
 	);
+	rule.end = m_accumulatedOutput.size();
+	m_rules.emplace_back(move(rule));
 }
 
 tuple<CheckResult, Expression, CHCSolverInterface::CexGraph> CHCSmtLib2Interface::query(Expression const& _block)
+{
+	return {parseResult(querySolver(queryInput(_block))), Expression(true), {}};
+}
+
+tuple<CheckResult, Expression, CHCSolverInterface::CexGraph> CHCSmtLib2Interface::queryWithSolverCommand(
+	string const& _input,
+	optional<unsigned> _timeout
+) const
+{
+	smtAssert(m_solverCommand, "");
+	if (auto knownResponse = m_queryResponses.find(util::keccak256(_input)); knownResponse != m_queryResponses.end())
+		return {parseResult(knownResponse->second), Expression(true), {}};
+	optional<string> response = runSolverCommand(_input, _timeout);
+	return {response ? parseResult(*response) : CheckResult::ERROR, Expression(true), {}};
+}
+
+string CHCSmtLib2Interface::queryInput(Expression const& _block)
 {
 	string accumulated{};
 	swap(m_accumulatedOutput, accumulated);
@@ -95,30 +134,29 @@ tuple<CheckResult, Expression, CHCSolverInterface::CexGraph> CHCSmtLib2Interface
 	writeHeader();
 	for (auto const& decl: m_smtlib2->userSorts() | ranges::views::values)
 		write(decl);
-	m_accumulatedOutput += accumulated;
+	// Solving time grows much faster than the size of the system, so only the rules
+	// that can contribute to reaching the queried block are sent to the solver.
+	m_accumulatedOutput += coneOfInfluence(accumulated, _block.name);
 
 	string queryRule = "(assert\n(forall " + forall() + "\n" +
 		"(=> " + _block.name + " false)"
 		"))";
-	string response = querySolver(
-		m_accumulatedOutput +
-		queryRule +
-		"\n(check-sat)"
-	);
+	string input = m_accumulatedOutput + queryRule + "\n(check-sat)";
 	swap(m_accumulatedOutput, accumulated);
+	return input;
+}
 
-	CheckResult result;
+CheckResult CHCSmtLib2Interface::parseResult(string const& _response)
+{
 	// TODO proper parsing
-	if (boost::starts_with(response, "sat"))
-		result = CheckResult::UNSATISFIABLE;
-	else if (boost::starts_with(response, "unsat"))
-		result = CheckResult::SATISFIABLE;
-	else if (boost::starts_with(response, "unknown"))
-		result = CheckResult::UNKNOWN;
+	if (boost::starts_with(_response, "sat"))
+		return CheckResult::UNSATISFIABLE;
+	else if (boost::starts_with(_response, "unsat"))
+		return CheckResult::SATISFIABLE;
+	else if (boost::starts_with(_response, "unknown"))
+		return CheckResult::UNKNOWN;
 	else
-		result = CheckResult::ERROR;
-
-	return {result, Expression(true), {}};
+		return CheckResult::ERROR;
 }
 
 void CHCSmtLib2Interface::declareVariable(string const& _name, SortPointer const& _sort)
@@ -193,6 +231,33 @@ void CHCSmtLib2Interface::declareFunction(string const& _name, SortPointer const
 	}
 }
 
+string CHCSmtLib2Interface::coneOfInfluence(string const& _system, string const& _relation) const
+{
+	map<string, vector<Rule const*>> rulesByHead;
+	for (Rule const& rule: m_rules)
+		rulesByHead[rule.head].push_back(&rule);
+
+	auto relevant = BreadthFirstSearch<string>{{_relation}}.run([&](string const& _head, auto&& _addChild) {
+		if (rulesByHead.count(_head))
+			for (Rule const* rule: rulesByHead.at(_head))
+				for (auto const& relation: rule->body)
+					_addChild(relation);
+	}).visited;
+
+	// Declarations are kept and everything is kept in its original order.
+	string sliced;
+	size_t position = 0;
+	for (Rule const& rule: m_rules)
+	{
+		sliced += _system.substr(position, rule.begin - position);
+		if (rule.head.empty() || relevant.count(rule.head))
+			sliced += _system.substr(rule.begin, rule.end - rule.begin);
+		position = rule.end;
+	}
+	sliced += _system.substr(position);
+	return sliced;
+}
+
 void CHCSmtLib2Interface::write(string _data)
 {
 	m_accumulatedOutput += move(_data) + "\n";
@@ -203,6 +268,9 @@ string CHCSmtLib2Interface::querySolver(string const& _input)
 	util::h256 inputHash = util::keccak256(_input);
 	if (m_queryResponses.count(inputHash))
 		return m_queryResponses.at(inputHash);
+	if (m_solverCommand)
+		if (optional<string> response = runSolverCommand(_input, m_queryTimeout))
+			return *response;
 	if (m_smtCallback)
 	{
 		auto result = m_smtCallback(ReadCallback::kindString(ReadCallback::Kind::SMTQuery), _input);
@@ -212,3 +280,17 @@ string CHCSmtLib2Interface::querySolver(string const& _input)
 	m_unhandledQueries.push_back(_input);
 	return "unknown\n";
 }
+
+optional<string> CHCSmtLib2Interface::runSolverCommand(string const& _input, optional<unsigned> _timeout) const
+{
+	smtAssert(m_solverCommand, "");
+	smtAssert(boost::ends_with(_input, "(check-sat)"), "");
+	SMTSolverProcess process(*m_solverCommand, _timeout);
+	if (!process.start())
+		return nullopt;
+	// The process only answers the final check-sat, so everything before it is just sent.
+	process.send(_input.substr(0, _input.size() - string("(check-sat)").size()));
+	optional<string> response = process.query("(check-sat)\n");
+	process.stop();
+	return response;
+}
@@ -32,10 +32,14 @@ namespace solidity::smtutil
 class CHCSmtLib2Interface: public CHCSolverInterface
 {
 public:
+	/// If @a _solverCommand is given, every query is answered by a new solver process started
+	/// with that command, which reads the Horn system from its standard input. The command can
+	/// also hand the query to another machine, so the queries can be solved on a cluster.
 	explicit CHCSmtLib2Interface(
 		std::map<util::h256, std::string> const& _queryResponses = {},
 		frontend::ReadCallback::Callback _smtCallback = {},
-		std::optional<unsigned> _queryTimeout = {}
+		std::optional<unsigned> _queryTimeout = {},
+		std::optional<std::string> _solverCommand = {}
 	);
 
 	void reset();
@@ -48,6 +52,17 @@ public:
 	/// @returns solving result, an invariant, and counterexample graph, if possible.
 	std::tuple<CheckResult, Expression, CexGraph> query(Expression const& _expr) override;
 
+	bool hasSolverCommand() const { return m_solverCommand.has_value(); }
+	/// @returns the SMT-LIB2 input that query() gives the solver for the reachability of @a _expr.
+	std::string queryInput(Expression const& _expr);
+	/// Answers @a _input, created by queryInput(), with a solver process that is given at most
+	/// @a _timeout milliseconds, without changing the state of the interface, so that queries
+	/// can be answered on several threads at the same time. Requires a solver command.
+	std::tuple<CheckResult, Expression, CexGraph> queryWithSolverCommand(
+		std::string const& _input,
+		std::optional<unsigned> _timeout
+	) const;
+
 	void declareVariable(std::string const& _name, SortPointer const& _sort) override;
 
 	std::vector<std::string> unhandledQueries() const { return m_unhandledQueries; }
@@ -63,21 +78,43 @@ private:
 
 	void declareFunction(std::string const& _name, SortPointer const& _sort);
 
+	/// @returns @a _system without the rules that cannot contribute to deriving @a _relation,
+	/// that is, the cone of influence of the query for @a _relation.
+	/// @a _system has to be the accumulated output the rules in m_rules refer to.
+	std::string coneOfInfluence(std::string const& _system, std::string const& _relation) const;
+
 	void write(std::string _data);
 
-	/// Communicates with the solver via the callback. Throws SMTSolverError on error.
+	/// Communicates with the solver via the solver command or the callback. Throws SMTSolverError on error.
 	std::string querySolver(std::string const& _input);
+	/// @returns the answer of a new process of the solver command to @a _input, or nullopt if it failed.
+	std::optional<std::string> runSolverCommand(std::string const& _input, std::optional<unsigned> _timeout) const;
+	static CheckResult parseResult(std::string const& _response);
 
 	/// Used to access toSmtLibSort, SExpr, and handle variables.
 	std::unique_ptr<SMTLib2Interface> m_smtlib2;
 
 	std::string m_accumulatedOutput;
 	std::set<std::string> m_variables;
+	std::set<std::string> m_relations;
+
+	/// A rule as the range of its text in m_accumulatedOutput together with
+	/// the relation it derives and the relations it depends on.
+	struct Rule
+	{
+		size_t begin;
+		size_t end;
+		/// Empty if the head is not a relation, in which case the rule is always kept.
+		std::string head;
+		std::set<std::string> body;
+	};
+	std::vector<Rule> m_rules;
 
 	std::map<util::h256, std::string> const& m_queryResponses;
 	std::vector<std::string> m_unhandledQueries;
 
 	frontend::ReadCallback::Callback m_smtCallback;
+	std::optional<std::string> m_solverCommand;
 
 	std::map<Sort const*, std::string> m_sortNames;
 };
@@ -59,6 +59,15 @@ public:
 		Expression const& _expr
 	) = 0;
 
+	/// Takes a formula _invariant over the arguments of the function application _predicate
+	/// that holds whenever the predicate does, and gives it to the solver as a lemma.
+	/// The solver trusts the lemma, so it has to be proved beforehand.
+	/// Does nothing if the solver does not take lemmas.
+	virtual void addInvariant(Expression const& /*_predicate*/, Expression const& /*_invariant*/) {}
+
+	/// Sets the timeout of the following queries in milliseconds.
+	virtual void setQueryTimeout(unsigned _milliseconds) { m_queryTimeout = _milliseconds; }
+
 protected:
 	std::optional<unsigned> m_queryTimeout;
 };
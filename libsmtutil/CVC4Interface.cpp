@@ -37,6 +37,8 @@ CVC4Interface::CVC4Interface(optional<unsigned> _queryTimeout):
 void CVC4Interface::reset()
 {
 	m_variables.clear();
+	m_translations.clear();
+	m_structuralTranslations.clear();
 	m_solver.reset();
 	m_solver.setOption("produce-models", true);
 	if (m_queryTimeout)
@@ -58,7 +60,13 @@ void CVC4Interface::pop()
 void CVC4Interface::declareVariable(string const& _name, SortPointer const& _sort)
 {
 	smtAssert(_sort, "");
-	m_variables[_name] = m_context.mkVar(_name.c_str(), cvc4Sort(*_sort));
+	// The encoding declares a variable again every time it reads its current SSA index,
+	// which must not create a new CVC4 variable.
+	CVC4::Type sort = cvc4Sort(*_sort);
+	auto variable = m_variables.find(_name);
+	if (variable != m_variables.end() && variable->second.getType() == sort)
+		return;
+	m_variables[_name] = m_context.mkVar(_name.c_str(), sort);
 }
 
 void CVC4Interface::addAssertion(Expression const& _expr)
@@ -121,24 +129,57 @@ pair<CheckResult, vector<string>> CVC4Interface::check(vector<Expression> const&
 	return make_pair(result, values);
 }
 
+void CVC4Interface::setQueryTimeout(unsigned _milliseconds)
+{
+	m_queryTimeout = _milliseconds;
+	m_solver.setTimeLimit(_milliseconds);
+}
+
 CVC4::Expr CVC4Interface::toCVC4Expr(Expression const& _expr)
 {
-	// Variable
-	if (_expr.arguments.empty() && m_variables.count(_expr.name))
-		return m_variables.at(_expr.name);
+	if (_expr.arguments.empty())
+	{
+		// Variable
+		if (auto variable = m_variables.find(_expr.name); variable != m_variables.end())
+			return variable->second;
+		return translate(_expr, {});
+	}
+
+	// The copies of an expression share their arguments, so a subexpression that
+	// occurs in many places of an encoding is only translated once.
+	auto key = make_tuple(_expr.arguments.identity(), _expr.name, _expr.sort.get());
+	if (auto translation = m_translations.find(key); translation != m_translations.end())
+		return translation->second.second;
 
 	vector<CVC4::Expr> arguments;
+	vector<unsigned long> argumentIds;
 	for (auto const& arg: _expr.arguments)
+	{
 		arguments.push_back(toCVC4Expr(arg));
+		argumentIds.push_back(arguments.back().getId());
+	}
 
+	// Expressions that were built separately but are equal have the same operator, sort
+	// and translated arguments, since CVC4 shares equal terms.
+	auto structuralKey = make_tuple(_expr.name, _expr.sort.get(), move(argumentIds));
+	auto translation = m_structuralTranslations.find(structuralKey);
+	if (translation == m_structuralTranslations.end())
+		translation = m_structuralTranslations.emplace(move(structuralKey), translate(_expr, arguments)).first;
+	CVC4::Expr result = translation->second;
+	m_translations.emplace(move(key), make_pair(_expr.arguments, result));
+	return result;
+}
+
+CVC4::Expr CVC4Interface::translate(Expression const& _expr, vector<CVC4::Expr> const& _arguments)
+{
 	try
 	{
 		string const& n = _expr.name;
 		// Function application
-		if (!arguments.empty() && m_variables.count(_expr.name))
-			return m_context.mkExpr(CVC4::kind::APPLY_UF, m_variables.at(n), arguments);
+		if (!_arguments.empty() && m_variables.count(_expr.name))
+			return m_context.mkExpr(CVC4::kind::APPLY_UF, m_variables.at(n), _arguments);
 		// Literal
-		else if (arguments.empty())
+		else if (_arguments.empty())
 		{
 			if (n == "true")
 				return m_context.mkConst(true);
@@ -163,49 +204,49 @@ CVC4::Expr CVC4Interface::toCVC4Expr(Expression const& _expr)
 
 		smtAssert(_expr.hasCorrectArity(), "");
 		if (n == "ite")
-			return arguments[0].iteExpr(arguments[1], arguments[2]);
+			return _arguments[0].iteExpr(_arguments[1], _arguments[2]);
 		else if (n == "not")
-			return arguments[0].notExpr();
+			return _arguments[0].notExpr();
 		else if (n == "and")
-			return arguments[0].andExpr(arguments[1]);
+			return _arguments[0].andExpr(_arguments[1]);
 		else if (n == "or")
-			return arguments[0].orExpr(arguments[1]);
+			return _arguments[0].orExpr(_arguments[1]);
 		else if (n == "=>")
-			return m_context.mkExpr(CVC4::kind::IMPLIES, arguments[0], arguments[1]);
+			return m_context.mkExpr(CVC4::kind::IMPLIES, _arguments[0], _arguments[1]);
 		else if (n == "=")
-			return m_context.mkExpr(CVC4::kind::EQUAL, arguments[0], arguments[1]);
+			return m_context.mkExpr(CVC4::kind::EQUAL, _arguments[0], _arguments[1]);
 		else if (n == "<")
-			return m_context.mkExpr(CVC4::kind::LT, arguments[0], arguments[1]);
+			return m_context.mkExpr(CVC4::kind::LT, _arguments[0], _arguments[1]);
 		else if (n == "<=")
-			return m_context.mkExpr(CVC4::kind::LEQ, arguments[0], arguments[1]);
+			return m_context.mkExpr(CVC4::kind::LEQ, _arguments[0], _arguments[1]);
 		else if (n == ">")
-			return m_context.mkExpr(CVC4::kind::GT, arguments[0], arguments[1]);
+			return m_context.mkExpr(CVC4::kind::GT, _arguments[0], _arguments[1]);
 		else if (n == ">=")
-			return m_context.mkExpr(CVC4::kind::GEQ, arguments[0], arguments[1]);
+			return m_context.mkExpr(CVC4::kind::GEQ, _arguments[0], _arguments[1]);
 		else if (n == "+")
-			return m_context.mkExpr(CVC4::kind::PLUS, arguments[0], arguments[1]);
+			return m_context.mkExpr(CVC4::kind::PLUS, _arguments[0], _arguments[1]);
 		else if (n == "-")
-			return m_context.mkExpr(CVC4::kind::MINUS, arguments[0], arguments[1]);
+			return m_context.mkExpr(CVC4::kind::MINUS, _arguments[0], _arguments[1]);
 		else if (n == "*")
-			return m_context.mkExpr(CVC4::kind::MULT, arguments[0], arguments[1]);
+			return m_context.mkExpr(CVC4::kind::MULT, _arguments[0], _arguments[1]);
 		else if (n == "div")
-			return m_context.mkExpr(CVC4::kind::INTS_DIVISION_TOTAL, arguments[0], arguments[1]);
+			return m_context.mkExpr(CVC4::kind::INTS_DIVISION_TOTAL, _arguments[0], _arguments[1]);
 		else if (n == "mod")
-			return m_context.mkExpr(CVC4::kind::INTS_MODULUS, arguments[0], arguments[1]);
+			return m_context.mkExpr(CVC4::kind::INTS_MODULUS, _arguments[0], _arguments[1]);
 		else if (n == "bvnot")
-			return m_context.mkExpr(CVC4::kind::BITVECTOR_NOT, arguments[0]);
+			return m_context.mkExpr(CVC4::kind::BITVECTOR_NOT, _arguments[0]);
 		else if (n == "bvand")
-			return m_context.mkExpr(CVC4::kind::BITVECTOR_AND, arguments[0], arguments[1]);
+			return m_context.mkExpr(CVC4::kind::BITVECTOR_AND, _arguments[0], _arguments[1]);
 		else if (n == "bvor")
-			return m_context.mkExpr(CVC4::kind::BITVECTOR_OR, arguments[0], arguments[1]);
+			return m_context.mkExpr(CVC4::kind::BITVECTOR_OR, _arguments[0], _arguments[1]);
 		else if (n == "bvxor")
-			return m_context.mkExpr(CVC4::kind::BITVECTOR_XOR, arguments[0], arguments[1]);
+			return m_context.mkExpr(CVC4::kind::BITVECTOR_XOR, _arguments[0], _arguments[1]);
 		else if (n == "bvshl")
-			return m_context.mkExpr(CVC4::kind::BITVECTOR_SHL, arguments[0], arguments[1]);
+			return m_context.mkExpr(CVC4::kind::BITVECTOR_SHL, _arguments[0], _arguments[1]);
 		else if (n == "bvlshr")
-			return m_context.mkExpr(CVC4::kind::BITVECTOR_LSHR, arguments[0], arguments[1]);
+			return m_context.mkExpr(CVC4::kind::BITVECTOR_LSHR, _arguments[0], _arguments[1]);
 		else if (n == "bvashr")
-			return m_context.mkExpr(CVC4::kind::BITVECTOR_ASHR, arguments[0], arguments[1]);
+			return m_context.mkExpr(CVC4::kind::BITVECTOR_ASHR, _arguments[0], _arguments[1]);
 		else if (n == "int2bv")
 		{
 			size_t size = std::stoul(_expr.arguments[1].name);
@@ -213,11 +254,11 @@ CVC4::Expr CVC4Interface::toCVC4Expr(Expression const& _expr)
 			// CVC4 treats all BVs as unsigned, so we need to manually apply 2's complement if needed.
 			return m_context.mkExpr(
 				CVC4::kind::ITE,
-				m_context.mkExpr(CVC4::kind::GEQ, arguments[0], m_context.mkConst(CVC4::Rational(0))),
-				m_context.mkExpr(CVC4::kind::INT_TO_BITVECTOR, i2bvOp, arguments[0]),
+				m_context.mkExpr(CVC4::kind::GEQ, _arguments[0], m_context.mkConst(CVC4::Rational(0))),
+				m_context.mkExpr(CVC4::kind::INT_TO_BITVECTOR, i2bvOp, _arguments[0]),
 				m_context.mkExpr(
 					CVC4::kind::BITVECTOR_NEG,
-					m_context.mkExpr(CVC4::kind::INT_TO_BITVECTOR, i2bvOp, m_context.mkExpr(CVC4::kind::UMINUS, arguments[0]))
+					m_context.mkExpr(CVC4::kind::INT_TO_BITVECTOR, i2bvOp, m_context.mkExpr(CVC4::kind::UMINUS, _arguments[0]))
 				)
 			);
 		}
@@ -225,11 +266,11 @@ CVC4::Expr CVC4Interface::toCVC4Expr(Expression const& _expr)
 		{
 			auto intSort = dynamic_pointer_cast<IntSort>(_expr.sort);
 			smtAssert(intSort, "");
-			auto nat = m_context.mkExpr(CVC4::kind::BITVECTOR_TO_NAT, arguments[0]);
+			auto nat = m_context.mkExpr(CVC4::kind::BITVECTOR_TO_NAT, _arguments[0]);
 			if (!intSort->isSigned)
 				return nat;
 
-			auto type = arguments[0].getType();
+			auto type = _arguments[0].getType();
 			smtAssert(type.isBitVector(), "");
 			auto size = CVC4::BitVectorType(type).getSize();
 			// CVC4 treats all BVs as unsigned, so we need to manually apply 2's complement if needed.
@@ -237,25 +278,25 @@ CVC4::Expr CVC4Interface::toCVC4Expr(Expression const& _expr)
 			return m_context.mkExpr(CVC4::kind::ITE,
 				m_context.mkExpr(
 					CVC4::kind::EQUAL,
-					m_context.mkExpr(CVC4::kind::BITVECTOR_EXTRACT, extractOp, arguments[0]),
+					m_context.mkExpr(CVC4::kind::BITVECTOR_EXTRACT, extractOp, _arguments[0]),
 					m_context.mkConst(CVC4::BitVector(1, size_t(0)))
 				),
 				nat,
 				m_context.mkExpr(
 					CVC4::kind::UMINUS,
-					m_context.mkExpr(CVC4::kind::BITVECTOR_TO_NAT, m_context.mkExpr(CVC4::kind::BITVECTOR_NEG, arguments[0]))
+					m_context.mkExpr(CVC4::kind::BITVECTOR_TO_NAT, m_context.mkExpr(CVC4::kind::BITVECTOR_NEG, _arguments[0]))
 				)
 			);
 		}
 		else if (n == "select")
-			return m_context.mkExpr(CVC4::kind::SELECT, arguments[0], arguments[1]);
+			return m_context.mkExpr(CVC4::kind::SELECT, _arguments[0], _arguments[1]);
 		else if (n == "store")
-			return m_context.mkExpr(CVC4::kind::STORE, arguments[0], arguments[1], arguments[2]);
+			return m_context.mkExpr(CVC4::kind::STORE, _arguments[0], _arguments[1], _arguments[2]);
 		else if (n == "const_array")
 		{
 			shared_ptr<SortSort> sortSort = std::dynamic_pointer_cast<SortSort>(_expr.arguments[0].sort);
 			smtAssert(sortSort, "");
-			return m_context.mkConst(CVC4::ArrayStoreAll(cvc4Sort(*sortSort->inner), arguments[1]));
+			return m_context.mkConst(CVC4::ArrayStoreAll(cvc4Sort(*sortSort->inner), _arguments[1]));
 		}
 		else if (n == "tuple_get")
 		{
@@ -265,7 +306,7 @@ CVC4::Expr CVC4Interface::toCVC4Expr(Expression const& _expr)
 			CVC4::Datatype const& dt = tt.getDatatype();
 			size_t index = std::stoul(_expr.arguments[1].name);
 			CVC4::Expr s = dt[0][index].getSelector();
-			return m_context.mkExpr(CVC4::kind::APPLY_SELECTOR, s, arguments[0]);
+			return m_context.mkExpr(CVC4::kind::APPLY_SELECTOR, s, _arguments[0]);
 		}
 		else if (n == "tuple_constructor")
 		{
@@ -274,7 +315,7 @@ CVC4::Expr CVC4Interface::toCVC4Expr(Expression const& _expr)
 			CVC4::DatatypeType tt = m_context.mkTupleType(cvc4Sort(tupleSort->components));
 			CVC4::Datatype const& dt = tt.getDatatype();
 			CVC4::Expr c = dt[0].getConstructor();
-			return m_context.mkExpr(CVC4::kind::APPLY_CONSTRUCTOR, c, arguments);
+			return m_context.mkExpr(CVC4::kind::APPLY_CONSTRUCTOR, c, _arguments);
 		}
 
 		smtAssert(false, "");
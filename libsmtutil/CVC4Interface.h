@@ -33,6 +33,9 @@
 #undef _GLIBCXX_PERMIT_BACKWARD_HASH
 #endif
 
+#include <map>
+#include <tuple>
+
 namespace solidity::smtutil
 {
 
@@ -55,14 +58,28 @@ public:
 	void addAssertion(Expression const& _expr) override;
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
 
+	void setQueryTimeout(unsigned _milliseconds) override;
+	/// CVC4 ignores interrupts outside of a satisfiability check.
+	void interrupt() override { m_solver.interrupt(); }
+
 private:
 	CVC4::Expr toCVC4Expr(Expression const& _expr);
+	/// Translates @a _expr, whose arguments are already translated to @a _arguments.
+	CVC4::Expr translate(Expression const& _expr, std::vector<CVC4::Expr> const& _arguments);
 	CVC4::Type cvc4Sort(Sort const& _sort);
 	std::vector<CVC4::Type> cvc4Sort(std::vector<SortPointer> const& _sorts);
 
 	CVC4::ExprManager m_context;
 	CVC4::SmtEngine m_solver;
 	std::map<std::string, CVC4::Expr> m_variables;
+	/// The translations of the expressions with arguments, keyed by the identity of their
+	/// arguments, their name and their sort. The arguments are kept alive so that their identity
+	/// is not reused.
+	std::map<std::tuple<void const*, std::string, Sort const*>, std::pair<ExpressionList, CVC4::Expr>> m_translations;
+	/// The translations of the expressions with arguments, keyed by their name, their sort
+	/// and the ids of their translated arguments. Also finds expressions that are equal but
+	/// do not share their arguments.
+	std::map<std::tuple<std::string, Sort const*, std::vector<unsigned long>>, CVC4::Expr> m_structuralTranslations;
 
 	// CVC4 "basic resources" limit.
 	// This is used to make the runs more deterministic and platform/machine independent.
@@ -42,21 +42,26 @@ using namespace solidity::smtutil;
 SMTLib2Interface::SMTLib2Interface(
 	map<h256, string> _queryResponses,
 	ReadCallback::Callback _smtCallback,
-	optional<unsigned> _queryTimeout
+	optional<unsigned> _queryTimeout,
+	optional<string> const& _solverCommand
 ):
 	SolverInterface(_queryTimeout),
 	m_queryResponses(move(_queryResponses)),
 	m_smtCallback(move(_smtCallback))
 {
+	if (_solverCommand)
+		m_solverProcess = make_unique<SMTSolverProcess>(*_solverCommand, m_queryTimeout);
 	reset();
 }
 
 void SMTLib2Interface::reset()
 {
+	m_solverInSync = false;
 	m_accumulatedOutput.clear();
 	m_accumulatedOutput.emplace_back();
 	m_variables.clear();
 	m_userSorts.clear();
+	m_sortNames.clear();
 	write("(set-option :produce-models true)");
 	if (m_queryTimeout)
 		write("(set-option :timeout " + to_string(*m_queryTimeout) + ")");
@@ -66,12 +71,16 @@ void SMTLib2Interface::reset()
 void SMTLib2Interface::push()
 {
 	m_accumulatedOutput.emplace_back();
+	if (m_solverInSync)
+		m_solverProcess->send("(push 1)\n");
 }
 
 void SMTLib2Interface::pop()
 {
 	smtAssert(!m_accumulatedOutput.empty(), "");
 	m_accumulatedOutput.pop_back();
+	if (m_solverInSync)
+		m_solverProcess->send("(pop 1)\n");
 }
 
 void SMTLib2Interface::declareVariable(string const& _name, SortPointer const& _sort)
@@ -116,10 +125,9 @@ void SMTLib2Interface::addAssertion(Expression const& _expr)
 
 pair<CheckResult, vector<string>> SMTLib2Interface::check(vector<Expression> const& _expressionsToEvaluate)
 {
-	string response = querySolver(
-		boost::algorithm::join(m_accumulatedOutput, "\n") +
-		checkSatAndGetValuesCommand(_expressionsToEvaluate)
-	);
+	string response = m_solverProcess ?
+		querySolverProcess(_expressionsToEvaluate) :
+		querySolver(dumpQuery(_expressionsToEvaluate));
 
 	CheckResult result;
 	// TODO proper parsing
@@ -214,6 +222,15 @@ string SMTLib2Interface::toSExpr(Expression const& _expr)
 }
 
 string SMTLib2Interface::toSmtLibSort(Sort const& _sort)
+{
+	if (!_sort.interned)
+		return sortToSmtLib(_sort);
+	if (auto it = m_sortNames.find(&_sort); it != m_sortNames.end())
+		return it->second;
+	return m_sortNames[&_sort] = sortToSmtLib(_sort);
+}
+
+string SMTLib2Interface::sortToSmtLib(Sort const& _sort)
 {
 	switch (_sort.kind)
 	{
@@ -264,34 +281,47 @@ string SMTLib2Interface::toSmtLibSort(vector<SortPointer> const& _sorts)
 void SMTLib2Interface::write(string _data)
 {
 	smtAssert(!m_accumulatedOutput.empty(), "");
-	m_accumulatedOutput.back() += move(_data) + "\n";
+	m_accumulatedOutput.back() += _data + "\n";
+	if (m_solverInSync)
+		m_solverProcess->send(_data + "\n");
 }
 
 string SMTLib2Interface::checkSatAndGetValuesCommand(vector<Expression> const& _expressionsToEvaluate)
+{
+	string command = evaluationCommands(_expressionsToEvaluate) + "(check-sat)\n";
+	if (!_expressionsToEvaluate.empty())
+		command += getValuesCommand(_expressionsToEvaluate);
+	return command;
+}
+
+string SMTLib2Interface::evaluationCommands(vector<Expression> const& _expressionsToEvaluate)
 {
 	string command;
-	if (_expressionsToEvaluate.empty())
-		command = "(check-sat)\n";
-	else
+	// TODO make sure these are unique
+	for (size_t i = 0; i < _expressionsToEvaluate.size(); i++)
 	{
-		// TODO make sure these are unique
-		for (size_t i = 0; i < _expressionsToEvaluate.size(); i++)
-		{
-			auto const& e = _expressionsToEvaluate.at(i);
-			smtAssert(e.sort->kind == Kind::Int || e.sort->kind == Kind::Bool, "Invalid sort for expression to evaluate.");
-			command += "(declare-const |EVALEXPR_" + to_string(i) + "| " + (e.sort->kind == Kind::Int ? "Int" : "Bool") + ")\n";
-			command += "(assert (= |EVALEXPR_" + to_string(i) + "| " + toSExpr(e) + "))\n";
-		}
-		command += "(check-sat)\n";
-		command += "(get-value (";
-		for (size_t i = 0; i < _expressionsToEvaluate.size(); i++)
-			command += "|EVALEXPR_" + to_string(i) + "| ";
-		command += "))\n";
+		auto const& e = _expressionsToEvaluate.at(i);
+		smtAssert(e.sort->kind == Kind::Int || e.sort->kind == Kind::Bool, "Invalid sort for expression to evaluate.");
+		command += "(declare-const |EVALEXPR_" + to_string(i) + "| " + (e.sort->kind == Kind::Int ? "Int" : "Bool") + ")\n";
+		command += "(assert (= |EVALEXPR_" + to_string(i) + "| " + toSExpr(e) + "))\n";
 	}
+	return command;
+}
 
+string SMTLib2Interface::getValuesCommand(vector<Expression> const& _expressionsToEvaluate)
+{
+	string command = "(get-value (";
+	for (size_t i = 0; i < _expressionsToEvaluate.size(); i++)
+		command += "|EVALEXPR_" + to_string(i) + "| ";
+	command += "))\n";
 	return command;
 }
 
+string SMTLib2Interface::dumpQuery(vector<Expression> const& _expressionsToEvaluate)
+{
+	return boost::algorithm::join(m_accumulatedOutput, "\n") + checkSatAndGetValuesCommand(_expressionsToEvaluate);
+}
+
 vector<string> SMTLib2Interface::parseValues(string::const_iterator _start, string::const_iterator _end)
 {
 	vector<string> values;
@@ -322,3 +352,53 @@ string SMTLib2Interface::querySolver(string const& _input)
 	m_unhandledQueries.push_back(_input);
 	return "unknown\n";
 }
+
+string SMTLib2Interface::querySolverProcess(vector<Expression> const& _expressionsToEvaluate)
+{
+	smtAssert(m_solverProcess, "");
+	if (!m_solverInSync && !synchronizeSolverProcess())
+		return "";
+
+	// The constants of the expressions to evaluate are declared in their own push level,
+	// so that the next query can declare them again.
+	m_solverProcess->send("(push 1)\n" + evaluationCommands(_expressionsToEvaluate));
+	optional<string> answer = m_solverProcess->query("(check-sat)\n");
+	if (!answer || (*answer != "sat" && *answer != "unsat" && *answer != "unknown"))
+	{
+		// The solver failed or reported an error, so its state is not known anymore.
+		// It is started again and sent all the commands at the next query.
+		m_solverProcess->stop();
+		m_solverInSync = false;
+		return answer ? *answer + "\n" : "unknown\n";
+	}
+
+	string response = *answer + "\n";
+	if (*answer == "sat" && !_expressionsToEvaluate.empty())
+	{
+		optional<string> values = m_solverProcess->query(getValuesCommand(_expressionsToEvaluate));
+		if (!values)
+		{
+			m_solverInSync = false;
+			return "unknown\n";
+		}
+		response += *values + "\n";
+	}
+	m_solverProcess->send("(pop 1)\n");
+	return response;
+}
+
+bool SMTLib2Interface::synchronizeSolverProcess()
+{
+	if (m_solverProcess->running())
+		m_solverProcess->send("(reset)\n");
+	else if (!m_solverProcess->start())
+		return false;
+
+	smtAssert(!m_accumulatedOutput.empty(), "");
+	string commands = m_accumulatedOutput.front();
+	for (size_t i = 1; i < m_accumulatedOutput.size(); ++i)
+		commands += "(push 1)\n" + m_accumulatedOutput[i];
+	m_solverProcess->send(commands);
+	m_solverInSync = true;
+	return true;
+}
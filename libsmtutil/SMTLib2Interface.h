@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <libsmtutil/SMTSolverProcess.h>
 #include <libsmtutil/SolverInterface.h>
 
 #include <libsolidity/interface/ReadFile.h>
@@ -27,6 +28,7 @@
 
 #include <cstdio>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -41,10 +43,14 @@ public:
 	SMTLib2Interface(SMTLib2Interface const&) = delete;
 	SMTLib2Interface& operator=(SMTLib2Interface const&) = delete;
 
+	/// If @a _solverCommand is given, the queries are not sent through the callback but
+	/// to a solver process started with that command, which is kept running and is only
+	/// sent the commands that changed since its last query.
 	explicit SMTLib2Interface(
 		std::map<util::h256, std::string> _queryResponses = {},
 		frontend::ReadCallback::Callback _smtCallback = {},
-		std::optional<unsigned> _queryTimeout = {}
+		std::optional<unsigned> _queryTimeout = {},
+		std::optional<std::string> const& _solverCommand = {}
 	);
 
 	void reset() override;
@@ -59,6 +65,9 @@ public:
 
 	std::vector<std::string> unhandledQueries() override { return m_unhandledQueries; }
 
+	/// @returns the SMT-LIB2 script that check() sends to the solver.
+	std::string dumpQuery(std::vector<Expression> const& _expressionsToEvaluate);
+
 	// Used by CHCSmtLib2Interface
 	std::string toSExpr(Expression const& _expr);
 	std::string toSmtLibSort(Sort const& _sort);
@@ -70,14 +79,25 @@ public:
 
 private:
 	void declareFunction(std::string const& _name, SortPointer const& _sort);
+	/// @returns the SMT-LIB2 name of @a _sort and declares the tuple sorts it uses that are not declared yet.
+	std::string sortToSmtLib(Sort const& _sort);
 
 	void write(std::string _data);
 
 	std::string checkSatAndGetValuesCommand(std::vector<Expression> const& _expressionsToEvaluate);
+	/// @returns the commands that define the expressions to evaluate as constants.
+	std::string evaluationCommands(std::vector<Expression> const& _expressionsToEvaluate);
+	std::string getValuesCommand(std::vector<Expression> const& _expressionsToEvaluate);
 	std::vector<std::string> parseValues(std::string::const_iterator _start, std::string::const_iterator _end);
 
 	/// Communicates with the solver via the callback. Throws SMTSolverError on error.
 	std::string querySolver(std::string const& _input);
+	/// Checks the current assertions with the solver process.
+	/// @returns its answer in the same format as querySolver().
+	std::string querySolverProcess(std::vector<Expression> const& _expressionsToEvaluate);
+	/// Starts the solver process or resets it, and sends it all the commands written so far.
+	/// @returns false if the process could not be started.
+	bool synchronizeSolverProcess();
 
 	std::vector<std::string> m_accumulatedOutput;
 	std::map<std::string, SortPointer> m_variables;
@@ -87,11 +107,18 @@ private:
 	/// It needs to be a vector so that the declaration order is kept,
 	/// otherwise solvers cannot parse the queries.
 	std::vector<std::pair<std::string, std::string>> m_userSorts;
+	/// The names of the interned sorts used since the last reset, keyed by their address.
+	std::map<Sort const*, std::string> m_sortNames;
 
 	std::map<util::h256, std::string> m_queryResponses;
 	std::vector<std::string> m_unhandledQueries;
 
 	frontend::ReadCallback::Callback m_smtCallback;
+
+	std::unique_ptr<SMTSolverProcess> m_solverProcess;
+	/// True if the solver process has received all the commands written so far
+	/// and is at the same push level as m_accumulatedOutput.
+	bool m_solverInSync = false;
 };
 
 }
@@ -26,6 +26,13 @@
 #endif
 #include <libsmtutil/SMTLib2Interface.h>
 
+#include <libsolutil/JSON.h>
+#include <libsolutil/Keccak256.h>
+
+#include <condition_variable>
+#include <future>
+#include <mutex>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::util;
@@ -36,38 +43,72 @@ SMTPortfolio::SMTPortfolio(
 	map<h256, string> _smtlib2Responses,
 	frontend::ReadCallback::Callback _smtCallback,
 	[[maybe_unused]] SMTSolverChoice _enabledSolvers,
-	optional<unsigned> _queryTimeout
+	optional<unsigned> _queryTimeout,
+	optional<string> const& _smtlib2Command,
+	shared_ptr<frontend::ArtifactCache> _resultCache
 ):
-	SolverInterface(_queryTimeout)
+	SolverInterface(_queryTimeout),
+	m_resultCache(move(_resultCache))
 {
 	if (_enabledSolvers.smtlib2)
-		m_solvers.emplace_back(make_unique<SMTLib2Interface>(move(_smtlib2Responses), move(_smtCallback), m_queryTimeout));
+	{
+		m_solvers.emplace_back(make_unique<SMTLib2Interface>(
+			move(_smtlib2Responses),
+			move(_smtCallback),
+			m_queryTimeout,
+			_smtlib2Command
+		));
+		m_cacheKeyPrefix += "smtlib2 ";
+	}
 #ifdef HAVE_Z3
 	if (_enabledSolvers.z3 && Z3Interface::available())
+	{
 		m_solvers.emplace_back(make_unique<Z3Interface>(m_queryTimeout));
+		m_cacheKeyPrefix += "z3-" + string(Z3_FULL_VERSION) + " ";
+	}
 #endif
 #ifdef HAVE_CVC4
 	if (_enabledSolvers.cvc4)
+	{
 		m_solvers.emplace_back(make_unique<CVC4Interface>(m_queryTimeout));
+		m_cacheKeyPrefix += "cvc4 ";
+	}
 #endif
+
+	if (m_resultCache && !_enabledSolvers.smtlib2)
+		m_queryPrinter = make_unique<SMTLib2Interface>(map<h256, string>{}, frontend::ReadCallback::Callback{}, m_queryTimeout);
+	m_cacheKeyPrefix = "smt-query " + m_cacheKeyPrefix + (m_queryTimeout ? to_string(*m_queryTimeout) : "rlimit") + "\n";
 }
 
 void SMTPortfolio::reset()
 {
 	for (auto const& s: m_solvers)
 		s->reset();
+	if (m_queryPrinter)
+		m_queryPrinter->reset();
 }
 
 void SMTPortfolio::push()
 {
 	for (auto const& s: m_solvers)
 		s->push();
+	if (m_queryPrinter)
+		m_queryPrinter->push();
 }
 
 void SMTPortfolio::pop()
 {
 	for (auto const& s: m_solvers)
 		s->pop();
+	if (m_queryPrinter)
+		m_queryPrinter->pop();
+}
+
+void SMTPortfolio::setQueryTimeout(unsigned _milliseconds)
+{
+	m_queryTimeout = _milliseconds;
+	for (auto const& s: m_solvers)
+		s->setQueryTimeout(_milliseconds);
 }
 
 void SMTPortfolio::declareVariable(string const& _name, SortPointer const& _sort)
@@ -75,12 +116,16 @@ void SMTPortfolio::declareVariable(string const& _name, SortPointer const& _sort
 	smtAssert(_sort, "");
 	for (auto const& s: m_solvers)
 		s->declareVariable(_name, _sort);
+	if (m_queryPrinter)
+		m_queryPrinter->declareVariable(_name, _sort);
 }
 
 void SMTPortfolio::addAssertion(Expression const& _expr)
 {
 	for (auto const& s: m_solvers)
 		s->addAssertion(_expr);
+	if (m_queryPrinter)
+		m_queryPrinter->addAssertion(_expr);
 }
 
 /*
@@ -112,16 +157,36 @@ void SMTPortfolio::addAssertion(Expression const& _expr)
  *   when it is told that this is a hard query to solve.
  *
  *   If all solvers return ERROR, the result is ERROR.
+ *
+ * The solvers are queried in parallel. The values are taken from the first solver
+ * in the order of m_solvers that answers the query, so the result does not depend
+ * on which solver is the fastest. The solvers that are still running are interrupted
+ * as soon as one solver answers UNSAT or when all solvers before the first one that
+ * answered SAT have finished. The interrupted solvers return UNKNOWN, so a conflict is
+ * only detected between the solvers that finished. Solvers that cannot be interrupted
+ * are still waited for.
 */
 pair<CheckResult, vector<string>> SMTPortfolio::check(vector<Expression> const& _expressionsToEvaluate)
 {
+	optional<h256> key;
+	if (m_resultCache && !m_solvers.empty())
+	{
+		key = cacheKey(_expressionsToEvaluate);
+		if (auto cachedResult = loadResult(*key))
+			return *cachedResult;
+	}
+
+	vector<pair<CheckResult, vector<string>>> results;
+	if (m_solvers.size() > 1)
+		results = race(_expressionsToEvaluate);
+	else
+		for (auto const& s: m_solvers)
+			results.emplace_back(s->check(_expressionsToEvaluate));
+
 	CheckResult lastResult = CheckResult::ERROR;
 	vector<string> finalValues;
-	for (auto const& s: m_solvers)
+	for (auto& [result, values]: results)
 	{
-		CheckResult result;
-		vector<string> values;
-		tie(result, values) = s->check(_expressionsToEvaluate);
 		if (solverAnswered(result))
 		{
 			if (!solverAnswered(lastResult))
@@ -138,6 +203,8 @@ pair<CheckResult, vector<string>> SMTPortfolio::check(vector<Expression> const&
 		else if (result == CheckResult::UNKNOWN && lastResult == CheckResult::ERROR)
 			lastResult = result;
 	}
+	if (key && solverAnswered(lastResult))
+		storeResult(*key, lastResult, finalValues);
 	return make_pair(lastResult, finalValues);
 }
 
@@ -155,3 +222,100 @@ bool SMTPortfolio::solverAnswered(CheckResult result)
 {
 	return result == CheckResult::SATISFIABLE || result == CheckResult::UNSATISFIABLE;
 }
+
+bool SMTPortfolio::resultDecided(vector<CheckResult> const& _results, vector<bool> const& _finished)
+{
+	for (size_t i = 0; i < _results.size(); ++i)
+		if (_finished[i] && _results[i] == CheckResult::UNSATISFIABLE)
+			return true;
+	for (size_t i = 0; i < _results.size(); ++i)
+		if (!_finished[i])
+			return false;
+		else if (solverAnswered(_results[i]))
+			return true;
+	return true;
+}
+
+h256 SMTPortfolio::cacheKey(vector<Expression> const& _expressionsToEvaluate)
+{
+	SMTLib2Interface* printer = m_queryPrinter.get();
+	if (!printer)
+		printer = dynamic_cast<SMTLib2Interface*>(m_solvers.front().get());
+	smtAssert(printer, "");
+	return keccak256(m_cacheKeyPrefix + printer->dumpQuery(_expressionsToEvaluate));
+}
+
+optional<pair<CheckResult, vector<string>>> SMTPortfolio::loadResult(h256 const& _key)
+{
+	optional<string> entry = m_resultCache->load(_key);
+	Json::Value json;
+	if (!entry || !jsonParseStrict(*entry, json) || !json.isObject() || !json["values"].isArray())
+		return nullopt;
+
+	CheckResult result;
+	if (json["result"] == "sat")
+		result = CheckResult::SATISFIABLE;
+	else if (json["result"] == "unsat")
+		result = CheckResult::UNSATISFIABLE;
+	else
+		return nullopt;
+
+	vector<string> values;
+	for (Json::Value const& value: json["values"])
+	{
+		if (!value.isString())
+			return nullopt;
+		values.emplace_back(value.asString());
+	}
+	return make_pair(result, move(values));
+}
+
+void SMTPortfolio::storeResult(h256 const& _key, CheckResult _result, vector<string> const& _values)
+{
+	Json::Value json{Json::objectValue};
+	json["result"] = _result == CheckResult::SATISFIABLE ? "sat" : "unsat";
+	json["values"] = Json::arrayValue;
+	for (string const& value: _values)
+		json["values"].append(value);
+	m_resultCache->store(_key, jsonCompactPrint(json));
+}
+
+vector<pair<CheckResult, vector<string>>> SMTPortfolio::race(vector<Expression> const& _expressionsToEvaluate)
+{
+	if (!m_pool)
+		m_pool = make_unique<ThreadPool>(m_solvers.size());
+
+	vector<pair<CheckResult, vector<string>>> results(m_solvers.size(), {CheckResult::ERROR, {}});
+	vector<CheckResult> finishedResults(m_solvers.size(), CheckResult::ERROR);
+	vector<bool> finished(m_solvers.size(), false);
+	mutex finishedMutex;
+	condition_variable solverFinished;
+
+	vector<future<void>> tasks;
+	for (size_t i = 0; i < m_solvers.size(); ++i)
+		tasks.emplace_back(m_pool->enqueue([&, i]() {
+			// Also marks the solver as finished if it throws, the exception is rethrown by the future.
+			ScopeGuard markFinished{[&]() {
+				lock_guard<mutex> lock(finishedMutex);
+				finishedResults[i] = results[i].first;
+				finished[i] = true;
+				solverFinished.notify_one();
+			}};
+			results[i] = m_solvers[i]->check(_expressionsToEvaluate);
+		}));
+
+	{
+		unique_lock<mutex> lock(finishedMutex);
+		solverFinished.wait(lock, [&]() { return resultDecided(finishedResults, finished); });
+		for (size_t i = 0; i < m_solvers.size(); ++i)
+			if (!finished[i])
+				m_solvers[i]->interrupt();
+	}
+
+	// All tasks have to finish before an exception is rethrown, since they refer to the local variables.
+	for (future<void>& task: tasks)
+		task.wait();
+	for (future<void>& task: tasks)
+		task.get();
+	return results;
+}
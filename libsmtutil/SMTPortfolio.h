@@ -19,9 +19,12 @@
 #pragma once
 
 
+#include <libsmtutil/SMTLib2Interface.h>
 #include <libsmtutil/SolverInterface.h>
+#include <libsolidity/interface/ArtifactCache.h>
 #include <libsolidity/interface/ReadFile.h>
 #include <libsolutil/FixedHash.h>
+#include <libsolutil/ThreadPool.h>
 
 #include <map>
 #include <vector>
@@ -34,6 +37,10 @@ namespace solidity::smtutil
  * propagating the functionalities to all solvers.
  * It also checks whether different solvers give conflicting answers
  * to SMT queries.
+ * The solvers are queried in parallel and the ones that are still running
+ * are interrupted, if they support it, as soon as the result is decided.
+ * If a result cache is given, answered queries are stored in it, keyed by the hash of
+ * their SMT-LIB2 script, the solvers and the timeout, and are not solved again.
  */
 class SMTPortfolio: public SolverInterface
 {
@@ -46,7 +53,9 @@ public:
 		std::map<util::h256, std::string> _smtlib2Responses = {},
 		frontend::ReadCallback::Callback _smtCallback = {},
 		SMTSolverChoice _enabledSolvers = SMTSolverChoice::All(),
-		std::optional<unsigned> _queryTimeout = {}
+		std::optional<unsigned> _queryTimeout = {},
+		std::optional<std::string> const& _smtlib2Command = {},
+		std::shared_ptr<frontend::ArtifactCache> _resultCache = {}
 	);
 
 	void reset() override;
@@ -62,10 +71,31 @@ public:
 
 	std::vector<std::string> unhandledQueries() override;
 	size_t solvers() override { return m_solvers.size(); }
+	void setQueryTimeout(unsigned _milliseconds) override;
 private:
 	static bool solverAnswered(CheckResult result);
+	/// @returns true if the result of a query can no longer change once the solvers
+	/// that are not @a _finished yet answer, given the @a _results of the finished ones.
+	static bool resultDecided(std::vector<CheckResult> const& _results, std::vector<bool> const& _finished);
+
+	/// Queries all solvers in parallel, interrupting them once the result is decided.
+	/// @returns the result of each solver.
+	std::vector<std::pair<CheckResult, std::vector<std::string>>> race(std::vector<Expression> const& _expressionsToEvaluate);
+
+	/// @returns the key of the query in the result cache.
+	util::h256 cacheKey(std::vector<Expression> const& _expressionsToEvaluate);
+	std::optional<std::pair<CheckResult, std::vector<std::string>>> loadResult(util::h256 const& _key);
+	void storeResult(util::h256 const& _key, CheckResult _result, std::vector<std::string> const& _values);
 
 	std::vector<std::unique_ptr<SolverInterface>> m_solvers;
+	/// Runs the solvers during a race. Only created once the first query is checked.
+	std::unique_ptr<util::ThreadPool> m_pool;
+
+	std::shared_ptr<frontend::ArtifactCache> m_resultCache;
+	/// Prints the queries for the cache keys if the SMT-LIB2 interface is not one of the solvers.
+	std::unique_ptr<SMTLib2Interface> m_queryPrinter;
+	/// Identifies the solvers and the timeout in the cache keys.
+	std::string m_cacheKeyPrefix;
 
 	std::vector<Expression> m_assertions;
 };
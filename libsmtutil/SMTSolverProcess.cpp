@@ -0,0 +1,212 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsmtutil/SMTSolverProcess.h>
+
+#include <libsmtutil/Exceptions.h>
+
+#include <boost/algorithm/string/classification.hpp>
+#include <boost/algorithm/string/split.hpp>
+
+#include <algorithm>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::smtutil;
+
+namespace bp = boost::process;
+
+namespace
+{
+
+/// How much longer than the query timeout the solver may take to answer.
+chrono::milliseconds const gracePeriod{1000};
+
+/// @returns the number of parentheses @a _line opens minus the number it closes,
+/// ignoring the ones in quoted symbols and string literals.
+int parenthesesBalance(string const& _line)
+{
+	int balance = 0;
+	char quote = 0;
+	for (char c: _line)
+		if (quote)
+		{
+			if (c == quote)
+				quote = 0;
+		}
+		else if (c == '|' || c == '"')
+			quote = c;
+		else if (c == '(')
+			++balance;
+		else if (c == ')')
+			--balance;
+	return balance;
+}
+
+}
+
+SMTSolverProcess::SMTSolverProcess(string const& _command, optional<unsigned> _queryTimeout)
+{
+	boost::algorithm::split(m_arguments, _command, boost::algorithm::is_space(), boost::algorithm::token_compress_on);
+	m_arguments.erase(remove(m_arguments.begin(), m_arguments.end(), ""), m_arguments.end());
+	smtAssert(!m_arguments.empty(), "Empty SMT solver command.");
+	m_executable = m_arguments.front();
+	m_arguments.erase(m_arguments.begin());
+
+	if (_queryTimeout)
+	{
+		m_answerTimeout = chrono::milliseconds(*_queryTimeout) + gracePeriod;
+		m_watchdog = thread([this] { watch(); });
+	}
+}
+
+SMTSolverProcess::~SMTSolverProcess()
+{
+	stop();
+	if (m_watchdog.joinable())
+	{
+		{
+			lock_guard<mutex> lock(m_mutex);
+			m_stopWatchdog = true;
+		}
+		m_deadlineChanged.notify_one();
+		m_watchdog.join();
+	}
+}
+
+bool SMTSolverProcess::start()
+{
+	stop();
+
+	auto input = make_unique<bp::opstream>();
+	auto output = make_unique<bp::ipstream>();
+	unique_ptr<bp::child> child;
+	try
+	{
+		boost::filesystem::path executable = m_executable;
+		if (!executable.has_parent_path())
+			executable = bp::search_path(m_executable);
+		if (executable.empty())
+			return false;
+		child = make_unique<bp::child>(
+			executable,
+			bp::args = m_arguments,
+			bp::std_in < *input,
+			bp::std_out > *output,
+			bp::std_err > bp::null
+		);
+	}
+	catch (bp::process_error const&)
+	{
+		return false;
+	}
+
+	lock_guard<mutex> lock(m_mutex);
+	m_input = move(input);
+	m_output = move(output);
+	m_child = move(child);
+	return true;
+}
+
+void SMTSolverProcess::stop()
+{
+	lock_guard<mutex> lock(m_mutex);
+	if (!m_child)
+		return;
+
+	m_input->pipe().close();
+	error_code ignored;
+	if (m_child->running(ignored))
+		m_child->terminate(ignored);
+	m_child.reset();
+	m_input.reset();
+	m_output.reset();
+}
+
+void SMTSolverProcess::send(string const& _commands)
+{
+	if (m_child)
+		*m_input << _commands;
+}
+
+optional<string> SMTSolverProcess::query(string const& _command)
+{
+	error_code ignored;
+	if (!m_child || !m_child->running(ignored))
+	{
+		stop();
+		return nullopt;
+	}
+
+	*m_input << _command << flush;
+	if (m_answerTimeout)
+	{
+		{
+			lock_guard<mutex> lock(m_mutex);
+			m_deadline = chrono::steady_clock::now() + *m_answerTimeout;
+		}
+		m_deadlineChanged.notify_one();
+	}
+
+	string answer;
+	string line;
+	int balance = 0;
+	bool complete = false;
+	while (getline(*m_output, line))
+	{
+		if (!answer.empty())
+			answer += "\n";
+		answer += line;
+		balance += parenthesesBalance(line);
+		if (balance <= 0 && !answer.empty())
+		{
+			complete = true;
+			break;
+		}
+	}
+
+	if (m_answerTimeout)
+	{
+		lock_guard<mutex> lock(m_mutex);
+		m_deadline.reset();
+	}
+
+	if (!complete || !*m_input)
+	{
+		stop();
+		return nullopt;
+	}
+	return answer;
+}
+
+void SMTSolverProcess::watch()
+{
+	unique_lock<mutex> lock(m_mutex);
+	while (!m_stopWatchdog)
+		if (!m_deadline)
+			m_deadlineChanged.wait(lock);
+		else if (chrono::steady_clock::now() < *m_deadline)
+			m_deadlineChanged.wait_until(lock, *m_deadline);
+		else
+		{
+			m_deadline.reset();
+			error_code ignored;
+			if (m_child)
+				m_child->terminate(ignored);
+		}
+}
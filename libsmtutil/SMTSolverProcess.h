@@ -0,0 +1,90 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#pragma once
+
+#include <boost/process.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace solidity::smtutil
+{
+
+/**
+ * An SMT solver that runs as a subprocess and reads SMT-LIB2 commands from its
+ * standard input, so that it can keep its state between queries and be sent
+ * only the commands that changed.
+ * If a query timeout is given, the process is ended when an answer takes more
+ * than a grace period longer than the timeout, in case the solver ignores it.
+ */
+class SMTSolverProcess
+{
+public:
+	/// Noncopyable.
+	SMTSolverProcess(SMTSolverProcess const&) = delete;
+	SMTSolverProcess& operator=(SMTSolverProcess const&) = delete;
+
+	/// @param _command the solver binary and its arguments, separated by spaces.
+	/// @param _queryTimeout the timeout per query in milliseconds.
+	explicit SMTSolverProcess(std::string const& _command, std::optional<unsigned> _queryTimeout = {});
+	~SMTSolverProcess();
+
+	/// @returns true if the process was started and has not failed since.
+	bool running() const { return m_child != nullptr; }
+	/// Starts the process, ending it first if it is running.
+	/// @returns false if it could not be started.
+	bool start();
+	/// Ends the process. The state of the solver is lost.
+	void stop();
+
+	/// Sends @a _commands, which must not produce any output, without waiting for the solver.
+	void send(std::string const& _commands);
+	/// Sends @a _command and reads its answer, that is, the next line, or the lines
+	/// up to the one that closes all the parentheses the answer opens.
+	/// @returns the answer without the final newline, or nullopt if the process failed
+	/// or had to be ended because of the timeout, in which case it is not running anymore.
+	std::optional<std::string> query(std::string const& _command);
+
+private:
+	/// Ends the process once the deadline of the current answer passes.
+	void watch();
+
+	std::string m_executable;
+	std::vector<std::string> m_arguments;
+	std::optional<std::chrono::milliseconds> m_answerTimeout;
+
+	std::unique_ptr<boost::process::opstream> m_input;
+	std::unique_ptr<boost::process::ipstream> m_output;
+	std::unique_ptr<boost::process::child> m_child;
+
+	/// Guards m_child and m_deadline against the watchdog thread.
+	std::mutex m_mutex;
+	std::condition_variable m_deadlineChanged;
+	std::optional<std::chrono::steady_clock::time_point> m_deadline;
+	bool m_stopWatchdog = false;
+	std::thread m_watchdog;
+};
+
+}
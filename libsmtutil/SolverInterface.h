@@ -115,6 +115,45 @@ enum class CheckResult
 	SATISFIABLE, UNSATISFIABLE, UNKNOWN, CONFLICTING, ERROR
 };
 
+class Expression;
+
+/**
+ * The arguments of an Expression. They cannot be changed once constructed
+ * and are shared by all copies of the expression. Copying an expression
+ * therefore does not copy its subexpressions, and an encoding built from
+ * copies of expressions is a DAG instead of a tree.
+ */
+class ExpressionList
+{
+public:
+	using value_type = Expression;
+	using const_iterator = std::vector<Expression>::const_iterator;
+
+	ExpressionList() = default;
+	ExpressionList(std::vector<Expression> _expressions);
+
+	operator std::vector<Expression> const&() const { return expressions(); }
+
+	bool empty() const { return !m_expressions; }
+	size_t size() const { return expressions().size(); }
+	Expression const& at(size_t _index) const { return expressions().at(_index); }
+	Expression const& operator[](size_t _index) const { return expressions()[_index]; }
+	Expression const& front() const { return expressions().front(); }
+	Expression const& back() const { return expressions().back(); }
+	const_iterator begin() const { return expressions().begin(); }
+	const_iterator end() const { return expressions().end(); }
+
+	/// @returns a pointer that is the same for the copies of this list and different for other
+	/// lists that are alive, or nullptr if the list is empty.
+	void const* identity() const { return m_expressions.get(); }
+
+private:
+	std::vector<Expression> const& expressions() const;
+
+	/// Null if the list is empty, so that leaves do not allocate.
+	std::shared_ptr<std::vector<Expression> const> m_expressions;
+};
+
 /// C++ representation of an SMTLIB2 expression.
 class Expression
 {
@@ -486,13 +525,17 @@ public:
 	}
 
 	std::string name;
-	std::vector<Expression> arguments;
+	ExpressionList arguments;
 	SortPointer sort;
 
 private:
 	/// Manual constructors, should only be used by SolverInterface and this class itself.
 	Expression(std::string _name, std::vector<Expression> _arguments, Kind _kind):
-		Expression(std::move(_name), std::move(_arguments), std::make_shared<Sort>(_kind)) {}
+		Expression(
+			std::move(_name),
+			std::move(_arguments),
+			_kind == Kind::Bool ? SortProvider::boolSort : std::make_shared<Sort>(_kind)
+		) {}
 
 	explicit Expression(std::string _name, Kind _kind):
 		Expression(std::move(_name), std::vector<Expression>{}, _kind) {}
@@ -502,6 +545,18 @@ private:
 		Expression(std::move(_name), std::vector<Expression>{std::move(_arg1), std::move(_arg2)}, _kind) {}
 };
 
+inline ExpressionList::ExpressionList(std::vector<Expression> _expressions)
+{
+	if (!_expressions.empty())
+		m_expressions = std::make_shared<std::vector<Expression> const>(std::move(_expressions));
+}
+
+inline std::vector<Expression> const& ExpressionList::expressions() const
+{
+	static std::vector<Expression> const empty;
+	return m_expressions ? *m_expressions : empty;
+}
+
 DEV_SIMPLE_EXCEPTION(SolverError);
 
 class SolverInterface
@@ -531,12 +586,19 @@ public:
 	virtual std::pair<CheckResult, std::vector<std::string>>
 	check(std::vector<Expression> const& _expressionsToEvaluate) = 0;
 
+	/// Called from another thread to stop a running call to check(), which then returns UNKNOWN.
+	/// Does nothing if the solver cannot be interrupted or is not checking a query.
+	virtual void interrupt() {}
+
 	/// @returns a list of queries that the system was not able to respond to.
 	virtual std::vector<std::string> unhandledQueries() { return {}; }
 
 	/// @returns how many SMT solvers this interface has.
 	virtual size_t solvers() { return 1; }
 
+	/// Sets the timeout of the following queries in milliseconds.
+	virtual void setQueryTimeout(unsigned _milliseconds) { m_queryTimeout = _milliseconds; }
+
 protected:
 	std::optional<unsigned> m_queryTimeout;
 };
@@ -19,11 +19,58 @@
 
 #include <libsmtutil/Sorts.h>
 
+#include <libsolutil/CommonData.h>
+
+#include <map>
+#include <mutex>
+#include <tuple>
+
 using namespace std;
 
 namespace solidity::smtutil
 {
 
+namespace
+{
+
+/// The sorts created by the factories of SortProvider, keyed by their arguments with the
+/// component sorts by address. The component sorts are kept alive by the sorts, so their
+/// addresses cannot be reused.
+struct SortTable
+{
+	mutex sortsMutex;
+	map<tuple<vector<Sort const*>, Sort const*>, shared_ptr<FunctionSort>> functionSorts;
+	map<tuple<Sort const*, Sort const*>, shared_ptr<ArraySort>> arraySorts;
+	map<Sort const*, shared_ptr<SortSort>> sortSorts;
+	map<tuple<string, vector<string>, vector<Sort const*>>, shared_ptr<TupleSort>> tupleSorts;
+};
+
+SortTable& sortTable()
+{
+	// Intentionally leaked, so that the sorts outlive all static objects using them.
+	static SortTable* table = new SortTable();
+	return *table;
+}
+
+vector<Sort const*> addresses(vector<SortPointer> const& _sorts)
+{
+	return util::applyMap(_sorts, [](SortPointer const& _sort) { return static_cast<Sort const*>(_sort.get()); });
+}
+
+template<typename SortType, typename Key, typename... Args>
+shared_ptr<SortType> intern(map<Key, shared_ptr<SortType>>& _sorts, Key _key, Args&&... _args)
+{
+	auto [it, inserted] = _sorts.try_emplace(move(_key));
+	if (inserted)
+	{
+		it->second = make_shared<SortType>(std::forward<Args>(_args)...);
+		it->second->interned = true;
+	}
+	return it->second;
+}
+
+}
+
 shared_ptr<Sort> const SortProvider::boolSort{make_shared<Sort>(Kind::Bool)};
 shared_ptr<IntSort> const SortProvider::uintSort{make_shared<IntSort>(false)};
 shared_ptr<IntSort> const SortProvider::sintSort{make_shared<IntSort>(true)};
@@ -37,4 +84,40 @@ shared_ptr<IntSort> SortProvider::intSort(bool _signed)
 
 shared_ptr<BitVectorSort> const SortProvider::bitVectorSort{make_shared<BitVectorSort>(256)};
 
+shared_ptr<FunctionSort> SortProvider::functionSort(vector<SortPointer> _domain, SortPointer _codomain)
+{
+	SortTable& table = sortTable();
+	lock_guard lock(table.sortsMutex);
+	auto key = make_tuple(addresses(_domain), static_cast<Sort const*>(_codomain.get()));
+	return intern(table.functionSorts, move(key), move(_domain), move(_codomain));
+}
+
+shared_ptr<ArraySort> SortProvider::arraySort(SortPointer _domain, SortPointer _range)
+{
+	SortTable& table = sortTable();
+	lock_guard lock(table.sortsMutex);
+	auto key = make_tuple(static_cast<Sort const*>(_domain.get()), static_cast<Sort const*>(_range.get()));
+	return intern(table.arraySorts, move(key), move(_domain), move(_range));
+}
+
+shared_ptr<SortSort> SortProvider::sortSort(SortPointer _inner)
+{
+	SortTable& table = sortTable();
+	lock_guard lock(table.sortsMutex);
+	Sort const* key = _inner.get();
+	return intern(table.sortSorts, key, move(_inner));
+}
+
+shared_ptr<TupleSort> SortProvider::tupleSort(
+	string _name,
+	vector<string> _members,
+	vector<SortPointer> _components
+)
+{
+	SortTable& table = sortTable();
+	lock_guard lock(table.sortsMutex);
+	auto key = make_tuple(_name, _members, addresses(_components));
+	return intern(table.tupleSorts, move(key), move(_name), move(_members), move(_components));
+}
+
 }
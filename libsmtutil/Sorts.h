@@ -22,7 +22,9 @@
 
 #include <libsolutil/Common.h>
 
+#include <map>
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace solidity::smtutil
@@ -47,6 +49,10 @@ struct Sort
 	virtual bool operator==(Sort const& _other) const { return kind == _other.kind; }
 
 	Kind const kind;
+	/// Whether the sort was created by one of the factories of SortProvider, which return the
+	/// same object for equal arguments and keep it alive until the end of the process.
+	/// Solver interfaces can therefore cache their translation of the sort by its address.
+	bool interned = false;
 };
 using SortPointer = std::shared_ptr<Sort>;
 
@@ -86,6 +92,8 @@ struct FunctionSort: public Sort
 		Sort(Kind::Function), domain(std::move(_domain)), codomain(std::move(_codomain)) {}
 	bool operator==(Sort const& _other) const override
 	{
+		if (this == &_other)
+			return true;
 		if (!Sort::operator==(_other))
 			return false;
 		auto _otherFunction = dynamic_cast<FunctionSort const*>(&_other);
@@ -116,6 +124,8 @@ struct ArraySort: public Sort
 		Sort(Kind::Array), domain(std::move(_domain)), range(std::move(_range)) {}
 	bool operator==(Sort const& _other) const override
 	{
+		if (this == &_other)
+			return true;
 		if (!Sort::operator==(_other))
 			return false;
 		auto _otherArray = dynamic_cast<ArraySort const*>(&_other);
@@ -136,6 +146,8 @@ struct SortSort: public Sort
 	SortSort(SortPointer _inner): Sort(Kind::Sort), inner(std::move(_inner)) {}
 	bool operator==(Sort const& _other) const override
 	{
+		if (this == &_other)
+			return true;
 		if (!Sort::operator==(_other))
 			return false;
 		auto _otherSort = dynamic_cast<SortSort const*>(&_other);
@@ -171,6 +183,8 @@ struct TupleSort: public Sort
 
 	bool operator==(Sort const& _other) const override
 	{
+		if (this == &_other)
+			return true;
 		if (!Sort::operator==(_other))
 			return false;
 		auto _otherTuple = dynamic_cast<TupleSort const*>(&_other);
@@ -198,7 +212,13 @@ struct TupleSort: public Sort
 };
 
 
-/** Frequently used sorts.*/
+/**
+ * Frequently used sorts and factories for the composite sorts.
+ *
+ * The factories return the same sort for arguments with the same component sorts (by address),
+ * so that sorts are shared between all variables and expressions using them and equal sorts
+ * can be compared by address.
+ */
 struct SortProvider
 {
 	static std::shared_ptr<Sort> const boolSort;
@@ -206,6 +226,15 @@ struct SortProvider
 	static std::shared_ptr<IntSort> const sintSort;
 	static std::shared_ptr<IntSort> intSort(bool _signed = false);
 	static std::shared_ptr<BitVectorSort> const bitVectorSort;
+
+	static std::shared_ptr<FunctionSort> functionSort(std::vector<SortPointer> _domain, SortPointer _codomain);
+	static std::shared_ptr<ArraySort> arraySort(SortPointer _domain, SortPointer _range);
+	static std::shared_ptr<SortSort> sortSort(SortPointer _inner);
+	static std::shared_ptr<TupleSort> tupleSort(
+		std::string _name,
+		std::vector<std::string> _members,
+		std::vector<SortPointer> _components
+	);
 };
 
 }
@@ -48,9 +48,19 @@ Z3CHCInterface::Z3CHCInterface(optional<unsigned> _queryTimeout):
 	else
 		z3::set_param("rlimit", Z3Interface::resourceLimit);
 
+	m_z3Interface->recordDeclarations();
 	setSpacerOptions();
 }
 
+void Z3CHCInterface::setQueryTimeout(unsigned _milliseconds)
+{
+	m_queryTimeout = _milliseconds;
+	m_z3Interface->setQueryTimeout(_milliseconds);
+	z3::params p(*m_context);
+	p.set("timeout", _milliseconds);
+	m_solver.set(p);
+}
+
 void Z3CHCInterface::declareVariable(string const& _name, SortPointer const& _sort)
 {
 	smtAssert(_sort, "");
@@ -59,11 +69,13 @@ void Z3CHCInterface::declareVariable(string const& _name, SortPointer const& _so
 
 void Z3CHCInterface::registerRelation(Expression const& _expr)
 {
+	m_additions.push_back({m_z3Interface->declarations().size(), Addition::Kind::Relation, _expr, {}, {}});
 	m_solver.register_relation(m_z3Interface->functions().at(_expr.name));
 }
 
 void Z3CHCInterface::addRule(Expression const& _expr, string const& _name)
 {
+	m_additions.push_back({m_z3Interface->declarations().size(), Addition::Kind::Rule, _expr, _name, {}});
 	z3::expr rule = m_z3Interface->toZ3Expr(_expr);
 	if (m_z3Interface->constants().empty())
 		m_solver.add_rule(rule, m_context->str_symbol(_name.c_str()));
@@ -128,6 +140,56 @@ tuple<CheckResult, Expression, CHCSolverInterface::CexGraph> Z3CHCInterface::que
 	return {result, Expression(true), {}};
 }
 
+void Z3CHCInterface::addInvariant(Expression const& _predicate, Expression const& _invariant)
+{
+	m_additions.push_back({m_z3Interface->declarations().size(), Addition::Kind::Invariant, _predicate, {}, _invariant});
+	z3::expr predicate = m_z3Interface->toZ3Expr(_predicate);
+	z3::expr invariant = m_z3Interface->toZ3Expr(_invariant);
+	// Spacer expects the lemma over the de Bruijn indices of the predicate's arguments.
+	z3::expr_vector arguments(*m_context);
+	z3::expr_vector indices(*m_context);
+	for (unsigned i = 0; i < predicate.num_args(); ++i)
+	{
+		arguments.push_back(predicate.arg(i));
+		indices.push_back(z3::expr(*m_context, Z3_mk_bound(*m_context, i, predicate.arg(i).get_sort())));
+	}
+	z3::func_decl relation = predicate.decl();
+	z3::expr lemma = invariant.substitute(arguments, indices);
+	// Level -1 is the fixedpoint, that is, the lemma holds for every unfolding of the predicate.
+	m_solver.add_cover(-1, relation, lemma);
+}
+
+unique_ptr<Z3CHCInterface> Z3CHCInterface::clone() const
+{
+	// Replaying the declarations in their original order between the relations and rules
+	// quantifies every rule over the same variables as in this solver.
+	auto solver = make_unique<Z3CHCInterface>(m_queryTimeout);
+	auto const& declarations = m_z3Interface->declarations();
+	size_t declared = 0;
+	auto declareUpTo = [&](size_t _count) {
+		for (; declared < _count; ++declared)
+			solver->declareVariable(declarations[declared].first, declarations[declared].second);
+	};
+	for (Addition const& addition: m_additions)
+	{
+		declareUpTo(addition.declarationsBefore);
+		switch (addition.kind)
+		{
+		case Addition::Kind::Relation:
+			solver->registerRelation(addition.expression);
+			break;
+		case Addition::Kind::Rule:
+			solver->addRule(addition.expression, addition.ruleName);
+			break;
+		case Addition::Kind::Invariant:
+			solver->addInvariant(addition.expression, *addition.invariant);
+			break;
+		}
+	}
+	declareUpTo(declarations.size());
+	return solver;
+}
+
 void Z3CHCInterface::setSpacerOptions(bool _preProcessing)
 {
 	// Spacer options.
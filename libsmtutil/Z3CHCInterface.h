@@ -25,6 +25,7 @@
 #include <libsmtutil/CHCSolverInterface.h>
 #include <libsmtutil/Z3Interface.h>
 
+#include <optional>
 #include <tuple>
 #include <vector>
 
@@ -45,11 +46,34 @@ public:
 
 	std::tuple<CheckResult, Expression, CexGraph> query(Expression const& _expr) override;
 
+	/// Adds the invariant as a Spacer lemma of the fixedpoint of the predicate.
+	/// The arguments of _predicate must be distinct variables.
+	void addInvariant(Expression const& _predicate, Expression const& _invariant) override;
+
+	void setQueryTimeout(unsigned _milliseconds) override;
+
 	Z3Interface* z3Interface() const { return m_z3Interface.get(); }
 
 	void setSpacerOptions(bool _preProcessing = true);
 
+	/// @returns a new solver with the same variables, relations and rules, which can be
+	/// queried independently of this one, e.g. on a different thread.
+	/// Has to be called on the thread that created this solver, since it sets global Z3 parameters.
+	std::unique_ptr<Z3CHCInterface> clone() const;
+
 private:
+	/// A relation, rule or invariant together with the number of variables declared before it was added.
+	struct Addition
+	{
+		enum class Kind { Relation, Rule, Invariant };
+		size_t declarationsBefore;
+		Kind kind;
+		/// The relation, the rule or the predicate application the invariant is about.
+		Expression expression;
+		std::string ruleName;
+		std::optional<Expression> invariant;
+	};
+
 	/// Constructs a nonlinear counterexample graph from the refutation.
 	CHCSolverInterface::CexGraph cexGraph(z3::expr const& _proof);
 	/// @returns the fact from a proof node.
@@ -65,6 +89,8 @@ private:
 	z3::context* m_context;
 	// Horn solver.
 	z3::fixedpoint m_solver;
+	/// The relations and rules in the order they were added, used to clone the solver.
+	std::vector<Addition> m_additions;
 
 	std::tuple<unsigned, unsigned, unsigned, unsigned> m_version = std::tuple(0, 0, 0, 0);
 };
@@ -55,9 +55,22 @@ void Z3Interface::reset()
 {
 	m_constants.clear();
 	m_functions.clear();
+	m_translations.clear();
+	m_structuralTranslations.clear();
+	m_declarations.clear();
 	m_solver.reset();
 }
 
+void Z3Interface::setQueryTimeout(unsigned _milliseconds)
+{
+	m_queryTimeout = _milliseconds;
+	m_context.set("timeout", int(_milliseconds));
+	// The context parameter only applies to solvers created after it is set.
+	z3::params p(m_context);
+	p.set("timeout", _milliseconds);
+	m_solver.set(p);
+}
+
 void Z3Interface::push()
 {
 	m_solver.push();
@@ -72,11 +85,26 @@ void Z3Interface::declareVariable(string const& _name, SortPointer const& _sort)
 {
 	smtAssert(_sort, "");
 	if (_sort->kind == Kind::Function)
+	{
+		if (m_recordDeclarations)
+			m_declarations.emplace_back(_name, _sort);
 		declareFunction(_name, *_sort);
-	else if (m_constants.count(_name))
-		m_constants.at(_name) = m_context.constant(_name.c_str(), z3Sort(*_sort));
+		return;
+	}
+
+	// The encoding declares a variable again every time it reads its current SSA index,
+	// so only the first declaration with a given sort creates the constant.
+	z3::sort sort = z3Sort(*_sort);
+	auto constant = m_constants.find(_name);
+	if (constant != m_constants.end() && z3::eq(constant->second.get_sort(), sort))
+		return;
+
+	if (m_recordDeclarations)
+		m_declarations.emplace_back(_name, _sort);
+	if (constant != m_constants.end())
+		constant->second = m_context.constant(_name.c_str(), sort);
 	else
-		m_constants.emplace(_name, m_context.constant(_name.c_str(), z3Sort(*_sort)));
+		m_constants.emplace(_name, m_context.constant(_name.c_str(), sort));
 }
 
 void Z3Interface::declareFunction(string const& _name, Sort const& _sort)
@@ -141,23 +169,51 @@ pair<CheckResult, vector<string>> Z3Interface::check(vector<Expression> const& _
 
 z3::expr Z3Interface::toZ3Expr(Expression const& _expr)
 {
-	if (_expr.arguments.empty() && m_constants.count(_expr.name))
-		return m_constants.at(_expr.name);
+	if (_expr.arguments.empty())
+	{
+		if (auto constant = m_constants.find(_expr.name); constant != m_constants.end())
+			return constant->second;
+		return translate(_expr, z3::expr_vector(m_context));
+	}
+
+	// The copies of an expression share their arguments, so a subexpression that
+	// occurs in many places of an encoding is only translated once.
+	auto key = make_tuple(_expr.arguments.identity(), _expr.name, _expr.sort.get());
+	if (auto translation = m_translations.find(key); translation != m_translations.end())
+		return translation->second.second;
+
 	z3::expr_vector arguments(m_context);
+	vector<unsigned> argumentIds;
 	for (auto const& arg: _expr.arguments)
+	{
 		arguments.push_back(toZ3Expr(arg));
+		argumentIds.push_back(arguments.back().id());
+	}
 
+	// Expressions that were built separately but are equal have the same operator, sort
+	// and translated arguments, since Z3 shares equal terms.
+	auto structuralKey = make_tuple(_expr.name, _expr.sort.get(), move(argumentIds));
+	auto translation = m_structuralTranslations.find(structuralKey);
+	if (translation == m_structuralTranslations.end())
+		translation = m_structuralTranslations.emplace(move(structuralKey), translate(_expr, arguments)).first;
+	z3::expr result = translation->second;
+	m_translations.emplace(move(key), make_pair(_expr.arguments, result));
+	return result;
+}
+
+z3::expr Z3Interface::translate(Expression const& _expr, z3::expr_vector const& _arguments)
+{
 	try
 	{
 		string const& n = _expr.name;
 		if (m_functions.count(n))
-			return m_functions.at(n)(arguments);
+			return m_functions.at(n)(_arguments);
 		else if (m_constants.count(n))
 		{
-			smtAssert(arguments.empty(), "");
+			smtAssert(_arguments.empty(), "");
 			return m_constants.at(n);
 		}
-		else if (arguments.empty())
+		else if (_arguments.empty())
 		{
 			if (n == "true")
 				return m_context.bool_val(true);
@@ -182,83 +238,83 @@ z3::expr Z3Interface::toZ3Expr(Expression const& _expr)
 
 		smtAssert(_expr.hasCorrectArity(), "");
 		if (n == "ite")
-			return z3::ite(arguments[0], arguments[1], arguments[2]);
+			return z3::ite(_arguments[0], _arguments[1], _arguments[2]);
 		else if (n == "not")
-			return !arguments[0];
+			return !_arguments[0];
 		else if (n == "and")
-			return arguments[0] && arguments[1];
+			return _arguments[0] && _arguments[1];
 		else if (n == "or")
-			return arguments[0] || arguments[1];
+			return _arguments[0] || _arguments[1];
 		else if (n == "=>")
-			return z3::implies(arguments[0], arguments[1]);
+			return z3::implies(_arguments[0], _arguments[1]);
 		else if (n == "=")
-			return arguments[0] == arguments[1];
+			return _arguments[0] == _arguments[1];
 		else if (n == "<")
-			return arguments[0] < arguments[1];
+			return _arguments[0] < _arguments[1];
 		else if (n == "<=")
-			return arguments[0] <= arguments[1];
+			return _arguments[0] <= _arguments[1];
 		else if (n == ">")
-			return arguments[0] > arguments[1];
+			return _arguments[0] > _arguments[1];
 		else if (n == ">=")
-			return arguments[0] >= arguments[1];
+			return _arguments[0] >= _arguments[1];
 		else if (n == "+")
-			return arguments[0] + arguments[1];
+			return _arguments[0] + _arguments[1];
 		else if (n == "-")
-			return arguments[0] - arguments[1];
+			return _arguments[0] - _arguments[1];
 		else if (n == "*")
-			return arguments[0] * arguments[1];
+			return _arguments[0] * _arguments[1];
 		else if (n == "div")
-			return arguments[0] / arguments[1];
+			return _arguments[0] / _arguments[1];
 		else if (n == "mod")
-			return z3::mod(arguments[0], arguments[1]);
+			return z3::mod(_arguments[0], _arguments[1]);
 		else if (n == "bvnot")
-			return ~arguments[0];
+			return ~_arguments[0];
 		else if (n == "bvand")
-			return arguments[0] & arguments[1];
+			return _arguments[0] & _arguments[1];
 		else if (n == "bvor")
-			return arguments[0] | arguments[1];
+			return _arguments[0] | _arguments[1];
 		else if (n == "bvxor")
-			return arguments[0] ^ arguments[1];
+			return _arguments[0] ^ _arguments[1];
 		else if (n == "bvshl")
-			return z3::shl(arguments[0], arguments[1]);
+			return z3::shl(_arguments[0], _arguments[1]);
 		else if (n == "bvlshr")
-			return z3::lshr(arguments[0], arguments[1]);
+			return z3::lshr(_arguments[0], _arguments[1]);
 		else if (n == "bvashr")
-			return z3::ashr(arguments[0], arguments[1]);
+			return z3::ashr(_arguments[0], _arguments[1]);
 		else if (n == "int2bv")
 		{
 			size_t size = std::stoul(_expr.arguments[1].name);
-			return z3::int2bv(static_cast<unsigned>(size), arguments[0]);
+			return z3::int2bv(static_cast<unsigned>(size), _arguments[0]);
 		}
 		else if (n == "bv2int")
 		{
 			auto intSort = dynamic_pointer_cast<IntSort>(_expr.sort);
 			smtAssert(intSort, "");
-			return z3::bv2int(arguments[0], intSort->isSigned);
+			return z3::bv2int(_arguments[0], intSort->isSigned);
 		}
 		else if (n == "select")
-			return z3::select(arguments[0], arguments[1]);
+			return z3::select(_arguments[0], _arguments[1]);
 		else if (n == "store")
-			return z3::store(arguments[0], arguments[1], arguments[2]);
+			return z3::store(_arguments[0], _arguments[1], _arguments[2]);
 		else if (n == "const_array")
 		{
 			shared_ptr<SortSort> sortSort = std::dynamic_pointer_cast<SortSort>(_expr.arguments[0].sort);
 			smtAssert(sortSort, "");
 			auto arraySort = dynamic_pointer_cast<ArraySort>(sortSort->inner);
 			smtAssert(arraySort && arraySort->domain, "");
-			return z3::const_array(z3Sort(*arraySort->domain), arguments[1]);
+			return z3::const_array(z3Sort(*arraySort->domain), _arguments[1]);
 		}
 		else if (n == "tuple_get")
 		{
 			size_t index = stoul(_expr.arguments[1].name);
-			return z3::func_decl(m_context, Z3_get_tuple_sort_field_decl(m_context, z3Sort(*_expr.arguments[0].sort), static_cast<unsigned>(index)))(arguments[0]);
+			return z3::func_decl(m_context, Z3_get_tuple_sort_field_decl(m_context, z3Sort(*_expr.arguments[0].sort), static_cast<unsigned>(index)))(_arguments[0]);
 		}
 		else if (n == "tuple_constructor")
 		{
 			auto constructor = z3::func_decl(m_context, Z3_get_tuple_sort_mk_decl(m_context, z3Sort(*_expr.sort)));
-			smtAssert(constructor.arity() == arguments.size(), "");
+			smtAssert(constructor.arity() == _arguments.size(), "");
 			z3::expr_vector args(m_context);
-			for (auto const& arg: arguments)
+			for (auto const& arg: _arguments)
 				args.push_back(arg);
 			return constructor(args);
 		}
@@ -359,12 +415,12 @@ Expression Z3Interface::fromZ3Expr(z3::expr const& _expr)
 		return Expression::store(arguments[0], arguments[1], arguments[2]);
 	else if (kind == Z3_OP_CONST_ARRAY)
 	{
-		auto sortSort = make_shared<SortSort>(fromZ3Sort(_expr.get_sort()));
+		auto sortSort = SortProvider::sortSort(fromZ3Sort(_expr.get_sort()));
 		return Expression::const_array(Expression(sortSort), arguments[0]);
 	}
 	else if (kind == Z3_OP_DT_CONSTRUCTOR)
 	{
-		auto sortSort = make_shared<SortSort>(fromZ3Sort(_expr.get_sort()));
+		auto sortSort = SortProvider::sortSort(fromZ3Sort(_expr.get_sort()));
 		return Expression::tuple_constructor(Expression(sortSort), arguments);
 	}
 	else if (kind == Z3_OP_DT_ACCESSOR)
@@ -378,6 +434,17 @@ Expression Z3Interface::fromZ3Expr(z3::expr const& _expr)
 }
 
 z3::sort Z3Interface::z3Sort(Sort const& _sort)
+{
+	if (!_sort.interned)
+		return translateSort(_sort);
+	if (auto it = m_sorts.find(&_sort); it != m_sorts.end())
+		return it->second;
+	z3::sort sort = translateSort(_sort);
+	m_sorts.emplace(&_sort, sort);
+	return sort;
+}
+
+z3::sort Z3Interface::translateSort(Sort const& _sort)
 {
 	switch (_sort.kind)
 	{
@@ -395,6 +462,9 @@ z3::sort Z3Interface::z3Sort(Sort const& _sort)
 	case Kind::Tuple:
 	{
 		auto const& tupleSort = dynamic_cast<TupleSort const&>(_sort);
+		if (auto cached = m_tupleSorts.find(tupleSort.name); cached != m_tupleSorts.end() && cached->second.first == tupleSort)
+			return cached->second.second;
+
 		vector<char const*> cMembers;
 		for (auto const& member: tupleSort.members)
 			cMembers.emplace_back(member.c_str());
@@ -411,6 +481,8 @@ z3::sort Z3Interface::z3Sort(Sort const& _sort)
 			sorts.data(),
 			projs
 		);
+		m_tupleSorts.erase(tupleSort.name);
+		m_tupleSorts.emplace(tupleSort.name, make_pair(tupleSort, tupleConstructor.range()));
 		return tupleConstructor.range();
 	}
 
@@ -439,7 +511,7 @@ SortPointer Z3Interface::fromZ3Sort(z3::sort const& _sort)
 	if (_sort.is_bv())
 		return make_shared<BitVectorSort>(_sort.bv_size());
 	if (_sort.is_array())
-		return make_shared<ArraySort>(fromZ3Sort(_sort.array_domain()), fromZ3Sort(_sort.array_range()));
+		return SortProvider::arraySort(fromZ3Sort(_sort.array_domain()), fromZ3Sort(_sort.array_range()));
 	if (_sort.is_datatype())
 	{
 		auto name = _sort.name().str();
@@ -452,7 +524,7 @@ SortPointer Z3Interface::fromZ3Sort(z3::sort const& _sort)
 			memberNames.push_back(accessor.name().str());
 			memberSorts.push_back(fromZ3Sort(accessor.range()));
 		}
-		return make_shared<TupleSort>(name, memberNames, memberSorts);
+		return SortProvider::tupleSort(name, memberNames, memberSorts);
 	}
 	smtAssert(false, "");
 }
@@ -21,6 +21,9 @@
 #include <libsmtutil/SolverInterface.h>
 #include <z3++.h>
 
+#include <map>
+#include <tuple>
+
 namespace solidity::smtutil
 {
 
@@ -45,6 +48,8 @@ public:
 	void addAssertion(Expression const& _expr) override;
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
 
+	void setQueryTimeout(unsigned _milliseconds) override;
+
 	z3::expr toZ3Expr(Expression const& _expr);
 	smtutil::Expression fromZ3Expr(z3::expr const& _expr);
 
@@ -53,6 +58,11 @@ public:
 
 	z3::context* context() { return &m_context; }
 
+	/// Starts recording the declared variables in the order of their declaration,
+	/// so that they can be declared again on a different interface.
+	void recordDeclarations() { m_recordDeclarations = true; }
+	std::vector<std::pair<std::string, SortPointer>> const& declarations() const { return m_declarations; }
+
 	// Z3 "basic resources" limit.
 	// This is used to make the runs more deterministic and platform/machine independent.
 	static int const resourceLimit = 1000000;
@@ -60,7 +70,11 @@ public:
 private:
 	void declareFunction(std::string const& _name, Sort const& _sort);
 
+	/// Translates @a _expr, whose arguments are already translated to @a _arguments.
+	z3::expr translate(Expression const& _expr, z3::expr_vector const& _arguments);
+
 	z3::sort z3Sort(Sort const& _sort);
+	z3::sort translateSort(Sort const& _sort);
 	z3::sort_vector z3Sort(std::vector<SortPointer> const& _sorts);
 	smtutil::SortPointer fromZ3Sort(z3::sort const& _sort);
 	std::vector<smtutil::SortPointer> fromZ3Sort(z3::sort_vector const& _sorts);
@@ -70,6 +84,23 @@ private:
 
 	std::map<std::string, z3::expr> m_constants;
 	std::map<std::string, z3::func_decl> m_functions;
+	/// The Z3 sorts of the tuple sorts, keyed by their name. Creating a tuple sort declares a
+	/// new datatype, which is too expensive to do every time a variable of that sort is declared.
+	std::map<std::string, std::pair<TupleSort, z3::sort>> m_tupleSorts;
+	/// The Z3 sorts of the interned sorts, keyed by their address. Like the declared tuple sorts,
+	/// they belong to the context and are kept across resets.
+	std::map<Sort const*, z3::sort> m_sorts;
+	/// The translations of the expressions with arguments, keyed by the identity of their
+	/// arguments, their name and their sort. The arguments are kept alive so that their identity
+	/// is not reused.
+	std::map<std::tuple<void const*, std::string, Sort const*>, std::pair<ExpressionList, z3::expr>> m_translations;
+	/// The translations of the expressions with arguments, keyed by their name, their sort
+	/// and the ids of their translated arguments. Also finds expressions that are equal but
+	/// do not share their arguments.
+	std::map<std::tuple<std::string, Sort const*, std::vector<unsigned>>, z3::expr> m_structuralTranslations;
+
+	bool m_recordDeclarations = false;
+	std::vector<std::pair<std::string, SortPointer>> m_declarations;
 };
 
 }
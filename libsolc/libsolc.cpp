@@ -22,6 +22,7 @@
  */
 
 #include <libsolc/libsolc.h>
+#include <libsolidity/interface/ArtifactCache.h>
 #include <libsolidity/interface/StandardCompiler.h>
 #include <libsolidity/interface/Version.h>
 #include <libyul/YulString.h>
@@ -36,6 +37,7 @@ using namespace std;
 using namespace solidity;
 using namespace solidity::util;
 
+using solidity::frontend::MemoryArtifactCache;
 using solidity::frontend::ReadCallback;
 using solidity::frontend::StandardCompiler;
 
@@ -132,6 +134,28 @@ extern char* solidity_compile(char const* _input, CStyleReadFileCallback _readCa
 	return solidityAllocations.emplace_back(compile(_input, _readCallback, _readContext)).data();
 }
 
+extern void solidity_compile_batch(
+	char const* const* _inputs,
+	size_t _count,
+	CStyleReadFileCallback _readCallback,
+	void* _readContext,
+	CStyleCompileResultCallback _resultCallback,
+	void* _resultContext
+) noexcept
+{
+	auto artifactCache = make_shared<MemoryArtifactCache>();
+	for (size_t i = 0; i < _count; ++i)
+	{
+		// The same as the call of solidity_reset() before each compilation, without
+		// freeing the allocations of the caller.
+		yul::YulStringRepository::reset();
+		StandardCompiler compiler(wrapReadCallback(_readCallback, _readContext));
+		compiler.setArtifactCache(artifactCache);
+		string const output = compiler.compile(string(_inputs[i]));
+		_resultCallback(_resultContext, i, output.c_str());
+	}
+}
+
 extern char* solidity_alloc(size_t _size) noexcept
 {
 	try
@@ -52,6 +52,14 @@ extern "C" {
 /// If the callback is not supported, *o_contents and *o_error must be set to NULL.
 typedef void (*CStyleReadFileCallback)(void* _context, char const* _kind, char const* _data, char** o_contents, char** o_error);
 
+/// Callback receiving the result of one input of solidity_compile_batch().
+///
+/// @param _context The resultContext passed to solidity_compile_batch. Can be NULL.
+/// @param _index The index of the input in the array passed to solidity_compile_batch.
+/// @param _output The "Standard Output JSON" of the input. It is only valid during the call
+///                and must not be freed.
+typedef void (*CStyleCompileResultCallback)(void* _context, size_t _index, char const* _output);
+
 /// Returns the complete license document.
 ///
 /// The pointer returned must NOT be freed by the caller.
@@ -90,6 +98,27 @@ void solidity_free(char* _data) SOLC_NOEXCEPT;
 /// @returns A pointer to the result. The pointer returned must be freed by the caller using solidity_free() or solidity_reset().
 char* solidity_compile(char const* _input, CStyleReadFileCallback _readCallback, void* _readContext) SOLC_NOEXCEPT;
 
+/// Takes an array of @p _count "Standard Input JSON"s and processes them one after the other
+/// like solidity_compile(), passing each "Standard Output JSON" to @p _resultCallback as soon
+/// as it is available. The inputs share the code generation artifacts of contracts compiled
+/// via the IR, so contracts that several inputs contain with the same settings are only
+/// compiled once.
+///
+/// @param _inputs The input JSONs to process.
+/// @param _count The number of inputs.
+/// @param _readCallback The optional callback pointer, see solidity_compile().
+/// @param _readContext An optional context pointer passed to _readCallback. Can be NULL.
+/// @param _resultCallback The callback receiving the outputs, in the order of the inputs.
+/// @param _resultContext An optional context pointer passed to _resultCallback. Can be NULL.
+void solidity_compile_batch(
+	char const* const* _inputs,
+	size_t _count,
+	CStyleReadFileCallback _readCallback,
+	void* _readContext,
+	CStyleCompileResultCallback _resultCallback,
+	void* _resultContext
+) SOLC_NOEXCEPT;
+
 /// Frees up any allocated memory.
 ///
 /// NOTE: the pointer returned by solidity_compile as well as any other pointer retrieved via solidity_alloc()
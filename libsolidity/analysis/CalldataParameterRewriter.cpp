@@ -0,0 +1,152 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/analysis/CalldataParameterRewriter.h>
+
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/TypeProvider.h>
+
+#include <libsolutil/CommonData.h>
+
+#include <algorithm>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+
+namespace
+{
+
+/// @returns the expression accessed by @a _expression if it is an index access into an array,
+/// the length of an array or a member of a struct, nullptr otherwise.
+Expression const* accessedBase(Expression const& _expression)
+{
+	if (auto const* indexAccess = dynamic_cast<IndexAccess const*>(&_expression))
+	{
+		if (
+			indexAccess->indexExpression() &&
+			dynamic_cast<ArrayType const*>(indexAccess->baseExpression().annotation().type)
+		)
+			return &indexAccess->baseExpression();
+	}
+	else if (auto const* memberAccess = dynamic_cast<MemberAccess const*>(&_expression))
+	{
+		Type const* baseType = memberAccess->expression().annotation().type;
+		if (dynamic_cast<ArrayType const*>(baseType) && memberAccess->memberName() == "length")
+			return &memberAccess->expression();
+		if (auto const* structType = dynamic_cast<StructType const*>(baseType))
+		{
+			auto const& members = structType->structDefinition().members();
+			Declaration const* member = memberAccess->annotation().referencedDeclaration;
+			if (any_of(members.begin(), members.end(), [&](auto const& _member) { return _member.get() == member; }))
+				return &memberAccess->expression();
+		}
+	}
+	return nullptr;
+}
+
+}
+
+void CalldataParameterRewriter::run(SourceUnit const& _sourceUnit)
+{
+	CalldataParameterRewriter rewriter;
+	_sourceUnit.accept(rewriter);
+}
+
+bool CalldataParameterRewriter::visit(FunctionDefinition const& _function)
+{
+	solAssert(m_candidates.empty() && m_chainRoots.empty());
+	if (!_function.isOrdinary() || _function.visibility() != Visibility::External || !_function.isImplemented())
+		return false;
+
+	for (ASTPointer<VariableDeclaration> const& parameter: _function.parameters())
+		if (parameter->referenceLocation() == VariableDeclaration::Location::Memory)
+			m_candidates[parameter.get()];
+	return !m_candidates.empty();
+}
+
+void CalldataParameterRewriter::endVisit(FunctionDefinition const&)
+{
+	for (auto const& [parameter, candidate]: m_candidates)
+	{
+		if (candidate.disqualified)
+			continue;
+
+		auto const* type = dynamic_cast<ReferenceType const*>(parameter->annotation().type);
+		solAssert(type && type->dataStoredIn(DataLocation::Memory));
+		parameter->annotation().type = TypeProvider::withLocation(type, DataLocation::CallData, true);
+		for (Expression const* access: candidate.accesses)
+		{
+			auto const* accessType = dynamic_cast<ReferenceType const*>(access->annotation().type);
+			solAssert(accessType && accessType->dataStoredIn(DataLocation::Memory));
+			access->annotation().type = TypeProvider::withLocation(accessType, DataLocation::CallData, accessType->isPointer());
+		}
+	}
+	m_candidates.clear();
+	m_chainRoots.clear();
+}
+
+bool CalldataParameterRewriter::visit(IndexAccess const& _indexAccess)
+{
+	collectAccessChain(_indexAccess);
+	return true;
+}
+
+bool CalldataParameterRewriter::visit(MemberAccess const& _memberAccess)
+{
+	collectAccessChain(_memberAccess);
+	return true;
+}
+
+void CalldataParameterRewriter::endVisit(Identifier const& _identifier)
+{
+	auto const* declaration = dynamic_cast<VariableDeclaration const*>(_identifier.annotation().referencedDeclaration);
+	if (declaration && m_candidates.count(declaration) && !m_chainRoots.count(&_identifier))
+		m_candidates.at(declaration).disqualified = true;
+}
+
+void CalldataParameterRewriter::endVisit(InlineAssembly const& _inlineAssembly)
+{
+	for (auto const& reference: _inlineAssembly.annotation().externalReferences)
+		if (auto const* declaration = dynamic_cast<VariableDeclaration const*>(reference.second.declaration))
+			if (m_candidates.count(declaration))
+				m_candidates.at(declaration).disqualified = true;
+}
+
+void CalldataParameterRewriter::collectAccessChain(Expression const& _access)
+{
+	// Only the accesses that end the chain, i.e. produce a value type, are considered.
+	if (dynamic_cast<ReferenceType const*>(_access.annotation().type) || _access.annotation().willBeWrittenTo)
+		return;
+
+	vector<Expression const*> chain;
+	for (Expression const* base = accessedBase(_access); base; base = accessedBase(*base))
+		chain.emplace_back(base);
+	if (chain.empty())
+		return;
+
+	auto const* root = dynamic_cast<Identifier const*>(chain.back());
+	if (!root)
+		return;
+	auto const* declaration = dynamic_cast<VariableDeclaration const*>(root->annotation().referencedDeclaration);
+	if (!declaration || !m_candidates.count(declaration))
+		return;
+
+	m_chainRoots.insert(root);
+	m_candidates.at(declaration).accesses += chain;
+}
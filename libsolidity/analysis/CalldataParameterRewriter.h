@@ -0,0 +1,76 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Changes the data location of read-only memory parameters of external functions to calldata.
+ */
+
+#pragma once
+
+#include <libsolidity/ast/ASTForward.h>
+#include <libsolidity/ast/ASTVisitor.h>
+
+#include <map>
+#include <set>
+#include <vector>
+
+namespace solidity::frontend
+{
+
+/**
+ * Changes the parameters of external functions that are declared ``memory`` but only read to
+ * ``calldata``, so that the code generated via the IR does not decode them into memory, but
+ * accesses them in calldata as if they were declared there. Invalid input is only detected when
+ * the affected part of the parameter is accessed.
+ *
+ * A parameter is only changed if every reference to it is the base of a chain of index accesses,
+ * struct member accesses and ``.length`` that ends in a value type which is not written to, like
+ * ``orders[i].amount``, and it is not referenced in inline assembly. Since the reference types in
+ * between are never used on their own, their data location cannot be observed. The types of the
+ * parameter and of these expressions are changed.
+ *
+ * Has to be run after all other analysis steps and only if the code is generated via the IR.
+ */
+class CalldataParameterRewriter: private ASTConstVisitor
+{
+public:
+	static void run(SourceUnit const& _sourceUnit);
+
+private:
+	struct Candidate
+	{
+		bool disqualified = false;
+		/// The expressions of reference type in the chains of accesses to the parameter.
+		std::vector<Expression const*> accesses;
+	};
+
+	bool visit(FunctionDefinition const& _function) override;
+	void endVisit(FunctionDefinition const& _function) override;
+	bool visit(IndexAccess const& _indexAccess) override;
+	bool visit(MemberAccess const& _memberAccess) override;
+	void endVisit(Identifier const& _identifier) override;
+	void endVisit(InlineAssembly const& _inlineAssembly) override;
+
+	/// Records the chain of accesses ending in @a _access if its root is a candidate parameter.
+	void collectAccessChain(Expression const& _access);
+
+	std::map<VariableDeclaration const*, Candidate> m_candidates;
+	/// The identifiers that are the roots of a chain of accesses to a candidate.
+	std::set<Identifier const*> m_chainRoots;
+};
+
+}
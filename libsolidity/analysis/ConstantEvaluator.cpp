@@ -71,6 +71,25 @@ bool fitsPrecisionBase2(bigint const& _mantissa, uint32_t _expBase2)
 optional<rational> ConstantEvaluator::evaluateBinaryOperator(Token _operator, rational const& _left, rational const& _right)
 {
 	bool fractional = _left.denominator() != 1 || _right.denominator() != 1;
+	if (!fractional)
+	{
+		// Integer arithmetic does not need to normalize the resulting fraction.
+		bigint const& left = _left.numerator();
+		bigint const& right = _right.numerator();
+		switch (_operator)
+		{
+		case Token::Add: return rational(left + right);
+		case Token::Sub: return rational(left - right);
+		case Token::Mul: return rational(left * right);
+		case Token::Div:
+			if (right != 0 && left % right == 0)
+				return rational(left / right);
+			break;
+		default:
+			break;
+		}
+	}
+
 	switch (_operator)
 	{
 	//bit operations will only be enabled for integers and fixed types that resemble integers
@@ -278,11 +297,23 @@ optional<TypedRational> ConstantEvaluator::evaluate(ASTNode const& _node)
 		if (auto const* varDecl = dynamic_cast<VariableDeclaration const*>(&_node))
 		{
 			solAssert(varDecl->isConstant(), "");
+			auto& cache = TypeProvider::constantValueCache();
 			// In some circumstances, we do not yet have a type for the variable.
 			if (!varDecl->value() || !varDecl->type())
+			{
 				m_values[&_node] = nullopt;
+				m_incomplete = true;
+			}
+			else if (auto cached = cache.find(varDecl); cached != cache.end())
+			{
+				if (cached->second)
+					m_values[&_node] = TypedRational{cached->second->first, cached->second->second};
+				else
+					m_values[&_node] = nullopt;
+			}
 			else
 			{
+				bool const outerIncomplete = exchange(m_incomplete, false);
 				m_depth++;
 				if (m_depth > 32)
 					m_errorReporter.fatalTypeError(
@@ -290,8 +321,16 @@ optional<TypedRational> ConstantEvaluator::evaluate(ASTNode const& _node)
 						varDecl->location(),
 						"Cyclic constant definition (or maximum recursion depth exhausted)."
 					);
-				m_values[&_node] = convertType(evaluate(*varDecl->value()), *varDecl->type());
+				optional<TypedRational> value = convertType(evaluate(*varDecl->value()), *varDecl->type());
+				m_values[&_node] = value;
 				m_depth--;
+				if (!m_incomplete)
+				{
+					auto& cached = cache[varDecl];
+					if (value)
+						cached.emplace(value->type, value->value);
+				}
+				m_incomplete = m_incomplete || outerIncomplete;
 			}
 		}
 		else if (auto const* expression = dynamic_cast<Expression const*>(&_node))
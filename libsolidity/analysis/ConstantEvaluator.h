@@ -79,6 +79,9 @@ private:
 	langutil::ErrorReporter& m_errorReporter;
 	/// Current recursion depth.
 	size_t m_depth = 0;
+	/// True if a constant variable without type or value was encountered during the current
+	/// evaluation of a variable. Such values are not cached, since they might be known later.
+	bool m_incomplete = false;
 	/// Values of sub-expressions and variable declarations.
 	std::map<ASTNode const*, std::optional<TypedRational>> m_values;
 };
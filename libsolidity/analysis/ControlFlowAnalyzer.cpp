@@ -21,8 +21,11 @@
 #include <liblangutil/SourceLocation.h>
 #include <libsolutil/Algorithms.h>
 
+#include <boost/dynamic_bitset.hpp>
+
 #include <range/v3/algorithm/sort.hpp>
 
+#include <deque>
 #include <functional>
 
 using namespace std;
@@ -63,47 +66,108 @@ void ControlFlowAnalyzer::analyze(FunctionDefinition const& _function, ContractD
 
 void ControlFlowAnalyzer::checkUninitializedAccess(CFGNode const* _entry, CFGNode const* _exit, bool _emptyBody, optional<string> _contractName)
 {
+	/// A variable occurrence, with the variable and the (potential) access numbered densely.
+	struct Operation
+	{
+		VariableOccurrence::Kind kind;
+		size_t variable;
+		size_t access;
+	};
 	struct NodeInfo
 	{
-		set<VariableDeclaration const*> unassignedVariablesAtEntry;
-		set<VariableDeclaration const*> unassignedVariablesAtExit;
-		set<VariableOccurrence const*> uninitializedVariableAccesses;
+		/// The node, nullptr if it is not reachable from the entry.
+		CFGNode const* node = nullptr;
+		vector<Operation> operations;
+		boost::dynamic_bitset<> unassignedVariablesAtEntry;
+		boost::dynamic_bitset<> uninitializedVariableAccesses;
 		/// Propagate the information from another node to this node.
 		/// To be used to propagate information from a node to its exit nodes.
 		/// Returns true, if new variables were added and thus the current node has
 		/// to be traversed again.
-		bool propagateFrom(NodeInfo const& _entryNode)
+		bool propagateFrom(boost::dynamic_bitset<> const& _unassignedVariables, NodeInfo const& _entryNode)
 		{
-			size_t previousUnassignedVariablesAtEntry = unassignedVariablesAtEntry.size();
-			size_t previousUninitializedVariableAccessess = uninitializedVariableAccesses.size();
-			unassignedVariablesAtEntry += _entryNode.unassignedVariablesAtExit;
-			uninitializedVariableAccesses += _entryNode.uninitializedVariableAccesses;
-			return
-				unassignedVariablesAtEntry.size() > previousUnassignedVariablesAtEntry ||
-				uninitializedVariableAccesses.size() > previousUninitializedVariableAccessess
-			;
+			bool changed = false;
+			if (!_unassignedVariables.is_subset_of(unassignedVariablesAtEntry))
+			{
+				unassignedVariablesAtEntry |= _unassignedVariables;
+				changed = true;
+			}
+			if (!_entryNode.uninitializedVariableAccesses.is_subset_of(uninitializedVariableAccesses))
+			{
+				uninitializedVariableAccesses |= _entryNode.uninitializedVariableAccesses;
+				changed = true;
+			}
+			return changed;
 		}
 	};
-	map<CFGNode const*, NodeInfo> nodeInfos;
-	set<CFGNode const*> nodesToTraverse;
-	nodesToTraverse.insert(_entry);
+
+	// Number the nodes reachable from the entry, their variables and the accesses to them,
+	// so that the sets of the data flow analysis below can be stored as bitsets.
+	vector<NodeInfo> nodeInfos;
+	auto const nodeIndex = [&](CFGNode const* _node) {
+		solAssert(_node->id >= _entry->id);
+		return _node->id - _entry->id;
+	};
+	map<VariableDeclaration const*, size_t> variableIndices;
+	vector<VariableOccurrence const*> accesses;
+	util::BreadthFirstSearch<CFGNode const*>{{_entry}}.run(
+		[&](CFGNode const* _node, auto&& _addChild) {
+			size_t index = nodeIndex(_node);
+			if (index >= nodeInfos.size())
+				nodeInfos.resize(index + 1);
+			NodeInfo& nodeInfo = nodeInfos[index];
+			nodeInfo.node = _node;
+			for (auto const& variableOccurrence: _node->variableOccurrences)
+			{
+				size_t variable = variableIndices.emplace(&variableOccurrence.declaration(), variableIndices.size()).first->second;
+				size_t access = accesses.size();
+				switch (variableOccurrence.kind())
+				{
+					case VariableOccurrence::Kind::InlineAssembly:
+					case VariableOccurrence::Kind::Access:
+					case VariableOccurrence::Kind::Return:
+						accesses.push_back(&variableOccurrence);
+						break;
+					case VariableOccurrence::Kind::Assignment:
+					case VariableOccurrence::Kind::Declaration:
+						break;
+				}
+				nodeInfo.operations.push_back({variableOccurrence.kind(), variable, access});
+			}
+			for (CFGNode const* exit: _node->exits)
+				_addChild(exit);
+		}
+	);
+	for (NodeInfo& nodeInfo: nodeInfos)
+		if (nodeInfo.node)
+		{
+			nodeInfo.unassignedVariablesAtEntry.resize(variableIndices.size());
+			nodeInfo.uninitializedVariableAccesses.resize(accesses.size());
+		}
+
+	vector<bool> queued(nodeInfos.size(), false);
+	vector<bool> traversed(nodeInfos.size(), false);
+	deque<size_t> nodesToTraverse{nodeIndex(_entry)};
+	queued[nodeIndex(_entry)] = true;
 
 	// Walk all paths starting from the nodes in ``nodesToTraverse`` until ``NodeInfo::propagateFrom``
 	// returns false for all exits, i.e. until all paths have been walked with maximal sets of unassigned
 	// variables and accesses.
 	while (!nodesToTraverse.empty())
 	{
-		CFGNode const* currentNode = *nodesToTraverse.begin();
-		nodesToTraverse.erase(nodesToTraverse.begin());
+		size_t currentIndex = nodesToTraverse.front();
+		nodesToTraverse.pop_front();
+		queued[currentIndex] = false;
+		traversed[currentIndex] = true;
 
-		auto& nodeInfo = nodeInfos[currentNode];
-		auto unassignedVariables = nodeInfo.unassignedVariablesAtEntry;
-		for (auto const& variableOccurrence: currentNode->variableOccurrences)
+		NodeInfo& nodeInfo = nodeInfos[currentIndex];
+		boost::dynamic_bitset<> unassignedVariables = nodeInfo.unassignedVariablesAtEntry;
+		for (Operation const& operation: nodeInfo.operations)
 		{
-			switch (variableOccurrence.kind())
+			switch (operation.kind)
 			{
 				case VariableOccurrence::Kind::Assignment:
-					unassignedVariables.erase(&variableOccurrence.declaration());
+					unassignedVariables.reset(operation.variable);
 					break;
 				case VariableOccurrence::Kind::InlineAssembly:
 					// We consider all variables referenced in inline assembly as accessed.
@@ -111,37 +175,42 @@ void ControlFlowAnalyzer::checkUninitializedAccess(CFGNode const* _entry, CFGNod
 					// the control flow in the assembly at some point.
 				case VariableOccurrence::Kind::Access:
 				case VariableOccurrence::Kind::Return:
-					if (unassignedVariables.count(&variableOccurrence.declaration()))
+					if (unassignedVariables.test(operation.variable))
 					{
 						// Merely store the unassigned access. We do not generate an error right away, since this
 						// path might still always revert. It is only an error if this is propagated to the exit
 						// node of the function (i.e. there is a path with an uninitialized access).
-						nodeInfo.uninitializedVariableAccesses.insert(&variableOccurrence);
+						nodeInfo.uninitializedVariableAccesses.set(operation.access);
 					}
 					break;
 				case VariableOccurrence::Kind::Declaration:
-					unassignedVariables.insert(&variableOccurrence.declaration());
+					unassignedVariables.set(operation.variable);
 					break;
 			}
 		}
-		nodeInfo.unassignedVariablesAtExit = std::move(unassignedVariables);
 
 		// Propagate changes to all exits and queue them for traversal, if needed.
-		for (auto const& exit: currentNode->exits)
+		for (CFGNode const* exit: nodeInfo.node->exits)
+		{
+			size_t exitIndex = nodeIndex(exit);
 			if (
-				auto exists = valueOrNullptr(nodeInfos, exit);
-				nodeInfos[exit].propagateFrom(nodeInfo) || !exists
+				(nodeInfos[exitIndex].propagateFrom(unassignedVariables, nodeInfo) || !traversed[exitIndex]) &&
+				!queued[exitIndex]
 			)
-				nodesToTraverse.insert(exit);
+			{
+				queued[exitIndex] = true;
+				nodesToTraverse.push_back(exitIndex);
+			}
+		}
 	}
 
-	auto const& exitInfo = nodeInfos[_exit];
-	if (!exitInfo.uninitializedVariableAccesses.empty())
+	size_t const exitIndex = nodeIndex(_exit);
+	if (exitIndex < nodeInfos.size() && nodeInfos[exitIndex].uninitializedVariableAccesses.any())
 	{
-		vector<VariableOccurrence const*> uninitializedAccessesOrdered(
-			exitInfo.uninitializedVariableAccesses.begin(),
-			exitInfo.uninitializedVariableAccesses.end()
-		);
+		auto const& exitAccesses = nodeInfos[exitIndex].uninitializedVariableAccesses;
+		vector<VariableOccurrence const*> uninitializedAccessesOrdered;
+		for (size_t access = exitAccesses.find_first(); access != boost::dynamic_bitset<>::npos; access = exitAccesses.find_next(access))
+			uninitializedAccessesOrdered.push_back(accesses[access]);
 		ranges::sort(
 			uninitializedAccessesOrdered,
 			[](VariableOccurrence const* lhs, VariableOccurrence const* rhs) -> bool
@@ -56,6 +56,7 @@ FunctionFlow const& CFG::functionFlow(FunctionDefinition const& _function, Contr
 
 CFGNode* CFG::NodeContainer::newNode()
 {
-	m_nodes.emplace_back(std::make_unique<CFGNode>());
-	return m_nodes.back().get();
+	CFGNode& node = m_nodes.emplace_back();
+	node.id = m_nodes.size() - 1;
+	return &node;
 }
@@ -24,6 +24,7 @@
 #include <liblangutil/EVMVersion.h>
 #include <liblangutil/SourceLocation.h>
 
+#include <deque>
 #include <map>
 #include <memory>
 #include <stack>
@@ -94,6 +95,10 @@ private:
  */
 struct CFGNode
 {
+	/// Position of the node in the order of creation. The nodes of a function flow are numbered
+	/// consecutively, starting with the entry node, so the ids relative to the entry node can be
+	/// used to index information about the nodes of a function.
+	size_t id = 0;
 	/// Entry nodes. All CFG nodes from which control flow may move into this node.
 	std::vector<CFGNode*> entries;
 	/// Exit nodes. All CFG nodes to which control flow may continue after this node.
@@ -169,7 +174,8 @@ public:
 	public:
 		CFGNode* newNode();
 	private:
-		std::vector<std::unique_ptr<CFGNode>> m_nodes;
+		/// A deque stores the nodes in large blocks without moving them when it grows.
+		std::deque<CFGNode> m_nodes;
 	};
 private:
 	langutil::ErrorReporter& m_errorReporter;
@@ -29,10 +29,27 @@
 #include <range/v3/view/filter.hpp>
 #include <range/v3/range/conversion.hpp>
 
+#include <algorithm>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::frontend;
 
+namespace
+{
+
+vector<ASTString const*> sortedNames(unordered_map<ASTString, vector<Declaration const*>> const& _declarations)
+{
+	vector<ASTString const*> names;
+	names.reserve(_declarations.size());
+	for (auto const& [name, declarations]: _declarations)
+		names.push_back(&name);
+	sort(names.begin(), names.end(), [](ASTString const* _a, ASTString const* _b) { return *_a < *_b; });
+	return names;
+}
+
+}
+
 Declaration const* DeclarationContainer::conflictingDeclaration(
 	Declaration const& _declaration,
 	ASTString const* _name
@@ -42,10 +59,10 @@ Declaration const* DeclarationContainer::conflictingDeclaration(
 		_name = &_declaration.name();
 	solAssert(!_name->empty(), "");
 	vector<Declaration const*> declarations;
-	if (m_declarations.count(*_name))
-		declarations += m_declarations.at(*_name);
-	if (m_invisibleDeclarations.count(*_name))
-		declarations += m_invisibleDeclarations.at(*_name);
+	if (auto it = m_declarations.find(*_name); it != m_declarations.end())
+		declarations += it->second;
+	if (auto it = m_invisibleDeclarations.find(*_name); it != m_invisibleDeclarations.end())
+		declarations += it->second;
 
 	if (
 		dynamic_cast<FunctionDefinition const*>(&_declaration) ||
@@ -85,13 +102,20 @@ Declaration const* DeclarationContainer::conflictingDeclaration(
 
 void DeclarationContainer::activateVariable(ASTString const& _name)
 {
+	auto invisible = m_invisibleDeclarations.find(_name);
 	solAssert(
-		m_invisibleDeclarations.count(_name) && m_invisibleDeclarations.at(_name).size() == 1,
+		invisible != m_invisibleDeclarations.end() && invisible->second.size() == 1,
 		"Tried to activate a non-inactive variable or multiple inactive variables with the same name."
 	);
-	solAssert(m_declarations.count(_name) == 0 || m_declarations.at(_name).empty(), "");
-	m_declarations[_name].emplace_back(m_invisibleDeclarations.at(_name).front());
-	m_invisibleDeclarations.erase(_name);
+	vector<Declaration const*>& visible = m_declarations[_name];
+	solAssert(visible.empty(), "");
+	visible.emplace_back(invisible->second.front());
+	m_invisibleDeclarations.erase(invisible);
+}
+
+map<ASTString, vector<Declaration const*>> DeclarationContainer::declarations() const
+{
+	return {m_declarations.begin(), m_declarations.end()};
 }
 
 bool DeclarationContainer::isInvisible(ASTString const& _name) const
@@ -152,21 +176,22 @@ vector<Declaration const*> DeclarationContainer::resolveName(
 	solAssert(!_name.empty(), "Attempt to resolve empty name.");
 	vector<Declaration const*> result;
 
-	if (m_declarations.count(_name))
+	if (auto it = m_declarations.find(_name); it != m_declarations.end())
 	{
 		if (_onlyVisibleAsUnqualifiedNames)
-			result += m_declarations.at(_name) | ranges::views::filter(&Declaration::isVisibleAsUnqualifiedName) | ranges::to_vector;
+			result += it->second | ranges::views::filter(&Declaration::isVisibleAsUnqualifiedName) | ranges::to_vector;
 		else
-			result += m_declarations.at(_name);
+			result += it->second;
 	}
 
-	if (_alsoInvisible && m_invisibleDeclarations.count(_name))
-	{
-		if (_onlyVisibleAsUnqualifiedNames)
-			result += m_invisibleDeclarations.at(_name) | ranges::views::filter(&Declaration::isVisibleAsUnqualifiedName) | ranges::to_vector;
-		else
-			result += m_invisibleDeclarations.at(_name);
-	}
+	if (_alsoInvisible)
+		if (auto it = m_invisibleDeclarations.find(_name); it != m_invisibleDeclarations.end())
+		{
+			if (_onlyVisibleAsUnqualifiedNames)
+				result += it->second | ranges::views::filter(&Declaration::isVisibleAsUnqualifiedName) | ranges::to_vector;
+			else
+				result += it->second;
+		}
 
 	if (result.empty() && _recursive && m_enclosingContainer)
 		result = m_enclosingContainer->resolveName(_name, true, _alsoInvisible, _onlyVisibleAsUnqualifiedNames);
@@ -183,18 +208,12 @@ vector<ASTString> DeclarationContainer::similarNames(ASTString const& _name) con
 
 	vector<ASTString> similar;
 	size_t maximumEditDistance = _name.size() > 3 ? 2 : _name.size() / 2;
-	for (auto const& declaration: m_declarations)
-	{
-		string const& declarationName = declaration.first;
-		if (util::stringWithinDistance(_name, declarationName, maximumEditDistance, MAXIMUM_LENGTH_THRESHOLD))
-			similar.push_back(declarationName);
-	}
-	for (auto const& declaration: m_invisibleDeclarations)
-	{
-		string const& declarationName = declaration.first;
-		if (util::stringWithinDistance(_name, declarationName, maximumEditDistance, MAXIMUM_LENGTH_THRESHOLD))
-			similar.push_back(declarationName);
-	}
+	for (ASTString const* declarationName: sortedNames(m_declarations))
+		if (util::stringWithinDistance(_name, *declarationName, maximumEditDistance, MAXIMUM_LENGTH_THRESHOLD))
+			similar.push_back(*declarationName);
+	for (ASTString const* declarationName: sortedNames(m_invisibleDeclarations))
+		if (util::stringWithinDistance(_name, *declarationName, maximumEditDistance, MAXIMUM_LENGTH_THRESHOLD))
+			similar.push_back(*declarationName);
 
 	if (m_enclosingContainer)
 		similar += m_enclosingContainer->similarNames(_name);
@@ -18,7 +18,9 @@
 
 #include <libsolidity/analysis/FunctionCallGraph.h>
 
+#include <libsolutil/Common.h>
 #include <libsolutil/StringUtils.h>
+#include <libsolutil/Visitor.h>
 
 #include <range/v3/range/conversion.hpp>
 #include <range/v3/view/reverse.hpp>
@@ -28,9 +30,10 @@ using namespace std;
 using namespace solidity::frontend;
 using namespace solidity::util;
 
-CallGraph FunctionCallGraphBuilder::buildCreationGraph(ContractDefinition const& _contract)
+CallGraph FunctionCallGraphBuilder::buildCreationGraph(ContractDefinition const& _contract, SummaryCache* _cache)
 {
-	FunctionCallGraphBuilder builder(_contract);
+	SummaryCache localCache;
+	FunctionCallGraphBuilder builder(_contract, _cache ? *_cache : localCache);
 	solAssert(builder.m_currentNode == CallGraph::Node(CallGraph::SpecialNode::Entry), "");
 
 	// Create graph for constructor, state vars, etc
@@ -41,7 +44,7 @@ CallGraph FunctionCallGraphBuilder::buildCreationGraph(ContractDefinition const&
 		builder.m_currentNode = CallGraph::SpecialNode::Entry;
 		for (auto const* stateVar: base->stateVariables())
 			if (!stateVar->isConstant())
-				stateVar->accept(builder);
+				builder.process(*stateVar);
 
 		if (base->constructor())
 		{
@@ -55,7 +58,7 @@ CallGraph FunctionCallGraphBuilder::buildCreationGraph(ContractDefinition const&
 		// Functions called from the inheritance specifier should have an edge from the constructor
 		// for consistency with functions called from constructor modifiers.
 		for (auto const& inheritanceSpecifier: base->baseContracts())
-			inheritanceSpecifier->accept(builder);
+			builder.process(*inheritanceSpecifier);
 	}
 
 	builder.m_currentNode = CallGraph::SpecialNode::Entry;
@@ -66,10 +69,12 @@ CallGraph FunctionCallGraphBuilder::buildCreationGraph(ContractDefinition const&
 
 CallGraph FunctionCallGraphBuilder::buildDeployedGraph(
 	ContractDefinition const& _contract,
-	CallGraph const& _creationGraph
+	CallGraph const& _creationGraph,
+	SummaryCache* _cache
 )
 {
-	FunctionCallGraphBuilder builder(_contract);
+	SummaryCache localCache;
+	FunctionCallGraphBuilder builder(_contract, _cache ? *_cache : localCache);
 	solAssert(builder.m_currentNode == CallGraph::Node(CallGraph::SpecialNode::Entry), "");
 
 	auto getSecondElement = [](auto const& _tuple){ return get<1>(_tuple); };
@@ -124,9 +129,9 @@ bool FunctionCallGraphBuilder::visit(FunctionCall const& _functionCall)
 		// If it's not a direct call, we don't really know which function will be called (it may even
 		// change at runtime). All we can do is to add an edge to the dispatch which in turn has
 		// edges to all functions could possibly be called.
-		add(m_currentNode, CallGraph::SpecialNode::InternalDispatch);
+		m_summary->emplace_back(InternalDispatchCall{});
 	else if (functionType->kind() == FunctionType::Kind::Error)
-		m_graph.usedErrors.insert(&dynamic_cast<ErrorDefinition const&>(functionType->declaration()));
+		m_summary->emplace_back(&dynamic_cast<ErrorDefinition const&>(functionType->declaration()));
 
 	return true;
 }
@@ -136,7 +141,7 @@ bool FunctionCallGraphBuilder::visit(EmitStatement const& _emitStatement)
 	auto const* functionType = dynamic_cast<FunctionType const*>(_emitStatement.eventCall().expression().annotation().type);
 	solAssert(functionType, "");
 
-	m_graph.emittedEvents.insert(&dynamic_cast<EventDefinition const&>(functionType->declaration()));
+	m_summary->emplace_back(&dynamic_cast<EventDefinition const&>(functionType->declaration()));
 
 	return true;
 }
@@ -159,7 +164,12 @@ bool FunctionCallGraphBuilder::visit(Identifier const& _identifier)
 
 		// For events kind() == Event, so we have an extra check here
 		if (funType && funType->kind() == FunctionType::Kind::Internal)
-			functionReferenced(callable->resolveVirtual(m_contract), _identifier.annotation().calledDirectly);
+			m_summary->emplace_back(CallableReference{
+				callable,
+				VirtualLookup::Virtual,
+				nullptr,
+				_identifier.annotation().calledDirectly
+			});
 	}
 
 	return true;
@@ -176,7 +186,7 @@ bool FunctionCallGraphBuilder::visit(MemberAccess const& _memberAccess)
 		))
 		{
 			ContractType const& accessedContractType = dynamic_cast<ContractType const&>(*magicType->typeArgument());
-			m_graph.bytecodeDependency.emplace(&accessedContractType.contractDefinition(), &_memberAccess);
+			m_summary->emplace_back(BytecodeReference{&accessedContractType.contractDefinition(), &_memberAccess});
 		}
 
 	auto functionType = dynamic_cast<FunctionType const*>(_memberAccess.annotation().type);
@@ -184,6 +194,7 @@ bool FunctionCallGraphBuilder::visit(MemberAccess const& _memberAccess)
 	if (!functionType || !functionDef || functionType->kind() != FunctionType::Kind::Internal)
 		return true;
 
+	CallableReference reference{functionDef, VirtualLookup::Static, nullptr, _memberAccess.annotation().calledDirectly};
 	// Super functions
 	if (*_memberAccess.annotation().requiredLookup == VirtualLookup::Super)
 	{
@@ -191,16 +202,14 @@ bool FunctionCallGraphBuilder::visit(MemberAccess const& _memberAccess)
 			if (auto const contractType = dynamic_cast<ContractType const*>(typeType->actualType()))
 			{
 				solAssert(contractType->isSuper(), "");
-				functionDef = &functionDef->resolveVirtual(
-					m_contract,
-					contractType->contractDefinition().superContract(m_contract)
-				);
+				reference.lookup = VirtualLookup::Super;
+				reference.superLookupBase = &contractType->contractDefinition();
 			}
 	}
 	else
 		solAssert(*_memberAccess.annotation().requiredLookup == VirtualLookup::Static, "");
 
-	functionReferenced(*functionDef, _memberAccess.annotation().calledDirectly);
+	m_summary->emplace_back(reference);
 	return true;
 }
 
@@ -210,13 +219,8 @@ bool FunctionCallGraphBuilder::visit(ModifierInvocation const& _modifierInvocati
 	{
 		VirtualLookup const& requiredLookup = *_modifierInvocation.name().annotation().requiredLookup;
 
-		if (requiredLookup == VirtualLookup::Virtual)
-			functionReferenced(modifier->resolveVirtual(m_contract));
-		else
-		{
-			solAssert(requiredLookup == VirtualLookup::Static, "");
-			functionReferenced(*modifier);
-		}
+		solAssert(requiredLookup == VirtualLookup::Virtual || requiredLookup == VirtualLookup::Static, "");
+		m_summary->emplace_back(CallableReference{modifier, requiredLookup, nullptr, true});
 	}
 
 	return true;
@@ -225,11 +229,42 @@ bool FunctionCallGraphBuilder::visit(ModifierInvocation const& _modifierInvocati
 bool FunctionCallGraphBuilder::visit(NewExpression const& _newExpression)
 {
 	if (ContractType const* contractType = dynamic_cast<ContractType const*>(_newExpression.typeName().annotation().type))
-		m_graph.bytecodeDependency.emplace(&contractType->contractDefinition(), &_newExpression);
+		m_summary->emplace_back(BytecodeReference{&contractType->contractDefinition(), &_newExpression});
 
 	return true;
 }
 
+void FunctionCallGraphBuilder::process(ASTNode const& _node)
+{
+	solAssert(!m_summary, "");
+	auto summary = m_cache.m_summaries.find(&_node);
+	if (summary == m_cache.m_summaries.end())
+	{
+		summary = m_cache.m_summaries.emplace(&_node, Summary{}).first;
+		m_summary = &summary->second;
+		ScopeGuard resetSummary{[&]() { m_summary = nullptr; }};
+		_node.accept(*this);
+	}
+
+	for (auto const& item: summary->second)
+		std::visit(GenericVisitor{
+			[&](CallableReference const& _reference) {
+				CallableDeclaration const* callable = _reference.callable;
+				if (_reference.lookup == VirtualLookup::Virtual)
+					callable = &callable->resolveVirtual(m_contract);
+				else if (_reference.lookup == VirtualLookup::Super)
+					callable = &callable->resolveVirtual(m_contract, _reference.superLookupBase->superContract(m_contract));
+				functionReferenced(*callable, _reference.calledDirectly);
+			},
+			[&](InternalDispatchCall) { add(m_currentNode, CallGraph::SpecialNode::InternalDispatch); },
+			[&](BytecodeReference const& _reference) {
+				m_graph.bytecodeDependency.emplace(_reference.contract, _reference.referencee);
+			},
+			[&](ErrorDefinition const* _error) { m_graph.usedErrors.insert(_error); },
+			[&](EventDefinition const* _event) { m_graph.emittedEvents.insert(_event); },
+		}, item);
+}
+
 void FunctionCallGraphBuilder::enqueueCallable(CallableDeclaration const& _callable)
 {
 	if (!m_graph.edges.count(&_callable))
@@ -251,7 +286,7 @@ void FunctionCallGraphBuilder::processQueue()
 		solAssert(holds_alternative<CallableDeclaration const*>(m_currentNode), "");
 
 		m_visitQueue.pop_front();
-		get<CallableDeclaration const*>(m_currentNode)->accept(*this);
+		process(*get<CallableDeclaration const*>(m_currentNode));
 	}
 
 	m_currentNode = CallGraph::SpecialNode::Entry;
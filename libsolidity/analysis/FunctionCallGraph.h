@@ -23,7 +23,10 @@
 #include <libsolidity/ast/CallGraph.h>
 
 #include <deque>
+#include <map>
 #include <ostream>
+#include <variant>
+#include <vector>
 
 namespace solidity::frontend
 {
@@ -56,18 +59,58 @@ namespace solidity::frontend
  */
 class FunctionCallGraphBuilder: private ASTConstVisitor
 {
+	/// Reference to a callable, virtual and super references are resolved for each contract.
+	struct CallableReference
+	{
+		CallableDeclaration const* callable;
+		VirtualLookup lookup;
+		/// Contract the lookup of a super reference starts above.
+		ContractDefinition const* superLookupBase;
+		bool calledDirectly;
+	};
+	struct InternalDispatchCall {};
+	struct BytecodeReference
+	{
+		ContractDefinition const* contract;
+		ASTNode const* referencee;
+	};
+	/// Everything in an AST node that is relevant for the call graph, in the order of visiting.
+	/// Unlike the call graph, this does not depend on the contract.
+	using Summary = std::vector<std::variant<
+		CallableReference,
+		InternalDispatchCall,
+		BytecodeReference,
+		ErrorDefinition const*,
+		EventDefinition const*
+	>>;
+
 public:
-	static CallGraph buildCreationGraph(ContractDefinition const& _contract);
+	/// Summaries of the functions, modifiers and other AST nodes visited while building call graphs.
+	/// Sharing them between the call graphs of several contracts ensures that each of the
+	/// (inherited) functions is only traversed once.
+	class SummaryCache
+	{
+	private:
+		friend class FunctionCallGraphBuilder;
+		std::map<ASTNode const*, Summary> m_summaries;
+	};
+
+	static CallGraph buildCreationGraph(ContractDefinition const& _contract, SummaryCache* _cache = nullptr);
 	static CallGraph buildDeployedGraph(
 		ContractDefinition const& _contract,
-		CallGraph const& _creationGraph
+		CallGraph const& _creationGraph,
+		SummaryCache* _cache = nullptr
 	);
 
 private:
-	FunctionCallGraphBuilder(ContractDefinition const& _contract):
-		m_contract(_contract)
+	FunctionCallGraphBuilder(ContractDefinition const& _contract, SummaryCache& _cache):
+		m_contract(_contract),
+		m_cache(_cache)
 	{}
 
+	/// Adds everything referenced by @a _node to the graph, using its cached summary if available.
+	void process(ASTNode const& _node);
+
 	bool visit(FunctionCall const& _functionCall) override;
 	bool visit(EmitStatement const& _emitStatement) override;
 	bool visit(Identifier const& _identifier) override;
@@ -83,6 +126,9 @@ private:
 
 	CallGraph::Node m_currentNode = CallGraph::SpecialNode::Entry;
 	ContractDefinition const& m_contract;
+	SummaryCache& m_cache;
+	/// The summary the visitor functions add to.
+	Summary* m_summary = nullptr;
 	CallGraph m_graph;
 	std::deque<CallableDeclaration const*> m_visitQueue;
 };
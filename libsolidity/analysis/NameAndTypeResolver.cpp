@@ -119,7 +119,9 @@ bool NameAndTypeResolver::performImports(SourceUnit& _sourceUnit, map<string, So
 						))
 							error =  true;
 		}
-	_sourceUnit.annotation().exportedSymbols = m_scopes[&_sourceUnit]->declarations();
+	// Source units whose analysis is reused by an incremental update already export the same symbols.
+	if (!_sourceUnit.annotation().exportedSymbols.set())
+		_sourceUnit.annotation().exportedSymbols = m_scopes[&_sourceUnit]->declarations();
 	return !error;
 }
 
@@ -600,7 +602,7 @@ void DeclarationRegistrationHelper::endVisit(VariableDeclarationStatement& _vari
 	// This does not fit here perfectly, but it saves us another AST visit.
 	solAssert(m_currentFunction, "Variable declaration without function.");
 	for (ASTPointer<VariableDeclaration> const& var: _variableDeclarationStatement.declarations())
-		if (var)
+		if (var && m_registerLocalVariables)
 			m_currentFunction->addLocalVariable(*var);
 	ASTVisitor::endVisit(_variableDeclarationStatement);
 }
@@ -629,14 +631,21 @@ bool DeclarationRegistrationHelper::visitNode(ASTNode& _node)
 				canonicalName = decl->name() + "." + canonicalName;
 			}
 
-		annotation->canonicalName = canonicalName;
+		// The name is already set if the declarations of the AST are registered a second time.
+		if (annotation->canonicalName.set())
+			solAssert(*annotation->canonicalName == canonicalName, "");
+		else
+			annotation->canonicalName = canonicalName;
 	}
 
 	if (dynamic_cast<ScopeOpener const*>(&_node))
 		enterNewSubScope(_node);
 
 	if (auto* variableScope = dynamic_cast<VariableScope*>(&_node))
+	{
 		m_currentFunction = variableScope;
+		m_registerLocalVariables = variableScope->localVariables().empty();
+	}
 
 	return true;
 }
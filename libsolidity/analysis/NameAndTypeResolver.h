@@ -179,6 +179,9 @@ private:
 	std::map<ASTNode const*, std::shared_ptr<DeclarationContainer>>& m_scopes;
 	ASTNode const* m_currentScope = nullptr;
 	VariableScope* m_currentFunction = nullptr;
+	/// False if the local variables of the current function have already been registered
+	/// by an earlier analysis of the same AST.
+	bool m_registerLocalVariables = true;
 	ContractDefinition const* m_currentContract = nullptr;
 	langutil::ErrorReporter& m_errorReporter;
 	GlobalContext& m_globalContext;
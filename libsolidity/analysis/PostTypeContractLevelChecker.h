@@ -45,11 +45,11 @@ public:
 	/// @returns true iff all checks passed. Note even if all checks passed, errors() can still contain warnings
 	bool check(SourceUnit const& _sourceUnit);
 
-private:
 	/// Performs checks on the given contract.
 	/// @returns true iff all checks passed. Note even if all checks passed, errors() can still contain warnings
 	bool check(ContractDefinition const& _contract);
 
+private:
 	langutil::ErrorReporter& m_errorReporter;
 };
 
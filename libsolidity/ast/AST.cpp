@@ -238,7 +238,8 @@ vector<pair<util::FixedHash<4>, FunctionTypePointer>> const& ContractDefinition:
 {
 	return m_interfaceFunctionList[_includeInheritedFunctions].init([&]{
 		set<string> signaturesSeen;
-		vector<pair<util::FixedHash<4>, FunctionTypePointer>> interfaceFunctionList;
+		vector<string> signatures;
+		vector<FunctionTypePointer> interfaceFunctions;
 
 		for (ContractDefinition const* contract: annotation().linearizedBaseContracts)
 		{
@@ -257,15 +258,22 @@ vector<pair<util::FixedHash<4>, FunctionTypePointer>> const& ContractDefinition:
 					// Fails hopefully because we already registered the error
 					continue;
 				string functionSignature = fun->externalSignature();
-				if (signaturesSeen.count(functionSignature) == 0)
+				if (signaturesSeen.insert(functionSignature).second)
 				{
-					signaturesSeen.insert(functionSignature);
-					util::FixedHash<4> hash(util::keccak256(functionSignature));
-					interfaceFunctionList.emplace_back(hash, fun);
+					signatures.emplace_back(move(functionSignature));
+					interfaceFunctions.push_back(fun);
 				}
 			}
 		}
 
+		// The signatures are hashed together, which is faster than hashing them one by one.
+		vector<bytesConstRef> inputs;
+		for (string const& signature: signatures)
+			inputs.emplace_back(signature);
+		vector<util::h256> const hashes = util::keccak256Batch(inputs);
+		vector<pair<util::FixedHash<4>, FunctionTypePointer>> interfaceFunctionList;
+		for (size_t i = 0; i < interfaceFunctions.size(); ++i)
+			interfaceFunctionList.emplace_back(util::FixedHash<4>(hashes[i]), interfaceFunctions[i]);
 		return interfaceFunctionList;
 	});
 }
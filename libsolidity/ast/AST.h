@@ -120,8 +120,13 @@ public:
 	bool operator!=(ASTNode const& _other) const { return !operator==(_other); }
 	///@}
 
+private:
+	/// The parser can move the IDs of the nodes of a source unit parsed on its own
+	/// into the ID range of the compilation, see Parser::shiftNodeIDs().
+	friend class Parser;
+
 protected:
-	size_t const m_id = 0;
+	size_t m_id = 0;
 
 	template <class T>
 	T& initAnnotation() const
@@ -32,6 +32,7 @@
 #include <libsolutil/JSON.h>
 #include <libsolutil/UTF8.h>
 #include <libsolutil/CommonData.h>
+#include <libsolutil/Common.h>
 
 #include <boost/algorithm/string/join.hpp>
 
@@ -195,7 +196,13 @@ void ASTJsonConverter::print(ostream& _stream, ASTNode const& _node)
 
 Json::Value ASTJsonConverter::toJson(ASTNode const& _node)
 {
+	++m_toJsonDepth;
+	ScopeGuard depthGuard{[&]() { --m_toJsonDepth; }};
 	_node.accept(*this);
+	// The null members are removed from the whole tree at once, since removing
+	// them again for every subtree takes time proportional to the depth of each node.
+	if (m_toJsonDepth > 1)
+		return std::move(m_currentValue);
 	return util::removeNullMembers(std::move(m_currentValue));
 }
 
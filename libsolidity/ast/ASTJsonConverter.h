@@ -197,6 +197,8 @@ private:
 	CompilerStack::State m_stackState = CompilerStack::State::Empty; ///< Used to only access information that already exists
 	bool m_inEvent = false; ///< whether we are currently inside an event or not
 	Json::Value m_currentValue;
+	/// Number of nested calls to toJson() for single nodes.
+	size_t m_toJsonDepth = 0;
 	std::map<std::string, unsigned> m_sourceIndices;
 };
 
@@ -33,9 +33,14 @@
 #include <liblangutil/SourceLocation.h>
 #include <liblangutil/Token.h>
 
+#include <libsolutil/ThreadPool.h>
+
 #include <boost/algorithm/string/split.hpp>
 #include <boost/algorithm/string.hpp>
 
+#include <string_view>
+#include <unordered_map>
+
 using namespace std;
 
 namespace solidity::frontend
@@ -55,19 +60,62 @@ ASTPointer<T> ASTJsonImporter::nullOrCast(Json::Value const& _json)
 
 // ============ public ===========================
 
-map<string, ASTPointer<SourceUnit>> ASTJsonImporter::jsonToSourceUnit(map<string, Json::Value> const& _sourceList)
+map<string, ASTPointer<SourceUnit>> ASTJsonImporter::jsonToSourceUnit(
+	map<string, Json::Value> const& _sourceList,
+	size_t _parallelism
+)
 {
 	for (auto const& src: _sourceList)
-		m_sourceNames.emplace_back(make_shared<string const>(src.first));
-	for (auto const& srcPair: _sourceList)
+		m_sourceNames.emplace_back(src.first);
+
+	if (_parallelism <= 1 || _sourceList.size() <= 1)
+	{
+		for (auto const& [sourceName, sourceJson]: _sourceList)
+			importSourceUnit(sourceName, sourceJson);
+		return m_sourceUnits;
+	}
+
+	// Every source unit is imported by its own importer, which allocates its nodes in its own arena.
+	// The IDs are checked for duplicates across the source units afterwards, in the order of the
+	// sources, so that the same error is reported as when importing them one after another.
+	vector<unique_ptr<ASTJsonImporter>> importers;
+	vector<pair<string const*, Json::Value const*>> sources;
+	for (auto const& [sourceName, sourceJson]: _sourceList)
 	{
-		astAssert(!srcPair.second.isNull());
-		astAssert(member(srcPair.second,"nodeType") == "SourceUnit", "The 'nodeType' of the highest node must be 'SourceUnit'.");
-		m_sourceUnits[srcPair.first] = createSourceUnit(srcPair.second, srcPair.first);
+		ASTJsonImporter& importer = *importers.emplace_back(make_unique<ASTJsonImporter>(m_evmVersion));
+		importer.m_sourceNames = m_sourceNames;
+		sources.emplace_back(&sourceName, &sourceJson);
+	}
+	vector<exception_ptr> failures(importers.size());
+	util::parallelFor(importers.size(), _parallelism, [&](size_t _i) {
+		try
+		{
+			importers[_i]->importSourceUnit(*sources[_i].first, *sources[_i].second);
+		}
+		catch (...)
+		{
+			failures[_i] = current_exception();
+		}
+	});
+	for (size_t i = 0; i < importers.size(); ++i)
+	{
+		if (failures[i])
+			rethrow_exception(failures[i]);
+		for (int64_t id: importers[i]->m_usedIDs)
+			astAssert(m_usedIDs.insert(id).second, "Found duplicate node ID!");
+		m_sourceUnits.merge(importers[i]->m_sourceUnits);
 	}
 	return m_sourceUnits;
 }
 
+void ASTJsonImporter::importSourceUnit(string const& _sourceName, Json::Value const& _sourceJson)
+{
+	astAssert(!_sourceJson.isNull());
+	astAssert(member(_sourceJson, "nodeType") == "SourceUnit", "The 'nodeType' of the highest node must be 'SourceUnit'.");
+	m_arena = make_shared<util::Arena>();
+	m_sourceUnits[_sourceName] = createSourceUnit(_sourceJson, _sourceName);
+}
+
 // ============ private ===========================
 
 // =========== general creation functions ==============
@@ -80,7 +128,8 @@ ASTPointer<T> ASTJsonImporter::createASTNode(Json::Value const& _node, Args&&...
 
 	astAssert(m_usedIDs.insert(id).second, "Found duplicate node ID!");
 
-	auto n = make_shared<T>(
+	auto n = allocate_shared<T>(
+		util::ArenaAllocator<T>{m_arena},
 		id,
 		createSourceLocation(_node),
 		forward<Args>(_args)...
@@ -113,122 +162,83 @@ ASTPointer<T> ASTJsonImporter::convertJsonToASTNode(Json::Value const& _node)
 
 ASTPointer<ASTNode> ASTJsonImporter::convertJsonToASTNode(Json::Value const& _json)
 {
-	astAssert(_json["nodeType"].isString() && _json.isMember("id"), "JSON-Node needs to have 'nodeType' and 'id' fields.");
-	string nodeType = _json["nodeType"].asString();
-	if (nodeType == "PragmaDirective")
-		return createPragmaDirective(_json);
-	if (nodeType == "ImportDirective")
-		return createImportDirective(_json);
-	if (nodeType == "ContractDefinition")
-		return createContractDefinition(_json);
-	if (nodeType == "IdentifierPath")
-		return createIdentifierPath(_json);
-	if (nodeType == "InheritanceSpecifier")
-		return createInheritanceSpecifier(_json);
-	if (nodeType == "UsingForDirective")
-		return createUsingForDirective(_json);
-	if (nodeType == "StructDefinition")
-		return createStructDefinition(_json);
-	if (nodeType == "EnumDefinition")
-		return createEnumDefinition(_json);
-	if (nodeType == "EnumValue")
-		return createEnumValue(_json);
-	if (nodeType == "UserDefinedValueTypeDefinition")
-		return createUserDefinedValueTypeDefinition(_json);
-	if (nodeType == "ParameterList")
-		return createParameterList(_json);
-	if (nodeType == "OverrideSpecifier")
-		return createOverrideSpecifier(_json);
-	if (nodeType == "FunctionDefinition")
-		return createFunctionDefinition(_json);
-	if (nodeType == "VariableDeclaration")
-		return createVariableDeclaration(_json);
-	if (nodeType == "ModifierDefinition")
-		return createModifierDefinition(_json);
-	if (nodeType == "ModifierInvocation")
-		return createModifierInvocation(_json);
-	if (nodeType == "EventDefinition")
-		return createEventDefinition(_json);
-	if (nodeType == "ErrorDefinition")
-		return createErrorDefinition(_json);
-	if (nodeType == "ElementaryTypeName")
-		return createElementaryTypeName(_json);
-	if (nodeType == "UserDefinedTypeName")
-		return createUserDefinedTypeName(_json);
-	if (nodeType == "FunctionTypeName")
-		return createFunctionTypeName(_json);
-	if (nodeType == "Mapping")
-		return createMapping(_json);
-	if (nodeType == "ArrayTypeName")
-		return createArrayTypeName(_json);
-	if (nodeType == "InlineAssembly")
-		return createInlineAssembly(_json);
-	if (nodeType == "Block")
-		return createBlock(_json, false);
-	if (nodeType == "UncheckedBlock")
-		return createBlock(_json, true);
-	if (nodeType == "PlaceholderStatement")
-		return createPlaceholderStatement(_json);
-	if (nodeType == "IfStatement")
-		return createIfStatement(_json);
-	if (nodeType == "TryCatchClause")
-		return createTryCatchClause(_json);
-	if (nodeType == "TryStatement")
-		return createTryStatement(_json);
-	if (nodeType == "WhileStatement")
-		return createWhileStatement(_json, false);
-	if (nodeType == "DoWhileStatement")
-		return createWhileStatement(_json, true);
-	if (nodeType == "ForStatement")
-		return createForStatement(_json);
-	if (nodeType == "Continue")
-		return createContinue(_json);
-	if (nodeType == "Break")
-		return createBreak(_json);
-	if (nodeType == "Return")
-		return createReturn(_json);
-	if (nodeType == "EmitStatement")
-		return createEmitStatement(_json);
-	if (nodeType == "RevertStatement")
-		return createRevertStatement(_json);
-	if (nodeType == "Throw")
-		return createThrow(_json);
-	if (nodeType == "VariableDeclarationStatement")
-		return createVariableDeclarationStatement(_json);
-	if (nodeType == "ExpressionStatement")
-		return createExpressionStatement(_json);
-	if (nodeType == "Conditional")
-		return createConditional(_json);
-	if (nodeType == "Assignment")
-		return createAssignment(_json);
-	if (nodeType == "TupleExpression")
-		return createTupleExpression(_json);
-	if (nodeType == "UnaryOperation")
-		return createUnaryOperation(_json);
-	if (nodeType == "BinaryOperation")
-		return createBinaryOperation(_json);
-	if (nodeType == "FunctionCall")
-		return createFunctionCall(_json);
-	if (nodeType == "FunctionCallOptions")
-		return createFunctionCallOptions(_json);
-	if (nodeType == "NewExpression")
-		return createNewExpression(_json);
-	if (nodeType == "MemberAccess")
-		return createMemberAccess(_json);
-	if (nodeType == "IndexAccess")
-		return createIndexAccess(_json);
-	if (nodeType == "IndexRangeAccess")
-		return createIndexRangeAccess(_json);
-	if (nodeType == "Identifier")
-		return createIdentifier(_json);
-	if (nodeType == "ElementaryTypeNameExpression")
-		return createElementaryTypeNameExpression(_json);
-	if (nodeType == "Literal")
-		return createLiteral(_json);
-	if (nodeType == "StructuredDocumentation")
-		return createDocumentation(_json);
-	else
-		astAssert(false, "Unknown type of ASTNode: " + nodeType);
+	using Converter = ASTPointer<ASTNode>(*)(ASTJsonImporter&, Json::Value const&);
+	static unordered_map<string_view, Converter> const converters{
+		{"PragmaDirective", &ASTJsonImporter::convertWith<&ASTJsonImporter::createPragmaDirective>},
+		{"ImportDirective", &ASTJsonImporter::convertWith<&ASTJsonImporter::createImportDirective>},
+		{"ContractDefinition", &ASTJsonImporter::convertWith<&ASTJsonImporter::createContractDefinition>},
+		{"IdentifierPath", &ASTJsonImporter::convertWith<&ASTJsonImporter::createIdentifierPath>},
+		{"InheritanceSpecifier", &ASTJsonImporter::convertWith<&ASTJsonImporter::createInheritanceSpecifier>},
+		{"UsingForDirective", &ASTJsonImporter::convertWith<&ASTJsonImporter::createUsingForDirective>},
+		{"StructDefinition", &ASTJsonImporter::convertWith<&ASTJsonImporter::createStructDefinition>},
+		{"EnumDefinition", &ASTJsonImporter::convertWith<&ASTJsonImporter::createEnumDefinition>},
+		{"EnumValue", &ASTJsonImporter::convertWith<&ASTJsonImporter::createEnumValue>},
+		{"UserDefinedValueTypeDefinition", &ASTJsonImporter::convertWith<&ASTJsonImporter::createUserDefinedValueTypeDefinition>},
+		{"ParameterList", &ASTJsonImporter::convertWith<&ASTJsonImporter::createParameterList>},
+		{"OverrideSpecifier", &ASTJsonImporter::convertWith<&ASTJsonImporter::createOverrideSpecifier>},
+		{"FunctionDefinition", &ASTJsonImporter::convertWith<&ASTJsonImporter::createFunctionDefinition>},
+		{"VariableDeclaration", &ASTJsonImporter::convertWith<&ASTJsonImporter::createVariableDeclaration>},
+		{"ModifierDefinition", &ASTJsonImporter::convertWith<&ASTJsonImporter::createModifierDefinition>},
+		{"ModifierInvocation", &ASTJsonImporter::convertWith<&ASTJsonImporter::createModifierInvocation>},
+		{"EventDefinition", &ASTJsonImporter::convertWith<&ASTJsonImporter::createEventDefinition>},
+		{"ErrorDefinition", &ASTJsonImporter::convertWith<&ASTJsonImporter::createErrorDefinition>},
+		{"ElementaryTypeName", &ASTJsonImporter::convertWith<&ASTJsonImporter::createElementaryTypeName>},
+		{"UserDefinedTypeName", &ASTJsonImporter::convertWith<&ASTJsonImporter::createUserDefinedTypeName>},
+		{"FunctionTypeName", &ASTJsonImporter::convertWith<&ASTJsonImporter::createFunctionTypeName>},
+		{"Mapping", &ASTJsonImporter::convertWith<&ASTJsonImporter::createMapping>},
+		{"ArrayTypeName", &ASTJsonImporter::convertWith<&ASTJsonImporter::createArrayTypeName>},
+		{"InlineAssembly", &ASTJsonImporter::convertWith<&ASTJsonImporter::createInlineAssembly>},
+		{"Block", [](ASTJsonImporter& _importer, Json::Value const& _json) -> ASTPointer<ASTNode> {
+			return _importer.createBlock(_json, false);
+		}},
+		{"UncheckedBlock", [](ASTJsonImporter& _importer, Json::Value const& _json) -> ASTPointer<ASTNode> {
+			return _importer.createBlock(_json, true);
+		}},
+		{"PlaceholderStatement", &ASTJsonImporter::convertWith<&ASTJsonImporter::createPlaceholderStatement>},
+		{"IfStatement", &ASTJsonImporter::convertWith<&ASTJsonImporter::createIfStatement>},
+		{"TryCatchClause", &ASTJsonImporter::convertWith<&ASTJsonImporter::createTryCatchClause>},
+		{"TryStatement", &ASTJsonImporter::convertWith<&ASTJsonImporter::createTryStatement>},
+		{"WhileStatement", [](ASTJsonImporter& _importer, Json::Value const& _json) -> ASTPointer<ASTNode> {
+			return _importer.createWhileStatement(_json, false);
+		}},
+		{"DoWhileStatement", [](ASTJsonImporter& _importer, Json::Value const& _json) -> ASTPointer<ASTNode> {
+			return _importer.createWhileStatement(_json, true);
+		}},
+		{"ForStatement", &ASTJsonImporter::convertWith<&ASTJsonImporter::createForStatement>},
+		{"Continue", &ASTJsonImporter::convertWith<&ASTJsonImporter::createContinue>},
+		{"Break", &ASTJsonImporter::convertWith<&ASTJsonImporter::createBreak>},
+		{"Return", &ASTJsonImporter::convertWith<&ASTJsonImporter::createReturn>},
+		{"EmitStatement", &ASTJsonImporter::convertWith<&ASTJsonImporter::createEmitStatement>},
+		{"RevertStatement", &ASTJsonImporter::convertWith<&ASTJsonImporter::createRevertStatement>},
+		{"Throw", &ASTJsonImporter::convertWith<&ASTJsonImporter::createThrow>},
+		{"VariableDeclarationStatement", &ASTJsonImporter::convertWith<&ASTJsonImporter::createVariableDeclarationStatement>},
+		{"ExpressionStatement", &ASTJsonImporter::convertWith<&ASTJsonImporter::createExpressionStatement>},
+		{"Conditional", &ASTJsonImporter::convertWith<&ASTJsonImporter::createConditional>},
+		{"Assignment", &ASTJsonImporter::convertWith<&ASTJsonImporter::createAssignment>},
+		{"TupleExpression", &ASTJsonImporter::convertWith<&ASTJsonImporter::createTupleExpression>},
+		{"UnaryOperation", &ASTJsonImporter::convertWith<&ASTJsonImporter::createUnaryOperation>},
+		{"BinaryOperation", &ASTJsonImporter::convertWith<&ASTJsonImporter::createBinaryOperation>},
+		{"FunctionCall", &ASTJsonImporter::convertWith<&ASTJsonImporter::createFunctionCall>},
+		{"FunctionCallOptions", &ASTJsonImporter::convertWith<&ASTJsonImporter::createFunctionCallOptions>},
+		{"NewExpression", &ASTJsonImporter::convertWith<&ASTJsonImporter::createNewExpression>},
+		{"MemberAccess", &ASTJsonImporter::convertWith<&ASTJsonImporter::createMemberAccess>},
+		{"IndexAccess", &ASTJsonImporter::convertWith<&ASTJsonImporter::createIndexAccess>},
+		{"IndexRangeAccess", &ASTJsonImporter::convertWith<&ASTJsonImporter::createIndexRangeAccess>},
+		{"Identifier", &ASTJsonImporter::convertWith<&ASTJsonImporter::createIdentifier>},
+		{"ElementaryTypeNameExpression", &ASTJsonImporter::convertWith<&ASTJsonImporter::createElementaryTypeNameExpression>},
+		{"Literal", &ASTJsonImporter::convertWith<&ASTJsonImporter::createLiteral>},
+		{"StructuredDocumentation", &ASTJsonImporter::convertWith<&ASTJsonImporter::createDocumentation>}
+	};
+
+	Json::Value const& nodeTypeJson = _json["nodeType"];
+	astAssert(nodeTypeJson.isString() && _json.isMember("id"), "JSON-Node needs to have 'nodeType' and 'id' fields.");
+	char const* nodeTypeBegin = nullptr;
+	char const* nodeTypeEnd = nullptr;
+	nodeTypeJson.getString(&nodeTypeBegin, &nodeTypeEnd);
+	string_view const nodeType{nodeTypeBegin, static_cast<size_t>(nodeTypeEnd - nodeTypeBegin)};
+	auto const converter = converters.find(nodeType);
+	astAssert(converter != converters.end(), "Unknown type of ASTNode: " + string(nodeType));
+	return converter->second(*this, _json);
 }
 
 // ============ functions to instantiate the AST-Nodes from Json-Nodes ==============
@@ -961,11 +971,12 @@ ASTPointer<StructuredDocumentation> ASTJsonImporter::createDocumentation(Json::V
 
 // ===== helper functions ==========
 
-Json::Value ASTJsonImporter::member(Json::Value const& _node, string const& _name)
+Json::Value const& ASTJsonImporter::member(Json::Value const& _node, string const& _name)
 {
-	if (!_node.isMember(_name))
-		return Json::nullValue;
-	return _node[_name];
+	static Json::Value const null;
+	if (Json::Value const* value = _node.find(_name.data(), _name.data() + _name.size()))
+		return *value;
+	return null;
 }
 
 Token ASTJsonImporter::scanSingleToken(Json::Value const& _node)
@@ -983,16 +994,16 @@ ASTPointer<ASTString> ASTJsonImporter::nullOrASTString(Json::Value const& _json,
 
 ASTPointer<ASTString> ASTJsonImporter::memberAsASTString(Json::Value const& _node, string const& _name)
 {
-	Json::Value value = member(_node, _name);
+	Json::Value const& value = member(_node, _name);
 	astAssert(value.isString(), "field " + _name + " must be of type string.");
-	return make_shared<ASTString>(_node[_name].asString());
+	return make_shared<ASTString>(value.asString());
 }
 
 bool ASTJsonImporter::memberAsBool(Json::Value const& _node, string const& _name)
 {
-	Json::Value value = member(_node, _name);
+	Json::Value const& value = member(_node, _name);
 	astAssert(value.isBool(), "field " + _name + " must be of type boolean.");
-	return _node[_name].asBool();
+	return value.asBool();
 }
 
 
@@ -1034,7 +1045,7 @@ Token ASTJsonImporter::literalTokenKind(Json::Value const& _node)
 
 Visibility ASTJsonImporter::visibility(Json::Value const& _node)
 {
-	Json::Value visibility = member(_node, "visibility");
+	Json::Value const& visibility = member(_node, "visibility");
 	astAssert(visibility.isString(), "'visibility' expected to be a string.");
 
 	string const visibilityStr = visibility.asString();
@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include <unordered_set>
 #include <vector>
 #include <libsolidity/ast/AST.h>
 #include <json/json.h>
@@ -30,6 +31,7 @@
 #include <liblangutil/EVMVersion.h>
 #include <liblangutil/Exceptions.h>
 #include <liblangutil/SourceLocation.h>
+#include <libsolutil/Arena.h>
 
 namespace solidity::frontend
 {
@@ -46,10 +48,16 @@ public:
 
 	/// Converts the AST from JSON-format to ASTPointer
 	/// @a _sourceList used to provide source names for the ASTs
+	/// @a _parallelism number of source units that are imported at the same time
 	/// @returns map of sourcenames to their respective ASTs
-	std::map<std::string, ASTPointer<SourceUnit>> jsonToSourceUnit(std::map<std::string, Json::Value> const& _sourceList);
+	std::map<std::string, ASTPointer<SourceUnit>> jsonToSourceUnit(
+		std::map<std::string, Json::Value> const& _sourceList,
+		size_t _parallelism = 1
+	);
 
 private:
+	/// Imports a single source unit into its own arena.
+	void importSourceUnit(std::string const& _sourceName, Json::Value const& _sourceJson);
 
 	// =========== general creation functions ==============
 
@@ -129,8 +137,14 @@ private:
 	///@}
 
 	// =============== general helper functions ===================
-	/// @returns the member of a given JSON object, throws if member does not exist
-	Json::Value member(Json::Value const& _node, std::string const& _name);
+	/// @returns the member of a given JSON object, or a null value if it does not exist
+	Json::Value const& member(Json::Value const& _node, std::string const& _name);
+	/// Converts @a _node using @a Create, for the table of converters of the node types.
+	template<auto Create>
+	static ASTPointer<ASTNode> convertWith(ASTJsonImporter& _importer, Json::Value const& _node)
+	{
+		return (_importer.*Create)(_node);
+	}
 	/// @returns the appropriate TokenObject used in parsed Strings (pragma directive or operator)
 	Token scanSingleToken(Json::Value const& _node);
 	template<class T>
@@ -154,11 +168,13 @@ private:
 
 	// =========== member variables ===============
 	/// list of source names, order by source index
-	std::vector<std::shared_ptr<std::string const>> m_sourceNames;
+	std::vector<langutil::SourceName> m_sourceNames;
 	/// filepath to AST
 	std::map<std::string, ASTPointer<SourceUnit>> m_sourceUnits;
 	/// IDs already used by the nodes
-	std::set<int64_t> m_usedIDs;
+	std::unordered_set<int64_t> m_usedIDs;
+	/// Memory of the nodes of the source unit that is being imported
+	std::shared_ptr<util::Arena> m_arena;
 	/// Configured EVM version
 	langutil::EVMVersion m_evmVersion;
 };
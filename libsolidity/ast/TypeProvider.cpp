@@ -21,6 +21,8 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/split.hpp>
 
+#include <algorithm>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::frontend;
@@ -174,6 +176,37 @@ inline void clearCaches(Container& container)
 		clearCache(e);
 }
 
+/// @returns true if @a _type is an elementary type or only built from elementary types,
+/// so that it does not depend on anything of a compilation and can be kept by reset().
+bool isBuiltFromElementaryTypes(Type const* _type)
+{
+	if (!_type)
+		return false;
+	switch (_type->category())
+	{
+	case Type::Category::Address:
+	case Type::Category::Bool:
+	case Type::Category::FixedBytes:
+	case Type::Category::FixedPoint:
+	case Type::Category::Integer:
+		return true;
+	case Type::Category::Array:
+		return isBuiltFromElementaryTypes(dynamic_cast<ArrayType const&>(*_type).baseType());
+	case Type::Category::Mapping:
+	{
+		auto const& mapping = dynamic_cast<MappingType const&>(*_type);
+		return isBuiltFromElementaryTypes(mapping.keyType()) && isBuiltFromElementaryTypes(mapping.valueType());
+	}
+	case Type::Category::Tuple:
+	{
+		auto const& components = dynamic_cast<TupleType const&>(*_type).components();
+		return all_of(components.begin(), components.end(), isBuiltFromElementaryTypes);
+	}
+	default:
+		return false;
+	}
+}
+
 void TypeProvider::reset()
 {
 	clearCache(m_boolean);
@@ -190,11 +223,17 @@ void TypeProvider::reset()
 	clearCaches(instance().m_uintM);
 	clearCaches(instance().m_bytesM);
 	clearCaches(instance().m_magics);
+	for (auto const& fixedPointTypes: {&instance().m_ufixedMxN, &instance().m_fixedMxN})
+		for (auto const& [bits, type]: *fixedPointTypes)
+			clearCache(type);
+	for (auto const& [identifier, type]: instance().m_persistentTypes)
+		clearCache(type);
 
 	instance().m_generalTypes.clear();
+	instance().m_internedTypes.clear();
 	instance().m_stringLiteralTypes.clear();
-	instance().m_ufixedMxN.clear();
-	instance().m_fixedMxN.clear();
+	instance().m_boundFunctions.clear();
+	instance().m_constantValues.clear();
 }
 
 template <typename T, typename... Args>
@@ -204,6 +243,38 @@ inline T const* TypeProvider::createAndGet(Args&& ... _args)
 	return static_cast<T const*>(instance().m_generalTypes.back().get());
 }
 
+template <typename T, typename... Args>
+inline T const* TypeProvider::createAndGetInterned(Args&& ... _args)
+{
+	return static_cast<T const*>(intern(make_unique<T>(std::forward<Args>(_args)...)));
+}
+
+Type const* TypeProvider::intern(unique_ptr<Type> _type)
+{
+	string identifier = _type->richIdentifier();
+	// The identifiers of function and modifier types do not include their declaration and
+	// the identifiers of rational number types do not include the compatible bytes type.
+	// Types containing such types are therefore not interned.
+	bool const interned =
+		identifier.find("t_function") == string::npos &&
+		identifier.find("t_modifier") == string::npos &&
+		identifier.find("t_rational") == string::npos;
+	if (interned)
+	{
+		if (auto it = instance().m_persistentTypes.find(identifier); it != instance().m_persistentTypes.end())
+			return it->second.get();
+		if (auto it = instance().m_internedTypes.find(identifier); it != instance().m_internedTypes.end())
+			return it->second;
+		if (isBuiltFromElementaryTypes(_type.get()))
+			return instance().m_persistentTypes.emplace(move(identifier), move(_type)).first->second.get();
+	}
+
+	Type const* type = instance().m_generalTypes.emplace_back(move(_type)).get();
+	if (interned)
+		instance().m_internedTypes.emplace(move(identifier), type);
+	return type;
+}
+
 Type const* TypeProvider::fromElementaryTypeName(ElementaryTypeNameToken const& _type, std::optional<StateMutability> _stateMutability)
 {
 	solAssert(
@@ -404,7 +475,7 @@ TupleType const* TypeProvider::tuple(vector<Type const*> members)
 	if (members.empty())
 		return &m_emptyTuple;
 
-	return createAndGet<TupleType>(move(members));
+	return createAndGetInterned<TupleType>(move(members));
 }
 
 ReferenceType const* TypeProvider::withLocation(ReferenceType const* _type, DataLocation _location, bool _isPointer)
@@ -412,8 +483,7 @@ ReferenceType const* TypeProvider::withLocation(ReferenceType const* _type, Data
 	if (_type->location() == _location && _type->isPointer() == _isPointer)
 		return _type;
 
-	instance().m_generalTypes.emplace_back(_type->copyForLocation(_location, _isPointer));
-	return static_cast<ReferenceType const*>(instance().m_generalTypes.back().get());
+	return static_cast<ReferenceType const*>(intern(_type->copyForLocation(_location, _isPointer)));
 }
 
 FunctionType const* TypeProvider::function(FunctionDefinition const& _function, FunctionType::Kind _kind)
@@ -504,17 +574,17 @@ ArrayType const* TypeProvider::array(DataLocation _location, bool _isString)
 		if (_location == DataLocation::Memory)
 			return bytesMemory();
 	}
-	return createAndGet<ArrayType>(_location, _isString);
+	return createAndGetInterned<ArrayType>(_location, _isString);
 }
 
 ArrayType const* TypeProvider::array(DataLocation _location, Type const* _baseType)
 {
-	return createAndGet<ArrayType>(_location, _baseType);
+	return createAndGetInterned<ArrayType>(_location, _baseType);
 }
 
 ArrayType const* TypeProvider::array(DataLocation _location, Type const* _baseType, u256 const& _length)
 {
-	return createAndGet<ArrayType>(_location, _baseType, _length);
+	return createAndGetInterned<ArrayType>(_location, _baseType, _length);
 }
 
 ArraySliceType const* TypeProvider::arraySlice(ArrayType const& _arrayType)
@@ -573,7 +643,7 @@ MagicType const* TypeProvider::meta(Type const* _type)
 
 MappingType const* TypeProvider::mapping(Type const* _keyType, Type const* _valueType)
 {
-	return createAndGet<MappingType>(_keyType, _valueType);
+	return createAndGetInterned<MappingType>(_keyType, _valueType);
 }
 
 UserDefinedValueType const* TypeProvider::userDefinedValueType(UserDefinedValueTypeDefinition const& _definition)
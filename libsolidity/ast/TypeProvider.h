@@ -24,6 +24,7 @@
 #include <map>
 #include <memory>
 #include <optional>
+#include <unordered_map>
 #include <utility>
 
 namespace solidity::frontend
@@ -49,7 +50,8 @@ public:
 	~TypeProvider() = default;
 
 	/// Resets state of this TypeProvider to initial state, wiping all mutable types.
-	/// This invalidates all dangling pointers to types provided by this TypeProvider.
+	/// This invalidates all dangling pointers to types provided by this TypeProvider,
+	/// except for the elementary types and the types only built from them, whose caches are cleared.
 	static void reset();
 
 	/// @name Factory functions
@@ -199,6 +201,21 @@ public:
 
 	static UserDefinedValueType const* userDefinedValueType(UserDefinedValueTypeDefinition const& _definition);
 
+	/// @returns the functions attached by `using for` directives, indexed by the scope they are visible in
+	/// and the identifier of the type they are attached to. Types are not unique, so this is shared
+	/// by all instances of a type and only cleared by reset().
+	static std::map<std::pair<ASTNode const*, std::string>, MemberList::MemberMap>& boundFunctionsCache()
+	{
+		return instance().m_boundFunctions;
+	}
+
+	/// @returns the types and values of constant variables computed by the ConstantEvaluator,
+	/// nullopt if the value is not a compile-time constant. Only cleared by reset().
+	static std::map<VariableDeclaration const*, std::optional<std::pair<Type const*, rational>>>& constantValueCache()
+	{
+		return instance().m_constantValues;
+	}
+
 private:
 	/// Global TypeProvider instance.
 	static TypeProvider& instance()
@@ -210,6 +227,12 @@ private:
 	template <typename T, typename... Args>
 	static inline T const* createAndGet(Args&& ... _args);
 
+	/// Like createAndGet, but returns the previously created type of the same identifier
+	/// if there is one and the type is fully determined by its identifier.
+	template <typename T, typename... Args>
+	static inline T const* createAndGetInterned(Args&& ... _args);
+	static Type const* intern(std::unique_ptr<Type> _type);
+
 	static BoolType const m_boolean;
 	static InaccessibleDynamicType const m_inaccessibleDynamic;
 
@@ -228,10 +251,19 @@ private:
 	static std::array<std::unique_ptr<FixedBytesType>, 32> const m_bytesM;
 	static std::array<std::unique_ptr<MagicType>, 4> const m_magics;        ///< MagicType's except MetaType
 
+	/// Like the other elementary types, the fixed point types are kept by reset().
 	std::map<std::pair<unsigned, unsigned>, std::unique_ptr<FixedPointType>> m_ufixedMxN{};
 	std::map<std::pair<unsigned, unsigned>, std::unique_ptr<FixedPointType>> m_fixedMxN{};
 	std::map<std::string, std::unique_ptr<StringLiteralType>> m_stringLiteralTypes{};
 	std::vector<std::unique_ptr<Type>> m_generalTypes{};
+	/// Types in m_generalTypes that were interned, indexed by their rich identifier.
+	std::unordered_map<std::string, Type const*> m_internedTypes{};
+	/// Interned types only built from elementary types, indexed by their rich identifier.
+	/// They do not depend on anything of a compilation and are kept by reset(), so that
+	/// long-running processes do not create them again for every compilation.
+	std::unordered_map<std::string, std::unique_ptr<Type>> m_persistentTypes{};
+	std::map<std::pair<ASTNode const*, std::string>, MemberList::MemberMap> m_boundFunctions{};
+	std::map<VariableDeclaration const*, std::optional<std::pair<Type const*, rational>>> m_constantValues{};
 };
 
 }
@@ -173,16 +173,33 @@ pair<u256, unsigned> const* StorageOffsets::offset(size_t _index) const
 void MemberList::combine(MemberList const & _other)
 {
 	m_memberTypes += _other.m_memberTypes;
+	m_storageOffsets = {};
+	m_memberIndices = {};
 }
 
-pair<u256, unsigned> const* MemberList::memberStorageOffset(string const& _name) const
+Type const* MemberList::memberType(string const& _name) const
 {
-	StorageOffsets const& offsets = storageOffsets();
+	vector<size_t> const& indices = memberIndices(_name);
+	if (indices.empty())
+		return nullptr;
+	solAssert(indices.size() == 1, "Requested member type by non-unique name.");
+	return m_memberTypes[indices.front()].type;
+}
 
-	for (auto&& [index, member]: m_memberTypes | ranges::views::enumerate)
-		if (member.name == _name)
-			return offsets.offset(index);
-	return nullptr;
+MemberList::MemberMap MemberList::membersByName(string const& _name) const
+{
+	MemberMap members;
+	for (size_t index: memberIndices(_name))
+		members.push_back(m_memberTypes[index]);
+	return members;
+}
+
+pair<u256, unsigned> const* MemberList::memberStorageOffset(string const& _name) const
+{
+	vector<size_t> const& indices = memberIndices(_name);
+	if (indices.empty())
+		return nullptr;
+	return storageOffsets().offset(indices.front());
 }
 
 u256 const& MemberList::storageSize() const
@@ -204,6 +221,19 @@ StorageOffsets const& MemberList::storageOffsets() const {
 	});
 }
 
+vector<size_t> const& MemberList::memberIndices(string const& _name) const
+{
+	static vector<size_t> const noMembers;
+	auto const& indices = m_memberIndices.init([&]{
+		map<string, vector<size_t>, less<>> result;
+		for (auto&& [index, member]: m_memberTypes | ranges::views::enumerate)
+			result[member.name].push_back(index);
+		return result;
+	});
+	auto it = indices.find(_name);
+	return it == indices.end() ? noMembers : it->second;
+}
+
 /// Helper functions for type identifier
 namespace
 {
@@ -260,15 +290,19 @@ string Type::escapeIdentifier(string const& _identifier)
 	return ret;
 }
 
-string Type::identifier() const
+string const& Type::identifier() const
 {
-	string ret = escapeIdentifier(richIdentifier());
-	solAssert(ret.find_first_of("0123456789") != 0, "Identifier cannot start with a number.");
-	solAssert(
-		ret.find_first_not_of("0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMONPQRSTUVWXYZ_$") == string::npos,
-		"Identifier contains invalid characters."
-	);
-	return ret;
+	if (!m_identifier)
+	{
+		string ret = escapeIdentifier(richIdentifier());
+		solAssert(ret.find_first_of("0123456789") != 0, "Identifier cannot start with a number.");
+		solAssert(
+			ret.find_first_not_of("0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMONPQRSTUVWXYZ_$") == string::npos,
+			"Identifier contains invalid characters."
+		);
+		m_identifier = move(ret);
+	}
+	return *m_identifier;
 }
 
 Type const* Type::commonType(Type const* _a, Type const* _b)
@@ -327,8 +361,13 @@ Type const* Type::fullEncodingType(bool _inLibraryCall, bool _encoderV2, bool) c
 	return encodingType;
 }
 
-MemberList::MemberMap Type::boundFunctions(Type const& _type, ASTNode const& _scope)
+MemberList::MemberMap const& Type::boundFunctions(Type const& _type, ASTNode const& _scope)
 {
+	auto& cache = TypeProvider::boundFunctionsCache();
+	pair<ASTNode const*, string> key{&_scope, _type.richIdentifier()};
+	if (auto cached = cache.find(key); cached != cache.end())
+		return cached->second;
+
 	vector<UsingForDirective const*> usingForDirectives;
 	if (auto const* sourceUnit = dynamic_cast<SourceUnit const*>(&_scope))
 		usingForDirectives += ASTNode::filteredNodes<UsingForDirective>(sourceUnit->nodes());
@@ -379,7 +418,7 @@ MemberList::MemberMap Type::boundFunctions(Type const& _type, ASTNode const& _sc
 		}
 	}
 
-	return members;
+	return cache[move(key)] = move(members);
 }
 
 AddressType::AddressType(StateMutability _stateMutability):
@@ -1603,6 +1642,8 @@ string ArrayType::richIdentifier() const
 
 bool ArrayType::operator==(Type const& _other) const
 {
+	if (this == &_other)
+		return true;
 	if (_other.category() != category())
 		return false;
 	ArrayType const& other = dynamic_cast<ArrayType const&>(_other);
@@ -2595,6 +2636,8 @@ string TupleType::richIdentifier() const
 
 bool TupleType::operator==(Type const& _other) const
 {
+	if (this == &_other)
+		return true;
 	if (auto tupleType = dynamic_cast<TupleType const*>(&_other))
 		return components() == tupleType->components();
 	else
@@ -3643,6 +3686,8 @@ string MappingType::richIdentifier() const
 
 bool MappingType::operator==(Type const& _other) const
 {
+	if (this == &_other)
+		return true;
 	if (_other.category() != category())
 		return false;
 	MappingType const& other = dynamic_cast<MappingType const&>(_other);
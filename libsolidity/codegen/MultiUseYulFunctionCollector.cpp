@@ -39,8 +39,27 @@ string MultiUseYulFunctionCollector::requestedFunctions()
 	return result;
 }
 
+shared_ptr<SharedYulFunctions::Function const> SharedYulFunctions::find(string const& _name) const
+{
+	lock_guard<mutex> lock(m_mutex);
+	auto it = m_functions.find(_name);
+	return it == m_functions.end() ? nullptr : it->second;
+}
+
+void SharedYulFunctions::store(string const& _name, Function _function)
+{
+	lock_guard<mutex> lock(m_mutex);
+	// The code can only be reused if the functions it requested can be reused as well.
+	for (string const& dependency: _function.dependencies)
+		if (!m_functions.count(dependency) && dependency != _name)
+			return;
+	m_functions.emplace(_name, make_shared<Function const>(move(_function)));
+}
+
 string MultiUseYulFunctionCollector::createFunction(string const& _name, function<string ()> const& _creator)
 {
+	if (!m_recordings.empty())
+		m_recordings.back().shareable = false;
 	if (!m_requestedFunctions.count(_name))
 	{
 		m_requestedFunctions.insert(_name);
@@ -58,24 +77,88 @@ string MultiUseYulFunctionCollector::createFunction(
 )
 {
 	solAssert(!_name.empty(), "");
+	if (!m_recordings.empty())
+		m_recordings.back().shareable = false;
 	if (!m_requestedFunctions.count(_name))
 	{
 		m_requestedFunctions.insert(_name);
-		vector<string> arguments;
-		vector<string> returnParameters;
-		string body = _creator(arguments, returnParameters);
-		solAssert(!body.empty(), "");
+		m_code += functionCode(_name, _creator);
+	}
+	return _name;
+}
+
+string MultiUseYulFunctionCollector::createSharedFunction(string const& _name, function<string()> const& _creator)
+{
+	if (!m_sharedFunctions)
+		return createFunction(_name, _creator);
+
+	if (!m_recordings.empty())
+		m_recordings.back().dependencies.emplace_back(_name);
+	if (m_requestedFunctions.count(_name))
+		return _name;
+	if (auto sharedFunction = m_sharedFunctions->find(_name))
+	{
+		addSharedFunction(_name, *sharedFunction);
+		return _name;
+	}
+
+	m_requestedFunctions.insert(_name);
+	m_recordings.emplace_back();
+	string fun = _creator();
+	Recording recording = move(m_recordings.back());
+	m_recordings.pop_back();
+	solAssert(!fun.empty(), "");
+	solAssert(fun.find("function " + _name + "(") != string::npos, "Function not properly named.");
+
+	if (recording.shareable)
+		m_sharedFunctions->store(_name, {fun, move(recording.dependencies)});
+	else if (!m_recordings.empty())
+		m_recordings.back().shareable = false;
+	m_code += move(fun);
+	return _name;
+}
 
-		m_code += Whiskers(R"(
+string MultiUseYulFunctionCollector::createSharedFunction(
+	string const& _name,
+	function<string(vector<string>&, vector<string>&)> const& _creator
+)
+{
+	solAssert(!_name.empty(), "");
+	return createSharedFunction(_name, [&]() { return functionCode(_name, _creator); });
+}
+
+string MultiUseYulFunctionCollector::functionCode(
+	string const& _name,
+	function<string(vector<string>&, vector<string>&)> const& _creator
+)
+{
+	vector<string> arguments;
+	vector<string> returnParameters;
+	string body = _creator(arguments, returnParameters);
+	solAssert(!body.empty(), "");
+
+	// Keeps the indentation of the generated code unchanged.
+	return Whiskers(R"(
 			function <functionName>(<args>)<?+retParams> -> <retParams></+retParams> {
 				<body>
 			}
 		)")
-		("functionName", _name)
-		("args", joinHumanReadable(arguments))
-		("retParams", joinHumanReadable(returnParameters))
-		("body", body)
-		.render();
-	}
-	return _name;
+	("functionName", _name)
+	("args", joinHumanReadable(arguments))
+	("retParams", joinHumanReadable(returnParameters))
+	("body", body)
+	.render();
+}
+
+void MultiUseYulFunctionCollector::addSharedFunction(string const& _name, SharedYulFunctions::Function const& _function)
+{
+	m_requestedFunctions.insert(_name);
+	for (string const& dependency: _function.dependencies)
+		if (!m_requestedFunctions.count(dependency))
+		{
+			auto sharedDependency = m_sharedFunctions->find(dependency);
+			solAssert(sharedDependency, "");
+			addSharedFunction(dependency, *sharedDependency);
+		}
+	m_code += _function.code;
 }
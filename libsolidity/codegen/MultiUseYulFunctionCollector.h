@@ -24,12 +24,40 @@
 
 #include <functional>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <set>
+#include <vector>
 
 namespace solidity::frontend
 {
 
+/**
+ * Utility functions generated during one compilation, shared between the collectors of all
+ * contracts so that each of them is only generated once.
+ * Can be used from multiple threads at the same time.
+ */
+class SharedYulFunctions
+{
+public:
+	struct Function
+	{
+		std::string code;
+		/// Functions requested while generating the code, in the order of the requests.
+		std::vector<std::string> dependencies;
+	};
+
+	/// @returns the function stored under @a _name, if any.
+	std::shared_ptr<Function const> find(std::string const& _name) const;
+	/// Stores @a _function under @a _name, unless one of its dependencies is not stored.
+	void store(std::string const& _name, Function _function);
+
+private:
+	mutable std::mutex m_mutex;
+	std::map<std::string, std::shared_ptr<Function const>> m_functions;
+};
+
 /**
  * Container of (unparsed) Yul functions identified by name which are meant to be generated
  * only once.
@@ -37,6 +65,10 @@ namespace solidity::frontend
 class MultiUseYulFunctionCollector
 {
 public:
+	explicit MultiUseYulFunctionCollector(std::shared_ptr<SharedYulFunctions> _sharedFunctions = nullptr):
+		m_sharedFunctions(std::move(_sharedFunctions))
+	{}
+
 	/// Helper function that uses @a _creator to create a function and add it to
 	/// @a m_requestedFunctions if it has not been created yet and returns @a _name in both
 	/// cases.
@@ -47,6 +79,16 @@ public:
 		std::function<std::string(std::vector<std::string>&, std::vector<std::string>&)> const& _creator
 	);
 
+	/// Like createFunction, but for functions whose code only depends on their name and the
+	/// settings of the compilation. Reuses the code generated by the other collectors sharing
+	/// @a m_sharedFunctions instead of calling @a _creator, including the functions it requested.
+	std::string createSharedFunction(std::string const& _name, std::function<std::string()> const& _creator);
+
+	std::string createSharedFunction(
+		std::string const& _name,
+		std::function<std::string(std::vector<std::string>&, std::vector<std::string>&)> const& _creator
+	);
+
 	/// @returns concatenation of all generated functions in the order in which they were
 	/// generated.
 	/// Clears the internal list, i.e. calling it again will result in an
@@ -56,9 +98,29 @@ public:
 	/// @returns true IFF a function with the specified name has already been collected.
 	bool contains(std::string const& _name) const { return m_requestedFunctions.count(_name) > 0; }
 
+	std::shared_ptr<SharedYulFunctions> const& sharedFunctions() const { return m_sharedFunctions; }
+
 private:
+	/// Functions requested while generating a shared function.
+	struct Recording
+	{
+		std::vector<std::string> dependencies;
+		/// False if a function that cannot be shared was requested.
+		bool shareable = true;
+	};
+
+	static std::string functionCode(
+		std::string const& _name,
+		std::function<std::string(std::vector<std::string>&, std::vector<std::string>&)> const& _creator
+	);
+	/// Adds @a _function and the ones it depends on, unless they were already requested.
+	void addSharedFunction(std::string const& _name, SharedYulFunctions::Function const& _function);
+
 	std::set<std::string> m_requestedFunctions;
 	std::string m_code;
+	std::shared_ptr<SharedYulFunctions> m_sharedFunctions;
+	/// Stack of the shared functions currently being generated.
+	std::vector<Recording> m_recordings;
 };
 
 }
@@ -262,6 +262,11 @@ public:
 	/// signature (to_slot, from_slot) ->
 	std::string copyValueArrayStorageToStorageFunction(ArrayType const& _fromType, ArrayType const& _toType);
 
+	/// @returns the name of a function that will copy an array of value types that are packed
+	/// into storage slots from memory or calldata to storage, writing each slot once.
+	/// signature (to_slot, from_ptr[, from_length]) ->
+	std::string copyPackedValueArrayToStorageFunction(ArrayType const& _fromType, ArrayType const& _toType);
+
 	/// Returns the name of a function that will convert a given length to the
 	/// size in memory (number of storage slots or calldata/memory bytes) it
 	/// will require.
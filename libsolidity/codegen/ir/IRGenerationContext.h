@@ -76,13 +76,15 @@ public:
 		OptimiserSettings _optimiserSettings,
 		std::map<std::string, unsigned> _sourceIndices,
 		langutil::DebugInfoSelection const& _debugInfoSelection,
-		langutil::CharStreamProvider const* _soliditySourceProvider
+		langutil::CharStreamProvider const* _soliditySourceProvider,
+		std::shared_ptr<SharedYulFunctions> _sharedYulFunctions = nullptr
 	):
 		m_evmVersion(_evmVersion),
 		m_executionContext(_executionContext),
 		m_revertStrings(_revertStrings),
 		m_optimiserSettings(std::move(_optimiserSettings)),
 		m_sourceIndices(std::move(_sourceIndices)),
+		m_functions(std::move(_sharedYulFunctions)),
 		m_debugInfoSelection(_debugInfoSelection),
 		m_soliditySourceProvider(_soliditySourceProvider)
 	{}
@@ -158,6 +160,8 @@ public:
 
 	RevertStrings revertStrings() const { return m_revertStrings; }
 
+	OptimiserSettings const& optimiserSettings() const { return m_optimiserSettings; }
+
 	std::set<ContractDefinition const*, ASTNode::CompareByID>& subObjectsCreated() { return m_subObjects; }
 
 	bool inlineAssemblySeen() const { return m_inlineAssemblySeen; }
@@ -30,6 +30,8 @@
 #include <libsolidity/codegen/ABIFunctions.h>
 #include <libsolidity/codegen/CompilerUtils.h>
 
+#include <libevmasm/GasMeter.h>
+
 #include <libyul/AssemblyStack.h>
 #include <libyul/Utilities.h>
 
@@ -40,6 +42,8 @@
 
 #include <liblangutil/SourceReferenceFormatter.h>
 
+#include <boost/algorithm/string/predicate.hpp>
+
 #include <sstream>
 #include <variant>
 
@@ -85,6 +89,77 @@ set<CallableDeclaration const*, ASTNode::CompareByID> collectReachableCallables(
 	return reachableCallables;
 }
 
+/// Code of the dispatcher for one external function.
+struct DispatchCase
+{
+	FixedHash<4> selector;
+	/// Number of calls of the function according to the execution profile, zero if unknown.
+	size_t executions = 0;
+	string code;
+};
+
+/// @returns true if the selection among @a _cases functions should be split into a comparison
+/// with the selector in the middle and the selection among the functions on either side.
+bool splitDispatch(SelectorDispatch _strategy, size_t _cases, size_t _runs)
+{
+	if (_strategy == SelectorDispatch::Switch || _cases <= 4)
+		return false;
+	if (_strategy == SelectorDispatch::BinarySearch)
+		return true;
+	// Same estimate as in ContractCompiler::appendInternalSelector: Each split saves 6 * (n - 4) gas
+	// per call on average and costs about 17 bytes of code.
+	// Start with a comparison to avoid overflow.
+	if (_runs > (17 * evmasm::GasCosts::createDataGas) / 6)
+		return true;
+	return _runs * 6 * (_cases - 4) > 17 * evmasm::GasCosts::createDataGas;
+}
+
+/// @returns code that runs the case for the value of the variable ``selector`` among
+/// @a _cases[_begin] to @a _cases[_end - 1], which are sorted by selector, and does nothing if there is none.
+string selectorDispatch(
+	vector<DispatchCase> const& _cases,
+	size_t _begin,
+	size_t _end,
+	SelectorDispatch _strategy,
+	size_t _runs
+)
+{
+	if (splitDispatch(_strategy, _end - _begin, _runs))
+	{
+		size_t pivot = _begin + (_end - _begin) / 2;
+		return Whiskers(R"(
+			switch lt(selector, <pivot>)
+			case 0
+			{
+				<larger>
+			}
+			default
+			{
+				<smaller>
+			}
+		)")
+		("pivot", "0x" + _cases[pivot].selector.hex())
+		("larger", selectorDispatch(_cases, pivot, _end, _strategy, _runs))
+		("smaller", selectorDispatch(_cases, _begin, pivot, _strategy, _runs))
+		.render();
+	}
+
+	vector<DispatchCase const*> cases;
+	for (size_t i = _begin; i < _end; ++i)
+		cases.push_back(&_cases[i]);
+	// Cases are compared in order, so the most frequently called functions come first.
+	// Without an execution profile, this keeps the order of the selectors.
+	if (_strategy != SelectorDispatch::Switch)
+		stable_sort(cases.begin(), cases.end(), [](DispatchCase const* _a, DispatchCase const* _b) {
+			return _a->executions > _b->executions;
+		});
+
+	string code = "switch selector\n";
+	for (DispatchCase const* dispatchCase: cases)
+		code += dispatchCase->code;
+	return code + "\ndefault {}";
+}
+
 }
 
 pair<string, string> IRGenerator::run(
@@ -93,35 +168,67 @@ pair<string, string> IRGenerator::run(
 	map<ContractDefinition const*, string_view const> const& _otherYulSources
 )
 {
-	string const ir = yul::reindent(generate(_contract, _cborMetadata, _otherYulSources));
+	auto [ir, asmStack] = runToAssemblyStack(_contract, _cborMetadata, _otherYulSources);
+	return {ir, irWarning() + asmStack->print(m_context.soliditySourceProvider())};
+}
 
-	yul::AssemblyStack asmStack(
+pair<string, shared_ptr<yul::AssemblyStack>> IRGenerator::runToAssemblyStack(
+	ContractDefinition const& _contract,
+	bytes const& _cborMetadata,
+	map<ContractDefinition const*, string_view const> const& _otherYulSources
+)
+{
+	string ir = runUnoptimized(_contract, _cborMetadata, _otherYulSources);
+	shared_ptr<yul::AssemblyStack> asmStack = parseAndOptimize(ir);
+	return {move(ir), move(asmStack)};
+}
+
+string IRGenerator::runUnoptimized(
+	ContractDefinition const& _contract,
+	bytes const& _cborMetadata,
+	map<ContractDefinition const*, string_view const> const& _otherYulSources
+)
+{
+	return irWarning() + yul::reindent(generate(_contract, _cborMetadata, _otherYulSources));
+}
+
+shared_ptr<yul::AssemblyStack> IRGenerator::parseAndOptimize(string const& _ir)
+{
+	solAssert(boost::starts_with(_ir, irWarning()), "");
+	string const ir = _ir.substr(irWarning().size());
+
+	auto asmStack = make_shared<yul::AssemblyStack>(
 		m_evmVersion,
 		yul::AssemblyStack::Language::StrictAssembly,
 		m_optimiserSettings,
 		m_context.debugInfoSelection()
 	);
-	if (!asmStack.parseAndAnalyze("", ir))
+	if (!asmStack->parseAndAnalyze("", ir))
 	{
 		string errorMessage;
-		for (auto const& error: asmStack.errors())
+		for (auto const& error: asmStack->errors())
 			errorMessage += langutil::SourceReferenceFormatter::formatErrorInformation(
 				*error,
-				asmStack.charStream("")
+				asmStack->charStream("")
 			);
 		solAssert(false, ir + "\n\nInvalid IR generated:\n" + errorMessage + "\n");
 	}
-	asmStack.optimize();
+	asmStack->setOptimisedCodeCache(m_optimisedCodeCache);
+	asmStack->setParallelism(m_parallelism);
+	asmStack->optimize();
 
-	string warning =
+	return asmStack;
+}
+
+string IRGenerator::irWarning()
+{
+	return
 		"/*=====================================================*\n"
 		" *                       WARNING                       *\n"
 		" *  Solidity to Yul compilation is still EXPERIMENTAL  *\n"
 		" *       It can result in LOSS OF FUNDS or worse       *\n"
 		" *                !USE AT YOUR OWN RISK!               *\n"
 		" *=====================================================*/\n\n";
-
-	return {warning + ir, warning + asmStack.print(m_context.soliditySourceProvider())};
 }
 
 string IRGenerator::generate(
@@ -967,11 +1074,19 @@ string IRGenerator::callValueCheck()
 string IRGenerator::dispatchRoutine(ContractDefinition const& _contract)
 {
 	Whiskers t(R"X(
-		<?+cases>if iszero(lt(calldatasize(), 4))
+		<?cases>if iszero(lt(calldatasize(), 4))
 		{
 			let selector := <shr224>(calldataload(0))
-			switch selector
-			<#cases>
+			<selectorDispatch>
+		}</cases>
+		<?+receiveEther>if iszero(calldatasize()) { <receiveEther> }</+receiveEther>
+		<fallback>
+	)X");
+	t("shr224", m_utils.shiftRightFunction(224));
+	vector<DispatchCase> cases;
+	for (auto const& function: _contract.interfaceFunctions())
+	{
+		Whiskers templ(R"X(
 			case <functionSelector>
 			{
 				// <functionName>
@@ -983,21 +1098,10 @@ string IRGenerator::dispatchRoutine(ContractDefinition const& _contract)
 				let memEnd := <abiEncode>(memPos <?+retParams>,</+retParams> <retParams>)
 				return(memPos, sub(memEnd, memPos))
 			}
-			</cases>
-			default {}
-		}</+cases>
-		<?+receiveEther>if iszero(calldatasize()) { <receiveEther> }</+receiveEther>
-		<fallback>
-	)X");
-	t("shr224", m_utils.shiftRightFunction(224));
-	vector<map<string, string>> functions;
-	for (auto const& function: _contract.interfaceFunctions())
-	{
-		functions.emplace_back();
-		map<string, string>& templ = functions.back();
-		templ["functionSelector"] = "0x" + function.first.hex();
+		)X");
+		templ("functionSelector", "0x" + function.first.hex());
 		FunctionTypePointer const& type = function.second;
-		templ["functionName"] = type->externalSignature();
+		templ("functionName", type->externalSignature());
 		string delegatecallCheck;
 		if (_contract.isLibrary())
 		{
@@ -1010,28 +1114,53 @@ string IRGenerator::dispatchRoutine(ContractDefinition const& _contract)
 					m_utils.revertReasonIfDebugFunction("Non-view function of library called without DELEGATECALL") +
 					"() }";
 		}
-		templ["delegatecallCheck"] = delegatecallCheck;
-		templ["callValueCheck"] = (type->isPayable() || _contract.isLibrary()) ? "" : callValueCheck();
+		templ("delegatecallCheck", delegatecallCheck);
+		templ("callValueCheck", (type->isPayable() || _contract.isLibrary()) ? "" : callValueCheck());
 
-		unsigned paramVars = make_shared<TupleType>(type->parameterTypes())->sizeOnStack();
+		TypePointers parameterTypes = type->parameterTypes();
+		if (auto const* funDef = dynamic_cast<FunctionDefinition const*>(&type->declaration()))
+			for (size_t i = 0; i < parameterTypes.size(); ++i)
+			{
+				// Memory parameters that are only read can be changed to calldata by
+				// CalldataParameterRewriter, so they are not decoded into memory.
+				Type const* declaredType = funDef->parameters()[i]->annotation().type;
+				if (
+					TypeProvider::isReferenceWithLocation(declaredType, DataLocation::CallData) &&
+					!TypeProvider::isReferenceWithLocation(parameterTypes[i], DataLocation::CallData)
+				)
+					parameterTypes[i] = declaredType;
+			}
+		unsigned paramVars = make_shared<TupleType>(parameterTypes)->sizeOnStack();
 		unsigned retVars = make_shared<TupleType>(type->returnParameterTypes())->sizeOnStack();
 
 		ABIFunctions abiFunctions(m_evmVersion, m_context.revertStrings(), m_context.functionCollector());
-		templ["abiDecode"] = abiFunctions.tupleDecoder(type->parameterTypes());
-		templ["params"] = suffixedVariableNameList("param_", 0, paramVars);
-		templ["retParams"] = suffixedVariableNameList("ret_", 0, retVars);
+		templ("abiDecode", abiFunctions.tupleDecoder(parameterTypes));
+		templ("params", suffixedVariableNameList("param_", 0, paramVars));
+		templ("retParams", suffixedVariableNameList("ret_", 0, retVars));
 
 		if (FunctionDefinition const* funDef = dynamic_cast<FunctionDefinition const*>(&type->declaration()))
-			templ["function"] = m_context.enqueueFunctionForCodeGeneration(*funDef);
+			templ("function", m_context.enqueueFunctionForCodeGeneration(*funDef));
 		else if (VariableDeclaration const* varDecl = dynamic_cast<VariableDeclaration const*>(&type->declaration()))
-			templ["function"] = generateGetter(*varDecl);
+			templ("function", generateGetter(*varDecl));
 		else
 			solAssert(false, "Unexpected declaration for function!");
 
-		templ["allocateUnbounded"] = m_utils.allocateUnboundedFunction();
-		templ["abiEncode"] = abiFunctions.tupleEncoder(type->returnParameterTypes(), type->returnParameterTypes(), _contract.isLibrary());
+		templ("allocateUnbounded", m_utils.allocateUnboundedFunction());
+		templ("abiEncode", abiFunctions.tupleEncoder(type->returnParameterTypes(), type->returnParameterTypes(), _contract.isLibrary()));
+
+		size_t executions = 0;
+		if (m_optimiserSettings.executionProfile)
+			executions = m_optimiserSettings.executionProfile->executions(type->declaration().location()).value_or(0);
+		cases.push_back({function.first, executions, templ.render()});
 	}
-	t("cases", functions);
+	t("cases", !cases.empty());
+	t("selectorDispatch", selectorDispatch(
+		cases,
+		0,
+		cases.size(),
+		m_optimiserSettings.selectorDispatch,
+		m_optimiserSettings.expectedExecutionsPerDeployment
+	));
 	FunctionDefinition const* etherReceiver = _contract.receiveFunction();
 	if (etherReceiver)
 	{
@@ -1106,7 +1235,8 @@ void IRGenerator::resetContext(ContractDefinition const& _contract, ExecutionCon
 		m_optimiserSettings,
 		m_context.sourceIndices(),
 		m_context.debugInfoSelection(),
-		m_context.soliditySourceProvider()
+		m_context.soliditySourceProvider(),
+		m_context.functionCollector().sharedFunctions()
 	);
 	newContext.copyFunctionIDsFrom(m_context);
 	m_context = move(newContext);
@@ -32,8 +32,15 @@
 #include <liblangutil/CharStreamProvider.h>
 #include <liblangutil/EVMVersion.h>
 
+#include <memory>
 #include <string>
 
+namespace solidity::yul
+{
+class AssemblyStack;
+class OptimisedCodeCache;
+}
+
 namespace solidity::frontend
 {
 
@@ -50,10 +57,15 @@ public:
 		OptimiserSettings _optimiserSettings,
 		std::map<std::string, unsigned> _sourceIndices,
 		langutil::DebugInfoSelection const& _debugInfoSelection,
-		langutil::CharStreamProvider const* _soliditySourceProvider
+		langutil::CharStreamProvider const* _soliditySourceProvider,
+		std::shared_ptr<yul::OptimisedCodeCache> _optimisedCodeCache = nullptr,
+		std::shared_ptr<SharedYulFunctions> _sharedYulFunctions = nullptr,
+		size_t _parallelism = 1
 	):
 		m_evmVersion(_evmVersion),
 		m_optimiserSettings(_optimiserSettings),
+		m_optimisedCodeCache(std::move(_optimisedCodeCache)),
+		m_parallelism(_parallelism),
 		m_context(
 			_evmVersion,
 			ExecutionContext::Creation,
@@ -61,7 +73,8 @@ public:
 			std::move(_optimiserSettings),
 			std::move(_sourceIndices),
 			_debugInfoSelection,
-			_soliditySourceProvider
+			_soliditySourceProvider,
+			std::move(_sharedYulFunctions)
 		),
 		m_utils(_evmVersion, m_context.revertStrings(), m_context.functionCollector())
 	{}
@@ -74,6 +87,28 @@ public:
 		std::map<ContractDefinition const*, std::string_view const> const& _otherYulSources
 	);
 
+	/// Like run(), but instead of printing the optimized IR code, returns the assembly stack
+	/// holding it in parsed and analyzed form, so that EVM code can be generated from it
+	/// without parsing it again.
+	std::pair<std::string, std::shared_ptr<yul::AssemblyStack>> runToAssemblyStack(
+		ContractDefinition const& _contract,
+		bytes const& _cborMetadata,
+		std::map<ContractDefinition const*, std::string_view const> const& _otherYulSources
+	);
+
+	/// Generates and returns the IR code in unoptimized form, without parsing it.
+	std::string runUnoptimized(
+		ContractDefinition const& _contract,
+		bytes const& _cborMetadata,
+		std::map<ContractDefinition const*, std::string_view const> const& _otherYulSources
+	);
+	/// Parses, analyzes and (depending on the optimizer settings) optimizes IR code returned
+	/// by runUnoptimized().
+	std::shared_ptr<yul::AssemblyStack> parseAndOptimize(std::string const& _ir);
+
+	/// @returns the comment prepended to the generated IR code.
+	static std::string irWarning();
+
 private:
 	std::string generate(
 		ContractDefinition const& _contract,
@@ -136,6 +171,9 @@ private:
 
 	langutil::EVMVersion const m_evmVersion;
 	OptimiserSettings const m_optimiserSettings;
+	std::shared_ptr<yul::OptimisedCodeCache> m_optimisedCodeCache;
+	/// Maximum number of threads used to optimise the sub-objects of the generated object.
+	size_t m_parallelism = 1;
 
 	IRGenerationContext m_context;
 	YulUtilFunctions m_utils;
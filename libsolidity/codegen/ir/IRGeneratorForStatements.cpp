@@ -41,6 +41,7 @@
 
 #include <liblangutil/Exceptions.h>
 
+#include <libsolutil/CommonData.h>
 #include <libsolutil/Whiskers.h>
 #include <libsolutil/StringUtils.h>
 #include <libsolutil/Keccak256.h>
@@ -215,6 +216,48 @@ private:
 	ExternalRefsMap const& m_references;
 };
 
+/// @returns true if @a _expression allocates a byte array that is only needed while it is
+/// consumed, because it is the result of an ABI encoding or ``bytes.concat`` and the arguments
+/// do not call any functions or assign to variables, through which memory allocated while
+/// evaluating them could be kept.
+bool isTemporaryAllocation(Expression const& _expression)
+{
+	auto const* functionCall = dynamic_cast<FunctionCall const*>(&_expression);
+	if (!functionCall || *functionCall->annotation().kind != FunctionCallKind::FunctionCall)
+		return false;
+	auto const* functionType = dynamic_cast<FunctionType const*>(functionCall->expression().annotation().type);
+	if (!functionType)
+		return false;
+	switch (functionType->kind())
+	{
+	case FunctionType::Kind::ABIEncode:
+	case FunctionType::Kind::ABIEncodePacked:
+	case FunctionType::Kind::ABIEncodeWithSelector:
+	case FunctionType::Kind::ABIEncodeCall:
+	case FunctionType::Kind::ABIEncodeWithSignature:
+	case FunctionType::Kind::BytesConcat:
+		break;
+	default:
+		return false;
+	}
+
+	bool temporary = true;
+	SimpleASTVisitor visitor(
+		[&](ASTNode const& _node) {
+			if (dynamic_cast<Assignment const*>(&_node))
+				temporary = false;
+			else if (auto const* call = dynamic_cast<FunctionCall const*>(&_node))
+				if (*call->annotation().kind != FunctionCallKind::TypeConversion)
+					temporary = false;
+			return temporary;
+		},
+		[](ASTNode const&) {}
+	);
+	for (ASTPointer<Expression const> const& argument: functionCall->arguments())
+		argument->accept(visitor);
+	return temporary;
+}
+
 }
 
 string IRGeneratorForStatementsBase::code() const
@@ -884,6 +927,27 @@ bool IRGeneratorForStatements::visit(BinaryOperation const& _binOp)
 	return false;
 }
 
+bool IRGeneratorForStatements::visit(FunctionCall const& _functionCall)
+{
+	// The byte array hashed by ``keccak256(abi.encode(...))`` is not used afterwards, so the
+	// free memory pointer is reset once the hash has been computed.
+	if (
+		m_context.optimiserSettings().reclaimTemporaryMemory &&
+		*_functionCall.annotation().kind == FunctionCallKind::FunctionCall &&
+		_functionCall.arguments().size() == 1 &&
+		isTemporaryAllocation(*_functionCall.arguments().front())
+	)
+		if (auto const* functionType = dynamic_cast<FunctionType const*>(_functionCall.expression().annotation().type))
+			if (functionType->kind() == FunctionType::Kind::KECCAK256)
+			{
+				setLocation(_functionCall);
+				string freeMemoryPre = m_context.newYulVariable();
+				appendCode() << "let " << freeMemoryPre << " := " << m_utils.allocateUnboundedFunction() << "()\n";
+				m_temporaryMemoryCheckpoints[&_functionCall] = freeMemoryPre;
+			}
+	return true;
+}
+
 void IRGeneratorForStatements::endVisit(FunctionCall const& _functionCall)
 {
 	setLocation(_functionCall);
@@ -1334,6 +1398,8 @@ void IRGeneratorForStatements::endVisit(FunctionCall const& _functionCall)
 				", " <<
 				(arrayLengthFunction + "(" + array.commaSeparatedList() +")") <<
 				")\n";
+			if (string const* freeMemoryPre = util::valueOrNullptr(m_temporaryMemoryCheckpoints, &_functionCall))
+				appendCode() << m_utils.finalizeAllocationFunction() << "(" << *freeMemoryPre << ", 0)\n";
 		}
 		break;
 	}
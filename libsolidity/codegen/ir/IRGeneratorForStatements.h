@@ -26,6 +26,7 @@
 #include <libsolidity/codegen/ir/IRVariable.h>
 
 #include <functional>
+#include <map>
 
 namespace solidity::frontend
 {
@@ -107,6 +108,7 @@ public:
 	void endVisit(Return const& _return) override;
 	bool visit(UnaryOperation const& _unaryOperation) override;
 	bool visit(BinaryOperation const& _binOp) override;
+	bool visit(FunctionCall const& _funCall) override;
 	void endVisit(FunctionCall const& _funCall) override;
 	void endVisit(FunctionCallOptions const& _funCallOptions) override;
 	bool visit(MemberAccess const& _memberAccess) override;
@@ -225,6 +227,9 @@ private:
 	std::function<std::string()> m_placeholderCallback;
 	YulUtilFunctions& m_utils;
 	std::optional<IRLValue> m_currentLValue;
+	/// The variables holding the free memory pointer before the evaluation of calls to
+	/// ``keccak256`` whose argument is a temporary allocation.
+	std::map<FunctionCall const*, std::string> m_temporaryMemoryCheckpoints;
 };
 
 }
@@ -26,7 +26,7 @@ using namespace solidity::smtutil;
 using namespace solidity::frontend;
 using namespace solidity::frontend::smt;
 
-map<string, ArraySlicePredicate::SliceData> ArraySlicePredicate::m_slicePredicates;
+thread_local map<string, ArraySlicePredicate::SliceData> ArraySlicePredicate::m_slicePredicates;
 
 pair<bool, ArraySlicePredicate::SliceData const&> ArraySlicePredicate::create(SortPointer _sort, EncodingContext& _context)
 {
@@ -48,11 +48,11 @@ pair<bool, ArraySlicePredicate::SliceData const&> ArraySlicePredicate::create(So
 	smt::SymbolicIntVariable iVar{TypeProvider::uint256(), TypeProvider::uint256(), "i_" + tupleName, _context};
 
 	vector<SortPointer> domain{sort, sort, startVar.sort(), endVar.sort()};
-	auto sliceSort = make_shared<FunctionSort>(domain, SortProvider::boolSort);
+	auto sliceSort = SortProvider::functionSort(domain, SortProvider::boolSort);
 	Predicate const& slice = *Predicate::create(sliceSort, "array_slice_" + tupleName, PredicateType::Custom, _context);
 
 	domain.emplace_back(iVar.sort());
-	auto predSort = make_shared<FunctionSort>(domain, SortProvider::boolSort);
+	auto predSort = SortProvider::functionSort(domain, SortProvider::boolSort);
 	Predicate const& header = *Predicate::create(predSort, "array_slice_header_" + tupleName, PredicateType::Custom, _context);
 	Predicate const& loop = *Predicate::create(predSort, "array_slice_loop_" + tupleName, PredicateType::Custom, _context);
 
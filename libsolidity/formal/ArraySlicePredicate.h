@@ -56,7 +56,8 @@ struct ArraySlicePredicate
 
 private:
 	/// Maps a unique sort name to its slice data.
-	static std::map<std::string, SliceData> m_slicePredicates;
+	/// Kept per thread, since contracts can be analysed on different threads.
+	static thread_local std::map<std::string, SliceData> m_slicePredicates;
 };
 
 }
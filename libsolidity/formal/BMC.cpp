@@ -41,10 +41,18 @@ BMC::BMC(
 	map<h256, string> const& _smtlib2Responses,
 	ReadCallback::Callback const& _smtCallback,
 	ModelCheckerSettings const& _settings,
-	CharStreamProvider const& _charStreamProvider
+	CharStreamProvider const& _charStreamProvider,
+	shared_ptr<ArtifactCache> _queryResultCache
 ):
 	SMTEncoder(_context, _settings, _errorReporter, _charStreamProvider),
-	m_interface(make_unique<smtutil::SMTPortfolio>(_smtlib2Responses, _smtCallback, _settings.solvers, _settings.timeout))
+	m_interface(make_unique<smtutil::SMTPortfolio>(
+		_smtlib2Responses,
+		_smtCallback,
+		_settings.solvers,
+		_settings.timeout,
+		_settings.smtlib2Command,
+		move(_queryResultCache)
+	))
 {
 #if defined (HAVE_Z3) || defined (HAVE_CVC4)
 	if (m_settings.solvers.cvc4 || m_settings.solvers.z3)
@@ -88,17 +96,8 @@ void BMC::analyze(SourceUnit const& _source, map<ASTNode const*, set<Verificatio
 
 	_source.accept(*this);
 
-	if (m_unprovedAmt > 0 && !m_settings.showUnproved)
-		m_errorReporter.warning(
-			2788_error,
-			{},
-			"BMC: " +
-			to_string(m_unprovedAmt) +
-			" verification condition(s) could not be proved." +
-			" Enable the model checker option \"show unproved\" to see all of them." +
-			" Consider choosing a specific contract to be verified in order to reduce the solving problems." +
-			" Consider increasing the timeout per query."
-		);
+	if (m_unprovedAmt > 0 && !m_settings.showUnproved && m_reportUnprovedSummary)
+		reportUnprovedSummary(m_errorReporter, m_unprovedAmt);
 
 	// If this check is true, Z3 and CVC4 are not available
 	// and the query answers were not provided, since SMTPortfolio
@@ -125,6 +124,20 @@ void BMC::analyze(SourceUnit const& _source, map<ASTNode const*, set<Verificatio
 	}
 }
 
+void BMC::reportUnprovedSummary(UniqueErrorReporter& _errorReporter, size_t _unprovedAmount)
+{
+	_errorReporter.warning(
+		2788_error,
+		{},
+		"BMC: " +
+		to_string(_unprovedAmount) +
+		" verification condition(s) could not be proved." +
+		" Enable the model checker option \"show unproved\" to see all of them." +
+		" Consider choosing a specific contract to be verified in order to reduce the solving problems." +
+		" Consider increasing the timeout per query."
+	);
+}
+
 bool BMC::shouldInlineFunctionCall(
 	FunctionCall const& _funCall,
 	ContractDefinition const* _scopeContract,
@@ -666,6 +679,9 @@ pair<vector<smtutil::Expression>, vector<string>> BMC::modelExpressions()
 {
 	vector<smtutil::Expression> expressionsToEvaluate;
 	vector<string> expressionNames;
+	// Without counterexamples the solver is not asked for any values.
+	if (!m_settings.showCounterexamples)
+		return {expressionsToEvaluate, expressionNames};
 	for (auto const& var: m_context.variables())
 		if (var.first->type()->isValueType())
 		{
@@ -703,8 +719,31 @@ pair<vector<smtutil::Expression>, vector<string>> BMC::modelExpressions()
 
 void BMC::checkVerificationTargets()
 {
-	for (auto& target: m_verificationTargets)
+	// Targets are checked in the order they were encountered, so consecutive
+	// targets share most of their encoding.
+	for (size_t i = 0; i < m_verificationTargets.size(); ++i)
+	{
+		auto& target = m_verificationTargets[i];
+		if (!m_timeBudget)
+		{
+			checkVerificationTarget(target);
+			continue;
+		}
+
+		m_pendingTargets = m_verificationTargets.size() - i;
+		auto start = chrono::steady_clock::now();
 		checkVerificationTarget(target);
+		recordTargetTime(
+			target.expression,
+			target.type,
+			chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start)
+		);
+	}
+	m_pendingTargets = 1;
+	if (m_timeBudget)
+		reportTargetTimes("BMC");
+	// The encoding continues with the solver at the base push level.
+	clearEncoding();
 }
 
 void BMC::checkVerificationTarget(BMCVerificationTarget& _target)
@@ -740,6 +779,7 @@ void BMC::checkVerificationTarget(BMCVerificationTarget& _target)
 
 void BMC::checkConstantCondition(BMCVerificationTarget& _target)
 {
+	// Constant conditions are checked while encoding, so their constraints include the encoding.
 	checkBooleanNotConstant(
 		*_target.expression,
 		_target.constraints,
@@ -770,6 +810,7 @@ void BMC::checkUnderflow(BMCVerificationTarget& _target)
 
 	checkCondition(
 		_target.constraints && _target.value < smt::minValue(*intType),
+		_target.assertions,
 		_target.callStack,
 		_target.modelExpressions,
 		_target.expression->location(),
@@ -803,6 +844,7 @@ void BMC::checkOverflow(BMCVerificationTarget& _target)
 
 	checkCondition(
 		_target.constraints && _target.value > smt::maxValue(*intType),
+		_target.assertions,
 		_target.callStack,
 		_target.modelExpressions,
 		_target.expression->location(),
@@ -826,6 +868,7 @@ void BMC::checkDivByZero(BMCVerificationTarget& _target)
 
 	checkCondition(
 		_target.constraints && (_target.value == 0),
+		_target.assertions,
 		_target.callStack,
 		_target.modelExpressions,
 		_target.expression->location(),
@@ -842,6 +885,7 @@ void BMC::checkBalance(BMCVerificationTarget& _target)
 	solAssert(_target.type == VerificationTargetType::Balance, "");
 	checkCondition(
 		_target.constraints && _target.value,
+		_target.assertions,
 		_target.callStack,
 		_target.modelExpressions,
 		_target.expression->location(),
@@ -864,6 +908,7 @@ void BMC::checkAssert(BMCVerificationTarget& _target)
 
 	checkCondition(
 		_target.constraints && !_target.value,
+		_target.assertions,
 		_target.callStack,
 		_target.modelExpressions,
 		_target.expression->location(),
@@ -886,22 +931,32 @@ void BMC::addVerificationTarget(
 		{
 			_type,
 			_value,
-			currentPathConditions() && m_context.assertions()
+			currentPathConditions()
 		},
 		_expression,
 		m_callStack,
-		modelExpressions()
+		modelExpressions(),
+		{}
 	};
 	if (_type == VerificationTargetType::ConstantCondition)
+	{
+		target.constraints = target.constraints && m_context.assertions();
 		checkVerificationTarget(target);
+	}
 	else
+	{
+		// The other targets are checked together at the end of the function,
+		// where checkCondition() gives the solver the assertions of each one.
+		target.assertions = m_context.assertionList();
 		m_verificationTargets.emplace_back(move(target));
+	}
 }
 
 /// Solving.
 
 void BMC::checkCondition(
 	smtutil::Expression _condition,
+	vector<shared_ptr<smtutil::Expression const>> const& _assertions,
 	vector<SMTEncoder::CallStackEntry> const& _callStack,
 	pair<vector<smtutil::Expression>, vector<string>> const& _modelExpressions,
 	SourceLocation const& _location,
@@ -912,13 +967,14 @@ void BMC::checkCondition(
 	smtutil::Expression const* _additionalValue
 )
 {
+	assertEncoding(_assertions);
 	m_interface->push();
 	m_interface->addAssertion(_condition);
 
 	vector<smtutil::Expression> expressionsToEvaluate;
 	vector<string> expressionNames;
 	tie(expressionsToEvaluate, expressionNames) = _modelExpressions;
-	if (_callStack.size())
+	if (_callStack.size() && m_settings.showCounterexamples)
 		if (_additionalValue)
 		{
 			expressionsToEvaluate.emplace_back(*_additionalValue);
@@ -953,7 +1009,7 @@ void BMC::checkCondition(
 
 		std::ostringstream modelMessage;
 		// Sometimes models have complex smtlib2 expressions that SMTLib2Interface fails to parse.
-		if (values.size() == expressionNames.size())
+		if (m_settings.showCounterexamples && values.size() == expressionNames.size())
 		{
 			modelMessage << "Counterexample:\n";
 			map<string, string> sortedModel;
@@ -965,11 +1021,14 @@ void BMC::checkCondition(
 				modelMessage << "  " << eval.first << " = " << eval.second << "\n";
 		}
 
+		SecondarySourceLocation details;
+		if (m_settings.showCounterexamples)
+			details.append(modelMessage.str(), SourceLocation{});
 		m_errorReporter.warning(
 			_errorHappens,
 			_location,
 			message.str(),
-			SecondarySourceLocation().append(modelMessage.str(), SourceLocation{})
+			details
 			.append(SMTEncoder::callStackMessage(_callStack))
 			.append(move(secondaryLocation))
 		);
@@ -1058,9 +1117,18 @@ BMC::checkSatisfiableAndGenerateModel(vector<smtutil::Expression> const& _expres
 {
 	smtutil::CheckResult result;
 	vector<string> values;
+	if (m_timeBudget)
+	{
+		unsigned timeout = m_timeBudget->queryTimeout(m_pendingTargets, m_settings.timeout);
+		// Once the budget is exhausted, the remaining targets are unproved without asking the solvers.
+		if (timeout == 0)
+			return {smtutil::CheckResult::UNKNOWN, {}};
+		m_interface->setQueryTimeout(timeout);
+	}
+
 	try
 	{
-		tie(result, values) = m_interface->check(_expressionsToEvaluate);
+		tie(result, values) = queryWithoutAnalysisLock([&]() { return m_interface->check(_expressionsToEvaluate); });
 	}
 	catch (smtutil::SolverError const& _e)
 	{
@@ -1089,6 +1157,42 @@ smtutil::CheckResult BMC::checkSatisfiable()
 	return checkSatisfiableAndGenerateModel({}).first;
 }
 
+void BMC::assertEncoding(vector<shared_ptr<smtutil::Expression const>> const& _assertions)
+{
+	size_t common = 0;
+	while (
+		common < min(m_solverAssertions.size(), _assertions.size()) &&
+		m_solverAssertions[common] == _assertions[common]
+	)
+		++common;
+
+	while (!m_solverAssertionLevels.empty() && m_solverAssertionLevels.back() > common)
+	{
+		m_interface->pop();
+		m_solverAssertionLevels.pop_back();
+	}
+	m_solverAssertions.resize(m_solverAssertionLevels.empty() ? 0 : m_solverAssertionLevels.back());
+
+	if (m_solverAssertions.size() == _assertions.size())
+		return;
+
+	m_interface->push();
+	for (size_t i = m_solverAssertions.size(); i < _assertions.size(); ++i)
+	{
+		m_interface->addAssertion(*_assertions[i]);
+		m_solverAssertions.push_back(_assertions[i]);
+	}
+	m_solverAssertionLevels.push_back(m_solverAssertions.size());
+}
+
+void BMC::clearEncoding()
+{
+	for (size_t i = 0; i < m_solverAssertionLevels.size(); ++i)
+		m_interface->pop();
+	m_solverAssertionLevels.clear();
+	m_solverAssertions.clear();
+}
+
 void BMC::assignment(smt::SymbolicVariable& _symVar, smtutil::Expression const& _value)
 {
 	auto oldVar = _symVar.currentValue();
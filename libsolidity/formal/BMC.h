@@ -33,6 +33,7 @@
 #include <libsolidity/formal/ModelCheckerSettings.h>
 #include <libsolidity/formal/SMTEncoder.h>
 
+#include <libsolidity/interface/ArtifactCache.h>
 #include <libsolidity/interface/ReadFile.h>
 
 #include <libsmtutil/SolverInterface.h>
@@ -63,7 +64,8 @@ public:
 		std::map<h256, std::string> const& _smtlib2Responses,
 		ReadCallback::Callback const& _smtCallback,
 		ModelCheckerSettings const& _settings,
-		langutil::CharStreamProvider const& _charStreamProvider
+		langutil::CharStreamProvider const& _charStreamProvider,
+		std::shared_ptr<ArtifactCache> _queryResultCache = {}
 	);
 
 	void analyze(SourceUnit const& _sources, std::map<ASTNode const*, std::set<VerificationTargetType>, smt::EncodingContext::IdCompare> _solvedTargets);
@@ -73,6 +75,11 @@ public:
 	/// the constructor.
 	std::vector<std::string> unhandledQueries() { return m_interface->unhandledQueries(); }
 
+	/// @returns the number of verification conditions of the last analysed source unit that could not be proved.
+	size_t unprovedAmount() const { return m_unprovedAmt; }
+	/// Reports that @a _unprovedAmount verification conditions could not be proved.
+	static void reportUnprovedSummary(langutil::UniqueErrorReporter& _errorReporter, size_t _unprovedAmount);
+
 	/// @returns true if _funCall should be inlined, otherwise false.
 	/// @param _scopeContract The contract that contains the current function being analyzed.
 	/// @param _contextContract The most derived contract, currently being analyzed.
@@ -135,6 +142,9 @@ private:
 		Expression const* expression;
 		std::vector<CallStackEntry> callStack;
 		std::pair<std::vector<smtutil::Expression>, std::vector<std::string>> modelExpressions;
+		/// The assertions of the encoding at the target, which are not part of `constraints`
+		/// unless the target is checked right away.
+		std::vector<std::shared_ptr<smtutil::Expression const>> assertions;
 	};
 
 	void checkVerificationTargets();
@@ -154,9 +164,10 @@ private:
 
 	/// Solver related.
 	//@{
-	/// Check that a condition can be satisfied.
+	/// Check that a condition can be satisfied under @a _assertions.
 	void checkCondition(
 		smtutil::Expression _condition,
+		std::vector<std::shared_ptr<smtutil::Expression const>> const& _assertions,
 		std::vector<CallStackEntry> const& _callStack,
 		std::pair<std::vector<smtutil::Expression>, std::vector<std::string>> const& _modelExpressions,
 		langutil::SourceLocation const& _location,
@@ -178,6 +189,13 @@ private:
 	checkSatisfiableAndGenerateModel(std::vector<smtutil::Expression> const& _expressionsToEvaluate);
 
 	smtutil::CheckResult checkSatisfiable();
+
+	/// Makes the solver assert exactly @a _assertions below the push level of the next query.
+	/// The push levels for the longest common prefix with the assertions of the previous target are kept,
+	/// so the encoding shared by consecutive targets is only given to the solver once.
+	void assertEncoding(std::vector<std::shared_ptr<smtutil::Expression const>> const& _assertions);
+	/// Pops all the push levels of assertEncoding().
+	void clearEncoding();
 	//@}
 
 	std::unique_ptr<smtutil::SolverInterface> m_interface;
@@ -188,9 +206,18 @@ private:
 
 	std::vector<BMCVerificationTarget> m_verificationTargets;
 
+	/// The assertions that assertEncoding() gave to the solver, in order.
+	std::vector<std::shared_ptr<smtutil::Expression const>> m_solverAssertions;
+	/// The size of m_solverAssertions at the end of each push level of assertEncoding().
+	std::vector<size_t> m_solverAssertionLevels;
+
 	/// Targets that were already proven.
 	std::map<ASTNode const*, std::set<VerificationTargetType>, smt::EncodingContext::IdCompare> m_solvedTargets;
 
+	/// The number of targets that are left to check, including the current one,
+	/// which share the time that is left in the time budget.
+	size_t m_pendingTargets = 1;
+
 	/// Number of verification conditions that could not be proved.
 	size_t m_unprovedAmt = 0;
 };
@@ -33,6 +33,7 @@
 #include <libsmtutil/CHCSmtLib2Interface.h>
 #include <liblangutil/CharStreamProvider.h>
 #include <libsolutil/Algorithms.h>
+#include <libsolutil/ThreadPool.h>
 
 #ifdef HAVE_Z3_DLOPEN
 #include <z3_version.h>
@@ -45,7 +46,10 @@
 #include <range/v3/view/enumerate.hpp>
 #include <range/v3/view/reverse.hpp>
 
+#include <atomic>
 #include <charconv>
+#include <chrono>
+#include <functional>
 #include <queue>
 
 using namespace std;
@@ -62,9 +66,11 @@ CHC::CHC(
 	[[maybe_unused]] map<util::h256, string> const& _smtlib2Responses,
 	[[maybe_unused]] ReadCallback::Callback const& _smtCallback,
 	ModelCheckerSettings const& _settings,
-	CharStreamProvider const& _charStreamProvider
+	CharStreamProvider const& _charStreamProvider,
+	size_t _parallelism
 ):
-	SMTEncoder(_context, _settings, _errorReporter, _charStreamProvider)
+	SMTEncoder(_context, _settings, _errorReporter, _charStreamProvider),
+	m_parallelism(max<size_t>(_parallelism, 1))
 {
 	bool usesZ3 = m_settings.solvers.z3;
 #ifdef HAVE_Z3
@@ -73,7 +79,12 @@ CHC::CHC(
 	usesZ3 = false;
 #endif
 	if (!usesZ3 && m_settings.solvers.smtlib2)
-		m_interface = make_unique<CHCSmtLib2Interface>(_smtlib2Responses, _smtCallback, m_settings.timeout);
+		m_interface = make_unique<CHCSmtLib2Interface>(
+			_smtlib2Responses,
+			_smtCallback,
+			m_settings.timeout,
+			m_settings.smtlib2Command
+		);
 }
 
 void CHC::analyze(SourceUnit const& _source)
@@ -109,6 +120,11 @@ void CHC::analyze(SourceUnit const& _source)
 
 	checkVerificationTargets();
 
+	for (auto const* source: sources)
+		for (auto const* contract: ASTNode::filteredNodes<ContractDefinition>(source->nodes()))
+			if (shouldAnalyze(*contract))
+				m_analyzedContracts.insert(contract);
+
 	bool ranSolver = true;
 	// If ranSolver is true here it's because an SMT solver callback was
 	// actually given and the queries were solved.
@@ -138,9 +154,23 @@ vector<string> CHC::unhandledQueries() const
 	return {};
 }
 
+void CHC::reportUnprovedSummary(UniqueErrorReporter& _errorReporter, size_t _unprovedAmount)
+{
+	_errorReporter.warning(
+		5840_error,
+		{},
+		"CHC: " +
+		to_string(_unprovedAmount) +
+		" verification condition(s) could not be proved." +
+		" Enable the model checker option \"show unproved\" to see all of them." +
+		" Consider choosing a specific contract to be verified in order to reduce the solving problems." +
+		" Consider increasing the timeout per query."
+	);
+}
+
 bool CHC::visit(ContractDefinition const& _contract)
 {
-	if (!shouldAnalyze(_contract))
+	if (!shouldEncode(_contract))
 		return false;
 
 	resetContractAnalysis();
@@ -158,7 +188,7 @@ bool CHC::visit(ContractDefinition const& _contract)
 
 void CHC::endVisit(ContractDefinition const& _contract)
 {
-	if (!shouldAnalyze(_contract))
+	if (!shouldEncode(_contract))
 		return;
 
 	for (auto base: _contract.annotation().linearizedBaseContracts)
@@ -235,6 +265,7 @@ void CHC::endVisit(ContractDefinition const& _contract)
 			txConstraints = txConstraints && state().txNonPayableConstraint();
 		m_queryPlaceholders[&_contract].push_back({txConstraints, errorFlag().currentValue(), m_currentBlock});
 		connectBlocks(m_currentBlock, interface(), txConstraints && errorFlag().currentValue() == 0);
+		collectInvariantCandidates(_contract);
 	}
 
 	solAssert(m_scopes.back() == &_contract, "");
@@ -986,6 +1017,7 @@ void CHC::resetSourceAnalysis()
 	m_functionTargetIds.clear();
 	m_verificationTargets.clear();
 	m_queryPlaceholders.clear();
+	m_invariantCandidates.clear();
 	m_callGraph.clear();
 	m_summaries.clear();
 	m_externalSummaries.clear();
@@ -1032,6 +1064,11 @@ void CHC::resetContractAnalysis()
 	errorFlag().resetIndex();
 }
 
+bool CHC::shouldEncode(ContractDefinition const& _contract) const
+{
+	return shouldAnalyze(_contract) && !m_analyzedContracts.count(&_contract);
+}
+
 void CHC::eraseKnowledge()
 {
 	resetStorageVariables();
@@ -1540,28 +1577,37 @@ void CHC::addRule(smtutil::Expression const& _rule, string const& _ruleName)
 }
 
 tuple<CheckResult, smtutil::Expression, CHCSolverInterface::CexGraph> CHC::query(smtutil::Expression const& _query, langutil::SourceLocation const& _location)
+{
+	auto result = querySolver(*m_interface, _query);
+	reportQueryResult(get<CheckResult>(result), _location);
+	return result;
+}
+
+tuple<CheckResult, smtutil::Expression, CHCSolverInterface::CexGraph> CHC::querySolver(
+	CHCSolverInterface& _solver,
+	smtutil::Expression const& _query
+) const
 {
 	CheckResult result;
 	smtutil::Expression invariant(true);
 	CHCSolverInterface::CexGraph cex;
-	tie(result, invariant, cex) = m_interface->query(_query);
-	switch (result)
-	{
-	case CheckResult::SATISFIABLE:
+	tie(result, invariant, cex) = queryWithoutAnalysisLock([&]() { return _solver.query(_query); });
+	if (result == CheckResult::SATISFIABLE)
 	{
 #ifdef HAVE_Z3
-		if (m_settings.solvers.z3)
+		// The second query is only needed for the counterexample.
+		if (m_settings.showCounterexamples && m_settings.solvers.z3)
 		{
 			// Even though the problem is SAT, Spacer's pre processing makes counterexamples incomplete.
 			// We now disable those optimizations and check whether we can still solve the problem.
-			auto* spacer = dynamic_cast<Z3CHCInterface*>(m_interface.get());
+			auto* spacer = dynamic_cast<Z3CHCInterface*>(&_solver);
 			solAssert(spacer, "");
 			spacer->setSpacerOptions(false);
 
 			CheckResult resultNoOpt;
 			smtutil::Expression invariantNoOpt(true);
 			CHCSolverInterface::CexGraph cexNoOpt;
-			tie(resultNoOpt, invariantNoOpt, cexNoOpt) = m_interface->query(_query);
+			tie(resultNoOpt, invariantNoOpt, cexNoOpt) = queryWithoutAnalysisLock([&]() { return _solver.query(_query); });
 
 			if (resultNoOpt == CheckResult::SATISFIABLE)
 				cex = move(cexNoOpt);
@@ -1569,10 +1615,16 @@ tuple<CheckResult, smtutil::Expression, CHCSolverInterface::CexGraph> CHC::query
 			spacer->setSpacerOptions(true);
 		}
 #endif
-		break;
 	}
+	return {result, invariant, cex};
+}
+
+void CHC::reportQueryResult(CheckResult _result, langutil::SourceLocation const& _location)
+{
+	switch (_result)
+	{
+	case CheckResult::SATISFIABLE:
 	case CheckResult::UNSATISFIABLE:
-		break;
 	case CheckResult::UNKNOWN:
 		break;
 	case CheckResult::CONFLICTING:
@@ -1582,7 +1634,6 @@ tuple<CheckResult, smtutil::Expression, CHCSolverInterface::CexGraph> CHC::query
 		m_errorReporter.warning(1218_error, _location, "CHC: Error trying to invoke SMT solver.");
 		break;
 	}
-	return {result, invariant, cex};
 }
 
 void CHC::verificationTargetEncountered(
@@ -1639,7 +1690,11 @@ void CHC::checkVerificationTargets()
 				targetEntryPoints[id].push_back(placeholder);
 	}
 
+	// The lemmas of the proved candidates are then available to every target query.
+	checkInvariantCandidates();
+
 	set<unsigned> checkedErrorIds;
+	vector<CHCTargetCheck> checks;
 	for (auto const& [targetId, placeholders]: targetEntryPoints)
 	{
 		string errorType;
@@ -1694,10 +1749,28 @@ void CHC::checkVerificationTargets()
 		else
 			solAssert(false, "");
 
-		checkAndReportTarget(target, placeholders, errorReporterId, errorType + " happens here.", errorType + " might happen here.");
+		checks.push_back({&target, &placeholders, errorReporterId, errorType + " happens here.", errorType + " might happen here."});
 		checkedErrorIds.insert(target.errorId);
 	}
 
+	// The Horn system can be checked in parallel if it can be cloned or if every query starts its own solver process.
+	bool checkInParallel = false;
+#ifdef HAVE_Z3
+	checkInParallel = dynamic_cast<Z3CHCInterface const*>(m_interface.get());
+#endif
+	if (auto const* smtlib2 = dynamic_cast<CHCSmtLib2Interface const*>(m_interface.get()))
+		checkInParallel = smtlib2->hasSolverCommand();
+	checkInParallel = checkInParallel && m_parallelism > 1 && checks.size() > 1;
+	if (checkInParallel)
+		checkAndReportTargetsInParallel(checks);
+	else
+		checkAndReportTargets(checks, m_settings.timeout);
+	if (m_timeBudget)
+	{
+		retryUnprovedTargets(checks);
+		reportTargetTimes("CHC");
+	}
+
 	auto toReport = m_unsafeTargets;
 	if (m_settings.showUnproved)
 		for (auto const& [node, targets]: m_unprovedTargets)
@@ -1712,17 +1785,8 @@ void CHC::checkVerificationTargets()
 				info.message
 			);
 
-	if (!m_settings.showUnproved && !m_unprovedTargets.empty())
-		m_errorReporter.warning(
-			5840_error,
-			{},
-			"CHC: " +
-			to_string(m_unprovedTargets.size()) +
-			" verification condition(s) could not be proved." +
-			" Enable the model checker option \"show unproved\" to see all of them." +
-			" Consider choosing a specific contract to be verified in order to reduce the solving problems." +
-			" Consider increasing the timeout per query."
-		);
+	if (!m_settings.showUnproved && !m_unprovedTargets.empty() && m_reportUnprovedSummary)
+		reportUnprovedSummary(m_errorReporter, m_unprovedTargets.size());
 
 	if (!m_settings.invariants.invariants.empty())
 	{
@@ -1785,6 +1849,55 @@ void CHC::checkVerificationTargets()
 		m_safeTargets[m_verificationTargets.at(id).errorNode].insert(m_verificationTargets.at(id).type);
 }
 
+void CHC::collectInvariantCandidates(ContractDefinition const& _contract)
+{
+	auto const& candidates = m_settings.invariantCandidates;
+	if (
+		!candidates.count(_contract.sourceUnitName()) ||
+		!candidates.at(_contract.sourceUnitName()).count(_contract.name())
+	)
+		return;
+
+	// The signature of an interface predicate is
+	// interface(this, abiFunctions, cryptoFunctions, blockchainState, stateVariables).
+	smtutil::Expression iface = interface();
+	auto const& stateVars = stateVariablesIncludingInheritedAndPrivate(_contract);
+	solAssert(iface.arguments.size() == stateVars.size() + 4, "");
+	map<string, smtutil::Expression> variables{{"address(this)", iface.arguments.at(0)}};
+	for (size_t i = 0; i < stateVars.size(); ++i)
+		variables.emplace(stateVars.at(i)->name(), iface.arguments.at(i + 4));
+
+	for (auto const& invariant: candidates.at(_contract.sourceUnitName()).at(_contract.name()))
+		if (auto formula = parseInvariant(invariant, variables))
+			m_invariantCandidates.push_back({invariant, iface, *formula});
+		else
+			m_errorReporter.warning(
+				4721_error,
+				SourceLocation(),
+				"CHC: The invariant candidate \"" + invariant + "\" for " + _contract.fullyQualifiedName() +
+				" is ignored. Only formulas over the Boolean and integer state variables of the contract are supported."
+			);
+}
+
+void CHC::checkInvariantCandidates()
+{
+#ifdef HAVE_Z3
+	// Only Spacer takes lemmas, so proving the candidates is pointless for the other solvers.
+	if (!dynamic_cast<Z3CHCInterface const*>(m_interface.get()))
+		return;
+
+	for (auto const& candidate: m_invariantCandidates)
+	{
+		createErrorBlock();
+		connectBlocks(candidate.interface, error(), !candidate.formula);
+		auto result = queryWithoutAnalysisLock([&]() { return m_interface->query(error()); });
+		// A candidate that cannot be proved is just not used.
+		if (get<CheckResult>(result) == CheckResult::UNSATISFIABLE)
+			m_interface->addInvariant(candidate.interface, candidate.formula);
+	}
+#endif
+}
+
 void CHC::checkAndReportTarget(
 	CHCVerificationTarget const& _target,
 	vector<CHCQueryPlaceholder> const& _placeholders,
@@ -1793,9 +1906,160 @@ void CHC::checkAndReportTarget(
 	string _unknownMsg
 )
 {
-	if (m_unsafeTargets.count(_target.errorNode) && m_unsafeTargets.at(_target.errorNode).count(_target.type))
+	if (alreadyUnsafe(_target))
+		return;
+
+	smtutil::Expression errorQuery = encodeTargetQuery(_target, _placeholders);
+	auto result = query(errorQuery, _target.errorNode->location());
+	reportTarget(_target, errorQuery, _errorReporterId, _satMsg, _unknownMsg, result);
+}
+
+void CHC::checkAndReportTargets(vector<CHCTargetCheck> const& _checks, optional<unsigned> _queryTimeout)
+{
+	for (size_t i = 0; i < _checks.size(); ++i)
+	{
+		CHCTargetCheck const& check = _checks[i];
+		if (!m_timeBudget)
+		{
+			checkAndReportTarget(*check.target, *check.placeholders, check.errorReporterId, check.satMsg, check.unknownMsg);
+			continue;
+		}
+
+		if (alreadyUnsafe(*check.target))
+			continue;
+		unsigned timeout = m_timeBudget->queryTimeout(_checks.size() - i, _queryTimeout);
+		if (timeout == 0)
+		{
+			// The budget is exhausted, so the target is unproved without asking the solver.
+			reportTarget(*check.target, error(), check.errorReporterId, check.satMsg, check.unknownMsg, {CheckResult::UNKNOWN, smtutil::Expression(true), {}});
+			continue;
+		}
+		m_interface->setQueryTimeout(timeout);
+		auto start = chrono::steady_clock::now();
+		checkAndReportTarget(*check.target, *check.placeholders, check.errorReporterId, check.satMsg, check.unknownMsg);
+		recordTargetTime(
+			check.target->errorNode,
+			check.target->type,
+			chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start)
+		);
+	}
+}
+
+void CHC::retryUnprovedTargets(vector<CHCTargetCheck> const& _checks)
+{
+	solAssert(m_timeBudget, "");
+	if (m_timeBudget->exhausted())
 		return;
 
+	vector<CHCTargetCheck> retries;
+	for (CHCTargetCheck const& check: _checks)
+	{
+		auto unproved = m_unprovedTargets.find(check.target->errorNode);
+		if (unproved == m_unprovedTargets.end() || !unproved->second.erase(check.target->type))
+			continue;
+		if (unproved->second.empty())
+			m_unprovedTargets.erase(unproved);
+		retries.push_back(check);
+	}
+	// The time that is left is split among the retries only, which can take longer than the timeout per query.
+	checkAndReportTargets(retries, nullopt);
+}
+
+void CHC::checkAndReportTargetsInParallel(vector<CHCTargetCheck> const& _checks)
+{
+	// All targets are encoded before they are checked, so that every thread can check all of them.
+	vector<smtutil::Expression> queries;
+	for (CHCTargetCheck const& check: _checks)
+		queries.emplace_back(encodeTargetQuery(*check.target, *check.placeholders));
+	size_t threads = min(m_parallelism, queries.size());
+
+	// @returns the result of query @a i on the solver of thread @a t, given at most @a timeout milliseconds.
+	std::function<tuple<CheckResult, smtutil::Expression, CHCSolverInterface::CexGraph>(size_t, size_t, optional<unsigned>)> runQuery;
+	vector<string> inputs;
+#ifdef HAVE_Z3
+	vector<unique_ptr<Z3CHCInterface>> clones;
+#endif
+	if (auto* smtlib2 = dynamic_cast<CHCSmtLib2Interface*>(m_interface.get()))
+	{
+		// Every query is a complete Horn system for a new solver process, possibly on another machine.
+		solAssert(smtlib2->hasSolverCommand(), "");
+		for (smtutil::Expression const& query: queries)
+			inputs.emplace_back(smtlib2->queryInput(query));
+		runQuery = [&, smtlib2](size_t, size_t i, optional<unsigned> timeout) {
+			return smtlib2->queryWithSolverCommand(inputs[i], timeout ? timeout : m_settings.timeout);
+		};
+	}
+	else
+	{
+#ifdef HAVE_Z3
+		auto const* solver = dynamic_cast<Z3CHCInterface const*>(m_interface.get());
+		solAssert(solver, "");
+		// Clones are created on this thread, since creating a Z3 solver sets global parameters.
+		for (size_t t = 0; t < threads; ++t)
+			clones.emplace_back(solver->clone());
+		runQuery = [&](size_t t, size_t i, optional<unsigned> timeout) {
+			if (timeout)
+				clones[t]->setQueryTimeout(*timeout);
+			return querySolver(*clones[t], queries[i]);
+		};
+#else
+		solAssert(false, "");
+#endif
+	}
+
+	vector<tuple<CheckResult, smtutil::Expression, CHCSolverInterface::CexGraph>> results(
+		queries.size(),
+		{CheckResult::ERROR, smtutil::Expression(true), {}}
+	);
+	vector<chrono::milliseconds> times(queries.size(), chrono::milliseconds(0));
+	atomic<size_t> nextQuery{0};
+	// Every solver instance is used by one thread only, so the threads take the queries from a
+	// common counter instead of every query being a task of its own.
+	util::parallelFor(threads, threads, [&](size_t _thread) {
+		for (size_t i = nextQuery++; i < queries.size(); i = nextQuery++)
+		{
+			optional<unsigned> timeout;
+			if (m_timeBudget)
+			{
+				// The threads check the pending queries at the same time, so each of them gets its share of the time.
+				size_t pending = (queries.size() - i + threads - 1) / threads;
+				timeout = m_timeBudget->queryTimeout(pending, m_settings.timeout);
+				if (*timeout == 0)
+				{
+					results[i] = {CheckResult::UNKNOWN, smtutil::Expression(true), {}};
+					continue;
+				}
+			}
+			auto start = chrono::steady_clock::now();
+			results[i] = runQuery(_thread, i, timeout);
+			times[i] = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start);
+		}
+	});
+
+	// Report in the order of the targets, skipping the ones that an earlier target
+	// already showed to be unsafe, like the sequential check does.
+	for (size_t i = 0; i < _checks.size(); ++i)
+	{
+		CHCTargetCheck const& check = _checks[i];
+		if (alreadyUnsafe(*check.target))
+			continue;
+		reportQueryResult(get<CheckResult>(results[i]), check.target->errorNode->location());
+		if (m_timeBudget)
+			recordTargetTime(check.target->errorNode, check.target->type, times[i]);
+		reportTarget(*check.target, queries[i], check.errorReporterId, check.satMsg, check.unknownMsg, results[i]);
+	}
+}
+
+bool CHC::alreadyUnsafe(CHCVerificationTarget const& _target) const
+{
+	return m_unsafeTargets.count(_target.errorNode) && m_unsafeTargets.at(_target.errorNode).count(_target.type);
+}
+
+smtutil::Expression CHC::encodeTargetQuery(
+	CHCVerificationTarget const& _target,
+	vector<CHCQueryPlaceholder> const& _placeholders
+)
+{
 	createErrorBlock();
 	for (auto const& placeholder: _placeholders)
 		connectBlocks(
@@ -1803,8 +2067,20 @@ void CHC::checkAndReportTarget(
 			error(),
 			placeholder.constraints && placeholder.errorExpression == _target.errorId
 		);
+	return error();
+}
+
+void CHC::reportTarget(
+	CHCVerificationTarget const& _target,
+	smtutil::Expression const& _query,
+	ErrorId _errorReporterId,
+	string const& _satMsg,
+	string const& _unknownMsg,
+	tuple<CheckResult, smtutil::Expression, CHCSolverInterface::CexGraph> const& _result
+)
+{
+	auto const& [result, invariant, model] = _result;
 	auto const& location = _target.errorNode->location();
-	auto [result, invariant, model] = query(error(), location);
 	if (result == CheckResult::UNSATISFIABLE)
 	{
 		m_safeTargets[_target.errorNode].insert(_target.type);
@@ -1820,7 +2096,9 @@ void CHC::checkAndReportTarget(
 	else if (result == CheckResult::SATISFIABLE)
 	{
 		solAssert(!_satMsg.empty(), "");
-		auto cex = generateCounterexample(model, error().name);
+		optional<string> cex;
+		if (m_settings.showCounterexamples)
+			cex = generateCounterexample(model, _query.name);
 		if (cex)
 			m_unsafeTargets[_target.errorNode][_target.type] = {
 				_errorReporterId,
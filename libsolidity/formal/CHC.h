@@ -60,7 +60,8 @@ public:
 		std::map<util::h256, std::string> const& _smtlib2Responses,
 		ReadCallback::Callback const& _smtCallback,
 		ModelCheckerSettings const& _settings,
-		langutil::CharStreamProvider const& _charStreamProvider
+		langutil::CharStreamProvider const& _charStreamProvider,
+		size_t _parallelism = 1
 	);
 
 	void analyze(SourceUnit const& _sources);
@@ -73,12 +74,16 @@ public:
 	};
 	std::map<ASTNode const*, std::set<VerificationTargetType>, smt::EncodingContext::IdCompare> const& safeTargets() const { return m_safeTargets; }
 	std::map<ASTNode const*, std::map<VerificationTargetType, ReportTargetInfo>, smt::EncodingContext::IdCompare> const& unsafeTargets() const { return m_unsafeTargets; }
+	std::map<ASTNode const*, std::map<VerificationTargetType, ReportTargetInfo>, smt::EncodingContext::IdCompare> const& unprovedTargets() const { return m_unprovedTargets; }
 
 	/// This is used if the Horn solver is not directly linked into this binary.
 	/// @returns a list of inputs to the Horn solver that were not part of the argument to
 	/// the constructor.
 	std::vector<std::string> unhandledQueries() const;
 
+	/// Reports that @a _unprovedAmount verification conditions could not be proved.
+	static void reportUnprovedSummary(langutil::UniqueErrorReporter& _errorReporter, size_t _unprovedAmount);
+
 	enum class CHCNatspecOption
 	{
 		AbstractFunctionNondet
@@ -131,6 +136,10 @@ private:
 	//@{
 	void resetSourceAnalysis();
 	void resetContractAnalysis();
+	/// @returns true if @a _contract has to be analysed and was not analysed for an earlier source unit.
+	/// Contracts are visited with every source unit that depends on them, but their
+	/// Horn system does not depend on the source unit that is analysed.
+	bool shouldEncode(ContractDefinition const& _contract) const;
 	void eraseKnowledge();
 	void clearIndices(ContractDefinition const* _contract, FunctionDefinition const* _function = nullptr) override;
 	void setCurrentBlock(Predicate const& _block);
@@ -248,14 +257,29 @@ private:
 	/// @returns <true, invariant, empty> if query is unsatisfiable (safe).
 	/// @returns <false, Expression(true), model> otherwise.
 	std::tuple<smtutil::CheckResult, smtutil::Expression, smtutil::CHCSolverInterface::CexGraph> query(smtutil::Expression const& _query, langutil::SourceLocation const& _location);
+	/// Queries @a _solver like query(), but without reporting anything, so that it can be
+	/// run concurrently on different solvers.
+	std::tuple<smtutil::CheckResult, smtutil::Expression, smtutil::CHCSolverInterface::CexGraph> querySolver(
+		smtutil::CHCSolverInterface& _solver,
+		smtutil::Expression const& _query
+	) const;
+	/// Reports the solver problems indicated by @a _result at @a _location.
+	void reportQueryResult(smtutil::CheckResult _result, langutil::SourceLocation const& _location);
 
 	void verificationTargetEncountered(ASTNode const* const _errorNode, VerificationTargetType _type, smtutil::Expression const& _errorCondition);
 
 	void checkVerificationTargets();
+	/// Parses the invariant candidates given for @a _contract in the settings
+	/// into formulas over its interface predicate, warning about the ones that cannot be parsed.
+	void collectInvariantCandidates(ContractDefinition const& _contract);
+	/// Checks whether the collected invariant candidates hold in every reachable state
+	/// of their contract and, if they do, adds them to the Horn system as lemmas.
+	void checkInvariantCandidates();
 	// Forward declarations. Definitions are below.
 	struct CHCVerificationTarget;
 	struct CHCQueryPlaceholder;
 	void checkAssertTarget(ASTNode const* _scope, CHCVerificationTarget const& _target);
+	struct CHCTargetCheck;
 	void checkAndReportTarget(
 		CHCVerificationTarget const& _target,
 		std::vector<CHCQueryPlaceholder> const& _placeholders,
@@ -263,6 +287,31 @@ private:
 		std::string _satMsg,
 		std::string _unknownMsg = ""
 	);
+	/// Checks @a _checks one after the other. If there is a time budget, each query gets
+	/// an equal share of the time that is left, at most @a _queryTimeout if given.
+	void checkAndReportTargets(std::vector<CHCTargetCheck> const& _checks, std::optional<unsigned> _queryTimeout);
+	/// Checks the targets of @a _checks that are still unproved again with the time that is left in the budget.
+	void retryUnprovedTargets(std::vector<CHCTargetCheck> const& _checks);
+	/// Checks @a _checks on clones of the Horn system or, with a solver command, on separate
+	/// solver processes, using up to m_parallelism threads, and reports the results in the given order like checkAndReportTarget().
+	void checkAndReportTargetsInParallel(std::vector<CHCTargetCheck> const& _checks);
+	/// @returns whether @a _target is already known to be unsafe, so that it does not have to be checked again.
+	bool alreadyUnsafe(CHCVerificationTarget const& _target) const;
+	/// Connects the entry points @a _placeholders of @a _target to a new error block.
+	/// @returns the query for the reachability of the error block.
+	smtutil::Expression encodeTargetQuery(
+		CHCVerificationTarget const& _target,
+		std::vector<CHCQueryPlaceholder> const& _placeholders
+	);
+	/// Reports @a _result of @a _query, the query returned by encodeTargetQuery() for @a _target.
+	void reportTarget(
+		CHCVerificationTarget const& _target,
+		smtutil::Expression const& _query,
+		langutil::ErrorId _errorReporterId,
+		std::string const& _satMsg,
+		std::string const& _unknownMsg,
+		std::tuple<smtutil::CheckResult, smtutil::Expression, smtutil::CHCSolverInterface::CexGraph> const& _result
+	);
 
 	std::optional<std::string> generateCounterexample(smtutil::CHCSolverInterface::CexGraph const& _graph, std::string const& _root);
 
@@ -362,6 +411,26 @@ private:
 		smtutil::Expression const fromPredicate;
 	};
 
+	/// A verification target together with the entry points it is checked from and its messages.
+	struct CHCTargetCheck
+	{
+		CHCVerificationTarget const* target;
+		std::vector<CHCQueryPlaceholder> const* placeholders;
+		langutil::ErrorId errorReporterId;
+		std::string satMsg;
+		std::string unknownMsg;
+	};
+
+	/// A contract invariant given in the settings that still has to be proved.
+	struct CHCInvariantCandidate
+	{
+		std::string invariant;
+		/// The application of the contract's interface predicate that the formula is about.
+		smtutil::Expression interface;
+		smtutil::Expression formula;
+	};
+	std::vector<CHCInvariantCandidate> m_invariantCandidates;
+
 	/// Query placeholders for constructors, if the key has type ContractDefinition*,
 	/// or external functions, if the key has type FunctionDefinition*.
 	/// A placeholder is created for each possible context of a function (e.g. multiple contracts in contract inheritance hierarchy).
@@ -374,6 +443,9 @@ private:
 	/// Helper mapping unique IDs to actual verification targets.
 	std::map<unsigned, CHCVerificationTarget> m_verificationTargets;
 
+	/// Contracts whose verification targets were already checked for an earlier source unit.
+	std::set<ContractDefinition const*, ASTNode::CompareByID> m_analyzedContracts;
+
 	/// Targets proved safe.
 	std::map<ASTNode const*, std::set<VerificationTargetType>, smt::EncodingContext::IdCompare> m_safeTargets;
 	/// Targets proved unsafe.
@@ -421,6 +493,10 @@ private:
 
 	/// CHC solver.
 	std::unique_ptr<smtutil::CHCSolverInterface> m_interface;
+
+	/// Maximum number of threads used to check the verification targets.
+	/// Only used with Z3, since the queries to it do not depend on each other.
+	size_t m_parallelism = 1;
 };
 
 }
@@ -37,6 +37,7 @@ void EncodingContext::reset()
 	m_globalContext.clear();
 	m_state.reset();
 	m_assertions.clear();
+	m_assertionLists.clear();
 }
 
 void EncodingContext::resetUniqueId()
@@ -195,7 +196,11 @@ smtutil::Expression EncodingContext::assertions()
 void EncodingContext::pushSolver()
 {
 	if (m_accumulateAssertions)
+	{
 		m_assertions.push_back(assertions());
+		auto list = assertionList();
+		m_assertionLists.push_back(move(list));
+	}
 	else
 		m_assertions.emplace_back(true);
 }
@@ -204,6 +209,8 @@ void EncodingContext::popSolver()
 {
 	solAssert(!m_assertions.empty(), "");
 	m_assertions.pop_back();
+	if (m_assertionLists.size() > m_assertions.size())
+		m_assertionLists.pop_back();
 }
 
 void EncodingContext::addAssertion(smtutil::Expression const& _expr)
@@ -212,4 +219,19 @@ void EncodingContext::addAssertion(smtutil::Expression const& _expr)
 		m_assertions.push_back(_expr);
 	else
 		m_assertions.back() = _expr && move(m_assertions.back());
+
+	if (m_accumulateAssertions)
+	{
+		if (m_assertionLists.size() < m_assertions.size())
+			m_assertionLists.resize(m_assertions.size());
+		m_assertionLists.back().push_back(make_shared<smtutil::Expression const>(_expr));
+	}
+}
+
+vector<shared_ptr<smtutil::Expression const>> const& EncodingContext::assertionList() const
+{
+	static vector<shared_ptr<smtutil::Expression const>> const empty;
+	if (m_assertionLists.empty())
+		return empty;
+	return m_assertionLists.back();
 }
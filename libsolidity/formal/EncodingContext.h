@@ -24,6 +24,8 @@
 #include <libsmtutil/SolverInterface.h>
 
 #include <map>
+#include <memory>
+#include <vector>
 
 namespace solidity::frontend::smt
 {
@@ -142,6 +144,11 @@ public:
 	void pushSolver();
 	void popSolver();
 	void addAssertion(smtutil::Expression const& _e);
+	/// @returns the assertions conjoined by assertions(), oldest first.
+	/// Assertions are shared between the frames of the assertion stack, so the
+	/// lists of two frames can be compared by identity.
+	/// Only tracked if assertions are accumulated.
+	std::vector<std::shared_ptr<smtutil::Expression const>> const& assertionList() const;
 	size_t solverStackHeigh() { return m_assertions.size(); } const
 	smtutil::SolverInterface* solver()
 	{
@@ -176,6 +183,8 @@ private:
 
 	/// Assertion stack.
 	std::vector<smtutil::Expression> m_assertions;
+	/// The assertions of each frame of the assertion stack, if assertions are accumulated.
+	std::vector<std::vector<std::shared_ptr<smtutil::Expression const>>> m_assertionLists;
 
 	/// Whether to conjoin assertions in the assertion stack.
 	bool m_accumulateAssertions = true;
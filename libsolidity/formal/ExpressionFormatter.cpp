@@ -130,8 +130,8 @@ smtutil::Expression substitute(smtutil::Expression _from, map<string, string> co
 		return smtutil::Expression(true);
 	if (_subst.count(_from.name))
 		_from.name = _subst.at(_from.name);
-	for (auto& arg: _from.arguments)
-		arg = substitute(arg, _subst);
+	if (!_from.arguments.empty())
+		_from.arguments = util::applyMap(_from.arguments, [&](auto const& _arg) { return substitute(_arg, _subst); });
 	return _from;
 }
 
@@ -31,6 +31,171 @@ using namespace solidity;
 using namespace solidity::smtutil;
 using namespace solidity::frontend::smt;
 
+namespace
+{
+
+/// Recursive descent parser for the output of toSolidityStr restricted to Booleans and integers.
+/// Infix operations are always enclosed in parentheses there, and all operators of one
+/// parenthesized operation are the same, so no precedence rules are needed.
+class InvariantParser
+{
+public:
+	InvariantParser(string const& _source, map<string, smtutil::Expression> const& _variables):
+		m_source(_source),
+		m_variables(_variables)
+	{}
+
+	optional<smtutil::Expression> parse()
+	{
+		auto result = term();
+		skipWhitespace();
+		if (!result || m_position != m_source.size() || result->sort->kind != smtutil::Kind::Bool)
+			return nullopt;
+		return result;
+	}
+
+private:
+	optional<smtutil::Expression> term()
+	{
+		skipWhitespace();
+		if (accept("("))
+		{
+			auto result = term();
+			if (!result)
+				return nullopt;
+			string op;
+			while (!accept(")"))
+			{
+				string next = infixOperator();
+				if (next.empty() || (!op.empty() && next != op))
+					return nullopt;
+				op = next;
+				auto rhs = term();
+				if (!rhs)
+					return nullopt;
+				result = apply(op, *result, *rhs);
+				if (!result)
+					return nullopt;
+			}
+			return result;
+		}
+		if (accept("!"))
+		{
+			auto operand = term();
+			if (!operand || operand->sort->kind != smtutil::Kind::Bool)
+				return nullopt;
+			return !*operand;
+		}
+		if (accept("-"))
+		{
+			auto operand = term();
+			if (!operand || operand->sort->kind != smtutil::Kind::Int)
+				return nullopt;
+			return smtutil::Expression(size_t(0)) - *operand;
+		}
+		if (m_position < m_source.size() && isdigit(m_source[m_position]))
+		{
+			size_t start = m_position;
+			while (m_position < m_source.size() && isdigit(m_source[m_position]))
+				++m_position;
+			return smtutil::Expression(bigint(m_source.substr(start, m_position - start)));
+		}
+		if (accept("address(this)"))
+			return variable("address(this)");
+		size_t start = m_position;
+		while (
+			m_position < m_source.size() &&
+			(isalnum(m_source[m_position]) || m_source[m_position] == '_' || m_source[m_position] == '$')
+		)
+			++m_position;
+		string name = m_source.substr(start, m_position - start);
+		if (name == "true" || name == "false")
+			return smtutil::Expression(name == "true");
+		if (name.empty())
+			return nullopt;
+		return variable(name);
+	}
+
+	optional<smtutil::Expression> variable(string const& _name) const
+	{
+		if (!m_variables.count(_name))
+			return nullopt;
+		auto const& var = m_variables.at(_name);
+		if (var.sort->kind != smtutil::Kind::Bool && var.sort->kind != smtutil::Kind::Int)
+			return nullopt;
+		return var;
+	}
+
+	/// @returns the infix operator at the current position or the empty string if there is none.
+	string infixOperator()
+	{
+		skipWhitespace();
+		// Operators that are prefixes of others come after them.
+		static vector<string> const ops{"&&", "||", "=>", ">=", "<=", "=", ">", "<", "+", "-", "*", "/", "%"};
+		for (auto const& op: ops)
+			if (accept(op))
+				return op;
+		return {};
+	}
+
+	static optional<smtutil::Expression> apply(string const& _op, smtutil::Expression _a, smtutil::Expression _b)
+	{
+		static set<string> const logical{"&&", "||", "=>"};
+		auto expected = logical.count(_op) ? smtutil::Kind::Bool : smtutil::Kind::Int;
+		if (_op == "=")
+			expected = _a.sort->kind;
+		if (_a.sort->kind != expected || _b.sort->kind != expected)
+			return nullopt;
+
+		if (_op == "&&")
+			return _a && _b;
+		if (_op == "||")
+			return _a || _b;
+		if (_op == "=>")
+			return smtutil::Expression::implies(_a, _b);
+		if (_op == "=")
+			return _a == _b;
+		if (_op == ">=")
+			return _a >= _b;
+		if (_op == "<=")
+			return _a <= _b;
+		if (_op == ">")
+			return _a > _b;
+		if (_op == "<")
+			return _a < _b;
+		if (_op == "+")
+			return _a + _b;
+		if (_op == "-")
+			return _a - _b;
+		if (_op == "*")
+			return _a * _b;
+		if (_op == "/")
+			return _a / _b;
+		solAssert(_op == "%", "");
+		return _a % _b;
+	}
+
+	bool accept(string const& _token)
+	{
+		if (m_source.compare(m_position, _token.size(), _token) != 0)
+			return false;
+		m_position += _token.size();
+		return true;
+	}
+
+	void skipWhitespace()
+	{
+		while (m_position < m_source.size() && isspace(m_source[m_position]))
+			++m_position;
+	}
+
+	string const& m_source;
+	map<string, smtutil::Expression> const& m_variables;
+	size_t m_position = 0;
+};
+
+}
+
 namespace solidity::frontend::smt
 {
 
@@ -83,4 +248,12 @@ map<Predicate const*, set<string>> collectInvariants(
 	return invariants;
 }
 
+optional<smtutil::Expression> parseInvariant(
+	string const& _invariant,
+	map<string, smtutil::Expression> const& _variables
+)
+{
+	return InvariantParser{_invariant, _variables}.parse();
+}
+
 }
@@ -22,6 +22,7 @@
 #include <libsolidity/formal/Predicate.h>
 
 #include <map>
+#include <optional>
 #include <set>
 #include <string>
 
@@ -34,4 +35,15 @@ std::map<Predicate const*, std::set<std::string>> collectInvariants(
 	ModelCheckerInvariants const& _invariantsSettings
 );
 
+/// Parses a contract invariant given in the format in which they are reported, for example
+/// `((x <= y) && !(x = 0))`, into a formula over @a _variables, which maps the names of the
+/// state variables and `address(this)` to their SMT expressions.
+/// Only Boolean and integer variables, numbers and the logical, comparison and arithmetic
+/// operators are supported.
+/// @returns the formula, or nullopt if @a _invariant is not of that form.
+std::optional<smtutil::Expression> parseInvariant(
+	std::string const& _invariant,
+	std::map<std::string, smtutil::Expression> const& _variables
+);
+
 }
@@ -21,27 +21,54 @@
 #include <libsmtutil/Z3Interface.h>
 #endif
 
+#include <libsolutil/ThreadPool.h>
+
 #include <range/v3/algorithm/any_of.hpp>
 #include <range/v3/view.hpp>
 
+#include <mutex>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::util;
 using namespace solidity::langutil;
 using namespace solidity::frontend;
 
+namespace
+{
+
+/// The engines that analyse a single contract, with their own encoding context and solvers.
+struct ContractAnalysis
+{
+	ModelCheckerSettings settings;
+	smt::EncodingContext context;
+	UniqueErrorReporter chcErrors;
+	UniqueErrorReporter bmcErrors;
+	unique_ptr<CHC> chc;
+	unique_ptr<BMC> bmc;
+};
+
+}
+
 ModelChecker::ModelChecker(
 	ErrorReporter& _errorReporter,
 	langutil::CharStreamProvider const& _charStreamProvider,
 	map<h256, string> const& _smtlib2Responses,
 	ModelCheckerSettings _settings,
-	ReadCallback::Callback const& _smtCallback
+	ReadCallback::Callback const& _smtCallback,
+	size_t _parallelism,
+	shared_ptr<ArtifactCache> _queryResultCache
 ):
 	m_errorReporter(_errorReporter),
 	m_settings(move(_settings)),
 	m_context(),
-	m_bmc(m_context, m_uniqueErrorReporter, _smtlib2Responses, _smtCallback, m_settings, _charStreamProvider),
-	m_chc(m_context, m_uniqueErrorReporter, _smtlib2Responses, _smtCallback, m_settings, _charStreamProvider)
+	m_bmc(m_context, m_uniqueErrorReporter, _smtlib2Responses, _smtCallback, m_settings, _charStreamProvider, _queryResultCache),
+	m_chc(m_context, m_uniqueErrorReporter, _smtlib2Responses, _smtCallback, m_settings, _charStreamProvider, _parallelism),
+	m_smtlib2Responses(_smtlib2Responses),
+	m_smtCallback(_smtCallback),
+	m_charStreamProvider(_charStreamProvider),
+	m_parallelism(_parallelism),
+	m_queryResultCache(move(_queryResultCache))
 {
 }
 
@@ -116,23 +143,129 @@ void ModelChecker::analyze(SourceUnit const& _source)
 	if (m_settings.engine.none())
 		return;
 
-	if (m_settings.engine.chc)
-		m_chc.analyze(_source);
+	if (m_settings.totalTimeout && !m_timeBudget)
+	{
+		m_timeBudget = make_shared<smt::TimeBudget const>(*m_settings.totalTimeout);
+		m_bmc.setTimeBudget(m_timeBudget);
+		m_chc.setTimeBudget(m_timeBudget);
+	}
+
+	vector<ContractDefinition const*> contracts;
+	if (m_parallelism > 1)
+		for (auto const& node: _source.nodes())
+			if (auto const* contract = dynamic_cast<ContractDefinition const*>(node.get()))
+				if (
+					contract->canBeDeployed() &&
+					(m_settings.contracts.isDefault() || m_settings.contracts.has(contract->sourceUnitName(), contract->name()))
+				)
+					contracts.push_back(contract);
 
-	auto solvedTargets = m_chc.safeTargets();
-	for (auto const& [node, targets]: m_chc.unsafeTargets())
-		solvedTargets[node] += targets | ranges::views::keys;
+	if (contracts.size() > 1)
+		analyzeContractsInParallel(_source, contracts);
+	else
+	{
+		if (m_settings.engine.chc)
+			m_chc.analyze(_source);
 
-	if (m_settings.engine.bmc)
-		m_bmc.analyze(_source, solvedTargets);
+		auto solvedTargets = m_chc.safeTargets();
+		for (auto const& [node, targets]: m_chc.unsafeTargets())
+			solvedTargets[node] += targets | ranges::views::keys;
+
+		if (m_settings.engine.bmc)
+			m_bmc.analyze(_source, solvedTargets);
+	}
 
 	m_errorReporter.append(m_uniqueErrorReporter.errors());
 	m_uniqueErrorReporter.clear();
 }
 
+void ModelChecker::analyzeContractsInParallel(SourceUnit const& _source, vector<ContractDefinition const*> const& _contracts)
+{
+	mutex callbackMutex;
+	ReadCallback::Callback smtCallback;
+	if (m_smtCallback)
+		smtCallback = [&](string const& _kind, string const& _query) {
+			lock_guard<mutex> lock(callbackMutex);
+			return m_smtCallback(_kind, _query);
+		};
+
+	// The engines are created on this thread, since creating a Z3 solver sets global parameters.
+	vector<unique_ptr<ContractAnalysis>> analyses;
+	for (ContractDefinition const* contract: _contracts)
+	{
+		auto analysis = make_unique<ContractAnalysis>();
+		analysis->settings = m_settings;
+		analysis->settings.contracts.contracts = {{contract->sourceUnitName(), {contract->name()}}};
+		analysis->chc = make_unique<CHC>(
+			analysis->context,
+			analysis->chcErrors,
+			m_smtlib2Responses,
+			smtCallback,
+			analysis->settings,
+			m_charStreamProvider
+		);
+		analysis->bmc = make_unique<BMC>(
+			analysis->context,
+			analysis->bmcErrors,
+			m_smtlib2Responses,
+			smtCallback,
+			analysis->settings,
+			m_charStreamProvider,
+			m_queryResultCache
+		);
+		analysis->chc->disableUnprovedSummary();
+		analysis->bmc->disableUnprovedSummary();
+		analysis->chc->setTimeBudget(m_timeBudget);
+		analysis->bmc->setTimeBudget(m_timeBudget);
+		analyses.emplace_back(move(analysis));
+	}
+
+	// The types and AST annotations are created lazily and shared by all engines, so only
+	// one of them can encode at a time. The lock is released while waiting for a solver.
+	mutex analysisMutex;
+	parallelFor(analyses.size(), m_parallelism, [&](size_t _i) {
+		ContractAnalysis& analysis = *analyses[_i];
+		unique_lock<mutex> lock(analysisMutex);
+		analysis.chc->setAnalysisLock(&lock);
+		analysis.bmc->setAnalysisLock(&lock);
+
+		if (m_settings.engine.chc)
+			analysis.chc->analyze(_source);
+
+		auto solvedTargets = analysis.chc->safeTargets();
+		for (auto const& [node, targets]: analysis.chc->unsafeTargets())
+			solvedTargets[node] += targets | ranges::views::keys;
+
+		if (m_settings.engine.bmc)
+			analysis.bmc->analyze(_source, solvedTargets);
+	});
+
+	// Like the sequential analysis, report the results of CHC before the ones of BMC.
+	// Targets in base contracts and free functions are reported for the first contract only.
+	set<ASTNode const*, smt::EncodingContext::IdCompare> unprovedCHCTargets;
+	for (unique_ptr<ContractAnalysis> const& analysis: analyses)
+	{
+		m_uniqueErrorReporter.append(analysis->chcErrors.errors());
+		unprovedCHCTargets += analysis->chc->unprovedTargets() | ranges::views::keys;
+		m_unhandledQueries += analysis->chc->unhandledQueries();
+	}
+	if (!m_settings.showUnproved && !unprovedCHCTargets.empty())
+		CHC::reportUnprovedSummary(m_uniqueErrorReporter, unprovedCHCTargets.size());
+
+	size_t unprovedBMCAmount = 0;
+	for (unique_ptr<ContractAnalysis> const& analysis: analyses)
+	{
+		m_uniqueErrorReporter.append(analysis->bmcErrors.errors());
+		unprovedBMCAmount += analysis->bmc->unprovedAmount();
+		m_unhandledQueries += analysis->bmc->unhandledQueries();
+	}
+	if (!m_settings.showUnproved && unprovedBMCAmount > 0)
+		BMC::reportUnprovedSummary(m_uniqueErrorReporter, unprovedBMCAmount);
+}
+
 vector<string> ModelChecker::unhandledQueries()
 {
-	return m_bmc.unhandledQueries() + m_chc.unhandledQueries();
+	return m_bmc.unhandledQueries() + m_chc.unhandledQueries() + m_unhandledQueries;
 }
 
 solidity::smtutil::SMTSolverChoice ModelChecker::availableSolvers()
@@ -27,7 +27,9 @@
 #include <libsolidity/formal/CHC.h>
 #include <libsolidity/formal/EncodingContext.h>
 #include <libsolidity/formal/ModelCheckerSettings.h>
+#include <libsolidity/formal/TimeBudget.h>
 
+#include <libsolidity/interface/ArtifactCache.h>
 #include <libsolidity/interface/ReadFile.h>
 
 #include <libsmtutil/SolverInterface.h>
@@ -49,12 +51,17 @@ class ModelChecker
 public:
 	/// @param _enabledSolvers represents a runtime choice of which SMT solvers
 	/// should be used, even if all are available. The default choice is to use all.
+	/// @param _parallelism is the maximum number of threads used to analyse the contracts
+	/// of a source unit, or, if there is only one, to check the CHC verification targets.
+	/// @param _queryResultCache stores the answers of the SMT solvers to the queries of the BMC engine.
 	ModelChecker(
 		langutil::ErrorReporter& _errorReporter,
 		langutil::CharStreamProvider const& _charStreamProvider,
 		std::map<solidity::util::h256, std::string> const& _smtlib2Responses,
 		ModelCheckerSettings _settings = ModelCheckerSettings{},
-		ReadCallback::Callback const& _smtCallback = ReadCallback::Callback()
+		ReadCallback::Callback const& _smtCallback = ReadCallback::Callback(),
+		size_t _parallelism = 1,
+		std::shared_ptr<ArtifactCache> _queryResultCache = {}
 	);
 
 	// TODO This should be removed for 0.9.0.
@@ -75,6 +82,10 @@ public:
 	static smtutil::SMTSolverChoice availableSolvers();
 
 private:
+	/// Analyses each of @a _contracts with its own engines, encoding context and solvers
+	/// on up to m_parallelism threads and reports the merged results in the order of the contracts.
+	void analyzeContractsInParallel(SourceUnit const& _source, std::vector<ContractDefinition const*> const& _contracts);
+
 	/// Error reporter from CompilerStack.
 	/// We need to append m_uniqueErrorReporter
 	/// to this one when the analysis is done.
@@ -95,6 +106,21 @@ private:
 
 	/// Constrained Horn Clauses engine.
 	CHC m_chc;
+
+	/// Used to create the engines of the contracts analysed in parallel.
+	//@{
+	std::map<solidity::util::h256, std::string> const& m_smtlib2Responses;
+	ReadCallback::Callback m_smtCallback;
+	langutil::CharStreamProvider const& m_charStreamProvider;
+	size_t m_parallelism;
+	std::shared_ptr<ArtifactCache> m_queryResultCache;
+	//@}
+
+	/// The budget that all queries of all sources share, created when the first source is analyzed.
+	std::shared_ptr<smt::TimeBudget const> m_timeBudget;
+
+	/// Queries of the contracts analysed in parallel that were not answered.
+	std::vector<std::string> m_unhandledQueries;
 };
 
 }
@@ -20,8 +20,10 @@
 
 #include <libsmtutil/SolverInterface.h>
 
+#include <map>
 #include <optional>
 #include <set>
+#include <string>
 
 namespace solidity::frontend
 {
@@ -151,11 +153,26 @@ struct ModelCheckerSettings
 	/// might prefer the precise encoding.
 	bool divModNoSlacks = false;
 	ModelCheckerEngine engine = ModelCheckerEngine::None();
+	/// Contract invariants found in earlier runs, per source and contract, in the format
+	/// they are reported in. The CHC engine proves them first and then uses them as lemmas.
+	std::map<std::string, std::map<std::string, std::set<std::string>>> invariantCandidates;
 	ModelCheckerInvariants invariants = ModelCheckerInvariants::Default();
+	/// Whether the unsafe targets are reported with a counterexample. Without them, CHC
+	/// does not query the solver again for a complete derivation and BMC does not ask
+	/// for the values of the model.
+	bool showCounterexamples = true;
 	bool showUnproved = false;
+	/// Command that starts an SMT solver reading SMT-LIB2 from its standard input.
+	/// If given, the BMC engine keeps it running and sends it the queries of the
+	/// smtlib2 solver incrementally instead of passing them to the callback.
+	std::optional<std::string> smtlib2Command;
 	smtutil::SMTSolverChoice solvers = smtutil::SMTSolverChoice::All();
 	ModelCheckerTargets targets = ModelCheckerTargets::Default();
 	std::optional<unsigned> timeout;
+	/// Wall-clock budget in milliseconds that all queries share. If given, each query gets an
+	/// equal share of the time that is left, at most ``timeout``, and the CHC engine tries
+	/// the targets it could not solve again with the time that is left after the first round.
+	std::optional<unsigned> totalTimeout;
 
 	bool operator!=(ModelCheckerSettings const& _other) const noexcept { return !(*this == _other); }
 	bool operator==(ModelCheckerSettings const& _other) const noexcept
@@ -164,11 +181,15 @@ struct ModelCheckerSettings
 			contracts == _other.contracts &&
 			divModNoSlacks == _other.divModNoSlacks &&
 			engine == _other.engine &&
+			invariantCandidates == _other.invariantCandidates &&
 			invariants == _other.invariants &&
+			showCounterexamples == _other.showCounterexamples &&
 			showUnproved == _other.showUnproved &&
+			smtlib2Command == _other.smtlib2Command &&
 			solvers == _other.solvers &&
 			targets == _other.targets &&
-			timeout == _other.timeout;
+			timeout == _other.timeout &&
+			totalTimeout == _other.totalTimeout;
 	}
 };
 
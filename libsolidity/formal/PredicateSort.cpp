@@ -30,7 +30,7 @@ namespace solidity::frontend::smt
 
 SortPointer interfaceSort(ContractDefinition const& _contract, SymbolicState& _state)
 {
-	return make_shared<FunctionSort>(
+	return SortProvider::functionSort(
 		vector<SortPointer>{_state.thisAddressSort(), _state.abiSort(), _state.cryptoSort(), _state.stateSort()} + stateSorts(_contract),
 		SortProvider::boolSort
 	);
@@ -40,7 +40,7 @@ SortPointer nondetInterfaceSort(ContractDefinition const& _contract, SymbolicSta
 {
 	auto varSorts = stateSorts(_contract);
 	vector<SortPointer> stateSort{_state.stateSort()};
-	return make_shared<FunctionSort>(
+	return SortProvider::functionSort(
 		vector<SortPointer>{_state.errorFlagSort(), _state.thisAddressSort(), _state.abiSort(), _state.cryptoSort()} +
 			stateSort +
 			varSorts +
@@ -57,7 +57,7 @@ SortPointer constructorSort(ContractDefinition const& _contract, SymbolicState&
 
 	auto varSorts = stateSorts(_contract);
 	vector<SortPointer> stateSort{_state.stateSort()};
-	return make_shared<FunctionSort>(
+	return SortProvider::functionSort(
 		vector<SortPointer>{_state.errorFlagSort(), _state.thisAddressSort(), _state.abiSort(), _state.cryptoSort(), _state.txSort(), _state.stateSort(), _state.stateSort()} + varSorts + varSorts,
 		SortProvider::boolSort
 	);
@@ -69,7 +69,7 @@ SortPointer functionSort(FunctionDefinition const& _function, ContractDefinition
 	auto varSorts = _contract ? stateSorts(*_contract) : vector<SortPointer>{};
 	auto inputSorts = applyMap(_function.parameters(), smtSort);
 	auto outputSorts = applyMap(_function.returnParameters(), smtSort);
-	return make_shared<FunctionSort>(
+	return SortProvider::functionSort(
 		vector<SortPointer>{_state.errorFlagSort(), _state.thisAddressSort(), _state.abiSort(), _state.cryptoSort(), _state.txSort(), _state.stateSort()} +
 			varSorts +
 			inputSorts +
@@ -87,7 +87,7 @@ SortPointer functionBodySort(FunctionDefinition const& _function, ContractDefini
 	solAssert(fSort, "");
 
 	auto smtSort = [](auto _var) { return smt::smtSortAbstractFunction(*_var->type()); };
-	return make_shared<FunctionSort>(
+	return SortProvider::functionSort(
 		fSort->domain + applyMap(SMTEncoder::localVariablesIncludingModifiers(_function, _contract), smtSort),
 		SortProvider::boolSort
 	);
@@ -95,7 +95,7 @@ SortPointer functionBodySort(FunctionDefinition const& _function, ContractDefini
 
 SortPointer arity0FunctionSort()
 {
-	return make_shared<FunctionSort>(
+	return SortProvider::functionSort(
 		vector<SortPointer>(),
 		SortProvider::boolSort
 	);
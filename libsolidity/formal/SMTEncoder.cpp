@@ -61,6 +61,36 @@ SMTEncoder::SMTEncoder(
 void SMTEncoder::resetSourceAnalysis()
 {
 	m_freeFunctions.clear();
+	m_targetTimes.clear();
+}
+
+void SMTEncoder::recordTargetTime(ASTNode const* _node, VerificationTargetType _type, chrono::milliseconds _time)
+{
+	for (auto& entry: m_targetTimes)
+		if (entry.node == _node && entry.type == _type)
+		{
+			entry.time += _time;
+			return;
+		}
+	m_targetTimes.push_back({_node, _type, _time});
+}
+
+void SMTEncoder::reportTargetTimes(string const& _engine)
+{
+	if (m_targetTimes.empty())
+		return;
+
+	string msg = _engine + ": Time spent per verification target:\n";
+	for (auto const& [node, type, time]: m_targetTimes)
+	{
+		string what = type == VerificationTargetType::UnderOverflow ?
+			"Underflow or overflow" :
+			ModelCheckerTargets::targetTypeToString.at(type);
+		string loc = string(m_charStreamProvider.charStream(*node->location().sourceName).text(node->location()));
+		msg += what + " at " + loc + ": " + to_string(time.count()) + " ms\n";
+	}
+	m_errorReporter.info(5744_error, msg);
+	m_targetTimes.clear();
 }
 
 bool SMTEncoder::visit(ContractDefinition const& _contract)
@@ -782,7 +812,7 @@ void SMTEncoder::visitABIFunction(FunctionCall const& _funCall)
 	{
 		auto inputSort = dynamic_cast<smtutil::ArraySort&>(*symbFunction.sort).domain;
 		arg = smtutil::Expression::tuple_constructor(
-			smtutil::Expression(make_shared<smtutil::SortSort>(inputSort), ""),
+			smtutil::Expression(smtutil::SortProvider::sortSort(inputSort), ""),
 			symbArgs
 		);
 	}
@@ -824,7 +854,7 @@ void SMTEncoder::visitCryptoFunction(FunctionCall const& _funCall)
 		auto arg3 = expr(*_funCall.arguments().at(3));
 		auto inputSort = dynamic_cast<smtutil::ArraySort&>(*e.sort).domain;
 		auto ecrecoverInput = smtutil::Expression::tuple_constructor(
-			smtutil::Expression(make_shared<smtutil::SortSort>(inputSort), ""),
+			smtutil::Expression(smtutil::SortProvider::sortSort(inputSort), ""),
 			{arg0, arg1, arg2, arg3}
 		);
 		result = smtutil::Expression::select(e, ecrecoverInput);
@@ -1550,7 +1580,7 @@ void SMTEncoder::indexOrMemberAssignment(Expression const& _expr, smtutil::Expre
 			auto symbArray = dynamic_pointer_cast<smt::SymbolicArrayVariable>(m_context.expression(base));
 			solAssert(symbArray, "");
 			toStore = smtutil::Expression::tuple_constructor(
-				smtutil::Expression(make_shared<smtutil::SortSort>(smt::smtSort(*baseType)), baseType->toString(true)),
+				smtutil::Expression(smtutil::SortProvider::sortSort(smt::smtSort(*baseType)), baseType->toString(true)),
 				{smtutil::Expression::store(symbArray->elements(), indexExpr, toStore), symbArray->length()}
 			);
 			defineExpr(*indexAccess, smtutil::Expression::select(
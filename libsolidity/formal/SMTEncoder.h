@@ -27,6 +27,7 @@
 #include <libsolidity/formal/EncodingContext.h>
 #include <libsolidity/formal/ModelCheckerSettings.h>
 #include <libsolidity/formal/SymbolicVariables.h>
+#include <libsolidity/formal/TimeBudget.h>
 #include <libsolidity/formal/VariableUsage.h>
 
 #include <libsolidity/ast/AST.h>
@@ -34,6 +35,9 @@
 #include <libsolidity/interface/ReadFile.h>
 #include <liblangutil/UniqueErrorReporter.h>
 
+#include <chrono>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -129,9 +133,30 @@ public:
 	/// including itself.
 	static std::set<SourceUnit const*, ASTNode::CompareByID> sourceDependencies(SourceUnit const& _source);
 
+	/// Sets the lock that guards the state shared with engines analysing other contracts
+	/// on other threads, i.e. the lazily created types and AST annotations.
+	/// It has to be held during the analysis and is only released while a solver is queried.
+	void setAnalysisLock(std::unique_lock<std::mutex>* _lock) { m_analysisLock = _lock; }
+	/// Stops the engine from reporting how many verification conditions could not be proved.
+	/// Used if the caller merges the results of several engines and reports the total itself.
+	void disableUnprovedSummary() { m_reportUnprovedSummary = false; }
+	/// Sets the wall-clock budget that the queries of this engine share with the other engines.
+	void setTimeBudget(std::shared_ptr<smt::TimeBudget const> _timeBudget) { m_timeBudget = std::move(_timeBudget); }
+
 protected:
 	void resetSourceAnalysis();
 
+	/// @returns the result of @a _query, which is called with the analysis lock released, if there is one.
+	template <typename Query>
+	auto queryWithoutAnalysisLock(Query const& _query) const
+	{
+		if (!m_analysisLock)
+			return _query();
+		m_analysisLock->unlock();
+		ScopeGuard relock{[this]() { m_analysisLock->lock(); }};
+		return _query();
+	}
+
 	// TODO: Check that we do not have concurrent reads and writes to a variable,
 	// because the order of expression evaluation is undefined
 	// TODO: or just force a certain order, but people might have a different idea about that.
@@ -427,6 +452,26 @@ protected:
 	bool m_arrayAssignmentHappened = false;
 	// True if the "No SMT solver available" warning was already created.
 	bool m_noSolverWarning = false;
+	/// Whether the number of verification conditions that could not be proved is reported.
+	bool m_reportUnprovedSummary = true;
+	/// Lock on the state shared with engines running on other threads, if any.
+	std::unique_lock<std::mutex>* m_analysisLock = nullptr;
+
+	/// The time budget shared by all queries, if there is one.
+	std::shared_ptr<smt::TimeBudget const> m_timeBudget;
+	struct TargetTime
+	{
+		ASTNode const* node;
+		VerificationTargetType type;
+		std::chrono::milliseconds time;
+	};
+	/// The time spent on each verification target, in the order the targets were checked.
+	/// Only recorded if there is a time budget.
+	std::vector<TargetTime> m_targetTimes;
+	/// Adds @a _time to the time of the target @a _type at @a _node.
+	void recordTargetTime(ASTNode const* _node, VerificationTargetType _type, std::chrono::milliseconds _time);
+	/// Reports m_targetTimes in an info message that starts with @a _engine and clears them.
+	void reportTargetTimes(std::string const& _engine);
 
 	/// Stores the instances of an Uninterpreted Function applied to arguments.
 	/// These may be direct application of UFs or Array index access.
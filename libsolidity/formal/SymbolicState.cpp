@@ -45,7 +45,7 @@ BlockchainVariable::BlockchainVariable(
 		m_componentIndices[component] = static_cast<unsigned>(members.size() - 1);
 	}
 	m_tuple = make_unique<SymbolicTupleVariable>(
-		make_shared<smtutil::TupleSort>(m_name + "_type", members, sorts),
+		smtutil::SortProvider::tupleSort(m_name + "_type", members, sorts),
 		m_name,
 		m_context
 	);
@@ -66,7 +66,7 @@ smtutil::Expression BlockchainVariable::assignMember(string const& _member, smtu
 			args.emplace_back(member(m.first));
 	m_tuple->increaseIndex();
 	auto tuple = m_tuple->currentValue();
-	auto sortExpr = smtutil::Expression(make_shared<smtutil::SortSort>(tuple.sort), tuple.name);
+	auto sortExpr = smtutil::Expression(smtutil::SortProvider::sortSort(tuple.sort), tuple.name);
 	m_context.addAssertion(tuple == smtutil::Expression::tuple_constructor(sortExpr, args));
 	return m_tuple->currentValue();
 }
@@ -307,14 +307,14 @@ void SymbolicState::buildABIFunctions(set<FunctionCall const*> const& _abiFuncti
 				inNames.emplace_back(_name + "_input_" + to_string(i));
 				sorts.emplace_back(smtSortAbstractFunction(*_types.at(i)));
 			}
-			return make_shared<smtutil::TupleSort>(
+			return smtutil::SortProvider::tupleSort(
 				_name + "_input",
 				inNames,
 				sorts
 			);
 		};
 
-		auto functionSort = make_shared<smtutil::ArraySort>(
+		auto functionSort = smtutil::SortProvider::arraySort(
 			typesToSort(inTypes, name),
 			typesToSort(outTypes, name)
 		);
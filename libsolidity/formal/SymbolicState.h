@@ -187,7 +187,7 @@ private:
 
 	BlockchainVariable m_state{
 		"state",
-		{{"balances", std::make_shared<smtutil::ArraySort>(smtutil::SortProvider::uintSort, smtutil::SortProvider::uintSort)}},
+		{{"balances", smtutil::SortProvider::arraySort(smtutil::SortProvider::uintSort, smtutil::SortProvider::uintSort)}},
 		m_context
 	};
 
@@ -201,7 +201,7 @@ private:
 			{"block.gaslimit", smtutil::SortProvider::uintSort},
 			{"block.number", smtutil::SortProvider::uintSort},
 			{"block.timestamp", smtutil::SortProvider::uintSort},
-			{"blockhash", std::make_shared<smtutil::ArraySort>(smtutil::SortProvider::uintSort, smtutil::SortProvider::uintSort)},
+			{"blockhash", smtutil::SortProvider::arraySort(smtutil::SortProvider::uintSort, smtutil::SortProvider::uintSort)},
 			// TODO gasleft
 			{"msg.data", smt::smtSort(*TypeProvider::bytesMemory())},
 			{"msg.sender", smt::smtSort(*TypeProvider::address())},
@@ -216,20 +216,20 @@ private:
 	BlockchainVariable m_crypto{
 		"crypto",
 		{
-			{"keccak256", std::make_shared<smtutil::ArraySort>(
+			{"keccak256", smtutil::SortProvider::arraySort(
 				smt::smtSort(*TypeProvider::bytesStorage()),
 				smtSort(*TypeProvider::fixedBytes(32))
 			)},
-			{"sha256", std::make_shared<smtutil::ArraySort>(
+			{"sha256", smtutil::SortProvider::arraySort(
 				smt::smtSort(*TypeProvider::bytesStorage()),
 				smtSort(*TypeProvider::fixedBytes(32))
 			)},
-			{"ripemd160", std::make_shared<smtutil::ArraySort>(
+			{"ripemd160", smtutil::SortProvider::arraySort(
 				smt::smtSort(*TypeProvider::bytesStorage()),
 				smtSort(*TypeProvider::fixedBytes(20))
 			)},
-			{"ecrecover", std::make_shared<smtutil::ArraySort>(
-				std::make_shared<smtutil::TupleSort>(
+			{"ecrecover", smtutil::SortProvider::arraySort(
+				smtutil::SortProvider::tupleSort(
 					"ecrecover_input_type",
 					std::vector<std::string>{"hash", "v", "r", "s"},
 					std::vector<smtutil::SortPointer>{
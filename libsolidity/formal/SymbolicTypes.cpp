@@ -61,7 +61,7 @@ SortPointer smtSort(frontend::Type const& _type)
 			returnSort = SortProvider::uintSort;
 		else
 			returnSort = smtSort(*returnTypes.front());
-		return make_shared<FunctionSort>(parameterSorts, returnSort);
+		return SortProvider::functionSort(parameterSorts, returnSort);
 	}
 	case Kind::Array:
 	{
@@ -70,13 +70,13 @@ SortPointer smtSort(frontend::Type const& _type)
 		{
 			auto mapType = dynamic_cast<frontend::MappingType const*>(&_type);
 			solAssert(mapType, "");
-			array = make_shared<ArraySort>(smtSortAbstractFunction(*mapType->keyType()), smtSortAbstractFunction(*mapType->valueType()));
+			array = SortProvider::arraySort(smtSortAbstractFunction(*mapType->keyType()), smtSortAbstractFunction(*mapType->valueType()));
 		}
 		else if (isStringLiteral(_type))
 		{
 			auto stringLitType = dynamic_cast<frontend::StringLiteralType const*>(&_type);
 			solAssert(stringLitType, "");
-			array = make_shared<ArraySort>(SortProvider::uintSort, SortProvider::uintSort);
+			array = SortProvider::arraySort(SortProvider::uintSort, SortProvider::uintSort);
 		}
 		else
 		{
@@ -89,7 +89,7 @@ SortPointer smtSort(frontend::Type const& _type)
 				solAssert(false, "");
 
 			solAssert(arrayType, "");
-			array = make_shared<ArraySort>(SortProvider::uintSort, smtSortAbstractFunction(*arrayType->baseType()));
+			array = SortProvider::arraySort(SortProvider::uintSort, smtSortAbstractFunction(*arrayType->baseType()));
 		}
 
 		string tupleName;
@@ -125,7 +125,7 @@ SortPointer smtSort(frontend::Type const& _type)
 
 		tupleName += "_tuple";
 
-		return make_shared<TupleSort>(
+		return SortProvider::tupleSort(
 			tupleName,
 			vector<string>{tupleName + "_accessor_array", tupleName + "_accessor_length"},
 			vector<SortPointer>{array, SortProvider::uintSort}
@@ -158,7 +158,7 @@ SortPointer smtSort(frontend::Type const& _type)
 		else
 			solAssert(false, "");
 
-		return make_shared<TupleSort>(tupleName, members, sorts);
+		return SortProvider::tupleSort(tupleName, members, sorts);
 	}
 	default:
 		// Abstract case.
@@ -465,7 +465,7 @@ smtutil::Expression zeroValue(frontend::Type const* _type)
 		{
 			auto tupleSort = dynamic_pointer_cast<TupleSort>(smtSort(*_type));
 			solAssert(tupleSort, "");
-			auto sortSort = make_shared<SortSort>(tupleSort->components.front());
+			auto sortSort = SortProvider::sortSort(tupleSort->components.front());
 
 			std::optional<smtutil::Expression> zeroArray;
 			auto length = bigint(0);
@@ -482,7 +482,7 @@ smtutil::Expression zeroValue(frontend::Type const* _type)
 
 			solAssert(zeroArray, "");
 			return smtutil::Expression::tuple_constructor(
-				smtutil::Expression(std::make_shared<SortSort>(tupleSort), tupleSort->name),
+				smtutil::Expression(SortProvider::sortSort(tupleSort), tupleSort->name),
 				vector<smtutil::Expression>{*zeroArray, length}
 			);
 
@@ -492,7 +492,7 @@ smtutil::Expression zeroValue(frontend::Type const* _type)
 			auto const* structType = dynamic_cast<StructType const*>(_type);
 			auto structSort = dynamic_pointer_cast<TupleSort>(smtSort(*_type));
 			return smtutil::Expression::tuple_constructor(
-				smtutil::Expression(make_shared<SortSort>(structSort), structSort->name),
+				smtutil::Expression(SortProvider::sortSort(structSort), structSort->name),
 				applyMap(
 					structType->structDefinition().members(),
 					[](auto var) { return zeroValue(var->type()); }
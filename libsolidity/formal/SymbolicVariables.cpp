@@ -80,9 +80,14 @@ string SymbolicVariable::nameAtIndex(unsigned _index) const
 	return uniqueSymbol(_index);
 }
 
-string SymbolicVariable::uniqueSymbol(unsigned _index) const
+string const& SymbolicVariable::uniqueSymbol(unsigned _index) const
 {
-	return m_uniqueName + "_" + to_string(_index);
+	if (_index >= m_symbols.size())
+		m_symbols.resize(_index + 1);
+	string& symbol = m_symbols[_index];
+	if (symbol.empty())
+		symbol = m_uniqueName + "_" + to_string(_index);
+	return symbol;
 }
 
 smtutil::Expression SymbolicVariable::resetIndex()
@@ -257,7 +262,7 @@ smtutil::Expression SymbolicTupleVariable::currentValue(frontend::Type const* _t
 	for (size_t i = 0; i < thisTuple->components.size(); ++i)
 		args.emplace_back(component(i, type(), _targetType));
 	return smtutil::Expression::tuple_constructor(
-		smtutil::Expression(make_shared<smtutil::SortSort>(smtSort(*_targetType)), ""),
+		smtutil::Expression(smtutil::SortProvider::sortSort(smtSort(*_targetType)), ""),
 		args
 	);
 }
@@ -305,7 +310,7 @@ SymbolicArrayVariable::SymbolicArrayVariable(
 ):
 	SymbolicVariable(move(_sort), move(_uniqueName), _context),
 	m_pair(
-		std::make_shared<TupleSort>(
+		SortProvider::tupleSort(
 			"array_length_pair",
 			std::vector<std::string>{"array", "length"},
 			std::vector<SortPointer>{m_sort, SortProvider::uintSort}
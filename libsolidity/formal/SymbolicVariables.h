@@ -75,7 +75,7 @@ public:
 	frontend::Type const* originalType() const { return m_originalType; }
 
 protected:
-	std::string uniqueSymbol(unsigned _index) const;
+	std::string const& uniqueSymbol(unsigned _index) const;
 
 	/// SMT sort.
 	smtutil::SortPointer m_sort;
@@ -84,6 +84,9 @@ protected:
 	/// Solidity original type, used for type conversion if necessary.
 	frontend::Type const* m_originalType;
 	std::string m_uniqueName;
+	/// The names of the SSA indices, formatted on first use. The indices of a variable
+	/// are allocated consecutively, so they are stored by index.
+	mutable std::vector<std::string> m_symbols;
 	EncodingContext& m_context;
 	std::unique_ptr<SSAVariable> m_ssa;
 };
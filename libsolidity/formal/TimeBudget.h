@@ -0,0 +1,71 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <optional>
+
+namespace solidity::frontend::smt
+{
+
+/**
+ * Wall-clock time that the queries of all engines and contracts share.
+ * Each query gets an equal share of the time that is left among the queries
+ * that are still pending, so that the time easy targets do not use is
+ * redistributed to the remaining ones.
+ * It can be shared between the threads that analyse contracts in parallel.
+ */
+class TimeBudget
+{
+public:
+	/// @param _total the budget in milliseconds, starting now.
+	explicit TimeBudget(unsigned _total):
+		m_deadline(std::chrono::steady_clock::now() + std::chrono::milliseconds(_total))
+	{}
+
+	/// @returns the milliseconds that are left.
+	unsigned remaining() const
+	{
+		auto left = std::chrono::duration_cast<std::chrono::milliseconds>(m_deadline - std::chrono::steady_clock::now());
+		return left.count() > 0 ? static_cast<unsigned>(left.count()) : 0;
+	}
+
+	bool exhausted() const { return remaining() == 0; }
+
+	/// @returns the timeout in milliseconds of the next query if @a _pendingQueries queries,
+	/// including it, share the time that is left, at most @a _queryTimeout if given.
+	/// @returns zero if the budget is exhausted.
+	unsigned queryTimeout(size_t _pendingQueries, std::optional<unsigned> _queryTimeout) const
+	{
+		unsigned left = remaining();
+		if (left == 0)
+			return 0;
+		unsigned share = std::max(1u, static_cast<unsigned>(left / std::max<size_t>(_pendingQueries, 1)));
+		if (_queryTimeout && *_queryTimeout > 0)
+			share = std::min(share, *_queryTimeout);
+		return share;
+	}
+
+private:
+	std::chrono::steady_clock::time_point m_deadline;
+};
+
+}
@@ -0,0 +1,114 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/interface/ArtifactCache.h>
+
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/Exceptions.h>
+
+#include <fstream>
+#include <random>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+using namespace solidity::util;
+
+optional<string> DirectoryArtifactCache::load(h256 const& _key)
+{
+	boost::filesystem::path path = entryPath(_key);
+	boost::system::error_code errorCode;
+	if (!boost::filesystem::is_regular_file(path, errorCode))
+		return nullopt;
+	try
+	{
+		return readFileAsString(path);
+	}
+	catch (FileNotFound const&)
+	{
+		return nullopt;
+	}
+	catch (NotAFile const&)
+	{
+		return nullopt;
+	}
+}
+
+void DirectoryArtifactCache::store(h256 const& _key, string const& _artifact)
+{
+	boost::filesystem::path path = entryPath(_key);
+	boost::system::error_code errorCode;
+	boost::filesystem::create_directories(path.parent_path(), errorCode);
+	if (errorCode)
+		return;
+
+	boost::filesystem::path temporaryPath = path;
+	temporaryPath += "." + to_string(random_device{}()) + ".tmp";
+	{
+		ofstream outFile(temporaryPath.string(), ios::binary | ios::trunc);
+		outFile << _artifact;
+		if (!outFile.good())
+		{
+			outFile.close();
+			boost::filesystem::remove(temporaryPath, errorCode);
+			return;
+		}
+	}
+	boost::filesystem::rename(temporaryPath, path, errorCode);
+	if (errorCode)
+		boost::filesystem::remove(temporaryPath, errorCode);
+}
+
+boost::filesystem::path DirectoryArtifactCache::entryPath(h256 const& _key) const
+{
+	string name = _key.hex();
+	return m_directory / name.substr(0, 2) / name;
+}
+
+optional<string> MemoryArtifactCache::load(h256 const& _key)
+{
+	lock_guard<mutex> lock(m_mutex);
+	if (auto entry = m_entries.find(_key); entry != m_entries.end())
+		return entry->second;
+	return nullopt;
+}
+
+void MemoryArtifactCache::store(h256 const& _key, string const& _artifact)
+{
+	if (_artifact.size() > m_maxSize)
+		return;
+
+	lock_guard<mutex> lock(m_mutex);
+	auto [entry, inserted] = m_entries.try_emplace(_key, _artifact);
+	if (!inserted)
+	{
+		m_size -= entry->second.size();
+		entry->second = _artifact;
+	}
+	else
+		m_order.push_back(_key);
+	m_size += _artifact.size();
+
+	while (m_size > m_maxSize)
+	{
+		auto oldest = m_entries.find(m_order.front());
+		m_size -= oldest->second.size();
+		m_entries.erase(oldest);
+		m_order.pop_front();
+	}
+}
@@ -0,0 +1,97 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Content-addressed storage for artifacts of the code generator.
+ */
+
+#pragma once
+
+#include <libsolutil/FixedHash.h>
+
+#include <boost/filesystem.hpp>
+
+#include <deque>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+
+namespace solidity::frontend
+{
+
+/**
+ * Storage for code generation artifacts, keyed by a hash of all inputs that affect them.
+ * Implementations may drop entries at any time; a missing entry only means that the
+ * artifact has to be generated again.
+ * Has to support being used from multiple threads at the same time.
+ */
+class ArtifactCache
+{
+public:
+	virtual ~ArtifactCache() = default;
+
+	/// @returns the artifact stored under @a _key, if any.
+	virtual std::optional<std::string> load(util::h256 const& _key) = 0;
+	/// Stores @a _artifact under @a _key. Errors are ignored.
+	virtual void store(util::h256 const& _key, std::string const& _artifact) = 0;
+};
+
+/**
+ * Artifact cache that stores one file per entry in a directory on disk.
+ * Entries are written to a temporary file first and then renamed, so concurrent
+ * compiler processes sharing the directory never observe partially written entries.
+ */
+class DirectoryArtifactCache: public ArtifactCache
+{
+public:
+	explicit DirectoryArtifactCache(boost::filesystem::path _directory): m_directory(std::move(_directory)) {}
+
+	std::optional<std::string> load(util::h256 const& _key) override;
+	void store(util::h256 const& _key, std::string const& _artifact) override;
+
+	boost::filesystem::path const& directory() const { return m_directory; }
+
+private:
+	boost::filesystem::path entryPath(util::h256 const& _key) const;
+
+	boost::filesystem::path m_directory;
+};
+
+/**
+ * Artifact cache that keeps the entries in memory, for processes that compile many times.
+ * Once the entries take more than the given number of bytes, the oldest ones are dropped.
+ */
+class MemoryArtifactCache: public ArtifactCache
+{
+public:
+	explicit MemoryArtifactCache(size_t _maxSize = 256 * 1024 * 1024): m_maxSize(_maxSize) {}
+
+	std::optional<std::string> load(util::h256 const& _key) override;
+	void store(util::h256 const& _key, std::string const& _artifact) override;
+
+private:
+	size_t const m_maxSize;
+	std::mutex m_mutex;
+	std::map<util::h256, std::string> m_entries;
+	/// Keys of m_entries from the oldest to the newest entry.
+	std::deque<util::h256> m_order;
+	/// Sum of the sizes of the artifacts in m_entries.
+	size_t m_size = 0;
+};
+
+}
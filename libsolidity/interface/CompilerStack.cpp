@@ -26,6 +26,7 @@
 #include <libsolidity/interface/CompilerStack.h>
 #include <libsolidity/interface/ImportRemapper.h>
 
+#include <libsolidity/analysis/CalldataParameterRewriter.h>
 #include <libsolidity/analysis/ControlFlowAnalyzer.h>
 #include <libsolidity/analysis/ControlFlowGraph.h>
 #include <libsolidity/analysis/ControlFlowRevertPruner.h>
@@ -48,6 +49,7 @@
 #include <libsolidity/ast/TypeProvider.h>
 #include <libsolidity/ast/ASTJsonImporter.h>
 #include <libsolidity/codegen/Compiler.h>
+#include <libsolidity/codegen/CompilerUtils.h>
 #include <libsolidity/formal/ModelChecker.h>
 #include <libsolidity/interface/ABI.h>
 #include <libsolidity/interface/Natspec.h>
@@ -65,6 +67,7 @@
 #include <libyul/AssemblyStack.h>
 #include <libyul/AST.h>
 #include <libyul/AsmParser.h>
+#include <libyul/optimiser/OptimisedCodeCache.h>
 
 #include <liblangutil/Scanner.h>
 #include <liblangutil/SemVerHandler.h>
@@ -75,12 +78,16 @@
 #include <libsolutil/IpfsHash.h>
 #include <libsolutil/JSON.h>
 #include <libsolutil/Algorithms.h>
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/Profiler.h>
+#include <libsolutil/ThreadPool.h>
 
 #include <json/json.h>
 
 #include <boost/algorithm/string/replace.hpp>
 
 #include <utility>
+#include <future>
 #include <map>
 #include <limits>
 #include <string>
@@ -95,6 +102,74 @@ using solidity::util::toHex;
 
 static int g_compilerStackCounts = 0;
 
+namespace
+{
+
+/// The ASTs replaced by incremental updates and the types created for them are only released
+/// by a reset. Once there are more of them than this many per source, but at least
+/// minRetiredASTs, updateSources() analyses everything again to release them.
+size_t const maxRetiredASTsPerSource = 2;
+size_t const minRetiredASTs = 32;
+
+/// Prefix of the contents of the metadata data objects in printed Yul objects.
+string const& metadataDataPrefix()
+{
+	static string const prefix = "data \"" + yul::Object::metadataName() + "\" hex\"";
+	return prefix;
+}
+
+/// Removes the contents of the metadata data objects from the Yul code @a _ir.
+/// @returns the removed contents in the order of their appearance.
+vector<string> removeMetadata(string& _ir)
+{
+	string const& prefix = metadataDataPrefix();
+	vector<string> metadata;
+	string result;
+	size_t position = 0;
+	for (
+		size_t found = _ir.find(prefix);
+		found != string::npos;
+		found = _ir.find(prefix, position)
+	)
+	{
+		size_t const start = found + prefix.size();
+		size_t const end = _ir.find('"', start);
+		if (end == string::npos)
+			break;
+		result.append(_ir, position, start - position);
+		metadata.emplace_back(_ir.substr(start, end - start));
+		position = end;
+	}
+	result.append(_ir, position, string::npos);
+	_ir = move(result);
+	return metadata;
+}
+
+/// Inserts @a _metadata into the metadata data objects of @a _ir, inverting removeMetadata.
+/// @returns nullopt if the number of data objects does not match.
+optional<string> insertMetadata(string const& _ir, vector<string> const& _metadata)
+{
+	string const placeholder = metadataDataPrefix() + "\"";
+	string result;
+	size_t position = 0;
+	for (string const& metadata: _metadata)
+	{
+		size_t const found = _ir.find(placeholder, position);
+		if (found == string::npos)
+			return nullopt;
+		size_t const start = found + metadataDataPrefix().size();
+		result.append(_ir, position, start - position);
+		result += metadata;
+		position = start;
+	}
+	if (_ir.find(placeholder, position) != string::npos)
+		return nullopt;
+	result.append(_ir, position, string::npos);
+	return result;
+}
+
+}
+
 CompilerStack::CompilerStack(ReadCallback::Callback _readFile):
 	m_readFile{std::move(_readFile)},
 	m_errorReporter{m_errorList}
@@ -113,36 +188,61 @@ CompilerStack::~CompilerStack()
 
 void CompilerStack::createAndAssignCallGraphs()
 {
+	vector<ContractDefinition const*> pendingContracts;
 	for (Source const* source: m_sourceOrder)
 	{
-		if (!source->ast)
+		if (!source->ast || isReusedSource(*source))
 			continue;
 
 		for (ContractDefinition const* contract: ASTNode::filteredNodes<ContractDefinition>(source->ast->nodes()))
-		{
-			ContractDefinitionAnnotation& annotation =
-				m_contracts.at(contract->fullyQualifiedName()).contract->annotation();
+			if (!m_analyzeOnlyRequestedContracts || isRequestedContract(*contract))
+				pendingContracts.push_back(contract);
+	}
+	// Process the contracts in source order, the dependencies are appended when needed.
+	reverse(pendingContracts.begin(), pendingContracts.end());
 
-			annotation.creationCallGraph = make_unique<CallGraph>(
-				FunctionCallGraphBuilder::buildCreationGraph(*contract)
-			);
-			annotation.deployedCallGraph = make_unique<CallGraph>(
-				FunctionCallGraphBuilder::buildDeployedGraph(
-					*contract,
-					**annotation.creationCallGraph
-				)
-			);
+	// Functions inherited by several contracts are only traversed once.
+	FunctionCallGraphBuilder::SummaryCache summaryCache;
+	while (!pendingContracts.empty())
+	{
+		ContractDefinition const* contract = pendingContracts.back();
+		pendingContracts.pop_back();
+		if (contract->annotation().creationCallGraph.set())
+			continue;
 
-			solAssert(annotation.contractDependencies.empty(), "contractDependencies expected to be empty?!");
+		ContractDefinitionAnnotation& annotation =
+			m_contracts.at(contract->fullyQualifiedName()).contract->annotation();
 
-			annotation.contractDependencies = annotation.creationCallGraph->get()->bytecodeDependency;
+		annotation.creationCallGraph = make_unique<CallGraph>(
+			FunctionCallGraphBuilder::buildCreationGraph(*contract, &summaryCache)
+		);
+		annotation.deployedCallGraph = make_unique<CallGraph>(
+			FunctionCallGraphBuilder::buildDeployedGraph(
+				*contract,
+				**annotation.creationCallGraph,
+				&summaryCache
+			)
+		);
 
-			for (auto const& [dependencyContract, referencee]: annotation.deployedCallGraph->get()->bytecodeDependency)
-				annotation.contractDependencies.emplace(dependencyContract, referencee);
-		}
+		solAssert(annotation.contractDependencies.empty(), "contractDependencies expected to be empty?!");
+
+		annotation.contractDependencies = annotation.creationCallGraph->get()->bytecodeDependency;
+
+		for (auto const& [dependencyContract, referencee]: annotation.deployedCallGraph->get()->bytecodeDependency)
+			annotation.contractDependencies.emplace(dependencyContract, referencee);
+
+		// The code of created contracts is generated as well, even if they are not requested.
+		if (m_analyzeOnlyRequestedContracts)
+			for (auto const& [dependencyContract, referencee]: annotation.contractDependencies)
+				pendingContracts.push_back(dependencyContract);
 	}
 }
 
+bool CompilerStack::isAnalysedContract(ContractDefinition const& _contract) const
+{
+	return !m_analyzeOnlyRequestedContracts || _contract.annotation().creationCallGraph.set();
+}
+
 void CompilerStack::findAndReportCyclicContractDependencies()
 {
 	// Cycles we found, used to avoid duplicate reports for the same reference
@@ -208,6 +308,13 @@ void CompilerStack::setRemappings(vector<ImportRemapper::Remapping> _remappings)
 	m_importRemapper.setRemappings(move(_remappings));
 }
 
+void CompilerStack::setAnalyzeOnlyRequestedContracts(bool _analyzeOnlyRequestedContracts)
+{
+	if (m_stackState >= AnalysisPerformed)
+		solThrow(CompilerError, "Must set the analysis mode before analysis.");
+	m_analyzeOnlyRequestedContracts = _analyzeOnlyRequestedContracts;
+}
+
 void CompilerStack::setViaIR(bool _viaIR)
 {
 	if (m_stackState >= ParsedAndImported)
@@ -290,6 +397,7 @@ void CompilerStack::reset(bool _keepSettings)
 {
 	m_stackState = Empty;
 	m_hasError = false;
+	m_modelCheckingPending = false;
 	m_sources.clear();
 	m_smtlib2Responses.clear();
 	m_unhandledSMTLib2Queries.clear();
@@ -302,16 +410,31 @@ void CompilerStack::reset(bool _keepSettings)
 		m_modelCheckerSettings = ModelCheckerSettings{};
 		m_generateIR = false;
 		m_generateEwasm = false;
+		m_generateDebugInfo = true;
+		m_parallelism = 1;
+		m_analyzeOnlyRequestedContracts = false;
+		m_artifactCache.reset();
 		m_revertStrings = RevertStrings::Default;
 		m_optimiserSettings = OptimiserSettings::minimal();
 		m_metadataLiteralSources = false;
 		m_metadataHash = MetadataHash::IPFS;
 		m_stopAfter = State::CompilationSuccessful;
 	}
-	m_globalContext.reset();
 	m_sourceOrder.clear();
 	m_contracts.clear();
+	m_metadataSettings.clear();
 	m_errorReporter.clear();
+	discardPreviousAnalysis();
+}
+
+void CompilerStack::discardPreviousAnalysis()
+{
+	m_previousSources.clear();
+	m_previousErrors.clear();
+	m_reusedSources.clear();
+	m_retiredASTs.clear();
+	m_lastNodeID = 0;
+	m_globalContext.reset();
 	TypeProvider::reset();
 }
 
@@ -321,38 +444,96 @@ void CompilerStack::setSources(StringMap _sources)
 		solThrow(CompilerError, "Cannot change sources once set.");
 	if (m_stackState != Empty)
 		solThrow(CompilerError, "Must set sources before parsing.");
-	for (auto source: _sources)
+	for (auto& source: _sources)
 		m_sources[source.first].charStream = make_unique<CharStream>(/*content*/std::move(source.second), /*name*/source.first);
 	m_stackState = SourcesSet;
 }
 
+void CompilerStack::updateSources(StringMap _sources)
+{
+	bool const tooManyRetiredASTs =
+		m_retiredASTs.size() > max(minRetiredASTs, maxRetiredASTsPerSource * max(m_sources.size(), _sources.size()));
+	if (m_stackState < AnalysisPerformed || m_hasError || m_importedSources || tooManyRetiredASTs)
+	{
+		reset(true);
+		setSources(move(_sources));
+		return;
+	}
+
+	set<string> analysedSources;
+	for (Source const* source: m_sourceOrder)
+		if (source->ast)
+			analysedSources.insert(*source->ast->annotation().path);
+	m_sourceOrder.clear();
+	m_contracts.clear();
+	m_metadataSettings.clear();
+
+	solAssert(m_previousSources.empty(), "");
+	for (auto& [name, source]: m_sources)
+		if (analysedSources.count(name))
+			m_previousSources[name] = move(source);
+		else if (source.ast)
+			m_retiredASTs.emplace_back(move(source.ast));
+	m_sources.clear();
+
+	for (shared_ptr<Error const> const& error: m_errorList)
+		if (
+			SourceLocation const* location = error->sourceLocation();
+			location && location->sourceName && analysedSources.count(*location->sourceName)
+		)
+			m_previousErrors.emplace_back(error);
+	m_errorReporter.clear();
+	m_previousAnalysisSettings = analysisSettings();
+	m_reusedSources.clear();
+
+	m_stackState = Empty;
+	m_hasError = false;
+	m_modelCheckingPending = false;
+	m_smtlib2Responses.clear();
+	m_unhandledSMTLib2Queries.clear();
+	setSources(move(_sources));
+}
+
+CompilerStack::AnalysisSettings CompilerStack::analysisSettings() const
+{
+	return AnalysisSettings{
+		m_evmVersion,
+		m_importRemapper.remappings(),
+		m_parserErrorRecovery,
+		m_optimiserSettings.runYulOptimiser,
+		m_viaIR && m_optimiserSettings.lazyCalldataParameters,
+		m_modelCheckerSettings
+	};
+}
+
+bool CompilerStack::isReusedSource(Source const& _source) const
+{
+	return _source.ast && m_reusedSources.count(*_source.ast->annotation().path);
+}
+
 bool CompilerStack::parse()
 {
 	if (m_stackState != SourcesSet)
 		solThrow(CompilerError, "Must call parse only after the SourcesSet state.");
+	util::Profiler::Scope profilerScope{"parsing"};
 	m_errorReporter.clear();
 
 	if (SemVerVersion{string(VersionString)}.isPrerelease())
 		m_errorReporter.warning(3805_error, "This is a pre-release compiler version, please do not use it in production.");
 
-	Parser parser{m_errorReporter, m_evmVersion, m_parserErrorRecovery};
+	if (!m_previousSources.empty() && m_previousAnalysisSettings != analysisSettings())
+		discardPreviousAnalysis();
 
-	vector<string> sourcesToParse;
-	for (auto const& s: m_sources)
-		sourcesToParse.push_back(s.first);
+	Parser parser{m_errorReporter, m_evmVersion, m_parserErrorRecovery};
+	parser.setLastNodeID(m_lastNodeID);
 
-	for (size_t i = 0; i < sourcesToParse.size(); ++i)
+	auto resolveImportPaths = [&](string const& _path, Source& _source)
 	{
-		string const& path = sourcesToParse[i];
-		Source& source = m_sources[path];
-		source.ast = parser.parse(*source.charStream);
-		if (!source.ast)
-			solAssert(Error::containsErrors(m_errorReporter.errors()), "Parser returned null but did not report error.");
-		else
+		if (_source.ast)
 		{
-			source.ast->annotation().path = path;
+			_source.ast->annotation().path = _path;
 
-			for (auto const& import: ASTNode::filteredNodes<ImportDirective>(source.ast->nodes()))
+			for (auto const& import: ASTNode::filteredNodes<ImportDirective>(_source.ast->nodes()))
 			{
 				solAssert(!import->path().empty(), "Import path cannot be empty.");
 
@@ -361,21 +542,173 @@ bool CompilerStack::parse()
 				// as seen globally.
 				import->annotation().absolutePath = applyRemapping(util::absolutePath(
 					import->path(),
-					path
-				), path);
+					_path
+				), _path);
+			}
+		}
+	};
+	auto parseSource = [&](string const& _path, Source& _source)
+	{
+		_source.ast = parser.parse(*_source.charStream);
+		if (!_source.ast)
+			solAssert(Error::containsErrors(m_errorReporter.errors()), "Parser returned null but did not report error.");
+		resolveImportPaths(_path, _source);
+	};
+	auto reusePreviousAST = [&](string const& _path, Source& _source) -> bool
+	{
+		auto previous = m_previousSources.find(_path);
+		if (
+			previous == m_previousSources.end() ||
+			previous->second.charStream->source() != _source.charStream->source()
+		)
+			return false;
+		// Provisionally reused, confirmed below once the imports are known.
+		_source.ast = previous->second.ast;
+		m_reusedSources.insert(_path);
+		return true;
+	};
+	auto addMissingSources = [&](Source const& _source, vector<string>& _sourcesToParse, map<string, ReadCallback::Result>& _readFiles)
+	{
+		if (_source.ast && m_stopAfter >= ParsedAndImported)
+			for (auto& newSource: loadMissingSources(*_source.ast, _readFiles))
+			{
+				string const& newPath = newSource.first;
+				m_sources[newPath].charStream = make_shared<CharStream>(move(newSource.second), newPath);
+				_sourcesToParse.push_back(newPath);
+			}
+	};
+
+	vector<string> sourcesToParse;
+	for (auto const& s: m_sources)
+		sourcesToParse.push_back(s.first);
+
+	if (m_parallelism <= 1)
+		for (size_t i = 0; i < sourcesToParse.size(); ++i)
+		{
+			string const& path = sourcesToParse[i];
+			Source& source = m_sources[path];
+			if (!reusePreviousAST(path, source))
+				parseSource(path, source);
+			map<string, ReadCallback::Result> readFiles;
+			addMissingSources(source, sourcesToParse, readFiles);
+		}
+	else
+	{
+		// The sources found so far are parsed in parallel, each with its own parser and
+		// list of errors. Their results are then processed in the same order as above,
+		// which discovers the next batch of sources. The node IDs are shifted and the errors
+		// merged so that the outcome is the same as when parsing one source after another.
+		struct ParsedSource
+		{
+			ErrorList errors;
+			unique_ptr<ErrorReporter> errorReporter;
+			unique_ptr<Parser> parser;
+			future<void> done;
+		};
+		vector<ParsedSource> parsedSources;
+
+		// The pool has to be destroyed before the parsed sources, since its destructor waits for running tasks.
+		util::ThreadPool pool(m_parallelism);
+		for (size_t batchBegin = 0; batchBegin < sourcesToParse.size();)
+		{
+			size_t const batchEnd = sourcesToParse.size();
+			// All tasks of the previous batch are finished at this point.
+			parsedSources.clear();
+			parsedSources.resize(batchEnd - batchBegin);
+			for (size_t i = batchBegin; i < batchEnd; ++i)
+			{
+				Source& source = m_sources[sourcesToParse[i]];
+				if (reusePreviousAST(sourcesToParse[i], source))
+					continue;
+				ParsedSource& parsedSource = parsedSources[i - batchBegin];
+				parsedSource.errorReporter = make_unique<ErrorReporter>(parsedSource.errors);
+				parsedSource.parser = make_unique<Parser>(*parsedSource.errorReporter, m_evmVersion, m_parserErrorRecovery);
+				parsedSource.parser->enableNodeIDShifting();
+				parsedSource.done = pool.enqueue([&parsedSource, &source = source]() {
+					source.ast = parsedSource.parser->parse(*source.charStream);
+					if (!source.ast)
+						solAssert(Error::containsErrors(parsedSource.errors), "Parser returned null but did not report error.");
+				});
+			}
+
+			// The missing sources imported by the whole batch are read at once, before the
+			// sources are processed in order.
+			vector<string> importPaths;
+			for (size_t i = batchBegin; i < batchEnd; ++i)
+			{
+				string const& path = sourcesToParse[i];
+				Source& source = m_sources[path];
+				ParsedSource& parsedSource = parsedSources[i - batchBegin];
+				if (parsedSource.done.valid())
+				{
+					parsedSource.done.wait();
+					resolveImportPaths(path, source);
+				}
+				if (source.ast && m_stopAfter >= ParsedAndImported)
+					for (auto const& import: ASTNode::filteredNodes<ImportDirective>(source.ast->nodes()))
+					{
+						string const& importPath = *import->annotation().absolutePath;
+						if (!m_sources.count(importPath) && !util::contains(importPaths, importPath))
+							importPaths.push_back(importPath);
+					}
 			}
+			map<string, ReadCallback::Result> readFiles = this->readFiles(importPaths);
 
-			if (m_stopAfter >= ParsedAndImported)
-				for (auto const& newSource: loadMissingSources(*source.ast))
+			for (size_t i = batchBegin; i < batchEnd; ++i)
+			{
+				string const path = sourcesToParse[i];
+				Source& source = m_sources[path];
+				ParsedSource& parsedSource = parsedSources[i - batchBegin];
+				if (parsedSource.done.valid())
 				{
-					string const& newPath = newSource.first;
-					string const& newContents = newSource.second;
-					m_sources[newPath].charStream = make_shared<CharStream>(newContents, newPath);
-					sourcesToParse.push_back(newPath);
+					parsedSource.done.get();
+					m_errorReporter.append(parsedSource.errors);
+					parsedSource.parser->shiftNodeIDs(parser.lastNodeID());
+					parser.setLastNodeID(parser.lastNodeID() + parsedSource.parser->lastNodeID());
 				}
+				addMissingSources(source, sourcesToParse, readFiles);
+			}
+			batchBegin = batchEnd;
 		}
 	}
 
+	// A source can only be reused if everything it imports is reused as well.
+	// Otherwise it is parsed again, which does not change its imports.
+	for (bool changed = true; changed;)
+	{
+		changed = false;
+		for (auto it = m_reusedSources.begin(); it != m_reusedSources.end();)
+		{
+			Source& source = m_sources[*it];
+			bool importsChangedSource = false;
+			for (auto const& import: ASTNode::filteredNodes<ImportDirective>(source.ast->nodes()))
+				if (!m_reusedSources.count(*import->annotation().absolutePath))
+					importsChangedSource = true;
+
+			if (importsChangedSource)
+			{
+				parseSource(*it, source);
+				it = m_reusedSources.erase(it);
+				changed = true;
+			}
+			else
+				++it;
+		}
+	}
+	m_lastNodeID = parser.lastNodeID();
+
+	for (auto& [name, previous]: m_previousSources)
+		if (!m_reusedSources.count(name))
+			m_retiredASTs.emplace_back(move(previous.ast));
+	m_previousSources.clear();
+
+	ErrorList reusedDiagnostics;
+	for (shared_ptr<Error const> const& error: m_previousErrors)
+		if (m_reusedSources.count(*error->sourceLocation()->sourceName))
+			reusedDiagnostics.emplace_back(error);
+	m_errorReporter.append(reusedDiagnostics);
+	m_previousErrors.clear();
+
 	if (m_stopAfter <= Parsed)
 		m_stackState = Parsed;
 	else
@@ -393,7 +726,8 @@ void CompilerStack::importASTs(map<string, Json::Value> const& _sources)
 	if (m_stackState != Empty)
 		solThrow(CompilerError, "Must call importASTs only before the SourcesSet state.");
 	m_sourceJsons = _sources;
-	map<string, ASTPointer<SourceUnit>> reconstructedSources = ASTJsonImporter(m_evmVersion).jsonToSourceUnit(m_sourceJsons);
+	map<string, ASTPointer<SourceUnit>> reconstructedSources =
+		ASTJsonImporter(m_evmVersion).jsonToSourceUnit(m_sourceJsons, m_parallelism);
 	for (auto& src: reconstructedSources)
 	{
 		string const& path = src.first;
@@ -415,22 +749,36 @@ bool CompilerStack::analyze()
 {
 	if (m_stackState != ParsedAndImported || m_stackState >= AnalysisPerformed)
 		solThrow(CompilerError, "Must call analyze only after parsing was performed.");
+	util::Profiler::Scope profilerScope{"analysis"};
 	resolveImports();
 
+	// Sources whose analysis is reused (see updateSources()) only take part in the steps
+	// that need information about all sources.
+	auto const needsAnalysis = [&](Source const* _source) { return _source->ast && !isReusedSource(*_source); };
+	size_t const firstAnalysisDiagnostic = m_errorList.size();
+
 	for (Source const* source: m_sourceOrder)
-		if (source->ast)
+		if (needsAnalysis(source))
 			Scoper::assignScopes(*source->ast);
 
 	bool noErrors = true;
 
 	try
 	{
-		SyntaxChecker syntaxChecker(m_errorReporter, m_optimiserSettings.runYulOptimiser);
+		vector<Source const*> sourcesToAnalyse;
 		for (Source const* source: m_sourceOrder)
-			if (source->ast && !syntaxChecker.checkSyntax(*source->ast))
-				noErrors = false;
-
-		m_globalContext = make_shared<GlobalContext>();
+			if (needsAnalysis(source))
+				sourcesToAnalyse.push_back(source);
+
+		if (!checkSourcesIndependently(sourcesToAnalyse, [&](SourceUnit const& _sourceUnit, ErrorReporter& _errorReporter) {
+			return SyntaxChecker(_errorReporter, m_optimiserSettings.runYulOptimiser).checkSyntax(_sourceUnit);
+		}))
+			noErrors = false;
+
+		// The global context is kept by incremental updates, since the annotations of reused
+		// sources refer to its declarations.
+		if (!m_globalContext)
+			m_globalContext = make_shared<GlobalContext>();
 		// We need to keep the same resolver during the whole process.
 		NameAndTypeResolver resolver(*m_globalContext, m_evmVersion, m_errorReporter);
 		for (Source const* source: m_sourceOrder)
@@ -446,24 +794,28 @@ bool CompilerStack::analyze()
 
 		resolver.warnHomonymDeclarations();
 
+		if (!checkSourcesIndependently(sourcesToAnalyse, [](SourceUnit const& _sourceUnit, ErrorReporter& _errorReporter) {
+			return DocStringTagParser(_errorReporter).parseDocStrings(_sourceUnit);
+		}))
+			noErrors = false;
 		DocStringTagParser docStringTagParser(m_errorReporter);
-		for (Source const* source: m_sourceOrder)
-			if (source->ast && !docStringTagParser.parseDocStrings(*source->ast))
-				noErrors = false;
 
 		// Requires DocStringTagParser
-		for (Source const* source: m_sourceOrder)
-			if (source->ast && !resolver.resolveNamesAndTypes(*source->ast))
-				return false;
+		{
+			util::Profiler::Scope resolverScope{"name and type resolution"};
+			for (Source const* source: m_sourceOrder)
+				if (needsAnalysis(source) && !resolver.resolveNamesAndTypes(*source->ast))
+					return false;
+		}
 
 		DeclarationTypeChecker declarationTypeChecker(m_errorReporter, m_evmVersion);
 		for (Source const* source: m_sourceOrder)
-			if (source->ast && !declarationTypeChecker.check(*source->ast))
+			if (needsAnalysis(source) && !declarationTypeChecker.check(*source->ast))
 				return false;
 
 		// Requires DeclarationTypeChecker to have run
 		for (Source const* source: m_sourceOrder)
-			if (source->ast && !docStringTagParser.validateDocStringsUsingTypes(*source->ast))
+			if (needsAnalysis(source) && !docStringTagParser.validateDocStringsUsingTypes(*source->ast))
 				noErrors = false;
 
 		// Next, we check inheritance, overrides, function collisions and other things at
@@ -473,13 +825,13 @@ bool CompilerStack::analyze()
 		ContractLevelChecker contractLevelChecker(m_errorReporter);
 
 		for (Source const* source: m_sourceOrder)
-			if (auto sourceAst = source->ast)
-				noErrors = contractLevelChecker.check(*sourceAst);
+			if (needsAnalysis(source))
+				noErrors = contractLevelChecker.check(*source->ast);
 
 		// Requires ContractLevelChecker
 		DocStringAnalyser docStringAnalyser(m_errorReporter);
 		for (Source const* source: m_sourceOrder)
-			if (source->ast && !docStringAnalyser.analyseDocStrings(*source->ast))
+			if (needsAnalysis(source) && !docStringAnalyser.analyseDocStrings(*source->ast))
 				noErrors = false;
 
 		// Now we run full type checks that go down to the expression level. This
@@ -489,17 +841,20 @@ bool CompilerStack::analyze()
 		//
 		// Note: this does not resolve overloaded functions. In order to do that, types of arguments are needed,
 		// which is only done one step later.
-		TypeChecker typeChecker(m_evmVersion, m_errorReporter);
-		for (Source const* source: m_sourceOrder)
-			if (source->ast && !typeChecker.checkTypeRequirements(*source->ast))
-				noErrors = false;
+		{
+			util::Profiler::Scope typeCheckerScope{"type checking"};
+			TypeChecker typeChecker(m_evmVersion, m_errorReporter);
+			for (Source const* source: m_sourceOrder)
+				if (needsAnalysis(source) && !typeChecker.checkTypeRequirements(*source->ast))
+					noErrors = false;
+		}
 
 		if (noErrors)
 		{
 			// Checks that can only be done when all types of all AST nodes are known.
 			PostTypeChecker postTypeChecker(m_errorReporter);
 			for (Source const* source: m_sourceOrder)
-				if (source->ast && !postTypeChecker.check(*source->ast))
+				if (needsAnalysis(source) && !postTypeChecker.check(*source->ast))
 					noErrors = false;
 			if (!postTypeChecker.finalize())
 				noErrors = false;
@@ -514,14 +869,16 @@ bool CompilerStack::analyze()
 
 		if (noErrors)
 			for (Source const* source: m_sourceOrder)
-				if (source->ast && !PostTypeContractLevelChecker{m_errorReporter}.check(*source->ast))
-					noErrors = false;
+				if (needsAnalysis(source))
+					for (ContractDefinition const* contract: ASTNode::filteredNodes<ContractDefinition>(source->ast->nodes()))
+						if (isAnalysedContract(*contract) && !PostTypeContractLevelChecker{m_errorReporter}.check(*contract))
+							noErrors = false;
 
 		// Check that immutable variables are never read in c'tors and assigned
 		// exactly once
 		if (noErrors)
 			for (Source const* source: m_sourceOrder)
-				if (source->ast)
+				if (needsAnalysis(source))
 					for (ASTPointer<ASTNode> const& node: source->ast->nodes())
 						if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
 							ImmutableValidator(m_errorReporter, *contract).analyze();
@@ -530,10 +887,28 @@ bool CompilerStack::analyze()
 		{
 			// Control flow graph generator and analyzer. It can check for issues such as
 			// variable is used before it is assigned to.
+			util::Profiler::Scope controlFlowScope{"control flow analysis"};
 			CFG cfg(m_errorReporter);
 			for (Source const* source: m_sourceOrder)
-				if (source->ast && !cfg.constructFlow(*source->ast))
-					noErrors = false;
+				if (source->ast)
+				{
+					if (!m_analyzeOnlyRequestedContracts)
+					{
+						if (!cfg.constructFlow(*source->ast))
+							noErrors = false;
+						continue;
+					}
+					// The flow of each contract covers the functions it inherits. Libraries are
+					// always included, since the functions of analysed contracts can call them.
+					for (ASTPointer<ASTNode> const& node: source->ast->nodes())
+					{
+						auto const* contract = dynamic_cast<ContractDefinition const*>(node.get());
+						if (contract && !contract->isLibrary() && !isAnalysedContract(*contract))
+							continue;
+						if (!cfg.constructFlow(*node))
+							noErrors = false;
+					}
+				}
 
 			if (noErrors)
 			{
@@ -551,7 +926,7 @@ bool CompilerStack::analyze()
 			// Checks for common mistakes. Only generates warnings.
 			StaticAnalyzer staticAnalyzer(m_errorReporter);
 			for (Source const* source: m_sourceOrder)
-				if (source->ast && !staticAnalyzer.analyze(*source->ast))
+				if (needsAnalysis(source) && !staticAnalyzer.analyze(*source->ast))
 					noErrors = false;
 		}
 
@@ -559,24 +934,48 @@ bool CompilerStack::analyze()
 		{
 			// Check for state mutability in every function.
 			vector<ASTPointer<ASTNode>> ast;
-			for (Source const* source: m_sourceOrder)
-				if (source->ast)
-					ast.push_back(source->ast);
+			if (!m_analyzeOnlyRequestedContracts)
+			{
+				for (Source const* source: m_sourceOrder)
+					if (source->ast)
+						ast.push_back(source->ast);
+			}
+			else
+			{
+				// Functions are checked where they are defined, so the bases of analysed
+				// contracts and all libraries have to be checked, too.
+				set<ContractDefinition const*> checkedContracts;
+				for (Source const* source: m_sourceOrder)
+					if (source->ast)
+						for (ContractDefinition const* contract: ASTNode::filteredNodes<ContractDefinition>(source->ast->nodes()))
+							if (contract->isLibrary() || isAnalysedContract(*contract))
+								checkedContracts += contract->annotation().linearizedBaseContracts;
+				for (Source const* source: m_sourceOrder)
+					if (source->ast)
+						for (ASTPointer<ASTNode> const& node: source->ast->nodes())
+						{
+							auto const* contract = dynamic_cast<ContractDefinition const*>(node.get());
+							if (!contract || checkedContracts.count(contract))
+								ast.push_back(node);
+						}
+			}
 
 			if (!ViewPureChecker(ast, m_errorReporter).check())
 				noErrors = false;
 		}
 
+		if (noErrors && m_viaIR && m_optimiserSettings.lazyCalldataParameters)
+			// Changes the types of parameters, so it has to run after all checks.
+			for (Source const* source: m_sourceOrder)
+				if (needsAnalysis(source))
+					CalldataParameterRewriter::run(*source->ast);
+
 		if (noErrors)
 		{
-			ModelChecker modelChecker(m_errorReporter, *this, m_smtlib2Responses, m_modelCheckerSettings, m_readFile);
-			auto allSources = applyMap(m_sourceOrder, [](Source const* _source) { return _source->ast; });
-			modelChecker.enableAllEnginesIfPragmaPresent(allSources);
-			modelChecker.checkRequestedSourcesAndContracts(allSources);
-			for (Source const* source: m_sourceOrder)
-				if (source->ast)
-					modelChecker.analyze(*source->ast);
-			m_unhandledSMTLib2Queries += modelChecker.unhandledQueries();
+			if (m_deferModelChecking)
+				m_modelCheckingPending = true;
+			else
+				runModelChecker();
 		}
 	}
 	catch (FatalError const&)
@@ -586,6 +985,21 @@ bool CompilerStack::analyze()
 		noErrors = false;
 	}
 
+	if (!m_reusedSources.empty())
+		// parse() restored the diagnostics of reused sources, drop the ones reported again
+		// by the steps that run on all sources.
+		m_errorList.erase(
+			remove_if(
+				m_errorList.begin() + static_cast<ptrdiff_t>(firstAnalysisDiagnostic),
+				m_errorList.end(),
+				[&](shared_ptr<Error const> const& _error) {
+					SourceLocation const* location = _error->sourceLocation();
+					return location && location->sourceName && m_reusedSources.count(*location->sourceName);
+				}
+			),
+			m_errorList.end()
+		);
+
 	m_stackState = AnalysisPerformed;
 	if (!noErrors)
 		m_hasError = true;
@@ -593,6 +1007,95 @@ bool CompilerStack::analyze()
 	return !m_hasError;
 }
 
+void CompilerStack::runModelChecker()
+{
+	util::Profiler::Scope modelCheckerScope{"model checking"};
+	ModelChecker modelChecker(
+		m_errorReporter,
+		*this,
+		m_smtlib2Responses,
+		m_modelCheckerSettings,
+		m_readFile,
+		m_parallelism,
+		m_artifactCache
+	);
+	auto allSources = applyMap(m_sourceOrder, [](Source const* _source) { return _source->ast; });
+	modelChecker.enableAllEnginesIfPragmaPresent(allSources);
+	modelChecker.checkRequestedSourcesAndContracts(allSources);
+	for (Source const* source: m_sourceOrder)
+		if (source->ast && !isReusedSource(*source))
+			modelChecker.analyze(*source->ast);
+	m_unhandledSMTLib2Queries += modelChecker.unhandledQueries();
+}
+
+bool CompilerStack::runPendingModelChecker()
+{
+	if (!m_modelCheckingPending)
+		return true;
+	m_modelCheckingPending = false;
+
+	unsigned const errorsBefore = m_errorReporter.errorCount();
+	try
+	{
+		runModelChecker();
+	}
+	catch (FatalError const&)
+	{
+		if (m_errorReporter.errors().empty())
+			throw; // Something is weird here, rather throw again.
+		return false;
+	}
+	return m_errorReporter.errorCount() == errorsBefore;
+}
+
+bool CompilerStack::checkSourcesIndependently(
+	vector<Source const*> const& _sources,
+	function<bool(SourceUnit const&, ErrorReporter&)> const& _check
+)
+{
+	bool success = true;
+	if (m_parallelism <= 1 || _sources.size() <= 1)
+	{
+		for (Source const* source: _sources)
+			if (!_check(*source->ast, m_errorReporter))
+				success = false;
+		return success;
+	}
+
+	struct Check
+	{
+		ErrorList errors;
+		unique_ptr<ErrorReporter> errorReporter;
+		bool success = false;
+		exception_ptr failure;
+	};
+	vector<Check> checks(_sources.size());
+
+	util::parallelFor(_sources.size(), m_parallelism, [&](size_t _i) {
+		Check& check = checks[_i];
+		check.errorReporter = make_unique<ErrorReporter>(check.errors);
+		try
+		{
+			check.success = _check(*_sources[_i]->ast, *check.errorReporter);
+		}
+		catch (...)
+		{
+			check.failure = current_exception();
+		}
+	});
+
+	for (Check& check: checks)
+	{
+		// Only rethrow the exceptions of a check (like FatalError) once its diagnostics are reported.
+		m_errorReporter.append(check.errors);
+		if (check.failure)
+			rethrow_exception(check.failure);
+		if (!check.success)
+			success = false;
+	}
+	return success;
+}
+
 bool CompilerStack::parseAndAnalyze(State _stopAfter)
 {
 	m_stopAfter = _stopAfter;
@@ -634,8 +1137,21 @@ bool CompilerStack::compile(State _stopAfter)
 {
 	m_stopAfter = _stopAfter;
 	if (m_stackState < AnalysisPerformed)
+	{
+		// The model checker only reports warnings and does not change what the code generators
+		// depend on, so in the parallel pipeline it runs while the IR is optimised and assembled.
+		m_deferModelChecking =
+			m_viaIR &&
+			m_generateEvmBytecode &&
+			m_parallelism > 1 &&
+			_stopAfter >= CompilationSuccessful;
+		ScopeGuard resetDeferModelChecking{[&]() { m_deferModelChecking = false; }};
 		if (!parseAndAnalyze(_stopAfter))
+		{
+			m_modelCheckingPending = false;
 			return false;
+		}
+	}
 
 	if (m_stackState >= m_stopAfter)
 		return true;
@@ -644,62 +1160,165 @@ bool CompilerStack::compile(State _stopAfter)
 		solThrow(CompilerError, "Called compile with errors.");
 
 	// Only compile contracts individually which have been requested.
-	map<ContractDefinition const*, shared_ptr<Compiler const>> otherCompilers;
-
+	vector<ContractDefinition const*> requestedContracts;
 	for (Source const* source: m_sourceOrder)
 		for (ASTPointer<ASTNode> const& node: source->ast->nodes())
 			if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
 				if (isRequestedContract(*contract))
+					requestedContracts.push_back(contract);
+
+	// The code of contracts created by other contracts is embedded into the IR of the creating
+	// contract, so the same Yul objects are optimised several times.
+	if (m_optimiserSettings.runYulOptimiser)
+		m_optimisedCodeCache = make_shared<yul::OptimisedCodeCache>();
+	ScopeGuard releaseOptimisedCodeCache{[&]() { m_optimisedCodeCache.reset(); }};
+	// The utility functions of the IR are generated once and reused by all contracts.
+	if (m_viaIR || m_generateIR)
+		m_sharedYulFunctions = make_shared<SharedYulFunctions>();
+	ScopeGuard releaseSharedYulFunctions{[&]() { m_sharedYulFunctions.reset(); }};
+	// Contracts that were only generated as dependencies keep their parsed IR until now.
+	ScopeGuard releaseIRStacks{[&]() {
+		for (auto& pair: m_contracts)
+			pair.second.yulIRStack.reset();
+	}};
+
+	if (m_viaIR && m_generateEvmBytecode && m_parallelism > 1 && requestedContracts.size() > 1)
+	{
+		if (!compileViaIRInParallel(requestedContracts))
+			return false;
+	}
+	else
+	{
+		if (!runPendingModelChecker())
+		{
+			m_hasError = true;
+			return false;
+		}
+		map<ContractDefinition const*, shared_ptr<Compiler const>> otherCompilers;
+		for (ContractDefinition const* contract: requestedContracts)
+			if (!reportingCodeGenerationErrors([&]() {
+				if (m_viaIR || m_generateIR || m_generateEwasm)
+					generateIR(*contract);
+				if (m_generateEvmBytecode)
 				{
-					try
-					{
-						if (m_viaIR || m_generateIR || m_generateEwasm)
-							generateIR(*contract);
-						if (m_generateEvmBytecode)
-						{
-							if (m_viaIR)
-								generateEVMFromIR(*contract);
-							else
-								compileContract(*contract, otherCompilers);
-						}
-						if (m_generateEwasm)
-							generateEwasm(*contract);
-					}
-					catch (Error const& _error)
-					{
-						if (_error.type() != Error::Type::CodeGenerationError)
-							throw;
-						m_errorReporter.error(_error.errorId(), _error.type(), SourceLocation(), _error.what());
-						return false;
-					}
-					catch (UnimplementedFeatureError const& _unimplementedError)
-					{
-						if (
-							SourceLocation const* sourceLocation =
-							boost::get_error_info<langutil::errinfo_sourceLocation>(_unimplementedError)
-						)
-						{
-							string const* comment = _unimplementedError.comment();
-							m_errorReporter.error(
-								1834_error,
-								Error::Type::CodeGenerationError,
-								*sourceLocation,
-								"Unimplemented feature error" +
-								((comment && !comment->empty()) ? ": " + *comment : string{}) +
-								" in " +
-								_unimplementedError.lineInfo()
-							);
-							return false;
-						}
-						else
-							throw;
-					}
+					if (m_viaIR)
+						generateEVMFromIR(*contract);
+					else
+						compileContract(*contract, otherCompilers);
 				}
+				if (m_generateEwasm)
+					generateEwasm(*contract);
+			}))
+				return false;
+	}
 	m_stackState = CompilationSuccessful;
 	this->link();
 	return true;
 }
 
+bool CompilerStack::reportingCodeGenerationErrors(function<void()> const& _step)
+{
+	try
+	{
+		_step();
+	}
+	catch (Error const& _error)
+	{
+		if (_error.type() != Error::Type::CodeGenerationError)
+			throw;
+		m_errorReporter.error(_error.errorId(), _error.type(), SourceLocation(), _error.what());
+		return false;
+	}
+	catch (UnimplementedFeatureError const& _unimplementedError)
+	{
+		if (
+			SourceLocation const* sourceLocation =
+			boost::get_error_info<langutil::errinfo_sourceLocation>(_unimplementedError)
+		)
+		{
+			string const* comment = _unimplementedError.comment();
+			m_errorReporter.error(
+				1834_error,
+				Error::Type::CodeGenerationError,
+				*sourceLocation,
+				"Unimplemented feature error" +
+				((comment && !comment->empty()) ? ": " + *comment : string{}) +
+				" in " +
+				_unimplementedError.lineInfo()
+			);
+			return false;
+		}
+		else
+			throw;
+	}
+	return true;
+}
+
+bool CompilerStack::compileViaIRInParallel(vector<ContractDefinition const*> const& _contracts)
+{
+	solAssert(m_viaIR && m_generateEvmBytecode, "");
+
+	struct Job
+	{
+		ContractDefinition const* contract = nullptr;
+		/// Diagnostics reported while generating the IR of the contract.
+		ErrorList irDiagnostics;
+		/// Exception thrown while generating the IR of the contract, if any.
+		exception_ptr irFailure;
+		future<void> evmAssembly;
+	};
+	vector<Job> jobs;
+
+	// The pool has to be destroyed before the jobs, since its destructor waits for running tasks.
+	util::ThreadPool pool(m_parallelism);
+	for (ContractDefinition const* contract: _contracts)
+	{
+		Job& job = jobs.emplace_back();
+		job.contract = contract;
+		size_t const diagnosticsBefore = m_errorList.size();
+		try
+		{
+			generateIR(*contract);
+		}
+		catch (...)
+		{
+			job.irFailure = current_exception();
+		}
+		// Diagnostics are re-reported in order once the previous contracts are finished.
+		job.irDiagnostics.assign(m_errorList.begin() + static_cast<ptrdiff_t>(diagnosticsBefore), m_errorList.end());
+		m_errorList.resize(diagnosticsBefore);
+		if (job.irFailure)
+			break;
+		job.evmAssembly = pool.enqueue([this, contract]() { generateEVMAssemblyFromIR(*contract); });
+	}
+
+	// Model checking was deferred until the IR of all contracts was generated. Errors it reports
+	// still prevent the output of all contracts, which is only marked once the jobs are finished.
+	if (!runPendingModelChecker())
+	{
+		for (Job& job: jobs)
+			if (job.evmAssembly.valid())
+				job.evmAssembly.wait();
+		m_hasError = true;
+		return false;
+	}
+
+	for (Job& job: jobs)
+	{
+		m_errorReporter.append(job.irDiagnostics);
+		if (!reportingCodeGenerationErrors([&]() {
+			if (job.irFailure)
+				rethrow_exception(job.irFailure);
+			job.evmAssembly.get();
+			generateEVMFromIR(*job.contract);
+			if (m_generateEwasm)
+				generateEwasm(*job.contract);
+		}))
+			return false;
+	}
+	return true;
+}
+
 void CompilerStack::link()
 {
 	solAssert(m_stackState >= CompilationSuccessful, "");
@@ -720,6 +1339,37 @@ vector<string> CompilerStack::contractNames() const
 	return contractNames;
 }
 
+void CompilerStack::releaseContract(string const& _contractName)
+{
+	// The results are only stored once the sources are analysed.
+	if (m_stackState < AnalysisPerformed)
+		return;
+
+	Contract& released = m_contracts.at(contract(_contractName).contract->fullyQualifiedName());
+	released.compiler.reset();
+	released.evmAssembly.reset();
+	released.evmRuntimeAssembly.reset();
+	released.object = {};
+	released.runtimeObject = {};
+	released.yulIR = string();
+	released.yulIROptimized = string();
+	released.yulIRStack.reset();
+	released.yulIRForEVM = string();
+	released.ewasm = string();
+	released.ewasmObject = {};
+	released.metadata = {};
+	released.abi = {};
+	released.storageLayout = {};
+	released.userDocumentation = {};
+	released.devDocumentation = {};
+	released.generatedSources = {};
+	released.runtimeGeneratedSources = {};
+	released.gasEstimates = {};
+	released.sourceMapping.reset();
+	released.runtimeSourceMapping.reset();
+	released.released = true;
+}
+
 string const CompilerStack::lastContractName(optional<string> const& _sourceName) const
 {
 	if (m_stackState < AnalysisPerformed)
@@ -1052,6 +1702,11 @@ CharStream const& CompilerStack::charStream(string const& _sourceName) const
 	return *source(_sourceName).charStream;
 }
 
+bool CompilerStack::isReusedSource(string const& _sourceName) const
+{
+	return m_reusedSources.count(_sourceName) != 0;
+}
+
 SourceUnit const& CompilerStack::ast(string const& _sourceName) const
 {
 	if (m_stackState < Parsed)
@@ -1106,9 +1761,39 @@ string const& CompilerStack::Source::ipfsUrl() const
 	return ipfsUrlCached;
 }
 
-StringMap CompilerStack::loadMissingSources(SourceUnit const& _ast)
+Json::Value CompilerStack::Source::metadataEntry(bool _literalContent) const
+{
+	if (!_literalContent && !metadataEntryCached.isNull())
+		return metadataEntryCached;
+
+	Json::Value entry{Json::objectValue};
+	entry["keccak256"] = "0x" + toHex(keccak256().asBytes());
+	if (optional<string> licenseString = ast->licenseString())
+		entry["license"] = *licenseString;
+	if (_literalContent)
+	{
+		entry["content"] = charStream->source();
+		return entry;
+	}
+	entry["urls"] = Json::arrayValue;
+	entry["urls"].append("bzz-raw://" + toHex(swarmHash().asBytes()));
+	entry["urls"].append(ipfsUrl());
+	metadataEntryCached = entry;
+	return entry;
+}
+
+StringMap CompilerStack::loadMissingSources(SourceUnit const& _ast, map<string, ReadCallback::Result>& _readFiles)
 {
 	solAssert(m_stackState < ParsedAndImported, "");
+	vector<string> unreadPaths;
+	for (auto const& import: ASTNode::filteredNodes<ImportDirective>(_ast.nodes()))
+	{
+		string const& importPath = *import->annotation().absolutePath;
+		if (!m_sources.count(importPath) && !_readFiles.count(importPath) && !util::contains(unreadPaths, importPath))
+			unreadPaths.push_back(importPath);
+	}
+	_readFiles.merge(readFiles(unreadPaths));
+
 	StringMap newSources;
 	try
 	{
@@ -1120,12 +1805,9 @@ StringMap CompilerStack::loadMissingSources(SourceUnit const& _ast)
 				if (m_sources.count(importPath) || newSources.count(importPath))
 					continue;
 
-				ReadCallback::Result result{false, string("File not supplied initially.")};
-				if (m_readFile)
-					result = m_readFile(ReadCallback::kindString(ReadCallback::Kind::ReadFile), importPath);
-
+				ReadCallback::Result& result = _readFiles.at(importPath);
 				if (result.success)
-					newSources[importPath] = result.responseOrErrorMessage;
+					newSources[importPath] = move(result.responseOrErrorMessage);
 				else
 				{
 					m_errorReporter.parserError(
@@ -1144,6 +1826,31 @@ StringMap CompilerStack::loadMissingSources(SourceUnit const& _ast)
 	return newSources;
 }
 
+map<string, ReadCallback::Result> CompilerStack::readFiles(vector<string> const& _paths)
+{
+	map<string, ReadCallback::Result> results;
+	if (_paths.empty())
+		return results;
+
+	string const kind = ReadCallback::kindString(ReadCallback::Kind::ReadFile);
+	if (m_batchReadFile)
+	{
+		vector<ReadCallback::Result> batchResults = m_batchReadFile(kind, _paths);
+		for (size_t i = 0; i < _paths.size(); ++i)
+			if (i < batchResults.size())
+				results.emplace(_paths[i], move(batchResults[i]));
+			else
+				results.emplace(_paths[i], ReadCallback::Result{false, "No result returned by the batch read callback."});
+	}
+	else
+		for (string const& path: _paths)
+			results.emplace(
+				path,
+				m_readFile ? m_readFile(kind, path) : ReadCallback::Result{false, "File not supplied initially."}
+			);
+	return results;
+}
+
 string CompilerStack::applyRemapping(string const& _path, string const& _context)
 {
 	solAssert(m_stackState < ParsedAndImported, "");
@@ -1276,6 +1983,8 @@ void CompilerStack::compileContract(
 	if (m_hasError)
 		solThrow(CompilerError, "Called compile with errors.");
 
+	util::Profiler::Scope profilerScope{"EVM code generation"};
+
 	if (_otherCompilers.count(&_contract))
 		return;
 
@@ -1287,7 +1996,7 @@ void CompilerStack::compileContract(
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
 
-	shared_ptr<Compiler> compiler = make_shared<Compiler>(m_evmVersion, m_revertStrings, m_optimiserSettings);
+	shared_ptr<Compiler> compiler = make_shared<Compiler>(m_evmVersion, m_revertStrings, optimiserSettings(_contract));
 	compiledContract.compiler = compiler;
 
 	solAssert(!m_viaIR, "");
@@ -1314,6 +2023,8 @@ void CompilerStack::generateIR(ContractDefinition const& _contract)
 	if (m_hasError)
 		solThrow(CompilerError, "Called generateIR with errors.");
 
+	util::Profiler::Scope profilerScope{"IR generation"};
+
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
 	if (!compiledContract.yulIR.empty())
 		return;
@@ -1333,16 +2044,146 @@ void CompilerStack::generateIR(ContractDefinition const& _contract)
 	if (!_contract.canBeDeployed())
 		return;
 
+	optional<h256> cacheKey;
+	if (m_artifactCache)
+	{
+		cacheKey = irCacheKey(compiledContract);
+		if (optional<string> artifact = m_artifactCache->load(*cacheKey))
+		{
+			Json::Value cached;
+			if (
+				util::jsonParseStrict(*artifact, cached) &&
+				cached.isObject() &&
+				cached["ir"].isString() &&
+				cached["irOptimized"].isString()
+			)
+			{
+				compiledContract.yulIR = cached["ir"].asString();
+				compiledContract.yulIROptimized = cached["irOptimized"].asString();
+				if (m_viaIR && m_generateEvmBytecode)
+					loadOptimizedIR(compiledContract);
+				return;
+			}
+		}
+	}
+
 	map<ContractDefinition const*, string_view const> otherYulSources;
 	for (auto const& pair: m_contracts)
 		otherYulSources.emplace(pair.second.contract, pair.second.yulIR);
 
-	IRGenerator generator(m_evmVersion, m_revertStrings, m_optimiserSettings, sourceIndices(), m_debugInfoSelection, this);
-	tie(compiledContract.yulIR, compiledContract.yulIROptimized) = generator.run(
-		_contract,
-		createCBORMetadata(compiledContract, /* _forIR */ true),
-		otherYulSources
+	IRGenerator generator(
+		m_evmVersion,
+		m_revertStrings,
+		optimiserSettings(_contract),
+		sourceIndices(),
+		generatedDebugInfo(),
+		this,
+		m_optimisedCodeCache,
+		m_sharedYulFunctions,
+		m_parallelism
 	);
+	bytes const cborMetadata = createCBORMetadata(compiledContract, /* _forIR */ true);
+	// EVM code is generated from the parsed IR directly, which is only printed if it was requested.
+	if (m_viaIR && m_generateEvmBytecode)
+	{
+		compiledContract.yulIR = generator.runUnoptimized(_contract, cborMetadata, otherYulSources);
+		// Settings that only affect the metadata do not require optimizing the IR again.
+		if (!m_artifactCache || !loadOptimizedIR(compiledContract))
+		{
+			compiledContract.yulIRStack = generator.parseAndOptimize(compiledContract.yulIR);
+			if (m_generateIR || m_generateEwasm || cacheKey)
+				compiledContract.yulIROptimized =
+					IRGenerator::irWarning() + compiledContract.yulIRStack->print(this);
+		}
+	}
+	else
+		tie(compiledContract.yulIR, compiledContract.yulIROptimized) =
+			generator.run(_contract, cborMetadata, otherYulSources);
+
+	if (cacheKey)
+	{
+		Json::Value artifact{Json::objectValue};
+		artifact["ir"] = compiledContract.yulIR;
+		artifact["irOptimized"] = compiledContract.yulIROptimized;
+		m_artifactCache->store(*cacheKey, util::jsonCompactPrint(artifact));
+	}
+}
+
+DebugInfoSelection CompilerStack::generatedDebugInfo() const
+{
+	// Without any annotations, the IR generator does not have to format the source locations and
+	// the Yul parser does not have to parse them and attach them to the nodes of the code.
+	if (!m_generateDebugInfo && !m_generateIR && !m_generateEwasm)
+		return DebugInfoSelection::None();
+	return m_debugInfoSelection;
+}
+
+h256 CompilerStack::irCacheKey(Contract const& _contract) const
+{
+	// The metadata covers the sources and all settings that affect the generated code,
+	// apart from the ones that only influence debug annotations and the metadata encoding.
+	string key = "ir\n" + createMetadata(_contract, /* _forIR */ true) + "\n";
+	key += util::toString(generatedDebugInfo()) + "\n";
+	key += to_string(static_cast<unsigned>(m_metadataFormat)) + "\n";
+	for (auto const& [sourceName, index]: sourceIndices())
+		key += to_string(index) + ":" + sourceName + "\n";
+	return util::keccak256(key);
+}
+
+h256 CompilerStack::optimizedIRCacheKey(ContractDefinition const& _contract, string const& _irWithoutMetadata) const
+{
+	// The optimizer does not look at the contents of data objects, so apart from the code only
+	// the settings of the Yul optimizer and the ones affecting how the code is printed matter.
+	OptimiserSettings const settings = optimiserSettings(_contract);
+	string key = "irOptimized\n" + m_evmVersion.name() + "\n";
+	key += util::toString(generatedDebugInfo()) + "\n";
+	key += (settings.runYulOptimiser ? "yul\n" : "\n");
+	key += (settings.optimizeStackAllocation ? "stackAllocation\n" : "\n");
+	key += settings.yulOptimiserSteps + "\n";
+	key += (settings.yulOptimiserStepBudget ? to_string(*settings.yulOptimiserStepBudget) : "") + "\n";
+	key += to_string(settings.yulOptimiserAutotuneCandidates) + "\n";
+	key += (settings.selectYulOptimiserSteps ? "selectSteps\n" : "\n");
+	key += to_string(settings.expectedExecutionsPerDeployment) + "\n";
+	// The printed code contains snippets of the sources.
+	for (auto const& [sourceName, index]: sourceIndices())
+		if (m_sources.count(sourceName))
+			key += to_string(index) + ":" + m_sources.at(sourceName).keccak256().hex() + "\n";
+	key += _irWithoutMetadata;
+	return util::keccak256(key);
+}
+
+bool CompilerStack::loadOptimizedIR(Contract& _contract)
+{
+	solAssert(m_artifactCache, "");
+	solAssert(!_contract.yulIR.empty(), "");
+
+	string irWithoutMetadata = _contract.yulIR;
+	vector<string> const metadata = removeMetadata(irWithoutMetadata);
+	_contract.optimizedIRCacheKey = optimizedIRCacheKey(*_contract.contract, irWithoutMetadata);
+
+	optional<string> artifact = m_artifactCache->load(*_contract.optimizedIRCacheKey);
+	Json::Value cached;
+	if (
+		!artifact ||
+		!util::jsonParseStrict(*artifact, cached) ||
+		!cached.isObject() ||
+		!cached["irOptimized"].isString() ||
+		!cached["evm"].isString()
+	)
+		return false;
+
+	optional<string> irOptimized = insertMetadata(cached["irOptimized"].asString(), metadata);
+	optional<string> irForEVM = insertMetadata(cached["evm"].asString(), metadata);
+	if (!irOptimized || !irForEVM)
+		return false;
+	_contract.yulIROptimized = move(*irOptimized);
+	_contract.yulIRForEVM = move(*irForEVM);
+	return true;
+}
+
+OptimiserSettings CompilerStack::optimiserSettings(ContractDefinition const& _contract) const
+{
+	return m_optimiserSettings.forContract(_contract.sourceUnitName(), _contract.name());
 }
 
 void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
@@ -1351,30 +2192,86 @@ void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
 	if (m_hasError)
 		solThrow(CompilerError, "Called generateEVMFromIR with errors.");
 
+	util::Profiler::Scope profilerScope{"EVM code generation"};
+
 	if (!_contract.canBeDeployed())
 		return;
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
-	solAssert(!compiledContract.yulIROptimized.empty(), "");
+	solAssert(
+		!compiledContract.yulIROptimized.empty() ||
+		!compiledContract.yulIRForEVM.empty() ||
+		compiledContract.yulIRStack,
+		""
+	);
 	if (!compiledContract.object.bytecode.empty())
 		return;
 
-	// Re-parse the Yul IR in EVM dialect
-	yul::AssemblyStack stack(
-		m_evmVersion,
-		yul::AssemblyStack::Language::StrictAssembly,
-		m_optimiserSettings,
-		m_debugInfoSelection
-	);
-	stack.parseAndAnalyze("", compiledContract.yulIROptimized);
-	stack.optimize();
+	if (!compiledContract.evmAssembly)
+		generateEVMAssemblyFromIR(_contract, m_parallelism);
+	assemble(_contract, compiledContract.evmAssembly, compiledContract.evmRuntimeAssembly);
+}
 
-	//cout << yul::AsmPrinter{}(*stack.parserResult()->code) << endl;
+void CompilerStack::generateEVMAssemblyFromIR(ContractDefinition const& _contract, size_t _parallelism)
+{
+	solAssert(m_stackState >= AnalysisPerformed, "");
+	if (m_hasError)
+		solThrow(CompilerError, "Called generateEVMAssemblyFromIR with errors.");
+
+	util::Profiler::Scope profilerScope{"EVM assembly from IR"};
+
+	if (!_contract.canBeDeployed())
+		return;
+
+	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
+
+	auto parseIR = [&](string const& _ir) {
+		auto stack = make_shared<yul::AssemblyStack>(
+			m_evmVersion,
+			yul::AssemblyStack::Language::StrictAssembly,
+			optimiserSettings(_contract),
+			generatedDebugInfo()
+		);
+		stack->parseAndAnalyze("", _ir);
+		return stack;
+	};
+
+	shared_ptr<yul::AssemblyStack> stack;
+	if (!compiledContract.yulIRForEVM.empty())
+		// Taken from the artifact cache, so it does not have to be optimized again.
+		stack = parseIR(compiledContract.yulIRForEVM);
+	else
+	{
+		// Use the parsed IR of the IR generator if it was kept, re-parse the Yul IR in EVM dialect otherwise.
+		stack = move(compiledContract.yulIRStack);
+		if (!stack)
+		{
+			solAssert(!compiledContract.yulIROptimized.empty(), "");
+			stack = parseIR(compiledContract.yulIROptimized);
+		}
+		stack->setOptimisedCodeCache(m_optimisedCodeCache);
+		stack->setParallelism(_parallelism);
+		stack->optimize();
+
+		if (compiledContract.optimizedIRCacheKey)
+		{
+			solAssert(m_artifactCache, "");
+			string irOptimized = compiledContract.yulIROptimized;
+			string irForEVM = stack->print(this);
+			removeMetadata(irOptimized);
+			removeMetadata(irForEVM);
+			Json::Value artifact{Json::objectValue};
+			artifact["irOptimized"] = move(irOptimized);
+			artifact["evm"] = move(irForEVM);
+			m_artifactCache->store(*compiledContract.optimizedIRCacheKey, util::jsonCompactPrint(artifact));
+		}
+	}
+
+	//cout << yul::AsmPrinter{}(*stack->parserResult()->code) << endl;
 
 	string deployedName = IRNames::deployedObject(_contract);
 	solAssert(!deployedName.empty(), "");
-	tie(compiledContract.evmAssembly, compiledContract.evmRuntimeAssembly) = stack.assembleEVMWithDeployed(deployedName);
-	assemble(_contract, compiledContract.evmAssembly, compiledContract.evmRuntimeAssembly);
+	tie(compiledContract.evmAssembly, compiledContract.evmRuntimeAssembly) = stack->assembleEVMWithDeployed(deployedName);
 }
 
 void CompilerStack::generateEwasm(ContractDefinition const& _contract)
@@ -1383,6 +2280,8 @@ void CompilerStack::generateEwasm(ContractDefinition const& _contract)
 	if (m_hasError)
 		solThrow(CompilerError, "Called generateEwasm with errors.");
 
+	util::Profiler::Scope profilerScope{"Ewasm code generation"};
+
 	if (!_contract.canBeDeployed())
 		return;
 
@@ -1395,10 +2294,13 @@ void CompilerStack::generateEwasm(ContractDefinition const& _contract)
 	yul::AssemblyStack stack(
 		m_evmVersion,
 		yul::AssemblyStack::Language::StrictAssembly,
-		m_optimiserSettings,
-		m_debugInfoSelection
+		optimiserSettings(_contract),
+		generatedDebugInfo()
 	);
 	stack.parseAndAnalyze("", compiledContract.yulIROptimized);
+	// The contracts are translated one after the other, so the functions of the translated code
+	// and the polyfill can use all threads.
+	stack.setParallelism(m_parallelism);
 
 	stack.optimize();
 	stack.translate(yul::AssemblyStack::Language::Ewasm);
@@ -1416,9 +2318,15 @@ CompilerStack::Contract const& CompilerStack::contract(string const& _contractNa
 {
 	solAssert(m_stackState >= AnalysisPerformed, "");
 
+	auto checkNotReleased = [&](Contract const& _contract) -> Contract const& {
+		if (_contract.released)
+			solThrow(CompilerError, "The results of contract \"" + _contractName + "\" were released.");
+		return _contract;
+	};
+
 	auto it = m_contracts.find(_contractName);
 	if (it != m_contracts.end())
-		return it->second;
+		return checkNotReleased(it->second);
 
 	// To provide a measure of backward-compatibility, if a contract is not located by its
 	// fully-qualified name, a lookup will be attempted purely on the contract's name to see
@@ -1435,7 +2343,7 @@ CompilerStack::Contract const& CompilerStack::contract(string const& _contractNa
 			getline(ss, source, ':');
 			getline(ss, foundName, ':');
 			if (foundName == _contractName)
-				return contractEntry.second;
+				return checkNotReleased(contractEntry.second);
 		}
 	}
 
@@ -1466,37 +2374,58 @@ string CompilerStack::createMetadata(Contract const& _contract, bool _forIR) con
 		referencedSources.insert(*sourceUnit->annotation().path);
 
 	meta["sources"] = Json::objectValue;
-	for (auto const& s: m_sources)
+	for (string const& sourceName: referencedSources)
 	{
-		if (!referencedSources.count(s.first))
-			continue;
-
-		solAssert(s.second.charStream, "Character stream not available");
-		meta["sources"][s.first]["keccak256"] = "0x" + toHex(s.second.keccak256().asBytes());
-		if (optional<string> licenseString = s.second.ast->licenseString())
-			meta["sources"][s.first]["license"] = *licenseString;
-		if (m_metadataLiteralSources)
-			meta["sources"][s.first]["content"] = s.second.charStream->source();
-		else
-		{
-			meta["sources"][s.first]["urls"] = Json::arrayValue;
-			meta["sources"][s.first]["urls"].append("bzz-raw://" + toHex(s.second.swarmHash().asBytes()));
-			meta["sources"][s.first]["urls"].append(s.second.ipfsUrl());
-		}
+		Source const& source = m_sources.at(sourceName);
+		solAssert(source.charStream, "Character stream not available");
+		meta["sources"][sourceName] = source.metadataEntry(m_metadataLiteralSources);
 	}
 
+	meta["settings"] = metadataSettings(_forIR);
+	meta["settings"]["compilationTarget"][_contract.contract->sourceUnitName()] =
+		*_contract.contract->annotation().canonicalName;
+
+	meta["output"]["abi"] = contractABI(_contract);
+	meta["output"]["userdoc"] = natspecUser(_contract);
+	meta["output"]["devdoc"] = natspecDev(_contract);
+
+	return util::jsonCompactPrint(meta);
+}
+
+Json::Value const& CompilerStack::metadataSettings(bool _forIR) const
+{
+	auto settingsIt = m_metadataSettings.find(_forIR);
+	if (settingsIt != m_metadataSettings.end())
+		return settingsIt->second;
+
+	Json::Value& settings = m_metadataSettings[_forIR];
+	settings = Json::objectValue;
 	static_assert(sizeof(m_optimiserSettings.expectedExecutionsPerDeployment) <= sizeof(Json::LargestUInt), "Invalid word size.");
 	solAssert(static_cast<Json::LargestUInt>(m_optimiserSettings.expectedExecutionsPerDeployment) < std::numeric_limits<Json::LargestUInt>::max(), "");
-	meta["settings"]["optimizer"]["runs"] = Json::Value(Json::LargestUInt(m_optimiserSettings.expectedExecutionsPerDeployment));
+	settings["optimizer"]["runs"] = Json::Value(Json::LargestUInt(m_optimiserSettings.expectedExecutionsPerDeployment));
+	if (m_optimiserSettings.executionProfile)
+		settings["optimizer"]["executionProfile"] = m_optimiserSettings.executionProfile->toJson();
+	for (auto const& [sourceName, contracts]: m_optimiserSettings.contractOverrides)
+		for (auto const& [contractName, contractOverride]: contracts)
+		{
+			Json::Value& overrideSettings = settings["optimizer"]["overrides"][sourceName][contractName];
+			overrideSettings = Json::objectValue;
+			if (contractOverride.expectedExecutionsPerDeployment)
+				overrideSettings["runs"] = Json::Value(Json::LargestUInt(*contractOverride.expectedExecutionsPerDeployment));
+			if (contractOverride.yulOptimiserSteps)
+				overrideSettings["optimizerSteps"] = *contractOverride.yulOptimiserSteps;
+		}
 
 	/// Backwards compatibility: If set to one of the default settings, do not provide details.
 	OptimiserSettings settingsWithoutRuns = m_optimiserSettings;
 	// reset to default
 	settingsWithoutRuns.expectedExecutionsPerDeployment = OptimiserSettings::minimal().expectedExecutionsPerDeployment;
+	settingsWithoutRuns.executionProfile = nullptr;
+	settingsWithoutRuns.contractOverrides.clear();
 	if (settingsWithoutRuns == OptimiserSettings::minimal())
-		meta["settings"]["optimizer"]["enabled"] = false;
+		settings["optimizer"]["enabled"] = false;
 	else if (settingsWithoutRuns == OptimiserSettings::standard())
-		meta["settings"]["optimizer"]["enabled"] = true;
+		settings["optimizer"]["enabled"] = true;
 	else
 	{
 		Json::Value details{Json::objectValue};
@@ -1508,48 +2437,63 @@ string CompilerStack::createMetadata(Contract const& _contract, bool _forIR) con
 		details["deduplicate"] = m_optimiserSettings.runDeduplicate;
 		details["cse"] = m_optimiserSettings.runCSE;
 		details["constantOptimizer"] = m_optimiserSettings.runConstantOptimiser;
+		// Only listed if enabled, since they are not part of any preset.
+		if (m_optimiserSettings.runSuperoptimiser)
+			details["superoptimizer"] = true;
+		if (m_optimiserSettings.runBlockLayout)
+			details["blockLayout"] = true;
+		if (m_optimiserSettings.runFunctionInliner)
+			details["functionInliner"] = true;
+		if (m_optimiserSettings.stackLayoutEffort > 0)
+			details["stackLayoutEffort"] = Json::Value::UInt64(m_optimiserSettings.stackLayoutEffort);
+		if (m_optimiserSettings.selectorDispatch != SelectorDispatch::Switch)
+			details["selectorDispatch"] = selectorDispatchToString(m_optimiserSettings.selectorDispatch);
+		if (m_optimiserSettings.lazyCalldataParameters)
+			details["lazyCalldataParameters"] = true;
+		if (m_optimiserSettings.reclaimTemporaryMemory)
+			details["reclaimTemporaryMemory"] = true;
 		details["yul"] = m_optimiserSettings.runYulOptimiser;
 		if (m_optimiserSettings.runYulOptimiser)
 		{
 			details["yulDetails"] = Json::objectValue;
 			details["yulDetails"]["stackAllocation"] = m_optimiserSettings.optimizeStackAllocation;
 			details["yulDetails"]["optimizerSteps"] = m_optimiserSettings.yulOptimiserSteps;
+			if (m_optimiserSettings.yulOptimiserStepBudget)
+				details["yulDetails"]["stepBudget"] = Json::Value::UInt64(*m_optimiserSettings.yulOptimiserStepBudget);
+			if (m_optimiserSettings.yulOptimiserAutotuneCandidates > 1)
+				details["yulDetails"]["autotuneCandidates"] = Json::Value::UInt64(m_optimiserSettings.yulOptimiserAutotuneCandidates);
+			if (m_optimiserSettings.selectYulOptimiserSteps)
+				details["yulDetails"]["selectSteps"] = true;
 		}
 
-		meta["settings"]["optimizer"]["details"] = std::move(details);
+		settings["optimizer"]["details"] = std::move(details);
 	}
 
 	if (m_revertStrings != RevertStrings::Default)
-		meta["settings"]["debug"]["revertStrings"] = revertStringsToString(m_revertStrings);
+		settings["debug"]["revertStrings"] = revertStringsToString(m_revertStrings);
 
 	if (m_metadataLiteralSources)
-		meta["settings"]["metadata"]["useLiteralContent"] = true;
+		settings["metadata"]["useLiteralContent"] = true;
 
 	static vector<string> hashes{"ipfs", "bzzr1", "none"};
-	meta["settings"]["metadata"]["bytecodeHash"] = hashes.at(unsigned(m_metadataHash));
+	settings["metadata"]["bytecodeHash"] = hashes.at(unsigned(m_metadataHash));
 
 	if (_forIR)
-		meta["settings"]["viaIR"] = _forIR;
-	meta["settings"]["evmVersion"] = m_evmVersion.name();
-	meta["settings"]["compilationTarget"][_contract.contract->sourceUnitName()] =
-		*_contract.contract->annotation().canonicalName;
+		settings["viaIR"] = _forIR;
+	settings["evmVersion"] = m_evmVersion.name();
 
-	meta["settings"]["remappings"] = Json::arrayValue;
+	settings["remappings"] = Json::arrayValue;
 	set<string> remappings;
 	for (auto const& r: m_importRemapper.remappings())
 		remappings.insert(r.context + ":" + r.prefix + "=" + r.target);
 	for (auto const& r: remappings)
-		meta["settings"]["remappings"].append(r);
+		settings["remappings"].append(r);
 
-	meta["settings"]["libraries"] = Json::objectValue;
+	settings["libraries"] = Json::objectValue;
 	for (auto const& library: m_libraries)
-		meta["settings"]["libraries"][library.first] = "0x" + toHex(library.second.asBytes());
+		settings["libraries"][library.first] = "0x" + toHex(library.second.asBytes());
 
-	meta["output"]["abi"] = contractABI(_contract);
-	meta["output"]["userdoc"] = natspecUser(_contract);
-	meta["output"]["devdoc"] = natspecDev(_contract);
-
-	return util::jsonCompactPrint(meta);
+	return settings;
 }
 
 class MetadataCBOREncoder
@@ -1691,57 +2635,51 @@ Json::Value CompilerStack::gasEstimates(string const& _contractName) const
 	if (!assemblyItems(_contractName) && !runtimeAssemblyItems(_contractName))
 		return Json::Value();
 
+	return contract(_contractName).gasEstimates.init([&]{ return computeGasEstimates(_contractName); });
+}
+
+Json::Value CompilerStack::computeGasEstimates(string const& _contractName) const
+{
 	using Gas = GasEstimator::GasConsumption;
 	GasEstimator gasEstimator(m_evmVersion);
-	Json::Value output(Json::objectValue);
-
-	if (evmasm::AssemblyItems const* items = assemblyItems(_contractName))
-	{
-		Gas executionGas = gasEstimator.functionalEstimation(*items);
-		Gas codeDepositGas{evmasm::GasMeter::dataGas(runtimeObject(_contractName).bytecode, false, m_evmVersion)};
-
-		Json::Value creation(Json::objectValue);
-		creation["codeDepositCost"] = gasToJson(codeDepositGas);
-		creation["executionCost"] = gasToJson(executionGas);
-		/// TODO: implement + overload to avoid the need of +=
-		executionGas += codeDepositGas;
-		creation["totalCost"] = gasToJson(executionGas);
-		output["creation"] = creation;
-	}
-
-	if (evmasm::AssemblyItems const* items = runtimeAssemblyItems(_contractName))
+	evmasm::AssemblyItems const* creationItems = assemblyItems(_contractName);
+	evmasm::AssemblyItems const* runtimeItems = runtimeAssemblyItems(_contractName);
+
+	// Every estimation explores the paths from one entry point and only reads the assembly items,
+	// so they can run in parallel. Everything that needs the AST or the types is prepared here.
+	vector<function<Gas()>> estimations;
+	if (creationItems)
+		estimations.emplace_back([&]() { return gasEstimator.functionalEstimation(*creationItems); });
+
+	vector<string> externalSignatures;
+	vector<string> internalSignatures;
+	if (runtimeItems)
 	{
 		/// External functions
 		ContractDefinition const& contract = contractDefinition(_contractName);
-		Json::Value externalFunctions(Json::objectValue);
-		for (auto it: contract.interfaceFunctions())
+		for (auto const& it: contract.interfaceFunctions())
 		{
 			string sig = it.second->externalSignature();
-			externalFunctions[sig] = gasToJson(gasEstimator.functionalEstimation(*items, sig));
+			externalSignatures.push_back(sig);
+			estimations.emplace_back([&, sig]() { return gasEstimator.functionalEstimation(*runtimeItems, sig); });
 		}
 
 		if (contract.fallbackFunction())
+		{
+			externalSignatures.emplace_back("");
 			/// This needs to be set to an invalid signature in order to trigger the fallback,
 			/// without the shortcut (of CALLDATSIZE == 0), and therefore to receive the upper bound.
 			/// An empty string ("") would work to trigger the shortcut only.
-			externalFunctions[""] = gasToJson(gasEstimator.functionalEstimation(*items, "INVALID"));
-
-		if (!externalFunctions.empty())
-			output["external"] = externalFunctions;
+			estimations.emplace_back([&]() { return gasEstimator.functionalEstimation(*runtimeItems, "INVALID"); });
+		}
 
 		/// Internal functions
-		Json::Value internalFunctions(Json::objectValue);
 		for (auto const& it: contract.definedFunctions())
 		{
 			/// Exclude externally visible functions, constructor, fallback and receive ether function
 			if (it->isPartOfExternalInterface() || !it->isOrdinary())
 				continue;
 
-			size_t entry = functionEntryPoint(_contractName, *it);
-			GasEstimator::GasConsumption gas = GasEstimator::GasConsumption::infinite();
-			if (entry > 0)
-				gas = gasEstimator.functionalEstimation(*items, entry, *it);
-
 			/// TODO: This could move into a method shared with externalSignature()
 			FunctionType type(*it);
 			string sig = it->name() + "(";
@@ -1749,10 +2687,50 @@ Json::Value CompilerStack::gasEstimates(string const& _contractName) const
 			for (auto it = paramTypes.begin(); it != paramTypes.end(); ++it)
 				sig += (*it)->toString() + (it + 1 == paramTypes.end() ? "" : ",");
 			sig += ")";
+			internalSignatures.push_back(sig);
 
-			internalFunctions[sig] = gasToJson(gas);
+			size_t entry = functionEntryPoint(_contractName, *it);
+			unsigned parametersSize = CompilerUtils::sizeOnStack(it->parameters());
+			estimations.emplace_back([&, entry, parametersSize]() {
+				return entry > 0 ? gasEstimator.functionalEstimation(*runtimeItems, entry, parametersSize) : Gas::infinite();
+			});
 		}
+	}
+
+	vector<Gas> results(estimations.size());
+	if (m_parallelism <= 1 || estimations.size() <= 1)
+		for (size_t i = 0; i < estimations.size(); ++i)
+			results[i] = estimations[i]();
+	else
+		util::parallelFor(estimations.size(), m_parallelism, [&](size_t _i) { results[_i] = estimations[_i](); });
+
+	Json::Value output(Json::objectValue);
+	auto result = results.begin();
+	if (creationItems)
+	{
+		Gas executionGas = *result++;
+		Gas codeDepositGas{evmasm::GasMeter::dataGas(runtimeObject(_contractName).bytecode, false, m_evmVersion)};
+
+		Json::Value creation(Json::objectValue);
+		creation["codeDepositCost"] = gasToJson(codeDepositGas);
+		creation["executionCost"] = gasToJson(executionGas);
+		/// TODO: implement + overload to avoid the need of +=
+		executionGas += codeDepositGas;
+		creation["totalCost"] = gasToJson(executionGas);
+		output["creation"] = creation;
+	}
 
+	if (runtimeItems)
+	{
+		Json::Value externalFunctions(Json::objectValue);
+		for (string const& sig: externalSignatures)
+			externalFunctions[sig] = gasToJson(*result++);
+		if (!externalFunctions.empty())
+			output["external"] = externalFunctions;
+
+		Json::Value internalFunctions(Json::objectValue);
+		for (string const& sig: internalSignatures)
+			internalFunctions[sig] = gasToJson(*result++);
 		if (!internalFunctions.empty())
 			output["internal"] = internalFunctions;
 	}
@@ -25,6 +25,7 @@
 #pragma once
 
 #include <libsolidity/analysis/FunctionCallGraph.h>
+#include <libsolidity/interface/ArtifactCache.h>
 #include <libsolidity/interface/ReadFile.h>
 #include <libsolidity/interface/ImportRemapper.h>
 #include <libsolidity/interface/OptimiserSettings.h>
@@ -43,12 +44,15 @@
 
 #include <libevmasm/LinkerObject.h>
 
+#include <libyul/YulString.h>
+
 #include <libsolutil/Common.h>
 #include <libsolutil/FixedHash.h>
 #include <libsolutil/LazyInit.h>
 
 #include <json/json.h>
 
+#include <algorithm>
 #include <functional>
 #include <memory>
 #include <ostream>
@@ -69,6 +73,12 @@ class AssemblyItem;
 using AssemblyItems = std::vector<AssemblyItem>;
 }
 
+namespace solidity::yul
+{
+class AssemblyStack;
+class OptimisedCodeCache;
+}
+
 namespace solidity::frontend
 {
 
@@ -81,6 +91,7 @@ class Compiler;
 class GlobalContext;
 class Natspec;
 class DeclarationContainer;
+class SharedYulFunctions;
 
 /**
  * Easy to use and self-contained Solidity compiler with as few header dependencies as possible.
@@ -169,6 +180,30 @@ public:
 	/// Must be set before parsing.
 	void setViaIR(bool _viaIR);
 
+	/// Sets the maximum number of threads used to parse and syntax check independent sources, to generate
+	/// bytecode from the IR of independent contracts and to optimise the independent Yul
+	/// sub-objects of a contract.
+	/// A value of one (the default) compiles everything on the calling thread.
+	/// The produced artifacts and diagnostics do not depend on this setting.
+	void setParallelism(size_t _parallelism) { m_parallelism = std::max<size_t>(_parallelism, 1); }
+
+	/// Sets a callback that reads all missing sources imported by a parsed source with one call,
+	/// instead of one call of the read callback per source. If the parallelism allows it, the
+	/// missing sources imported by all sources that are parsed at the same time are read with one call.
+	/// Must be set before parsing.
+	void setBatchReadCallback(ReadCallback::BatchCallback _batchReadFile) { m_batchReadFile = std::move(_batchReadFile); }
+
+	/// If set, the call graphs, the control flow analysis, the state mutability checks and the
+	/// post type checks at contract level are skipped for contracts that are neither requested
+	/// nor created by requested contracts (functions they inherit or call in libraries are still
+	/// checked). The diagnostics of those contracts are not reported then.
+	/// Must be set before analysis.
+	void setAnalyzeOnlyRequestedContracts(bool _analyzeOnlyRequestedContracts);
+
+	/// Sets a cache for the IR generated for contracts, keyed by a hash of their metadata
+	/// and all further settings that affect the IR. Consulted when compiling via the IR.
+	void setArtifactCache(std::shared_ptr<ArtifactCache> _artifactCache) { m_artifactCache = std::move(_artifactCache); }
+
 	/// Set the EVM version used before running compile.
 	/// When called without an argument it will revert to the default version.
 	/// Must be set before parsing.
@@ -195,6 +230,12 @@ public:
 	/// Enable experimental generation of Ewasm code. If enabled, IR is also generated.
 	void enableEwasmGeneration(bool _enable = true) { m_generateEwasm = _enable; }
 
+	/// Enable the annotation of the IR and the code generated from it with source locations and
+	/// the other debug info selected. This is enabled by default and can be disabled if none of the
+	/// outputs depending on it, i.e. the IR, assembly, source maps, generated sources and function
+	/// debug data, is requested.
+	void enableDebugInfoGeneration(bool _enable = true) { m_generateDebugInfo = _enable; }
+
 	/// @arg _metadataLiteralSources When true, store sources as literals in the contract metadata.
 	/// Must be set before parsing.
 	void useMetadataLiteralSources(bool _metadataLiteralSources);
@@ -210,6 +251,15 @@ public:
 	/// Sets the sources. Must be set before parsing.
 	void setSources(StringMap _sources);
 
+	/// Replaces the sources of an analysed stack while keeping all settings, like reset(true)
+	/// followed by setSources(). The next call to parse() and analyze() reuses the ASTs and analysis
+	/// results of sources whose content did not change and that only import such sources,
+	/// so that only the changed sources and the sources depending on them are processed again.
+	/// Reparsed sources get AST IDs different from the ones of a fresh compilation.
+	/// Nothing is reused if the previous analysis failed, if the analysis settings change or if
+	/// so many ASTs were replaced since the last reset that releasing them and their types is due.
+	void updateSources(StringMap _sources);
+
 	/// Adds a response to an SMTLib2 query (identified by the hash of the query input).
 	/// Must be set before parsing.
 	void addSMTLib2Response(util::h256 const& _hash, std::string const& _response);
@@ -248,6 +298,10 @@ public:
 	/// @returns the parsed source unit with the supplied name.
 	SourceUnit const& ast(std::string const& _sourceName) const;
 
+	/// @returns true if the AST and the analysis of the source with the supplied name were reused
+	/// from before the last call to updateSources() instead of being redone.
+	bool isReusedSource(std::string const& _sourceName) const;
+
 	/// @returns the parsed contract with the supplied name. Throws an exception if the contract
 	/// does not exist.
 	ContractDefinition const& contractDefinition(std::string const& _contractName) const;
@@ -259,6 +313,13 @@ public:
 	/// @returns a list of the contract names in the sources.
 	std::vector<std::string> contractNames() const;
 
+	/// Releases the compilation results of the contract @a _contractName, i.e. its assemblies, IR,
+	/// bytecode and cached outputs, so that they do not take up memory until the compiler stack is
+	/// destroyed. Meant to be called once all requested outputs of the contract have been written.
+	/// The code of the contracts it creates is already part of its bytecode, so the outputs of the
+	/// other contracts are not affected. Querying any output of the contract afterwards throws.
+	void releaseContract(std::string const& _contractName);
+
 	/// @returns the name of the last contract. If _sourceName is defined the last contract of that source will be returned.
 	std::string const lastContractName(std::optional<std::string> const& _sourceName = std::nullopt) const;
 
@@ -269,6 +330,7 @@ public:
 	std::string const& yulIR(std::string const& _contractName) const;
 
 	/// @returns the optimized IR representation of a contract.
+	/// When compiling via the IR, it is only printed if IR generation was enabled.
 	std::string const& yulIROptimized(std::string const& _contractName) const;
 
 	/// @returns the Ewasm text representation of a contract.
@@ -341,7 +403,8 @@ public:
 	///               for the EVM codegen
 	bytes cborMetadata(std::string const& _contractName, bool _forIR) const;
 
-	/// @returns a JSON representing the estimated gas usage for contract creation, internal and external functions
+	/// @returns a JSON representing the estimated gas usage for contract creation, internal and external functions.
+	/// The estimates are computed only once per contract, in parallel if the parallelism allows it.
 	Json::Value gasEstimates(std::string const& _contractName) const;
 
 	/// Changes the format of the metadata appended at the end of the bytecode.
@@ -358,10 +421,15 @@ private:
 		util::h256 mutable keccak256HashCached;
 		util::h256 mutable swarmHashCached;
 		std::string mutable ipfsUrlCached;
+		/// The entry of the source in the metadata if it lists the URLs instead of the content.
+		/// It is the same for all contracts that import the source.
+		Json::Value mutable metadataEntryCached;
 		void reset() { *this = Source(); }
 		util::h256 const& keccak256() const;
 		util::h256 const& swarmHash() const;
 		std::string const& ipfsUrl() const;
+		/// @returns the entry of the source in the "sources" of the metadata.
+		Json::Value metadataEntry(bool _literalContent) const;
 	};
 
 	/// The state per contract. Filled gradually during compilation.
@@ -375,6 +443,13 @@ private:
 		evmasm::LinkerObject runtimeObject; ///< Runtime object.
 		std::string yulIR; ///< Experimental Yul IR code.
 		std::string yulIROptimized; ///< Optimized experimental Yul IR code.
+		/// Optimized IR in parsed form, kept until EVM code is generated from it.
+		/// Only set when compiling via the IR.
+		std::shared_ptr<yul::AssemblyStack> yulIRStack;
+		/// Optimized IR as passed to the EVM code generator, if taken from the artifact cache.
+		std::string yulIRForEVM;
+		/// Key of the optimized IR in the artifact cache, which does not depend on the metadata.
+		std::optional<util::h256> optimizedIRCacheKey;
 		std::string ewasm; ///< Experimental Ewasm text representation
 		evmasm::LinkerObject ewasmObject; ///< Experimental Ewasm code
 		util::LazyInit<std::string const> metadata; ///< The metadata json that will be hashed into the chain.
@@ -384,17 +459,76 @@ private:
 		util::LazyInit<Json::Value const> devDocumentation;
 		util::LazyInit<Json::Value const> generatedSources;
 		util::LazyInit<Json::Value const> runtimeGeneratedSources;
+		util::LazyInit<Json::Value const> gasEstimates;
 		mutable std::optional<std::string const> sourceMapping;
 		mutable std::optional<std::string const> runtimeSourceMapping;
+		/// Whether the results were released by ``releaseContract``.
+		bool released = false;
 	};
 
+	/// Settings that influence the results of parsing and analysis.
+	struct AnalysisSettings
+	{
+		langutil::EVMVersion evmVersion;
+		std::vector<ImportRemapper::Remapping> remappings;
+		bool parserErrorRecovery = false;
+		bool runYulOptimiser = false;
+		bool lazyCalldataParameters = false;
+		ModelCheckerSettings modelCheckerSettings;
+
+		bool operator==(AnalysisSettings const& _other) const
+		{
+			return
+				evmVersion == _other.evmVersion &&
+				remappings == _other.remappings &&
+				parserErrorRecovery == _other.parserErrorRecovery &&
+				runYulOptimiser == _other.runYulOptimiser &&
+				lazyCalldataParameters == _other.lazyCalldataParameters &&
+				modelCheckerSettings == _other.modelCheckerSettings;
+		}
+		bool operator!=(AnalysisSettings const& _other) const { return !(*this == _other); }
+	};
+
+	AnalysisSettings analysisSettings() const;
+
+	/// Drops everything kept alive for an incremental update by updateSources().
+	void discardPreviousAnalysis();
+
+	/// @returns true if the analysis of @a _source is reused from before the last call to updateSources().
+	bool isReusedSource(Source const& _source) const;
+
+	/// Runs @a _check on the ASTs of @a _sources. If m_parallelism allows it, the sources are
+	/// checked concurrently, each with its own error reporter, and the diagnostics are reported
+	/// in the order of @a _sources. Only usable for checks that do not depend on or modify
+	/// anything outside of the source unit they are given, in particular not on types.
+	/// @returns false if @a _check returned false for any of the sources.
+	bool checkSourcesIndependently(
+		std::vector<Source const*> const& _sources,
+		std::function<bool(SourceUnit const&, langutil::ErrorReporter&)> const& _check
+	);
+
+	/// Runs the model checker on the analysed sources, the last step of the analysis.
+	void runModelChecker();
+	/// Runs the model checker if analyze() deferred it because of m_deferModelChecking.
+	/// It only reads the AST, so it can run while the IR of contracts is optimised concurrently.
+	/// @returns false if it reported an error.
+	bool runPendingModelChecker();
+
+	/// Creates the call graphs of all contracts or, if m_analyzeOnlyRequestedContracts is set,
+	/// only of the requested contracts and the contracts they create.
 	void createAndAssignCallGraphs();
+	/// @returns false if m_analyzeOnlyRequestedContracts is set and the whole-contract analysis
+	/// of @a _contract is skipped, because no code is generated for it.
+	bool isAnalysedContract(ContractDefinition const& _contract) const;
 	void findAndReportCyclicContractDependencies();
 
-	/// Loads the missing sources from @a _ast (named @a _path) using the callback
-	/// @a m_readFile
+	/// Loads the missing sources imported by @a _ast, taking the ones in @a _readFiles, which
+	/// are moved out of it, and reading the others using readFiles().
 	/// @returns the newly loaded sources.
-	StringMap loadMissingSources(SourceUnit const& _ast);
+	StringMap loadMissingSources(SourceUnit const& _ast, std::map<std::string, ReadCallback::Result>& _readFiles);
+	/// Reads the sources @a _paths with one call of m_batchReadFile if it is set
+	/// and otherwise calls m_readFile for each of them.
+	std::map<std::string, ReadCallback::Result> readFiles(std::vector<std::string> const& _paths);
 	std::string applyRemapping(std::string const& _path, std::string const& _context);
 	void resolveImports();
 
@@ -427,10 +561,47 @@ private:
 	/// The IR is stored but otherwise unused.
 	void generateIR(ContractDefinition const& _contract);
 
+	/// @returns the debug info to annotate the IR with, which is none if its generation is disabled.
+	langutil::DebugInfoSelection generatedDebugInfo() const;
+
+	/// @returns the key under which the IR of @a _contract is stored in the artifact cache.
+	util::h256 irCacheKey(Contract const& _contract) const;
+
+	/// @returns the key under which the optimized IR of @a _contract is stored in the artifact
+	/// cache, given its unoptimized IR @a _irWithoutMetadata without the contents of the metadata.
+	util::h256 optimizedIRCacheKey(ContractDefinition const& _contract, std::string const& _irWithoutMetadata) const;
+
+	/// Loads the optimized IR of @a _contract from the artifact cache, which only requires its
+	/// unoptimized IR to match up to the embedded metadata.
+	/// Also sets the key under which it is stored after EVM code is generated from it.
+	/// @returns false if there was no cache entry.
+	bool loadOptimizedIR(Contract& _contract);
+
+	/// @returns the optimiser settings for the code of @a _contract.
+	OptimiserSettings optimiserSettings(ContractDefinition const& _contract) const;
+
 	/// Generate EVM representation for a single contract.
 	/// Depends on output generated by generateIR.
 	void generateEVMFromIR(ContractDefinition const& _contract);
 
+	/// Optimizes the IR of a single contract and transforms it into EVM assembly, without assembling it.
+	/// Only touches the Contract object of @a _contract, so it can run concurrently for different contracts.
+	/// Independent Yul sub-objects are optimised on up to @a _parallelism threads.
+	/// Depends on output generated by generateIR.
+	void generateEVMAssemblyFromIR(ContractDefinition const& _contract, size_t _parallelism = 1);
+
+	/// Generates IR for all of @a _contracts on the calling thread and hands the IR of each contract
+	/// to a pool of m_parallelism threads for the bytecode generation as soon as it is available.
+	/// Results are collected in the order of @a _contracts, so that errors and warnings are
+	/// reported exactly like in the serial pipeline.
+	/// @returns false on error.
+	bool compileViaIRInParallel(std::vector<ContractDefinition const*> const& _contracts);
+
+	/// Runs @a _step, converting code generation errors and located unimplemented feature errors
+	/// into reported errors.
+	/// @returns false if an error was reported.
+	bool reportingCodeGenerationErrors(std::function<void()> const& _step);
+
 	/// Generate Ewasm representation for a single contract.
 	/// Depends on output generated by generateIR.
 	void generateEwasm(ContractDefinition const& _contract);
@@ -452,6 +623,10 @@ private:
 	/// @returns the metadata JSON as a compact string for the given contract.
 	std::string createMetadata(Contract const& _contract, bool _forIR) const;
 
+	/// @returns the "settings" of the metadata without the compilation target, which are the same
+	/// for all contracts and therefore only generated once.
+	Json::Value const& metadataSettings(bool _forIR) const;
+
 	/// @returns the metadata CBOR for the given serialised metadata JSON.
 	/// @param _forIR If true, use the metadata for the IR codegen. Otherwise the one for EVM codegen.
 	bytes createCBORMetadata(Contract const& _contract, bool _forIR) const;
@@ -476,6 +651,9 @@ private:
 	/// This will generate the metadata and store it in the Contract object if it is not present yet.
 	std::string const& metadata(Contract const& _contract) const;
 
+	/// @returns the estimated gas usage of the contract @a _contractName, see gasEstimates().
+	Json::Value computeGasEstimates(std::string const& _contractName) const;
+
 	/// @returns the offset of the entry point of the given function into the list of assembly items
 	/// or zero if it is not found or does not exist.
 	size_t functionEntryPoint(
@@ -483,7 +661,10 @@ private:
 		FunctionDefinition const& _function
 	) const;
 
+	/// Keeps the YulStrings of inline assembly blocks and generated code valid. Destroyed last.
+	yul::YulStringRepository::Session m_yulStringSession;
 	ReadCallback::Callback m_readFile;
+	ReadCallback::BatchCallback m_batchReadFile;
 	OptimiserSettings m_optimiserSettings;
 	RevertStrings m_revertStrings = RevertStrings::Default;
 	State m_stopAfter = State::CompilationSuccessful;
@@ -494,6 +675,14 @@ private:
 	bool m_generateEvmBytecode = true;
 	bool m_generateIR = false;
 	bool m_generateEwasm = false;
+	bool m_generateDebugInfo = true;
+	size_t m_parallelism = 1;
+	bool m_analyzeOnlyRequestedContracts = false;
+	std::shared_ptr<ArtifactCache> m_artifactCache;
+	/// Optimised Yul objects, shared by all contracts during compile().
+	std::shared_ptr<yul::OptimisedCodeCache> m_optimisedCodeCache;
+	/// Utility functions of the IR shared by all contracts during compile().
+	std::shared_ptr<SharedYulFunctions> m_sharedYulFunctions;
 	std::map<std::string, util::h160> m_libraries;
 	ImportRemapper m_importRemapper;
 	std::map<std::string const, Source> m_sources;
@@ -504,6 +693,22 @@ private:
 	std::shared_ptr<GlobalContext> m_globalContext;
 	std::vector<Source const*> m_sourceOrder;
 	std::map<std::string const, Contract> m_contracts;
+	/// Cache of metadataSettings(), by whether the metadata is for the IR codegen.
+	mutable std::map<bool, Json::Value> m_metadataSettings;
+	/// Analysed sources from before the last call to updateSources(), which parse() takes over
+	/// if their content did not change.
+	std::map<std::string, Source> m_previousSources;
+	AnalysisSettings m_previousAnalysisSettings;
+	/// Diagnostics reported for m_previousSources, restored for the sources that are reused.
+	langutil::ErrorList m_previousErrors;
+	/// Names of the sources whose ASTs and analysis results are reused.
+	std::set<std::string> m_reusedSources;
+	/// ASTs replaced by incremental updates. They are kept until the next reset, because
+	/// the types created for them are only released then and must not refer to recycled nodes.
+	/// updateSources() resets once there are too many of them, so that they do not accumulate.
+	std::vector<std::shared_ptr<SourceUnit>> m_retiredASTs;
+	/// ID of the last AST node created, so that reparsed sources do not reuse the IDs of reused ones.
+	int64_t m_lastNodeID = 0;
 
 	langutil::ErrorList m_errorList;
 	langutil::ErrorReporter m_errorReporter;
@@ -516,6 +721,10 @@ private:
 	/// Whether or not there has been an error during processing.
 	/// If this is true, the stack will refuse to generate code.
 	bool m_hasError = false;
+	/// Set by compile() to make analyze() leave the model checker to the code generation.
+	bool m_deferModelChecking = false;
+	/// Whether the analysis succeeded, but the model checker has not run yet.
+	bool m_modelCheckingPending = false;
 	MetadataFormat m_metadataFormat = VersionIsRelease ? MetadataFormat::WithReleaseVersionTag : MetadataFormat::WithPrereleaseVersionTag;
 };
 
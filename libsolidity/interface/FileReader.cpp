@@ -94,6 +94,18 @@ void FileReader::setStdin(SourceCode _source)
 	m_sourceCodes["<stdin>"] = std::move(_source);
 }
 
+void FileReader::replaceSourceRange(SourceUnitName const& _sourceUnitName, size_t _start, size_t _end, string const& _text)
+{
+	SourceCode& source = m_sourceCodes.at(_sourceUnitName);
+	solAssert(_start <= _end && _end <= source.size(), "");
+	source.replace(_start, _end - _start, _text);
+}
+
+void FileReader::removeSourceUnit(SourceUnitName const& _sourceUnitName)
+{
+	m_sourceCodes.erase(_sourceUnitName);
+}
+
 void FileReader::setSourceUnits(StringMap _sources)
 {
 	m_sourceCodes = std::move(_sources);
@@ -156,7 +168,7 @@ ReadCallback::Result FileReader::readFile(string const& _kind, string const& _so
 		auto contents = readFileAsString(candidates[0]);
 		solAssert(m_sourceCodes.count(_sourceUnitName) == 0, "");
 		m_sourceCodes[_sourceUnitName] = contents;
-		return ReadCallback::Result{true, contents};
+		return ReadCallback::Result{true, std::move(contents)};
 	}
 	catch (util::Exception const& _exception)
 	{
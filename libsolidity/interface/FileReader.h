@@ -77,6 +77,13 @@ public:
 	/// Does not enforce @a allowedDirectories().
 	void setStdin(SourceCode _source);
 
+	/// Replaces the characters from @a _start up to @a _end of the existing source unit
+	/// @a _sourceUnitName by @a _text in place.
+	void replaceSourceRange(SourceUnitName const& _sourceUnitName, size_t _start, size_t _end, std::string const& _text);
+
+	/// Removes the source unit @a _sourceUnitName, so that it is read again when it is imported.
+	void removeSourceUnit(SourceUnitName const& _sourceUnitName);
+
 	/// Receives a @p _sourceUnitName that refers to a source unit in compiler's virtual filesystem
 	/// and attempts to interpret it as a path and read the corresponding file from disk.
 	/// The read will only succeed if the canonical path of the file is within one of the @a allowedDirectories().
@@ -64,6 +64,15 @@ public:
 		FunctionDefinition const& _function
 	) const;
 
+	/// @returns the estimated gas consumption by a function whose parameters occupy
+	/// @a _parametersSize stack slots and which starts at the given offset into the list
+	/// of assembly items. Unlike the other overloads, this does not access the AST.
+	GasConsumption functionalEstimation(
+		evmasm::AssemblyItems const& _items,
+		size_t const& _offset,
+		unsigned _parametersSize
+	) const;
+
 private:
 	/// @returns the set of AST nodes which are the finest nodes at their location.
 	static std::set<ASTNode const*> finestNodesAtLocation(std::vector<ASTNode const*> const& _roots);
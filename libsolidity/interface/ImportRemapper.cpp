@@ -19,7 +19,6 @@
 #include <libsolutil/CommonIO.h>
 #include <liblangutil/Exceptions.h>
 
-using std::equal;
 using std::find;
 using std::move;
 using std::nullopt;
@@ -36,47 +35,83 @@ void ImportRemapper::setRemappings(vector<Remapping> _remappings)
 	for (auto const& remapping: _remappings)
 		solAssert(!remapping.prefix.empty(), "");
 	m_remappings = move(_remappings);
+
+	m_trie.assign(1, TrieNode{});
+	m_targets.clear();
+	for (size_t i = 0; i < m_remappings.size(); ++i)
+	{
+		size_t contextNode = insert(0, util::sanitizePath(m_remappings[i].context));
+		if (!m_trie[contextNode].value)
+		{
+			m_trie.emplace_back();
+			m_trie[contextNode].value = m_trie.size() - 1;
+		}
+		size_t prefixNode = insert(*m_trie[contextNode].value, util::sanitizePath(m_remappings[i].prefix));
+		m_trie[prefixNode].value = i;
+		m_targets.emplace_back(util::sanitizePath(m_remappings[i].target));
+	}
 }
 
 SourceUnitName ImportRemapper::apply(ImportPath const& _path, string const& _context) const
 {
-	// Try to find the longest prefix match in all remappings that are active in the current context.
-	auto isPrefixOf = [](string const& _a, string const& _b)
+	if (m_trie.empty())
+		return _path;
+
+	// Calls @a _visit with the length and the value of each node with a value along @a _key.
+	auto walk = [&](size_t _node, string const& _key, auto _visit)
 	{
-		if (_a.length() > _b.length())
-			return false;
-		return equal(_a.begin(), _a.end(), _b.begin());
+		for (size_t length = 0; ; ++length)
+		{
+			if (m_trie[_node].value)
+				_visit(length, *m_trie[_node].value);
+			if (length == _key.size())
+				break;
+			auto child = m_trie[_node].children.find(_key[length]);
+			if (child == m_trie[_node].children.end())
+				break;
+			_node = child->second;
+		}
 	};
 
-	size_t longestPrefix = 0;
-	size_t longestContext = 0;
-	string bestMatchTarget;
+	// The roots of the tries over the prefixes of the remappings whose context is a prefix of
+	// _context, shortest context first.
+	vector<size_t> prefixTries;
+	walk(0, _context, [&](size_t, size_t _prefixTrie) { prefixTries.emplace_back(_prefixTrie); });
 
-	for (auto const& redir: m_remappings)
+	// A closer context takes precedence over a longer prefix.
+	for (auto prefixTrie = prefixTries.rbegin(); prefixTrie != prefixTries.rend(); ++prefixTrie)
+	{
+		optional<size_t> longestPrefix;
+		size_t remapping = 0;
+		walk(*prefixTrie, _path, [&](size_t _length, size_t _remapping) {
+			longestPrefix = _length;
+			remapping = _remapping;
+		});
+		if (longestPrefix)
+		{
+			string path = m_targets[remapping];
+			path.append(_path.begin() + static_cast<string::difference_type>(*longestPrefix), _path.end());
+			return path;
+		}
+	}
+	return _path;
+}
+
+size_t ImportRemapper::insert(size_t _node, string const& _key)
+{
+	for (char c: _key)
 	{
-		string context = util::sanitizePath(redir.context);
-		string prefix = util::sanitizePath(redir.prefix);
-
-		// Skip if current context is closer
-		if (context.length() < longestContext)
-			continue;
-		// Skip if redir.context is not a prefix of _context
-		if (!isPrefixOf(context, _context))
-			continue;
-		// Skip if we already have a closer prefix match.
-		if (prefix.length() < longestPrefix && context.length() == longestContext)
-			continue;
-		// Skip if the prefix does not match.
-		if (!isPrefixOf(prefix, _path))
-			continue;
-
-		longestContext = context.length();
-		longestPrefix = prefix.length();
-		bestMatchTarget = util::sanitizePath(redir.target);
+		auto child = m_trie[_node].children.find(c);
+		if (child != m_trie[_node].children.end())
+			_node = child->second;
+		else
+		{
+			m_trie.emplace_back();
+			m_trie[_node].children[c] = m_trie.size() - 1;
+			_node = m_trie.size() - 1;
+		}
 	}
-	string path = bestMatchTarget;
-	path.append(_path.begin() + static_cast<string::difference_type>(longestPrefix), _path.end());
-	return path;
+	return _node;
 }
 
 bool ImportRemapper::isRemapping(string_view _input)
@@ -17,6 +17,7 @@
 // SPDX-License-Identifier: GPL-3.0
 #pragma once
 
+#include <map>
 #include <optional>
 #include <string>
 #include <vector>
@@ -49,11 +50,20 @@ public:
 		std::string target;
 	};
 
-	void clear() { m_remappings.clear(); }
+	void clear()
+	{
+		m_remappings.clear();
+		m_trie.clear();
+		m_targets.clear();
+	}
 
 	void setRemappings(std::vector<Remapping> _remappings);
 	std::vector<Remapping> const& remappings() const noexcept { return m_remappings; }
 
+	/// Applies the remapping with the longest context that is a prefix of @a _context and, among
+	/// those, the longest prefix of @a _path, preferring later remappings if both are equal.
+	/// Takes time linear in the lengths of @a _path and @a _context, independent of the number
+	/// of remappings.
 	SourceUnitName apply(ImportPath const& _path, std::string const& _context) const;
 
 	/// @returns true if the string can be parsed as a remapping
@@ -63,9 +73,26 @@ public:
 	static std::optional<Remapping> parseRemapping(std::string_view _input);
 
 private:
+	/// Node of the trie over the sanitized contexts of the remappings or of one of the tries over
+	/// their sanitized prefixes.
+	struct TrieNode
+	{
+		std::map<char, size_t> children;
+		/// In the trie over the contexts, the root of the trie over the prefixes of the remappings
+		/// with this context. In a trie over prefixes, the index of the last remapping with this prefix.
+		std::optional<size_t> value;
+	};
+
+	/// Inserts @a _key into the trie starting at @a _node and @returns the node it ends at.
+	size_t insert(size_t _node, std::string const& _key);
+
 	/// list of path prefix remappings, e.g. mylibrary: github.com/ethereum = /usr/local/ethereum
 	/// "context:prefix=target"
 	std::vector<Remapping> m_remappings = {};
+	/// The nodes of all tries, the first one is the root of the trie over the contexts.
+	std::vector<TrieNode> m_trie;
+	/// The sanitized targets of the remappings.
+	std::vector<std::string> m_targets;
 };
 
 }
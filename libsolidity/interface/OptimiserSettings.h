@@ -23,10 +23,16 @@
 
 #pragma once
 
+#include <libevmasm/ExecutionProfile.h>
+
 #include <liblangutil/Exceptions.h>
 
 #include <cstddef>
+#include <map>
+#include <memory>
+#include <optional>
 #include <string>
+#include <tuple>
 
 namespace solidity::frontend
 {
@@ -39,6 +45,52 @@ enum class OptimisationPreset
 	Full,
 };
 
+/// How the code generated via the IR selects the external function to call.
+enum class SelectorDispatch
+{
+	/// A single switch over all selectors.
+	Switch,
+	/// Binary search over the selectors down to switches over at most four of them.
+	BinarySearch,
+	/// Binary search as far as it pays off for the expected executions per deployment,
+	/// like in the legacy code generator.
+	Auto,
+};
+
+inline std::string selectorDispatchToString(SelectorDispatch _dispatch)
+{
+	switch (_dispatch)
+	{
+	case SelectorDispatch::Switch: return "switch";
+	case SelectorDispatch::BinarySearch: return "binarySearch";
+	case SelectorDispatch::Auto: return "auto";
+	}
+	// Cannot reach this.
+	return "INVALID";
+}
+
+inline std::optional<SelectorDispatch> selectorDispatchFromString(std::string const& _str)
+{
+	for (auto i: {SelectorDispatch::Switch, SelectorDispatch::BinarySearch, SelectorDispatch::Auto})
+		if (selectorDispatchToString(i) == _str)
+			return i;
+	return std::nullopt;
+}
+
+/// Optimiser settings of a single contract that differ from the ones of the compilation.
+struct OptimiserSettingsOverride
+{
+	std::optional<size_t> expectedExecutionsPerDeployment;
+	std::optional<std::string> yulOptimiserSteps;
+
+	bool operator==(OptimiserSettingsOverride const& _other) const
+	{
+		return
+			std::tie(expectedExecutionsPerDeployment, yulOptimiserSteps) ==
+			std::tie(_other.expectedExecutionsPerDeployment, _other.yulOptimiserSteps);
+	}
+};
+
 struct OptimiserSettings
 {
 	static char constexpr DefaultYulOptimiserSteps[] =
@@ -59,6 +111,19 @@ struct OptimiserSettings
 		"]"
 		"jmul[jul] VcTOcul jmul";      // Make source short and pretty
 
+	/// Alternatives to the default sequence tried when auto-tuning, see @a yulOptimiserAutotuneCandidates.
+	/// They only differ from the default sequence in the SSA plus simplify part and the full inliner.
+	static constexpr char const* AutotuneYulOptimiserSteps[] = {
+		// Remove overwritten storage writes
+		"dhfoDgvulfnTUtnIf[xa[r]EscLMcCTUtTOntnfDIulLculVcul [j]Tpeulxa[rul]xa[r]cLgvifCTUca[r]LWsTFOtfDnca[r]Iulc]jmul[jul] VcTOcul jmul",
+		// Move invariant loads out of inlined loops
+		"dhfoDgvulfnTUtnIf[xa[r]EscLMcCTUtTOntnfDIulLculVcul [j]Tpeulxa[rul]xa[r]cLgvifCTUca[r]LMsTFOtfDnca[r]Iulc]jmul[jul] VcTOcul jmul",
+		// Both of the above
+		"dhfoDgvulfnTUtnIf[xa[r]EscLMcCTUtTOntnfDIulLculVcul [j]Tpeulxa[rul]xa[r]cLgvifCTUca[r]LWMsTFOtfDnca[r]Iulc]jmul[jul] VcTOcul jmul",
+		// No full inliner, usually smaller code
+		"dhfoDgvulfnTUtnIf[xa[r]EscLMcCTUtTOntnfDIulLculVcul [j]Tpeulxa[rul]xa[r]cLgvfCTUca[r]LsTFOtfDnca[r]Iulc]jmul[jul] VcTOcul jmul",
+	};
+
 	/// No optimisations at all - not recommended.
 	static OptimiserSettings none()
 	{
@@ -115,10 +180,44 @@ struct OptimiserSettings
 			runDeduplicate == _other.runDeduplicate &&
 			runCSE == _other.runCSE &&
 			runConstantOptimiser == _other.runConstantOptimiser &&
+			runSuperoptimiser == _other.runSuperoptimiser &&
+			runBlockLayout == _other.runBlockLayout &&
+			runFunctionInliner == _other.runFunctionInliner &&
 			optimizeStackAllocation == _other.optimizeStackAllocation &&
+			stackLayoutEffort == _other.stackLayoutEffort &&
+			selectorDispatch == _other.selectorDispatch &&
+			lazyCalldataParameters == _other.lazyCalldataParameters &&
+			reclaimTemporaryMemory == _other.reclaimTemporaryMemory &&
 			runYulOptimiser == _other.runYulOptimiser &&
 			yulOptimiserSteps == _other.yulOptimiserSteps &&
-			expectedExecutionsPerDeployment == _other.expectedExecutionsPerDeployment;
+			yulOptimiserStepBudget == _other.yulOptimiserStepBudget &&
+			yulOptimiserAutotuneCandidates == _other.yulOptimiserAutotuneCandidates &&
+			selectYulOptimiserSteps == _other.selectYulOptimiserSteps &&
+			expectedExecutionsPerDeployment == _other.expectedExecutionsPerDeployment &&
+			(executionProfile && _other.executionProfile ?
+				*executionProfile == *_other.executionProfile :
+				executionProfile == _other.executionProfile
+			) &&
+			contractOverrides == _other.contractOverrides;
+	}
+
+	/// @returns the settings used for the code of contract @a _contractName
+	/// in source unit @a _sourceUnitName, i.e. these settings with its override applied.
+	OptimiserSettings forContract(std::string const& _sourceUnitName, std::string const& _contractName) const
+	{
+		OptimiserSettings settings = *this;
+		settings.contractOverrides.clear();
+		auto sourceOverrides = contractOverrides.find(_sourceUnitName);
+		if (sourceOverrides == contractOverrides.end())
+			return settings;
+		auto contractOverride = sourceOverrides->second.find(_contractName);
+		if (contractOverride == sourceOverrides->second.end())
+			return settings;
+		if (contractOverride->second.expectedExecutionsPerDeployment)
+			settings.expectedExecutionsPerDeployment = *contractOverride->second.expectedExecutionsPerDeployment;
+		if (contractOverride->second.yulOptimiserSteps)
+			settings.yulOptimiserSteps = *contractOverride->second.yulOptimiserSteps;
+		return settings;
 	}
 
 	/// Move literals to the right of commutative binary operators during code generation.
@@ -137,8 +236,28 @@ struct OptimiserSettings
 	/// Constant optimizer, which tries to find better representations that satisfy the given
 	/// size/cost-trade-off.
 	bool runConstantOptimiser = false;
+	/// Search for cheaper equivalent sequences of stack instructions. Not part of any preset.
+	bool runSuperoptimiser = false;
+	/// Move cold code behind conditional jumps to the end of the assembly. Not part of any preset.
+	bool runBlockLayout = false;
+	/// Inline functions with a single call site and remove unreachable code. Not part of any preset.
+	bool runFunctionInliner = false;
 	/// Perform more efficient stack allocation for variables during code generation from Yul to bytecode.
 	bool optimizeStackAllocation = false;
+	/// Rounds of local search spent on improving the stack layouts at conditional jumps and the order
+	/// of the arguments and return values of functions when @a optimizeStackAllocation is set.
+	/// Trades compilation time for less stack shuffling.
+	size_t stackLayoutEffort = 0;
+	/// Selection of the external function in the code generated via the IR. Unless it is
+	/// @a SelectorDispatch::Switch, the functions with the most executions according to
+	/// @a executionProfile are compared first.
+	SelectorDispatch selectorDispatch = SelectorDispatch::Switch;
+	/// Access the ``memory`` parameters of external functions that are only read in calldata
+	/// instead of decoding them into memory, in the code generated via the IR.
+	bool lazyCalldataParameters = false;
+	/// Reset the free memory pointer after hashing byte arrays produced by ABI encoding or
+	/// ``bytes.concat`` with ``keccak256``, in the code generated via the IR.
+	bool reclaimTemporaryMemory = false;
 	/// Yul optimiser with default settings. Will only run on certain parts of the code for now.
 	bool runYulOptimiser = false;
 	/// Sequence of optimisation steps to be performed by Yul optimiser.
@@ -146,9 +265,26 @@ struct OptimiserSettings
 	/// them just by setting this to an empty string. Set @a runYulOptimiser to false if you want
 	/// no optimisations.
 	std::string yulOptimiserSteps = DefaultYulOptimiserSteps;
+	/// Maximum number of steps of @a yulOptimiserSteps the Yul optimiser runs on each object.
+	/// Steps skipped because they would not change the code do not count. The hard-coded steps
+	/// and the ones ensuring that the code can be compiled are always run. Unlimited if not set.
+	std::optional<size_t> yulOptimiserStepBudget;
+	/// Number of sequences the Yul optimiser tries on each object, in parallel if threads are
+	/// available: @a yulOptimiserSteps followed by @a AutotuneYulOptimiserSteps. The result with the
+	/// lowest estimated deployment and runtime costs is kept, the earlier sequence in case of a tie.
+	/// At most 1 disables auto-tuning.
+	size_t yulOptimiserAutotuneCandidates = 1;
+	/// If @a yulOptimiserSteps is the default sequence, replace it for each object by the one of
+	/// @a AutotuneYulOptimiserSteps that suits the class of its code, see @a yul::OptimiserSuite::classify.
+	bool selectYulOptimiserSteps = false;
 	/// This specifies an estimate on how often each opcode in this assembly will be executed,
 	/// i.e. use a small value to optimise for size and a large value to optimise for runtime gas usage.
 	size_t expectedExecutionsPerDeployment = 200;
+	/// Execution counts of source ranges, e.g. collected from transaction traces. Where present,
+	/// they replace @a expectedExecutionsPerDeployment for the runtime code of these ranges.
+	std::shared_ptr<evmasm::ExecutionProfile const> executionProfile;
+	/// Overrides for individual contracts by source unit name and contract name, see @a forContract.
+	std::map<std::string, std::map<std::string, OptimiserSettingsOverride>> contractOverrides;
 };
 
 }
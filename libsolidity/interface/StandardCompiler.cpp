@@ -29,6 +29,7 @@
 #include <libyul/Exceptions.h>
 #include <libyul/optimiser/Suite.h>
 
+#include <libevmasm/ExecutionProfile.h>
 #include <libevmasm/Instruction.h>
 
 #include <libsmtutil/Exceptions.h>
@@ -38,10 +39,13 @@
 #include <libsolutil/JSON.h>
 #include <libsolutil/Keccak256.h>
 #include <libsolutil/CommonData.h>
+#include <libsolutil/Profiler.h>
+#include <libsolutil/ThreadPool.h>
 
 #include <boost/algorithm/string/predicate.hpp>
 
 #include <algorithm>
+#include <limits>
 #include <optional>
 
 using namespace std;
@@ -134,14 +138,22 @@ Json::Value formatErrorWithException(
 	else
 		message = _message;
 
+	SourceLocation const* location = boost::get_error_info<errinfo_sourceLocation>(_exception);
+	SecondarySourceLocation const* secondaryLocation = boost::get_error_info<errinfo_secondarySourceLocation>(_exception);
+	if (auto const* error = dynamic_cast<Error const*>(&_exception))
+	{
+		location = error->sourceLocation();
+		secondaryLocation = error->secondarySourceLocation();
+	}
+
 	Json::Value error = formatError(
 		_severity,
 		_type,
 		_component,
 		message,
 		formattedMessage,
-		formatSourceLocation(boost::get_error_info<errinfo_sourceLocation>(_exception)),
-		formatSecondarySourceLocation(boost::get_error_info<errinfo_secondarySourceLocation>(_exception))
+		formatSourceLocation(location),
+		formatSecondarySourceLocation(secondaryLocation)
 	);
 
 	if (_errorId)
@@ -331,6 +343,30 @@ bool isIRRequested(Json::Value const& _outputSelection)
 	return false;
 }
 
+/// @returns true if any output depending on the source locations and other debug info the code
+/// generated via the IR is annotated with was requested.
+bool isDebugInfoRequested(Json::Value const& _outputSelection)
+{
+	if (isIRRequested(_outputSelection))
+		return true;
+
+	if (!_outputSelection.isObject())
+		return false;
+
+	static vector<string> const outputsThatRequireDebugInfo = vector<string>{
+		"evm.gasEstimates", "evm.legacyAssembly", "evm.assembly",
+		"evm.bytecode.sourceMap", "evm.bytecode.functionDebugData", "evm.bytecode.generatedSources",
+		"evm.deployedBytecode.sourceMap", "evm.deployedBytecode.functionDebugData", "evm.deployedBytecode.generatedSources"
+	};
+
+	for (auto const& fileRequests: _outputSelection)
+		for (auto const& requests: fileRequests)
+			for (auto const& output: outputsThatRequireDebugInfo)
+				if (isArtifactRequested(requests, output, false))
+					return true;
+	return false;
+}
+
 Json::Value formatLinkReferences(std::map<size_t, std::string> const& linkReferences)
 {
 	Json::Value ret{Json::objectValue};
@@ -381,10 +417,12 @@ Json::Value formatImmutableReferences(map<u256, pair<string, vector<size_t>>> co
 	return ret;
 }
 
+/// @a _sourceMap and @a _generatedSources are only called if their artifacts are requested,
+/// since computing them can take longer than generating the bytecode.
 Json::Value collectEVMObject(
 	evmasm::LinkerObject const& _object,
-	string const* _sourceMap,
-	Json::Value _generatedSources,
+	function<string const*()> const& _sourceMap,
+	function<Json::Value()> const& _generatedSources,
 	bool _runtimeObject,
 	function<bool(string)> const& _artifactRequested
 )
@@ -395,7 +433,10 @@ Json::Value collectEVMObject(
 	if (_artifactRequested("opcodes"))
 		output["opcodes"] = evmasm::disassemble(_object.bytecode);
 	if (_artifactRequested("sourceMap"))
-		output["sourceMap"] = _sourceMap ? *_sourceMap : "";
+	{
+		string const* sourceMap = _sourceMap();
+		output["sourceMap"] = sourceMap ? *sourceMap : "";
+	}
 	if (_artifactRequested("functionDebugData"))
 		output["functionDebugData"] = StandardCompiler::formatFunctionDebugData(_object.functionDebugData);
 	if (_artifactRequested("linkReferences"))
@@ -403,7 +444,7 @@ Json::Value collectEVMObject(
 	if (_runtimeObject && _artifactRequested("immutableReferences"))
 		output["immutableReferences"] = formatImmutableReferences(_object.immutableReferences);
 	if (_artifactRequested("generatedSources"))
-		output["generatedSources"] = move(_generatedSources);
+		output["generatedSources"] = _generatedSources();
 	return output;
 }
 
@@ -439,25 +480,25 @@ std::optional<Json::Value> checkAuxiliaryInputKeys(Json::Value const& _input)
 
 std::optional<Json::Value> checkSettingsKeys(Json::Value const& _input)
 {
-	static set<string> keys{"parserErrorRecovery", "debug", "evmVersion", "libraries", "metadata", "modelChecker", "optimizer", "outputSelection", "remappings", "stopAfter", "viaIR"};
+	static set<string> keys{"analyzeOnlyRequestedContracts", "parserErrorRecovery", "debug", "evmVersion", "libraries", "metadata", "modelChecker", "optimizer", "outputSelection", "parallelism", "profiling", "remappings", "stopAfter", "viaIR"};
 	return checkKeys(_input, keys, "settings");
 }
 
 std::optional<Json::Value> checkModelCheckerSettingsKeys(Json::Value const& _input)
 {
-	static set<string> keys{"contracts", "divModNoSlacks", "engine", "invariants", "showUnproved", "solvers", "targets", "timeout"};
+	static set<string> keys{"contracts", "divModNoSlacks", "engine", "invariantCandidates", "invariants", "showCounterexamples", "showUnproved", "solvers", "targets", "timeout", "totalTimeout"};
 	return checkKeys(_input, keys, "modelChecker");
 }
 
 std::optional<Json::Value> checkOptimizerKeys(Json::Value const& _input)
 {
-	static set<string> keys{"details", "enabled", "runs"};
+	static set<string> keys{"details", "enabled", "executionProfile", "overrides", "runs"};
 	return checkKeys(_input, keys, "settings.optimizer");
 }
 
 std::optional<Json::Value> checkOptimizerDetailsKeys(Json::Value const& _input)
 {
-	static set<string> keys{"peephole", "inliner", "jumpdestRemover", "orderLiterals", "deduplicate", "cse", "constantOptimizer", "yul", "yulDetails"};
+	static set<string> keys{"peephole", "inliner", "jumpdestRemover", "orderLiterals", "deduplicate", "cse", "constantOptimizer", "superoptimizer", "blockLayout", "functionInliner", "stackLayoutEffort", "selectorDispatch", "lazyCalldataParameters", "reclaimTemporaryMemory", "yul", "yulDetails"};
 	return checkKeys(_input, keys, "settings.optimizer.details");
 }
 
@@ -499,6 +540,81 @@ std::optional<Json::Value> checkOptimizerDetailSteps(Json::Value const& _details
 	return {};
 }
 
+std::variant<shared_ptr<evmasm::ExecutionProfile const>, Json::Value> parseExecutionProfile(Json::Value const& _input)
+{
+	string const errorPrefix = "\"settings.optimizer.executionProfile\"";
+	if (!_input.isObject())
+		return formatFatalError("JSONError", errorPrefix + " must be an object mapping source unit names to lists of ranges.");
+
+	auto profile = make_shared<evmasm::ExecutionProfile>();
+	for (auto const& sourceName: _input.getMemberNames())
+	{
+		Json::Value const& ranges = _input[sourceName];
+		if (!ranges.isArray())
+			return formatFatalError("JSONError", errorPrefix + " must contain a list of ranges for source \"" + sourceName + "\".");
+		for (auto const& range: ranges)
+		{
+			if (auto result = checkKeys(range, {"start", "length", "count"}, "settings.optimizer.executionProfile." + sourceName))
+				return *result;
+			if (!range["start"].isUInt() || !range["length"].isUInt() || !range["count"].isUInt64())
+				return formatFatalError("JSONError", "Ranges in " + errorPrefix + " must have unsigned \"start\", \"length\" and \"count\" fields.");
+			uint64_t start = range["start"].asUInt();
+			uint64_t end = start + range["length"].asUInt();
+			if (end > uint64_t(numeric_limits<int>::max()))
+				return formatFatalError("JSONError", "Range in " + errorPrefix + " is out of bounds.");
+			profile->add(sourceName, static_cast<int>(start), static_cast<int>(end), range["count"].asUInt64());
+		}
+	}
+	return {move(profile)};
+}
+
+std::variant<map<string, map<string, OptimiserSettingsOverride>>, Json::Value> parseOptimizerOverrides(Json::Value const& _input)
+{
+	if (!_input.isObject())
+		return formatFatalError("JSONError", "\"settings.optimizer.overrides\" must be an object mapping source unit names to contracts.");
+
+	map<string, map<string, OptimiserSettingsOverride>> overrides;
+	for (auto const& sourceName: _input.getMemberNames())
+	{
+		Json::Value const& contracts = _input[sourceName];
+		if (!contracts.isObject())
+			return formatFatalError("JSONError", "\"settings.optimizer.overrides." + sourceName + "\" must be an object mapping contract names to settings.");
+		for (auto const& contractName: contracts.getMemberNames())
+		{
+			string const name = "settings.optimizer.overrides." + sourceName + "." + contractName;
+			Json::Value const& settings = contracts[contractName];
+			if (auto result = checkKeys(settings, {"runs", "optimizerSteps"}, name))
+				return *result;
+
+			OptimiserSettingsOverride& contractOverride = overrides[sourceName][contractName];
+			if (settings.isMember("runs"))
+			{
+				if (!settings["runs"].isUInt())
+					return formatFatalError("JSONError", "\"" + name + ".runs\" must be an unsigned number.");
+				contractOverride.expectedExecutionsPerDeployment = settings["runs"].asUInt();
+			}
+			if (settings.isMember("optimizerSteps"))
+			{
+				if (!settings["optimizerSteps"].isString())
+					return formatFatalError("JSONError", "\"" + name + ".optimizerSteps\" must be a string");
+				try
+				{
+					yul::OptimiserSuite::validateSequence(settings["optimizerSteps"].asString());
+				}
+				catch (yul::OptimizerException const& _exception)
+				{
+					return formatFatalError(
+						"JSONError",
+						"Invalid optimizer step sequence in \"" + name + ".optimizerSteps\": " + _exception.what()
+					);
+				}
+				contractOverride.yulOptimiserSteps = settings["optimizerSteps"].asString();
+			}
+		}
+	}
+	return {move(overrides)};
+}
+
 std::optional<Json::Value> checkMetadataKeys(Json::Value const& _input)
 {
 	if (_input.isObject())
@@ -584,6 +700,14 @@ std::variant<OptimiserSettings, Json::Value> parseOptimizerSettings(Json::Value
 		settings.expectedExecutionsPerDeployment = _jsonInput["runs"].asUInt();
 	}
 
+	if (_jsonInput.isMember("executionProfile"))
+	{
+		auto profile = parseExecutionProfile(_jsonInput["executionProfile"]);
+		if (auto const* error = get_if<Json::Value>(&profile))
+			return *error;
+		settings.executionProfile = move(get<shared_ptr<evmasm::ExecutionProfile const>>(profile));
+	}
+
 	if (_jsonInput.isMember("details"))
 	{
 		Json::Value const& details = _jsonInput["details"];
@@ -604,6 +728,31 @@ std::variant<OptimiserSettings, Json::Value> parseOptimizerSettings(Json::Value
 			return *error;
 		if (auto error = checkOptimizerDetail(details, "constantOptimizer", settings.runConstantOptimiser))
 			return *error;
+		if (auto error = checkOptimizerDetail(details, "superoptimizer", settings.runSuperoptimiser))
+			return *error;
+		if (auto error = checkOptimizerDetail(details, "blockLayout", settings.runBlockLayout))
+			return *error;
+		if (auto error = checkOptimizerDetail(details, "functionInliner", settings.runFunctionInliner))
+			return *error;
+		if (details.isMember("stackLayoutEffort"))
+		{
+			if (!details["stackLayoutEffort"].isUInt())
+				return formatFatalError("JSONError", "\"settings.optimizer.details.stackLayoutEffort\" must be an unsigned integer.");
+			settings.stackLayoutEffort = details["stackLayoutEffort"].asUInt();
+		}
+		if (details.isMember("selectorDispatch"))
+		{
+			optional<SelectorDispatch> selectorDispatch;
+			if (details["selectorDispatch"].isString())
+				selectorDispatch = selectorDispatchFromString(details["selectorDispatch"].asString());
+			if (!selectorDispatch)
+				return formatFatalError("JSONError", "\"settings.optimizer.details.selectorDispatch\" must be \"switch\", \"binarySearch\" or \"auto\".");
+			settings.selectorDispatch = *selectorDispatch;
+		}
+		if (auto error = checkOptimizerDetail(details, "lazyCalldataParameters", settings.lazyCalldataParameters))
+			return *error;
+		if (auto error = checkOptimizerDetail(details, "reclaimTemporaryMemory", settings.reclaimTemporaryMemory))
+			return *error;
 		if (auto error = checkOptimizerDetail(details, "yul", settings.runYulOptimiser))
 			return *error;
 		settings.optimizeStackAllocation = settings.runYulOptimiser;
@@ -612,14 +761,40 @@ std::variant<OptimiserSettings, Json::Value> parseOptimizerSettings(Json::Value
 			if (!settings.runYulOptimiser)
 				return formatFatalError("JSONError", "\"Providing yulDetails requires Yul optimizer to be enabled.");
 
-			if (auto result = checkKeys(details["yulDetails"], {"stackAllocation", "optimizerSteps"}, "settings.optimizer.details.yulDetails"))
+			if (auto result = checkKeys(details["yulDetails"], {"stackAllocation", "optimizerSteps", "stepBudget", "autotuneCandidates", "selectSteps"}, "settings.optimizer.details.yulDetails"))
 				return *result;
 			if (auto error = checkOptimizerDetail(details["yulDetails"], "stackAllocation", settings.optimizeStackAllocation))
 				return *error;
 			if (auto error = checkOptimizerDetailSteps(details["yulDetails"], "optimizerSteps", settings.yulOptimiserSteps))
 				return *error;
+			if (details["yulDetails"].isMember("stepBudget"))
+			{
+				if (!details["yulDetails"]["stepBudget"].isUInt())
+					return formatFatalError("JSONError", "\"settings.optimizer.details.yulDetails.stepBudget\" must be an unsigned integer.");
+				settings.yulOptimiserStepBudget = details["yulDetails"]["stepBudget"].asUInt();
+			}
+			if (details["yulDetails"].isMember("autotuneCandidates"))
+			{
+				if (!details["yulDetails"]["autotuneCandidates"].isUInt())
+					return formatFatalError("JSONError", "\"settings.optimizer.details.yulDetails.autotuneCandidates\" must be an unsigned integer.");
+				settings.yulOptimiserAutotuneCandidates = details["yulDetails"]["autotuneCandidates"].asUInt();
+			}
+			if (auto error = checkOptimizerDetail(details["yulDetails"], "selectSteps", settings.selectYulOptimiserSteps))
+				return *error;
 		}
 	}
+
+	if (_jsonInput.isMember("overrides"))
+	{
+		auto overrides = parseOptimizerOverrides(_jsonInput["overrides"]);
+		if (auto const* error = get_if<Json::Value>(&overrides))
+			return *error;
+		settings.contractOverrides = move(get<map<string, map<string, OptimiserSettingsOverride>>>(overrides));
+		for (auto const& [sourceName, contracts]: settings.contractOverrides)
+			for (auto const& [contractName, contractOverride]: contracts)
+				if (contractOverride.yulOptimiserSteps && !settings.runYulOptimiser)
+					return formatFatalError("JSONError", "Providing \"optimizerSteps\" in \"settings.optimizer.overrides\" requires Yul optimizer to be enabled.");
+	}
 	return { std::move(settings) };
 }
 
@@ -669,7 +844,7 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 					"Mismatch between content and supplied hash for \"" + sourceName + "\""
 				));
 			else
-				ret.sources[sourceName] = content;
+				ret.sources[sourceName] = move(content);
 		}
 		else if (sources[sourceName]["urls"].isArray())
 		{
@@ -695,7 +870,7 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 						));
 					else
 					{
-						ret.sources[sourceName] = result.responseOrErrorMessage;
+						ret.sources[sourceName] = move(result.responseOrErrorMessage);
 						found = true;
 						break;
 					}
@@ -785,6 +960,29 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 		ret.viaIR = settings["viaIR"].asBool();
 	}
 
+	if (settings.isMember("analyzeOnlyRequestedContracts"))
+	{
+		if (!settings["analyzeOnlyRequestedContracts"].isBool())
+			return formatFatalError("JSONError", "\"settings.analyzeOnlyRequestedContracts\" must be a Boolean.");
+		ret.analyzeOnlyRequestedContracts = settings["analyzeOnlyRequestedContracts"].asBool();
+	}
+
+	if (settings.isMember("profiling"))
+	{
+		if (!settings["profiling"].isBool())
+			return formatFatalError("JSONError", "\"settings.profiling\" must be a Boolean.");
+		ret.profiling = settings["profiling"].asBool();
+	}
+
+	if (settings.isMember("parallelism"))
+	{
+		if (!settings["parallelism"].isUInt())
+			return formatFatalError("JSONError", "\"settings.parallelism\" must be an unsigned integer.");
+		ret.parallelism = settings["parallelism"].asUInt();
+		if (ret.parallelism == 0)
+			ret.parallelism = util::ThreadPool::hardwareConcurrency();
+	}
+
 	if (settings.isMember("evmVersion"))
 	{
 		if (!settings["evmVersion"].isString())
@@ -987,6 +1185,36 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 		ret.modelCheckerSettings.engine = *engine;
 	}
 
+	if (modelCheckerSettings.isMember("invariantCandidates"))
+	{
+		auto const& sources = modelCheckerSettings["invariantCandidates"];
+		if (!sources.isObject())
+			return formatFatalError("JSONError", "settings.modelChecker.invariantCandidates is not a JSON object.");
+
+		map<string, map<string, set<string>>> candidates;
+		for (auto const& source: sources.getMemberNames())
+		{
+			auto const& contracts = sources[source];
+			if (!contracts.isObject())
+				return formatFatalError("JSONError", "The invariant candidates of a source must be a JSON object.");
+
+			for (auto const& contract: contracts.getMemberNames())
+			{
+				auto const& invariants = contracts[contract];
+				if (!invariants.isArray())
+					return formatFatalError("JSONError", "The invariant candidates of a contract must be an array.");
+
+				for (auto const& invariant: invariants)
+				{
+					if (!invariant.isString())
+						return formatFatalError("JSONError", "Every invariant candidate in settings.modelChecker.invariantCandidates must be a string.");
+					candidates[source][contract].insert(invariant.asString());
+				}
+			}
+		}
+		ret.modelCheckerSettings.invariantCandidates = move(candidates);
+	}
+
 	if (modelCheckerSettings.isMember("invariants"))
 	{
 		auto const& invariantsArray = modelCheckerSettings["invariants"];
@@ -1008,6 +1236,14 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 		ret.modelCheckerSettings.invariants = invariants;
 	}
 
+	if (modelCheckerSettings.isMember("showCounterexamples"))
+	{
+		auto const& showCounterexamples = modelCheckerSettings["showCounterexamples"];
+		if (!showCounterexamples.isBool())
+			return formatFatalError("JSONError", "settings.modelChecker.showCounterexamples must be a Boolean value.");
+		ret.modelCheckerSettings.showCounterexamples = showCounterexamples.asBool();
+	}
+
 	if (modelCheckerSettings.isMember("showUnproved"))
 	{
 		auto const& showUnproved = modelCheckerSettings["showUnproved"];
@@ -1062,10 +1298,17 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 		ret.modelCheckerSettings.timeout = modelCheckerSettings["timeout"].asUInt();
 	}
 
+	if (modelCheckerSettings.isMember("totalTimeout"))
+	{
+		if (!modelCheckerSettings["totalTimeout"].isUInt())
+			return formatFatalError("JSONError", "settings.modelChecker.totalTimeout must be an unsigned integer.");
+		ret.modelCheckerSettings.totalTimeout = modelCheckerSettings["totalTimeout"].asUInt();
+	}
+
 	return { std::move(ret) };
 }
 
-Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inputsAndSettings)
+Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inputsAndSettings, util::JsonStreamWriter* _writer)
 {
 	CompilerStack compilerStack(m_readFile);
 
@@ -1074,6 +1317,10 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 	for (auto const& smtLib2Response: _inputsAndSettings.smtLib2Responses)
 		compilerStack.addSMTLib2Response(smtLib2Response.first, smtLib2Response.second);
 	compilerStack.setViaIR(_inputsAndSettings.viaIR);
+	compilerStack.setParallelism(_inputsAndSettings.parallelism);
+	compilerStack.setArtifactCache(m_artifactCache);
+	compilerStack.setBatchReadCallback(m_batchReadFile);
+	compilerStack.setAnalyzeOnlyRequestedContracts(_inputsAndSettings.analyzeOnlyRequestedContracts);
 	compilerStack.setEVMVersion(_inputsAndSettings.evmVersion);
 	compilerStack.setParserErrorRecovery(_inputsAndSettings.parserErrorRecovery);
 	compilerStack.setRemappings(move(_inputsAndSettings.remappings));
@@ -1090,6 +1337,7 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 	compilerStack.enableEvmBytecodeGeneration(isEvmBytecodeRequested(_inputsAndSettings.outputSelection));
 	compilerStack.enableIRGeneration(isIRRequested(_inputsAndSettings.outputSelection));
 	compilerStack.enableEwasmGeneration(isEwasmRequested(_inputsAndSettings.outputSelection));
+	compilerStack.enableDebugInfoGeneration(isDebugInfoRequested(_inputsAndSettings.outputSelection));
 
 	Json::Value errors = std::move(_inputsAndSettings.errors);
 
@@ -1244,6 +1492,13 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 		for (string const& query: compilerStack.unhandledSMTLib2Queries())
 			output["auxiliaryInputRequested"]["smtlib2queries"]["0x" + util::keccak256(query).hex()] = query;
 
+	// Members are streamed in the order of their keys, which are sorted in the output.
+	if (_writer && output.isMember("auxiliaryInputRequested"))
+	{
+		_writer->writeMember("auxiliaryInputRequested", output["auxiliaryInputRequested"]);
+		output.removeMember("auxiliaryInputRequested");
+	}
+
 	bool const wildcardMatchesExperimental = false;
 
 	output["sources"] = Json::objectValue;
@@ -1258,101 +1513,137 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 			output["sources"][sourceName] = sourceResult;
 		}
 
-	Json::Value contractsOutput = Json::objectValue;
+	// Contracts grouped by source in the order of the keys in the output.
+	map<string, map<string, string>> contractsBySource;
 	for (string const& contractName: analysisPerformed ? compilerStack.contractNames() : vector<string>())
 	{
 		size_t colon = contractName.rfind(':');
 		solAssert(colon != string::npos, "");
-		string file = contractName.substr(0, colon);
-		string name = contractName.substr(colon + 1);
-
-		// ABI, storage layout, documentation and metadata
-		Json::Value contractData(Json::objectValue);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "abi", wildcardMatchesExperimental))
-			contractData["abi"] = compilerStack.contractABI(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "storageLayout", false))
-			contractData["storageLayout"] = compilerStack.storageLayout(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "metadata", wildcardMatchesExperimental))
-			contractData["metadata"] = compilerStack.metadata(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "userdoc", wildcardMatchesExperimental))
-			contractData["userdoc"] = compilerStack.natspecUser(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "devdoc", wildcardMatchesExperimental))
-			contractData["devdoc"] = compilerStack.natspecDev(contractName);
-
-		// IR
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ir", wildcardMatchesExperimental))
-			contractData["ir"] = compilerStack.yulIR(contractName);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "irOptimized", wildcardMatchesExperimental))
-			contractData["irOptimized"] = compilerStack.yulIROptimized(contractName);
-
-		// Ewasm
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ewasm.wast", wildcardMatchesExperimental))
-			contractData["ewasm"]["wast"] = compilerStack.ewasm(contractName);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ewasm.wasm", wildcardMatchesExperimental))
-			contractData["ewasm"]["wasm"] = compilerStack.ewasmObject(contractName).toHex();
-
-		// EVM
-		Json::Value evmData(Json::objectValue);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.assembly", wildcardMatchesExperimental))
-			evmData["assembly"] = compilerStack.assemblyString(contractName, sourceList);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.legacyAssembly", wildcardMatchesExperimental))
-			evmData["legacyAssembly"] = compilerStack.assemblyJSON(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.methodIdentifiers", wildcardMatchesExperimental))
-			evmData["methodIdentifiers"] = compilerStack.methodIdentifiers(contractName);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.gasEstimates", wildcardMatchesExperimental))
-			evmData["gasEstimates"] = compilerStack.gasEstimates(contractName);
-
-		if (compilationSuccess && isArtifactRequested(
-			_inputsAndSettings.outputSelection,
-			file,
-			name,
-			evmObjectComponents("bytecode"),
-			wildcardMatchesExperimental
-		))
-			evmData["bytecode"] = collectEVMObject(
-				compilerStack.object(contractName),
-				compilerStack.sourceMapping(contractName),
-				compilerStack.generatedSources(contractName),
-				false,
-				[&](string const& _element) { return isArtifactRequested(
-					_inputsAndSettings.outputSelection,
-					file,
-					name,
-					"evm.bytecode." + _element,
-					wildcardMatchesExperimental
-				); }
-			);
+		contractsBySource[contractName.substr(0, colon)][contractName.substr(colon + 1)] = contractName;
+	}
 
-		if (compilationSuccess && isArtifactRequested(
-			_inputsAndSettings.outputSelection,
-			file,
-			name,
-			evmObjectComponents("deployedBytecode"),
-			wildcardMatchesExperimental
-		))
-			evmData["deployedBytecode"] = collectEVMObject(
-				compilerStack.runtimeObject(contractName),
-				compilerStack.runtimeSourceMapping(contractName),
-				compilerStack.generatedSources(contractName, true),
-				true,
-				[&](string const& _element) { return isArtifactRequested(
-					_inputsAndSettings.outputSelection,
-					file,
-					name,
-					"evm.deployedBytecode." + _element,
-					wildcardMatchesExperimental
-				); }
-			);
+	Json::Value contractsOutput = Json::objectValue;
+	optional<string> streamedSource;
+	// Not using structured bindings, since they cannot be captured by the lambdas below.
+	for (auto const& sourceContracts: contractsBySource)
+		for (auto const& contract: sourceContracts.second)
+		{
+			string const& file = sourceContracts.first;
+			string const& name = contract.first;
+			string const& contractName = contract.second;
+
+			// ABI, storage layout, documentation and metadata
+			Json::Value contractData(Json::objectValue);
+			if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "abi", wildcardMatchesExperimental))
+				contractData["abi"] = compilerStack.contractABI(contractName);
+			if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "storageLayout", false))
+				contractData["storageLayout"] = compilerStack.storageLayout(contractName);
+			if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "metadata", wildcardMatchesExperimental))
+				contractData["metadata"] = compilerStack.metadata(contractName);
+			if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "userdoc", wildcardMatchesExperimental))
+				contractData["userdoc"] = compilerStack.natspecUser(contractName);
+			if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "devdoc", wildcardMatchesExperimental))
+				contractData["devdoc"] = compilerStack.natspecDev(contractName);
+
+			// IR
+			if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ir", wildcardMatchesExperimental))
+				contractData["ir"] = compilerStack.yulIR(contractName);
+			if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "irOptimized", wildcardMatchesExperimental))
+				contractData["irOptimized"] = compilerStack.yulIROptimized(contractName);
+
+			// Ewasm
+			if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ewasm.wast", wildcardMatchesExperimental))
+				contractData["ewasm"]["wast"] = compilerStack.ewasm(contractName);
+			if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ewasm.wasm", wildcardMatchesExperimental))
+				contractData["ewasm"]["wasm"] = compilerStack.ewasmObject(contractName).toHex();
+
+			// EVM
+			Json::Value evmData(Json::objectValue);
+			if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.assembly", wildcardMatchesExperimental))
+				evmData["assembly"] = compilerStack.assemblyString(contractName, sourceList);
+			if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.legacyAssembly", wildcardMatchesExperimental))
+				evmData["legacyAssembly"] = compilerStack.assemblyJSON(contractName);
+			if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.methodIdentifiers", wildcardMatchesExperimental))
+				evmData["methodIdentifiers"] = compilerStack.methodIdentifiers(contractName);
+			if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.gasEstimates", wildcardMatchesExperimental))
+				evmData["gasEstimates"] = compilerStack.gasEstimates(contractName);
+
+			if (compilationSuccess && isArtifactRequested(
+				_inputsAndSettings.outputSelection,
+				file,
+				name,
+				evmObjectComponents("bytecode"),
+				wildcardMatchesExperimental
+			))
+				evmData["bytecode"] = collectEVMObject(
+					compilerStack.object(contractName),
+					[&]() { return compilerStack.sourceMapping(contractName); },
+					[&]() { return compilerStack.generatedSources(contractName); },
+					false,
+					[&](string const& _element) { return isArtifactRequested(
+						_inputsAndSettings.outputSelection,
+						file,
+						name,
+						"evm.bytecode." + _element,
+						wildcardMatchesExperimental
+					); }
+				);
 
-		if (!evmData.empty())
-			contractData["evm"] = evmData;
+			if (compilationSuccess && isArtifactRequested(
+				_inputsAndSettings.outputSelection,
+				file,
+				name,
+				evmObjectComponents("deployedBytecode"),
+				wildcardMatchesExperimental
+			))
+				evmData["deployedBytecode"] = collectEVMObject(
+					compilerStack.runtimeObject(contractName),
+					[&]() { return compilerStack.runtimeSourceMapping(contractName); },
+					[&]() { return compilerStack.generatedSources(contractName, true); },
+					true,
+					[&](string const& _element) { return isArtifactRequested(
+						_inputsAndSettings.outputSelection,
+						file,
+						name,
+						"evm.deployedBytecode." + _element,
+						wildcardMatchesExperimental
+					); }
+				);
 
-		if (!contractData.empty())
-		{
-			if (!contractsOutput.isMember(file))
-				contractsOutput[file] = Json::objectValue;
-			contractsOutput[file][name] = contractData;
+			if (!evmData.empty())
+				contractData["evm"] = evmData;
+
+			// The results of the contract are not needed anymore, so they are released before
+			// the next contract adds its outputs.
+			compilerStack.releaseContract(contractName);
+
+			if (contractData.empty())
+				continue;
+			if (_writer)
+			{
+				if (!streamedSource)
+					_writer->beginObject("contracts");
+				if (streamedSource != file)
+				{
+					if (streamedSource)
+						_writer->endObject();
+					_writer->beginObject(file);
+					streamedSource = file;
+				}
+				_writer->writeMember(name, contractData);
+			}
+			else
+			{
+				if (!contractsOutput.isMember(file))
+					contractsOutput[file] = Json::objectValue;
+				contractsOutput[file][name] = std::move(contractData);
+			}
 		}
+	if (streamedSource)
+	{
+		// Finish the objects of the last source and of "contracts".
+		_writer->endObject();
+		_writer->endObject();
 	}
 	if (!contractsOutput.empty())
 		output["contracts"] = contractsOutput;
@@ -1483,8 +1774,8 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 				output["contracts"][sourceName][contractName]["evm"][objectKind] =
 					collectEVMObject(
 						*o.bytecode,
-						o.sourceMappings.get(),
-						Json::arrayValue,
+						[&]() { return o.sourceMappings.get(); },
+						[]() { return Json::Value{Json::arrayValue}; },
 						false,
 						[&](string const& _element) { return isArtifactRequested(
 							_inputsAndSettings.outputSelection,
@@ -1506,6 +1797,11 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 
 
 Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
+{
+	return compile(_input, nullptr);
+}
+
+Json::Value StandardCompiler::compile(Json::Value const& _input, util::JsonStreamWriter* _writer) noexcept
 {
 	YulStringRepository::reset();
 
@@ -1515,12 +1811,22 @@ Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
 		if (std::holds_alternative<Json::Value>(parsed))
 			return std::get<Json::Value>(std::move(parsed));
 		InputsAndSettings settings = std::get<InputsAndSettings>(std::move(parsed));
+		bool const profiling = settings.profiling;
+		if (profiling)
+			util::Profiler::instance().enable();
+		ScopeGuard disableProfiler{[]() { util::Profiler::instance().disable(); }};
+
+		Json::Value output;
 		if (settings.language == "Solidity")
-			return compileSolidity(std::move(settings));
+			output = compileSolidity(std::move(settings), _writer);
 		else if (settings.language == "Yul")
-			return compileYul(std::move(settings));
+			output = compileYul(std::move(settings));
 		else
 			return formatFatalError("JSONError", "Only \"Solidity\" or \"Yul\" is supported as a language.");
+
+		if (profiling)
+			output["profiling"] = util::Profiler::instance().toJson();
+		return output;
 	}
 	catch (Json::LogicError const& _exception)
 	{
@@ -1568,6 +1874,36 @@ string StandardCompiler::compile(string const& _input) noexcept
 	}
 }
 
+void StandardCompiler::compile(string const& _input, ostream& _output)
+{
+	Json::Value input;
+	string errors;
+	try
+	{
+		if (!util::jsonParseStrict(_input, input, &errors))
+		{
+			_output << util::jsonPrint(formatFatalError("JSONError", errors), m_jsonPrintingFormat);
+			return;
+		}
+	}
+	catch (...)
+	{
+		_output << "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error parsing input JSON.\"}]}";
+		return;
+	}
+
+	util::JsonStreamWriter writer(_output, m_jsonPrintingFormat);
+	writer.beginObject();
+	Json::Value output = compile(input, &writer);
+	// An internal error while writing the contracts leaves their objects open. The error is
+	// reported in "errors", which comes after "contracts".
+	while (writer.depth() > 1)
+		writer.endObject();
+	for (string const& key: output.getMemberNames())
+		writer.writeMember(key, output[key]);
+	writer.endObject();
+}
+
 Json::Value StandardCompiler::formatFunctionDebugData(
 	map<string, evmasm::LinkerObject::FunctionDebugData> const& _debugInfo
 )
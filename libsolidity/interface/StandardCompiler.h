@@ -62,6 +62,16 @@ public:
 	/// Parses input as JSON and peforms the above processing steps, returning a serialized JSON
 	/// output. Parsing errors are returned as regular errors.
 	std::string compile(std::string const& _input) noexcept;
+	/// Same as above, but writes the output to @a _output. The artifacts of each contract are
+	/// written as soon as they are generated and released afterwards, which keeps the peak memory
+	/// usage low for large outputs. The text is identical to the one returned above.
+	void compile(std::string const& _input, std::ostream& _output);
+
+	/// Sets the cache the compiler stacks of all following compilations use for their code generation artifacts.
+	void setArtifactCache(std::shared_ptr<ArtifactCache> _artifactCache) { m_artifactCache = std::move(_artifactCache); }
+	/// Sets the callback the compiler stacks use to read the imports of a parsing round at once,
+	/// see CompilerStack::setBatchReadCallback().
+	void setBatchReadCallback(ReadCallback::BatchCallback _batchReadFile) { m_batchReadFile = std::move(_batchReadFile); }
 
 	static Json::Value formatFunctionDebugData(
 		std::map<std::string, evmasm::LinkerObject::FunctionDebugData> const& _debugInfo
@@ -87,16 +97,24 @@ private:
 		Json::Value outputSelection;
 		ModelCheckerSettings modelCheckerSettings = ModelCheckerSettings{};
 		bool viaIR = false;
+		size_t parallelism = 1;
+		bool analyzeOnlyRequestedContracts = false;
+		bool profiling = false;
 	};
 
 	/// Parses the input json (and potentially invokes the read callback) and either returns
 	/// it in condensed form or an error as a json object.
 	std::variant<InputsAndSettings, Json::Value> parseInput(Json::Value const& _input);
 
-	Json::Value compileSolidity(InputsAndSettings _inputsAndSettings);
+	/// Performs compilation. If @a _writer is given, the "auxiliaryInputRequested" and "contracts"
+	/// members are written to it instead of being returned.
+	Json::Value compile(Json::Value const& _input, util::JsonStreamWriter* _writer) noexcept;
+	Json::Value compileSolidity(InputsAndSettings _inputsAndSettings, util::JsonStreamWriter* _writer = nullptr);
 	Json::Value compileYul(InputsAndSettings _inputsAndSettings);
 
 	ReadCallback::Callback m_readFile;
+	std::shared_ptr<ArtifactCache> m_artifactCache;
+	ReadCallback::BatchCallback m_batchReadFile;
 
 	util::JsonFormat m_jsonPrintingFormat;
 };
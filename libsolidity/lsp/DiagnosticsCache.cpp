@@ -0,0 +1,76 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/lsp/DiagnosticsCache.h>
+
+#include <libsolidity/interface/Version.h>
+
+#include <libsolutil/JSON.h>
+#include <libsolutil/Keccak256.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+using namespace solidity::lsp;
+using namespace solidity::util;
+
+void DiagnosticsCache::store(
+	string const& _sourceUnitName,
+	map<string, string const*> const& _sources,
+	Json::Value const& _diagnostics
+)
+{
+	Json::Value entry{Json::objectValue};
+	entry["sourceUnitName"] = _sourceUnitName;
+	entry["sources"] = Json::objectValue;
+	for (auto const& [name, content]: _sources)
+		entry["sources"][name] = keccak256(*content).hex();
+	entry["diagnostics"] = _diagnostics;
+	m_storage.store(entryKey(_sourceUnitName), jsonCompactPrint(entry));
+}
+
+optional<Json::Value> DiagnosticsCache::load(
+	string const& _sourceUnitName,
+	function<optional<string>(string const&)> const& _currentContent
+)
+{
+	optional<string> stored = m_storage.load(entryKey(_sourceUnitName));
+	Json::Value entry;
+	if (
+		!stored ||
+		!jsonParseStrict(*stored, entry) ||
+		!entry.isObject() ||
+		entry["sourceUnitName"] != _sourceUnitName ||
+		!entry["sources"].isObject() ||
+		!entry["diagnostics"].isArray()
+	)
+		return nullopt;
+
+	for (string const& name: entry["sources"].getMemberNames())
+	{
+		optional<string> content = _currentContent(name);
+		if (!content || entry["sources"][name] != keccak256(*content).hex())
+			return nullopt;
+	}
+	return entry["diagnostics"];
+}
+
+h256 DiagnosticsCache::entryKey(string const& _sourceUnitName)
+{
+	return keccak256("diagnostics\n" + VersionString + "\n" + _sourceUnitName);
+}
@@ -0,0 +1,68 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+#pragma once
+
+#include <libsolidity/interface/ArtifactCache.h>
+
+#include <json/value.h>
+
+#include <functional>
+#include <map>
+#include <optional>
+#include <string>
+
+namespace solidity::lsp
+{
+
+/**
+ * Diagnostics of source units stored in a directory by an earlier session of the language server,
+ * so that they can be published as soon as a file is opened instead of after its first compilation.
+ * They are only used if the compiler version and the contents of the source unit and of all the
+ * sources it imports are the same as when they were stored.
+ * The entries are stored in a DirectoryArtifactCache, so failures to read or write
+ * the directory are ignored.
+ */
+class DiagnosticsCache
+{
+public:
+	explicit DiagnosticsCache(boost::filesystem::path _directory): m_storage(std::move(_directory)) {}
+
+	/// Stores the diagnostics @a _diagnostics of @a _sourceUnitName, which was compiled
+	/// with the sources in @a _sources, given by name and content, including itself.
+	void store(
+		std::string const& _sourceUnitName,
+		std::map<std::string, std::string const*> const& _sources,
+		Json::Value const& _diagnostics
+	);
+
+	/// @returns the diagnostics stored for @a _sourceUnitName, or nullopt if there are none
+	/// or if the content of one of the sources they were computed from changed, according to
+	/// @a _currentContent, which returns the current content of a source or nullopt if it does not exist.
+	std::optional<Json::Value> load(
+		std::string const& _sourceUnitName,
+		std::function<std::optional<std::string>(std::string const&)> const& _currentContent
+	);
+
+private:
+	/// @returns the key of the entry of @a _sourceUnitName, which depends on the compiler version.
+	static util::h256 entryKey(std::string const& _sourceUnitName);
+
+	frontend::DirectoryArtifactCache m_storage;
+};
+
+}
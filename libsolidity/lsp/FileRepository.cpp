@@ -18,8 +18,14 @@
 
 #include <libsolidity/lsp/FileRepository.h>
 
+#include <liblangutil/Exceptions.h>
+
+#include <algorithm>
+#include <cstring>
+
 using namespace std;
 using namespace solidity;
+using namespace solidity::langutil;
 using namespace solidity::lsp;
 
 namespace
@@ -61,4 +67,80 @@ void FileRepository::setSourceByClientPath(string const& _uri, string _text)
 	// but we need to mostly rewrite this in a future version anyway.
 	m_sourceUnitNamesToClientPaths.emplace(clientPathToSourceUnitName(_uri), _uri);
 	m_fileReader.addOrUpdateFile(stripFilePrefix(_uri), move(_text));
+	m_lineStarts.erase(clientPathToSourceUnitName(_uri));
+}
+
+void FileRepository::replaceSourceRange(string const& _uri, size_t _start, size_t _end, string const& _text)
+{
+	string const sourceUnitName = clientPathToSourceUnitName(_uri);
+	lineStarts(sourceUnitName);
+	vector<size_t>& starts = m_lineStarts.at(sourceUnitName);
+	m_fileReader.replaceSourceRange(sourceUnitName, _start, _end, _text);
+
+	// The lines starting after a replaced line feed are gone, the ones after the range move
+	// and the line feeds of the new text start new lines.
+	size_t const first = static_cast<size_t>(upper_bound(starts.begin(), starts.end(), _start) - starts.begin());
+	size_t const last = static_cast<size_t>(upper_bound(starts.begin(), starts.end(), _end) - starts.begin());
+	for (size_t i = last; i < starts.size(); ++i)
+		starts[i] = starts[i] - (_end - _start) + _text.size();
+	vector<size_t> newStarts;
+	for (size_t offset = _text.find('\n'); offset != string::npos; offset = _text.find('\n', offset + 1))
+		newStarts.push_back(_start + offset + 1);
+	starts.erase(starts.begin() + static_cast<ptrdiff_t>(first), starts.begin() + static_cast<ptrdiff_t>(last));
+	starts.insert(starts.begin() + static_cast<ptrdiff_t>(first), newStarts.begin(), newStarts.end());
+}
+
+void FileRepository::retainClientPaths(set<string> const& _uris)
+{
+	set<string> retained;
+	for (string const& uri: _uris)
+		retained.insert(clientPathToSourceUnitName(uri));
+
+	vector<string> removed;
+	for (auto const& [sourceUnitName, source]: m_fileReader.sourceUnits())
+		if (!retained.count(sourceUnitName))
+			removed.push_back(sourceUnitName);
+	for (string const& sourceUnitName: removed)
+	{
+		m_fileReader.removeSourceUnit(sourceUnitName);
+		m_sourceUnitNamesToClientPaths.erase(sourceUnitName);
+		m_lineStarts.erase(sourceUnitName);
+	}
+}
+
+optional<size_t> FileRepository::translateLineColumnToPosition(
+	string const& _sourceUnitName,
+	LineColumn const& _lineColumn
+) const
+{
+	if (!m_fileReader.sourceUnits().count(_sourceUnitName))
+		return nullopt;
+
+	vector<size_t> const& starts = lineStarts(_sourceUnitName);
+	if (_lineColumn.line < 0 || static_cast<size_t>(_lineColumn.line) >= starts.size() || _lineColumn.column < 0)
+		return nullopt;
+
+	size_t const line = static_cast<size_t>(_lineColumn.line);
+	size_t const endOfLine = line + 1 < starts.size() ?
+		starts[line + 1] - 1 :
+		m_fileReader.sourceUnits().at(_sourceUnitName).size();
+	if (starts[line] + static_cast<size_t>(_lineColumn.column) > endOfLine)
+		return nullopt;
+	return starts[line] + static_cast<size_t>(_lineColumn.column);
+}
+
+vector<size_t> const& FileRepository::lineStarts(string const& _sourceUnitName) const
+{
+	vector<size_t>& starts = m_lineStarts[_sourceUnitName];
+	if (starts.empty())
+	{
+		string const& source = m_fileReader.sourceUnits().at(_sourceUnitName);
+		starts.push_back(0);
+		// memchr() is usually much faster than comparing the characters one by one.
+		char const* const begin = source.data();
+		char const* const end = begin + source.size();
+		for (char const* it = begin; (it = static_cast<char const*>(memchr(it, '\n', size_t(end - it)))); )
+			starts.push_back(size_t(++it - begin));
+	}
+	return starts;
 }
@@ -19,8 +19,13 @@
 
 #include <libsolidity/interface/FileReader.h>
 
-#include <string>
+#include <liblangutil/SourceLocation.h>
+
 #include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
 
 namespace solidity::lsp
 {
@@ -42,12 +47,31 @@ public:
 	std::map<std::string, std::string> const& sourceUnits() const;
 	/// Changes the source identified by the LSP client path _uri to _text.
 	void setSourceByClientPath(std::string const& _uri, std::string _text);
+	/// Replaces the characters from @a _start up to @a _end of the existing source identified
+	/// by the LSP client path _uri by _text in place and updates its line index.
+	void replaceSourceRange(std::string const& _uri, size_t _start, size_t _end, std::string const& _text);
+	/// Removes all sources except the ones identified by the LSP client paths in @a _uris,
+	/// so that the others are read from disk again.
+	void retainClientPaths(std::set<std::string> const& _uris);
+
+	/// @returns the offset of @a _lineColumn in the source unit @a _sourceUnitName,
+	/// or nullopt if the source or the position does not exist.
+	std::optional<size_t> translateLineColumnToPosition(
+		std::string const& _sourceUnitName,
+		langutil::LineColumn const& _lineColumn
+	) const;
 
 	frontend::ReadCallback::Callback reader() { return m_fileReader.reader(); }
 
 private:
+	/// @returns the offsets at which the lines of the source unit @a _sourceUnitName start,
+	/// computing them if they are not known yet.
+	std::vector<size_t> const& lineStarts(std::string const& _sourceUnitName) const;
+
 	std::map<std::string, std::string> m_sourceUnitNamesToClientPaths;
 	frontend::FileReader m_fileReader;
+	/// Line start offsets by source unit name, kept up to date with edits of the open sources.
+	mutable std::map<std::string, std::vector<size_t>> m_lineStarts;
 };
 
 }
@@ -21,12 +21,15 @@
 #include <libsolidity/interface/ReadFile.h>
 #include <libsolidity/interface/StandardCompiler.h>
 #include <libsolidity/lsp/LanguageServer.h>
+#include <libsolidity/parsing/Parser.h>
 
 #include <liblangutil/SourceReferenceExtractor.h>
 #include <liblangutil/CharStream.h>
+#include <liblangutil/ErrorReporter.h>
 
 #include <libsolutil/Visitor.h>
 #include <libsolutil/JSON.h>
+#include <libsolutil/Profiler.h>
 
 #include <boost/exception/diagnostic_information.hpp>
 #include <boost/filesystem.hpp>
@@ -34,10 +37,13 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
 #include <ostream>
 #include <string>
+#include <thread>
 
 using namespace std;
+using namespace std::chrono;
 using namespace std::string_literals;
 using namespace std::placeholders;
 
@@ -48,6 +54,13 @@ using namespace solidity::frontend;
 namespace
 {
 
+/// How long the sources have to stay unchanged before they are compiled, so that
+/// a burst of edits, e.g. while typing, is compiled only once.
+chrono::milliseconds const compilationDelay{150};
+/// How long the sources have to stay unchanged before the edited ones are parsed on their own
+/// to report syntax errors ahead of the compilation.
+chrono::milliseconds const syntaxCheckDelay{30};
+
 Json::Value toJson(LineColumn _pos)
 {
 	Json::Value json = Json::objectValue;
@@ -86,25 +99,51 @@ int toDiagnosticSeverity(Error::Type _errorType)
 	return -1;
 }
 
+/// @returns the LSP Diagnostic for @a _error at @a _range, without related information.
+Json::Value toDiagnostic(Error const& _error, Json::Value _range)
+{
+	Json::Value jsonDiag;
+	jsonDiag["source"] = "solc";
+	jsonDiag["severity"] = toDiagnosticSeverity(_error.type());
+	jsonDiag["code"] = Json::UInt64{_error.errorId().error};
+	string message = _error.typeName() + ":";
+	if (string const* comment = _error.comment())
+		message += " " + *comment;
+	jsonDiag["message"] = move(message);
+	jsonDiag["range"] = move(_range);
+	return jsonDiag;
+}
+
 }
 
 LanguageServer::LanguageServer(Transport& _transport):
 	m_client{_transport},
 	m_handlers{
-		{"$/cancelRequest", [](auto, auto) {/*nothing for now as we are synchronous */}},
-		{"cancelRequest", [](auto, auto) {/*nothing for now as we are synchronous */}},
+		{"$/cancelRequest", [](auto, auto) {/* handled by readMessages() */}},
+		{"$/setTrace", bind(&LanguageServer::handleSetTrace, this, _2)},
+		{"$/solidity/stats", bind(&LanguageServer::handleSolidityStats, this, _1)},
+		{"cancelRequest", [](auto, auto) {/* handled by readMessages() */}},
 		{"exit", [this](auto, auto) { m_state = (m_state == State::ShutdownRequested ? State::ExitRequested : State::ExitWithoutShutdown); }},
 		{"initialize", bind(&LanguageServer::handleInitialize, this, _1, _2)},
 		{"initialized", [](auto, auto) {}},
-		{"shutdown", [this](auto, auto) { m_state = State::ShutdownRequested; }},
+		{"shutdown", [this](auto, auto) {
+			storeDiagnostics();
+			m_state = State::ShutdownRequested;
+		}},
 		{"textDocument/didOpen", bind(&LanguageServer::handleTextDocumentDidOpen, this, _2)},
 		{"textDocument/didChange", bind(&LanguageServer::handleTextDocumentDidChange, this, _2)},
 		{"textDocument/didClose", bind(&LanguageServer::handleTextDocumentDidClose, this, _2)},
+		{"textDocument/definition", bind(&LanguageServer::handleTextDocumentDefinition, this, _1, _2)},
+		{"textDocument/references", bind(&LanguageServer::handleTextDocumentReferences, this, _1, _2)},
 		{"workspace/didChangeConfiguration", bind(&LanguageServer::handleWorkspaceDidChangeConfiguration, this, _2)},
+		{"workspace/symbol", bind(&LanguageServer::handleWorkspaceSymbol, this, _1, _2)},
 	},
 	m_fileRepository("/" /* basePath */),
 	m_compilerStack{m_fileRepository.reader()}
 {
+	// The durations of the compiler phases are part of the statistics. This process only
+	// runs the language server, so the profiler is not shared with anything else.
+	util::Profiler::instance().enable();
 }
 
 optional<SourceLocation> LanguageServer::parsePosition(
@@ -112,15 +151,12 @@ optional<SourceLocation> LanguageServer::parsePosition(
 	Json::Value const& _position
 ) const
 {
-	if (!m_fileRepository.sourceUnits().count(_sourceUnitName))
-		return nullopt;
-
 	if (optional<LineColumn> lineColumn = parseLineColumn(_position))
-		if (optional<int> const offset = CharStream::translateLineColumnToPosition(
-			m_fileRepository.sourceUnits().at(_sourceUnitName),
-			*lineColumn
-		))
-			return SourceLocation{*offset, *offset, make_shared<string>(_sourceUnitName)};
+		if (optional<size_t> const offset = m_fileRepository.translateLineColumnToPosition(_sourceUnitName, *lineColumn))
+		{
+			int const position = static_cast<int>(*offset);
+			return SourceLocation{position, position, make_shared<string>(_sourceUnitName)};
+		}
 	return nullopt;
 }
 
@@ -167,33 +203,198 @@ void LanguageServer::compile()
 {
 	// For files that are not open, we have to take changes on disk into account,
 	// so we just remove all non-open files.
+	m_fileRepository.retainClientPaths(m_openFiles);
 
-	FileRepository oldRepository(m_fileRepository.basePath());
-	swap(oldRepository, m_fileRepository);
+	util::Profiler::Scope profilerScope{"language server compilation"};
+	{
+		util::Profiler::Scope updateScope{"source update"};
+		// Only the changed files and the files importing them are analysed again.
+		m_compilerStack.updateSources(m_fileRepository.sourceUnits());
+	}
+	m_compilerStack.compile(CompilerStack::State::AnalysisPerformed);
+	util::Profiler::Scope indexScope{"symbol indexing"};
+	updateSymbolIndex();
+}
+
+void LanguageServer::updateSymbolIndex()
+{
+	vector<string> const sourceNames = m_compilerStack.sourceNames();
+	set<string> const compiledSources(sourceNames.begin(), sourceNames.end());
+	for (string const& sourceUnitName: m_symbolIndex.sourceUnitNames())
+		if (!compiledSources.count(sourceUnitName))
+			m_symbolIndex.remove(sourceUnitName);
+
+	// Without a successful parse there are no complete ASTs and the previous index is kept.
+	if (m_compilerStack.state() < CompilerStack::State::AnalysisPerformed)
+		return;
+
+	// The ASTs of the reused sources did not change since they were indexed.
+	for (string const& sourceUnitName: sourceNames)
+		if (!m_compilerStack.isReusedSource(sourceUnitName) || !m_symbolIndex.contains(sourceUnitName))
+			m_symbolIndex.update(sourceUnitName, m_compilerStack.ast(sourceUnitName));
+}
+
+bool LanguageServer::publishCachedDiagnostics(string const& _sourceUnitName)
+{
+	if (!m_diagnosticsCache)
+		return false;
+
+	optional<Json::Value> diagnostics = m_diagnosticsCache->load(
+		_sourceUnitName,
+		[this](string const& _name) -> optional<string> {
+			auto source = m_fileRepository.sourceUnits().find(_name);
+			if (source != m_fileRepository.sourceUnits().end())
+				return source->second;
+			ReadCallback::Result result = m_fileRepository.reader()(ReadCallback::kindString(ReadCallback::Kind::ReadFile), _name);
+			if (!result.success)
+				return nullopt;
+			return result.responseOrErrorMessage;
+		}
+	);
+	if (!diagnostics)
+		return false;
 
-	for (string const& fileName: m_openFiles)
-		m_fileRepository.setSourceByClientPath(
-			fileName,
-			oldRepository.sourceUnits().at(oldRepository.clientPathToSourceUnitName(fileName))
+	if (diagnostics->empty())
+		m_publishedDiagnostics.erase(_sourceUnitName);
+	else
+		m_publishedDiagnostics[_sourceUnitName] = *diagnostics;
+	Json::Value params;
+	params["uri"] = m_fileRepository.sourceUnitNameToClientPath(_sourceUnitName);
+	params["diagnostics"] = move(*diagnostics);
+	m_client.notify("textDocument/publishDiagnostics", move(params));
+	return true;
+}
+
+void LanguageServer::storeDiagnostics()
+{
+	// Only the diagnostics of a completed analysis of the current sources are stored.
+	if (!m_diagnosticsCache || m_compilationDue || m_compilerStack.state() < CompilerStack::State::AnalysisPerformed)
+		return;
+
+	vector<string> const sourceNames = m_compilerStack.sourceNames();
+	for (string const& uri: m_openFiles)
+	{
+		string const sourceUnitName = m_fileRepository.clientPathToSourceUnitName(uri);
+		if (find(sourceNames.begin(), sourceNames.end(), sourceUnitName) == sourceNames.end())
+			continue;
+
+		// The diagnostics only depend on the source unit itself and the ones it imports.
+		SourceUnit const& ast = m_compilerStack.ast(sourceUnitName);
+		map<string, string const*> sources;
+		sources[sourceUnitName] = &m_compilerStack.charStream(sourceUnitName).source();
+		for (SourceUnit const* imported: ast.referencedSourceUnits(true))
+			if (imported->location().sourceName)
+			{
+				string const& name = *imported->location().sourceName;
+				sources[name] = &m_compilerStack.charStream(name).source();
+			}
+
+		auto published = m_publishedDiagnostics.find(sourceUnitName);
+		m_diagnosticsCache->store(
+			sourceUnitName,
+			sources,
+			published == m_publishedDiagnostics.end() ? Json::Value{Json::arrayValue} : published->second
 		);
+	}
+}
 
-	// TODO: optimize! do not recompile if nothing has changed (file(s) not flagged dirty).
+void LanguageServer::compilePendingChanges()
+{
+	if (m_compilationDue)
+		compileAndUpdateDiagnostics();
+}
 
-	m_compilerStack.reset(false);
-	m_compilerStack.setSources(m_fileRepository.sourceUnits());
-	m_compilerStack.compile(CompilerStack::State::AnalysisPerformed);
+optional<SourceLocation> LanguageServer::declarationAtPosition(Json::Value const& _params)
+{
+	string const sourceUnitName = m_fileRepository.clientPathToSourceUnitName(_params["textDocument"]["uri"].asString());
+	optional<SourceLocation> position = parsePosition(sourceUnitName, _params["position"]);
+	lspAssert(
+		position.has_value(),
+		ErrorCode::InvalidParams,
+		"Invalid position: " + jsonCompactPrint(_params["position"])
+	);
+	return m_symbolIndex.declarationAt(sourceUnitName, position->start);
+}
+
+void LanguageServer::scheduleCompilation()
+{
+	m_compilationDue = chrono::steady_clock::now() + compilationDelay;
+	m_syntaxCheckDue = chrono::steady_clock::now() + syntaxCheckDelay;
+}
+
+void LanguageServer::publishSyntaxErrors()
+{
+	m_syntaxCheckDue.reset();
+	util::Profiler::Scope profilerScope{"language server syntax check"};
+
+	for (auto sourceUnitName = m_editedSources.begin(); sourceUnitName != m_editedSources.end();)
+	{
+		auto source = m_fileRepository.sourceUnits().find(*sourceUnitName);
+		if (source == m_fileRepository.sourceUnits().end())
+		{
+			++sourceUnitName;
+			continue;
+		}
+
+		// The compiler stack uses the default EVM version as well.
+		CharStream stream(source->second, *sourceUnitName);
+		ErrorList errors;
+		ErrorReporter errorReporter(errors);
+		Parser(errorReporter, EVMVersion{}).parse(stream);
+
+		Json::Value diagnostics = Json::arrayValue;
+		if (Error::containsErrors(errors))
+			for (shared_ptr<Error const> const& error: errors)
+				if (SourceLocation const* location = error->sourceLocation(); location && location->hasText())
+					diagnostics.append(toDiagnostic(*error, toJsonRange(
+						stream.translatePositionToLineColumn(location->start),
+						stream.translatePositionToLineColumn(location->end)
+					)));
+		if (diagnostics.empty())
+		{
+			// Without syntax errors the previous diagnostics stay until the analysis replaces them.
+			++sourceUnitName;
+			continue;
+		}
+
+		m_publishedDiagnostics[*sourceUnitName] = diagnostics;
+
+		Json::Value params;
+		params["uri"] = m_fileRepository.sourceUnitNameToClientPath(*sourceUnitName);
+		params["diagnostics"] = move(diagnostics);
+		m_client.notify("textDocument/publishDiagnostics", move(params));
+
+		// The compilation finds the same errors and only publishes them again if they change.
+		sourceUnitName = m_editedSources.erase(sourceUnitName);
+	}
 }
 
 void LanguageServer::compileAndUpdateDiagnostics()
 {
+	m_compilationDue.reset();
+	m_syntaxCheckDue.reset();
+	auto const start = steady_clock::now();
 	compile();
-
-	// These are the source units we will sent diagnostics to the client for sure,
-	// even if it is just to clear previous diagnostics.
+	nanoseconds const duration = steady_clock::now() - start;
+
+	// The compiler cannot be interrupted without losing what the next compilation could reuse,
+	// but the diagnostics of a state of the sources that was already edited again are not published.
+	bool const discarded = sourceChangePending();
+	m_statistics.recordCompilation(duration, discarded);
+	logTrace(fmt::format(
+		"Compiled in {} ms{}.",
+		duration_cast<milliseconds>(duration).count(),
+		discarded ? ", diagnostics discarded" : ""
+	));
+	if (discarded)
+		return;
+
+	// These are the source units whose diagnostics are compared to the published ones,
+	// including the ones whose previous diagnostics might have to be cleared.
 	map<string, Json::Value> diagnosticsBySourceUnit;
 	for (string const& sourceUnitName: m_fileRepository.sourceUnits() | ranges::views::keys)
 		diagnosticsBySourceUnit[sourceUnitName] = Json::arrayValue;
-	for (string const& sourceUnitName: m_nonemptyDiagnostics)
+	for (string const& sourceUnitName: m_publishedDiagnostics | ranges::views::keys)
 		diagnosticsBySourceUnit[sourceUnitName] = Json::arrayValue;
 
 	for (shared_ptr<Error const> const& error: m_compilerStack.errors())
@@ -203,16 +404,7 @@ void LanguageServer::compileAndUpdateDiagnostics()
 			// LSP only has diagnostics applied to individual files.
 			continue;
 
-		Json::Value jsonDiag;
-		jsonDiag["source"] = "solc";
-		jsonDiag["severity"] = toDiagnosticSeverity(error->type());
-		jsonDiag["code"] = Json::UInt64{error->errorId().error};
-		string message = error->typeName() + ":";
-		if (string const* comment = error->comment())
-			message += " " + *comment;
-		jsonDiag["message"] = move(message);
-		jsonDiag["range"] = toRange(*location);
-
+		Json::Value jsonDiag = toDiagnostic(*error, toRange(*location));
 		if (auto const* secondary = error->secondarySourceLocation())
 			for (auto&& [secondaryMessage, secondaryLocation]: secondary->infos)
 			{
@@ -225,52 +417,171 @@ void LanguageServer::compileAndUpdateDiagnostics()
 		diagnosticsBySourceUnit[*location->sourceName].append(jsonDiag);
 	}
 
-	m_nonemptyDiagnostics.clear();
+	// Unchanged diagnostics are only sent again for the files the client just opened or edited.
 	for (auto&& [sourceUnitName, diagnostics]: diagnosticsBySourceUnit)
 	{
+		auto published = m_publishedDiagnostics.find(sourceUnitName);
+		bool const unchanged = published == m_publishedDiagnostics.end() ?
+			diagnostics.empty() :
+			published->second == diagnostics;
+		if (unchanged && !m_editedSources.count(sourceUnitName))
+			continue;
+
+		if (diagnostics.empty())
+			m_publishedDiagnostics.erase(sourceUnitName);
+		else
+			m_publishedDiagnostics[sourceUnitName] = diagnostics;
 		Json::Value params;
 		params["uri"] = m_fileRepository.sourceUnitNameToClientPath(sourceUnitName);
-		if (!diagnostics.empty())
-			m_nonemptyDiagnostics.insert(sourceUnitName);
 		params["diagnostics"] = move(diagnostics);
 		m_client.notify("textDocument/publishDiagnostics", move(params));
 	}
+	m_editedSources.clear();
 }
 
 bool LanguageServer::run()
 {
-	while (m_state != State::ExitRequested && m_state != State::ExitWithoutShutdown && !m_client.closed())
+	thread reader([this]() { readMessages(); });
+	while (m_state != State::ExitRequested && m_state != State::ExitWithoutShutdown)
 	{
-		MessageID id;
-		try
+		optional<IncomingMessage> const incoming = nextMessage();
+		if (incoming)
 		{
-			optional<Json::Value> const jsonMessage = m_client.receive();
-			if (!jsonMessage)
-				continue;
-
-			if ((*jsonMessage)["method"].isString())
+			auto const start = steady_clock::now();
+			handleMessage(incoming->message);
+			string const method = incoming->message["method"].isString() ? incoming->message["method"].asString() : "";
+			nanoseconds const latency = steady_clock::now() - incoming->arrival;
+			m_statistics.recordMessage(method, latency);
+			logTrace(
+				fmt::format("Handled {} in {} ms.", method, duration_cast<milliseconds>(latency).count()),
+				fmt::format("Waited {} ms to be handled.", duration_cast<milliseconds>(start - incoming->arrival).count())
+			);
+		}
+		else if (m_syntaxCheckDue || m_compilationDue)
+			try
 			{
-				string const methodName = (*jsonMessage)["method"].asString();
-				id = (*jsonMessage)["id"];
-
-				if (auto handler = valueOrDefault(m_handlers, methodName))
-					handler(id, (*jsonMessage)["params"]);
+				if (m_syntaxCheckDue)
+					publishSyntaxErrors();
 				else
-					m_client.error(id, ErrorCode::MethodNotFound, "Unknown method " + methodName);
+					compileAndUpdateDiagnostics();
 			}
-			else
-				m_client.error({}, ErrorCode::ParseError, "\"method\" has to be a string.");
+			catch (...)
+			{
+				m_client.error({}, ErrorCode::InternalError, "Unhandled exception: "s + boost::current_exception_diagnostic_information());
+			}
+		else
+			break;
+	}
+	// The loop only ends after the reader handed over the "exit" notification or finished
+	// because the transport was closed, so the reader does not wait for input anymore.
+	reader.join();
+	return m_state == State::ExitRequested;
+}
+
+void LanguageServer::readMessages()
+{
+	while (!m_client.closed())
+	{
+		optional<Json::Value> jsonMessage = m_client.receive();
+		if (!jsonMessage)
+			continue;
+		Json::Value const& method = (*jsonMessage)["method"];
+		if (method == "$/cancelRequest" || method == "cancelRequest")
+		{
+			// Handled right away, so that requests waiting behind a compilation can be cancelled.
+			cancelRequest((*jsonMessage)["params"]["id"]);
+			continue;
 		}
-		catch (RequestError const& error)
+		bool exit = method == "exit";
 		{
-			m_client.error(id, error.code(), error.comment() ? *error.comment() : ""s);
+			lock_guard<mutex> lock(m_incomingMutex);
+			m_incomingMessages.push_back({move(*jsonMessage), steady_clock::now()});
 		}
-		catch (...)
+		m_messageArrived.notify_one();
+		if (exit)
+			break;
+	}
+	{
+		lock_guard<mutex> lock(m_incomingMutex);
+		m_readerFinished = true;
+	}
+	m_messageArrived.notify_one();
+}
+
+void LanguageServer::cancelRequest(MessageID const& _id)
+{
+	if (_id.isNull())
+		return;
+	{
+		lock_guard<mutex> lock(m_incomingMutex);
+		auto request = find_if(
+			m_incomingMessages.begin(),
+			m_incomingMessages.end(),
+			[&](IncomingMessage const& _incoming) { return _incoming.message["method"].isString() && _incoming.message["id"] == _id; }
+		);
+		// Requests that are already being handled are answered as usual.
+		if (request == m_incomingMessages.end())
+			return;
+		m_incomingMessages.erase(request);
+		++m_cancelledRequests;
+	}
+	m_client.error(_id, ErrorCode::RequestCancelled, "Request cancelled.");
+}
+
+optional<LanguageServer::IncomingMessage> LanguageServer::nextMessage()
+{
+	unique_lock<mutex> lock(m_incomingMutex);
+	auto available = [&]() { return !m_incomingMessages.empty() || m_readerFinished; };
+	if (m_syntaxCheckDue)
+		m_messageArrived.wait_until(lock, *m_syntaxCheckDue, available);
+	else if (m_compilationDue)
+		m_messageArrived.wait_until(lock, *m_compilationDue, available);
+	else
+		m_messageArrived.wait(lock, available);
+
+	if (m_incomingMessages.empty())
+		return nullopt;
+	m_statistics.recordQueueDepth(m_incomingMessages.size());
+	IncomingMessage incoming = move(m_incomingMessages.front());
+	m_incomingMessages.pop_front();
+	return incoming;
+}
+
+bool LanguageServer::sourceChangePending()
+{
+	lock_guard<mutex> lock(m_incomingMutex);
+	for (IncomingMessage const& incoming: m_incomingMessages)
+		if (incoming.message["method"].isString() && boost::starts_with(incoming.message["method"].asString(), "textDocument/did"))
+			return true;
+	return false;
+}
+
+void LanguageServer::handleMessage(Json::Value const& _jsonMessage)
+{
+	MessageID id;
+	try
+	{
+		if (_jsonMessage["method"].isString())
 		{
-			m_client.error(id, ErrorCode::InternalError, "Unhandled exception: "s + boost::current_exception_diagnostic_information());
+			string const methodName = _jsonMessage["method"].asString();
+			id = _jsonMessage["id"];
+
+			if (auto handler = valueOrDefault(m_handlers, methodName))
+				handler(id, _jsonMessage["params"]);
+			else
+				m_client.error(id, ErrorCode::MethodNotFound, "Unknown method " + methodName);
 		}
+		else
+			m_client.error({}, ErrorCode::ParseError, "\"method\" has to be a string.");
+	}
+	catch (RequestError const& error)
+	{
+		m_client.error(id, error.code(), error.comment() ? *error.comment() : ""s);
+	}
+	catch (...)
+	{
+		m_client.error(id, ErrorCode::InternalError, "Unhandled exception: "s + boost::current_exception_diagnostic_information());
 	}
-	return m_state == State::ExitRequested;
 }
 
 void LanguageServer::requireServerInitialized()
@@ -310,14 +621,23 @@ void LanguageServer::handleInitialize(MessageID _id, Json::Value const& _args)
 		rootPath = rootPath.asString();
 
 	m_fileRepository = FileRepository(boost::filesystem::path(rootPath));
+	if (_args["trace"].isString())
+		m_trace = _args["trace"].asString();
 	if (_args["initializationOptions"].isObject())
+	{
 		changeConfiguration(_args["initializationOptions"]);
+		if (_args["initializationOptions"]["diagnosticsCache"].isString())
+			m_diagnosticsCache.emplace(_args["initializationOptions"]["diagnosticsCache"].asString());
+	}
 
 	Json::Value replyArgs;
 	replyArgs["serverInfo"]["name"] = "solc";
 	replyArgs["serverInfo"]["version"] = string(VersionNumber);
 	replyArgs["capabilities"]["textDocumentSync"]["openClose"] = true;
 	replyArgs["capabilities"]["textDocumentSync"]["change"] = 2; // 0=none, 1=full, 2=incremental
+	replyArgs["capabilities"]["definitionProvider"] = true;
+	replyArgs["capabilities"]["referencesProvider"] = true;
+	replyArgs["capabilities"]["workspaceSymbolProvider"] = true;
 
 	m_client.reply(_id, move(replyArgs));
 }
@@ -330,6 +650,37 @@ void LanguageServer::handleWorkspaceDidChangeConfiguration(Json::Value const& _a
 		changeConfiguration(_args["settings"]);
 }
 
+void LanguageServer::handleSetTrace(Json::Value const& _args)
+{
+	if (_args["value"].isString())
+		m_trace = _args["value"].asString();
+}
+
+void LanguageServer::handleSolidityStats(MessageID _id)
+{
+	requireServerInitialized();
+
+	Json::Value statistics = m_statistics.toJson();
+	{
+		lock_guard<mutex> lock(m_incomingMutex);
+		statistics["cancelledRequests"] = Json::UInt64{m_cancelledRequests};
+	}
+	statistics["phases"] = util::Profiler::instance().toJson()["phases"];
+	m_client.reply(_id, move(statistics));
+}
+
+void LanguageServer::logTrace(string const& _message, string const& _verbose)
+{
+	if (m_trace == "off")
+		return;
+
+	Json::Value params;
+	params["message"] = _message;
+	if (m_trace == "verbose" && !_verbose.empty())
+		params["verbose"] = _verbose;
+	m_client.notify("$/logTrace", move(params));
+}
+
 void LanguageServer::handleTextDocumentDidOpen(Json::Value const& _args)
 {
 	requireServerInitialized();
@@ -344,7 +695,11 @@ void LanguageServer::handleTextDocumentDidOpen(Json::Value const& _args)
 	string uri = _args["textDocument"]["uri"].asString();
 	m_openFiles.insert(uri);
 	m_fileRepository.setSourceByClientPath(uri, move(text));
-	compileAndUpdateDiagnostics();
+	// With up to date diagnostics of an earlier session, the compilation only publishes them if they change.
+	string const sourceUnitName = m_fileRepository.clientPathToSourceUnitName(uri);
+	if (!publishCachedDiagnostics(sourceUnitName))
+		m_editedSources.insert(sourceUnitName);
+	scheduleCompilation();
 }
 
 void LanguageServer::handleTextDocumentDidChange(Json::Value const& _args)
@@ -378,14 +733,20 @@ void LanguageServer::handleTextDocumentDidChange(Json::Value const& _args)
 				"Invalid source range: " + jsonCompactPrint(jsonContentChange["range"])
 			);
 
-			string buffer = m_fileRepository.sourceUnits().at(sourceUnitName);
-			buffer.replace(static_cast<size_t>(change->start), static_cast<size_t>(change->end - change->start), move(text));
-			text = move(buffer);
+			// Edit the stored source in place instead of copying the whole document.
+			m_fileRepository.replaceSourceRange(
+				uri,
+				static_cast<size_t>(change->start),
+				static_cast<size_t>(change->end),
+				text
+			);
 		}
-		m_fileRepository.setSourceByClientPath(uri, move(text));
+		else
+			m_fileRepository.setSourceByClientPath(uri, move(text));
 	}
 
-	compileAndUpdateDiagnostics();
+	m_editedSources.insert(m_fileRepository.clientPathToSourceUnitName(uri));
+	scheduleCompilation();
 }
 
 void LanguageServer::handleTextDocumentDidClose(Json::Value const& _args)
@@ -399,7 +760,54 @@ void LanguageServer::handleTextDocumentDidClose(Json::Value const& _args)
 	);
 
 	string uri = _args["textDocument"]["uri"].asString();
+	storeDiagnostics();
 	m_openFiles.erase(uri);
 
-	compileAndUpdateDiagnostics();
+	scheduleCompilation();
+}
+
+void LanguageServer::handleTextDocumentDefinition(MessageID _id, Json::Value const& _args)
+{
+	requireServerInitialized();
+	compilePendingChanges();
+
+	if (optional<SourceLocation> declaration = declarationAtPosition(_args))
+		m_client.reply(_id, toJson(*declaration));
+	else
+		m_client.reply(_id, Json::nullValue);
+}
+
+void LanguageServer::handleTextDocumentReferences(MessageID _id, Json::Value const& _args)
+{
+	requireServerInitialized();
+	compilePendingChanges();
+
+	Json::Value locations = Json::arrayValue;
+	if (optional<SourceLocation> declaration = declarationAtPosition(_args))
+	{
+		if (_args["context"]["includeDeclaration"].asBool())
+			locations.append(toJson(*declaration));
+		for (SourceLocation const& reference: m_symbolIndex.references(*declaration))
+			locations.append(toJson(reference));
+	}
+	m_client.reply(_id, move(locations));
+}
+
+void LanguageServer::handleWorkspaceSymbol(MessageID _id, Json::Value const& _args)
+{
+	requireServerInitialized();
+	compilePendingChanges();
+
+	Json::Value symbols = Json::arrayValue;
+	for (SymbolIndex::Symbol const* symbol: m_symbolIndex.symbols(_args["query"].asString()))
+	{
+		Json::Value item;
+		item["name"] = symbol->name;
+		item["kind"] = symbol->kind;
+		if (!symbol->containerName.empty())
+			item["containerName"] = symbol->containerName;
+		item["location"] = toJson(symbol->location);
+		symbols.append(move(item));
+	}
+	m_client.reply(_id, move(symbols));
 }
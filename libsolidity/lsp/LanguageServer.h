@@ -18,14 +18,21 @@
 #pragma once
 
 #include <libsolidity/lsp/Transport.h>
+#include <libsolidity/lsp/DiagnosticsCache.h>
 #include <libsolidity/lsp/FileRepository.h>
+#include <libsolidity/lsp/Statistics.h>
+#include <libsolidity/lsp/SymbolIndex.h>
 #include <libsolidity/interface/CompilerStack.h>
 #include <libsolidity/interface/FileReader.h>
 
 #include <json/value.h>
 
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <functional>
 #include <map>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <vector>
@@ -53,11 +60,39 @@ public:
 	///
 	/// The standard shutdown condition is when the maximum number of consecutive failures
 	/// has been exceeded.
+	/// The messages are read on a separate thread, so that the client is not blocked while
+	/// the project is compiled. Changes to the sources are compiled once no further change
+	/// arrived for a short while.
 	///
 	/// @return boolean indicating normal or abnormal termination.
 	bool run();
 
 private:
+	/// A message read by the reader thread and the time it arrived.
+	struct IncomingMessage
+	{
+		Json::Value message;
+		std::chrono::steady_clock::time_point arrival;
+	};
+
+	/// Reads the messages from the transport into m_incomingMessages until the client
+	/// sends "exit" or the transport is closed. Runs on its own thread.
+	void readMessages();
+	/// Removes the request with the ID @a _id from m_incomingMessages and tells the client
+	/// that it was cancelled, unless it is already being handled. Runs on the reader thread.
+	void cancelRequest(MessageID const& _id);
+	/// Waits for the next message, but at most until the pending compilation is due.
+	/// @returns nullopt if the compilation is due or no further message will arrive.
+	std::optional<IncomingMessage> nextMessage();
+	/// @returns true if a message that changes the sources is waiting to be handled.
+	bool sourceChangePending();
+	void handleMessage(Json::Value const& _message);
+	/// Compiles the project and updates the diagnostics once no further change arrived for a short while.
+	void scheduleCompilation();
+	/// Parses each edited source on its own and publishes its syntax errors right away,
+	/// ahead of the diagnostics of the compilation, which cannot analyse it anyway.
+	void publishSyntaxErrors();
+
 	/// Checks if the server is initialized (to be used by messages that need it to be initialized).
 	/// Reports an error and returns false if not.
 	void requireServerInitialized();
@@ -66,12 +101,39 @@ private:
 	void handleTextDocumentDidOpen(Json::Value const& _args);
 	void handleTextDocumentDidChange(Json::Value const& _args);
 	void handleTextDocumentDidClose(Json::Value const& _args);
+	void handleTextDocumentDefinition(MessageID _id, Json::Value const& _args);
+	void handleTextDocumentReferences(MessageID _id, Json::Value const& _args);
+	void handleWorkspaceSymbol(MessageID _id, Json::Value const& _args);
+	void handleSetTrace(Json::Value const& _args);
+	/// Replies the statistics of the server, see Statistics::toJson(), with the number of
+	/// cancelled requests and the durations of the compiler phases of util::Profiler.
+	void handleSolidityStats(MessageID _id);
+
+	/// Sends @a _message to the client as a "$/logTrace" notification if it enabled tracing,
+	/// together with @a _verbose if it asked for verbose tracing.
+	void logTrace(std::string const& _message, std::string const& _verbose = {});
 
 	/// Invoked when the server user-supplied configuration changes (initiated by the client).
 	void changeConfiguration(Json::Value const&);
 
 	/// Compile everything until after analysis phase.
 	void compile();
+	/// Indexes the sources that were analysed again by the last compilation
+	/// and drops the ones that are not part of it anymore.
+	void updateSymbolIndex();
+	/// Publishes the diagnostics that m_diagnosticsCache has for the just opened source unit
+	/// @a _sourceUnitName, if they are still valid.
+	/// @returns false if there are none.
+	bool publishCachedDiagnostics(std::string const& _sourceUnitName);
+	/// Stores the published diagnostics of the open files in m_diagnosticsCache,
+	/// unless they are not compiled yet.
+	void storeDiagnostics();
+	/// Compiles the changes that are not compiled yet, so that requests are answered for
+	/// the current state of the sources.
+	void compilePendingChanges();
+	/// @returns the name location of the declaration that is declared or referred to at the
+	/// position in the document of the LSP TextDocumentPositionParams @a _params.
+	std::optional<langutil::SourceLocation> declarationAtPosition(Json::Value const& _params);
 
 	std::optional<langutil::SourceLocation> parsePosition(
 		std::string const& _sourceUnitName,
@@ -97,14 +159,40 @@ private:
 
 	/// Set of files known to be open by the client.
 	std::set<std::string> m_openFiles;
-	/// Set of source unit names for which we sent diagnostics to the client in the last iteration.
-	std::set<std::string> m_nonemptyDiagnostics;
+	/// Non-empty diagnostics last sent to the client by source unit name.
+	/// The client still shows them, so they are only sent again if they change.
+	std::map<std::string, Json::Value> m_publishedDiagnostics;
+	/// Source unit names of the files opened or edited since their diagnostics were last sent,
+	/// which are checked for syntax errors and whose diagnostics are sent even if they did not change.
+	std::set<std::string> m_editedSources;
 	FileRepository m_fileRepository;
 
 	frontend::CompilerStack m_compilerStack;
+	SymbolIndex m_symbolIndex;
+	/// Diagnostics of earlier sessions, if the client configured a directory for them
+	/// in the "diagnosticsCache" initialization option.
+	std::optional<DiagnosticsCache> m_diagnosticsCache;
 
 	/// User-supplied custom configuration settings (such as EVM version).
 	Json::Value m_settingsObject;
+	/// The LSP TraceValue set by the client: "off", "messages" or "verbose".
+	std::string m_trace = "off";
+	Statistics m_statistics;
+
+	/// The time at which the sources are compiled if they do not change again before, if they changed.
+	std::optional<std::chrono::steady_clock::time_point> m_compilationDue;
+	/// The time at which the edited sources are checked for syntax errors, if they changed.
+	/// It is always before m_compilationDue.
+	std::optional<std::chrono::steady_clock::time_point> m_syntaxCheckDue;
+
+	/// Messages read by the reader thread that are not handled yet.
+	//@{
+	std::mutex m_incomingMutex;
+	std::condition_variable m_messageArrived;
+	std::deque<IncomingMessage> m_incomingMessages;
+	bool m_readerFinished = false;
+	uint64_t m_cancelledRequests = 0;
+	//@}
 };
 
 }
@@ -0,0 +1,102 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/lsp/Statistics.h>
+
+#include <algorithm>
+
+using namespace std;
+using namespace std::chrono;
+using namespace solidity;
+using namespace solidity::lsp;
+
+namespace
+{
+
+Json::UInt64 toMicroseconds(nanoseconds _duration)
+{
+	return static_cast<Json::UInt64>(duration_cast<microseconds>(_duration).count());
+}
+
+}
+
+void Statistics::recordMessage(string const& _method, nanoseconds _latency)
+{
+	m_messages[_method].record(_latency);
+}
+
+void Statistics::recordQueueDepth(size_t _depth)
+{
+	++m_queueDepthSamples;
+	m_queueDepthTotal += _depth;
+	m_maxQueueDepth = max<uint64_t>(m_maxQueueDepth, _depth);
+}
+
+void Statistics::recordCompilation(nanoseconds _duration, bool _discarded)
+{
+	m_compilations.record(_duration);
+	if (_discarded)
+		++m_discardedCompilations;
+}
+
+Json::Value Statistics::toJson() const
+{
+	Json::Value statistics{Json::objectValue};
+	statistics["messages"] = Json::objectValue;
+	for (auto const& [method, histogram]: m_messages)
+		statistics["messages"][method] = histogram.toJson();
+
+	statistics["queueDepth"]["max"] = Json::UInt64{m_maxQueueDepth};
+	statistics["queueDepth"]["average"] =
+		m_queueDepthSamples == 0 ? 0.0 : static_cast<double>(m_queueDepthTotal) / static_cast<double>(m_queueDepthSamples);
+
+	statistics["compilations"]["discarded"] = Json::UInt64{m_discardedCompilations};
+	statistics["compilations"]["duration"] = m_compilations.toJson();
+	return statistics;
+}
+
+void Statistics::Histogram::record(nanoseconds _duration)
+{
+	++count;
+	totalTime += _duration;
+	maxTime = max(maxTime, _duration);
+	auto bucket = find_if(
+		bucketBounds.begin(),
+		bucketBounds.end(),
+		[&](int64_t _bound) { return _duration <= milliseconds(_bound); }
+	);
+	++buckets[static_cast<size_t>(bucket - bucketBounds.begin())];
+}
+
+Json::Value Statistics::Histogram::toJson() const
+{
+	Json::Value histogram{Json::objectValue};
+	histogram["count"] = Json::UInt64{count};
+	histogram["totalTime"] = toMicroseconds(totalTime);
+	histogram["maxTime"] = toMicroseconds(maxTime);
+	histogram["buckets"] = Json::arrayValue;
+	for (size_t i = 0; i < buckets.size(); ++i)
+	{
+		Json::Value bucket{Json::objectValue};
+		if (i < bucketBounds.size())
+			bucket["upTo"] = toMicroseconds(milliseconds(bucketBounds[i]));
+		bucket["count"] = Json::UInt64{buckets[i]};
+		histogram["buckets"].append(move(bucket));
+	}
+	return histogram;
+}
@@ -0,0 +1,77 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+#pragma once
+
+#include <json/value.h>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace solidity::lsp
+{
+
+/**
+ * Latencies of the handled messages and counters of the work of the language server,
+ * so that its responsiveness can be measured and compared between releases.
+ * The durations of the compiler phases are recorded by util::Profiler.
+ */
+class Statistics
+{
+public:
+	/// Records that a message with the method @a _method was handled @a _latency after it arrived.
+	void recordMessage(std::string const& _method, std::chrono::nanoseconds _latency);
+	/// Records that @a _depth messages were waiting, including the one that is handled next.
+	void recordQueueDepth(size_t _depth);
+	/// Records a compilation that took @a _duration. It is @a _discarded if its diagnostics
+	/// were not published because the sources were already changed again.
+	void recordCompilation(std::chrono::nanoseconds _duration, bool _discarded);
+
+	/// @returns the statistics as a JSON object of the form
+	/// {"messages": {<method>: <histogram>}, "queueDepth": {"max": ..., "average": ...},
+	/// "compilations": {"discarded": ..., "duration": <histogram>}}.
+	/// A histogram has the form {"count": ..., "totalTime": ..., "maxTime": ..., "buckets": [{"upTo": ..., "count": ...}]}
+	/// with times in microseconds. The last bucket has no "upTo".
+	Json::Value toJson() const;
+
+private:
+	/// The upper bounds of the buckets of the histograms, except the last one, in milliseconds.
+	static constexpr std::array<int64_t, 12> bucketBounds{1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 2000, 5000};
+
+	struct Histogram
+	{
+		void record(std::chrono::nanoseconds _duration);
+		Json::Value toJson() const;
+
+		uint64_t count = 0;
+		std::chrono::nanoseconds totalTime{0};
+		std::chrono::nanoseconds maxTime{0};
+		std::array<uint64_t, bucketBounds.size() + 1> buckets{};
+	};
+
+	std::map<std::string, Histogram> m_messages;
+	uint64_t m_queueDepthSamples = 0;
+	uint64_t m_queueDepthTotal = 0;
+	uint64_t m_maxQueueDepth = 0;
+	Histogram m_compilations;
+	uint64_t m_discardedCompilations = 0;
+};
+
+}
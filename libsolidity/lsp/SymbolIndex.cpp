@@ -0,0 +1,274 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/lsp/SymbolIndex.h>
+
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTVisitor.h>
+
+#include <libsolutil/CommonData.h>
+
+#include <boost/algorithm/string/predicate.hpp>
+
+#include <algorithm>
+#include <functional>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+using namespace solidity::langutil;
+using namespace solidity::lsp;
+
+namespace
+{
+
+/// The values of the LSP SymbolKind enumeration used for Solidity declarations.
+enum class SymbolKind
+{
+	Module = 2,
+	Class = 5,
+	Method = 6,
+	Property = 7,
+	Constructor = 9,
+	Enum = 10,
+	Interface = 11,
+	Function = 12,
+	Constant = 14,
+	EnumMember = 22,
+	Struct = 23,
+	Event = 24,
+	TypeParameter = 26
+};
+
+/**
+ * Reports the names that declare something or refer to a declaration, and the declarations
+ * that can be found by name in the whole workspace, i.e. the ones outside of functions.
+ */
+class IndexBuilder: public ASTConstVisitor
+{
+public:
+	using OccurrenceCallback = std::function<void(SourceLocation const& _location, Declaration const& _declaration)>;
+	using SymbolCallback = std::function<void(Declaration const& _declaration, SymbolKind _kind, ContractDefinition const* _contract)>;
+
+	IndexBuilder(OccurrenceCallback _onOccurrence, SymbolCallback _onSymbol):
+		m_onOccurrence(move(_onOccurrence)),
+		m_onSymbol(move(_onSymbol))
+	{}
+
+	bool visitNode(ASTNode const& _node) override
+	{
+		if (auto const* declaration = dynamic_cast<Declaration const*>(&_node))
+			if (!declaration->name().empty() && declaration->nameLocation().hasText())
+				m_onOccurrence(declaration->nameLocation(), *declaration);
+		return true;
+	}
+
+	bool visit(ContractDefinition const& _contract) override
+	{
+		m_onSymbol(
+			_contract,
+			_contract.isInterface() ? SymbolKind::Interface : _contract.isLibrary() ? SymbolKind::Module : SymbolKind::Class,
+			nullptr
+		);
+		m_contract = &_contract;
+		return visitNode(_contract);
+	}
+	void endVisit(ContractDefinition const&) override { m_contract = nullptr; }
+
+	bool visit(FunctionDefinition const& _function) override
+	{
+		addSymbol(_function, _function.isConstructor() ? SymbolKind::Constructor : _function.isFree() ? SymbolKind::Function : SymbolKind::Method);
+		return visitNode(_function);
+	}
+	bool visit(ModifierDefinition const& _modifier) override
+	{
+		addSymbol(_modifier, SymbolKind::Method);
+		return visitNode(_modifier);
+	}
+	bool visit(EventDefinition const& _event) override
+	{
+		addSymbol(_event, SymbolKind::Event);
+		return visitNode(_event);
+	}
+	bool visit(ErrorDefinition const& _error) override
+	{
+		addSymbol(_error, SymbolKind::Event);
+		return visitNode(_error);
+	}
+	bool visit(StructDefinition const& _struct) override
+	{
+		addSymbol(_struct, SymbolKind::Struct);
+		return visitNode(_struct);
+	}
+	bool visit(EnumDefinition const& _enum) override
+	{
+		addSymbol(_enum, SymbolKind::Enum);
+		return visitNode(_enum);
+	}
+	bool visit(EnumValue const& _value) override
+	{
+		addSymbol(_value, SymbolKind::EnumMember);
+		return visitNode(_value);
+	}
+	bool visit(UserDefinedValueTypeDefinition const& _type) override
+	{
+		addSymbol(_type, SymbolKind::TypeParameter);
+		return visitNode(_type);
+	}
+	bool visit(VariableDeclaration const& _variable) override
+	{
+		if (_variable.isStateVariable() || _variable.isFileLevelVariable())
+			addSymbol(_variable, _variable.isConstant() ? SymbolKind::Constant : SymbolKind::Property);
+		return visitNode(_variable);
+	}
+
+	bool visit(Identifier const& _identifier) override
+	{
+		if (Declaration const* declaration = _identifier.annotation().referencedDeclaration)
+			m_onOccurrence(_identifier.location(), *declaration);
+		return true;
+	}
+	bool visit(IdentifierPath const& _path) override
+	{
+		if (Declaration const* declaration = _path.annotation().referencedDeclaration)
+			m_onOccurrence(_path.location(), *declaration);
+		return true;
+	}
+	bool visit(MemberAccess const& _memberAccess) override
+	{
+		if (Declaration const* declaration = _memberAccess.annotation().referencedDeclaration)
+		{
+			// The member name has no location of its own, but it ends the expression.
+			SourceLocation location = _memberAccess.location();
+			int const nameLength = static_cast<int>(_memberAccess.memberName().size());
+			if (location.end - location.start >= nameLength)
+				location.start = location.end - nameLength;
+			m_onOccurrence(location, *declaration);
+		}
+		return true;
+	}
+
+private:
+	void addSymbol(Declaration const& _declaration, SymbolKind _kind)
+	{
+		if (!_declaration.name().empty())
+			m_onSymbol(_declaration, _kind, m_contract);
+	}
+
+	OccurrenceCallback m_onOccurrence;
+	SymbolCallback m_onSymbol;
+	ContractDefinition const* m_contract = nullptr;
+};
+
+}
+
+void SymbolIndex::update(string const& _sourceUnitName, SourceUnit const& _ast)
+{
+	remove(_sourceUnitName);
+
+	SourceIndex& index = m_sources[_sourceUnitName];
+	IndexBuilder builder(
+		[&](SourceLocation const& _location, Declaration const& _declaration) {
+			SourceLocation const& declaration = _declaration.nameLocation();
+			// Magic variables and other builtins are not declared in any source.
+			if (!_location.hasText() || !declaration.hasText())
+				return;
+			index.occurrences.push_back({_location, declaration});
+			if (_location != declaration)
+				m_references[declaration][_sourceUnitName].push_back(_location);
+		},
+		[&](Declaration const& _declaration, SymbolKind _kind, ContractDefinition const* _contract) {
+			if (_declaration.nameLocation().hasText())
+				index.symbols.push_back({
+					_declaration.name(),
+					static_cast<int>(_kind),
+					_contract ? _contract->name() : "",
+					_declaration.nameLocation()
+				});
+		}
+	);
+	_ast.accept(builder);
+
+	sort(
+		index.occurrences.begin(),
+		index.occurrences.end(),
+		[](Occurrence const& _a, Occurrence const& _b) { return _a.location.start < _b.location.start; }
+	);
+}
+
+void SymbolIndex::remove(string const& _sourceUnitName)
+{
+	auto source = m_sources.find(_sourceUnitName);
+	if (source == m_sources.end())
+		return;
+
+	for (Occurrence const& occurrence: source->second.occurrences)
+		if (auto references = m_references.find(occurrence.declaration); references != m_references.end())
+		{
+			references->second.erase(_sourceUnitName);
+			if (references->second.empty())
+				m_references.erase(references);
+		}
+	m_sources.erase(source);
+}
+
+vector<string> SymbolIndex::sourceUnitNames() const
+{
+	vector<string> names;
+	for (auto const& [name, index]: m_sources)
+		names.push_back(name);
+	return names;
+}
+
+optional<SourceLocation> SymbolIndex::declarationAt(string const& _sourceUnitName, int _position) const
+{
+	auto source = m_sources.find(_sourceUnitName);
+	if (source == m_sources.end())
+		return nullopt;
+
+	// Since the names do not overlap, only the last one that starts before the position can contain it.
+	vector<Occurrence> const& occurrences = source->second.occurrences;
+	auto next = upper_bound(
+		occurrences.begin(),
+		occurrences.end(),
+		_position,
+		[](int _start, Occurrence const& _occurrence) { return _start < _occurrence.location.start; }
+	);
+	if (next == occurrences.begin() || _position > prev(next)->location.end)
+		return nullopt;
+	return prev(next)->declaration;
+}
+
+vector<SourceLocation> SymbolIndex::references(SourceLocation const& _declaration) const
+{
+	vector<SourceLocation> locations;
+	if (auto references = m_references.find(_declaration); references != m_references.end())
+		for (auto const& [sourceUnitName, sourceReferences]: references->second)
+			locations += sourceReferences;
+	return locations;
+}
+
+vector<SymbolIndex::Symbol const*> SymbolIndex::symbols(string const& _query) const
+{
+	vector<Symbol const*> matches;
+	for (auto const& [sourceUnitName, index]: m_sources)
+		for (Symbol const& symbol: index.symbols)
+			if (_query.empty() || boost::algorithm::icontains(symbol.name, _query))
+				matches.push_back(&symbol);
+	return matches;
+}
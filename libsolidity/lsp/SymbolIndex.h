@@ -0,0 +1,95 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+#pragma once
+
+#include <liblangutil/SourceLocation.h>
+
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace solidity::frontend
+{
+class SourceUnit;
+}
+
+namespace solidity::lsp
+{
+
+/**
+ * Index of the declarations of the analysed sources and of the names referring to them,
+ * built from the declarations the references were resolved to.
+ * It is kept per source unit, so that only the sources that were analysed again
+ * have to be indexed again.
+ */
+class SymbolIndex
+{
+public:
+	/// A declaration that can be found by its name in the whole workspace.
+	struct Symbol
+	{
+		std::string name;
+		/// The LSP SymbolKind.
+		int kind = 0;
+		/// Name of the contract the symbol is declared in, if any.
+		std::string containerName;
+		langutil::SourceLocation location;
+	};
+
+	/// Replaces everything known about the source unit @a _sourceUnitName by the declarations
+	/// and references of @a _ast.
+	void update(std::string const& _sourceUnitName, frontend::SourceUnit const& _ast);
+	/// Forgets everything about the source unit @a _sourceUnitName.
+	void remove(std::string const& _sourceUnitName);
+
+	bool contains(std::string const& _sourceUnitName) const { return m_sources.count(_sourceUnitName) != 0; }
+	/// @returns the names of all indexed source units.
+	std::vector<std::string> sourceUnitNames() const;
+
+	/// @returns the name location of the declaration that is declared or referred to
+	/// by the name at @a _position in @a _sourceUnitName, or nullopt if there is no such name.
+	std::optional<langutil::SourceLocation> declarationAt(std::string const& _sourceUnitName, int _position) const;
+	/// @returns the locations of all names referring to the declaration whose name is at @a _declaration.
+	std::vector<langutil::SourceLocation> references(langutil::SourceLocation const& _declaration) const;
+	/// @returns the symbols whose name contains @a _query, or all of them if @a _query is empty.
+	std::vector<Symbol const*> symbols(std::string const& _query) const;
+
+private:
+	/// A name that declares a declaration or refers to it.
+	struct Occurrence
+	{
+		langutil::SourceLocation location;
+		/// The name location of the declaration.
+		langutil::SourceLocation declaration;
+	};
+
+	struct SourceIndex
+	{
+		/// Sorted by their start, they do not overlap.
+		std::vector<Occurrence> occurrences;
+		std::vector<Symbol> symbols;
+	};
+
+	std::map<std::string, SourceIndex> m_sources;
+	/// Locations of the references in each source unit by the name location of the declaration
+	/// they refer to.
+	std::map<langutil::SourceLocation, std::map<std::string, std::vector<langutil::SourceLocation>>> m_references;
+};
+
+}
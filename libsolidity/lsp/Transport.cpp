@@ -107,6 +107,7 @@ void IOStreamTransport::send(Json::Value _json, MessageID _id)
 
 	string const jsonString = solidity::util::jsonCompactPrint(_json);
 
+	lock_guard<mutex> lock(m_outputMutex);
 	m_output << "Content-Length: " << jsonString.size() << "\r\n";
 	m_output << "\r\n";
 	m_output << jsonString;
@@ -24,6 +24,7 @@
 #include <functional>
 #include <iosfwd>
 #include <map>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -44,6 +45,7 @@ enum class ErrorCode
 
 	// Defined by the protocol.
 	ServerNotInitialized = -32002,
+	RequestCancelled = -32800,
 	RequestFailed = -32803
 };
 
@@ -114,6 +116,7 @@ public:
 
 protected:
 	/// Sends an arbitrary raw message to the client.
+	/// Can be called from several threads, e.g. while another thread waits in receive().
 	///
 	/// Used by the notify/reply/error function family.
 	virtual void send(Json::Value _message, MessageID _id = Json::nullValue);
@@ -124,6 +127,7 @@ protected:
 private:
 	std::istream& m_input;
 	std::ostream& m_output;
+	std::mutex m_outputMutex;
 };
 
 }
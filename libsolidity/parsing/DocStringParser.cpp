@@ -89,10 +89,12 @@ multimap<string, DocTag> DocStringParser::parse()
 
 	while (currPos != end)
 	{
-		iter tagPos = find(currPos, end, '@');
 		iter nlPos = find(currPos, end, '\n');
+		// Only the current line is searched, so that long texts without tags are not scanned
+		// to their end for every line.
+		iter tagPos = find(currPos, nlPos, '@');
 
-		if (tagPos != end && tagPos < nlPos)
+		if (tagPos != nlPos)
 		{
 			// we found a tag
 			iter tagNameEndPos = firstWhitespaceOrNewline(tagPos, end);
@@ -127,7 +129,7 @@ DocStringParser::iter DocStringParser::parseDocTagLine(iter _pos, iter _end, boo
 		m_lastTag->content += " ";
 	else if (!_appending)
 		_pos = skipWhitespace(_pos, _end);
-	copy(_pos, nlPos, back_inserter(m_lastTag->content));
+	m_lastTag->content.append(_pos, nlPos);
 	return skipLineOrEOS(nlPos, _end);
 }
 
@@ -26,6 +26,7 @@
 #include <libsolidity/ast/AST.h>
 #include <liblangutil/ParserBase.h>
 #include <liblangutil/EVMVersion.h>
+#include <libsolutil/Arena.h>
 
 namespace solidity::langutil
 {
@@ -49,6 +50,20 @@ public:
 
 	ASTPointer<SourceUnit> parse(langutil::CharStream& _charStream);
 
+	/// @returns the ID of the last AST node created by this parser.
+	int64_t lastNodeID() const { return m_currentNodeID; }
+	/// Makes the parser assign IDs greater than @a _id, so that new nodes do not clash
+	/// with the nodes of ASTs created by another parser that are still in use.
+	void setLastNodeID(int64_t _id) { m_currentNodeID = _id; }
+
+	/// Makes the parser remember the nodes created by the following calls to parse(),
+	/// so that their IDs can be changed with shiftNodeIDs().
+	void enableNodeIDShifting() { m_createdNodes.emplace(); }
+	/// Adds @a _offset to the IDs of all nodes remembered since the last call and forgets them.
+	/// This allows source units to be parsed independently of each other, starting from the
+	/// same ID, and to give them the IDs they would get if they were parsed one after another.
+	void shiftNodeIDs(int64_t _offset);
+
 private:
 	class ASTNodeFactory;
 
@@ -189,6 +204,16 @@ private:
 	/// Returns the next AST node ID
 	int64_t nextID() { return ++m_currentNodeID; }
 
+	/// @returns a new AST node allocated in the arena of the source unit that is being parsed.
+	template <class NodeType, typename... Args>
+	ASTPointer<NodeType> allocateNode(Args&&... _args)
+	{
+		auto node = std::allocate_shared<NodeType>(util::ArenaAllocator<NodeType>{m_arena}, std::forward<Args>(_args)...);
+		if (m_createdNodes)
+			m_createdNodes->emplace_back(node);
+		return node;
+	}
+
 	std::pair<LookAheadInfo, IndexAccessedPath> tryParseIndexAccessedPath();
 	/// Performs limited look-ahead to distinguish between variable declaration and expression statement.
 	/// For source code of the form "a[][8]" ("IndexAccessStructure"), this is not possible to
@@ -217,6 +242,12 @@ private:
 	langutil::EVMVersion m_evmVersion;
 	/// Counter for the next AST node ID
 	int64_t m_currentNodeID = 0;
+	/// Memory of the nodes of the source unit that is being parsed. Every node keeps the
+	/// arena alive, so it is released at once together with the last node of the AST.
+	std::shared_ptr<util::Arena> m_arena;
+	/// Nodes whose IDs can still be changed by shiftNodeIDs(), if enabled.
+	/// Nodes that are discarded while parsing, e.g. on errors, are skipped.
+	std::optional<std::vector<std::weak_ptr<ASTNode>>> m_createdNodes;
 };
 
 }
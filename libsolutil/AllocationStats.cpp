@@ -0,0 +1,65 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/AllocationStats.h>
+
+#include <cstdlib>
+#include <new>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+
+namespace
+{
+
+/// Counted per thread, so that the allocations are not synchronized and can be attributed to
+/// the profiler scopes open on the thread.
+thread_local AllocationStats currentThreadStats;
+
+}
+
+AllocationStats solidity::util::threadAllocationStats()
+{
+	return currentThreadStats;
+}
+
+#if defined(SOLC_ALLOC_STATS)
+
+// The nothrow and array versions of operator new call this one unless they are replaced themselves.
+// The aligned versions are not counted.
+void* operator new(size_t _size)
+{
+	++currentThreadStats.count;
+	currentThreadStats.bytes += _size;
+	if (void* pointer = malloc(_size == 0 ? 1 : _size))
+		return pointer;
+	throw bad_alloc();
+}
+
+void operator delete(void* _pointer) noexcept
+{
+	free(_pointer);
+}
+
+void operator delete(void* _pointer, size_t) noexcept
+{
+	free(_pointer);
+}
+
+#endif
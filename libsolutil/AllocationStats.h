@@ -0,0 +1,48 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Counters of the allocations done via the global operator new.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace solidity::util
+{
+
+/// Number and total size of the allocations done via the global operator new.
+struct AllocationStats
+{
+	uint64_t count = 0;
+	uint64_t bytes = 0;
+};
+
+/// True if the allocations are counted, i.e. if the compiler was built with
+/// the CMake option SOLC_ALLOC_STATS, which replaces the global operator new.
+#if defined(SOLC_ALLOC_STATS)
+constexpr bool allocationStatsEnabled = true;
+#else
+constexpr bool allocationStatsEnabled = false;
+#endif
+
+/// @returns the allocations done by the current thread so far. Always zero unless
+/// allocationStatsEnabled is true.
+AllocationStats threadAllocationStats();
+
+}
@@ -0,0 +1,55 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/Arena.h>
+
+#include <libsolutil/Assertions.h>
+
+#include <algorithm>
+#include <cstdint>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+
+void* Arena::allocate(size_t _size, size_t _alignment)
+{
+	assertThrow(
+		_alignment > 0 && (_alignment & (_alignment - 1)) == 0 && _alignment <= alignof(max_align_t),
+		Exception,
+		"Invalid alignment."
+	);
+
+	size_t padding = (_alignment - reinterpret_cast<uintptr_t>(m_current) % _alignment) % _alignment;
+	if (!m_current || padding + _size > m_remaining)
+	{
+		// Chunks are allocated with new[] and thus suitably aligned for any type.
+		size_t chunkSize = max(m_nextChunkSize, _size);
+		m_chunks.emplace_back(new byte[chunkSize]);
+		m_current = m_chunks.back().get();
+		m_remaining = chunkSize;
+		m_reservedBytes += chunkSize;
+		m_nextChunkSize = min(m_nextChunkSize * 2, maxChunkSize);
+		padding = 0;
+	}
+
+	byte* result = m_current + padding;
+	m_current = result + _size;
+	m_remaining -= padding + _size;
+	return result;
+}
@@ -0,0 +1,92 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Bump-pointer memory arena and an allocator using it.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace solidity::util
+{
+
+/**
+ * Memory region from which objects are allocated by advancing a pointer through large chunks.
+ * Deallocating single objects is a no-op, all memory is released at once when the arena
+ * is destroyed.
+ *
+ * Allocation is not thread-safe.
+ */
+class Arena
+{
+public:
+	Arena() = default;
+	Arena(Arena const&) = delete;
+	Arena& operator=(Arena const&) = delete;
+
+	/// @returns uninitialised memory of @a _size bytes, aligned to @a _alignment,
+	/// which has to be a power of two not larger than alignof(std::max_align_t).
+	void* allocate(size_t _size, size_t _alignment);
+
+	/// @returns the number of bytes reserved from the system so far.
+	size_t reservedBytes() const { return m_reservedBytes; }
+
+private:
+	static size_t constexpr initialChunkSize = 4096;
+	static size_t constexpr maxChunkSize = 1024 * 1024;
+
+	std::vector<std::unique_ptr<std::byte[]>> m_chunks;
+	std::byte* m_current = nullptr;
+	size_t m_remaining = 0;
+	size_t m_nextChunkSize = initialChunkSize;
+	size_t m_reservedBytes = 0;
+};
+
+/**
+ * Standard allocator that takes its memory from an Arena. Every copy of the allocator keeps
+ * the arena alive, so that objects created via e.g. std::allocate_shared can be used safely
+ * for as long as they exist.
+ */
+template <typename T>
+class ArenaAllocator
+{
+public:
+	using value_type = T;
+
+	explicit ArenaAllocator(std::shared_ptr<Arena> _arena): m_arena(std::move(_arena)) {}
+	template <typename U>
+	ArenaAllocator(ArenaAllocator<U> const& _other): m_arena(_other.arena()) {}
+
+	T* allocate(size_t _count) { return static_cast<T*>(m_arena->allocate(sizeof(T) * _count, alignof(T))); }
+	void deallocate(T*, size_t) noexcept {}
+
+	std::shared_ptr<Arena> const& arena() const { return m_arena; }
+
+	template <typename U>
+	bool operator==(ArenaAllocator<U> const& _other) const { return m_arena == _other.arena(); }
+	template <typename U>
+	bool operator!=(ArenaAllocator<U> const& _other) const { return m_arena != _other.arena(); }
+
+private:
+	std::shared_ptr<Arena> m_arena;
+};
+
+}
@@ -38,7 +38,7 @@ struct Exception: virtual std::exception, virtual boost::exception
 	std::string lineInfo() const;
 
 	/// @returns the errinfo_comment of this exception.
-	std::string const* comment() const noexcept;
+	virtual std::string const* comment() const noexcept;
 };
 
 /// Throws an exception with a given description and extra information about the location the
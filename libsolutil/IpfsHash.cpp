@@ -153,7 +153,7 @@ bytes groupChunksBottomUp(Chunks _currentLevel)
 }
 }
 
-bytes solidity::util::ipfsHash(string _data)
+bytes solidity::util::ipfsHash(string const& _data)
 {
 	size_t const maxChunkSize = 1024 * 256;
 	size_t chunkCount = _data.length() / maxChunkSize + (_data.length() % maxChunkSize > 0 ? 1 : 0);
@@ -163,41 +163,49 @@ bytes solidity::util::ipfsHash(string _data)
 
 	for (size_t chunkIndex = 0; chunkIndex < chunkCount; chunkIndex++)
 	{
-		bytes chunkBytes = asBytes(
-			_data.substr(chunkIndex * maxChunkSize, min(maxChunkSize, _data.length() - chunkIndex * maxChunkSize))
-		);
-
-		bytes lengthAsVarint = varintEncoding(chunkBytes.size());
+		size_t const chunkOffset = chunkIndex * maxChunkSize;
+		size_t const chunkSize = min(maxChunkSize, _data.length() - chunkOffset);
+		bytes lengthAsVarint = varintEncoding(chunkSize);
 
-		bytes protobufEncodedData;
+		// The block of the chunk only has to be hashed, so it is passed to the hasher in pieces
+		// and the data of the chunk is never copied.
 		// Type: File
-		protobufEncodedData += bytes{0x08, 0x02};
-		if (!chunkBytes.empty())
-		{
+		bytes protobufPrefix{0x08, 0x02};
+		if (chunkSize > 0)
 			// Data (length delimited bytes)
-			protobufEncodedData += bytes{0x12};
-			protobufEncodedData += lengthAsVarint;
-			protobufEncodedData += chunkBytes;
-		}
+			protobufPrefix += bytes{0x12} + lengthAsVarint;
 		// filesize: length as varint
-		protobufEncodedData += bytes{0x18} + lengthAsVarint;
+		bytes const protobufSuffix = bytes{0x18} + lengthAsVarint;
 
 		// PBDag:
 		// Data: (length delimited bytes)
-		bytes blockData = encodeByteArray(protobufEncodedData);
+		bytes const blockPrefix =
+			bytes{0x0a} +
+			varintEncoding(protobufPrefix.size() + chunkSize + protobufSuffix.size()) +
+			protobufPrefix;
+
+		auto const* chunkBegin = reinterpret_cast<uint8_t const*>(_data.data()) + chunkOffset;
+		picosha2::hash256_one_by_one hasher;
+		hasher.process(blockPrefix.begin(), blockPrefix.end());
+		hasher.process(chunkBegin, chunkBegin + chunkSize);
+		hasher.process(protobufSuffix.begin(), protobufSuffix.end());
+		hasher.finish();
 
 		// Multihash: sha2-256, 256 bits
+		bytes hash{0x12, 0x20};
+		hash.resize(2 + picosha2::k_digest_size);
+		hasher.get_hash_bytes(hash.begin() + 2, hash.end());
 		allChunks.emplace_back(
-			encodeHash(blockData),
-			chunkBytes.size(),
-			blockData.size()
+			std::move(hash),
+			chunkSize,
+			blockPrefix.size() + chunkSize + protobufSuffix.size()
 		);
 	}
 
 	return groupChunksBottomUp(std::move(allChunks));
 }
 
-string solidity::util::ipfsHashBase58(string _data)
+string solidity::util::ipfsHashBase58(string const& _data)
 {
-	return base58Encode(ipfsHash(std::move(_data)));
+	return base58Encode(ipfsHash(_data));
 }
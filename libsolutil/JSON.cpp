@@ -23,12 +23,16 @@
 #include <libsolutil/JSON.h>
 
 #include <libsolutil/CommonIO.h>
+#include <libsolutil/Assertions.h>
 
 #include <boost/algorithm/string/replace.hpp>
 
-#include <sstream>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <map>
 #include <memory>
+#include <optional>
 
 using namespace std;
 
@@ -43,17 +47,6 @@ namespace solidity::util
 namespace
 {
 
-/// StreamWriterBuilder that can be constructed with specific settings
-class StreamWriterBuilder: public Json::StreamWriterBuilder
-{
-public:
-	explicit StreamWriterBuilder(map<string, Json::Value> const& _settings)
-	{
-		for (auto const& iter: _settings)
-			this->settings_[iter.first] = iter.second;
-	}
-};
-
 /// CharReaderBuilder with strict-mode settings
 class StrictModeCharReaderBuilder: public Json::CharReaderBuilder
 {
@@ -64,18 +57,228 @@ public:
 	}
 };
 
-/// Serialise the JSON object (@a _input) with specific builder (@a _builder)
-/// \param _input JSON input string
-/// \param _builder StreamWriterBuilder that is used to create new Json::StreamWriter
-/// \return serialized json object
-string print(Json::Value const& _input, Json::StreamWriterBuilder const& _builder)
+/// Decodes the UTF-8 sequence starting at @a _it the same way as jsoncpp, advancing @a _it
+/// to its last byte. Invalid sequences are decoded as the replacement character.
+unsigned utf8ToCodepoint(char const*& _it, char const* _end)
+{
+	unsigned const replacementCharacter = 0xfffd;
+	auto byte = [&](size_t _index) { return static_cast<unsigned>(static_cast<unsigned char>(_it[_index])); };
+	unsigned const first = byte(0);
+	if (first < 0x80)
+		return first;
+	if (first < 0xe0)
+	{
+		if (_end - _it < 2)
+			return replacementCharacter;
+		unsigned const codepoint = ((first & 0x1f) << 6) | (byte(1) & 0x3f);
+		_it += 1;
+		return codepoint < 0x80 ? replacementCharacter : codepoint;
+	}
+	if (first < 0xf0)
+	{
+		if (_end - _it < 3)
+			return replacementCharacter;
+		unsigned const codepoint = ((first & 0x0f) << 12) | ((byte(1) & 0x3f) << 6) | (byte(2) & 0x3f);
+		_it += 2;
+		if (codepoint >= 0xd800 && codepoint <= 0xdfff)
+			return replacementCharacter;
+		return codepoint < 0x800 ? replacementCharacter : codepoint;
+	}
+	if (first < 0xf8)
+	{
+		if (_end - _it < 4)
+			return replacementCharacter;
+		unsigned const codepoint =
+			((first & 0x07) << 18) | ((byte(1) & 0x3f) << 12) | ((byte(2) & 0x3f) << 6) | (byte(3) & 0x3f);
+		_it += 3;
+		return codepoint < 0x10000 ? replacementCharacter : codepoint;
+	}
+	return replacementCharacter;
+}
+
+void appendEscapedCodeUnit(string& _output, unsigned _codeUnit)
+{
+	static char const hexDigits[] = "0123456789abcdef";
+	_output += "\\u";
+	for (int shift = 12; shift >= 0; shift -= 4)
+		_output.push_back(hexDigits[(_codeUnit >> shift) & 0xf]);
+}
+
+/// Appends the characters from @a _begin to @a _end as a quoted string literal escaped like
+/// jsoncpp, i.e. with control characters and non-ASCII characters as \u escapes.
+void appendQuotedString(string& _output, char const* _begin, char const* _end)
+{
+	auto const needsEscaping = [](char _c) {
+		unsigned char const c = static_cast<unsigned char>(_c);
+		return c < 0x20 || c >= 0x80 || c == '"' || c == '\\';
+	};
+
+	_output.push_back('"');
+	char const* it = _begin;
+	while (it != _end)
+	{
+		// Copy the longest run of characters that do not need escaping at once.
+		char const* run = find_if(it, _end, needsEscaping);
+		_output.append(it, run);
+		if (run == _end)
+			break;
+		it = run;
+		switch (*it)
+		{
+		case '"': _output += "\\\""; break;
+		case '\\': _output += "\\\\"; break;
+		case '\b': _output += "\\b"; break;
+		case '\f': _output += "\\f"; break;
+		case '\n': _output += "\\n"; break;
+		case '\r': _output += "\\r"; break;
+		case '\t': _output += "\\t"; break;
+		default:
+		{
+			unsigned codepoint = utf8ToCodepoint(it, _end);
+			if (codepoint < 0x10000)
+				appendEscapedCodeUnit(_output, codepoint);
+			else
+			{
+				codepoint -= 0x10000;
+				appendEscapedCodeUnit(_output, (codepoint >> 10) + 0xd800);
+				appendEscapedCodeUnit(_output, (codepoint & 0x3ff) + 0xdc00);
+			}
+			break;
+		}
+		}
+		++it;
+	}
+	_output.push_back('"');
+}
+
+void appendQuotedString(string& _output, string const& _value)
 {
-	stringstream stream;
-	unique_ptr<Json::StreamWriter> writer(_builder.newStreamWriter());
-	writer->write(_input, &stream);
-	return stream.str();
+	appendQuotedString(_output, _value.data(), _value.data() + _value.size());
 }
 
+/**
+ * Serialises JSON values directly into a string, producing exactly the same text as the
+ * jsoncpp StreamWriter with the settings used by jsonPrint(), but without going through
+ * a stream, copying the member names of every object and looking up every member again.
+ */
+class JsonPrinter
+{
+public:
+	JsonPrinter(string& _output, JsonFormat const& _format):
+		m_output(_output),
+		m_colon(_format.format == JsonFormat::Pretty ? ": " : ":"),
+		m_indent(_format.format == JsonFormat::Pretty ? _format.indent : 0)
+	{}
+
+	void print(Json::Value const& _value) { printValue(_value, 0); }
+
+private:
+	void printValue(Json::Value const& _value, size_t _level)
+	{
+		switch (_value.type())
+		{
+		case Json::nullValue:
+			m_output += "null";
+			break;
+		case Json::intValue:
+			m_output += to_string(_value.asLargestInt());
+			break;
+		case Json::uintValue:
+			m_output += to_string(_value.asLargestUInt());
+			break;
+		case Json::realValue:
+			m_output += Json::valueToString(_value.asDouble());
+			break;
+		case Json::stringValue:
+		{
+			char const* begin = nullptr;
+			char const* end = nullptr;
+			if (_value.getString(&begin, &end))
+				appendQuotedString(m_output, begin, end);
+			break;
+		}
+		case Json::booleanValue:
+			m_output += _value.asBool() ? "true" : "false";
+			break;
+		case Json::arrayValue:
+			printArray(_value, _level);
+			break;
+		case Json::objectValue:
+			printObject(_value, _level);
+			break;
+		}
+	}
+
+	void printObject(Json::Value const& _object, size_t _level)
+	{
+		if (_object.empty())
+		{
+			m_output += "{}";
+			return;
+		}
+		m_output.push_back('{');
+		for (auto it = _object.begin(); it != _object.end(); ++it)
+		{
+			if (it != _object.begin())
+				m_output.push_back(',');
+			newLine(_level + 1);
+			char const* end = nullptr;
+			char const* name = it.memberName(&end);
+			appendQuotedString(m_output, name, end);
+			if (startsOnNewLine(*it))
+			{
+				// jsonPrint() removes the trailing space of the colon.
+				m_output.push_back(':');
+				newLine(_level + 1);
+			}
+			else
+				m_output += m_colon;
+			printValue(*it, _level + 1);
+		}
+		newLine(_level);
+		m_output.push_back('}');
+	}
+
+	void printArray(Json::Value const& _array, size_t _level)
+	{
+		if (_array.empty())
+		{
+			m_output += "[]";
+			return;
+		}
+		// Since jsoncpp is configured to keep comments, it puts every element on a line of its own.
+		m_output.push_back('[');
+		for (Json::ArrayIndex i = 0; i < _array.size(); ++i)
+		{
+			if (i > 0)
+				m_output.push_back(',');
+			newLine(_level + 1);
+			printValue(_array[i], _level + 1);
+		}
+		newLine(_level);
+		m_output.push_back(']');
+	}
+
+	/// @returns true if @a _value starts on the line after the key of the object member it
+	/// is the value of.
+	bool startsOnNewLine(Json::Value const& _value) const
+	{
+		return m_indent && (_value.isObject() || _value.isArray()) && !_value.empty();
+	}
+
+	void newLine(size_t _level)
+	{
+		if (!m_indent)
+			return;
+		m_output.push_back('\n');
+		m_output.append(_level * m_indent, ' ');
+	}
+
+	string& m_output;
+	string m_colon;
+	size_t m_indent;
+};
+
 /// Parse a JSON string (@a _input) with specified builder (@ _builder) and writes resulting JSON object to (@a _json)
 /// \param _builder CharReaderBuilder that is used to create new Json::CharReaders
 /// \param _input JSON input string
@@ -88,6 +291,287 @@ bool parse(Json::CharReaderBuilder& _builder, string const& _input, Json::Value&
 	return reader->parse(_input.c_str(), _input.c_str() + _input.length(), &_json, _errs);
 }
 
+/// Appends the head of a CBOR data item with major type @a _majorType and argument @a _argument.
+void appendCBORHead(string& _output, uint8_t _majorType, uint64_t _argument)
+{
+	uint8_t const majorType = static_cast<uint8_t>(_majorType << 5);
+	if (_argument < 24)
+	{
+		_output.push_back(static_cast<char>(majorType | _argument));
+		return;
+	}
+	size_t const argumentSize =
+		_argument <= 0xff ? 1 :
+		_argument <= 0xffff ? 2 :
+		_argument <= 0xffffffff ? 4 :
+		8;
+	// Additional information 24, 25, 26 and 27 denote arguments of size 1, 2, 4 and 8.
+	_output.push_back(static_cast<char>(majorType | (argumentSize == 1 ? 24 : argumentSize == 2 ? 25 : argumentSize == 4 ? 26 : 27)));
+	for (size_t i = argumentSize; i > 0; --i)
+		_output.push_back(static_cast<char>((_argument >> (8 * (i - 1))) & 0xff));
+}
+
+void appendCBOR(string& _output, Json::Value const& _value)
+{
+	switch (_value.type())
+	{
+	case Json::nullValue:
+		_output.push_back(static_cast<char>(0xf6));
+		break;
+	case Json::booleanValue:
+		_output.push_back(static_cast<char>(_value.asBool() ? 0xf5 : 0xf4));
+		break;
+	case Json::intValue:
+		if (_value.asInt64() >= 0)
+			appendCBORHead(_output, 0, static_cast<uint64_t>(_value.asInt64()));
+		else
+			appendCBORHead(_output, 1, static_cast<uint64_t>(-(_value.asInt64() + 1)));
+		break;
+	case Json::uintValue:
+		appendCBORHead(_output, 0, _value.asUInt64());
+		break;
+	case Json::realValue:
+	{
+		double const value = _value.asDouble();
+		uint64_t bits;
+		memcpy(&bits, &value, sizeof(bits));
+		_output.push_back(static_cast<char>(0xfb));
+		for (size_t i = 8; i > 0; --i)
+			_output.push_back(static_cast<char>((bits >> (8 * (i - 1))) & 0xff));
+		break;
+	}
+	case Json::stringValue:
+	{
+		char const* begin = nullptr;
+		char const* end = nullptr;
+		_value.getString(&begin, &end);
+		appendCBORHead(_output, 3, static_cast<uint64_t>(end - begin));
+		_output.append(begin, end);
+		break;
+	}
+	case Json::arrayValue:
+		appendCBORHead(_output, 4, _value.size());
+		for (Json::Value const& element: _value)
+			appendCBOR(_output, element);
+		break;
+	case Json::objectValue:
+		appendCBORHead(_output, 5, _value.size());
+		for (auto it = _value.begin(); it != _value.end(); ++it)
+		{
+			char const* keyEnd = nullptr;
+			char const* keyBegin = it.memberName(&keyEnd);
+			appendCBORHead(_output, 3, static_cast<uint64_t>(keyEnd - keyBegin));
+			_output.append(keyBegin, keyEnd);
+			appendCBOR(_output, *it);
+		}
+		break;
+	}
+}
+
+/// Decoder for the subset of CBOR that corresponds to JSON.
+class CBORDecoder
+{
+public:
+	explicit CBORDecoder(string const& _input): m_input(_input) {}
+
+	/// Decodes the complete input.
+	/// @throws DecodingError if the input is not valid or contains unsupported items.
+	Json::Value decode()
+	{
+		Json::Value value = decodeItem(0);
+		if (m_position != m_input.size())
+			throw DecodingError{"Trailing data after the CBOR item."};
+		return value;
+	}
+
+	struct DecodingError
+	{
+		string message;
+	};
+
+private:
+	/// Same as the default stack limit of the JSON reader.
+	static size_t constexpr c_maxDepth = 1000;
+	static uint8_t constexpr c_break = 0xff;
+
+	uint8_t peekByte() const
+	{
+		if (m_position >= m_input.size())
+			throw DecodingError{"Unexpected end of CBOR data."};
+		return static_cast<uint8_t>(m_input[m_position]);
+	}
+	uint8_t readByte()
+	{
+		uint8_t const byte = peekByte();
+		++m_position;
+		return byte;
+	}
+	uint64_t readBigEndian(size_t _size)
+	{
+		uint64_t value = 0;
+		for (size_t i = 0; i < _size; ++i)
+			value = (value << 8) | readByte();
+		return value;
+	}
+	/// Reads the argument of a head with additional information @a _info.
+	/// @returns nullopt for an indefinite length.
+	optional<uint64_t> readArgument(uint8_t _info)
+	{
+		if (_info < 24)
+			return _info;
+		if (_info <= 27)
+			return readBigEndian(size_t(1) << (_info - 24));
+		if (_info == 31)
+			return nullopt;
+		throw DecodingError{"Invalid additional information in CBOR head."};
+	}
+	/// Checks that @a _size more bytes can be read, which is also a bound on the number of
+	/// items of a container.
+	size_t checkedSize(uint64_t _size) const
+	{
+		if (_size > m_input.size() - m_position)
+			throw DecodingError{"Unexpected end of CBOR data."};
+		return static_cast<size_t>(_size);
+	}
+	string readTextString(uint8_t _info)
+	{
+		optional<uint64_t> const length = readArgument(_info);
+		if (!length)
+		{
+			string text;
+			while (peekByte() != c_break)
+			{
+				uint8_t const head = readByte();
+				if ((head >> 5) != 3 || (head & 0x1f) == 31)
+					throw DecodingError{"Invalid chunk in indefinite-length CBOR text string."};
+				text += readTextString(head & 0x1f);
+			}
+			++m_position;
+			return text;
+		}
+		size_t const size = checkedSize(*length);
+		string text = m_input.substr(m_position, size);
+		m_position += size;
+		return text;
+	}
+
+	Json::Value decodeItem(size_t _depth)
+	{
+		if (_depth > c_maxDepth)
+			throw DecodingError{"CBOR data is nested too deeply."};
+
+		uint8_t const head = readByte();
+		uint8_t const majorType = head >> 5;
+		uint8_t const info = head & 0x1f;
+		switch (majorType)
+		{
+		case 0:
+		{
+			optional<uint64_t> const value = readArgument(info);
+			if (!value)
+				throw DecodingError{"Invalid CBOR integer."};
+			// Same representation as the JSON reader: signed if possible.
+			if (*value <= static_cast<uint64_t>(Json::Value::maxInt64))
+				return Json::Value(static_cast<Json::Int64>(*value));
+			return Json::Value(static_cast<Json::UInt64>(*value));
+		}
+		case 1:
+		{
+			optional<uint64_t> const value = readArgument(info);
+			if (!value || *value > static_cast<uint64_t>(Json::Value::maxInt64))
+				throw DecodingError{"CBOR integer out of range."};
+			return Json::Value(-static_cast<Json::Int64>(*value) - 1);
+		}
+		case 2:
+			throw DecodingError{"CBOR byte strings are not supported."};
+		case 3:
+			return Json::Value(readTextString(info));
+		case 4:
+		{
+			Json::Value array(Json::arrayValue);
+			optional<uint64_t> const length = readArgument(info);
+			if (length)
+				for (size_t i = checkedSize(*length); i > 0; --i)
+					array.append(decodeItem(_depth + 1));
+			else
+			{
+				while (peekByte() != c_break)
+					array.append(decodeItem(_depth + 1));
+				++m_position;
+			}
+			return array;
+		}
+		case 5:
+		{
+			Json::Value object(Json::objectValue);
+			optional<uint64_t> const length = readArgument(info);
+			auto const decodeMember = [&]() {
+				uint8_t const keyHead = readByte();
+				if ((keyHead >> 5) != 3)
+					throw DecodingError{"CBOR map keys have to be text strings."};
+				string const key = readTextString(keyHead & 0x1f);
+				if (object.isMember(key))
+					throw DecodingError{"Duplicate key in CBOR map: " + key};
+				object[key] = decodeItem(_depth + 1);
+			};
+			if (length)
+				for (size_t i = checkedSize(*length); i > 0; --i)
+					decodeMember();
+			else
+			{
+				while (peekByte() != c_break)
+					decodeMember();
+				++m_position;
+			}
+			return object;
+		}
+		case 6:
+			throw DecodingError{"CBOR tags are not supported."};
+		default:
+			switch (info)
+			{
+			case 20:
+				return Json::Value(false);
+			case 21:
+				return Json::Value(true);
+			case 22:
+				return Json::Value(Json::nullValue);
+			case 25:
+			{
+				// Half-precision float.
+				uint64_t const bits = readBigEndian(2);
+				int const exponent = static_cast<int>((bits >> 10) & 0x1f);
+				double const mantissa = static_cast<double>(bits & 0x3ff);
+				double value =
+					exponent == 0 ? ldexp(mantissa, -24) :
+					exponent == 31 ? (mantissa == 0 ? INFINITY : NAN) :
+					ldexp(mantissa + 1024, exponent - 25);
+				return Json::Value((bits & 0x8000) ? -value : value);
+			}
+			case 26:
+			{
+				uint32_t const bits = static_cast<uint32_t>(readBigEndian(4));
+				float value;
+				memcpy(&value, &bits, sizeof(value));
+				return Json::Value(static_cast<double>(value));
+			}
+			case 27:
+			{
+				uint64_t const bits = readBigEndian(8);
+				double value;
+				memcpy(&value, &bits, sizeof(value));
+				return Json::Value(value);
+			}
+			default:
+				throw DecodingError{"Unsupported CBOR simple value."};
+			}
+		}
+	}
+
+	string const& m_input;
+	size_t m_position = 0;
+};
+
 /// Takes a JSON value (@ _json) and removes all its members with value 'null' recursively.
 void removeNullMembersHelper(Json::Value& _json)
 {
@@ -95,14 +579,17 @@ void removeNullMembersHelper(Json::Value& _json)
 		for (auto& child: _json)
 			removeNullMembersHelper(child);
 	else if (_json.type() == Json::ValueType::objectValue)
-		for (auto const& key: _json.getMemberNames())
-		{
-			Json::Value& value = _json[key];
-			if (value.isNull())
-				_json.removeMember(key);
+	{
+		// Only the keys of null members are copied, since members cannot be removed while iterating.
+		vector<string> nullMembers;
+		for (auto it = _json.begin(); it != _json.end(); ++it)
+			if (it->isNull())
+				nullMembers.emplace_back(it.name());
 			else
-				removeNullMembersHelper(value);
-		}
+				removeNullMembersHelper(*it);
+		for (string const& key: nullMembers)
+			_json.removeMember(key);
+	}
 }
 
 } // end anonymous namespace
@@ -125,19 +612,82 @@ string jsonCompactPrint(Json::Value const& _input)
 
 string jsonPrint(Json::Value const& _input, JsonFormat const& _format)
 {
-	map<string, Json::Value> settings;
-	if (_format.format == JsonFormat::Pretty)
+	string result;
+	JsonPrinter(result, _format).print(_input);
+	return result;
+}
+
+void JsonStreamWriter::beginObject()
+{
+	assertThrow(m_objects.empty(), Exception, "The top-level object was already started.");
+	m_objects.emplace_back();
+}
+
+void JsonStreamWriter::beginObject(string const& _key)
+{
+	writeKey(_key);
+	m_objects.emplace_back();
+}
+
+void JsonStreamWriter::writeMember(string const& _key, Json::Value const& _value)
+{
+	writeKey(_key);
+	string value = jsonPrint(_value, m_format);
+	if (m_format.format == JsonFormat::Compact)
+		m_stream << ":" << value;
+	else if ((value.front() == '{' || value.front() == '[') && value.find('\n') != string::npos)
 	{
-		settings["indentation"] = string(_format.indent, ' ');
-		settings["enableYAMLCompatibility"] = true;
+		// Nested multi-line values start on a new line at the indentation of their key.
+		string const indented = "\n" + indentation(m_objects.size());
+		boost::replace_all(value, "\n", indented);
+		m_stream << ":" << indented << value;
 	}
 	else
-		settings["indentation"] = "";
-	StreamWriterBuilder writerBuilder(settings);
-	string result = print(_input, writerBuilder);
-	if (_format.format == JsonFormat::Pretty)
-		boost::replace_all(result, " \n", "\n");
-	return result;
+		m_stream << ": " << value;
+}
+
+void JsonStreamWriter::endObject()
+{
+	assertThrow(!m_objects.empty(), Exception, "No object to finish.");
+	bool const opened = m_objects.back().opened;
+	m_objects.pop_back();
+	bool const topLevel = m_objects.empty();
+
+	if (!opened)
+		m_stream << (topLevel ? "" : (m_format.format == JsonFormat::Compact ? ":" : ": ")) << "{}";
+	else if (m_format.format == JsonFormat::Compact)
+		m_stream << "}";
+	else
+		m_stream << "\n" << indentation(m_objects.size()) << "}";
+}
+
+void JsonStreamWriter::writeKey(string const& _key)
+{
+	assertThrow(!m_objects.empty(), Exception, "No object to write to.");
+	Object& object = m_objects.back();
+	size_t const level = m_objects.size() - 1;
+	if (!object.opened)
+	{
+		if (level == 0)
+			m_stream << "{";
+		else if (m_format.format == JsonFormat::Compact)
+			m_stream << ":{";
+		else
+			m_stream << ":\n" << indentation(level) << "{";
+		object.opened = true;
+	}
+	else
+	{
+		assertThrow(object.lastKey < _key, Exception, "Members have to be written in ascending order of their keys.");
+		m_stream << ",";
+	}
+	object.lastKey = _key;
+
+	if (m_format.format == JsonFormat::Pretty)
+		m_stream << "\n" << indentation(level + 1);
+	string key;
+	appendQuotedString(key, _key);
+	m_stream << key;
 }
 
 bool jsonParseStrict(string const& _input, Json::Value& _json, string* _errs /* = nullptr */)
@@ -146,4 +696,34 @@ bool jsonParseStrict(string const& _input, Json::Value& _json, string* _errs /*
 	return parse(readerBuilder, _input, _json, _errs);
 }
 
+string jsonToCBOR(Json::Value const& _input)
+{
+	string output;
+	appendCBOR(output, _input);
+	return output;
+}
+
+bool jsonParseCBOR(string const& _input, Json::Value& _json, string* _errs /* = nullptr */)
+{
+	try
+	{
+		_json = CBORDecoder(_input).decode();
+		return true;
+	}
+	catch (CBORDecoder::DecodingError const& _error)
+	{
+		if (_errs)
+			*_errs = _error.message;
+		return false;
+	}
+}
+
+bool isCBORObject(string const& _input)
+{
+	if (_input.empty())
+		return false;
+	uint8_t const head = static_cast<uint8_t>(_input.front());
+	return (head >> 5) == 5 && ((head & 0x1f) <= 27 || (head & 0x1f) == 31);
+}
+
 } // namespace solidity::util
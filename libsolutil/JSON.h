@@ -25,7 +25,9 @@
 
 #include <json/json.h>
 
+#include <ostream>
 #include <string>
+#include <vector>
 
 namespace solidity::util
 {
@@ -60,6 +62,46 @@ std::string jsonCompactPrint(Json::Value const& _input);
 /// Serialise the JSON object (@a _input) using specified format (@a _format)
 std::string jsonPrint(Json::Value const& _input, JsonFormat const& _format);
 
+/// Writes a JSON object to a stream member by member, producing the same text as jsonPrint()
+/// for the complete object. This allows large outputs to be written without keeping all of
+/// their values in memory at the same time.
+/// Since jsoncpp sorts the members of objects, the members of each object have to be written
+/// in ascending order of their keys.
+class JsonStreamWriter
+{
+public:
+	JsonStreamWriter(std::ostream& _stream, JsonFormat const& _format): m_stream(_stream), m_format(_format) {}
+
+	/// Starts the top-level object.
+	void beginObject();
+	/// Starts an object that is the value of the member @a _key of the current object.
+	void beginObject(std::string const& _key);
+	/// Writes the member @a _key with value @a _value to the current object.
+	void writeMember(std::string const& _key, Json::Value const& _value);
+	/// Finishes the current object.
+	void endObject();
+
+	/// @returns the number of objects that were started but not finished yet.
+	size_t depth() const { return m_objects.size(); }
+
+private:
+	struct Object
+	{
+		/// The opening brace is only written together with the first member,
+		/// because the formatting of empty objects differs.
+		bool opened = false;
+		std::string lastKey;
+	};
+
+	/// Writes everything up to and including @a _key of a new member of the current object.
+	void writeKey(std::string const& _key);
+	std::string indentation(size_t _level) const { return std::string(_level * m_format.indent, ' '); }
+
+	std::ostream& m_stream;
+	JsonFormat m_format;
+	std::vector<Object> m_objects;
+};
+
 /// Parse a JSON string (@a _input) with enabled strict-mode and writes resulting JSON object to (@a _json)
 /// \param _input JSON input string
 /// \param _json [out] resulting JSON object
@@ -67,4 +109,22 @@ std::string jsonPrint(Json::Value const& _input, JsonFormat const& _format);
 /// \return \c true if the document was successfully parsed, \c false if an error occurred.
 bool jsonParseStrict(std::string const& _input, Json::Value& _json, std::string* _errs = nullptr);
 
+/// Serialise the JSON value (@a _input) to CBOR (RFC 8949), a binary format that is more compact
+/// and much faster to decode than JSON text. Object members are written in the order of their keys.
+/// \return the encoded bytes
+std::string jsonToCBOR(Json::Value const& _input);
+
+/// Decode a CBOR document (@a _input) that represents a JSON value and writes it to (@a _json).
+/// Byte strings, tags and simple values other than booleans and null are rejected, as well as
+/// maps with keys that are not text strings, duplicate keys and trailing data.
+/// \param _input the encoded bytes
+/// \param _json [out] resulting JSON value
+/// \param _errs [out] Formatted error messages
+/// \return \c true if the document was successfully decoded, \c false if an error occurred.
+bool jsonParseCBOR(std::string const& _input, Json::Value& _json, std::string* _errs = nullptr);
+
+/// @returns true if @a _input starts like a CBOR encoded JSON object, i.e. with the head of a map.
+/// Such a byte cannot start a JSON text.
+bool isCBORObject(std::string const& _input);
+
 }
@@ -22,11 +22,23 @@
 
 #include <libsolutil/Keccak256.h>
 
+#include <algorithm>
 #include <cstdint>
 #include <cstring>
+#include <numeric>
 
 using namespace std;
 
+// The multi-buffer implementation uses the vector extensions of GCC and Clang and is compiled
+// for the instruction sets it is dispatched to at runtime.
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define SOL_KECCAK_MULTI_BUFFER 1
+#define SOL_KECCAK_ALWAYS_INLINE inline __attribute__((always_inline))
+#else
+#define SOL_KECCAK_MULTI_BUFFER 0
+#define SOL_KECCAK_ALWAYS_INLINE inline
+#endif
+
 namespace solidity::util
 {
 
@@ -45,16 +57,6 @@ namespace
 /******** The Keccak-f[1600] permutation ********/
 
 /*** Constants. ***/
-static uint8_t const rho[24] = \
-	{ 1,  3,   6, 10, 15, 21,
-	28, 36, 45, 55,  2, 14,
-	27, 41, 56,  8, 25, 43,
-	62, 18, 39, 61, 20, 44};
-static uint8_t const pi[24] = \
-	{10,  7, 11, 17, 18, 3,
-	5, 16,  8, 21, 24, 4,
-	15, 23, 19, 13, 12, 2,
-	20, 14, 22,  9, 6,  1};
 static uint64_t const RC[24] = \
 	{1ULL, 0x8082ULL, 0x800000000000808aULL, 0x8000000080008000ULL,
 	0x808bULL, 0x80000001ULL, 0x8000000080008081ULL, 0x8000000000008009ULL,
@@ -63,49 +65,96 @@ static uint64_t const RC[24] = \
 	0x8000000000008002ULL, 0x8000000000000080ULL, 0x800aULL, 0x800000008000000aULL,
 	0x8000000080008081ULL, 0x8000000000008080ULL, 0x80000001ULL, 0x8000000080008008ULL};
 
-/*** Helper macros to unroll the permutation. ***/
 #define rol(x, s) (((x) << s) | ((x) >> (64 - s)))
-#define REPEAT6(e) e e e e e e
-#define REPEAT24(e) REPEAT6(e e e e)
-#define REPEAT5(e) e e e e e
-#define FOR5(type, v, s, e) \
-	v = 0;            \
-	REPEAT5(e; v = static_cast<type>(v + s);)
 
 /*** Keccak-f[1600] ***/
-static inline void keccakf(void* state) {
-	auto* a = static_cast<uint64_t*>(state);
-	uint64_t b[5] = {0};
+/// Applies the permutation to the 25 lanes of @a _state. A lane is either a uint64_t or a vector
+/// of uint64_t, each element of which belongs to the state of a different sponge.
+/// The lanes are kept in local variables and the rho and pi steps are written out,
+/// so that the compiler can keep the whole state in registers.
+template<typename Lane>
+SOL_KECCAK_ALWAYS_INLINE void keccakf(Lane* _state)
+{
+	Lane a00 = _state[0], a01 = _state[1], a02 = _state[2], a03 = _state[3], a04 = _state[4];
+	Lane a05 = _state[5], a06 = _state[6], a07 = _state[7], a08 = _state[8], a09 = _state[9];
+	Lane a10 = _state[10], a11 = _state[11], a12 = _state[12], a13 = _state[13], a14 = _state[14];
+	Lane a15 = _state[15], a16 = _state[16], a17 = _state[17], a18 = _state[18], a19 = _state[19];
+	Lane a20 = _state[20], a21 = _state[21], a22 = _state[22], a23 = _state[23], a24 = _state[24];
 
-	for (int i = 0; i < 24; i++)
+	for (uint64_t const roundConstant: RC)
 	{
-		uint8_t x, y;
 		// Theta
-		FOR5(uint8_t, x, 1,
-			b[x] = 0;
-			FOR5(uint8_t, y, 5,
-				b[x] ^= a[x + y]; ))
-		FOR5(uint8_t, x, 1,
-			FOR5(uint8_t, y, 5,
-				a[y + x] ^= b[(x + 4) % 5] ^ rol(b[(x + 1) % 5], 1); ))
+		Lane const c0 = a00 ^ a05 ^ a10 ^ a15 ^ a20;
+		Lane const c1 = a01 ^ a06 ^ a11 ^ a16 ^ a21;
+		Lane const c2 = a02 ^ a07 ^ a12 ^ a17 ^ a22;
+		Lane const c3 = a03 ^ a08 ^ a13 ^ a18 ^ a23;
+		Lane const c4 = a04 ^ a09 ^ a14 ^ a19 ^ a24;
+		Lane const d0 = c4 ^ rol(c1, 1);
+		Lane const d1 = c0 ^ rol(c2, 1);
+		Lane const d2 = c1 ^ rol(c3, 1);
+		Lane const d3 = c2 ^ rol(c4, 1);
+		Lane const d4 = c3 ^ rol(c0, 1);
+
 		// Rho and pi
-		uint64_t t = a[1];
-		x = 0;
-		REPEAT24(b[0] = a[pi[x]];
-				a[pi[x]] = rol(t, rho[x]);
-				t = b[0];
-				x++; )
-		// Chi
-		FOR5(uint8_t,
-			y,
-			5,
-			FOR5(uint8_t, x, 1,
-				b[x] = a[y + x];)
-			FOR5(uint8_t, x, 1,
-				a[y + x] = b[x] ^ ((~b[(x + 1) % 5]) & b[(x + 2) % 5]); ))
-		// Iota
-		a[0] ^= RC[i];
+		Lane const b00 = a00 ^ d0;
+		Lane const b01 = rol(a06 ^ d1, 44);
+		Lane const b02 = rol(a12 ^ d2, 43);
+		Lane const b03 = rol(a18 ^ d3, 21);
+		Lane const b04 = rol(a24 ^ d4, 14);
+		Lane const b05 = rol(a03 ^ d3, 28);
+		Lane const b06 = rol(a09 ^ d4, 20);
+		Lane const b07 = rol(a10 ^ d0, 3);
+		Lane const b08 = rol(a16 ^ d1, 45);
+		Lane const b09 = rol(a22 ^ d2, 61);
+		Lane const b10 = rol(a01 ^ d1, 1);
+		Lane const b11 = rol(a07 ^ d2, 6);
+		Lane const b12 = rol(a13 ^ d3, 25);
+		Lane const b13 = rol(a19 ^ d4, 8);
+		Lane const b14 = rol(a20 ^ d0, 18);
+		Lane const b15 = rol(a04 ^ d4, 27);
+		Lane const b16 = rol(a05 ^ d0, 36);
+		Lane const b17 = rol(a11 ^ d1, 10);
+		Lane const b18 = rol(a17 ^ d2, 15);
+		Lane const b19 = rol(a23 ^ d3, 56);
+		Lane const b20 = rol(a02 ^ d2, 62);
+		Lane const b21 = rol(a08 ^ d3, 55);
+		Lane const b22 = rol(a14 ^ d4, 39);
+		Lane const b23 = rol(a15 ^ d0, 41);
+		Lane const b24 = rol(a21 ^ d1, 2);
+
+		// Chi and iota
+		a00 = b00 ^ (~b01 & b02) ^ roundConstant;
+		a01 = b01 ^ (~b02 & b03);
+		a02 = b02 ^ (~b03 & b04);
+		a03 = b03 ^ (~b04 & b00);
+		a04 = b04 ^ (~b00 & b01);
+		a05 = b05 ^ (~b06 & b07);
+		a06 = b06 ^ (~b07 & b08);
+		a07 = b07 ^ (~b08 & b09);
+		a08 = b08 ^ (~b09 & b05);
+		a09 = b09 ^ (~b05 & b06);
+		a10 = b10 ^ (~b11 & b12);
+		a11 = b11 ^ (~b12 & b13);
+		a12 = b12 ^ (~b13 & b14);
+		a13 = b13 ^ (~b14 & b10);
+		a14 = b14 ^ (~b10 & b11);
+		a15 = b15 ^ (~b16 & b17);
+		a16 = b16 ^ (~b17 & b18);
+		a17 = b17 ^ (~b18 & b19);
+		a18 = b18 ^ (~b19 & b15);
+		a19 = b19 ^ (~b15 & b16);
+		a20 = b20 ^ (~b21 & b22);
+		a21 = b21 ^ (~b22 & b23);
+		a22 = b22 ^ (~b23 & b24);
+		a23 = b23 ^ (~b24 & b20);
+		a24 = b24 ^ (~b20 & b21);
 	}
+
+	_state[0] = a00; _state[1] = a01; _state[2] = a02; _state[3] = a03; _state[4] = a04;
+	_state[5] = a05; _state[6] = a06; _state[7] = a07; _state[8] = a08; _state[9] = a09;
+	_state[10] = a10; _state[11] = a11; _state[12] = a12; _state[13] = a13; _state[14] = a14;
+	_state[15] = a15; _state[16] = a16; _state[17] = a17; _state[18] = a18; _state[19] = a19;
+	_state[20] = a20; _state[21] = a21; _state[22] = a22; _state[23] = a23; _state[24] = a24;
 }
 
 /******** The FIPS202-defined functions. ********/
@@ -131,7 +180,7 @@ static inline void keccakf(void* state) {
 mkapply_ds(xorin, dst[i] ^= src[i])  // xorin
 mkapply_sd(setout, dst[i] = src[i])  // setout
 
-#define P keccakf
+#define P(a) keccakf<uint64_t>(reinterpret_cast<uint64_t*>(a))
 #define Plen 200
 
 // Fold P*F over the full blocks of an input.
@@ -153,7 +202,7 @@ inline void hash(
 	uint8_t delim
 )
 {
-	uint8_t a[Plen] = {0};
+	alignas(uint64_t) uint8_t a[Plen] = {0};
 	// Absorb input.
 	foldP(in, inlen, xorin);
 	// Xor in the DS and pad frame.
@@ -169,6 +218,94 @@ inline void hash(
 	memset(a, 0, 200);
 }
 
+/// The rate of Keccak-256 in bytes.
+size_t constexpr keccak256Rate = 200 - (256 / 4);
+
+/// @returns the number of permutations needed to hash @a _input, including the one of the padding.
+size_t keccak256Blocks(bytesConstRef _input)
+{
+	return _input.size() / keccak256Rate + 1;
+}
+
+#if SOL_KECCAK_MULTI_BUFFER
+
+size_t constexpr multiBufferWidth = 4;
+/// Lanes of the states of multiBufferWidth sponges.
+using MultiBufferLane = uint64_t __attribute__((vector_size(8 * multiBufferWidth)));
+
+/// Computes the Keccak-256 hashes of multiBufferWidth inputs at the same time. The permutations
+/// of inputs with fewer blocks than the others are continued, but their results are not used.
+SOL_KECCAK_ALWAYS_INLINE void multiBufferHash(bytesConstRef const* _inputs, h256* _outputs)
+{
+	MultiBufferLane state[25] = {};
+	size_t blocks[multiBufferWidth];
+	for (size_t i = 0; i < multiBufferWidth; ++i)
+		blocks[i] = keccak256Blocks(_inputs[i]);
+	size_t const maxBlocks = *max_element(begin(blocks), end(blocks));
+
+	for (size_t block = 0; block < maxBlocks; ++block)
+	{
+		for (size_t i = 0; i < multiBufferWidth; ++i)
+		{
+			if (block >= blocks[i])
+				continue;
+			size_t const offset = block * keccak256Rate;
+			size_t const length = min(keccak256Rate, _inputs[i].size() - offset);
+			uint8_t data[keccak256Rate] = {};
+			if (length > 0)
+				memcpy(data, _inputs[i].data() + offset, length);
+			if (block + 1 == blocks[i])
+			{
+				data[length] ^= 0x01;
+				data[keccak256Rate - 1] ^= 0x80;
+			}
+			for (size_t lane = 0; lane < keccak256Rate / 8; ++lane)
+			{
+				uint64_t word;
+				memcpy(&word, data + 8 * lane, 8);
+				state[lane][i] ^= word;
+			}
+		}
+		keccakf(state);
+		for (size_t i = 0; i < multiBufferWidth; ++i)
+			if (block + 1 == blocks[i])
+				for (size_t lane = 0; lane < h256::size / 8; ++lane)
+				{
+					uint64_t const word = state[lane][i];
+					memcpy(_outputs[i].data() + 8 * lane, &word, 8);
+				}
+	}
+}
+
+__attribute__((target("avx2")))
+void multiBufferHashAVX2(bytesConstRef const* _inputs, h256* _outputs)
+{
+	multiBufferHash(_inputs, _outputs);
+}
+
+/// AVX-512 provides rotations and three-input logic for the 256 bit vectors.
+__attribute__((target("avx512f,avx512vl")))
+void multiBufferHashAVX512(bytesConstRef const* _inputs, h256* _outputs)
+{
+	multiBufferHash(_inputs, _outputs);
+}
+
+using MultiBufferHashFunction = void(*)(bytesConstRef const*, h256*);
+
+/// @returns the multi-buffer implementation for the instruction sets of this CPU, or nullptr if
+/// it does not support any of them, in which case hashing the inputs one by one is faster.
+MultiBufferHashFunction selectMultiBufferHash()
+{
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vl"))
+		return multiBufferHashAVX512;
+	if (__builtin_cpu_supports("avx2"))
+		return multiBufferHashAVX2;
+	return nullptr;
+}
+
+#endif
+
 }
 
 h256 keccak256(bytesConstRef _input)
@@ -178,8 +315,44 @@ h256 keccak256(bytesConstRef _input)
 	// The 0x01 is the specific padding for keccak (sha3 uses 0x06) and
 	// the way the round size (or window or whatever it was) is calculated.
 	// 200 - (256 / 4) is the "rate"
-	hash(output.data(), output.size, _input.data(), _input.size(), 200 - (256 / 4), 0x01);
+	hash(output.data(), output.size, _input.data(), _input.size(), keccak256Rate, 0x01);
 	return output;
 }
 
+vector<h256> keccak256Batch(vector<bytesConstRef> const& _inputs)
+{
+	vector<h256> outputs(_inputs.size());
+	size_t hashed = 0;
+	vector<size_t> order(_inputs.size());
+	iota(order.begin(), order.end(), 0);
+
+#if SOL_KECCAK_MULTI_BUFFER
+	static MultiBufferHashFunction const multiBufferHashFunction = selectMultiBufferHash();
+	if (multiBufferHashFunction && _inputs.size() > 1)
+	{
+		// Inputs with the same number of blocks are hashed together, so that few permutations are wasted.
+		stable_sort(order.begin(), order.end(), [&](size_t _a, size_t _b) {
+			return keccak256Blocks(_inputs[_a]) < keccak256Blocks(_inputs[_b]);
+		});
+		for (; hashed + 1 < _inputs.size(); hashed += multiBufferWidth)
+		{
+			// The last group is filled up with empty inputs.
+			bytesConstRef inputs[multiBufferWidth];
+			h256 groupOutputs[multiBufferWidth];
+			size_t const groupSize = min(multiBufferWidth, _inputs.size() - hashed);
+			for (size_t i = 0; i < groupSize; ++i)
+				inputs[i] = _inputs[order[hashed + i]];
+			multiBufferHashFunction(inputs, groupOutputs);
+			for (size_t i = 0; i < groupSize; ++i)
+				outputs[order[hashed + i]] = groupOutputs[i];
+		}
+		hashed = min(hashed, _inputs.size());
+	}
+#endif
+
+	for (; hashed < _inputs.size(); ++hashed)
+		outputs[order[hashed]] = keccak256(_inputs[order[hashed]]);
+	return outputs;
+}
+
 }
@@ -0,0 +1,183 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/Profiler.h>
+
+#include <ctime>
+#include <functional>
+
+#if !defined(_WIN32)
+#include <sys/resource.h>
+#endif
+
+using namespace std;
+using namespace std::chrono;
+using namespace solidity;
+using namespace solidity::util;
+
+namespace
+{
+
+/// Path of the scopes that are currently open on this thread.
+thread_local vector<string> currentPath;
+
+nanoseconds cpuTime()
+{
+#if defined(_WIN32)
+	// Only the CPU time of the whole process is available.
+	return duration_cast<nanoseconds>(duration<double>(static_cast<double>(clock()) / CLOCKS_PER_SEC));
+#else
+	timespec time;
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+	return seconds(time.tv_sec) + nanoseconds(time.tv_nsec);
+#endif
+}
+
+/// @returns the peak resident set size of the process in kilobytes, or zero if it is unknown.
+uint64_t peakMemory()
+{
+#if defined(_WIN32)
+	return 0;
+#else
+	rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) != 0)
+		return 0;
+#if defined(__APPLE__)
+	// Reported in bytes on macOS.
+	return static_cast<uint64_t>(usage.ru_maxrss) / 1024;
+#else
+	return static_cast<uint64_t>(usage.ru_maxrss);
+#endif
+#endif
+}
+
+}
+
+Profiler::Scope::Scope(string_view _name)
+{
+	Profiler& profiler = Profiler::instance();
+	if (!profiler.enabled())
+		return;
+
+	m_active = true;
+	m_generation = profiler.m_generation;
+	currentPath.emplace_back(_name);
+	m_wallStart = steady_clock::now();
+	m_cpuStart = cpuTime();
+	m_allocationsStart = threadAllocationStats();
+}
+
+Profiler::Scope::~Scope()
+{
+	if (!m_active)
+		return;
+
+	Profiler& profiler = Profiler::instance();
+	if (profiler.enabled() && profiler.m_generation == m_generation)
+	{
+		Measurement measurement;
+		measurement.count = 1;
+		measurement.wallTime = duration_cast<nanoseconds>(steady_clock::now() - m_wallStart);
+		measurement.cpuTime = cpuTime() - m_cpuStart;
+		measurement.peakMemory = peakMemory();
+		AllocationStats allocations = threadAllocationStats();
+		measurement.allocations.count = allocations.count - m_allocationsStart.count;
+		measurement.allocations.bytes = allocations.bytes - m_allocationsStart.bytes;
+		profiler.record(currentPath, measurement);
+	}
+	currentPath.pop_back();
+}
+
+void Profiler::enable()
+{
+	lock_guard<mutex> lock(m_mutex);
+	m_measurements.clear();
+	++m_generation;
+	m_enabled = true;
+}
+
+void Profiler::disable()
+{
+	m_enabled = false;
+}
+
+Json::Value Profiler::toJson() const
+{
+	struct Node
+	{
+		Measurement measurement;
+		map<string, Node> children;
+	};
+
+	Node root;
+	{
+		lock_guard<mutex> lock(m_mutex);
+		for (auto const& [path, measurement]: m_measurements)
+		{
+			Node* node = &root;
+			for (string const& name: path)
+				node = &node->children[name];
+			node->measurement = measurement;
+		}
+	}
+
+	function<Json::Value(Node const&)> phasesToJson = [&](Node const& _node)
+	{
+		Json::Value phases(Json::arrayValue);
+		for (auto const& [name, child]: _node.children)
+		{
+			Json::Value phase(Json::objectValue);
+			phase["name"] = name;
+			phase["count"] = Json::UInt64(child.measurement.count);
+			phase["wallTime"] = Json::Int64(duration_cast<microseconds>(child.measurement.wallTime).count());
+			phase["cpuTime"] = Json::Int64(duration_cast<microseconds>(child.measurement.cpuTime).count());
+			phase["peakMemory"] = Json::UInt64(child.measurement.peakMemory);
+			if (allocationStatsEnabled)
+			{
+				phase["allocations"] = Json::UInt64(child.measurement.allocations.count);
+				phase["allocatedBytes"] = Json::UInt64(child.measurement.allocations.bytes);
+			}
+			if (!child.children.empty())
+				phase["phases"] = phasesToJson(child);
+			phases.append(move(phase));
+		}
+		return phases;
+	};
+
+	Json::Value result(Json::objectValue);
+	result["phases"] = phasesToJson(root);
+	return result;
+}
+
+Profiler& Profiler::instance()
+{
+	static Profiler profiler;
+	return profiler;
+}
+
+void Profiler::record(vector<string> const& _path, Measurement const& _measurement)
+{
+	lock_guard<mutex> lock(m_mutex);
+	Measurement& total = m_measurements[_path];
+	total.count += _measurement.count;
+	total.wallTime += _measurement.wallTime;
+	total.cpuTime += _measurement.cpuTime;
+	total.peakMemory = max(total.peakMemory, _measurement.peakMemory);
+	total.allocations.count += _measurement.allocations.count;
+	total.allocations.bytes += _measurement.allocations.bytes;
+}
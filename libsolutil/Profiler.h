@@ -0,0 +1,107 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Collection of timing and memory measurements for the phases of the compiler.
+ */
+
+#pragma once
+
+#include <libsolutil/AllocationStats.h>
+
+#include <json/json.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace solidity::util
+{
+
+/**
+ * Records wall time, CPU time and peak memory usage of named phases.
+ *
+ * Phases are opened with Profiler::Scope. A scope opened while another scope is active on the
+ * same thread becomes a child of that scope. The measurements of all scopes with the same
+ * path are summed up.
+ *
+ * The profiler is disabled by default. Opening a scope then only costs a check of an atomic flag.
+ *
+ * If the compiler is built with SOLC_ALLOC_STATS, the number and size of the allocations of the
+ * thread during the scope are recorded as well.
+ */
+class Profiler
+{
+public:
+	/// Measures the phase @a _name from construction to destruction.
+	class Scope
+	{
+	public:
+		explicit Scope(std::string_view _name);
+		~Scope();
+
+		Scope(Scope const&) = delete;
+		Scope& operator=(Scope const&) = delete;
+
+	private:
+		bool m_active = false;
+		uint64_t m_generation = 0;
+		std::chrono::steady_clock::time_point m_wallStart;
+		std::chrono::nanoseconds m_cpuStart{0};
+		AllocationStats m_allocationsStart;
+	};
+
+	/// Discards all measurements and starts recording.
+	void enable();
+	/// Stops recording. Scopes that are still open are not recorded.
+	void disable();
+	bool enabled() const { return m_enabled; }
+
+	/// @returns the measurements as a JSON object of the form
+	/// {"phases": [{"name": ..., "count": ..., "wallTime": ..., "cpuTime": ..., "peakMemory": ..., "phases": [...]}]}.
+	/// Times are given in microseconds, the peak memory usage of the process (the maximum
+	/// observed at the end of the phase) in kilobytes. Phases are sorted by name.
+	/// If allocations are counted, each phase also contains "allocations" and "allocatedBytes".
+	Json::Value toJson() const;
+
+	static Profiler& instance();
+
+private:
+	struct Measurement
+	{
+		uint64_t count = 0;
+		std::chrono::nanoseconds wallTime{0};
+		std::chrono::nanoseconds cpuTime{0};
+		uint64_t peakMemory = 0;
+		AllocationStats allocations;
+	};
+
+	void record(std::vector<std::string> const& _path, Measurement const& _measurement);
+
+	std::atomic<bool> m_enabled = false;
+	/// Incremented by enable(), so that scopes opened before do not record into new results.
+	std::atomic<uint64_t> m_generation = 0;
+	mutable std::mutex m_mutex;
+	std::map<std::vector<std::string>, Measurement> m_measurements;
+};
+
+}
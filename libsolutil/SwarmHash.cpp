@@ -22,6 +22,8 @@
 
 #include <libsolutil/Keccak256.h>
 
+#include <algorithm>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::util;
@@ -69,10 +71,12 @@ h256 bmtHash(bytesConstRef _data)
 		return keccak256(_data);
 
 	size_t midPoint = _data.size() / 2;
-	return keccak256(
-		bmtHash(_data.cropped(0, midPoint)).asBytes() +
-		bmtHash(_data.cropped(midPoint)).asBytes()
-	);
+	uint8_t children[2 * h256::size];
+	h256 const left = bmtHash(_data.cropped(0, midPoint));
+	h256 const right = bmtHash(_data.cropped(midPoint));
+	copy(left.data(), left.data() + h256::size, children);
+	copy(right.data(), right.data() + h256::size, children + h256::size);
+	return keccak256(bytesConstRef(children, sizeof(children)));
 }
 
 h256 chunkHash(bytesConstRef const _data, bool _forceHigherLevel = false)
@@ -116,3 +120,10 @@ h256 solidity::util::bzzr1Hash(bytes const& _input)
 		return h256{};
 	return chunkHash(&_input);
 }
+
+h256 solidity::util::bzzr1Hash(string const& _input)
+{
+	if (_input.empty())
+		return h256{};
+	return chunkHash(bytesConstRef(_input));
+}
@@ -0,0 +1,207 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/ThreadPool.h>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+
+using namespace std;
+using namespace solidity::util;
+
+namespace
+{
+
+/// The pool of worker threads shared by all parallel loops of the process, which grows on demand.
+class SharedPool
+{
+public:
+	static SharedPool& instance()
+	{
+		static SharedPool pool;
+		return pool;
+	}
+
+	~SharedPool()
+	{
+		{
+			lock_guard<mutex> lock(m_mutex);
+			m_stopping = true;
+		}
+		m_condition.notify_all();
+		for (thread& worker: m_workers)
+			worker.join();
+	}
+
+	/// Starts workers until there are at least @a _workerCount, then schedules @a _task for each of them.
+	void runOnWorkers(size_t _workerCount, function<void()> const& _task)
+	{
+		{
+			lock_guard<mutex> lock(m_mutex);
+			while (m_workers.size() < _workerCount)
+				m_workers.emplace_back([this]() { work(); });
+			for (size_t i = 0; i < _workerCount; ++i)
+				m_tasks.emplace_back(_task);
+		}
+		m_condition.notify_all();
+	}
+
+private:
+	void work()
+	{
+		while (true)
+		{
+			function<void()> task;
+			{
+				unique_lock<mutex> lock(m_mutex);
+				m_condition.wait(lock, [this]() { return m_stopping || !m_tasks.empty(); });
+				if (m_stopping)
+					return;
+				task = move(m_tasks.front());
+				m_tasks.pop_front();
+			}
+			task();
+		}
+	}
+
+	mutex m_mutex;
+	condition_variable m_condition;
+	deque<function<void()>> m_tasks;
+	bool m_stopping = false;
+	vector<thread> m_workers;
+};
+
+/// The state of a parallel loop, shared by the calling thread and the workers helping it.
+/// Workers that only start after the loop is finished find no index left and return without
+/// accessing the task, which may be destroyed by then.
+struct ParallelLoop
+{
+	ParallelLoop(size_t _count, function<void(size_t)> const& _task):
+		count(_count), task(_task), firstFailure(_count), exceptions(_count) {}
+
+	/// Processes indices until none is left.
+	void run()
+	{
+		for (size_t index = next++; index < count; index = next++)
+		{
+			if (index < firstFailure)
+				try
+				{
+					task(index);
+				}
+				catch (...)
+				{
+					exceptions[index] = current_exception();
+					size_t failure = firstFailure;
+					while (index < failure && !firstFailure.compare_exchange_weak(failure, index))
+						;
+				}
+			lock_guard<mutex> lock(finishedMutex);
+			if (++finished == count)
+				allFinished.notify_all();
+		}
+	}
+
+	size_t const count;
+	function<void(size_t)> const& task;
+	atomic<size_t> next{0};
+	atomic<size_t> firstFailure;
+	vector<exception_ptr> exceptions;
+	mutex finishedMutex;
+	condition_variable allFinished;
+	size_t finished = 0;
+};
+
+}
+
+ThreadPool::ThreadPool(size_t _threadCount)
+{
+	_threadCount = max<size_t>(_threadCount, 1);
+	m_workers.reserve(_threadCount);
+	for (size_t i = 0; i < _threadCount; ++i)
+		m_workers.emplace_back([this]() { work(); });
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		lock_guard<mutex> lock(m_mutex);
+		m_stopping = true;
+		m_tasks.clear();
+	}
+	m_condition.notify_all();
+	for (thread& worker: m_workers)
+		worker.join();
+}
+
+future<void> ThreadPool::enqueue(function<void()> _task)
+{
+	packaged_task<void()> task(move(_task));
+	future<void> result = task.get_future();
+	{
+		lock_guard<mutex> lock(m_mutex);
+		m_tasks.emplace_back(move(task));
+	}
+	m_condition.notify_one();
+	return result;
+}
+
+size_t ThreadPool::hardwareConcurrency()
+{
+	return max<size_t>(thread::hardware_concurrency(), 1);
+}
+
+void ThreadPool::work()
+{
+	while (true)
+	{
+		packaged_task<void()> task;
+		{
+			unique_lock<mutex> lock(m_mutex);
+			m_condition.wait(lock, [this]() { return m_stopping || !m_tasks.empty(); });
+			if (m_stopping)
+				return;
+			task = move(m_tasks.front());
+			m_tasks.pop_front();
+		}
+		task();
+	}
+}
+
+void solidity::util::parallelFor(size_t _count, size_t _parallelism, function<void(size_t)> const& _task)
+{
+	size_t const workerCount = _count == 0 ? 0 : min(max<size_t>(_parallelism, 1), _count) - 1;
+	if (workerCount == 0)
+	{
+		for (size_t i = 0; i < _count; ++i)
+			_task(i);
+		return;
+	}
+
+	auto loop = make_shared<ParallelLoop>(_count, _task);
+	SharedPool::instance().runOnWorkers(workerCount, [loop]() { loop->run(); });
+	loop->run();
+	{
+		unique_lock<mutex> lock(loop->finishedMutex);
+		loop->allFinished.wait(lock, [&]() { return loop->finished == loop->count; });
+	}
+	if (loop->firstFailure < _count)
+		rethrow_exception(loop->exceptions[loop->firstFailure]);
+}
@@ -0,0 +1,86 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Fixed-size pool of worker threads and parallel loops on a pool shared by the whole process.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace solidity::util
+{
+
+/**
+ * Fixed-size pool of worker threads that execute tasks in the order in which they were enqueued.
+ *
+ * Exceptions thrown by a task are stored in the future returned by @a enqueue.
+ * Destroying the pool waits for the tasks that are currently running and discards
+ * the ones that have not been started yet (their futures report a broken promise).
+ */
+class ThreadPool
+{
+public:
+	/// Creates a pool with @a _threadCount workers. A count of zero is treated as one.
+	explicit ThreadPool(size_t _threadCount);
+	~ThreadPool();
+
+	ThreadPool(ThreadPool const&) = delete;
+	ThreadPool& operator=(ThreadPool const&) = delete;
+
+	/// Schedules @a _task for execution on one of the workers.
+	std::future<void> enqueue(std::function<void()> _task);
+
+	size_t threadCount() const { return m_workers.size(); }
+
+	/// @returns the number of threads that can run concurrently on this machine (at least one).
+	static size_t hardwareConcurrency();
+
+private:
+	void work();
+
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+	std::deque<std::packaged_task<void()>> m_tasks;
+	bool m_stopping = false;
+	std::vector<std::thread> m_workers;
+};
+
+/// Calls @a _task for every index from 0 to @a _count - 1, on the calling thread and on at most
+/// @a _parallelism - 1 workers of a pool shared by the whole process.
+///
+/// The shared pool grows to the largest number of workers ever requested, so its threads are
+/// capped by the largest ``--jobs`` value and not multiplied when parallel loops are nested, e.g.
+/// when a contract compiled in parallel with others optimises its functions in parallel. Instead
+/// of blocking, the calling thread processes the indices no worker has taken yet and only waits
+/// for the ones that are already running, so nested loops cannot deadlock.
+///
+/// If tasks throw, the indices above the lowest failing one that have not been started are
+/// skipped and the exception of the lowest failing index is rethrown once all started tasks
+/// are finished, like in a sequential loop. Results written to slots indexed by the task index
+/// are therefore deterministic.
+void parallelFor(size_t _count, size_t _parallelism, std::function<void(size_t)> const& _task);
+
+}
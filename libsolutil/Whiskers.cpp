@@ -26,7 +26,12 @@
 
 #include <libsolutil/Assertions.h>
 
-#include <regex>
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
 
 using namespace std;
 using namespace solidity::util;
@@ -69,164 +74,303 @@ Whiskers& Whiskers::operator()(
 	return *this;
 }
 
-string Whiskers::render() const
+namespace
 {
-	return replace(m_template, m_parameters, m_conditions, m_listParameters);
-}
 
-void Whiskers::checkParameterValid(string const& _parameter) const
+bool isParameterCharacter(char _c)
 {
-	static regex validParam("^" + paramRegex() + "$");
-	assertThrow(
-		regex_match(_parameter, validParam),
-		WhiskersError,
-		"Parameter" + _parameter + " contains invalid characters."
-	);
+	return
+		('a' <= _c && _c <= 'z') ||
+		('A' <= _c && _c <= 'Z') ||
+		('0' <= _c && _c <= '9') ||
+		_c == '_' || _c == '$' || _c == '-';
 }
 
-void Whiskers::checkParameterUnknown(string const& _parameter) const
+/// Template split into its elements. Bodies of lists and conditions are parsed
+/// as templates of their own.
+struct CompiledTemplate
 {
-	assertThrow(
-		!m_parameters.count(_parameter),
-		WhiskersError,
-		_parameter + " already set as value parameter."
-	);
-	assertThrow(
-		!m_conditions.count(_parameter),
-		WhiskersError,
-		_parameter + " already set as condition parameter."
-	);
-	assertThrow(
-		!m_listParameters.count(_parameter),
-		WhiskersError,
-		_parameter + " already set as list parameter."
-	);
+	enum class Kind { Text, Parameter, List, Condition };
+
+	struct Element
+	{
+		Kind kind = Kind::Text;
+		/// The text or the name of the parameter, including the "+" of conditional value parameters.
+		string text;
+		/// The body of a list or the part of a condition used if it is true.
+		unique_ptr<CompiledTemplate> body;
+		/// The part of a condition used if it is false, if any.
+		unique_ptr<CompiledTemplate> elseBody;
+	};
+
+	string source;
+	vector<Element> elements;
+};
+
+unique_ptr<CompiledTemplate> compileTemplate(string_view _template);
+
+/// @returns the end of the parameter name starting at @a _pos if it is followed by ">".
+optional<size_t> parameterNameEnd(string_view _template, size_t _pos)
+{
+	size_t end = _pos;
+	while (end < _template.size() && isParameterCharacter(_template[end]))
+		++end;
+	if (end == _pos || end == _template.size() || _template[end] != '>')
+		return nullopt;
+	return end;
 }
 
-void Whiskers::checkTemplateContainsTags(string const& _parameter, vector<string> const& _prefixes) const
+/// Parses the tag at @a _pos, which has to be a "<". Matches the first closing tag
+/// of the same name for lists and conditions.
+/// @returns the element and the position after it or nullopt if there is no valid tag at @a _pos.
+optional<pair<CompiledTemplate::Element, size_t>> compileTag(string_view _template, size_t _pos)
 {
-	for (auto const& prefix: _prefixes)
+	using Kind = CompiledTemplate::Kind;
+	CompiledTemplate::Element element;
+
+	if (optional<size_t> nameEnd = parameterNameEnd(_template, _pos + 1))
 	{
-		string tag{"<" + prefix + _parameter + ">"};
-		assertThrow(
-			m_template.find(tag) != string::npos,
-			WhiskersError,
-			"Tag '" + tag + "' not found in template:\n" + m_template
-		);
+		element.kind = Kind::Parameter;
+		element.text = string(_template.substr(_pos + 1, *nameEnd - _pos - 1));
+		return {{move(element), *nameEnd + 1}};
+	}
+
+	if (_pos + 1 >= _template.size())
+		return nullopt;
+	char const kind = _template[_pos + 1];
+	if (kind == '#')
+	{
+		optional<size_t> nameEnd = parameterNameEnd(_template, _pos + 2);
+		if (!nameEnd)
+			return nullopt;
+		element.kind = Kind::List;
+		element.text = string(_template.substr(_pos + 2, *nameEnd - _pos - 2));
+		size_t bodyStart = *nameEnd + 1;
+		string const closingTag = "</" + element.text + ">";
+		size_t closingPos = _template.find(closingTag, bodyStart);
+		if (closingPos == string_view::npos)
+			return nullopt;
+		element.body = compileTemplate(_template.substr(bodyStart, closingPos - bodyStart));
+		return {{move(element), closingPos + closingTag.size()}};
+	}
+	else if (kind == '?')
+	{
+		size_t nameStart = _pos + 2;
+		if (nameStart < _template.size() && _template[nameStart] == '+')
+			++nameStart;
+		optional<size_t> nameEnd = parameterNameEnd(_template, nameStart);
+		if (!nameEnd)
+			return nullopt;
+		element.kind = Kind::Condition;
+		element.text = string(_template.substr(_pos + 2, *nameEnd - _pos - 2));
+		size_t bodyStart = *nameEnd + 1;
+		string const closingTag = "</" + element.text + ">";
+		string const elseTag = "<!" + element.text + ">";
+		size_t closingPos = _template.find(closingTag, bodyStart);
+		if (closingPos == string_view::npos)
+			return nullopt;
+		size_t elsePos = _template.find(elseTag, bodyStart);
+		if (elsePos < closingPos)
+		{
+			element.body = compileTemplate(_template.substr(bodyStart, elsePos - bodyStart));
+			size_t elseStart = elsePos + elseTag.size();
+			element.elseBody = compileTemplate(_template.substr(elseStart, closingPos - elseStart));
+		}
+		else
+			element.body = compileTemplate(_template.substr(bodyStart, closingPos - bodyStart));
+		return {{move(element), closingPos + closingTag.size()}};
 	}
+	return nullopt;
 }
 
-namespace
+unique_ptr<CompiledTemplate> compileTemplate(string_view _template)
 {
-template<class ReplaceCallback>
-string regex_replace(
-	string const& _source,
-	regex const& _pattern,
-	ReplaceCallback _replace,
-	regex_constants::match_flag_type _flags = regex_constants::match_default
-)
+	auto compiled = make_unique<CompiledTemplate>();
+	compiled->source = string(_template);
+
+	auto appendText = [&](size_t _begin, size_t _end) {
+		if (_begin < _end)
+		{
+			CompiledTemplate::Element text;
+			text.text = string(_template.substr(_begin, _end - _begin));
+			compiled->elements.emplace_back(move(text));
+		}
+	};
+
+	size_t textStart = 0;
+	for (size_t pos = _template.find('<'); pos != string_view::npos; pos = _template.find('<', pos))
+		if (auto tag = compileTag(_template, pos))
+		{
+			appendText(textStart, pos);
+			compiled->elements.emplace_back(move(tag->first));
+			textStart = pos = tag->second;
+		}
+		else
+			++pos;
+	appendText(textStart, _template.size());
+	return compiled;
+}
+
+/// @returns the parsed form of @a _template, parsing it only the first time it is requested.
+shared_ptr<CompiledTemplate const> compiledTemplate(string const& _template)
 {
-	sregex_iterator curMatch(_source.begin(), _source.end(), _pattern, _flags);
-	sregex_iterator matchEnd;
-	string::const_iterator lastMatchedPos(_source.cbegin());
-	string result;
-	while (curMatch != matchEnd)
+	static mutex cacheMutex;
+	static unordered_map<string, shared_ptr<CompiledTemplate const>> cache;
 	{
-		result.append(curMatch->prefix().first, curMatch->prefix().second);
-		result.append(_replace(*curMatch));
-		lastMatchedPos = (*curMatch)[0].second;
-		++curMatch;
+		lock_guard<mutex> lock(cacheMutex);
+		if (auto it = cache.find(_template); it != cache.end())
+			return it->second;
 	}
-	result.append(lastMatchedPos, _source.cend());
-	return result;
-}
+	shared_ptr<CompiledTemplate const> compiled = compileTemplate(_template);
+	lock_guard<mutex> lock(cacheMutex);
+	// Templates built at runtime could otherwise let the cache grow without bounds.
+	if (cache.size() >= 0x1000)
+		cache.clear();
+	return cache.emplace(_template, move(compiled)).first->second;
 }
 
-string Whiskers::replace(
-	string const& _template,
-	StringMap const& _parameters,
-	map<string, bool> const& _conditions,
-	map<string, vector<StringMap>> const& _listParameters
-)
+/// Parameters visible while rendering a (part of a) template.
+struct RenderContext
 {
-	static regex listOrTag(
-		"<(" + paramRegex() + ")>|"
-		"<#(" + paramRegex() + ")>((?:.|\\r|\\n)*?)</\\2>|"
-		"<\\?(\\+?" + paramRegex() + ")>((?:.|\\r|\\n)*?)(<!\\4>((?:.|\\r|\\n)*?))?</\\4>"
-	);
-	return regex_replace(_template, listOrTag, [&](match_results<string::const_iterator> _match) -> string
+	Whiskers::StringMap const& parameters;
+	/// Parameters of the current list element, if inside of a list.
+	Whiskers::StringMap const* listElement;
+	map<string, bool> const& conditions;
+	/// List parameters, if not inside of a list.
+	Whiskers::StringListMap const* listParameters;
+
+	string const* parameter(string const& _name) const
+	{
+		if (listElement)
+			if (auto it = listElement->find(_name); it != listElement->end())
+				return &it->second;
+		if (auto it = parameters.find(_name); it != parameters.end())
+			return &it->second;
+		return nullptr;
+	}
+	vector<Whiskers::StringMap> const* list(string const& _name) const
 	{
-		string tagName(_match[1]);
-		string listName(_match[2]);
-		string conditionName(_match[4]);
-		if (!tagName.empty())
+		if (listParameters)
+			if (auto it = listParameters->find(_name); it != listParameters->end())
+				return &it->second;
+		return nullptr;
+	}
+};
+
+void render(CompiledTemplate const& _template, RenderContext const& _context, string& _output)
+{
+	using Kind = CompiledTemplate::Kind;
+	for (CompiledTemplate::Element const& element: _template.elements)
+		switch (element.kind)
 		{
+		case Kind::Text:
+			_output += element.text;
+			break;
+		case Kind::Parameter:
+		{
+			string const* value = _context.parameter(element.text);
 			assertThrow(
-				_parameters.count(tagName),
+				value,
 				WhiskersError,
-				"Value for tag " + tagName + " not provided.\n" +
+				"Value for tag " + element.text + " not provided.\n" +
 				"Template:\n" +
-				_template
+				_template.source
 			);
-			return _parameters.at(tagName);
+			_output += *value;
+			break;
 		}
-		else if (!listName.empty())
+		case Kind::List:
 		{
-			string templ(_match[3]);
-			assertThrow(
-				_listParameters.count(listName),
-				WhiskersError, "List parameter " + listName + " not set."
-			);
-			string replacement;
-			for (auto const& parameters: _listParameters.at(listName))
-				replacement += replace(templ, joinMaps(_parameters, parameters), _conditions);
-			return replacement;
+			auto const* values = _context.list(element.text);
+			assertThrow(values, WhiskersError, "List parameter " + element.text + " not set.");
+			for (Whiskers::StringMap const& listElement: *values)
+			{
+				for (auto const& parameter: listElement)
+					assertThrow(!_context.parameters.count(parameter.first), WhiskersError, "Parameter collision");
+				// Lists cannot be nested, so list parameters are not visible inside of lists.
+				render(*element.body, RenderContext{_context.parameters, &listElement, _context.conditions, nullptr}, _output);
+			}
+			break;
 		}
-		else
+		case Kind::Condition:
 		{
-			assertThrow(!conditionName.empty(), WhiskersError, "");
 			bool conditionValue = false;
-			if (conditionName[0] == '+')
+			if (element.text[0] == '+')
 			{
-				string tag = conditionName.substr(1);
-
-				if (_parameters.count(tag))
-					conditionValue = !_parameters.at(tag).empty();
-				else if (_listParameters.count(tag))
-					conditionValue = !_listParameters.at(tag).empty();
+				string tag = element.text.substr(1);
+				if (string const* value = _context.parameter(tag))
+					conditionValue = !value->empty();
+				else if (auto const* values = _context.list(tag))
+					conditionValue = !values->empty();
 				else
 					assertThrow(false, WhiskersError, "Tag " + tag + " used as condition but was not set.");
 			}
 			else
 			{
+				auto it = _context.conditions.find(element.text);
 				assertThrow(
-					_conditions.count(conditionName),
-					WhiskersError, "Condition parameter " + conditionName + " not set."
+					it != _context.conditions.end(),
+					WhiskersError, "Condition parameter " + element.text + " not set."
 				);
-				conditionValue = _conditions.at(conditionName);
+				conditionValue = it->second;
 			}
-			return replace(
-				conditionValue ? _match[5] : _match[7],
-				_parameters,
-				_conditions,
-				_listParameters
-			);
+			if (conditionValue)
+				render(*element.body, _context, _output);
+			else if (element.elseBody)
+				render(*element.elseBody, _context, _output);
+			break;
+		}
 		}
-	});
 }
 
-Whiskers::StringMap Whiskers::joinMaps(
-	Whiskers::StringMap const& _a,
-	Whiskers::StringMap const& _b
-)
+}
+
+string Whiskers::render() const
 {
-	Whiskers::StringMap ret = _a;
-	for (auto const& x: _b)
+	shared_ptr<CompiledTemplate const> compiled = compiledTemplate(m_template);
+	string result;
+	result.reserve(m_template.size());
+	::render(*compiled, RenderContext{m_parameters, nullptr, m_conditions, &m_listParameters}, result);
+	return result;
+}
+
+void Whiskers::checkParameterValid(string const& _parameter) const
+{
+	assertThrow(
+		!_parameter.empty() && all_of(_parameter.begin(), _parameter.end(), isParameterCharacter),
+		WhiskersError,
+		"Parameter" + _parameter + " contains invalid characters."
+	);
+}
+
+void Whiskers::checkParameterUnknown(string const& _parameter) const
+{
+	assertThrow(
+		!m_parameters.count(_parameter),
+		WhiskersError,
+		_parameter + " already set as value parameter."
+	);
+	assertThrow(
+		!m_conditions.count(_parameter),
+		WhiskersError,
+		_parameter + " already set as condition parameter."
+	);
+	assertThrow(
+		!m_listParameters.count(_parameter),
+		WhiskersError,
+		_parameter + " already set as list parameter."
+	);
+}
+
+void Whiskers::checkTemplateContainsTags(string const& _parameter, vector<string> const& _prefixes) const
+{
+	for (auto const& prefix: _prefixes)
+	{
+		string tag{"<" + prefix + _parameter + ">"};
 		assertThrow(
-			ret.insert(x).second,
+			m_template.find(tag) != string::npos,
 			WhiskersError,
-			"Parameter collision"
+			"Tag '" + tag + "' not found in template:\n" + m_template
 		);
-	return ret;
+	}
 }
-
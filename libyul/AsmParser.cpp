@@ -35,7 +35,7 @@
 #include <boost/algorithm/string.hpp>
 
 #include <algorithm>
-#include <regex>
+#include <array>
 
 using namespace std;
 using namespace solidity;
@@ -46,11 +46,11 @@ using namespace solidity::yul;
 namespace
 {
 
-optional<int> toInt(string const& _value)
+optional<int> toInt(string_view _value)
 {
 	try
 	{
-		return stoi(_value);
+		return stoi(string(_value));
 	}
 	catch (...)
 	{
@@ -58,18 +58,106 @@ optional<int> toInt(string const& _value)
 	}
 }
 
+// The annotations in comments are matched by hand instead of by regular expressions, since they
+// precede nearly every statement of the generated IR. Whitespace and digits are those of ``\s`` and ``\d``.
+bool isWhitespace(char _c)
+{
+	return _c == ' ' || _c == '\t' || _c == '\n' || _c == '\v' || _c == '\f' || _c == '\r';
+}
+
+bool isDigit(char _c)
+{
+	return '0' <= _c && _c <= '9';
+}
+
+size_t skipWhitespace(string_view _text, size_t _position)
+{
+	while (_position < _text.size() && isWhitespace(_text[_position]))
+		++_position;
+	return _position;
+}
+
+size_t skipDigits(string_view _text, size_t _position)
+{
+	while (_position < _text.size() && isDigit(_text[_position]))
+		++_position;
+	return _position;
+}
+
+/// @returns the first tag like ``@src`` in @a _text that is preceded by whitespace or the start of the text
+/// and followed by whitespace or the end of the text, together with the position after that whitespace.
+optional<pair<string_view, size_t>> findTag(string_view _text)
+{
+	if (_text.find('@') == string_view::npos)
+		return nullopt;
+
+	auto isTagCharacter = [](char _c) {
+		return ('a' <= _c && _c <= 'z') || ('A' <= _c && _c <= 'Z') || isDigit(_c) || _c == '-' || _c == '_';
+	};
+	auto tagAt = [&](size_t _position) -> optional<pair<string_view, size_t>> {
+		if (_position >= _text.size() || _text[_position] != '@')
+			return nullopt;
+		size_t end = _position + 1;
+		while (end < _text.size() && isTagCharacter(_text[end]))
+			++end;
+		if (end == _position + 1 || (end < _text.size() && !isWhitespace(_text[end])))
+			return nullopt;
+		return {{_text.substr(_position, end - _position), skipWhitespace(_text, end)}};
+	};
+
+	if (auto tag = tagAt(0))
+		return tag;
+	for (size_t position = 0; position < _text.size();)
+		if (isWhitespace(_text[position]))
+		{
+			position = skipWhitespace(_text, position);
+			if (auto tag = tagAt(position))
+				return tag;
+		}
+		else
+			++position;
+	return nullopt;
+}
+
+/// @returns the position after the value of a source location (``-1`` or a non-negative integer)
+/// starting at @a _position in @a _text or nullopt if there is none.
+optional<size_t> matchLocationValue(string_view _text, size_t _position)
+{
+	if (_text.substr(_position, 2) == "-1")
+		return _position + 2;
+	size_t end = skipDigits(_text, _position);
+	if (end == _position)
+		return nullopt;
+	return end;
+}
+
 }
 
 std::shared_ptr<DebugData const> Parser::createDebugData() const
 {
+	auto reuseOrCreate = [&](
+		SourceLocation const& _nativeLocation,
+		SourceLocation const& _originLocation,
+		optional<int64_t> _astID
+	) {
+		if (
+			!m_lastDebugData ||
+			m_lastDebugData->nativeLocation != _nativeLocation ||
+			m_lastDebugData->originLocation != _originLocation ||
+			m_lastDebugData->astID != _astID
+		)
+			m_lastDebugData = DebugData::create(_nativeLocation, _originLocation, _astID);
+		return m_lastDebugData;
+	};
+
 	switch (m_useSourceLocationFrom)
 	{
 		case UseSourceLocationFrom::Scanner:
-			return DebugData::create(ParserBase::currentLocation(), ParserBase::currentLocation());
+			return reuseOrCreate(ParserBase::currentLocation(), ParserBase::currentLocation(), nullopt);
 		case UseSourceLocationFrom::LocationOverride:
-			return DebugData::create(m_locationOverride, m_locationOverride);
+			return reuseOrCreate(m_locationOverride, m_locationOverride, nullopt);
 		case UseSourceLocationFrom::Comments:
-			return DebugData::create(ParserBase::currentLocation(), m_locationFromComment, m_astIDFromComment);
+			return reuseOrCreate(ParserBase::currentLocation(), m_locationFromComment, m_astIDFromComment);
 	}
 	solAssert(false, "");
 }
@@ -146,31 +234,26 @@ void Parser::fetchDebugDataFromComment()
 {
 	solAssert(m_sourceNames.has_value(), "");
 
-	static regex const tagRegex = regex(
-		R"~~((?:^|\s+)(@[a-zA-Z0-9\-_]+)(?:\s+|$))~~", // tag, e.g: @src
-		regex_constants::ECMAScript | regex_constants::optimize
-	);
-
 	string_view commentLiteral = m_scanner->currentCommentLiteral();
-	match_results<string_view::const_iterator> match;
 
 	langutil::SourceLocation originLocation = m_locationFromComment;
 	// Empty for each new node.
 	optional<int> astID;
 
-	while (regex_search(commentLiteral.cbegin(), commentLiteral.cend(), match, tagRegex))
+	// Tags, e.g: @src
+	while (auto tagAndEnd = findTag(commentLiteral))
 	{
-		solAssert(match.size() == 2, "");
-		commentLiteral = commentLiteral.substr(static_cast<size_t>(match.position() + match.length()));
+		string_view const tag = tagAndEnd->first;
+		commentLiteral = commentLiteral.substr(tagAndEnd->second);
 
-		if (match[1] == "@src")
+		if (tag == "@src")
 		{
 			if (auto parseResult = parseSrcComment(commentLiteral, m_scanner->currentCommentLocation()))
 				tie(commentLiteral, originLocation) = *parseResult;
 			else
 				break;
 		}
-		else if (match[1] == "@ast-id")
+		else if (tag == "@ast-id")
 		{
 			if (auto parseResult = parseASTIDComment(commentLiteral, m_scanner->currentCommentLocation()))
 				tie(commentLiteral, astID) = *parseResult;
@@ -191,13 +274,28 @@ optional<pair<string_view, SourceLocation>> Parser::parseSrcComment(
 	langutil::SourceLocation const& _commentLocation
 )
 {
-	static regex const argsRegex = regex(
-		R"~~(^(-1|\d+):(-1|\d+):(-1|\d+)(?:\s+|$))~~"  // index and location, e.g.: 1:234:-1
-		R"~~(("(?:[^"\\]|\\.)*"?)?)~~",                // optional code snippet, e.g.: "string memory s = \"abc\";..."
-		regex_constants::ECMAScript | regex_constants::optimize
-	);
-	match_results<string_view::const_iterator> match;
-	if (!regex_search(_arguments.cbegin(), _arguments.cend(), match, argsRegex))
+	// Index and location, e.g.: 1:234:-1
+	array<string_view, 3> values;
+	size_t position = 0;
+	bool matched = true;
+	for (size_t i = 0; i < values.size() && matched; ++i)
+	{
+		if (i > 0)
+			matched = position < _arguments.size() && _arguments[position++] == ':';
+		if (optional<size_t> end = matched ? matchLocationValue(_arguments, position) : nullopt)
+		{
+			values[i] = _arguments.substr(position, *end - position);
+			position = *end;
+		}
+		else
+			matched = false;
+	}
+	if (matched && position < _arguments.size())
+	{
+		matched = isWhitespace(_arguments[position]);
+		position = skipWhitespace(_arguments, position);
+	}
+	if (!matched)
 	{
 		m_errorReporter.syntaxError(
 			8387_error,
@@ -207,12 +305,29 @@ optional<pair<string_view, SourceLocation>> Parser::parseSrcComment(
 		return nullopt;
 	}
 
-	solAssert(match.size() == 5, "");
-	string_view tail = _arguments.substr(static_cast<size_t>(match.position() + match.length()));
+	// Optional code snippet, e.g.: "string memory s = \"abc\";..."
+	optional<string_view> snippet;
+	if (position < _arguments.size() && _arguments[position] == '"')
+	{
+		size_t end = position + 1;
+		// Escapes cannot contain line terminators.
+		while (end < _arguments.size() && _arguments[end] != '"')
+			if (_arguments[end] != '\\')
+				++end;
+			else if (end + 1 < _arguments.size() && _arguments[end + 1] != '\n' && _arguments[end + 1] != '\r')
+				end += 2;
+			else
+				break;
+		if (end < _arguments.size() && _arguments[end] == '"')
+			++end;
+		snippet = _arguments.substr(position, end - position);
+		position = end;
+	}
+	string_view tail = _arguments.substr(position);
 
-	if (match[4].matched && (
-		!boost::algorithm::ends_with(match[4].str(), "\"") ||
-		boost::algorithm::ends_with(match[4].str(), "\\\"")
+	if (snippet && (
+		!boost::algorithm::ends_with(*snippet, "\"") ||
+		boost::algorithm::ends_with(*snippet, "\\\"")
 	))
 	{
 		m_errorReporter.syntaxError(
@@ -223,9 +338,9 @@ optional<pair<string_view, SourceLocation>> Parser::parseSrcComment(
 		return {{tail, SourceLocation{}}};
 	}
 
-	optional<int> const sourceIndex = toInt(match[1].str());
-	optional<int> const start = toInt(match[2].str());
-	optional<int> const end = toInt(match[3].str());
+	optional<int> const sourceIndex = toInt(values[0]);
+	optional<int> const start = toInt(values[1]);
+	optional<int> const end = toInt(values[2]);
 
 	if (!sourceIndex.has_value() || !start.has_value() || !end.has_value())
 		m_errorReporter.syntaxError(
@@ -256,21 +371,12 @@ optional<pair<string_view, optional<int>>> Parser::parseASTIDComment(
 	langutil::SourceLocation const& _commentLocation
 )
 {
-	static regex const argRegex = regex(
-		R"~~(^(\d+)(?:\s|$))~~",
-		regex_constants::ECMAScript | regex_constants::optimize
-	);
-	match_results<string_view::const_iterator> match;
+	// A non-negative integer followed by whitespace or the end.
+	size_t end = skipDigits(_arguments, 0);
+	bool matched = end > 0 && (end == _arguments.size() || isWhitespace(_arguments[end]));
 	optional<int> astID;
-	bool matched = regex_search(_arguments.cbegin(), _arguments.cend(), match, argRegex);
-	string_view tail = _arguments;
 	if (matched)
-	{
-		solAssert(match.size() == 2, "");
-		tail = _arguments.substr(static_cast<size_t>(match.position() + match.length()));
-
-		astID = toInt(match[1].str());
-	}
+		astID = toInt(_arguments.substr(0, end));
 
 	if (!matched || !astID || *astID < 0 || static_cast<int64_t>(*astID) != *astID)
 	{
@@ -118,6 +118,7 @@ protected:
 	);
 
 	/// Creates a DebugData object with the correct source location set.
+	/// Reuses the previous one if the locations did not change, e.g. for nodes starting at the same token.
 	std::shared_ptr<DebugData const> createDebugData() const;
 
 	void updateLocationEndFrom(
@@ -161,6 +162,8 @@ private:
 	langutil::SourceLocation m_locationFromComment;
 	std::optional<int64_t> m_astIDFromComment;
 	UseSourceLocationFrom m_useSourceLocationFrom = UseSourceLocationFrom::Scanner;
+	/// The debug data returned by the last call to createDebugData.
+	mutable std::shared_ptr<DebugData const> m_lastDebugData;
 	ForLoopComponent m_currentForLoopComponent = ForLoopComponent::None;
 	bool m_insideFunction = false;
 };
@@ -29,11 +29,8 @@
 #include <libsolutil/CommonData.h>
 #include <libsolutil/StringUtils.h>
 
-#include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/replace.hpp>
 
-#include <range/v3/view/transform.hpp>
-
 #include <memory>
 #include <functional>
 
@@ -45,204 +42,330 @@ using namespace solidity::yul;
 
 string AsmPrinter::operator()(Literal const& _literal)
 {
-	string const locationComment = formatDebugData(_literal);
+	return printed(_literal);
+}
+
+string AsmPrinter::operator()(Identifier const& _identifier)
+{
+	return printed(_identifier);
+}
+
+string AsmPrinter::operator()(ExpressionStatement const& _expr)
+{
+	return printed(_expr);
+}
+
+string AsmPrinter::operator()(Assignment const& _assignment)
+{
+	return printed(_assignment);
+}
+
+string AsmPrinter::operator()(VariableDeclaration const& _variableDeclaration)
+{
+	return printed(_variableDeclaration);
+}
+
+string AsmPrinter::operator()(FunctionDefinition const& _functionDefinition)
+{
+	return printed(_functionDefinition);
+}
+
+string AsmPrinter::operator()(FunctionCall const& _functionCall)
+{
+	return printed(_functionCall);
+}
+
+string AsmPrinter::operator()(If const& _if)
+{
+	return printed(_if);
+}
+
+string AsmPrinter::operator()(Switch const& _switch)
+{
+	return printed(_switch);
+}
+
+string AsmPrinter::operator()(ForLoop const& _forLoop)
+{
+	return printed(_forLoop);
+}
+
+string AsmPrinter::operator()(Break const& _break)
+{
+	return printed(_break);
+}
+
+string AsmPrinter::operator()(Continue const& _continue)
+{
+	return printed(_continue);
+}
+
+// '_leave' and '__leave' is reserved in VisualStudio
+string AsmPrinter::operator()(Leave const& leave_)
+{
+	return printed(leave_);
+}
+
+string AsmPrinter::operator()(Block const& _block)
+{
+	return printed(_block);
+}
+
+void AsmPrinter::print(Literal const& _literal)
+{
+	printDebugData(_literal);
 
 	switch (_literal.kind)
 	{
 	case LiteralKind::Number:
 		yulAssert(isValidDecimal(_literal.value.str()) || isValidHex(_literal.value.str()), "Invalid number literal");
-		return locationComment + _literal.value.str() + appendTypeName(_literal.type);
+		m_out += _literal.value.str();
+		printTypeName(_literal.type);
+		return;
 	case LiteralKind::Boolean:
 		yulAssert(_literal.value == "true"_yulstring || _literal.value == "false"_yulstring, "Invalid bool literal.");
-		return locationComment + ((_literal.value == "true"_yulstring) ? "true" : "false") + appendTypeName(_literal.type, true);
+		m_out += (_literal.value == "true"_yulstring) ? "true" : "false";
+		printTypeName(_literal.type, true);
+		return;
 	case LiteralKind::String:
 		break;
 	}
 
-	return locationComment + escapeAndQuoteString(_literal.value.str()) + appendTypeName(_literal.type);
+	m_out += escapeAndQuoteString(_literal.value.str());
+	printTypeName(_literal.type);
 }
 
-string AsmPrinter::operator()(Identifier const& _identifier)
+void AsmPrinter::print(Identifier const& _identifier)
 {
 	yulAssert(!_identifier.name.empty(), "Invalid identifier.");
-	return formatDebugData(_identifier) + _identifier.name.str();
+	printDebugData(_identifier);
+	m_out += _identifier.name.str();
 }
 
-string AsmPrinter::operator()(ExpressionStatement const& _statement)
+void AsmPrinter::print(ExpressionStatement const& _statement)
 {
-	string const locationComment = formatDebugData(_statement);
-
-	return locationComment + std::visit(*this, _statement.expression);
+	printDebugData(_statement);
+	print(_statement.expression);
 }
 
-string AsmPrinter::operator()(Assignment const& _assignment)
+void AsmPrinter::print(Assignment const& _assignment)
 {
-	string const locationComment = formatDebugData(_assignment);
+	printDebugData(_assignment);
 
 	yulAssert(_assignment.variableNames.size() >= 1, "");
-	string variables = (*this)(_assignment.variableNames.front());
+	print(_assignment.variableNames.front());
 	for (size_t i = 1; i < _assignment.variableNames.size(); ++i)
-		variables += ", " + (*this)(_assignment.variableNames[i]);
+	{
+		m_out += ", ";
+		print(_assignment.variableNames[i]);
+	}
 
-	return locationComment + variables + " := " + std::visit(*this, *_assignment.value);
+	m_out += " := ";
+	print(*_assignment.value);
 }
 
-string AsmPrinter::operator()(VariableDeclaration const& _variableDeclaration)
+void AsmPrinter::print(VariableDeclaration const& _variableDeclaration)
 {
-	string out = formatDebugData(_variableDeclaration);
+	printDebugData(_variableDeclaration);
 
-	out += "let ";
-	out += boost::algorithm::join(
-		_variableDeclaration.variables | ranges::views::transform(
-			[this](TypedName argument) { return formatTypedName(argument); }
-		),
-		", "
-	);
+	m_out += "let ";
+	printTypedNames(_variableDeclaration.variables);
 	if (_variableDeclaration.value)
 	{
-		out += " := ";
-		out += std::visit(*this, *_variableDeclaration.value);
+		m_out += " := ";
+		print(*_variableDeclaration.value);
 	}
-	return out;
 }
 
-string AsmPrinter::operator()(FunctionDefinition const& _functionDefinition)
+void AsmPrinter::print(FunctionDefinition const& _functionDefinition)
 {
 	yulAssert(!_functionDefinition.name.empty(), "Invalid function name.");
 
-	string out = formatDebugData(_functionDefinition);
-	out += "function " + _functionDefinition.name.str() + "(";
-	out += boost::algorithm::join(
-		_functionDefinition.parameters | ranges::views::transform(
-			[this](TypedName argument) { return formatTypedName(argument); }
-		),
-		", "
-	);
-	out += ")";
+	printDebugData(_functionDefinition);
+	m_out += "function ";
+	m_out += _functionDefinition.name.str();
+	m_out += "(";
+	printTypedNames(_functionDefinition.parameters);
+	m_out += ")";
 	if (!_functionDefinition.returnVariables.empty())
 	{
-		out += " -> ";
-		out += boost::algorithm::join(
-			_functionDefinition.returnVariables | ranges::views::transform(
-				[this](TypedName argument) { return formatTypedName(argument); }
-			),
-			", "
-		);
+		m_out += " -> ";
+		printTypedNames(_functionDefinition.returnVariables);
 	}
 
-	return out + "\n" + (*this)(_functionDefinition.body);
+	newLine();
+	print(_functionDefinition.body);
 }
 
-string AsmPrinter::operator()(FunctionCall const& _functionCall)
+void AsmPrinter::print(FunctionCall const& _functionCall)
 {
-	string const locationComment = formatDebugData(_functionCall);
-	string const functionName = (*this)(_functionCall.functionName);
-	return
-		locationComment +
-		functionName + "(" +
-		boost::algorithm::join(
-			_functionCall.arguments | ranges::views::transform([&](auto&& _node) { return std::visit(*this, _node); }),
-			", " ) +
-		")";
+	printDebugData(_functionCall);
+	print(_functionCall.functionName);
+	m_out += "(";
+	for (size_t i = 0; i < _functionCall.arguments.size(); ++i)
+	{
+		if (i > 0)
+			m_out += ", ";
+		print(_functionCall.arguments[i]);
+	}
+	m_out += ")";
 }
 
-string AsmPrinter::operator()(If const& _if)
+void AsmPrinter::print(If const& _if)
 {
 	yulAssert(_if.condition, "Invalid if condition.");
 
-	string out = formatDebugData(_if);
-	out += "if " + std::visit(*this, *_if.condition);
-
-	string body = (*this)(_if.body);
-	char delim = '\n';
-	if (body.find('\n') == string::npos)
-		delim = ' ';
-
-	return out + delim + body;
+	printDebugData(_if);
+	m_out += "if ";
+	print(*_if.condition);
+
+	size_t const delimiterStart = m_out.size();
+	newLine();
+	size_t const bodyStart = m_out.size();
+	print(_if.body);
+	// A body without line breaks is short, so moving it is cheap.
+	if (m_out.find('\n', bodyStart) == string::npos)
+		m_out.replace(delimiterStart, bodyStart - delimiterStart, " ");
 }
 
-string AsmPrinter::operator()(Switch const& _switch)
+void AsmPrinter::print(Switch const& _switch)
 {
 	yulAssert(_switch.expression, "Invalid expression pointer.");
 
-	string out = formatDebugData(_switch);
-	out += "switch " + std::visit(*this, *_switch.expression);
+	printDebugData(_switch);
+	m_out += "switch ";
+	print(*_switch.expression);
 
 	for (auto const& _case: _switch.cases)
 	{
+		newLine();
 		if (!_case.value)
-			out += "\ndefault ";
+			m_out += "default ";
 		else
-			out += "\ncase " + (*this)(*_case.value) + " ";
-		out += (*this)(_case.body);
+		{
+			m_out += "case ";
+			print(*_case.value);
+			m_out += " ";
+		}
+		print(_case.body);
 	}
-	return out;
 }
 
-string AsmPrinter::operator()(ForLoop const& _forLoop)
+void AsmPrinter::print(ForLoop const& _forLoop)
 {
 	yulAssert(_forLoop.condition, "Invalid for loop condition.");
-	string const locationComment = formatDebugData(_forLoop);
-
-	string pre = (*this)(_forLoop.pre);
-	string condition = std::visit(*this, *_forLoop.condition);
-	string post = (*this)(_forLoop.post);
+	printDebugData(_forLoop);
+
+	m_out += "for ";
+	size_t const preStart = m_out.size();
+	print(_forLoop.pre);
+	size_t const preEnd = m_out.size();
+	newLine();
+	size_t const conditionStart = m_out.size();
+	print(*_forLoop.condition);
+	size_t const conditionEnd = m_out.size();
+	newLine();
+	size_t const postStart = m_out.size();
+	print(_forLoop.post);
+	size_t const postEnd = m_out.size();
 
-	char delim = '\n';
 	if (
-		pre.size() + condition.size() + post.size() < 60 &&
-		pre.find('\n') == string::npos &&
-		post.find('\n') == string::npos
+		(preEnd - preStart) + (conditionEnd - conditionStart) + (postEnd - postStart) < 60 &&
+		m_out.find('\n', preStart) >= preEnd &&
+		m_out.find('\n', postStart) == string::npos
 	)
-		delim = ' ';
-	return
-		locationComment +
-		("for " + move(pre) + delim + move(condition) + delim + move(post) + "\n") +
-		(*this)(_forLoop.body);
+	{
+		// The later delimiter is replaced first to keep the position of the earlier one valid.
+		m_out.replace(conditionEnd, postStart - conditionEnd, " ");
+		m_out.replace(preEnd, conditionStart - preEnd, " ");
+	}
+	newLine();
+	print(_forLoop.body);
 }
 
-string AsmPrinter::operator()(Break const& _break)
+void AsmPrinter::print(Break const& _break)
 {
-	return formatDebugData(_break) + "break";
+	printDebugData(_break);
+	m_out += "break";
 }
 
-string AsmPrinter::operator()(Continue const& _continue)
+void AsmPrinter::print(Continue const& _continue)
 {
-	return formatDebugData(_continue) + "continue";
+	printDebugData(_continue);
+	m_out += "continue";
 }
 
 // '_leave' and '__leave' is reserved in VisualStudio
-string AsmPrinter::operator()(Leave const& leave_)
+void AsmPrinter::print(Leave const& leave_)
 {
-	return formatDebugData(leave_) + "leave";
+	printDebugData(leave_);
+	m_out += "leave";
 }
 
-string AsmPrinter::operator()(Block const& _block)
+void AsmPrinter::print(Block const& _block)
 {
-	string const locationComment = formatDebugData(_block);
+	printDebugData(_block);
 
 	if (_block.statements.empty())
-		return locationComment + "{ }";
-	string body = boost::algorithm::join(
-		_block.statements | ranges::views::transform([&](auto&& _node) { return std::visit(*this, _node); }),
-		"\n"
-	);
-	if (body.size() < 30 && body.find('\n') == string::npos)
-		return locationComment + "{ " + body + " }";
+	{
+		m_out += "{ }";
+		return;
+	}
+
+	size_t const blockStart = m_out.size();
+	m_out += "{";
+	++m_indentation;
+	newLine();
+	size_t const bodyStart = m_out.size();
+	for (size_t i = 0; i < _block.statements.size(); ++i)
+	{
+		if (i > 0)
+			newLine();
+		print(_block.statements[i]);
+	}
+	--m_indentation;
+
+	if (m_out.size() - bodyStart < 30 && m_out.find('\n', bodyStart) == string::npos)
+	{
+		m_out.replace(blockStart + 1, bodyStart - blockStart - 1, " ");
+		m_out += " }";
+	}
 	else
 	{
-		boost::replace_all(body, "\n", "\n    ");
-		return locationComment + "{\n    " + body + "\n}";
+		newLine();
+		m_out += "}";
 	}
 }
 
-string AsmPrinter::formatTypedName(TypedName _variable)
+void AsmPrinter::print(Expression const& _expression)
+{
+	std::visit([&](auto const& _node) { print(_node); }, _expression);
+}
+
+void AsmPrinter::print(Statement const& _statement)
+{
+	std::visit([&](auto const& _node) { print(_node); }, _statement);
+}
+
+void AsmPrinter::print(TypedName const& _variable)
 {
 	yulAssert(!_variable.name.empty(), "Invalid variable name.");
-	return formatDebugData(_variable) + _variable.name.str() + appendTypeName(_variable.type);
+	printDebugData(_variable);
+	m_out += _variable.name.str();
+	printTypeName(_variable.type);
+}
+
+void AsmPrinter::printTypedNames(vector<TypedName> const& _variables)
+{
+	for (size_t i = 0; i < _variables.size(); ++i)
+	{
+		if (i > 0)
+			m_out += ", ";
+		print(_variables[i]);
+	}
 }
 
-string AsmPrinter::appendTypeName(YulString _type, bool _isBoolLiteral) const
+void AsmPrinter::printTypeName(YulString _type, bool _isBoolLiteral)
 {
 	if (m_dialect && !_type.empty())
 	{
@@ -252,10 +375,11 @@ string AsmPrinter::appendTypeName(YulString _type, bool _isBoolLiteral) const
 			// Special case: If we have a bool type but empty default type, do not remove the type.
 			_type = {};
 	}
-	if (_type.empty())
-		return {};
-	else
-		return ":" + _type.str();
+	if (!_type.empty())
+	{
+		m_out += ":";
+		m_out += _type.str();
+	}
 }
 
 string AsmPrinter::formatSourceLocation(
@@ -302,15 +426,21 @@ string AsmPrinter::formatSourceLocation(
 	return sourceLocation + (solidityCodeSnippet.empty() ? "" : "  ") + solidityCodeSnippet;
 }
 
-string AsmPrinter::formatDebugData(shared_ptr<DebugData const> const& _debugData, bool _statement)
+void AsmPrinter::printDebugData(shared_ptr<DebugData const> const& _debugData, bool _statement)
 {
 	if (!_debugData || m_debugInfoSelection.none())
-		return "";
+		return;
+
+	size_t const commentStart = m_out.size();
+	m_out += _statement ? "/// " : "/** ";
+	size_t const bodyStart = m_out.size();
 
-	vector<string> items;
 	if (auto id = _debugData->astID)
 		if (m_debugInfoSelection.astID)
-			items.emplace_back("@ast-id " + to_string(*id));
+		{
+			m_out += "@ast-id ";
+			m_out += to_string(*id);
+		}
 
 	if (
 		m_lastLocation != _debugData->originLocation &&
@@ -319,20 +449,32 @@ string AsmPrinter::formatDebugData(shared_ptr<DebugData const> const& _debugData
 	{
 		m_lastLocation = _debugData->originLocation;
 
-		items.emplace_back(formatSourceLocation(
-			_debugData->originLocation,
-			m_nameToSourceIndex,
-			m_debugInfoSelection,
-			m_soliditySourceProvider
-		));
+		SourceLocation const& location = _debugData->originLocation;
+		auto&& [it, inserted] = m_locationComments.try_emplace(
+			make_tuple(location.sourceName.get(), location.start, location.end)
+		);
+		if (inserted)
+			it->second = formatSourceLocation(
+				location,
+				m_nameToSourceIndex,
+				m_debugInfoSelection,
+				m_soliditySourceProvider
+			);
+		if (m_out.size() > bodyStart)
+			m_out += " ";
+		m_out += it->second;
 	}
 
-	string commentBody = joinHumanReadable(items, " ");
-	if (commentBody.empty())
-		return "";
+	if (m_out.size() == bodyStart)
+		m_out.resize(commentStart);
+	else if (_statement)
+		newLine();
 	else
-		return
-			_statement ?
-			"/// " + commentBody + "\n" :
-			"/** " + commentBody + " */ ";
+		m_out += " */ ";
+}
+
+void AsmPrinter::newLine()
+{
+	m_out += '\n';
+	m_out.append(4 * m_indentation, ' ');
 }
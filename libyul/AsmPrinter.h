@@ -33,6 +33,9 @@
 #include <liblangutil/SourceLocation.h>
 
 #include <map>
+#include <string>
+#include <tuple>
+#include <vector>
 
 namespace solidity::yul
 {
@@ -42,6 +45,9 @@ struct Dialect;
  * Converts a parsed Yul AST into readable string representation.
  * Ignores source locations.
  * If a dialect is provided, the dialect's default type is omitted.
+ *
+ * The code of all nodes is written into a single buffer, where the indentation of nested blocks
+ * is emitted directly instead of being inserted into the code of each enclosing block.
  */
 class AsmPrinter
 {
@@ -91,19 +97,53 @@ public:
 	);
 
 private:
-	std::string formatTypedName(TypedName _variable);
-	std::string appendTypeName(YulString _type, bool _isBoolLiteral = false) const;
-	std::string formatDebugData(std::shared_ptr<DebugData const> const& _debugData, bool _statement);
 	template <class T>
-	std::string formatDebugData(T const& _node)
+	std::string printed(T const& _node)
+	{
+		m_out.clear();
+		m_indentation = 0;
+		print(_node);
+		return std::move(m_out);
+	}
+
+	void print(Literal const& _literal);
+	void print(Identifier const& _identifier);
+	void print(ExpressionStatement const& _statement);
+	void print(Assignment const& _assignment);
+	void print(VariableDeclaration const& _variableDeclaration);
+	void print(FunctionDefinition const& _functionDefinition);
+	void print(FunctionCall const& _functionCall);
+	void print(If const& _if);
+	void print(Switch const& _switch);
+	void print(ForLoop const& _forLoop);
+	void print(Break const& _break);
+	void print(Continue const& _continue);
+	void print(Leave const& _leave);
+	void print(Block const& _block);
+	void print(Expression const& _expression);
+	void print(Statement const& _statement);
+	void print(TypedName const& _variable);
+	void printTypedNames(std::vector<TypedName> const& _variables);
+	void printTypeName(YulString _type, bool _isBoolLiteral = false);
+	void printDebugData(std::shared_ptr<DebugData const> const& _debugData, bool _statement);
+	template <class T>
+	void printDebugData(T const& _node)
 	{
 		bool isExpression = std::is_constructible<Expression, T>::value;
-		return formatDebugData(_node.debugData, !isExpression);
+		printDebugData(_node.debugData, !isExpression);
 	}
+	/// Starts a new line at the indentation of the current block.
+	void newLine();
 
 	Dialect const* const m_dialect = nullptr;
 	std::map<std::string, unsigned> m_nameToSourceIndex;
 	langutil::SourceLocation m_lastLocation = {};
+	/// Formatted ``@src`` comments by the name of their source (compared by address) and their range.
+	std::map<std::tuple<std::string const*, int, int>, std::string> m_locationComments;
+	/// The code printed by the current call.
+	std::string m_out;
+	/// Number of blocks enclosing the node being printed.
+	size_t m_indentation = 0;
 	langutil::DebugInfoSelection m_debugInfoSelection = {};
 	langutil::CharStreamProvider const* m_soliditySourceProvider = nullptr;
 };
@@ -34,10 +34,15 @@
 #include <libyul/backends/wasm/WasmObjectCompiler.h>
 #include <libyul/backends/wasm/EVMToEwasmTranslator.h>
 #include <libyul/ObjectParser.h>
+#include <libyul/optimiser/ASTCopier.h>
+#include <libyul/optimiser/Metrics.h>
 #include <libyul/optimiser/Suite.h>
 
 #include <libevmasm/Assembly.h>
 #include <liblangutil/Scanner.h>
+#include <libsolutil/ThreadPool.h>
+
+#include <functional>
 #include <optional>
 
 using namespace std;
@@ -71,7 +76,7 @@ evmasm::Assembly::OptimiserSettings translateOptimiserSettings(
 )
 {
 	// Constructing it this way so that we notice changes in the fields.
-	evmasm::Assembly::OptimiserSettings asmSettings{false, false,  false, false, false, false, false, _evmVersion, 0};
+	evmasm::Assembly::OptimiserSettings asmSettings{false, false,  false, false, false, false, false, false, false, false, _evmVersion, 0, 1, {}};
 	asmSettings.isCreation = true;
 	asmSettings.runInliner = _settings.runInliner;
 	asmSettings.runJumpdestRemover = _settings.runJumpdestRemover;
@@ -79,7 +84,11 @@ evmasm::Assembly::OptimiserSettings translateOptimiserSettings(
 	asmSettings.runDeduplicate = _settings.runDeduplicate;
 	asmSettings.runCSE = _settings.runCSE;
 	asmSettings.runConstantOptimiser = _settings.runConstantOptimiser;
+	asmSettings.runSuperoptimiser = _settings.runSuperoptimiser;
+	asmSettings.runBlockLayout = _settings.runBlockLayout;
+	asmSettings.runFunctionInliner = _settings.runFunctionInliner;
 	asmSettings.expectedExecutionsPerDeployment = _settings.expectedExecutionsPerDeployment;
+	asmSettings.executionProfile = _settings.executionProfile;
 	asmSettings.evmVersion = _evmVersion;
 
 	return asmSettings;
@@ -119,8 +128,48 @@ void AssemblyStack::optimize()
 
 	m_analysisSuccessful = false;
 	yulAssert(m_parserResult, "");
-	optimize(*m_parserResult, true);
-	yulAssert(analyzeParsed(), "Invalid source code after optimization.");
+
+	// An object is optimised after its sub-objects. Objects of the same height in the object
+	// tree do not contain each other and are optimised independently of each other.
+	vector<vector<pair<Object*, bool>>> objectsByHeight;
+	function<size_t(Object&, bool)> collectObjects = [&](Object& _object, bool _isCreation) -> size_t
+	{
+		size_t height = 0;
+		for (auto& subNode: _object.subObjects)
+			if (auto subObject = dynamic_cast<Object*>(subNode.get()))
+				height = max(height, collectObjects(*subObject, false) + 1);
+		if (objectsByHeight.size() <= height)
+			objectsByHeight.resize(height + 1);
+		objectsByHeight[height].emplace_back(&_object, _isCreation);
+		return height;
+	};
+	collectObjects(*m_parserResult, true);
+
+	size_t maxWidth = 0;
+	for (auto const& objects: objectsByHeight)
+		maxWidth = max(maxWidth, objects.size());
+
+	// The threads that are not needed for independent objects are used inside the optimiser steps.
+	auto threadsPerObject = [&](vector<pair<Object*, bool>> const& _objects) {
+		return max<size_t>(1, m_parallelism / _objects.size());
+	};
+	if (m_parallelism == 1 || maxWidth == 1)
+		for (auto const& objects: objectsByHeight)
+			for (auto const& [object, isCreation]: objects)
+				optimize(*object, isCreation, threadsPerObject(objects));
+	else
+		for (auto const& objects: objectsByHeight)
+		{
+			size_t parallelism = threadsPerObject(objects);
+			// Rethrows the exception of the first failing object.
+			util::parallelFor(objects.size(), m_parallelism, [&](size_t _i) {
+				optimize(*objects[_i].first, objects[_i].second, parallelism);
+			});
+		}
+
+	// The optimiser suite leaves every object with up-to-date analysis information, which
+	// it already asserted to be free of errors, so the tree does not have to be analysed again.
+	m_analysisSuccessful = true;
 }
 
 void AssemblyStack::translate(AssemblyStack::Language _targetLanguage)
@@ -185,30 +234,101 @@ void AssemblyStack::compileEVM(AbstractAssembly& _assembly, bool _optimize) cons
 			break;
 	}
 
-	EVMObjectCompiler::compile(*m_parserResult, _assembly, *dialect, _optimize);
+	EVMObjectCompiler::compile(
+		*m_parserResult,
+		_assembly,
+		*dialect,
+		_optimize,
+		m_optimiserSettings.stackLayoutEffort,
+		m_parallelism
+	);
 }
 
-void AssemblyStack::optimize(Object& _object, bool _isCreation)
+void AssemblyStack::optimize(Object& _object, bool _isCreation, size_t _parallelism)
 {
 	yulAssert(_object.code, "");
 	yulAssert(_object.analysisInfo, "");
-	for (auto& subNode: _object.subObjects)
-		if (auto subObject = dynamic_cast<Object*>(subNode.get()))
-			optimize(*subObject, false);
 
 	Dialect const& dialect = languageToDialect(m_language, m_evmVersion);
 	unique_ptr<GasMeter> meter;
 	if (EVMDialect const* evmDialect = dynamic_cast<EVMDialect const*>(&dialect))
 		meter = make_unique<GasMeter>(*evmDialect, _isCreation, m_optimiserSettings.expectedExecutionsPerDeployment);
-	OptimiserSuite::run(
-		dialect,
-		meter.get(),
-		_object,
-		m_optimiserSettings.optimizeStackAllocation,
-		m_optimiserSettings.yulOptimiserSteps,
-		_isCreation ? nullopt : make_optional(m_optimiserSettings.expectedExecutionsPerDeployment),
-		{}
-	);
+	auto runSequence = [&](Object& _target, string_view _sequence, size_t _threads) {
+		OptimiserSuite::run(
+			dialect,
+			meter.get(),
+			_target,
+			m_optimiserSettings.optimizeStackAllocation,
+			_sequence,
+			_isCreation ? nullopt : make_optional(m_optimiserSettings.expectedExecutionsPerDeployment),
+			{},
+			m_optimisedCodeCache.get(),
+			_threads,
+			m_optimiserSettings.yulOptimiserStepBudget
+		);
+	};
+
+	vector<string_view> sequences{m_optimiserSettings.yulOptimiserSteps};
+	if (
+		m_optimiserSettings.selectYulOptimiserSteps &&
+		m_optimiserSettings.yulOptimiserSteps == frontend::OptimiserSettings::DefaultYulOptimiserSteps
+	)
+		switch (OptimiserSuite::classify(dialect, *_object.code))
+		{
+		case OptimiserSuite::CodeClass::General:
+			break;
+		case OptimiserSuite::CodeClass::StorageHeavy:
+			// Remove overwritten storage writes
+			sequences.front() = frontend::OptimiserSettings::AutotuneYulOptimiserSteps[0];
+			break;
+		case OptimiserSuite::CodeClass::ComputationHeavy:
+			// Move invariant loads out of inlined loops
+			sequences.front() = frontend::OptimiserSettings::AutotuneYulOptimiserSteps[1];
+			break;
+		}
+	for (char const* steps: frontend::OptimiserSettings::AutotuneYulOptimiserSteps)
+		if (sequences.size() < m_optimiserSettings.yulOptimiserAutotuneCandidates && steps != sequences.front())
+			sequences.emplace_back(steps);
+	if (sequences.size() == 1)
+	{
+		runSequence(_object, sequences.front(), _parallelism);
+		return;
+	}
+
+	// Every sequence optimises its own copy of the code.
+	vector<Object> candidates(sequences.size(), _object);
+	for (Object& candidate: candidates)
+	{
+		candidate.code = make_shared<Block>(ASTCopier{}.translate(*_object.code));
+		candidate.analysisInfo = make_shared<AsmAnalysisInfo>(AsmAnalyzer::analyzeStrictAssertCorrect(dialect, candidate));
+	}
+	size_t threadsPerCandidate = max<size_t>(1, _parallelism / sequences.size());
+	if (_parallelism == 1)
+		for (size_t i = 0; i < sequences.size(); ++i)
+			runSequence(candidates[i], sequences[i], threadsPerCandidate);
+	else
+		util::parallelFor(sequences.size(), _parallelism, [&](size_t _i) {
+			runSequence(candidates[_i], sequences[_i], threadsPerCandidate);
+		});
+
+	auto costs = [&](Object const& _candidate) -> bigint {
+		if (meter)
+			return meter->codeCosts(*_candidate.code);
+		else
+			return CodeSize::codeSizeIncludingFunctions(*_candidate.code);
+	};
+	// Ties are resolved in favour of the earlier sequence to keep the result deterministic.
+	size_t best = 0;
+	bigint bestCosts = costs(candidates.front());
+	for (size_t i = 1; i < candidates.size(); ++i)
+		if (bigint candidateCosts = costs(candidates[i]); candidateCosts < bestCosts)
+		{
+			best = i;
+			bestCosts = candidateCosts;
+		}
+	// The analysis information of the candidate refers to its AST nodes, so both are taken over.
+	_object.code = move(candidates[best].code);
+	_object.analysisInfo = move(candidates[best].analysisInfo);
 }
 
 MachineAssemblyObject AssemblyStack::assemble(Machine _machine) const
@@ -285,7 +405,9 @@ AssemblyStack::assembleEVMWithDeployed(optional<string_view> _deployName) const
 	EthAssemblyAdapter adapter(assembly);
 	compileEVM(adapter, m_optimiserSettings.optimizeStackAllocation);
 
-	assembly.optimise(translateOptimiserSettings(m_optimiserSettings, m_evmVersion));
+	evmasm::Assembly::OptimiserSettings asmSettings = translateOptimiserSettings(m_optimiserSettings, m_evmVersion);
+	asmSettings.parallelism = m_parallelism;
+	assembly.optimise(asmSettings);
 
 	optional<size_t> subIndex;
 
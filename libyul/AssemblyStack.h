@@ -29,6 +29,7 @@
 
 #include <libyul/Object.h>
 #include <libyul/ObjectParser.h>
+#include <libyul/YulString.h>
 
 #include <libsolidity/interface/OptimiserSettings.h>
 
@@ -50,6 +51,7 @@ class Scanner;
 namespace solidity::yul
 {
 class AbstractAssembly;
+class OptimisedCodeCache;
 
 
 struct MachineAssemblyObject
@@ -102,6 +104,15 @@ public:
 	/// If the settings (see constructor) disabled the optimizer, nothing is done here.
 	void optimize();
 
+	/// Makes optimize() reuse and record the optimised code of objects in @a _cache,
+	/// which can be shared with other stacks using the same settings.
+	void setOptimisedCodeCache(std::shared_ptr<OptimisedCodeCache> _cache) { m_optimisedCodeCache = std::move(_cache); }
+
+	/// Sets the maximum number of threads used by optimize() to optimise independent sub-objects,
+	/// e.g. the runtime object and the objects of contracts created via ``new``, and the functions
+	/// within some of the optimiser steps. The result does not depend on this setting.
+	void setParallelism(size_t _parallelism) { m_parallelism = std::max<size_t>(_parallelism, 1); }
+
 	/// Translate the source to a different language / dialect.
 	void translate(Language _targetLanguage);
 
@@ -142,12 +153,18 @@ private:
 
 	void compileEVM(yul::AbstractAssembly& _assembly, bool _optimize) const;
 
-	void optimize(yul::Object& _object, bool _isCreation);
+	/// Optimizes the code of @a _object, but not of its sub-objects.
+	void optimize(yul::Object& _object, bool _isCreation, size_t _parallelism);
+
+	/// Keeps the YulStrings of the parsed objects valid. Destroyed last.
+	yul::YulStringRepository::Session m_yulStringSession;
 
 	Language m_language = Language::Assembly;
 	langutil::EVMVersion m_evmVersion;
 	solidity::frontend::OptimiserSettings m_optimiserSettings;
 	langutil::DebugInfoSelection m_debugInfoSelection{};
+	std::shared_ptr<OptimisedCodeCache> m_optimisedCodeCache;
+	size_t m_parallelism = 1;
 
 	std::unique_ptr<langutil::CharStream> m_charStream;
 
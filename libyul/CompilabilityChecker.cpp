@@ -22,6 +22,8 @@
 
 #include <libyul/AsmAnalysis.h>
 #include <libyul/AsmAnalysisInfo.h>
+#include <libyul/AST.h>
+#include <libyul/optimiser/ASTCopier.h>
 
 #include <libyul/backends/evm/EVMCodeTransform.h>
 #include <libyul/backends/evm/NoOutputAssembly.h>
@@ -69,3 +71,35 @@ CompilabilityChecker::CompilabilityChecker(
 		}
 	}
 }
+
+CompilabilityChecker::CompilabilityChecker(
+	Dialect const& _dialect,
+	Object const& _object,
+	bool _optimizeStackAllocation,
+	set<YulString> const& _functionsToCheck
+)
+{
+	yulAssert(_object.code, "");
+	Object reducedObject = _object;
+	auto reducedCode = make_shared<Block>();
+	reducedCode->debugData = _object.code->debugData;
+	bool checkMainCode = _functionsToCheck.count({});
+	for (Statement const& statement: _object.code->statements)
+		if (auto const* function = get_if<FunctionDefinition>(&statement))
+		{
+			if (_functionsToCheck.count(function->name))
+				reducedCode->statements.emplace_back(ASTCopier{}.translate(statement));
+			else
+				reducedCode->statements.emplace_back(FunctionDefinition{
+					function->debugData,
+					function->name,
+					function->parameters,
+					function->returnVariables,
+					Block{function->body.debugData, {}}
+				});
+		}
+		else if (checkMainCode)
+			reducedCode->statements.emplace_back(ASTCopier{}.translate(statement));
+	reducedObject.code = move(reducedCode);
+	*this = CompilabilityChecker{_dialect, reducedObject, _optimizeStackAllocation};
+}
@@ -27,6 +27,7 @@
 
 #include <map>
 #include <memory>
+#include <set>
 
 namespace solidity::yul
 {
@@ -45,6 +46,16 @@ namespace solidity::yul
 struct CompilabilityChecker
 {
 	CompilabilityChecker(Dialect const& _dialect, Object const& _object, bool _optimizeStackAllocation);
+	/// Only checks the top-level functions named in @a _functionsToCheck and, if it contains the empty name,
+	/// the code outside of top-level functions. The other functions are replaced by functions with empty bodies,
+	/// which does not change the result for the checked functions, since the code of each function is
+	/// generated independently.
+	CompilabilityChecker(
+		Dialect const& _dialect,
+		Object const& _object,
+		bool _optimizeStackAllocation,
+		std::set<YulString> const& _functionsToCheck
+	);
 	std::map<YulString, std::set<YulString>> unreachableVariables;
 	std::map<YulString, int> stackDeficit;
 };
@@ -22,6 +22,8 @@
 #include <libyul/Dialect.h>
 #include <libyul/AST.h>
 
+#include <mutex>
+
 using namespace solidity::yul;
 using namespace std;
 using namespace solidity::langutil;
@@ -52,8 +54,13 @@ bool Dialect::validTypeForLiteral(LiteralKind _kind, YulString, YulString _type)
 
 Dialect const& Dialect::yulDeprecated()
 {
+	static mutex dialectMutex;
+	lock_guard<mutex> lock(dialectMutex);
 	static unique_ptr<Dialect> dialect;
-	static YulStringRepository::ResetCallback callback{[&] { dialect.reset(); }};
+	static YulStringRepository::ResetCallback callback{[&] {
+		lock_guard<mutex> resetLock(dialectMutex);
+		dialect.reset();
+	}};
 
 	if (!dialect)
 	{
@@ -25,6 +25,7 @@
 #include <libyul/Exceptions.h>
 
 #include <libsolutil/CommonData.h>
+#include <libsolutil/Keccak256.h>
 #include <libsolutil/StringUtils.h>
 
 #include <boost/algorithm/string.hpp>
@@ -51,9 +52,16 @@ string indent(std::string const& _input)
 
 }
 
+Data::Data(YulString _name, shared_ptr<bytes const> _data):
+	data(move(_data)),
+	hash(keccak256(*data))
+{
+	name = _name;
+}
+
 string Data::toString(Dialect const*, DebugInfoSelection const&, CharStreamProvider const*) const
 {
-	return "data \"" + name.str() + "\" hex\"" + util::toHex(data) + "\"";
+	return "data \"" + name.str() + "\" hex\"" + util::toHex(*data) + "\"";
 }
 
 string Object::toString(
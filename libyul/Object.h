@@ -28,6 +28,7 @@
 #include <liblangutil/DebugInfoSelection.h>
 
 #include <libsolutil/Common.h>
+#include <libsolutil/FixedHash.h>
 
 #include <memory>
 #include <set>
@@ -62,12 +63,23 @@ struct ObjectNode
 
 /**
  * Named data in Yul objects.
+ * The contents are immutable, so that equal data can be shared between all objects and assemblies
+ * containing it, and their hash is only computed once.
  */
 struct Data: public ObjectNode
 {
-	Data(YulString _name, bytes _data): data(std::move(_data)) { name = _name; }
-
-	bytes data;
+	Data(YulString _name, bytes _data): Data(_name, std::make_shared<bytes const>(std::move(_data))) {}
+	Data(YulString _name, std::shared_ptr<bytes const> _data);
+	/// Creates the data object without computing the hash of @a _data, which has to be @a _hash.
+	Data(YulString _name, std::shared_ptr<bytes const> _data, util::h256 const& _hash):
+		data(std::move(_data)), hash(_hash)
+	{
+		name = _name;
+	}
+
+	std::shared_ptr<bytes const> data;
+	/// Keccak-256 hash of @a data.
+	util::h256 hash;
 
 	std::string toString(
 		Dialect const* _dialect,
@@ -28,6 +28,7 @@
 #include <liblangutil/Token.h>
 #include <liblangutil/Scanner.h>
 
+#include <libsolutil/Keccak256.h>
 #include <libsolutil/StringUtils.h>
 
 #include <regex>
@@ -192,7 +193,13 @@ void ObjectParser::parseData(Object& _containingObject)
 		expectToken(Token::HexStringLiteral, false);
 	else
 		expectToken(Token::StringLiteral, false);
-	addNamedSubObject(_containingObject, name, make_shared<Data>(name, asBytes(currentLiteral())));
+	bytes data = asBytes(currentLiteral());
+	util::h256 hash = util::keccak256(data);
+	// Equal data, e.g. the same bytecode embedded at several levels of the object tree, is only stored once.
+	shared_ptr<bytes const>& sharedData = m_dataByHash[hash];
+	if (!sharedData)
+		sharedData = make_shared<bytes const>(move(data));
+	addNamedSubObject(_containingObject, name, make_shared<Data>(name, sharedData, hash));
 	advance();
 }
 
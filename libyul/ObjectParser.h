@@ -30,6 +30,7 @@
 
 #include <libsolutil/Common.h>
 
+#include <map>
 #include <memory>
 
 namespace solidity::langutil
@@ -67,6 +68,8 @@ private:
 	void addNamedSubObject(Object& _container, YulString _name, std::shared_ptr<ObjectNode> _subObject);
 
 	Dialect const& m_dialect;
+	/// Contents of the data objects parsed so far by their hash.
+	std::map<util::h256, std::shared_ptr<bytes const>> m_dataByHash;
 };
 
 }
@@ -0,0 +1,627 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Compact binary encoding of Yul objects.
+ */
+
+#include <libyul/ObjectSerializer.h>
+
+#include <libyul/AST.h>
+#include <libyul/Exceptions.h>
+#include <libyul/Object.h>
+
+#include <limits>
+#include <unordered_map>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::langutil;
+using namespace solidity::util;
+using namespace solidity::yul;
+
+namespace
+{
+
+/// Prefix of every encoding. The last byte is the version of the format.
+bytes const c_magic{'y', 'u', 'l', 'b', 1};
+
+/// Maximum nesting depth of blocks and expressions accepted when decoding.
+size_t constexpr c_maxDepth = 4096;
+
+uint64_t zigzag(int64_t _value)
+{
+	return (static_cast<uint64_t>(_value) << 1) ^ static_cast<uint64_t>(_value >> 63);
+}
+
+int64_t unzigzag(uint64_t _value)
+{
+	return static_cast<int64_t>(_value >> 1) ^ -static_cast<int64_t>(_value & 1);
+}
+
+/**
+ * Writes the nodes of an object tree in pre-order.
+ *
+ * Identifiers, source names and debug data are written as references: zero stands for an empty
+ * value, a reference to the entry after the last one that was written so far defines a new entry,
+ * whose contents follow, and every other reference refers to an entry that was defined earlier.
+ */
+class Encoder
+{
+public:
+	bytes run(Object const& _object)
+	{
+		m_out = c_magic;
+		writeObject(_object);
+		return move(m_out);
+	}
+
+	void operator()(Literal const& _literal)
+	{
+		writeDebugData(_literal.debugData);
+		writeNumber(static_cast<uint64_t>(_literal.kind));
+		writeName(_literal.value);
+		writeName(_literal.type);
+	}
+	void operator()(Identifier const& _identifier)
+	{
+		writeDebugData(_identifier.debugData);
+		writeName(_identifier.name);
+	}
+	void operator()(FunctionCall const& _call)
+	{
+		writeDebugData(_call.debugData);
+		(*this)(_call.functionName);
+		writeNumber(_call.arguments.size());
+		for (Expression const& argument: _call.arguments)
+			writeExpression(argument);
+	}
+	void operator()(ExpressionStatement const& _statement)
+	{
+		writeDebugData(_statement.debugData);
+		writeExpression(_statement.expression);
+	}
+	void operator()(Assignment const& _assignment)
+	{
+		yulAssert(_assignment.value, "");
+		writeDebugData(_assignment.debugData);
+		writeNumber(_assignment.variableNames.size());
+		for (Identifier const& variable: _assignment.variableNames)
+			(*this)(variable);
+		writeExpression(*_assignment.value);
+	}
+	void operator()(VariableDeclaration const& _declaration)
+	{
+		writeDebugData(_declaration.debugData);
+		writeTypedNames(_declaration.variables);
+		writeOptionalExpression(_declaration.value.get());
+	}
+	void operator()(FunctionDefinition const& _function)
+	{
+		writeDebugData(_function.debugData);
+		writeName(_function.name);
+		writeTypedNames(_function.parameters);
+		writeTypedNames(_function.returnVariables);
+		(*this)(_function.body);
+	}
+	void operator()(If const& _if)
+	{
+		yulAssert(_if.condition, "");
+		writeDebugData(_if.debugData);
+		writeExpression(*_if.condition);
+		(*this)(_if.body);
+	}
+	void operator()(Switch const& _switch)
+	{
+		yulAssert(_switch.expression, "");
+		writeDebugData(_switch.debugData);
+		writeExpression(*_switch.expression);
+		writeNumber(_switch.cases.size());
+		for (Case const& switchCase: _switch.cases)
+		{
+			writeDebugData(switchCase.debugData);
+			writeNumber(switchCase.value ? 1 : 0);
+			if (switchCase.value)
+				(*this)(*switchCase.value);
+			(*this)(switchCase.body);
+		}
+	}
+	void operator()(ForLoop const& _loop)
+	{
+		yulAssert(_loop.condition, "");
+		writeDebugData(_loop.debugData);
+		(*this)(_loop.pre);
+		writeExpression(*_loop.condition);
+		(*this)(_loop.post);
+		(*this)(_loop.body);
+	}
+	void operator()(Break const& _break) { writeDebugData(_break.debugData); }
+	void operator()(Continue const& _continue) { writeDebugData(_continue.debugData); }
+	void operator()(Leave const& _leave) { writeDebugData(_leave.debugData); }
+	void operator()(Block const& _block)
+	{
+		writeDebugData(_block.debugData);
+		writeNumber(_block.statements.size());
+		for (Statement const& statement: _block.statements)
+		{
+			writeNumber(statement.index());
+			std::visit(*this, statement);
+		}
+	}
+
+private:
+	void writeObject(Object const& _object)
+	{
+		yulAssert(_object.code, "");
+		writeName(_object.name);
+		if (_object.debugData && _object.debugData->sourceNames)
+		{
+			writeNumber(_object.debugData->sourceNames->size() + 1);
+			for (auto const& [index, sourceName]: *_object.debugData->sourceNames)
+			{
+				writeNumber(index);
+				writeSourceName(sourceName);
+			}
+		}
+		else
+			writeNumber(0);
+		(*this)(*_object.code);
+
+		writeNumber(_object.subObjects.size());
+		for (shared_ptr<ObjectNode> const& subNode: _object.subObjects)
+			if (auto const* subObject = dynamic_cast<Object const*>(subNode.get()))
+			{
+				writeNumber(0);
+				writeObject(*subObject);
+			}
+			else
+			{
+				auto const* data = dynamic_cast<Data const*>(subNode.get());
+				yulAssert(data, "");
+				writeNumber(1);
+				writeName(data->name);
+				writeBytes(*data->data);
+			}
+	}
+
+	void writeExpression(Expression const& _expression)
+	{
+		writeNumber(_expression.index());
+		std::visit(*this, _expression);
+	}
+
+	void writeOptionalExpression(Expression const* _expression)
+	{
+		writeNumber(_expression ? 1 : 0);
+		if (_expression)
+			writeExpression(*_expression);
+	}
+
+	void writeTypedNames(TypedNameList const& _names)
+	{
+		writeNumber(_names.size());
+		for (TypedName const& name: _names)
+		{
+			writeDebugData(name.debugData);
+			writeName(name.name);
+			writeName(name.type);
+		}
+	}
+
+	void writeDebugData(shared_ptr<DebugData const> const& _debugData)
+	{
+		if (!_debugData)
+		{
+			writeNumber(0);
+			return;
+		}
+		auto&& [it, inserted] = m_debugData.try_emplace(_debugData.get(), m_debugData.size() + 1);
+		writeNumber(it->second);
+		if (!inserted)
+			return;
+		writeLocation(_debugData->nativeLocation);
+		writeLocation(_debugData->originLocation);
+		if (_debugData->astID)
+			writeNumber(zigzag(*_debugData->astID) + 1);
+		else
+			writeNumber(0);
+	}
+
+	void writeLocation(SourceLocation const& _location)
+	{
+		writeSourceName(_location.sourceName);
+		writeNumber(zigzag(_location.start));
+		writeNumber(zigzag(_location.end));
+	}
+
+	void writeName(YulString _name)
+	{
+		if (_name.empty())
+		{
+			writeNumber(0);
+			return;
+		}
+		auto&& [it, inserted] = m_names.try_emplace(_name, m_names.size() + 1);
+		writeNumber(it->second);
+		if (inserted)
+			writeBytes(asBytes(_name.str()));
+	}
+
+	void writeSourceName(SourceName _sourceName)
+	{
+		if (!_sourceName)
+		{
+			writeNumber(0);
+			return;
+		}
+		auto&& [it, inserted] = m_sourceNames.try_emplace(_sourceName.get(), m_sourceNames.size() + 1);
+		writeNumber(it->second);
+		if (inserted)
+			writeBytes(asBytes(*_sourceName));
+	}
+
+	void writeBytes(bytes const& _data)
+	{
+		writeNumber(_data.size());
+		m_out += _data;
+	}
+
+	/// Writes @a _value as an unsigned LEB128 number.
+	void writeNumber(uint64_t _value)
+	{
+		for (; _value >= 0x80; _value >>= 7)
+			m_out.push_back(static_cast<uint8_t>(_value | 0x80));
+		m_out.push_back(static_cast<uint8_t>(_value));
+	}
+
+	bytes m_out;
+	unordered_map<YulString, size_t> m_names;
+	unordered_map<string const*, size_t> m_sourceNames;
+	unordered_map<DebugData const*, size_t> m_debugData;
+};
+
+struct InvalidEncoding: virtual YulException {};
+
+#define decodingAssert(CONDITION) \
+	assertThrow(CONDITION, InvalidEncoding, "Invalid encoding of a Yul object.")
+
+class Decoder
+{
+public:
+	explicit Decoder(bytesConstRef _data): m_data(_data) {}
+
+	shared_ptr<Object> run()
+	{
+		decodingAssert(m_data.size() >= c_magic.size());
+		decodingAssert(equal(c_magic.begin(), c_magic.end(), m_data.begin()));
+		m_position = c_magic.size();
+		shared_ptr<Object> object = readObject();
+		decodingAssert(m_position == m_data.size());
+		return object;
+	}
+
+private:
+	shared_ptr<Object> readObject()
+	{
+		auto object = make_shared<Object>();
+		object->name = readName();
+		auto debugData = make_shared<ObjectDebugData>();
+		if (uint64_t sourceNameCount = readNumber())
+		{
+			debugData->sourceNames.emplace();
+			for (uint64_t i = 1; i < sourceNameCount; ++i)
+			{
+				uint64_t index = readNumber();
+				decodingAssert(index <= numeric_limits<unsigned>::max());
+				SourceName sourceName = readSourceName();
+				decodingAssert(sourceName);
+				decodingAssert(debugData->sourceNames->emplace(
+					static_cast<unsigned>(index),
+					make_shared<string const>(*sourceName)
+				).second);
+			}
+		}
+		object->debugData = move(debugData);
+		object->code = make_shared<Block>(readBlock());
+
+		uint64_t subObjectCount = readNumber();
+		for (uint64_t i = 0; i < subObjectCount; ++i)
+		{
+			shared_ptr<ObjectNode> subNode;
+			switch (readNumber())
+			{
+			case 0:
+			{
+				ScopedDepth depth{*this};
+				subNode = readObject();
+				break;
+			}
+			case 1:
+			{
+				YulString name = readName();
+				subNode = make_shared<Data>(name, readBytes());
+				break;
+			}
+			default:
+				decodingAssert(false);
+			}
+			decodingAssert(object->subIndexByName.emplace(subNode->name, object->subObjects.size()).second);
+			object->subObjects.emplace_back(move(subNode));
+		}
+		return object;
+	}
+
+	Expression readExpression()
+	{
+		ScopedDepth depth{*this};
+		switch (readNumber())
+		{
+		case 0:
+		{
+			FunctionCall call{readDebugData(), readIdentifier(), {}};
+			uint64_t argumentCount = readNumber();
+			for (uint64_t i = 0; i < argumentCount; ++i)
+				call.arguments.emplace_back(readExpression());
+			return call;
+		}
+		case 1:
+			return readIdentifier();
+		case 2:
+			return readLiteral();
+		default:
+			decodingAssert(false);
+		}
+		return {};
+	}
+
+	unique_ptr<Expression> readOptionalExpression()
+	{
+		if (readNumber() == 0)
+			return nullptr;
+		return make_unique<Expression>(readExpression());
+	}
+
+	Statement readStatement()
+	{
+		switch (readNumber())
+		{
+		case 0:
+		{
+			auto debugData = readDebugData();
+			return ExpressionStatement{move(debugData), readExpression()};
+		}
+		case 1:
+		{
+			Assignment assignment{readDebugData(), {}, {}};
+			uint64_t variableCount = readNumber();
+			for (uint64_t i = 0; i < variableCount; ++i)
+				assignment.variableNames.emplace_back(readIdentifier());
+			assignment.value = make_unique<Expression>(readExpression());
+			return assignment;
+		}
+		case 2:
+		{
+			VariableDeclaration declaration{readDebugData(), readTypedNames(), {}};
+			declaration.value = readOptionalExpression();
+			return declaration;
+		}
+		case 3:
+		{
+			FunctionDefinition function{readDebugData(), readName(), {}, {}, {}};
+			function.parameters = readTypedNames();
+			function.returnVariables = readTypedNames();
+			function.body = readBlock();
+			return function;
+		}
+		case 4:
+		{
+			If ifStatement{readDebugData(), make_unique<Expression>(readExpression()), {}};
+			ifStatement.body = readBlock();
+			return ifStatement;
+		}
+		case 5:
+		{
+			Switch switchStatement{readDebugData(), make_unique<Expression>(readExpression()), {}};
+			uint64_t caseCount = readNumber();
+			for (uint64_t i = 0; i < caseCount; ++i)
+			{
+				Case switchCase{readDebugData(), {}, {}};
+				if (readNumber() != 0)
+					switchCase.value = make_unique<Literal>(readLiteral());
+				switchCase.body = readBlock();
+				switchStatement.cases.emplace_back(move(switchCase));
+			}
+			return switchStatement;
+		}
+		case 6:
+		{
+			ForLoop loop{readDebugData(), readBlock(), {}, {}, {}};
+			loop.condition = make_unique<Expression>(readExpression());
+			loop.post = readBlock();
+			loop.body = readBlock();
+			return loop;
+		}
+		case 7:
+			return Break{readDebugData()};
+		case 8:
+			return Continue{readDebugData()};
+		case 9:
+			return Leave{readDebugData()};
+		case 10:
+			return readBlock();
+		default:
+			decodingAssert(false);
+		}
+		return {};
+	}
+
+	Block readBlock()
+	{
+		ScopedDepth depth{*this};
+		Block block{readDebugData(), {}};
+		uint64_t statementCount = readNumber();
+		for (uint64_t i = 0; i < statementCount; ++i)
+			block.statements.emplace_back(readStatement());
+		return block;
+	}
+
+	Literal readLiteral()
+	{
+		Literal literal{readDebugData(), {}, {}, {}};
+		uint64_t kind = readNumber();
+		decodingAssert(kind <= static_cast<uint64_t>(LiteralKind::String));
+		literal.kind = static_cast<LiteralKind>(kind);
+		literal.value = readName();
+		literal.type = readName();
+		return literal;
+	}
+
+	Identifier readIdentifier()
+	{
+		auto debugData = readDebugData();
+		return Identifier{move(debugData), readName()};
+	}
+
+	TypedNameList readTypedNames()
+	{
+		TypedNameList names;
+		uint64_t count = readNumber();
+		for (uint64_t i = 0; i < count; ++i)
+		{
+			TypedName name{readDebugData(), {}, {}};
+			name.name = readName();
+			name.type = readName();
+			names.emplace_back(move(name));
+		}
+		return names;
+	}
+
+	shared_ptr<DebugData const> readDebugData()
+	{
+		uint64_t reference = readNumber();
+		if (reference == 0)
+			return nullptr;
+		if (reference <= m_debugData.size())
+			return m_debugData[reference - 1];
+		decodingAssert(reference == m_debugData.size() + 1);
+		SourceLocation nativeLocation = readLocation();
+		SourceLocation originLocation = readLocation();
+		optional<int64_t> astID;
+		if (uint64_t encodedID = readNumber())
+			astID = unzigzag(encodedID - 1);
+		m_debugData.emplace_back(DebugData::create(move(nativeLocation), move(originLocation), astID));
+		return m_debugData.back();
+	}
+
+	SourceLocation readLocation()
+	{
+		SourceLocation location;
+		location.sourceName = readSourceName();
+		int64_t start = unzigzag(readNumber());
+		int64_t end = unzigzag(readNumber());
+		decodingAssert(numeric_limits<int>::min() <= start && start <= numeric_limits<int>::max());
+		decodingAssert(numeric_limits<int>::min() <= end && end <= numeric_limits<int>::max());
+		location.start = static_cast<int>(start);
+		location.end = static_cast<int>(end);
+		return location;
+	}
+
+	YulString readName()
+	{
+		uint64_t reference = readNumber();
+		if (reference == 0)
+			return {};
+		if (reference <= m_names.size())
+			return m_names[reference - 1];
+		decodingAssert(reference == m_names.size() + 1);
+		bytes name = readBytes();
+		m_names.emplace_back(string(name.begin(), name.end()));
+		return m_names.back();
+	}
+
+	SourceName readSourceName()
+	{
+		uint64_t reference = readNumber();
+		if (reference == 0)
+			return nullptr;
+		if (reference <= m_sourceNames.size())
+			return m_sourceNames[reference - 1];
+		decodingAssert(reference == m_sourceNames.size() + 1);
+		bytes name = readBytes();
+		m_sourceNames.emplace_back(string(name.begin(), name.end()));
+		return m_sourceNames.back();
+	}
+
+	bytes readBytes()
+	{
+		uint64_t length = readNumber();
+		decodingAssert(length <= m_data.size() - m_position);
+		auto begin = m_data.begin() + static_cast<ptrdiff_t>(m_position);
+		m_position += static_cast<size_t>(length);
+		return bytes(begin, begin + static_cast<ptrdiff_t>(length));
+	}
+
+	uint64_t readNumber()
+	{
+		uint64_t value = 0;
+		for (unsigned shift = 0; ; shift += 7)
+		{
+			decodingAssert(m_position < m_data.size() && shift < 64);
+			uint8_t byte = m_data[m_position++];
+			value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+			if (!(byte & 0x80))
+				return value;
+		}
+	}
+
+	/// Limits the recursion depth while it is in scope.
+	struct ScopedDepth
+	{
+		explicit ScopedDepth(Decoder& _decoder): decoder(_decoder)
+		{
+			decodingAssert(++decoder.m_depth <= c_maxDepth);
+		}
+		~ScopedDepth() { --decoder.m_depth; }
+		Decoder& decoder;
+	};
+
+	bytesConstRef m_data;
+	size_t m_position = 0;
+	size_t m_depth = 0;
+	vector<YulString> m_names;
+	vector<SourceName> m_sourceNames;
+	vector<shared_ptr<DebugData const>> m_debugData;
+};
+
+}
+
+bytes ObjectSerializer::serialize(Object const& _object)
+{
+	return Encoder{}.run(_object);
+}
+
+shared_ptr<Object> ObjectSerializer::deserialize(bytesConstRef _data)
+{
+	try
+	{
+		return Decoder{_data}.run();
+	}
+	catch (InvalidEncoding const&)
+	{
+		return nullptr;
+	}
+}
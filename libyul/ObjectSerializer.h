@@ -0,0 +1,53 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Compact binary encoding of Yul objects.
+ */
+
+#pragma once
+
+#include <libsolutil/Common.h>
+#include <libsolutil/CommonData.h>
+
+#include <memory>
+
+namespace solidity::yul
+{
+struct Object;
+
+/**
+ * Converts Yul objects including their sub-objects, data and debug data to and from a compact
+ * binary encoding, which is much faster to produce and to load than the textual representation
+ * because it does not have to be printed or parsed.
+ *
+ * Identifiers, source names and debug data are encoded once and referred to by their index
+ * afterwards, so debug data shared between nodes is also shared after decoding.
+ *
+ * The analysis information and the sub-object IDs are not part of the encoding: the former refers
+ * to the addresses of the AST nodes, the latter is only assigned during code generation.
+ */
+class ObjectSerializer
+{
+public:
+	static bytes serialize(Object const& _object);
+	/// @returns the object encoded in @a _data or nullptr if @a _data is not a valid encoding,
+	/// e.g. because it was produced by a different version of the compiler.
+	static std::shared_ptr<Object> deserialize(bytesConstRef _data);
+};
+
+}
@@ -0,0 +1,146 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * String abstraction that avoids copies.
+ */
+
+#include <libyul/YulString.h>
+
+#include <libyul/Exceptions.h>
+
+using namespace std;
+using namespace solidity::yul;
+
+YulStringRepository::Session::Session()
+{
+	YulStringRepository& repository = instance();
+	lock_guard<mutex> lock(repository.m_sessionMutex);
+	++repository.m_sessionCount;
+}
+
+YulStringRepository::Session::~Session()
+{
+	YulStringRepository& repository = instance();
+	lock_guard<mutex> lock(repository.m_sessionMutex);
+	--repository.m_sessionCount;
+	if (repository.m_sessionCount == 0 && repository.m_resetPending)
+		repository.performReset();
+}
+
+YulStringRepository::YulStringRepository()
+{
+	clear();
+}
+
+YulStringRepository::Handle YulStringRepository::stringToHandle(string const& _string)
+{
+	if (_string.empty())
+		return { 0, emptyHash() };
+	uint64_t h = hash(_string);
+	size_t const shard = shardIndex(h);
+	{
+		shared_lock<shared_mutex> lock(m_shards[shard].mutex);
+		if (optional<size_t> id = findID(_string, h))
+			return Handle{*id, h};
+	}
+	unique_lock<shared_mutex> lock(m_shards[shard].mutex);
+	// Another thread might have inserted the string in the meantime.
+	if (optional<size_t> id = findID(_string, h))
+		return Handle{*id, h};
+	size_t index = m_shards[shard].strings.append(_string);
+	m_shards[shard].hashToIndex.emplace(h, index);
+	return Handle{index * shardCount + shard, h};
+}
+
+optional<YulStringRepository::Handle> YulStringRepository::findHandle(string const& _string) const
+{
+	if (_string.empty())
+		return Handle{0, emptyHash()};
+	uint64_t h = hash(_string);
+	shared_lock<shared_mutex> lock(m_shards[shardIndex(h)].mutex);
+	if (optional<size_t> id = findID(_string, h))
+		return Handle{*id, h};
+	return nullopt;
+}
+
+void YulStringRepository::reset()
+{
+	YulStringRepository& repository = instance();
+	lock_guard<mutex> lock(repository.m_sessionMutex);
+	if (repository.m_sessionCount > 0)
+	{
+		repository.m_resetPending = true;
+		return;
+	}
+	repository.performReset();
+}
+
+void YulStringRepository::performReset()
+{
+	vector<function<void()>> callbacks;
+	{
+		// The callbacks lock further mutexes that are held while registering callbacks,
+		// so they cannot be invoked while holding the mutex of the callback list.
+		lock_guard<mutex> lock(resetCallbacksMutex());
+		callbacks = resetCallbacks();
+	}
+	for (auto const& cb: callbacks)
+		cb();
+	clear();
+	m_resetPending = false;
+}
+
+optional<size_t> YulStringRepository::findID(string const& _string, uint64_t _hash) const
+{
+	size_t const shard = shardIndex(_hash);
+	auto range = m_shards[shard].hashToIndex.equal_range(_hash);
+	for (auto it = range.first; it != range.second; ++it)
+		if (m_shards[shard].strings.at(it->second) == _string)
+			return it->second * shardCount + shard;
+	return nullopt;
+}
+
+void YulStringRepository::clear()
+{
+	for (Shard& shard: m_shards)
+	{
+		shard.hashToIndex.clear();
+		shard.strings.clear();
+	}
+	// The empty string has ID zero, which is index zero of the first shard.
+	m_shards[0].strings.append({});
+}
+
+size_t YulStringRepository::StringStorage::append(string const& _string)
+{
+	size_t const index = m_size;
+	size_t const chunk = highestBit(index / firstChunkSize + 1);
+	yulAssert(chunk < m_chunks.size(), "YulString repository is full.");
+	if (!m_chunks[chunk])
+		m_chunks[chunk] = make_unique<string[]>(firstChunkSize << chunk);
+	m_chunks[chunk][index - firstChunkSize * ((size_t(1) << chunk) - 1)] = _string;
+	++m_size;
+	return index;
+}
+
+void YulStringRepository::StringStorage::clear()
+{
+	for (auto& chunk: m_chunks)
+		chunk.reset();
+	m_size = 0;
+}
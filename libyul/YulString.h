@@ -23,8 +23,13 @@
 
 #include <fmt/format.h>
 
+#include <array>
+#include <cstdint>
 #include <unordered_map>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
 #include <vector>
 #include <string>
 #include <functional>
@@ -36,6 +41,10 @@ namespace solidity::yul
 /// Owns the string data for all YulStrings, which can be referenced by a Handle.
 /// A Handle consists of an ID (that depends on the insertion order of YulStrings and is potentially
 /// non-deterministic) and a deterministic string hash.
+///
+/// The repository is split into shards selected by the string hash, each with its own lock,
+/// so that concurrent compilations and optimiser runs do not contend on insertion.
+/// Looking up the string of an ID does not require locking at all.
 class YulStringRepository
 {
 public:
@@ -45,28 +54,33 @@ public:
 		std::uint64_t hash;
 	};
 
+	/// Marks the lifetime of a user of the repository, e.g. a compilation.
+	/// A reset that is requested while sessions are alive is postponed until the last
+	/// of them has ended, so that long-running processes can reclaim strings without
+	/// invalidating the YulStrings of compilations that are still in progress.
+	/// Copies of a session count as separate users.
+	class Session
+	{
+	public:
+		Session();
+		Session(Session const&): Session() {}
+		Session& operator=(Session const&) { return *this; }
+		~Session();
+	};
+
 	static YulStringRepository& instance()
 	{
 		static YulStringRepository inst;
 		return inst;
 	}
 
-	Handle stringToHandle(std::string const& _string)
+	Handle stringToHandle(std::string const& _string);
+	/// @returns the handle of @a _string if it is already present, without adding it otherwise.
+	std::optional<Handle> findHandle(std::string const& _string) const;
+	std::string const& idToString(size_t _id) const
 	{
-		if (_string.empty())
-			return { 0, emptyHash() };
-		std::uint64_t h = hash(_string);
-		auto range = m_hashToID.equal_range(h);
-		for (auto it = range.first; it != range.second; ++it)
-			if (*m_strings[it->second] == _string)
-				return Handle{it->second, h};
-		m_strings.emplace_back(std::make_shared<std::string>(_string));
-		size_t id = m_strings.size() - 1;
-		m_hashToID.emplace_hint(range.second, std::make_pair(h, id));
-
-		return Handle{id, h};
+		return m_shards[_id % shardCount].strings.at(_id / shardCount);
 	}
-	std::string const& idToString(size_t _id) const	{ return *m_strings.at(_id); }
 
 	static std::uint64_t hash(std::string const& v)
 	{
@@ -85,37 +99,93 @@ public:
 	/// Use with care - there cannot be any dangling YulString references.
 	/// If references need to be cleared manually, register the callback via
 	/// resetCallback.
-	static void reset()
-	{
-		for (auto const& cb: resetCallbacks())
-			cb();
-		instance() = YulStringRepository{};
-	}
+	/// If there are active sessions, the reset is performed when the last one ends.
+	static void reset();
 	/// Struct that registers a reset callback as a side-effect of its construction.
 	/// Useful as static local variable to register a reset callback once.
 	struct ResetCallback
 	{
 		ResetCallback(std::function<void()> _fun)
 		{
+			std::lock_guard<std::mutex> lock(resetCallbacksMutex());
 			YulStringRepository::resetCallbacks().emplace_back(std::move(_fun));
 		}
 	};
 
 private:
-	YulStringRepository() = default;
+	/// Append-only storage whose elements never move, so that they can be read while
+	/// other threads append. Chunk k holds firstChunkSize * 2^k strings.
+	class StringStorage
+	{
+	public:
+		std::string const& at(size_t _index) const
+		{
+			size_t const chunk = highestBit(_index / firstChunkSize + 1);
+			return m_chunks[chunk][_index - firstChunkSize * ((size_t(1) << chunk) - 1)];
+		}
+		/// @returns the index of the appended string. Has to be called with exclusive access.
+		size_t append(std::string const& _string);
+		void clear();
+
+	private:
+		static size_t highestBit(size_t _value)
+		{
+#if defined(__GNUC__) || defined(__clang__)
+			return sizeof(unsigned long long) * 8 - 1 - static_cast<size_t>(__builtin_clzll(_value));
+#else
+			size_t result = 0;
+			while (_value >>= 1)
+				++result;
+			return result;
+#endif
+		}
+
+		static constexpr size_t firstChunkSize = 64;
+		std::array<std::unique_ptr<std::string[]>, 48> m_chunks;
+		size_t m_size = 0;
+	};
+
+	struct Shard
+	{
+		mutable std::shared_mutex mutex;
+		std::unordered_multimap<std::uint64_t, size_t> hashToIndex;
+		StringStorage strings;
+	};
+
+	static constexpr size_t shardCount = 16;
+
+	YulStringRepository();
 	YulStringRepository(YulStringRepository const&) = delete;
-	YulStringRepository(YulStringRepository&&) = default;
 	YulStringRepository& operator=(YulStringRepository const& _rhs) = delete;
-	YulStringRepository& operator=(YulStringRepository&& _rhs) = default;
+
+	static size_t shardIndex(std::uint64_t _hash) { return static_cast<size_t>(_hash >> 60); }
+
+	/// @returns the ID of @a _string with hash @a _hash if it is already present.
+	/// Has to be called with at least a shared lock on the mutex of the shard.
+	std::optional<size_t> findID(std::string const& _string, std::uint64_t _hash) const;
+
+	/// Clears all shards. Has to be called without any concurrent access.
+	void clear();
 
 	static std::vector<std::function<void()>>& resetCallbacks()
 	{
 		static std::vector<std::function<void()>> callbacks;
 		return callbacks;
 	}
+	static std::mutex& resetCallbacksMutex()
+	{
+		static std::mutex mutex;
+		return mutex;
+	}
+	/// Invokes all reset callbacks and clears the repository.
+	/// Has to be called with the session mutex locked.
+	void performReset();
 
-	std::vector<std::shared_ptr<std::string>> m_strings = {std::make_shared<std::string>()};
-	std::unordered_multimap<std::uint64_t, size_t> m_hashToID = {{emptyHash(), 0}};
+	std::array<Shard, shardCount> m_shards;
+
+	std::mutex m_sessionMutex;
+	size_t m_sessionCount = 0;
+	bool m_resetPending = false;
 };
 
 /// Wrapper around handles into the YulString repository.
@@ -132,6 +202,15 @@ public:
 	YulString& operator=(YulString const&) = default;
 	YulString& operator=(YulString&&) = default;
 
+	/// @returns the YulString of @a _s if it already exists, without adding @a _s
+	/// to the repository otherwise.
+	static std::optional<YulString> find(std::string const& _s)
+	{
+		if (std::optional<YulStringRepository::Handle> handle = YulStringRepository::instance().findHandle(_s))
+			return YulString(*handle);
+		return std::nullopt;
+	}
+
 	/// This is not consistent with the string <-operator!
 	/// First compares the string hashes. If they are equal
 	/// it checks for identical IDs (only identical strings have
@@ -158,6 +237,8 @@ public:
 	uint64_t hash() const { return m_handle.hash; }
 
 private:
+	explicit YulString(YulStringRepository::Handle _handle): m_handle(_handle) {}
+
 	/// Handle of the string. Assumes that the empty string has ID zero.
 	YulStringRepository::Handle m_handle{ 0, YulStringRepository::emptyHash() };
 };
@@ -27,6 +27,7 @@
 
 #include <libsolutil/Common.h>
 #include <libsolutil/CommonData.h>
+#include <libsolutil/FixedHash.h>
 #include <libsolutil/Numeric.h>
 
 #include <functional>
@@ -103,8 +104,8 @@ public:
 	virtual void appendDataOffset(std::vector<SubID> const& _subPath) = 0;
 	/// Appends the size of the given sub-assembly or data.
 	virtual void appendDataSize(std::vector<SubID> const& _subPath) = 0;
-	/// Appends the given data to the assembly and returns its ID.
-	virtual SubID appendData(bytes const& _data) = 0;
+	/// Appends the given data, whose hash is @a _hash, to the assembly and returns its ID.
+	virtual SubID appendData(std::shared_ptr<bytes const> const& _data, util::h256 const& _hash) = 0;
 
 	/// Appends loading an immutable variable.
 	virtual void appendImmutable(std::string const& _identifier) = 0;
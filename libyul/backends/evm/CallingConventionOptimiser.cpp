@@ -0,0 +1,258 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Choice of the order in which functions take their arguments and return values on the stack.
+ */
+
+#include <libyul/backends/evm/CallingConventionOptimiser.h>
+
+#include <libyul/backends/evm/StackHelpers.h>
+#include <libyul/backends/evm/StackLayoutGenerator.h>
+
+#include <libsolutil/Algorithms.h>
+#include <libsolutil/CommonData.h>
+#include <libsolutil/Visitor.h>
+
+#include <range/v3/range/conversion.hpp>
+#include <range/v3/view/enumerate.hpp>
+#include <range/v3/view/reverse.hpp>
+#include <range/v3/view/transform.hpp>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+
+namespace
+{
+
+/// The main entry point or the entry of a function together with the functions called from its blocks.
+struct EntryPoint
+{
+	CFG::BasicBlock* entry = nullptr;
+	/// Nullptr for the main entry point.
+	CFG::FunctionInfo const* function = nullptr;
+	set<Scope::Function const*> callees;
+};
+
+/// @returns the number of operations needed for shuffling @a _source to @a _target,
+/// where operations that are too deep count a thousand times.
+size_t shuffleCost(Stack const& _source, Stack const& _target)
+{
+	size_t cost = 0;
+	Stack stack = _source;
+	createStackLayout(
+		stack,
+		_target,
+		[&](unsigned _depth) { cost += _depth > 16 ? 1001 : 1; },
+		[&](StackSlot const& _slot)
+		{
+			++cost;
+			if (canBeFreelyGenerated(_slot))
+				return;
+			if (auto depth = util::findOffset(stack | ranges::views::reverse, _slot); depth && *depth >= 16)
+				cost += 1000;
+		},
+		[&]() { ++cost; }
+	);
+	return cost;
+}
+
+Stack functionReturnLayout(CFG::FunctionInfo const& _function)
+{
+	Stack stack = _function.returnVariables | ranges::to<Stack>;
+	stack.emplace_back(FunctionReturnLabelSlot{_function.function});
+	return stack;
+}
+
+/// @returns the number of shuffling operations the code transform emits for @a _entryPoint with @a _layout.
+size_t layoutCost(EntryPoint const& _entryPoint, StackLayout const& _layout)
+{
+	Stack initial;
+	if (_entryPoint.function)
+	{
+		initial.emplace_back(FunctionReturnLabelSlot{_entryPoint.function->function});
+		for (auto const& parameter: _entryPoint.function->parameters | ranges::views::reverse)
+			initial.emplace_back(parameter);
+	}
+	size_t cost = shuffleCost(initial, _layout.blockInfos.at(_entryPoint.entry).entryLayout);
+
+	util::BreadthFirstSearch<CFG::BasicBlock const*>{{_entryPoint.entry}}.run([&](CFG::BasicBlock const* _block, auto _addChild) {
+		Stack stack = _layout.blockInfos.at(_block).entryLayout;
+		for (auto const& operation: _block->operations)
+		{
+			Stack const& operationEntry = _layout.operationEntryLayout.at(&operation);
+			cost += shuffleCost(stack, operationEntry);
+			stack = operationEntry;
+			for (size_t i = 0; i < operation.input.size(); ++i)
+				stack.pop_back();
+			stack += operation.output;
+		}
+		std::visit(util::GenericVisitor{
+			[&](CFG::BasicBlock::MainExit const&) {},
+			[&](CFG::BasicBlock::Jump const& _jump)
+			{
+				cost += shuffleCost(stack, _layout.blockInfos.at(_jump.target).entryLayout);
+				if (!_jump.backwards)
+					_addChild(_jump.target);
+			},
+			[&](CFG::BasicBlock::ConditionalJump const& _conditionalJump)
+			{
+				cost += shuffleCost(stack, _layout.blockInfos.at(_block).exitLayout);
+				_addChild(_conditionalJump.zero);
+				_addChild(_conditionalJump.nonZero);
+			},
+			[&](CFG::BasicBlock::FunctionReturn const& _functionReturn)
+			{
+				cost += shuffleCost(stack, functionReturnLayout(*_functionReturn.info));
+			},
+			[&](CFG::BasicBlock::Terminated const&) {},
+		}, _block->exit);
+	});
+	return cost;
+}
+
+vector<size_t> reversed(vector<size_t> _order)
+{
+	reverse(_order.begin(), _order.end());
+	return _order;
+}
+
+/// Changes the calling convention of @a _function and of all @a _calls to it.
+void setConvention(
+	CFG::FunctionInfo& _function,
+	vector<CFG::Operation*> const& _calls,
+	vector<size_t> const& _argumentOrder,
+	vector<size_t> const& _returnOrder
+)
+{
+	size_t arguments = _function.parameters.size();
+	vector<VariableSlot> declaredParameters = _function.parameters;
+	vector<VariableSlot> declaredReturnVariables = _function.returnVariables;
+	for (size_t i = 0; i < arguments; ++i)
+		declaredParameters[_function.argumentOrder[i]] = _function.parameters[i];
+	for (size_t i = 0; i < _function.returnVariables.size(); ++i)
+		declaredReturnVariables[_function.returnOrder[i]] = _function.returnVariables[i];
+
+	for (CFG::Operation* call: _calls)
+	{
+		// The first argument in the calling convention is at the top of the stack, below it the return label.
+		yulAssert(call->input.size() == arguments + 1, "");
+		Stack declaredArguments(arguments, JunkSlot{});
+		for (size_t i = 0; i < arguments; ++i)
+			declaredArguments[_function.argumentOrder[i]] = call->input[arguments - i];
+		for (size_t i = 0; i < arguments; ++i)
+			call->input[arguments - i] = declaredArguments[_argumentOrder[i]];
+
+		auto const& functionCall = get<CFG::FunctionCall>(call->operation).functionCall;
+		call->output = _returnOrder | ranges::views::transform([&](size_t _index) -> StackSlot {
+			return TemporarySlot{functionCall, _index};
+		}) | ranges::to<Stack>;
+	}
+
+	for (size_t i = 0; i < arguments; ++i)
+		_function.parameters[i] = declaredParameters[_argumentOrder[i]];
+	for (size_t i = 0; i < _returnOrder.size(); ++i)
+		_function.returnVariables[i] = declaredReturnVariables[_returnOrder[i]];
+	_function.argumentOrder = _argumentOrder;
+	_function.returnOrder = _returnOrder;
+}
+
+}
+
+void CallingConventionOptimiser::run(CFG& _cfg, size_t _rounds, size_t _stackLayoutEffort)
+{
+	vector<EntryPoint> entryPoints{EntryPoint{_cfg.entry, nullptr, {}}};
+	for (Scope::Function const* function: _cfg.functions)
+	{
+		CFG::FunctionInfo const& info = _cfg.functionInfo.at(function);
+		entryPoints.emplace_back(EntryPoint{info.entry, &info, {}});
+	}
+
+	map<Scope::Function const*, vector<CFG::Operation*>> calls;
+	for (EntryPoint& entryPoint: entryPoints)
+		util::BreadthFirstSearch<CFG::BasicBlock*>{{entryPoint.entry}}.run(
+			[&](CFG::BasicBlock* _block, auto _addChild) {
+				for (CFG::Operation& operation: _block->operations)
+					if (auto const* call = get_if<CFG::FunctionCall>(&operation.operation))
+					{
+						calls[&call->function.get()].emplace_back(&operation);
+						entryPoint.callees.insert(&call->function.get());
+					}
+				std::visit(util::GenericVisitor{
+					[&](CFG::BasicBlock::Jump const& _jump) { _addChild(_jump.target); },
+					[&](CFG::BasicBlock::ConditionalJump const& _conditionalJump)
+					{
+						_addChild(_conditionalJump.zero);
+						_addChild(_conditionalJump.nonZero);
+					},
+					[](auto const&) {}
+				}, _block->exit);
+			}
+		);
+
+	for (size_t round = 0; round < _rounds; ++round)
+	{
+		bool changed = false;
+		for (auto&& [index, function]: _cfg.functions | ranges::views::enumerate)
+		{
+			CFG::FunctionInfo& info = _cfg.functionInfo.at(function);
+			if (info.parameters.size() < 2 && info.returnVariables.size() < 2)
+				continue;
+
+			// Only the layouts of the function itself and of its callers depend on its calling convention.
+			vector<EntryPoint const*> affected{&entryPoints.at(index + 1)};
+			for (EntryPoint const& entryPoint: entryPoints)
+				if (entryPoint.function != &info && entryPoint.callees.count(function))
+					affected.emplace_back(&entryPoint);
+			auto cost = [&]() {
+				size_t result = 0;
+				for (EntryPoint const* entryPoint: affected)
+					result += layoutCost(
+						*entryPoint,
+						StackLayoutGenerator::runForEntryPoint(*entryPoint->entry, _stackLayoutEffort)
+					);
+				return result;
+			};
+
+			// The current convention comes first, so that it is kept unless another one is strictly better.
+			vector<pair<vector<size_t>, vector<size_t>>> conventions;
+			for (auto const& argumentOrder: {info.argumentOrder, reversed(info.argumentOrder)})
+				for (auto const& returnOrder: {info.returnOrder, reversed(info.returnOrder)})
+					if (!util::contains(conventions, make_pair(argumentOrder, returnOrder)))
+						conventions.emplace_back(argumentOrder, returnOrder);
+
+			vector<CFG::Operation*> const& functionCalls = calls[function];
+			size_t best = 0;
+			size_t bestCost = cost();
+			for (size_t i = 1; i < conventions.size(); ++i)
+			{
+				setConvention(info, functionCalls, conventions[i].first, conventions[i].second);
+				if (size_t candidateCost = cost(); candidateCost < bestCost)
+				{
+					best = i;
+					bestCost = candidateCost;
+				}
+			}
+			setConvention(info, functionCalls, conventions[best].first, conventions[best].second);
+			if (best != 0)
+				changed = true;
+		}
+		if (!changed)
+			break;
+	}
+}
@@ -0,0 +1,48 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Choice of the order in which functions take their arguments and return values on the stack.
+ */
+
+#pragma once
+
+#include <libyul/backends/evm/ControlFlowGraph.h>
+
+namespace solidity::yul
+{
+
+/**
+ * Chooses the calling convention of the functions of a control flow graph, i.e. the order in which
+ * their arguments and return values are passed on the stack (see CFG::FunctionInfo::argumentOrder),
+ * such that the function and its callers need fewer stack shuffling operations.
+ *
+ * For each function, the declaration order and its reverse are tried for both the arguments and the
+ * return values. An order is kept if it reduces the number of shuffling operations along the layouts the
+ * StackLayoutGenerator creates for the function itself and for all functions calling it, where operations
+ * that are too deep count like a thousand operations.
+ *
+ * Each round visits the functions in declaration order and the search stops after a round without changes.
+ */
+class CallingConventionOptimiser
+{
+public:
+	/// Runs at most @a _rounds rounds. @a _stackLayoutEffort is used for generating the compared layouts.
+	static void run(CFG& _cfg, size_t _rounds, size_t _stackLayoutEffort = 0);
+};
+
+}
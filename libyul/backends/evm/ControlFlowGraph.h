@@ -29,6 +29,7 @@
 
 #include <libsolutil/Numeric.h>
 
+#include <deque>
 #include <functional>
 #include <list>
 #include <vector>
@@ -164,6 +165,9 @@ struct CFG
 		/// Stack slots this operation leaves on the stack as output.
 		Stack output;
 		std::variant<FunctionCall, BuiltinCall, Assignment> operation;
+		/// Position of the operation among all operations of the graph in order of creation.
+		/// Used to store information about operations in vectors instead of maps.
+		size_t index = 0;
 	};
 
 	struct FunctionInfo;
@@ -196,6 +200,8 @@ struct CFG
 		std::vector<BasicBlock*> entries;
 		std::vector<Operation> operations;
 		std::variant<MainExit, Jump, ConditionalJump, FunctionReturn, Terminated> exit = MainExit{};
+		/// Position of the block in ``CFG::blocks``.
+		size_t index = 0;
 	};
 
 	struct FunctionInfo
@@ -203,8 +209,14 @@ struct CFG
 		std::shared_ptr<DebugData const> debugData;
 		Scope::Function const& function;
 		BasicBlock* entry = nullptr;
+		/// Parameters in the order in which they are passed, the first one at the stack top.
 		std::vector<VariableSlot> parameters;
+		/// Return variables in the order in which they are returned, the last one at the stack top.
 		std::vector<VariableSlot> returnVariables;
+		/// Calling convention of the function: @a parameters[i] is declared as parameter argumentOrder[i]
+		/// and @a returnVariables[i] as return variable returnOrder[i]. The declaration order by default.
+		std::vector<size_t> argumentOrder;
+		std::vector<size_t> returnOrder;
 	};
 
 	/// The main entry point, i.e. the start of the outermost Yul block.
@@ -215,7 +227,10 @@ struct CFG
 	std::list<Scope::Function const*> functions;
 
 	/// Container for blocks for explicit ownership.
-	std::list<BasicBlock> blocks;
+	/// A deque stores the blocks in large chunks without moving them when it grows.
+	std::deque<BasicBlock> blocks;
+	/// Number of operations in all blocks, i.e. one more than the largest ``Operation::index``.
+	size_t operationCount = 0;
 	/// Container for generated variables for explicit ownership.
 	/// Ghost variables are generated to store switch conditions when transforming the control flow
 	/// of a switch to a sequence of conditional jumps.
@@ -227,7 +242,7 @@ struct CFG
 
 	BasicBlock& makeBlock(std::shared_ptr<DebugData const> _debugData)
 	{
-		return blocks.emplace_back(BasicBlock{move(_debugData), {}, {}});
+		return blocks.emplace_back(BasicBlock{move(_debugData), {}, {}, BasicBlock::MainExit{}, blocks.size()});
 	}
 };
 
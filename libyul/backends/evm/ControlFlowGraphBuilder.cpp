@@ -195,7 +195,8 @@ void ControlFlowGraphBuilder::operator()(VariableDeclaration const& _varDecl)
 	m_currentBlock->operations.emplace_back(CFG::Operation{
 		std::move(input),
 		declaredVariables | ranges::to<Stack>,
-		CFG::Assignment{_varDecl.debugData, declaredVariables}
+		CFG::Assignment{_varDecl.debugData, declaredVariables},
+		m_graph.operationCount++
 	});
 }
 void ControlFlowGraphBuilder::operator()(Assignment const& _assignment)
@@ -211,7 +212,8 @@ void ControlFlowGraphBuilder::operator()(Assignment const& _assignment)
 		// output
 		assignedVariables | ranges::to<Stack>,
 		// operation
-		CFG::Assignment{_assignment.debugData, assignedVariables}
+		CFG::Assignment{_assignment.debugData, assignedVariables},
+		m_graph.operationCount++
 	});
 }
 void ControlFlowGraphBuilder::operator()(ExpressionStatement const& _exprStmt)
@@ -271,7 +273,8 @@ void ControlFlowGraphBuilder::operator()(Switch const& _switch)
 	m_currentBlock->operations.emplace_back(CFG::Operation{
 		Stack{std::visit(*this, *_switch.expression)},
 		Stack{ghostVarSlot},
-		CFG::Assignment{_switch.debugData, {ghostVarSlot}}
+		CFG::Assignment{_switch.debugData, {ghostVarSlot}},
+		m_graph.operationCount++
 	});
 
 	BuiltinFunction const* equalityBuiltin = m_dialect.equalityFunction({});
@@ -289,6 +292,7 @@ void ControlFlowGraphBuilder::operator()(Switch const& _switch)
 			Stack{ghostVarSlot, LiteralSlot{valueOfLiteral(*_case.value), debugDataOf(*_case.value)}},
 			Stack{TemporarySlot{ghostCall, 0}},
 			CFG::BuiltinCall{debugDataOf(_case), *equalityBuiltin, ghostCall, 2},
+			m_graph.operationCount++
 		});
 		return operation.output.front();
 	};
@@ -423,7 +427,9 @@ void ControlFlowGraphBuilder::registerFunction(FunctionDefinition const& _functi
 				std::get<Scope::Variable>(virtualFunctionScope->identifiers.at(_retVar.name)),
 				_retVar.debugData
 			};
-		}) | ranges::to<vector>
+		}) | ranges::to<vector>,
+		ranges::views::iota(0u, _function.parameters.size()) | ranges::to<vector<size_t>>,
+		ranges::views::iota(0u, _function.returnVariables.size()) | ranges::to<vector<size_t>>
 	})).second;
 	yulAssert(inserted);
 }
@@ -448,7 +454,8 @@ Stack const& ControlFlowGraphBuilder::visitFunctionCall(FunctionCall const& _cal
 				return TemporarySlot{_call, _i};
 			}) | ranges::to<Stack>,
 			// operation
-			move(builtinCall)
+			move(builtinCall),
+			m_graph.operationCount++
 		}).output;
 	}
 	else
@@ -465,7 +472,8 @@ Stack const& ControlFlowGraphBuilder::visitFunctionCall(FunctionCall const& _cal
 				return TemporarySlot{_call, _i};
 			}) | ranges::to<Stack>,
 			// operation
-			CFG::FunctionCall{_call.debugData, function, _call}
+			CFG::FunctionCall{_call.debugData, function, _call},
+			m_graph.operationCount++
 		}).output;
 	}
 }
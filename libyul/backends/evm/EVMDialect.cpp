@@ -36,6 +36,7 @@
 #include <range/v3/view/reverse.hpp>
 #include <range/v3/view/tail.hpp>
 
+#include <mutex>
 #include <regex>
 
 using namespace std;
@@ -137,9 +138,9 @@ set<YulString> createReservedIdentifiers(langutil::EVMVersion _evmVersion)
 	return reserved;
 }
 
-map<YulString, BuiltinFunctionForEVM> createBuiltins(langutil::EVMVersion _evmVersion, bool _objectAccess)
+unordered_map<YulString, BuiltinFunctionForEVM> createBuiltins(langutil::EVMVersion _evmVersion, bool _objectAccess)
 {
-	map<YulString, BuiltinFunctionForEVM> builtins;
+	unordered_map<YulString, BuiltinFunctionForEVM> builtins;
 	for (auto const& instr: evmasm::c_instructions)
 	{
 		string name = instr.first;
@@ -294,11 +295,19 @@ EVMDialect::EVMDialect(langutil::EVMVersion _evmVersion, bool _objectAccess):
 	m_functions(createBuiltins(_evmVersion, _objectAccess)),
 	m_reserved(createReservedIdentifiers(_evmVersion))
 {
+	m_discardFunction = builtin("pop"_yulstring);
+	m_equalityFunction = builtin("eq"_yulstring);
+	m_booleanNegationFunction = builtin("iszero"_yulstring);
+	m_memoryStoreFunction = builtin("mstore"_yulstring);
+	m_memoryLoadFunction = builtin("mload"_yulstring);
+	m_storageStoreFunction = builtin("sstore"_yulstring);
+	m_storageLoadFunction = builtin("sload"_yulstring);
 }
 
 BuiltinFunctionForEVM const* EVMDialect::builtin(YulString _name) const
 {
-	if (m_objectAccess)
+	// Only names starting with ``verbatim_`` can match the pattern, so the other names skip the regular expression.
+	if (m_objectAccess && _name.str().compare(0, "verbatim_"s.size(), "verbatim_") == 0)
 	{
 		smatch match;
 		if (regex_match(_name.str(), match, verbatimPattern()))
@@ -314,15 +323,20 @@ BuiltinFunctionForEVM const* EVMDialect::builtin(YulString _name) const
 bool EVMDialect::reservedIdentifier(YulString _name) const
 {
 	if (m_objectAccess)
-		if (_name.str().substr(0, "verbatim"s.size()) == "verbatim")
+		if (_name.str().compare(0, "verbatim"s.size(), "verbatim") == 0)
 			return true;
 	return m_reserved.count(_name) != 0;
 }
 
 EVMDialect const& EVMDialect::strictAssemblyForEVM(langutil::EVMVersion _version)
 {
+	static mutex dialectsMutex;
+	lock_guard<mutex> lock(dialectsMutex);
 	static map<langutil::EVMVersion, unique_ptr<EVMDialect const>> dialects;
-	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
+	static YulStringRepository::ResetCallback callback{[&] {
+		lock_guard<mutex> resetLock(dialectsMutex);
+		dialects.clear();
+	}};
 	if (!dialects[_version])
 		dialects[_version] = make_unique<EVMDialect>(_version, false);
 	return *dialects[_version];
@@ -330,8 +344,13 @@ EVMDialect const& EVMDialect::strictAssemblyForEVM(langutil::EVMVersion _version
 
 EVMDialect const& EVMDialect::strictAssemblyForEVMObjects(langutil::EVMVersion _version)
 {
+	static mutex dialectsMutex;
+	lock_guard<mutex> lock(dialectsMutex);
 	static map<langutil::EVMVersion, unique_ptr<EVMDialect const>> dialects;
-	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
+	static YulStringRepository::ResetCallback callback{[&] {
+		lock_guard<mutex> resetLock(dialectsMutex);
+		dialects.clear();
+	}};
 	if (!dialects[_version])
 		dialects[_version] = make_unique<EVMDialect>(_version, true);
 	return *dialects[_version];
@@ -359,6 +378,7 @@ SideEffects EVMDialect::sideEffectsOfInstruction(evmasm::Instruction _instructio
 BuiltinFunctionForEVM const* EVMDialect::verbatimFunction(size_t _arguments, size_t _returnVariables) const
 {
 	pair<size_t, size_t> key{_arguments, _returnVariables};
+	lock_guard<mutex> lock(m_verbatimFunctionsMutex);
 	shared_ptr<BuiltinFunctionForEVM const>& function = m_verbatimFunctions[key];
 	if (!function)
 	{
@@ -419,6 +439,7 @@ EVMDialectTyped::EVMDialectTyped(langutil::EVMVersion _evmVersion, bool _objectA
 	m_functions["not"_yulstring].returns = {"bool"_yulstring};
 	m_functions["not"_yulstring].parameters = {"bool"_yulstring};
 	m_functions.erase("iszero"_yulstring);
+	m_booleanNegationFunction = builtin("not"_yulstring);
 
 	m_functions["bitand"_yulstring] = m_functions["and"_yulstring];
 	m_functions["bitand"_yulstring].name = "bitand"_yulstring;
@@ -485,8 +506,13 @@ BuiltinFunctionForEVM const* EVMDialectTyped::equalityFunction(YulString _type)
 
 EVMDialectTyped const& EVMDialectTyped::instance(langutil::EVMVersion _version)
 {
+	static mutex dialectsMutex;
+	lock_guard<mutex> lock(dialectsMutex);
 	static map<langutil::EVMVersion, unique_ptr<EVMDialectTyped const>> dialects;
-	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
+	static YulStringRepository::ResetCallback callback{[&] {
+		lock_guard<mutex> resetLock(dialectsMutex);
+		dialects.clear();
+	}};
 	if (!dialects[_version])
 		dialects[_version] = make_unique<EVMDialectTyped>(_version, true);
 	return *dialects[_version];
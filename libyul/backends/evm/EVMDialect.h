@@ -28,7 +28,9 @@
 #include <liblangutil/EVMVersion.h>
 
 #include <map>
+#include <mutex>
 #include <set>
+#include <unordered_map>
 
 namespace solidity::yul
 {
@@ -75,13 +77,13 @@ struct EVMDialect: public Dialect
 	/// @returns true if the identifier is reserved. This includes the builtins too.
 	bool reservedIdentifier(YulString _name) const override;
 
-	BuiltinFunctionForEVM const* discardFunction(YulString /*_type*/) const override { return builtin("pop"_yulstring); }
-	BuiltinFunctionForEVM const* equalityFunction(YulString /*_type*/) const override { return builtin("eq"_yulstring); }
-	BuiltinFunctionForEVM const* booleanNegationFunction() const override { return builtin("iszero"_yulstring); }
-	BuiltinFunctionForEVM const* memoryStoreFunction(YulString /*_type*/) const override { return builtin("mstore"_yulstring); }
-	BuiltinFunctionForEVM const* memoryLoadFunction(YulString /*_type*/) const override { return builtin("mload"_yulstring); }
-	BuiltinFunctionForEVM const* storageStoreFunction(YulString /*_type*/) const override { return builtin("sstore"_yulstring); }
-	BuiltinFunctionForEVM const* storageLoadFunction(YulString /*_type*/) const override { return builtin("sload"_yulstring); }
+	BuiltinFunctionForEVM const* discardFunction(YulString /*_type*/) const override { return m_discardFunction; }
+	BuiltinFunctionForEVM const* equalityFunction(YulString /*_type*/) const override { return m_equalityFunction; }
+	BuiltinFunctionForEVM const* booleanNegationFunction() const override { return m_booleanNegationFunction; }
+	BuiltinFunctionForEVM const* memoryStoreFunction(YulString /*_type*/) const override { return m_memoryStoreFunction; }
+	BuiltinFunctionForEVM const* memoryLoadFunction(YulString /*_type*/) const override { return m_memoryLoadFunction; }
+	BuiltinFunctionForEVM const* storageStoreFunction(YulString /*_type*/) const override { return m_storageStoreFunction; }
+	BuiltinFunctionForEVM const* storageLoadFunction(YulString /*_type*/) const override { return m_storageLoadFunction; }
 	YulString hashFunction(YulString /*_type*/) const override { return "keccak256"_yulstring; }
 
 	static EVMDialect const& strictAssemblyForEVM(langutil::EVMVersion _version);
@@ -98,7 +100,19 @@ protected:
 
 	bool const m_objectAccess;
 	langutil::EVMVersion const m_evmVersion;
-	std::map<YulString, BuiltinFunctionForEVM> m_functions;
+	/// Hashed by the precomputed hash of the names, since optimiser steps look up builtins at every function call.
+	/// Elements do not move when other builtins are added, so pointers to them stay valid.
+	std::unordered_map<YulString, BuiltinFunctionForEVM> m_functions;
+	/// Builtins with special roles, looked up once instead of by name every time they are requested.
+	BuiltinFunctionForEVM const* m_discardFunction = nullptr;
+	BuiltinFunctionForEVM const* m_equalityFunction = nullptr;
+	BuiltinFunctionForEVM const* m_booleanNegationFunction = nullptr;
+	BuiltinFunctionForEVM const* m_memoryStoreFunction = nullptr;
+	BuiltinFunctionForEVM const* m_memoryLoadFunction = nullptr;
+	BuiltinFunctionForEVM const* m_storageStoreFunction = nullptr;
+	BuiltinFunctionForEVM const* m_storageLoadFunction = nullptr;
+	/// Dialects are shared between threads, so lazily creating verbatim functions has to be synchronised.
+	std::mutex mutable m_verbatimFunctionsMutex;
 	std::map<std::pair<size_t, size_t>, std::shared_ptr<BuiltinFunctionForEVM const>> mutable m_verbatimFunctions;
 	std::set<YulString> m_reserved;
 };
@@ -120,7 +134,6 @@ struct EVMDialectTyped: public EVMDialect
 
 	BuiltinFunctionForEVM const* discardFunction(YulString _type) const override;
 	BuiltinFunctionForEVM const* equalityFunction(YulString _type) const override;
-	BuiltinFunctionForEVM const* booleanNegationFunction() const override { return builtin("not"_yulstring); }
 
 	static EVMDialectTyped const& instance(langutil::EVMVersion _version);
 };
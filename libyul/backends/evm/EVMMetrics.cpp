@@ -41,6 +41,11 @@ bigint GasMeter::costs(Expression const& _expression) const
 	return combineCosts(GasMeterVisitor::costs(_expression, m_dialect, m_isCreation));
 }
 
+bigint GasMeter::codeCosts(Block const& _block) const
+{
+	return combineCosts(GasMeterVisitor::codeCosts(_block, m_dialect, m_isCreation));
+}
+
 bigint GasMeter::instructionCosts(evmasm::Instruction _instruction) const
 {
 	return combineCosts(GasMeterVisitor::instructionCosts(_instruction, m_dialect, m_isCreation));
@@ -55,14 +60,28 @@ bigint GasMeter::combineCosts(std::pair<bigint, bigint> _costs) const
 pair<bigint, bigint> GasMeterVisitor::costs(
 	Expression const& _expression,
 	EVMDialect const& _dialect,
-	bool _isCreation
+	bool _isCreation,
+	bool _estimateCalls
 )
 {
 	GasMeterVisitor gmv(_dialect, _isCreation);
+	gmv.m_estimateCalls = _estimateCalls;
 	gmv.visit(_expression);
 	return {gmv.m_runGas, gmv.m_dataGas};
 }
 
+pair<bigint, bigint> GasMeterVisitor::codeCosts(
+	Block const& _block,
+	EVMDialect const& _dialect,
+	bool _isCreation
+)
+{
+	GasMeterVisitor gmv(_dialect, _isCreation);
+	gmv.m_estimateCalls = true;
+	gmv(_block);
+	return {gmv.m_runGas, gmv.m_dataGas};
+}
+
 pair<bigint, bigint> GasMeterVisitor::instructionCosts(
 	evmasm::Instruction _instruction,
 	EVMDialect const& _dialect,
@@ -76,14 +95,31 @@ pair<bigint, bigint> GasMeterVisitor::instructionCosts(
 
 void GasMeterVisitor::operator()(FunctionCall const& _funCall)
 {
-	ASTWalker::operator()(_funCall);
-	if (BuiltinFunctionForEVM const* f = m_dialect.builtin(_funCall.functionName.name))
-		if (f->instruction)
-		{
-			instructionCostsInternal(*f->instruction);
-			return;
-		}
-	yulAssert(false, "Functions not implemented.");
+	BuiltinFunctionForEVM const* f = m_dialect.builtin(_funCall.functionName.name);
+	if (f && f->instruction)
+	{
+		ASTWalker::operator()(_funCall);
+		instructionCostsInternal(*f->instruction);
+		return;
+	}
+	yulAssert(m_estimateCalls, "Functions not implemented.");
+
+	// Literal arguments of builtins are not pushed to the stack.
+	for (size_t i = 0; i < _funCall.arguments.size(); ++i)
+		if (!f || !f->literalArgument(i))
+			visit(_funCall.arguments[i]);
+	if (f)
+		// Builtins without an instruction mostly push a value known at assembly time.
+		instructionCostsInternal(evmasm::Instruction::PUSH1);
+	else
+	{
+		// Push the return label, jump into the function and back.
+		instructionCostsInternal(evmasm::Instruction::PUSH1);
+		instructionCostsInternal(evmasm::Instruction::JUMP);
+		instructionCostsInternal(evmasm::Instruction::JUMPDEST);
+		instructionCostsInternal(evmasm::Instruction::JUMP);
+		instructionCostsInternal(evmasm::Instruction::JUMPDEST);
+	}
 }
 
 void GasMeterVisitor::operator()(Literal const& _lit)
@@ -120,6 +156,6 @@ void GasMeterVisitor::instructionCostsInternal(evmasm::Instruction _instruction)
 		// Assumes that Keccak-256 is computed on a single word (rounded up).
 		m_runGas += evmasm::GasCosts::keccak256Gas + evmasm::GasCosts::keccak256WordGas;
 	else
-		m_runGas += evmasm::GasMeter::runGas(_instruction);
+		m_runGas += evmasm::GasMeter::runGas(_instruction, m_dialect.evmVersion());
 	m_dataGas += singleByteDataGas();
 }
@@ -38,6 +38,9 @@ struct EVMDialect;
  * Is not particularly exact for anything apart from arithmetic.
  *
  * Assumes that Keccak-256 is computed on a single word (rounded up).
+ *
+ * Uses the costs of ``evmasm::GasMeter::runGas`` for the EVM version of the dialect,
+ * i.e. storage slots and accounts are assumed to be cold from Berlin on.
  */
 class GasMeter
 {
@@ -50,6 +53,10 @@ public:
 
 	/// @returns the full combined costs of deploying and evaluating the expression.
 	bigint costs(Expression const& _expression) const;
+	/// @returns the combined costs of deploying the code and evaluating each of its expressions
+	/// once, including the bodies of functions. Calls to functions that are not single instructions
+	/// are estimated by the costs of the jumps into the function and back.
+	bigint codeCosts(Block const& _block) const;
 	/// @returns the combined costs of deploying and running the instruction, not including
 	/// the costs for its arguments.
 	bigint instructionCosts(evmasm::Instruction _instruction) const;
@@ -65,9 +72,17 @@ private:
 class GasMeterVisitor: public ASTWalker
 {
 public:
+	/// If @a _estimateCalls is set, calls to functions that are not single instructions are
+	/// estimated by the costs of the jumps into the function and back, otherwise they are not allowed.
 	static std::pair<bigint, bigint> costs(
 		Expression const& _expression,
 		EVMDialect const& _dialect,
+		bool _isCreation,
+		bool _estimateCalls = false
+	);
+	static std::pair<bigint, bigint> codeCosts(
+		Block const& _block,
+		EVMDialect const& _dialect,
 		bool _isCreation
 	);
 
@@ -83,6 +98,7 @@ public:
 		m_isCreation{_isCreation}
 	{}
 
+	using ASTWalker::operator();
 	void operator()(FunctionCall const& _funCall) override;
 	void operator()(Literal const& _literal) override;
 	void operator()(Identifier const& _identifier) override;
@@ -96,6 +112,8 @@ private:
 
 	EVMDialect const& m_dialect;
 	bool m_isCreation = false;
+	/// If true, calls to functions that are not single instructions are estimated instead of rejected.
+	bool m_estimateCalls = false;
 	bigint m_runGas = 0;
 	bigint m_dataGas = 0;
 };
@@ -31,9 +31,16 @@
 using namespace solidity::yul;
 using namespace std;
 
-void EVMObjectCompiler::compile(Object& _object, AbstractAssembly& _assembly, EVMDialect const& _dialect, bool _optimize)
+void EVMObjectCompiler::compile(
+	Object& _object,
+	AbstractAssembly& _assembly,
+	EVMDialect const& _dialect,
+	bool _optimize,
+	size_t _stackLayoutEffort,
+	size_t _parallelism
+)
 {
-	EVMObjectCompiler compiler(_assembly, _dialect);
+	EVMObjectCompiler compiler(_assembly, _dialect, _stackLayoutEffort, _parallelism);
 	compiler.run(_object, _optimize);
 }
 
@@ -49,16 +56,16 @@ void EVMObjectCompiler::run(Object& _object, bool _optimize)
 			auto subAssemblyAndID = m_assembly.createSubAssembly(subObject->name.str());
 			context.subIDs[subObject->name] = subAssemblyAndID.second;
 			subObject->subId = subAssemblyAndID.second;
-			compile(*subObject, *subAssemblyAndID.first, m_dialect, _optimize);
+			compile(*subObject, *subAssemblyAndID.first, m_dialect, _optimize, m_stackLayoutEffort, m_parallelism);
 		}
 		else
 		{
 			Data const& data = dynamic_cast<Data const&>(*subNode);
 			// Special handling of metadata.
 			if (data.name.str() == Object::metadataName())
-				m_assembly.appendToAuxiliaryData(data.data);
+				m_assembly.appendToAuxiliaryData(*data.data);
 			else
-				context.subIDs[data.name] = m_assembly.appendData(data.data);
+				context.subIDs[data.name] = m_assembly.appendData(data.data, data.hash);
 		}
 
 	yulAssert(_object.analysisInfo, "No analysis info.");
@@ -71,7 +78,9 @@ void EVMObjectCompiler::run(Object& _object, bool _optimize)
 			*_object.code,
 			m_dialect,
 			context,
-			OptimizedEVMCodeTransform::UseNamedLabels::ForFirstFunctionOfEachName
+			OptimizedEVMCodeTransform::UseNamedLabels::ForFirstFunctionOfEachName,
+			m_stackLayoutEffort,
+			m_parallelism
 		);
 		if (!stackErrors.empty())
 			BOOST_THROW_EXCEPTION(stackErrors.front());
@@ -21,6 +21,8 @@
 
 #pragma once
 
+#include <cstddef>
+
 namespace solidity::yul
 {
 struct Object;
@@ -30,16 +32,26 @@ struct EVMDialect;
 class EVMObjectCompiler
 {
 public:
-	static void compile(Object& _object, AbstractAssembly& _assembly, EVMDialect const& _dialect, bool _optimize);
+	/// @a _stackLayoutEffort and @a _parallelism are passed on to the StackLayoutGenerator if @a _optimize is set.
+	static void compile(
+		Object& _object,
+		AbstractAssembly& _assembly,
+		EVMDialect const& _dialect,
+		bool _optimize,
+		size_t _stackLayoutEffort = 0,
+		size_t _parallelism = 1
+	);
 private:
-	EVMObjectCompiler(AbstractAssembly& _assembly, EVMDialect const& _dialect):
-		m_assembly(_assembly), m_dialect(_dialect)
+	EVMObjectCompiler(AbstractAssembly& _assembly, EVMDialect const& _dialect, size_t _stackLayoutEffort, size_t _parallelism):
+		m_assembly(_assembly), m_dialect(_dialect), m_stackLayoutEffort(_stackLayoutEffort), m_parallelism(_parallelism)
 	{}
 
 	void run(Object& _object, bool _optimize);
 
 	AbstractAssembly& m_assembly;
 	EVMDialect const& m_dialect;
+	size_t m_stackLayoutEffort = 0;
+	size_t m_parallelism = 1;
 };
 
 }
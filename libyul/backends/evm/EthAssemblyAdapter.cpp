@@ -153,9 +153,9 @@ void EthAssemblyAdapter::appendDataSize(vector<AbstractAssembly::SubID> const& _
 	m_assembly.pushSubroutineSize(m_assembly.encodeSubPath(_subPath));
 }
 
-AbstractAssembly::SubID EthAssemblyAdapter::appendData(bytes const& _data)
+AbstractAssembly::SubID EthAssemblyAdapter::appendData(shared_ptr<bytes const> const& _data, util::h256 const& _hash)
 {
-	evmasm::AssemblyItem pushData = m_assembly.newData(_data);
+	evmasm::AssemblyItem pushData = m_assembly.newData(_data, _hash);
 	SubID subID = m_nextDataCounter++;
 	m_dataHashBySubId[subID] = pushData.data();
 	return subID;
@@ -58,7 +58,7 @@ public:
 	std::pair<std::shared_ptr<AbstractAssembly>, SubID> createSubAssembly(std::string _name = {}) override;
 	void appendDataOffset(std::vector<SubID> const& _subPath) override;
 	void appendDataSize(std::vector<SubID> const& _subPath) override;
-	SubID appendData(bytes const& _data) override;
+	SubID appendData(std::shared_ptr<bytes const> const& _data, util::h256 const& _hash) override;
 
 	void appendToAuxiliaryData(bytes const& _data) override;
 
@@ -114,7 +114,7 @@ void NoOutputAssembly::appendDataSize(std::vector<AbstractAssembly::SubID> const
 	appendInstruction(evmasm::Instruction::PUSH1);
 }
 
-AbstractAssembly::SubID NoOutputAssembly::appendData(bytes const&)
+AbstractAssembly::SubID NoOutputAssembly::appendData(shared_ptr<bytes const> const&, util::h256 const&)
 {
 	return 1;
 }
@@ -17,6 +17,8 @@
 // SPDX-License-Identifier: GPL-3.0
 #include <libyul/backends/evm/OptimizedEVMCodeTransform.h>
 
+#include <libyul/backends/evm/CallingConventionOptimiser.h>
+#include <libyul/backends/evm/SSAConstantPropagator.h>
 #include <libyul/backends/evm/ControlFlowGraphBuilder.h>
 #include <libyul/backends/evm/StackHelpers.h>
 #include <libyul/backends/evm/StackLayoutGenerator.h>
@@ -44,11 +46,18 @@ vector<StackTooDeepError> OptimizedEVMCodeTransform::run(
 	Block const& _block,
 	EVMDialect const& _dialect,
 	BuiltinContext& _builtinContext,
-	UseNamedLabels _useNamedLabelsForFunctions
+	UseNamedLabels _useNamedLabelsForFunctions,
+	size_t _stackLayoutEffort,
+	size_t _parallelism
 )
 {
 	std::unique_ptr<CFG> dfg = ControlFlowGraphBuilder::build(_analysisInfo, _dialect, _block);
-	StackLayout stackLayout = StackLayoutGenerator::run(*dfg);
+	if (_stackLayoutEffort > 0)
+	{
+		SSAConstantPropagator::run(*dfg);
+		CallingConventionOptimiser::run(*dfg, _stackLayoutEffort, _stackLayoutEffort);
+	}
+	StackLayout stackLayout = StackLayoutGenerator::run(*dfg, _stackLayoutEffort, _parallelism);
 	OptimizedEVMCodeTransform optimizedCodeTransform(
 		_assembly,
 		_builtinContext,
@@ -66,16 +75,17 @@ vector<StackTooDeepError> OptimizedEVMCodeTransform::run(
 
 void OptimizedEVMCodeTransform::operator()(CFG::FunctionCall const& _call)
 {
+	CFG::FunctionInfo const& functionInfo = m_dfg.functionInfo.at(&_call.function.get());
 	// Validate stack.
 	{
 		yulAssert(m_assembly.stackHeight() == static_cast<int>(m_stack.size()), "");
 		yulAssert(m_stack.size() >= _call.function.get().arguments.size() + 1, "");
-		// Assert that we got the correct arguments on stack for the call.
-		for (auto&& [arg, slot]: ranges::zip_view(
-			_call.functionCall.get().arguments | ranges::views::reverse,
-			m_stack | ranges::views::take_last(_call.functionCall.get().arguments.size())
-		))
-			validateSlot(slot, arg);
+		// Assert that we got the correct arguments on stack for the call, in the order of its calling convention.
+		for (auto&& [depth, argumentIndex]: functionInfo.argumentOrder | ranges::views::enumerate)
+			validateSlot(
+				m_stack.at(m_stack.size() - 1 - depth),
+				_call.functionCall.get().arguments.at(argumentIndex)
+			);
 		// Assert that we got the correct return label on stack.
 		auto const* returnLabelSlot = get_if<FunctionCallReturnLabelSlot>(
 			&m_stack.at(m_stack.size() - _call.functionCall.get().arguments.size() - 1)
@@ -100,7 +110,7 @@ void OptimizedEVMCodeTransform::operator()(CFG::FunctionCall const& _call)
 		for (size_t i = 0; i < _call.function.get().arguments.size() + 1; ++i)
 			m_stack.pop_back();
 		// Push return values to m_stack.
-		for (size_t index: ranges::views::iota(0u, _call.function.get().returns.size()))
+		for (size_t index: functionInfo.returnOrder)
 			m_stack.emplace_back(TemporarySlot{_call.functionCall, index});
 		yulAssert(m_assembly.stackHeight() == static_cast<int>(m_stack.size()), "");
 	}
@@ -222,6 +232,9 @@ void OptimizedEVMCodeTransform::validateSlot(StackSlot const& _slot, Expression
 			yulAssert(literalSlot && valueOfLiteral(_literal) == literalSlot->value, "");
 		},
 		[&](yul::Identifier const& _identifier) {
+			// The SSAConstantPropagator replaces variables with a constant value by literals.
+			if (holds_alternative<LiteralSlot>(_slot))
+				return;
 			auto* variableSlot = get_if<VariableSlot>(&_slot);
 			yulAssert(variableSlot && variableSlot->variable.get().name == _identifier.name, "");
 		},
@@ -0,0 +1,305 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Sparse conditional constant propagation on the control flow graph used during code generation.
+ */
+
+#include <libyul/backends/evm/SSAConstantPropagator.h>
+
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/SSAControlFlowGraphBuilder.h>
+
+#include <libevmasm/Instruction.h>
+
+#include <libsolutil/Algorithms.h>
+#include <libsolutil/cxx20.h>
+#include <libsolutil/Visitor.h>
+
+#include <algorithm>
+#include <set>
+
+using namespace solidity;
+using namespace solidity::yul;
+using namespace std;
+
+namespace
+{
+
+/// Largest constant that replaces a variable in the inputs of operations. Pushing it takes at most
+/// two bytes more than duplicating the variable, but frees its stack slot.
+u256 const maxSubstitutedConstant = 0xffff;
+
+/// Element of the lattice of the propagation. Values are only lowered from undefined to a constant
+/// and from a constant to not constant.
+struct LatticeValue
+{
+	enum class Kind { Undefined, Constant, NotConstant };
+	Kind kind = Kind::Undefined;
+	u256 value = 0;
+
+	static LatticeValue constant(u256 _value) { return {Kind::Constant, move(_value)}; }
+	static LatticeValue notConstant() { return {Kind::NotConstant, 0}; }
+	bool operator==(LatticeValue const& _other) const
+	{
+		return kind == _other.kind && (kind != Kind::Constant || value == _other.value);
+	}
+	bool operator!=(LatticeValue const& _other) const { return !(*this == _other); }
+};
+
+LatticeValue meet(LatticeValue const& _a, LatticeValue const& _b)
+{
+	if (_a.kind == LatticeValue::Kind::Undefined)
+		return _b;
+	if (_b.kind == LatticeValue::Kind::Undefined || _a == _b)
+		return _a;
+	return LatticeValue::notConstant();
+}
+
+/// @returns the result of @a _instruction for the given arguments, the first argument first,
+/// if it is an arithmetic, bitwise or comparison instruction.
+optional<u256> evaluate(evmasm::Instruction _instruction, vector<u256> const& _arguments)
+{
+	using evmasm::Instruction;
+	switch (_instruction)
+	{
+	case Instruction::ADD: return u256(_arguments[0] + _arguments[1]);
+	case Instruction::SUB: return u256(_arguments[0] - _arguments[1]);
+	case Instruction::MUL: return u256(_arguments[0] * _arguments[1]);
+	case Instruction::DIV: return _arguments[1] == 0 ? 0 : u256(_arguments[0] / _arguments[1]);
+	case Instruction::MOD: return _arguments[1] == 0 ? 0 : u256(_arguments[0] % _arguments[1]);
+	case Instruction::LT: return _arguments[0] < _arguments[1] ? 1 : 0;
+	case Instruction::GT: return _arguments[0] > _arguments[1] ? 1 : 0;
+	case Instruction::EQ: return _arguments[0] == _arguments[1] ? 1 : 0;
+	case Instruction::ISZERO: return _arguments[0] == 0 ? 1 : 0;
+	case Instruction::AND: return u256(_arguments[0] & _arguments[1]);
+	case Instruction::OR: return u256(_arguments[0] | _arguments[1]);
+	case Instruction::XOR: return u256(_arguments[0] ^ _arguments[1]);
+	case Instruction::NOT: return u256(~_arguments[0]);
+	case Instruction::SHL: return _arguments[0] >= 256 ? 0 : u256(_arguments[1] << unsigned(_arguments[0]));
+	case Instruction::SHR: return _arguments[0] >= 256 ? 0 : u256(_arguments[1] >> unsigned(_arguments[0]));
+	default: return nullopt;
+	}
+}
+
+/// Lowers the values of the SSA form of a graph in rounds over its executed blocks
+/// until nothing changes anymore.
+class Propagation
+{
+public:
+	Propagation(CFG const& _cfg, SSACFG const& _ssa):
+		m_ssa(_ssa),
+		m_values(_ssa.values.size()),
+		m_executed(_cfg.blocks.size(), false)
+	{
+		for (SSACFG::ValueId id = 0; id < _ssa.values.size(); ++id)
+			if (auto const* literal = get_if<SSACFG::LiteralValue>(&_ssa.values[id]))
+				m_values[id] = LatticeValue::constant(literal->value);
+			else if (holds_alternative<SSACFG::ParameterValue>(_ssa.values[id]))
+				m_values[id] = LatticeValue::notConstant();
+
+		m_executed[_cfg.entry->index] = true;
+		for (auto const& [function, functionInfo]: _cfg.functionInfo)
+			m_executed[functionInfo.entry->index] = true;
+
+		do
+		{
+			m_changed = false;
+			for (CFG::BasicBlock const* block: _ssa.blocks)
+				if (m_executed[block->index])
+					visitBlock(*block);
+		}
+		while (m_changed);
+	}
+
+	bool executed(CFG::BasicBlock const& _block) const { return m_executed[_block.index]; }
+	optional<u256> constant(SSACFG::ValueId _value) const
+	{
+		if (m_values[_value].kind == LatticeValue::Kind::Constant)
+			return m_values[_value].value;
+		return nullopt;
+	}
+
+private:
+	void visitBlock(CFG::BasicBlock const& _block)
+	{
+		for (SSACFG::ValueId phi: m_ssa.phis[_block.index])
+		{
+			vector<SSACFG::ValueId> const& arguments = get<SSACFG::Phi>(m_ssa.values[phi]).arguments;
+			LatticeValue joined;
+			for (size_t i = 0; i < arguments.size(); ++i)
+				if (m_executedEdges.count({_block.entries[i]->index, _block.index}))
+					joined = meet(joined, m_values[arguments[i]]);
+			lower(phi, joined);
+		}
+
+		for (CFG::Operation const& operation: _block.operations)
+		{
+			vector<SSACFG::ValueId> const& outputs = m_ssa.operationOutputs[operation.index];
+			auto const* builtinCall = get_if<CFG::BuiltinCall>(&operation.operation);
+			if (builtinCall && outputs.size() == 1)
+				lower(outputs.front(), evaluateBuiltin(operation, *builtinCall));
+			else
+				for (SSACFG::ValueId output: outputs)
+					lower(output, LatticeValue::notConstant());
+		}
+
+		std::visit(util::GenericVisitor{
+			[&](CFG::BasicBlock::Jump const& _jump) {
+				markExecuted(_block, *_jump.target);
+			},
+			[&](CFG::BasicBlock::ConditionalJump const& _conditionalJump) {
+				yulAssert(m_ssa.conditions[_block.index].has_value(), "");
+				LatticeValue const& condition = m_values[*m_ssa.conditions[_block.index]];
+				// An undefined condition is treated like one that is not constant, since the
+				// jumps are only removed from the graph for constant conditions.
+				if (condition.kind != LatticeValue::Kind::Constant || condition.value != 0)
+					markExecuted(_block, *_conditionalJump.nonZero);
+				if (condition.kind != LatticeValue::Kind::Constant || condition.value == 0)
+					markExecuted(_block, *_conditionalJump.zero);
+			},
+			[](auto const&) {}
+		}, _block.exit);
+	}
+
+	LatticeValue evaluateBuiltin(CFG::Operation const& _operation, CFG::BuiltinCall const& _call) const
+	{
+		auto const& builtin = static_cast<BuiltinFunctionForEVM const&>(_call.builtin.get());
+		if (!builtin.instruction || _call.arguments != _call.functionCall.get().arguments.size())
+			return LatticeValue::notConstant();
+
+		// The first argument is at the stack top, i.e. it is the last input.
+		vector<optional<SSACFG::ValueId>> const& inputs = m_ssa.operationInputs[_operation.index];
+		vector<u256> arguments;
+		for (auto input = inputs.rbegin(); input != inputs.rend(); ++input)
+		{
+			yulAssert(input->has_value(), "");
+			LatticeValue const& argument = m_values[**input];
+			if (argument.kind != LatticeValue::Kind::Constant)
+				return argument;
+			arguments.emplace_back(argument.value);
+		}
+		if (optional<u256> result = evaluate(*builtin.instruction, arguments))
+			return LatticeValue::constant(*result);
+		return LatticeValue::notConstant();
+	}
+
+	void lower(SSACFG::ValueId _value, LatticeValue const& _newValue)
+	{
+		LatticeValue lowered = meet(m_values[_value], _newValue);
+		if (lowered != m_values[_value])
+		{
+			m_values[_value] = lowered;
+			m_changed = true;
+		}
+	}
+
+	void markExecuted(CFG::BasicBlock const& _from, CFG::BasicBlock const& _to)
+	{
+		if (m_executedEdges.emplace(_from.index, _to.index).second)
+			m_changed = true;
+		if (!m_executed[_to.index])
+		{
+			m_executed[_to.index] = true;
+			m_changed = true;
+		}
+	}
+
+	SSACFG const& m_ssa;
+	vector<LatticeValue> m_values;
+	vector<bool> m_executed;
+	set<pair<size_t, size_t>> m_executedEdges;
+	bool m_changed = false;
+};
+
+/// Removes the entries of blocks that are no longer reachable.
+void removeUnreachableEntries(CFG& _cfg)
+{
+	util::BreadthFirstSearch<CFG::BasicBlock*> reachabilityCheck{{_cfg.entry}};
+	for (auto& [function, functionInfo]: _cfg.functionInfo)
+		reachabilityCheck.verticesToTraverse.emplace_back(functionInfo.entry);
+
+	reachabilityCheck.run([&](CFG::BasicBlock* _node, auto&& _addChild) {
+		std::visit(util::GenericVisitor{
+			[&](CFG::BasicBlock::Jump const& _jump) {
+				_addChild(_jump.target);
+			},
+			[&](CFG::BasicBlock::ConditionalJump const& _jump) {
+				_addChild(_jump.zero);
+				_addChild(_jump.nonZero);
+			},
+			[](auto const&) {}
+		}, _node->exit);
+	});
+
+	for (CFG::BasicBlock* node: reachabilityCheck.visited)
+		cxx20::erase_if(node->entries, [&](CFG::BasicBlock* entry) -> bool {
+			return !reachabilityCheck.visited.count(entry);
+		});
+}
+
+}
+
+vector<optional<u256>> SSAConstantPropagator::constants(CFG const& _cfg, SSACFG const& _ssa)
+{
+	Propagation propagation{_cfg, _ssa};
+	vector<optional<u256>> constants;
+	for (SSACFG::ValueId id = 0; id < _ssa.values.size(); ++id)
+		constants.emplace_back(propagation.constant(id));
+	return constants;
+}
+
+void SSAConstantPropagator::run(CFG& _cfg)
+{
+	unique_ptr<SSACFG> ssa = SSAControlFlowGraphBuilder::build(_cfg);
+	Propagation propagation{_cfg, *ssa};
+
+	bool removedJumps = false;
+	for (CFG::BasicBlock& block: _cfg.blocks)
+	{
+		auto const* conditionalJump = get_if<CFG::BasicBlock::ConditionalJump>(&block.exit);
+		if (!conditionalJump || !propagation.executed(block))
+			continue;
+		optional<u256> condition = propagation.constant(*ssa->conditions[block.index]);
+		if (!condition)
+			continue;
+
+		CFG::BasicBlock* target = *condition != 0 ? conditionalJump->nonZero : conditionalJump->zero;
+		CFG::BasicBlock* skipped = *condition != 0 ? conditionalJump->zero : conditionalJump->nonZero;
+		// Only removes one occurrence, in case both jumps have the same target.
+		auto entry = find(skipped->entries.begin(), skipped->entries.end(), &block);
+		yulAssert(entry != skipped->entries.end(), "");
+		skipped->entries.erase(entry);
+		block.exit = CFG::BasicBlock::Jump{conditionalJump->debugData, target};
+		removedJumps = true;
+	}
+	if (removedJumps)
+		removeUnreachableEntries(_cfg);
+
+	for (CFG::BasicBlock& block: _cfg.blocks)
+		if (propagation.executed(block))
+			for (CFG::Operation& operation: block.operations)
+				for (size_t i = 0; i < operation.input.size(); ++i)
+					if (auto const* variable = get_if<VariableSlot>(&operation.input[i]))
+					{
+						optional<SSACFG::ValueId> value = ssa->operationInputs[operation.index][i];
+						yulAssert(value.has_value(), "");
+						if (optional<u256> constant = propagation.constant(*value))
+							if (*constant <= maxSubstitutedConstant)
+								operation.input[i] = LiteralSlot{*constant, variable->debugData};
+					}
+}
@@ -0,0 +1,57 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Sparse conditional constant propagation on the control flow graph used during code generation.
+ */
+
+#pragma once
+
+#include <libyul/backends/evm/SSAControlFlowGraph.h>
+
+#include <optional>
+#include <vector>
+
+namespace solidity::yul
+{
+
+/**
+ * Sparse conditional constant propagation (Wegman and Zadeck, "Constant Propagation with
+ * Conditional Branches") on the SSA form of a control flow graph.
+ *
+ * Values start out as undefined and are lowered to a constant or to "not constant"; the outputs of
+ * arithmetic, bitwise and comparison builtins of constant arguments are constant. A block is only
+ * considered executed if it is jumped to by an executed block whose condition does not exclude the
+ * jump, and phi functions only join the values from the executed entries of their blocks. Unlike
+ * constant propagation on the AST, this finds the values of variables that are assigned to in loops
+ * and the branches that are never taken because of them.
+ *
+ * The results are applied to the graph: Conditional jumps with a constant condition are replaced by
+ * jumps, the blocks that are no longer reachable are removed from the entries of the others, and
+ * variables with a constant value that fits into two bytes are replaced by the literal in the
+ * inputs of operations, so that they do not have to be kept on the stack.
+ */
+class SSAConstantPropagator
+{
+public:
+	/// The constant values of the values of @a _ssa, nullopt for the values that are not constant
+	/// or only occur in blocks not executed, indexed by ``SSACFG::ValueId``.
+	static std::vector<std::optional<u256>> constants(CFG const& _cfg, SSACFG const& _ssa);
+	static void run(CFG& _cfg);
+};
+
+}
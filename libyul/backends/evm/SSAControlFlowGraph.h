@@ -0,0 +1,84 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Static single assignment form of the control flow graph used during code generation.
+ */
+
+#pragma once
+
+#include <libyul/backends/evm/ControlFlowGraph.h>
+
+#include <optional>
+#include <variant>
+#include <vector>
+
+namespace solidity::yul
+{
+
+/// Static single assignment form of a ``CFG``: Maps every stack slot consumed by an operation or
+/// a conditional jump of the blocks reachable from the entries of the graph to the value it holds.
+/// Assignments do not define values of their own, i.e. a variable that is assigned another variable
+/// or a literal holds the same value as the assigned one.
+/// The blocks and operations of the graph have to outlive its SSA form and must not change.
+struct SSACFG
+{
+	using ValueId = size_t;
+
+	struct LiteralValue
+	{
+		u256 value;
+	};
+	/// The value of a variable at the entry of a function, i.e. of a function parameter.
+	struct ParameterValue
+	{
+		Scope::Variable const* variable = nullptr;
+	};
+	/// The @a index-th output of a function or builtin call.
+	struct OperationOutput
+	{
+		CFG::Operation const* operation = nullptr;
+		size_t index = 0;
+	};
+	/// Joins the values a variable has at the ends of the entries of @a block.
+	struct Phi
+	{
+		CFG::BasicBlock const* block = nullptr;
+		/// The values in the order of ``block->entries``.
+		std::vector<ValueId> arguments;
+	};
+	using Value = std::variant<LiteralValue, ParameterValue, OperationOutput, Phi>;
+
+	std::vector<Value> values;
+	/// The values of the inputs of each operation, indexed by ``CFG::Operation::index``.
+	/// Return labels and junk slots do not have a value.
+	std::vector<std::vector<std::optional<ValueId>>> operationInputs;
+	/// The values of the outputs of each function and builtin call, indexed by ``CFG::Operation::index``.
+	std::vector<std::vector<ValueId>> operationOutputs;
+	/// The value of the condition of the conditional jump at the end of each block, indexed by
+	/// ``CFG::BasicBlock::index``.
+	std::vector<std::optional<ValueId>> conditions;
+	/// The phi functions at the start of each block, indexed by ``CFG::BasicBlock::index``.
+	std::vector<std::vector<ValueId>> phis;
+	/// The blocks reachable from the entries of the graph in reverse post order, i.e. every block
+	/// comes after the blocks jumping to it, apart from backwards jumps.
+	std::vector<CFG::BasicBlock const*> blocks;
+	/// Whether each block is reachable from an entry, indexed by ``CFG::BasicBlock::index``.
+	std::vector<bool> reachable;
+};
+
+}
@@ -0,0 +1,311 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Construction of the static single assignment form of a control flow graph.
+ */
+
+#include <libyul/backends/evm/SSAControlFlowGraphBuilder.h>
+
+#include <libsolutil/CommonData.h>
+#include <libsolutil/cxx20.h>
+#include <libsolutil/Visitor.h>
+
+#include <algorithm>
+#include <numeric>
+
+using namespace solidity;
+using namespace solidity::yul;
+using namespace std;
+
+namespace
+{
+
+vector<CFG::BasicBlock const*> successors(CFG::BasicBlock const& _block)
+{
+	return std::visit(util::GenericVisitor{
+		[](CFG::BasicBlock::Jump const& _jump) -> vector<CFG::BasicBlock const*> {
+			return {_jump.target};
+		},
+		[](CFG::BasicBlock::ConditionalJump const& _jump) -> vector<CFG::BasicBlock const*> {
+			return {_jump.nonZero, _jump.zero};
+		},
+		[](auto const&) -> vector<CFG::BasicBlock const*> { return {}; }
+	}, _block.exit);
+}
+
+}
+
+unique_ptr<SSACFG> SSAControlFlowGraphBuilder::build(CFG const& _cfg)
+{
+	auto ssa = make_unique<SSACFG>();
+	SSAControlFlowGraphBuilder builder{_cfg, *ssa};
+
+	builder.collectBlocks(*_cfg.entry);
+	for (Scope::Function const* function: _cfg.functions)
+		builder.collectBlocks(*_cfg.functionInfo.at(function).entry);
+
+	for (CFG::BasicBlock const* block: ssa->blocks)
+		builder.visitBlock(*block);
+	builder.removeTrivialPhis();
+
+	return ssa;
+}
+
+SSAControlFlowGraphBuilder::SSAControlFlowGraphBuilder(CFG const& _cfg, SSACFG& _ssa):
+	m_ssa(_ssa),
+	m_functionEntries(_cfg.blocks.size(), nullptr),
+	m_currentValues(_cfg.blocks.size()),
+	m_incompletePhis(_cfg.blocks.size()),
+	m_visited(_cfg.blocks.size(), false),
+	m_sealed(_cfg.blocks.size(), false)
+{
+	m_ssa.operationInputs.resize(_cfg.operationCount);
+	m_ssa.operationOutputs.resize(_cfg.operationCount);
+	m_ssa.conditions.resize(_cfg.blocks.size());
+	m_ssa.phis.resize(_cfg.blocks.size());
+	m_ssa.reachable.resize(_cfg.blocks.size(), false);
+	for (auto const& [function, functionInfo]: _cfg.functionInfo)
+		m_functionEntries[functionInfo.entry->index] = &functionInfo;
+}
+
+void SSAControlFlowGraphBuilder::collectBlocks(CFG::BasicBlock const& _entry)
+{
+	// Depth-first search with an explicit stack of the blocks and their next successor to visit.
+	vector<CFG::BasicBlock const*> postOrder;
+	vector<pair<CFG::BasicBlock const*, size_t>> stack{{&_entry, 0}};
+	m_ssa.reachable[_entry.index] = true;
+	while (!stack.empty())
+	{
+		auto [block, next] = stack.back();
+		vector<CFG::BasicBlock const*> blockSuccessors = successors(*block);
+		if (next < blockSuccessors.size())
+		{
+			++stack.back().second;
+			CFG::BasicBlock const* successor = blockSuccessors[next];
+			if (!m_ssa.reachable[successor->index])
+			{
+				m_ssa.reachable[successor->index] = true;
+				stack.emplace_back(successor, 0);
+			}
+		}
+		else
+		{
+			postOrder.emplace_back(block);
+			stack.pop_back();
+		}
+	}
+	m_ssa.blocks.insert(m_ssa.blocks.end(), postOrder.rbegin(), postOrder.rend());
+}
+
+void SSAControlFlowGraphBuilder::visitBlock(CFG::BasicBlock const& _block)
+{
+	auto allEntriesVisited = [&](CFG::BasicBlock const& _target) {
+		return all_of(_target.entries.begin(), _target.entries.end(), [&](CFG::BasicBlock const* _entry) {
+			return m_visited[_entry->index];
+		});
+	};
+	if (allEntriesVisited(_block))
+		seal(_block);
+
+	map<Scope::Variable const*, SSACFG::ValueId>& currentValues = m_currentValues[_block.index];
+	if (CFG::FunctionInfo const* function = m_functionEntries[_block.index])
+	{
+		for (VariableSlot const& parameter: function->parameters)
+			currentValues[&parameter.variable.get()] = newValue(SSACFG::ParameterValue{&parameter.variable.get()});
+		// Return variables are initialized to zero.
+		for (VariableSlot const& returnVariable: function->returnVariables)
+			currentValues[&returnVariable.variable.get()] = literal(0);
+	}
+
+	for (CFG::Operation const& operation: _block.operations)
+	{
+		vector<optional<SSACFG::ValueId>> inputs;
+		for (StackSlot const& slot: operation.input)
+			inputs.emplace_back(readSlot(slot, _block));
+
+		if (auto const* assignment = get_if<CFG::Assignment>(&operation.operation))
+		{
+			yulAssert(inputs.size() == assignment->variables.size(), "");
+			for (size_t i = 0; i < inputs.size(); ++i)
+			{
+				yulAssert(inputs[i].has_value(), "");
+				currentValues[&assignment->variables[i].variable.get()] = *inputs[i];
+			}
+		}
+		else
+			for (size_t i = 0; i < operation.output.size(); ++i)
+			{
+				TemporarySlot const* temporary = get_if<TemporarySlot>(&operation.output[i]);
+				yulAssert(temporary, "");
+				SSACFG::ValueId output = newValue(SSACFG::OperationOutput{&operation, i});
+				m_ssa.operationOutputs[operation.index].emplace_back(output);
+				m_temporaries[{&temporary->call.get(), temporary->index}] = output;
+			}
+
+		m_ssa.operationInputs[operation.index] = move(inputs);
+	}
+
+	if (auto const* conditionalJump = get_if<CFG::BasicBlock::ConditionalJump>(&_block.exit))
+		m_ssa.conditions[_block.index] = readSlot(conditionalJump->condition, _block);
+
+	m_visited[_block.index] = true;
+	for (CFG::BasicBlock const* successor: successors(_block))
+		if (!m_sealed[successor->index] && allEntriesVisited(*successor))
+			seal(*successor);
+}
+
+void SSAControlFlowGraphBuilder::seal(CFG::BasicBlock const& _block)
+{
+	for (auto const& [variable, phi]: m_incompletePhis[_block.index])
+		addPhiArguments(*variable, phi);
+	m_incompletePhis[_block.index].clear();
+	m_sealed[_block.index] = true;
+}
+
+void SSAControlFlowGraphBuilder::removeTrivialPhis()
+{
+	vector<SSACFG::ValueId> replacements(m_ssa.values.size());
+	iota(replacements.begin(), replacements.end(), 0);
+	auto resolve = [&](SSACFG::ValueId _value) {
+		while (replacements[_value] != _value)
+			_value = replacements[_value];
+		return _value;
+	};
+
+	// Replacing a phi function can make the phi functions using it trivial, so this is repeated
+	// until no more phi functions are replaced.
+	bool changed = true;
+	while (changed)
+	{
+		changed = false;
+		for (vector<SSACFG::ValueId> const& blockPhis: m_ssa.phis)
+			for (SSACFG::ValueId phi: blockPhis)
+			{
+				if (resolve(phi) != phi)
+					continue;
+				optional<SSACFG::ValueId> uniqueArgument;
+				bool trivial = true;
+				for (SSACFG::ValueId argument: get<SSACFG::Phi>(m_ssa.values[phi]).arguments)
+				{
+					argument = resolve(argument);
+					if (argument == phi || argument == uniqueArgument)
+						continue;
+					if (uniqueArgument)
+					{
+						trivial = false;
+						break;
+					}
+					uniqueArgument = argument;
+				}
+				if (trivial && uniqueArgument)
+				{
+					replacements[phi] = *uniqueArgument;
+					changed = true;
+				}
+			}
+	}
+
+	for (vector<SSACFG::ValueId>& blockPhis: m_ssa.phis)
+	{
+		cxx20::erase_if(blockPhis, [&](SSACFG::ValueId _phi) { return resolve(_phi) != _phi; });
+		for (SSACFG::ValueId phi: blockPhis)
+			for (SSACFG::ValueId& argument: get<SSACFG::Phi>(m_ssa.values[phi]).arguments)
+				argument = resolve(argument);
+	}
+	for (vector<optional<SSACFG::ValueId>>& inputs: m_ssa.operationInputs)
+		for (optional<SSACFG::ValueId>& input: inputs)
+			if (input)
+				input = resolve(*input);
+	for (optional<SSACFG::ValueId>& condition: m_ssa.conditions)
+		if (condition)
+			condition = resolve(*condition);
+}
+
+optional<SSACFG::ValueId> SSAControlFlowGraphBuilder::readSlot(StackSlot const& _slot, CFG::BasicBlock const& _block)
+{
+	return std::visit(util::GenericVisitor{
+		[&](VariableSlot const& _variable) -> optional<SSACFG::ValueId> {
+			return readVariable(_variable.variable, _block);
+		},
+		[&](LiteralSlot const& _literal) -> optional<SSACFG::ValueId> {
+			return literal(_literal.value);
+		},
+		[&](TemporarySlot const& _temporary) -> optional<SSACFG::ValueId> {
+			return m_temporaries.at({&_temporary.call.get(), _temporary.index});
+		},
+		[](auto const&) -> optional<SSACFG::ValueId> { return nullopt; }
+	}, _slot);
+}
+
+SSACFG::ValueId SSAControlFlowGraphBuilder::readVariable(Scope::Variable const& _variable, CFG::BasicBlock const& _block)
+{
+	if (SSACFG::ValueId const* value = util::valueOrNullptr(m_currentValues[_block.index], &_variable))
+		return *value;
+	return readVariableFromEntries(_variable, _block);
+}
+
+SSACFG::ValueId SSAControlFlowGraphBuilder::readVariableFromEntries(Scope::Variable const& _variable, CFG::BasicBlock const& _block)
+{
+	SSACFG::ValueId value;
+	if (!m_sealed[_block.index])
+	{
+		// Not all entries are known yet, so the arguments are added when the block is sealed.
+		value = newValue(SSACFG::Phi{&_block, {}});
+		m_ssa.phis[_block.index].emplace_back(value);
+		m_incompletePhis[_block.index][&_variable] = value;
+	}
+	else if (_block.entries.empty())
+		// Variables are declared before they are used, so this is only reached for the
+		// parameters of functions, which do not have a known value.
+		value = newValue(SSACFG::ParameterValue{&_variable});
+	else if (_block.entries.size() == 1)
+		value = readVariable(_variable, *_block.entries.front());
+	else
+	{
+		value = newValue(SSACFG::Phi{&_block, {}});
+		m_ssa.phis[_block.index].emplace_back(value);
+		// Recorded before the arguments are read to break cycles through loops.
+		m_currentValues[_block.index][&_variable] = value;
+		addPhiArguments(_variable, value);
+	}
+	m_currentValues[_block.index][&_variable] = value;
+	return value;
+}
+
+void SSAControlFlowGraphBuilder::addPhiArguments(Scope::Variable const& _variable, SSACFG::ValueId _phi)
+{
+	CFG::BasicBlock const& block = *get<SSACFG::Phi>(m_ssa.values[_phi]).block;
+	vector<SSACFG::ValueId> arguments;
+	for (CFG::BasicBlock const* entry: block.entries)
+		arguments.emplace_back(readVariable(_variable, *entry));
+	// Reading the arguments can add values, so the phi function is only accessed afterwards.
+	get<SSACFG::Phi>(m_ssa.values[_phi]).arguments = move(arguments);
+}
+
+SSACFG::ValueId SSAControlFlowGraphBuilder::literal(u256 const& _value)
+{
+	if (SSACFG::ValueId const* value = util::valueOrNullptr(m_literals, _value))
+		return *value;
+	return m_literals[_value] = newValue(SSACFG::LiteralValue{_value});
+}
+
+SSACFG::ValueId SSAControlFlowGraphBuilder::newValue(SSACFG::Value _value)
+{
+	m_ssa.values.emplace_back(move(_value));
+	return m_ssa.values.size() - 1;
+}
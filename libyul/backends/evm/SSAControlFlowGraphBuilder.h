@@ -0,0 +1,79 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Construction of the static single assignment form of a control flow graph.
+ */
+#pragma once
+
+#include <libyul/backends/evm/SSAControlFlowGraph.h>
+
+#include <map>
+#include <memory>
+
+namespace solidity::yul
+{
+
+/**
+ * Constructs the SSA form of a control flow graph as described in Braun et al., "Simple and
+ * Efficient Construction of Static Single Assignment Form": The blocks are visited in reverse
+ * post order and the value of a variable not assigned to in a block is looked up in its entries,
+ * with a phi function if there are several. A block is sealed, i.e. the phi functions of its
+ * variables are completed, once all its entries have been visited.
+ *
+ * Phi functions whose arguments are all the same value, apart from the phi function itself,
+ * are replaced by that value afterwards.
+ */
+class SSAControlFlowGraphBuilder
+{
+public:
+	SSAControlFlowGraphBuilder(SSAControlFlowGraphBuilder const&) = delete;
+	SSAControlFlowGraphBuilder& operator=(SSAControlFlowGraphBuilder const&) = delete;
+	static std::unique_ptr<SSACFG> build(CFG const& _cfg);
+
+private:
+	SSAControlFlowGraphBuilder(CFG const& _cfg, SSACFG& _ssa);
+
+	/// Adds the blocks reachable from @a _entry to the block order of the SSA form.
+	void collectBlocks(CFG::BasicBlock const& _entry);
+	void visitBlock(CFG::BasicBlock const& _block);
+	/// Completes the phi functions of @a _block, whose entries have all been visited.
+	void seal(CFG::BasicBlock const& _block);
+	/// Replaces the phi functions with a single distinct argument and resolves the replacements.
+	void removeTrivialPhis();
+
+	std::optional<SSACFG::ValueId> readSlot(StackSlot const& _slot, CFG::BasicBlock const& _block);
+	SSACFG::ValueId readVariable(Scope::Variable const& _variable, CFG::BasicBlock const& _block);
+	SSACFG::ValueId readVariableFromEntries(Scope::Variable const& _variable, CFG::BasicBlock const& _block);
+	void addPhiArguments(Scope::Variable const& _variable, SSACFG::ValueId _phi);
+	SSACFG::ValueId literal(u256 const& _value);
+	SSACFG::ValueId newValue(SSACFG::Value _value);
+
+	SSACFG& m_ssa;
+	/// The function whose entry each block is, if any, indexed by ``CFG::BasicBlock::index``.
+	std::vector<CFG::FunctionInfo const*> m_functionEntries;
+	/// The current values of the variables in each block, indexed by ``CFG::BasicBlock::index``.
+	std::vector<std::map<Scope::Variable const*, SSACFG::ValueId>> m_currentValues;
+	/// The phi functions created in each block before it was sealed, indexed by ``CFG::BasicBlock::index``.
+	std::vector<std::map<Scope::Variable const*, SSACFG::ValueId>> m_incompletePhis;
+	std::vector<bool> m_visited;
+	std::vector<bool> m_sealed;
+	std::map<u256, SSACFG::ValueId> m_literals;
+	std::map<std::pair<yul::FunctionCall const*, size_t>, SSACFG::ValueId> m_temporaries;
+};
+
+}
@@ -25,6 +25,8 @@
 
 #include <libsolutil/Algorithms.h>
 #include <libsolutil/cxx20.h>
+#include <libsolutil/Profiler.h>
+#include <libsolutil/ThreadPool.h>
 #include <libsolutil/Visitor.h>
 
 #include <range/v3/algorithm/any_of.hpp>
@@ -46,14 +48,42 @@ using namespace solidity;
 using namespace solidity::yul;
 using namespace std;
 
-StackLayout StackLayoutGenerator::run(CFG const& _cfg)
+StackLayout StackLayoutGenerator::run(CFG const& _cfg, size_t _effort, size_t _parallelism)
 {
+	util::Profiler::Scope profilerScope{"stack layout generation"};
 	StackLayout stackLayout;
-	StackLayoutGenerator{stackLayout}.processEntryPoint(*_cfg.entry);
+	if (_parallelism <= 1 || _cfg.functionInfo.empty())
+	{
+		StackLayoutGenerator{stackLayout, _effort}.processEntryPoint(*_cfg.entry);
+
+		for (auto& functionInfo: _cfg.functionInfo | ranges::views::values)
+			StackLayoutGenerator{stackLayout, _effort}.processEntryPoint(*functionInfo.entry);
+
+		return stackLayout;
+	}
 
+	// The blocks reachable from different entry points are disjoint and function calls only depend on
+	// the fixed calling convention, so every entry point can be processed into a layout of its own.
+	vector<CFG::BasicBlock const*> entries{_cfg.entry};
 	for (auto& functionInfo: _cfg.functionInfo | ranges::views::values)
-		StackLayoutGenerator{stackLayout}.processEntryPoint(*functionInfo.entry);
+		entries.emplace_back(functionInfo.entry);
+	vector<StackLayout> layouts(entries.size());
+	util::parallelFor(entries.size(), _parallelism, [&](size_t _i) {
+		StackLayoutGenerator{layouts[_i], _effort}.processEntryPoint(*entries[_i]);
+	});
+	for (StackLayout& layout: layouts)
+	{
+		stackLayout.blockInfos.merge(layout.blockInfos);
+		stackLayout.operationEntryLayout.merge(layout.operationEntryLayout);
+		yulAssert(layout.blockInfos.empty() && layout.operationEntryLayout.empty(), "");
+	}
+	return stackLayout;
+}
 
+StackLayout StackLayoutGenerator::runForEntryPoint(CFG::BasicBlock const& _entry, size_t _effort)
+{
+	StackLayout stackLayout;
+	StackLayoutGenerator{stackLayout, _effort}.processEntryPoint(_entry);
 	return stackLayout;
 }
 
@@ -87,7 +117,9 @@ vector<StackLayoutGenerator::StackTooDeep> StackLayoutGenerator::reportStackTooD
 	return generator.reportStackTooDeep(*entry);
 }
 
-StackLayoutGenerator::StackLayoutGenerator(StackLayout& _layout): m_layout(_layout)
+StackLayoutGenerator::StackLayoutGenerator(StackLayout& _layout, size_t _effort):
+	m_layout(_layout),
+	m_effort(_effort)
 {
 }
 
@@ -420,7 +452,7 @@ optional<Stack> StackLayoutGenerator::getExitLayoutOrStageDependencies(
 			{
 				// Choose the best currently known entry layout of the jump target as initial exit.
 				// Note that this may not yet be the final layout.
-				if (auto* info = util::valueOrNullptr(m_layout.blockInfos, _jump.target))
+				if (auto* info = m_layout.blockInfos.find(_jump.target))
 					return info->entryLayout;
 				return Stack{};
 			}
@@ -541,8 +573,12 @@ void StackLayoutGenerator::stitchConditionalJumps(CFG::BasicBlock const& _block)
 	});
 }
 
-Stack StackLayoutGenerator::combineStack(Stack const& _stack1, Stack const& _stack2)
+Stack StackLayoutGenerator::combineStack(Stack const& _stack1, Stack const& _stack2) const
 {
+	auto key = make_pair(_stack1, _stack2);
+	if (auto const* combined = util::valueOrNullptr(m_combinedStacks, key))
+		return *combined;
+
 	// TODO: it would be nicer to replace this by a constructive algorithm.
 	// Currently it uses a reduced version of the Heap Algorithm to partly brute-force, which seems
 	// to work decently well.
@@ -575,21 +611,7 @@ Stack StackLayoutGenerator::combineStack(Stack const& _stack1, Stack const& _sta
 	});
 
 	auto evaluate = [&](Stack const& _candidate) -> size_t {
-		size_t numOps = 0;
-		Stack testStack = _candidate;
-		auto swap = [&](unsigned _swapDepth) { ++numOps; if (_swapDepth > 16) numOps += 1000; };
-		auto dupOrPush = [&](StackSlot const& _slot)
-		{
-			if (canBeFreelyGenerated(_slot))
-				return;
-			auto depth = util::findOffset(ranges::concat_view(commonPrefix, testStack) | ranges::views::reverse, _slot);
-			if (depth && *depth >= 16)
-				numOps += 1000;
-		};
-		createStackLayout(testStack, stack1Tail, swap, dupOrPush, [&](){});
-		testStack = _candidate;
-		createStackLayout(testStack, stack2Tail, swap, dupOrPush, [&](){});
-		return numOps;
+		return shuffleCost(commonPrefix, _candidate, stack1Tail) + shuffleCost(commonPrefix, _candidate, stack2Tail);
 	};
 
 	// See https://en.wikipedia.org/wiki/Heap's_algorithm
@@ -625,7 +647,64 @@ Stack StackLayoutGenerator::combineStack(Stack const& _stack1, Stack const& _sta
 		}
 	}
 
-	return commonPrefix + bestCandidate;
+	// Each round of the local search moves to the best layout that differs from the current one
+	// by exchanging two slots, until no exchange is an improvement or the effort is spent.
+	for (size_t round = 0; round < m_effort; ++round)
+	{
+		Stack bestNeighbour = bestCandidate;
+		size_t bestNeighbourCost = bestCost;
+		for (size_t first = 0; first < n; ++first)
+			for (size_t second = first + 1; second < n; ++second)
+			{
+				candidate = bestCandidate;
+				std::swap(candidate[first], candidate[second]);
+				if (size_t cost = evaluate(candidate); cost < bestNeighbourCost)
+				{
+					bestNeighbourCost = cost;
+					bestNeighbour = candidate;
+				}
+			}
+		if (bestNeighbourCost == bestCost)
+			break;
+		bestCost = bestNeighbourCost;
+		bestCandidate = move(bestNeighbour);
+	}
+
+	return m_combinedStacks[key] = commonPrefix + bestCandidate;
+}
+
+size_t StackLayoutGenerator::shuffleCost(Stack const& _prefix, Stack const& _source, Stack const& _target) const
+{
+	// The shuffling only depends on which slots are equal, which are junk and which can be freely generated,
+	// so slots are replaced by the index of their first occurrence. Junk is encoded as zero.
+	vector<size_t> key{_prefix.size(), _source.size()};
+	map<StackSlot, size_t> slotIndices;
+	for (Stack const* stack: {&_prefix, &_source, &_target})
+		for (StackSlot const& slot: *stack)
+			if (holds_alternative<JunkSlot>(slot))
+				key.emplace_back(0);
+			else
+			{
+				size_t index = slotIndices.emplace(slot, slotIndices.size()).first->second;
+				key.emplace_back(2 * index + (canBeFreelyGenerated(slot) ? 2 : 1));
+			}
+	auto [it, inserted] = m_shuffleCosts.try_emplace(move(key), 0);
+	if (!inserted)
+		return it->second;
+
+	size_t numOps = 0;
+	Stack testStack = _source;
+	auto swap = [&](unsigned _swapDepth) { ++numOps; if (_swapDepth > 16) numOps += 1000; };
+	auto dupOrPush = [&](StackSlot const& _slot)
+	{
+		if (canBeFreelyGenerated(_slot))
+			return;
+		auto depth = util::findOffset(ranges::concat_view(_prefix, testStack) | ranges::views::reverse, _slot);
+		if (depth && *depth >= 16)
+			numOps += 1000;
+	};
+	createStackLayout(testStack, _target, swap, dupOrPush, [&](){});
+	return it->second = numOps;
 }
 
 vector<StackLayoutGenerator::StackTooDeep> StackLayoutGenerator::reportStackTooDeep(CFG::BasicBlock const& _entry) const
@@ -22,12 +22,83 @@
 #pragma once
 
 #include <libyul/backends/evm/ControlFlowGraph.h>
+#include <libyul/Exceptions.h>
 
 #include <map>
+#include <optional>
+#include <vector>
 
 namespace solidity::yul
 {
 
+/**
+ * Map from blocks or operations of a CFG to values, stored in a vector at the index of the key.
+ * Grows as needed, so that it does not have to know the size of the graph in advance.
+ */
+template<typename Key, typename Value>
+class CFGIndexedMap
+{
+public:
+	/// @returns the value of @a _key, inserting a default constructed one, if there is none.
+	Value& operator[](Key const* _key)
+	{
+		if (_key->index >= m_values.size())
+			m_values.resize(_key->index + 1);
+		std::optional<Value>& value = m_values[_key->index];
+		if (!value)
+		{
+			value.emplace();
+			m_indices.push_back(_key->index);
+		}
+		return *value;
+	}
+	Value& at(Key const* _key)
+	{
+		Value* value = find(_key);
+		yulAssert(value, "");
+		return *value;
+	}
+	Value const& at(Key const* _key) const
+	{
+		Value const* value = find(_key);
+		yulAssert(value, "");
+		return *value;
+	}
+	/// @returns the value of @a _key or nullptr if there is none.
+	Value* find(Key const* _key)
+	{
+		if (_key->index >= m_values.size() || !m_values[_key->index])
+			return nullptr;
+		return &*m_values[_key->index];
+	}
+	Value const* find(Key const* _key) const
+	{
+		return const_cast<CFGIndexedMap&>(*this).find(_key);
+	}
+	bool empty() const { return m_indices.empty(); }
+	size_t size() const { return m_indices.size(); }
+	/// Moves all values of @a _other here, which must not have keys in common with this map.
+	/// Only visits the keys present in @a _other, which is empty afterwards.
+	void merge(CFGIndexedMap& _other)
+	{
+		if (_other.m_values.size() > m_values.size())
+			m_values.resize(_other.m_values.size());
+		for (size_t index: _other.m_indices)
+		{
+			yulAssert(!m_values[index], "");
+			m_values[index] = std::move(_other.m_values[index]);
+			m_indices.push_back(index);
+		}
+		_other.m_values.clear();
+		_other.m_indices.clear();
+	}
+
+private:
+	std::vector<std::optional<Value>> m_values;
+	/// Indices of the present values in order of insertion.
+	std::vector<size_t> m_indices;
+};
+
 struct StackLayout
 {
 	struct BlockInfo
@@ -37,11 +108,11 @@ struct StackLayout
 		/// The resulting stack layout after executing the block.
 		Stack exitLayout;
 	};
-	std::map<CFG::BasicBlock const*, BlockInfo> blockInfos;
+	CFGIndexedMap<CFG::BasicBlock, BlockInfo> blockInfos;
 	/// For each operation the complete stack layout that:
 	/// - has the slots required for the operation at the stack top.
 	/// - will have the operation result in a layout that makes it easy to achieve the next desired layout.
-	std::map<CFG::Operation const*, Stack> operationEntryLayout;
+	CFGIndexedMap<CFG::Operation, Stack> operationEntryLayout;
 };
 
 class StackLayoutGenerator
@@ -55,7 +126,13 @@ public:
 		std::vector<YulString> variableChoices;
 	};
 
-	static StackLayout run(CFG const& _cfg);
+	/// @a _effort is the number of rounds of local search used to improve the layouts of conditional
+	/// jumps beyond the initial heuristic, see @a combineStack.
+	/// The main entry point and the functions are processed on up to @a _parallelism threads.
+	static StackLayout run(CFG const& _cfg, size_t _effort = 0, size_t _parallelism = 1);
+	/// @returns the layouts of the blocks reachable from @a _entry, which is the main entry point
+	/// or the entry of a function. They do not depend on the other entry points.
+	static StackLayout runForEntryPoint(CFG::BasicBlock const& _entry, size_t _effort = 0);
 	/// @returns a map from function names to the stack too deep errors occurring in that function.
 	/// Requires @a _cfg to be a control flow graph generated from disambiguated Yul.
 	/// The empty string is mapped to the stack too deep errors of the main entry point.
@@ -66,7 +143,7 @@ public:
 	static std::vector<StackTooDeep> reportStackTooDeep(CFG const& _cfg, YulString _functionName);
 
 private:
-	StackLayoutGenerator(StackLayout& _context);
+	StackLayoutGenerator(StackLayout& _context, size_t _effort = 0);
 
 	/// @returns the optimal entry stack layout, s.t. @a _operation can be applied to it and
 	/// the result can be transformed to @a _exitStack with minimal stack shuffling.
@@ -100,7 +177,13 @@ private:
 
 	/// Calculates the ideal stack layout, s.t. both @a _stack1 and @a _stack2 can be achieved with minimal
 	/// stack shuffling when starting from the returned layout.
-	static Stack combineStack(Stack const& _stack1, Stack const& _stack2);
+	/// The result is cached, since the layouts are propagated repeatedly until they stabilize.
+	Stack combineStack(Stack const& _stack1, Stack const& _stack2) const;
+
+	/// @returns the number of operations needed to shuffle @a _source to @a _target on top of @a _prefix,
+	/// plus 1000 for each of them that is too deep. Only used to compare layouts, so the operations are
+	/// not generated. The result is cached for all stacks with the same pattern of equal slots.
+	size_t shuffleCost(Stack const& _prefix, Stack const& _source, Stack const& _target) const;
 
 	/// Walks through the CFG and reports any stack too deep errors that would occur when generating code for it
 	/// without countermeasures.
@@ -112,6 +195,10 @@ private:
 	static Stack compressStack(Stack _stack);
 
 	StackLayout& m_layout;
+	size_t m_effort = 0;
+	mutable std::map<std::pair<Stack, Stack>, Stack> m_combinedStacks;
+	/// Results of shuffleCost by the canonical form of its arguments.
+	mutable std::map<std::vector<size_t>, size_t> m_shuffleCosts;
 };
 
 }
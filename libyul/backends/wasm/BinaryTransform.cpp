@@ -38,11 +38,6 @@ using namespace solidity::util;
 namespace
 {
 
-bytes toBytes(uint8_t _b)
-{
-	return bytes(1, _b);
-}
-
 enum class LimitsKind: uint8_t
 {
 	Min = 0x00,
@@ -67,11 +62,6 @@ enum class Section: uint8_t
 	CODE = 0x0a
 };
 
-bytes toBytes(Section _s)
-{
-	return toBytes(uint8_t(_s));
-}
-
 enum class ValueType: uint8_t
 {
 	Void = 0x40,
@@ -80,11 +70,6 @@ enum class ValueType: uint8_t
 	I32 = 0x7f
 };
 
-bytes toBytes(ValueType _vt)
-{
-	return toBytes(uint8_t(_vt));
-}
-
 ValueType toValueType(wasm::Type _type)
 {
 	if (_type == wasm::Type::i32)
@@ -101,11 +86,6 @@ enum class Export: uint8_t
 	Memory = 0x2
 };
 
-bytes toBytes(Export _export)
-{
-	return toBytes(uint8_t(_export));
-}
-
 // NOTE: This is a subset of WebAssembly opcodes.
 //       Those available as a builtin are listed further down.
 enum class Opcode: uint8_t
@@ -130,9 +110,9 @@ enum class Opcode: uint8_t
 	I64Const = 0x42,
 };
 
-bytes toBytes(Opcode _o)
+void appendOpcode(bytes& _out, Opcode _opcode)
 {
-	return toBytes(uint8_t(_o));
+	_out.push_back(uint8_t(_opcode));
 }
 
 Opcode constOpcodeFor(ValueType _type)
@@ -236,15 +216,19 @@ static map<string, uint8_t> const builtins = {
 	{"i64.extend_i32_u", 0xad},
 };
 
-bytes prefixSize(bytes _data)
+/// Inserts the size of the contents appended to @a _out since @a _start in front of them.
+void insertSizePrefix(bytes& _out, size_t _start)
 {
-	size_t size = _data.size();
-	return lebEncode(size) + move(_data);
+	bytes size;
+	lebEncodeTo(size, _out.size() - _start);
+	_out.insert(_out.begin() + static_cast<ptrdiff_t>(_start), size.begin(), size.end());
 }
 
-bytes makeSection(Section _section, bytes _data)
+/// Starts a section by appending its ID and @returns the position its contents start at.
+size_t beginSection(bytes& _out, Section _section)
 {
-	return toBytes(_section) + prefixSize(move(_data));
+	_out.push_back(uint8_t(_section));
+	return _out.size();
 }
 
 /// This is a kind of run-length-encoding of local types.
@@ -293,12 +277,12 @@ bytes BinaryTransform::run(Module const& _module)
 	bytes ret{0, 'a', 's', 'm'};
 	// version
 	ret += bytes{1, 0, 0, 0};
-	ret += typeSection(types);
-	ret += importSection(_module.imports, functionTypes);
-	ret += functionSection(_module.functions, functionTypes);
-	ret += memorySection();
-	ret += globalSection(_module.globals);
-	ret += exportSection(functionIDs);
+	typeSection(ret, types);
+	importSection(ret, _module.imports, functionTypes);
+	functionSection(ret, _module.functions, functionTypes);
+	memorySection(ret);
+	globalSection(ret, _module.globals);
+	exportSection(ret, functionIDs);
 
 	map<string, pair<size_t, size_t>> subModulePosAndSize;
 	for (auto const& [name, module]: _module.subModules)
@@ -306,7 +290,7 @@ bytes BinaryTransform::run(Module const& _module)
 		// TODO should we prefix and / or shorten the name?
 		bytes data = BinaryTransform::run(module);
 		size_t const length = data.size();
-		ret += customSection(name, move(data));
+		customSection(ret, name, data);
 		// Skip all the previous sections and the size field of this current custom section.
 		size_t const offset = ret.size() - length;
 		subModulePosAndSize[name] = {offset, length};
@@ -314,49 +298,58 @@ bytes BinaryTransform::run(Module const& _module)
 	for (auto const& [name, data]: _module.customSections)
 	{
 		size_t const length = data.size();
-		ret += customSection(name, data);
+		customSection(ret, name, data);
 		// Skip all the previous sections and the size field of this current custom section.
 		size_t const offset = ret.size() - length;
 		subModulePosAndSize[name] = {offset, length};
 	}
 
 	BinaryTransform bt(
+		ret,
 		move(globalIDs),
 		move(functionIDs),
 		move(functionTypes),
 		move(subModulePosAndSize)
 	);
 
-	ret += bt.codeSection(_module.functions);
+	bt.codeSection(_module.functions);
 	return ret;
 }
 
-bytes BinaryTransform::operator()(Literal const& _literal)
+void BinaryTransform::operator()(Literal const& _literal)
 {
-	return std::visit(GenericVisitor{
-		[&](uint32_t _value) -> bytes { return toBytes(Opcode::I32Const) + lebEncodeSigned(static_cast<int32_t>(_value)); },
-		[&](uint64_t _value) -> bytes { return toBytes(Opcode::I64Const) + lebEncodeSigned(static_cast<int64_t>(_value)); },
+	std::visit(GenericVisitor{
+		[&](uint32_t _value) {
+			appendOpcode(m_out, Opcode::I32Const);
+			lebEncodeSignedTo(m_out, static_cast<int32_t>(_value));
+		},
+		[&](uint64_t _value) {
+			appendOpcode(m_out, Opcode::I64Const);
+			lebEncodeSignedTo(m_out, static_cast<int64_t>(_value));
+		},
 	}, _literal.value);
 }
 
-bytes BinaryTransform::operator()(StringLiteral const&)
+void BinaryTransform::operator()(StringLiteral const&)
 {
 	// StringLiteral is a special AST element used for certain builtins.
 	// It is not mapped to actual WebAssembly, and should be processed in visit(BuiltinCall).
 	yulAssert(false, "");
 }
 
-bytes BinaryTransform::operator()(LocalVariable const& _variable)
+void BinaryTransform::operator()(LocalVariable const& _variable)
 {
-	return toBytes(Opcode::LocalGet) + lebEncode(m_locals.at(_variable.name));
+	appendOpcode(m_out, Opcode::LocalGet);
+	lebEncodeTo(m_out, m_locals.at(_variable.name));
 }
 
-bytes BinaryTransform::operator()(GlobalVariable const& _variable)
+void BinaryTransform::operator()(GlobalVariable const& _variable)
 {
-	return toBytes(Opcode::GlobalGet) + lebEncode(m_globalIDs.at(_variable.name));
+	appendOpcode(m_out, Opcode::GlobalGet);
+	lebEncodeTo(m_out, m_globalIDs.at(_variable.name));
 }
 
-bytes BinaryTransform::operator()(BuiltinCall const& _call)
+void BinaryTransform::operator()(BuiltinCall const& _call)
 {
 	// We need to avoid visiting the arguments of `dataoffset` and `datasize` because
 	// they are references to object names that should not end up in the code.
@@ -365,20 +358,24 @@ bytes BinaryTransform::operator()(BuiltinCall const& _call)
 		string name = get<StringLiteral>(_call.arguments.at(0)).value;
 		// TODO: support the case where name refers to the current object
 		yulAssert(m_subModulePosAndSize.count(name), "");
-		return toBytes(Opcode::I64Const) + lebEncodeSigned(static_cast<int64_t>(m_subModulePosAndSize.at(name).first));
+		appendOpcode(m_out, Opcode::I64Const);
+		lebEncodeSignedTo(m_out, static_cast<int64_t>(m_subModulePosAndSize.at(name).first));
+		return;
 	}
 	else if (_call.functionName == "datasize")
 	{
 		string name = get<StringLiteral>(_call.arguments.at(0)).value;
 		// TODO: support the case where name refers to the current object
 		yulAssert(m_subModulePosAndSize.count(name), "");
-		return toBytes(Opcode::I64Const) + lebEncodeSigned(static_cast<int64_t>(m_subModulePosAndSize.at(name).second));
+		appendOpcode(m_out, Opcode::I64Const);
+		lebEncodeSignedTo(m_out, static_cast<int64_t>(m_subModulePosAndSize.at(name).second));
+		return;
 	}
 
 	yulAssert(builtins.count(_call.functionName), "Builtin " + _call.functionName + " not found");
 	// NOTE: the dialect ensures we have the right amount of arguments
-	bytes args = visit(_call.arguments);
-	bytes ret = move(args) + toBytes(builtins.at(_call.functionName));
+	visit(_call.arguments);
+	m_out.push_back(builtins.at(_call.functionName));
 	if (
 		_call.functionName.find(".load") != string::npos ||
 		_call.functionName.find(".store") != string::npos
@@ -387,103 +384,101 @@ bytes BinaryTransform::operator()(BuiltinCall const& _call)
 		// into account to generate more efficient code but if the hint is invalid it could
 		// actually be more expensive. It's best to hint at 1-byte alignment if we don't plan
 		// to control the memory layout accordingly.
-		ret += bytes{{0, 0}}; // 2^0 == 1-byte alignment
-
-	return ret;
+		m_out += bytes{{0, 0}}; // 2^0 == 1-byte alignment
 }
 
-bytes BinaryTransform::operator()(FunctionCall const& _call)
+void BinaryTransform::operator()(FunctionCall const& _call)
 {
-	return visit(_call.arguments) + toBytes(Opcode::Call) + lebEncode(m_functionIDs.at(_call.functionName));
+	visit(_call.arguments);
+	appendOpcode(m_out, Opcode::Call);
+	lebEncodeTo(m_out, m_functionIDs.at(_call.functionName));
 }
 
-bytes BinaryTransform::operator()(LocalAssignment const& _assignment)
+void BinaryTransform::operator()(LocalAssignment const& _assignment)
 {
-	return
-		std::visit(*this, *_assignment.value) +
-		toBytes(Opcode::LocalSet) +
-		lebEncode(m_locals.at(_assignment.variableName));
+	std::visit(*this, *_assignment.value);
+	appendOpcode(m_out, Opcode::LocalSet);
+	lebEncodeTo(m_out, m_locals.at(_assignment.variableName));
 }
 
-bytes BinaryTransform::operator()(GlobalAssignment const& _assignment)
+void BinaryTransform::operator()(GlobalAssignment const& _assignment)
 {
-	return
-		std::visit(*this, *_assignment.value) +
-		toBytes(Opcode::GlobalSet) +
-		lebEncode(m_globalIDs.at(_assignment.variableName));
+	std::visit(*this, *_assignment.value);
+	appendOpcode(m_out, Opcode::GlobalSet);
+	lebEncodeTo(m_out, m_globalIDs.at(_assignment.variableName));
 }
 
-bytes BinaryTransform::operator()(If const& _if)
+void BinaryTransform::operator()(If const& _if)
 {
-	bytes result =
-		std::visit(*this, *_if.condition) +
-		toBytes(Opcode::If) +
-		toBytes(ValueType::Void);
+	std::visit(*this, *_if.condition);
+	appendOpcode(m_out, Opcode::If);
+	m_out.push_back(uint8_t(ValueType::Void));
 
 	m_labels.emplace_back();
 
-	result += visit(_if.statements);
+	visit(_if.statements);
 	if (_if.elseStatements)
-		result += toBytes(Opcode::Else) + visit(*_if.elseStatements);
+	{
+		appendOpcode(m_out, Opcode::Else);
+		visit(*_if.elseStatements);
+	}
 
 	m_labels.pop_back();
 
-	result += toBytes(Opcode::End);
-	return result;
+	appendOpcode(m_out, Opcode::End);
 }
 
-bytes BinaryTransform::operator()(Loop const& _loop)
+void BinaryTransform::operator()(Loop const& _loop)
 {
-	bytes result = toBytes(Opcode::Loop) + toBytes(ValueType::Void);
+	appendOpcode(m_out, Opcode::Loop);
+	m_out.push_back(uint8_t(ValueType::Void));
 
 	m_labels.emplace_back(_loop.labelName);
-	result += visit(_loop.statements);
+	visit(_loop.statements);
 	m_labels.pop_back();
 
-	result += toBytes(Opcode::End);
-	return result;
+	appendOpcode(m_out, Opcode::End);
 }
 
-bytes BinaryTransform::operator()(Branch const& _branch)
+void BinaryTransform::operator()(Branch const& _branch)
 {
-	return toBytes(Opcode::Br) + encodeLabelIdx(_branch.label.name);
+	appendOpcode(m_out, Opcode::Br);
+	encodeLabelIdx(_branch.label.name);
 }
 
-bytes BinaryTransform::operator()(BranchIf const& _branchIf)
+void BinaryTransform::operator()(BranchIf const& _branchIf)
 {
-	bytes result = std::visit(*this, *_branchIf.condition);
-	result += toBytes(Opcode::BrIf) + encodeLabelIdx(_branchIf.label.name);
-	return result;
+	std::visit(*this, *_branchIf.condition);
+	appendOpcode(m_out, Opcode::BrIf);
+	encodeLabelIdx(_branchIf.label.name);
 }
 
-bytes BinaryTransform::operator()(Return const&)
+void BinaryTransform::operator()(Return const&)
 {
 	// Note that this does not work if the function returns a value.
-	return toBytes(Opcode::Return);
+	appendOpcode(m_out, Opcode::Return);
 }
 
-bytes BinaryTransform::operator()(Block const& _block)
+void BinaryTransform::operator()(Block const& _block)
 {
 	m_labels.emplace_back(_block.labelName);
-	bytes result =
-		toBytes(Opcode::Block) +
-		toBytes(ValueType::Void) +
-		visit(_block.statements) +
-		toBytes(Opcode::End);
+	appendOpcode(m_out, Opcode::Block);
+	m_out.push_back(uint8_t(ValueType::Void));
+	visit(_block.statements);
+	appendOpcode(m_out, Opcode::End);
 	m_labels.pop_back();
-	return result;
 }
 
-bytes BinaryTransform::operator()(FunctionDefinition const& _function)
+void BinaryTransform::operator()(FunctionDefinition const& _function)
 {
-	bytes ret;
+	size_t const start = m_out.size();
 
 	vector<pair<size_t, ValueType>> localEntries = groupLocalVariables(_function.locals);
-	ret += lebEncode(localEntries.size());
+	lebEncodeTo(m_out, localEntries.size());
 	for (pair<size_t, ValueType> const& entry: localEntries)
 	{
-		ret += lebEncode(entry.first);
-		ret += toBytes(entry.second);
+		lebEncodeTo(m_out, entry.first);
+		m_out.push_back(uint8_t(entry.second));
 	}
 
 	m_locals.clear();
@@ -495,12 +490,12 @@ bytes BinaryTransform::operator()(FunctionDefinition const& _function)
 
 	yulAssert(m_labels.empty(), "Stray labels.");
 
-	ret += visit(_function.body);
-	ret += toBytes(Opcode::End);
+	visit(_function.body);
+	appendOpcode(m_out, Opcode::End);
 
 	yulAssert(m_labels.empty(), "Stray labels.");
 
-	return prefixSize(move(ret));
+	insertSizePrefix(m_out, start);
 }
 
 BinaryTransform::Type BinaryTransform::typeOf(FunctionImport const& _import)
@@ -589,134 +584,146 @@ map<string, size_t> BinaryTransform::enumerateFunctionTypes(map<Type, vector<str
 	return functionTypes;
 }
 
-bytes BinaryTransform::typeSection(map<BinaryTransform::Type, vector<string>> const& _typeToFunctionMap)
+void BinaryTransform::typeSection(bytes& _out, map<BinaryTransform::Type, vector<string>> const& _typeToFunctionMap)
 {
-	bytes result;
-	size_t index = 0;
+	size_t const start = beginSection(_out, Section::TYPE);
+	lebEncodeTo(_out, _typeToFunctionMap.size());
 	for (Type const& type: _typeToFunctionMap | ranges::views::keys)
 	{
-		result += toBytes(ValueType::Function);
-		result += lebEncode(type.first.size()) + type.first;
-		result += lebEncode(type.second.size()) + type.second;
-
-		index++;
+		_out.push_back(uint8_t(ValueType::Function));
+		lebEncodeTo(_out, type.first.size());
+		_out += type.first;
+		lebEncodeTo(_out, type.second.size());
+		_out += type.second;
 	}
-
-	return makeSection(Section::TYPE, lebEncode(index) + move(result));
+	insertSizePrefix(_out, start);
 }
 
-bytes BinaryTransform::importSection(
+void BinaryTransform::importSection(
+	bytes& _out,
 	vector<FunctionImport> const& _imports,
 	map<string, size_t> const& _functionTypes
 )
 {
-	bytes result = lebEncode(_imports.size());
+	size_t const start = beginSection(_out, Section::IMPORT);
+	lebEncodeTo(_out, _imports.size());
 	for (FunctionImport const& import: _imports)
 	{
 		uint8_t importKind = 0; // function
-		result +=
-			encodeName(import.module) +
-			encodeName(import.externalName) +
-			toBytes(importKind) +
-			lebEncode(_functionTypes.at(import.internalName));
+		encodeName(_out, import.module);
+		encodeName(_out, import.externalName);
+		_out.push_back(importKind);
+		lebEncodeTo(_out, _functionTypes.at(import.internalName));
 	}
-	return makeSection(Section::IMPORT, move(result));
+	insertSizePrefix(_out, start);
 }
 
-bytes BinaryTransform::functionSection(
+void BinaryTransform::functionSection(
+	bytes& _out,
 	vector<FunctionDefinition> const& _functions,
 	map<string, size_t> const& _functionTypes
 )
 {
-	bytes result = lebEncode(_functions.size());
+	size_t const start = beginSection(_out, Section::FUNCTION);
+	lebEncodeTo(_out, _functions.size());
 	for (auto const& fun: _functions)
-		result += lebEncode(_functionTypes.at(fun.name));
-	return makeSection(Section::FUNCTION, move(result));
+		lebEncodeTo(_out, _functionTypes.at(fun.name));
+	insertSizePrefix(_out, start);
 }
 
-bytes BinaryTransform::memorySection()
+void BinaryTransform::memorySection(bytes& _out)
 {
-	bytes result = lebEncode(1);
-	result.push_back(static_cast<uint8_t>(LimitsKind::Min));
-	result.push_back(1); // initial length
-	return makeSection(Section::MEMORY, move(result));
+	size_t const start = beginSection(_out, Section::MEMORY);
+	lebEncodeTo(_out, 1);
+	_out.push_back(static_cast<uint8_t>(LimitsKind::Min));
+	_out.push_back(1); // initial length
+	insertSizePrefix(_out, start);
 }
 
-bytes BinaryTransform::globalSection(vector<wasm::GlobalVariableDeclaration> const& _globals)
+void BinaryTransform::globalSection(bytes& _out, vector<wasm::GlobalVariableDeclaration> const& _globals)
 {
-	bytes result = lebEncode(_globals.size());
+	size_t const start = beginSection(_out, Section::GLOBAL);
+	lebEncodeTo(_out, _globals.size());
 	for (wasm::GlobalVariableDeclaration const& global: _globals)
 	{
 		ValueType globalType = toValueType(global.type);
-		result +=
-			toBytes(globalType) +
-			lebEncode(static_cast<uint8_t>(Mutability::Var)) +
-			toBytes(constOpcodeFor(globalType)) +
-			lebEncodeSigned(0) +
-			toBytes(Opcode::End);
+		_out.push_back(uint8_t(globalType));
+		lebEncodeTo(_out, static_cast<uint8_t>(Mutability::Var));
+		appendOpcode(_out, constOpcodeFor(globalType));
+		lebEncodeSignedTo(_out, 0);
+		appendOpcode(_out, Opcode::End);
 	}
-
-	return makeSection(Section::GLOBAL, move(result));
+	insertSizePrefix(_out, start);
 }
 
-bytes BinaryTransform::exportSection(map<string, size_t> const& _functionIDs)
+void BinaryTransform::exportSection(bytes& _out, map<string, size_t> const& _functionIDs)
 {
 	bool hasMain = _functionIDs.count("main");
-	bytes result = lebEncode(hasMain ? 2 : 1);
-	result += encodeName("memory") + toBytes(Export::Memory) + lebEncode(0);
+	size_t const start = beginSection(_out, Section::EXPORT);
+	lebEncodeTo(_out, hasMain ? 2 : 1);
+	encodeName(_out, "memory");
+	_out.push_back(uint8_t(Export::Memory));
+	lebEncodeTo(_out, 0);
 	if (hasMain)
-		result += encodeName("main") + toBytes(Export::Function) + lebEncode(_functionIDs.at("main"));
-	return makeSection(Section::EXPORT, move(result));
+	{
+		encodeName(_out, "main");
+		_out.push_back(uint8_t(Export::Function));
+		lebEncodeTo(_out, _functionIDs.at("main"));
+	}
+	insertSizePrefix(_out, start);
 }
 
-bytes BinaryTransform::customSection(string const& _name, bytes _data)
+void BinaryTransform::customSection(bytes& _out, string const& _name, bytes const& _data)
 {
-	bytes result = encodeName(_name) + move(_data);
-	return makeSection(Section::CUSTOM, move(result));
+	size_t const start = beginSection(_out, Section::CUSTOM);
+	encodeName(_out, _name);
+	_out += _data;
+	insertSizePrefix(_out, start);
 }
 
-bytes BinaryTransform::codeSection(vector<wasm::FunctionDefinition> const& _functions)
+void BinaryTransform::codeSection(vector<wasm::FunctionDefinition> const& _functions)
 {
-	bytes result = lebEncode(_functions.size());
+	size_t const start = beginSection(m_out, Section::CODE);
+	lebEncodeTo(m_out, _functions.size());
 	for (FunctionDefinition const& fun: _functions)
-		result += (*this)(fun);
-	return makeSection(Section::CODE, move(result));
+		(*this)(fun);
+	insertSizePrefix(m_out, start);
 }
 
-bytes BinaryTransform::visit(vector<Expression> const& _expressions)
+void BinaryTransform::visit(vector<Expression> const& _expressions)
 {
-	bytes result;
 	for (auto const& expr: _expressions)
-		result += std::visit(*this, expr);
-	return result;
+		std::visit(*this, expr);
 }
 
-bytes BinaryTransform::visitReversed(vector<Expression> const& _expressions)
+void BinaryTransform::visitReversed(vector<Expression> const& _expressions)
 {
-	bytes result;
 	for (auto const& expr: _expressions | ranges::views::reverse)
-		result += std::visit(*this, expr);
-	return result;
+		std::visit(*this, expr);
 }
 
-bytes BinaryTransform::encodeLabelIdx(string const& _label) const
+void BinaryTransform::encodeLabelIdx(string const& _label)
 {
 	yulAssert(!_label.empty(), "Empty label.");
 	size_t depth = 0;
 	for (string const& label: m_labels | ranges::views::reverse)
 		if (label == _label)
-			return lebEncode(depth);
+		{
+			lebEncodeTo(m_out, depth);
+			return;
+		}
 		else
 			++depth;
 	yulAssert(false, "Label not found.");
 }
 
-bytes BinaryTransform::encodeName(string const& _name)
+void BinaryTransform::encodeName(bytes& _out, string const& _name)
 {
 	// UTF-8 is allowed here by the Wasm spec, but since all names here should stem from
 	// Solidity or Yul identifiers or similar, non-ascii characters ending up here
 	// is a very bad sign.
 	for (char c: _name)
 		yulAssert(uint8_t(c) <= 0x7f, "Non-ascii character found.");
-	return lebEncode(_name.size()) + asBytes(_name);
+	lebEncodeTo(_out, _name.size());
+	_out += asBytes(_name);
 }
@@ -39,29 +39,33 @@ class BinaryTransform
 public:
 	static bytes run(Module const& _module);
 
-	bytes operator()(wasm::Literal const& _literal);
-	bytes operator()(wasm::StringLiteral const& _literal);
-	bytes operator()(wasm::LocalVariable const& _identifier);
-	bytes operator()(wasm::GlobalVariable const& _identifier);
-	bytes operator()(wasm::BuiltinCall const& _builinCall);
-	bytes operator()(wasm::FunctionCall const& _functionCall);
-	bytes operator()(wasm::LocalAssignment const& _assignment);
-	bytes operator()(wasm::GlobalAssignment const& _assignment);
-	bytes operator()(wasm::If const& _if);
-	bytes operator()(wasm::Loop const& _loop);
-	bytes operator()(wasm::Branch const& _branch);
-	bytes operator()(wasm::BranchIf const& _branchIf);
-	bytes operator()(wasm::Return const& _return);
-	bytes operator()(wasm::Block const& _block);
-	bytes operator()(wasm::FunctionDefinition const& _function);
+	void operator()(wasm::Literal const& _literal);
+	void operator()(wasm::StringLiteral const& _literal);
+	void operator()(wasm::LocalVariable const& _identifier);
+	void operator()(wasm::GlobalVariable const& _identifier);
+	void operator()(wasm::BuiltinCall const& _builinCall);
+	void operator()(wasm::FunctionCall const& _functionCall);
+	void operator()(wasm::LocalAssignment const& _assignment);
+	void operator()(wasm::GlobalAssignment const& _assignment);
+	void operator()(wasm::If const& _if);
+	void operator()(wasm::Loop const& _loop);
+	void operator()(wasm::Branch const& _branch);
+	void operator()(wasm::BranchIf const& _branchIf);
+	void operator()(wasm::Return const& _return);
+	void operator()(wasm::Block const& _block);
+	void operator()(wasm::FunctionDefinition const& _function);
 
 private:
+	/// Creates a transform that appends the code to @a _out, which already contains
+	/// all sections preceding the code section.
 	BinaryTransform(
+		bytes& _out,
 		std::map<std::string, size_t> _globalIDs,
 		std::map<std::string, size_t> _functionIDs,
 		std::map<std::string, size_t> _functionTypes,
 		std::map<std::string, std::pair<size_t, size_t>> _subModulePosAndSize
 	):
+		m_out(_out),
 		m_globalIDs(std::move(_globalIDs)),
 		m_functionIDs(std::move(_functionIDs)),
 		m_functionTypes(std::move(_functionTypes)),
@@ -87,28 +91,34 @@ private:
 		std::map<Type, std::vector<std::string>> const& _typeToFunctionMap
 	);
 
-	static bytes typeSection(std::map<Type, std::vector<std::string>> const& _typeToFunctionMap);
-	static bytes importSection(
+	/// The section functions append the section to @a _out, including its size.
+	static void typeSection(bytes& _out, std::map<Type, std::vector<std::string>> const& _typeToFunctionMap);
+	static void importSection(
+		bytes& _out,
 		std::vector<wasm::FunctionImport> const& _imports,
 		std::map<std::string, size_t> const& _functionTypes
 	);
-	static bytes functionSection(
+	static void functionSection(
+		bytes& _out,
 		std::vector<wasm::FunctionDefinition> const& _functions,
 		std::map<std::string, size_t> const& _functionTypes
 	);
-	static bytes memorySection();
-	static bytes globalSection(std::vector<wasm::GlobalVariableDeclaration> const& _globals);
-	static bytes exportSection(std::map<std::string, size_t> const& _functionIDs);
-	static bytes customSection(std::string const& _name, bytes _data);
-	bytes codeSection(std::vector<wasm::FunctionDefinition> const& _functions);
+	static void memorySection(bytes& _out);
+	static void globalSection(bytes& _out, std::vector<wasm::GlobalVariableDeclaration> const& _globals);
+	static void exportSection(bytes& _out, std::map<std::string, size_t> const& _functionIDs);
+	static void customSection(bytes& _out, std::string const& _name, bytes const& _data);
+	void codeSection(std::vector<wasm::FunctionDefinition> const& _functions);
 
-	bytes visit(std::vector<wasm::Expression> const& _expressions);
-	bytes visitReversed(std::vector<wasm::Expression> const& _expressions);
+	void visit(std::vector<wasm::Expression> const& _expressions);
+	void visitReversed(std::vector<wasm::Expression> const& _expressions);
 
-	bytes encodeLabelIdx(std::string const& _label) const;
+	void encodeLabelIdx(std::string const& _label);
 
-	static bytes encodeName(std::string const& _name);
+	static void encodeName(bytes& _out, std::string const& _name);
 
+	/// The output everything is appended to. It contains the whole module, so that no
+	/// intermediate buffers have to be concatenated.
+	bytes& m_out;
 	std::map<std::string, size_t> const m_globalIDs;
 	std::map<std::string, size_t> const m_functionIDs;
 	std::map<std::string, size_t> const m_functionTypes;
@@ -31,6 +31,8 @@
 #include <libyul/optimiser/NameDisplacer.h>
 #include <libyul/optimiser/OptimiserStep.h>
 #include <libyul/optimiser/ForLoopConditionIntoBody.h>
+#include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/optimiser/NameCollector.h>
 
 #include <libyul/AST.h>
 #include <libyul/AsmParser.h>
@@ -45,6 +47,8 @@
 
 #include <libsolidity/interface/OptimiserSettings.h>
 
+#include <mutex>
+
 // The following headers are generated from the
 // yul files placed in libyul/backends/wasm/polyfill.
 
@@ -63,10 +67,17 @@ using namespace solidity::yul;
 using namespace solidity::util;
 using namespace solidity::langutil;
 
+struct EVMToEwasmTranslator::Polyfill
+{
+	std::shared_ptr<Block const> code;
+	std::set<YulString> functions;
+	/// The polyfill functions called by each polyfill function.
+	std::map<YulString, std::set<YulString>> callees;
+};
+
 Object EVMToEwasmTranslator::run(Object const& _object)
 {
-	if (!m_polyfill)
-		parsePolyfill();
+	Polyfill const& polyfill = EVMToEwasmTranslator::polyfill();
 
 	Block ast = std::get<Block>(Disambiguator(m_dialect, *_object.analysisInfo)(*_object.code));
 	set<YulString> reservedIdentifiers;
@@ -86,9 +97,24 @@ Object EVMToEwasmTranslator::run(Object const& _object)
 	ExpressionSplitter::run(context, ast);
 	WordSizeTransform::run(m_dialect, WasmDialect::instance(), ast, nameDispenser);
 
-	NameDisplacer{nameDispenser, m_polyfillFunctions}(ast);
-	for (auto const& st: m_polyfill->statements)
-		ast.statements.emplace_back(ASTCopier{}.translate(st));
+	NameDisplacer{nameDispenser, polyfill.functions}(ast);
+
+	// Only copy the polyfill functions that are reachable from the translated code.
+	set<YulString> usedFunctions;
+	vector<YulString> toVisit;
+	for (auto const& [name, count]: ReferencesCounter::countReferences(ast))
+		if (polyfill.functions.count(name))
+			toVisit.emplace_back(name);
+	while (!toVisit.empty())
+	{
+		YulString function = toVisit.back();
+		toVisit.pop_back();
+		if (usedFunctions.insert(function).second)
+			toVisit += polyfill.callees.at(function);
+	}
+	for (auto const& st: polyfill.code->statements)
+		if (usedFunctions.count(std::get<FunctionDefinition>(st).name))
+			ast.statements.emplace_back(ASTCopier{}.translate(st));
 
 	Object ret;
 	ret.name = _object.name;
@@ -122,7 +148,21 @@ Object EVMToEwasmTranslator::run(Object const& _object)
 	return ret;
 }
 
-void EVMToEwasmTranslator::parsePolyfill()
+EVMToEwasmTranslator::Polyfill const& EVMToEwasmTranslator::polyfill()
+{
+	static mutex polyfillMutex;
+	lock_guard<mutex> lock(polyfillMutex);
+	static unique_ptr<Polyfill const> polyfill;
+	static YulStringRepository::ResetCallback callback{[&] {
+		lock_guard<mutex> resetLock(polyfillMutex);
+		polyfill.reset();
+	}};
+	if (!polyfill)
+		polyfill = parsePolyfill();
+	return *polyfill;
+}
+
+unique_ptr<EVMToEwasmTranslator::Polyfill const> EVMToEwasmTranslator::parsePolyfill()
 {
 	ErrorList errors;
 	ErrorReporter errorReporter(errors);
@@ -141,7 +181,7 @@ void EVMToEwasmTranslator::parsePolyfill()
 	// Passing an empty SourceLocation() here is a workaround to prevent a crash
 	// when compiling from yul->ewasm. We're stripping nativeLocation and
 	// originLocation from the AST (but we only really need to strip nativeLocation)
-	m_polyfill = Parser(errorReporter, WasmDialect::instance(), langutil::SourceLocation()).parse(charStream);
+	shared_ptr<Block> code = Parser(errorReporter, WasmDialect::instance(), langutil::SourceLocation()).parse(charStream);
 	if (!errors.empty())
 	{
 		string message;
@@ -153,7 +193,16 @@ void EVMToEwasmTranslator::parsePolyfill()
 		yulAssert(false, message);
 	}
 
-	m_polyfillFunctions.clear();
-	for (auto const& statement: m_polyfill->statements)
-		m_polyfillFunctions.insert(std::get<FunctionDefinition>(statement).name);
+	auto polyfill = make_unique<Polyfill>();
+	for (auto const& statement: code->statements)
+		polyfill->functions.insert(std::get<FunctionDefinition>(statement).name);
+	for (auto const& [function, callees]: CallGraphGenerator::callGraph(*code).functionCalls)
+		if (polyfill->functions.count(function))
+			for (YulString callee: callees)
+				if (polyfill->functions.count(callee))
+					polyfill->callees[function].insert(callee);
+	for (YulString function: polyfill->functions)
+		polyfill->callees[function];
+	polyfill->code = move(code);
+	return polyfill;
 }
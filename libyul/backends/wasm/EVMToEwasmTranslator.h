@@ -43,13 +43,14 @@ public:
 	Object run(Object const& _object);
 
 private:
-	void parsePolyfill();
+	struct Polyfill;
+	/// @returns the polyfill library, which is only parsed once per process and shared by
+	/// all translations.
+	static Polyfill const& polyfill();
+	static std::unique_ptr<Polyfill const> parsePolyfill();
 
 	Dialect const& m_dialect;
 	langutil::CharStreamProvider const& m_charStreamProvider;
-
-	std::shared_ptr<Block> m_polyfill;
-	std::set<YulString> m_polyfillFunctions;
 };
 
 }
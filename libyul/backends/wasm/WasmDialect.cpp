@@ -24,6 +24,8 @@
 #include <libyul/AST.h>
 #include <libyul/Exceptions.h>
 
+#include <mutex>
+
 using namespace std;
 using namespace solidity::yul;
 
@@ -166,8 +168,13 @@ BuiltinFunction const* WasmDialect::equalityFunction(YulString _type) const
 
 WasmDialect const& WasmDialect::instance()
 {
+	static mutex dialectMutex;
+	lock_guard<mutex> lock(dialectMutex);
 	static std::unique_ptr<WasmDialect> dialect;
-	static YulStringRepository::ResetCallback callback{[&] { dialect.reset(); }};
+	static YulStringRepository::ResetCallback callback{[&] {
+		lock_guard<mutex> resetLock(dialectMutex);
+		dialect.reset();
+	}};
 	if (!dialect)
 		dialect = make_unique<WasmDialect>();
 	return *dialect;
@@ -52,7 +52,7 @@ wasm::Module WasmObjectCompiler::run(Object& _object)
 		if (Object* subObject = dynamic_cast<Object*>(subNode.get()))
 			module.subModules[subObject->name.str()] = run(*subObject);
 		else if (Data* subObject = dynamic_cast<Data*>(subNode.get()))
-			module.customSections[subObject->name.str()] = subObject->data;
+			module.customSections[subObject->name.str()] = *subObject->data;
 		else
 			yulAssert(false, "");
 
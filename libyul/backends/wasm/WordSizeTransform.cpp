@@ -20,10 +20,13 @@
 #include <libyul/backends/wasm/WordSizeTransform.h>
 #include <libyul/Utilities.h>
 #include <libyul/Dialect.h>
+#include <libyul/optimiser/ASTWalker.h>
 #include <libyul/optimiser/NameDisplacer.h>
 
 #include <libsolutil/CommonData.h>
 
+#include <range/v3/algorithm/any_of.hpp>
+
 #include <array>
 #include <map>
 #include <variant>
@@ -34,6 +37,135 @@ using namespace solidity;
 using namespace solidity::yul;
 using namespace solidity::util;
 
+namespace
+{
+
+/**
+ * Finds the local variables that only ever hold values fitting into 64 bits.
+ *
+ * A variable is narrow if it is only assigned literals fitting into 64 bits and other narrow
+ * variables, or if it is declared with the value of a comparison, of ``datasize`` or ``dataoffset``,
+ * or of an ``and`` with a narrow argument. All other variables including function parameters
+ * and return variables are considered wide.
+ *
+ * Prerequisite: Disambiguator, ExpressionSplitter
+ */
+class NarrowVariableFinder: public ASTWalker
+{
+public:
+	static set<YulString> run(Dialect const& _dialect, Block const& _ast)
+	{
+		NarrowVariableFinder finder{_dialect};
+		finder(_ast);
+		return finder.narrowVariables();
+	}
+
+	using ASTWalker::operator();
+	void operator()(FunctionDefinition const& _function) override
+	{
+		for (TypedName const& var: _function.parameters + _function.returnVariables)
+			m_wide.insert(var.name);
+		ASTWalker::operator()(_function);
+	}
+
+	void operator()(VariableDeclaration const& _varDecl) override
+	{
+		if (_varDecl.variables.size() != 1)
+			for (TypedName const& var: _varDecl.variables)
+				m_wide.insert(var.name);
+		else if (!_varDecl.value)
+			m_values[_varDecl.variables.front().name];
+		else if (
+			!holds_alternative<FunctionCall>(*_varDecl.value) ||
+			narrowBuiltin(std::get<FunctionCall>(*_varDecl.value))
+		)
+			m_values[_varDecl.variables.front().name].push_back(_varDecl.value.get());
+		else
+			m_wide.insert(_varDecl.variables.front().name);
+		ASTWalker::operator()(_varDecl);
+	}
+
+	void operator()(Assignment const& _assignment) override
+	{
+		// The calls assigned to a variable produce all four words, which are only
+		// declared if the variable was declared from a call.
+		if (_assignment.variableNames.size() == 1 && !holds_alternative<FunctionCall>(*_assignment.value))
+			m_values[_assignment.variableNames.front().name].push_back(_assignment.value.get());
+		else
+			for (Identifier const& var: _assignment.variableNames)
+				m_wide.insert(var.name);
+		ASTWalker::operator()(_assignment);
+	}
+
+private:
+	explicit NarrowVariableFinder(Dialect const& _dialect): m_dialect(_dialect) {}
+
+	bool narrowBuiltin(FunctionCall const& _call) const
+	{
+		static set<YulString> const narrowResults{
+			"lt"_yulstring, "gt"_yulstring, "slt"_yulstring, "sgt"_yulstring, "eq"_yulstring, "iszero"_yulstring,
+			"datasize"_yulstring, "dataoffset"_yulstring, "and"_yulstring
+		};
+		return m_dialect.builtin(_call.functionName.name) && narrowResults.count(_call.functionName.name);
+	}
+
+	bool narrow(Expression const& _value, set<YulString> const& _narrowVariables) const
+	{
+		if (Literal const* literal = get_if<Literal>(&_value))
+			return valueOfLiteral(*literal) <= numeric_limits<uint64_t>::max();
+		else if (Identifier const* identifier = get_if<Identifier>(&_value))
+			return _narrowVariables.count(identifier->name);
+		FunctionCall const& call = std::get<FunctionCall>(_value);
+		if (call.functionName.name == "and"_yulstring)
+			return ranges::any_of(call.arguments, [&](Expression const& _arg) { return narrow(_arg, _narrowVariables); });
+		return true;
+	}
+
+	/// Starts with all candidates and removes the ones with a value that is not narrow
+	/// until only narrow variables are left.
+	set<YulString> narrowVariables() const
+	{
+		set<YulString> narrowVariables;
+		map<YulString, vector<YulString>> users;
+		for (auto const& [name, values]: m_values)
+		{
+			if (m_wide.count(name))
+				continue;
+			narrowVariables.insert(name);
+			for (Expression const* value: values)
+				if (Identifier const* identifier = get_if<Identifier>(value))
+					users[identifier->name].push_back(name);
+				else if (FunctionCall const* call = get_if<FunctionCall>(value))
+					for (Expression const& arg: call->arguments)
+						if (Identifier const* argument = get_if<Identifier>(&arg))
+							users[argument->name].push_back(name);
+		}
+
+		vector<YulString> toCheck(narrowVariables.begin(), narrowVariables.end());
+		while (!toCheck.empty())
+		{
+			YulString name = toCheck.back();
+			toCheck.pop_back();
+			if (!narrowVariables.count(name))
+				continue;
+			for (Expression const* value: m_values.at(name))
+				if (!narrow(*value, narrowVariables))
+				{
+					narrowVariables.erase(name);
+					toCheck += users[name];
+					break;
+				}
+		}
+		return narrowVariables;
+	}
+
+	Dialect const& m_dialect;
+	map<YulString, vector<Expression const*>> m_values;
+	set<YulString> m_wide;
+};
+
+}
+
 void WordSizeTransform::operator()(FunctionDefinition& _fd)
 {
 	rewriteVarDeclList(_fd.parameters);
@@ -101,7 +233,7 @@ void WordSizeTransform::operator()(Block& _block)
 				VariableDeclaration& varDecl = std::get<VariableDeclaration>(_s);
 
 				if (!varDecl.value)
-					rewriteVarDeclList(varDecl.variables);
+					rewriteVarDeclList(varDecl.variables, true);
 				else if (holds_alternative<FunctionCall>(*varDecl.value))
 				{
 					visit(*varDecl.value);
@@ -115,17 +247,18 @@ void WordSizeTransform::operator()(Block& _block)
 							yulAssert(varDecl.variables.size() == 1, "");
 							auto newLhs = generateU64IdentifierNames(varDecl.variables[0].name);
 							vector<Statement> ret;
-							for (size_t i = 0; i < 3; i++)
-								ret.emplace_back(VariableDeclaration{
-									varDecl.debugData,
-									{TypedName{varDecl.debugData, newLhs[i], m_targetDialect.defaultType}},
-									make_unique<Expression>(Literal{
-										debugDataOf(*varDecl.value),
-										LiteralKind::Number,
-										"0"_yulstring,
-										m_targetDialect.defaultType
-									})
-								});
+							if (!m_narrowVariables.count(varDecl.variables[0].name))
+								for (size_t i = 0; i < 3; i++)
+									ret.emplace_back(VariableDeclaration{
+										varDecl.debugData,
+										{TypedName{varDecl.debugData, newLhs[i], m_targetDialect.defaultType}},
+										make_unique<Expression>(Literal{
+											debugDataOf(*varDecl.value),
+											LiteralKind::Number,
+											"0"_yulstring,
+											m_targetDialect.defaultType
+										})
+									});
 							ret.emplace_back(VariableDeclaration{
 								varDecl.debugData,
 								{TypedName{varDecl.debugData, newLhs[3], m_targetDialect.defaultType}},
@@ -146,7 +279,7 @@ void WordSizeTransform::operator()(Block& _block)
 					auto newRhs = expandValue(*varDecl.value);
 					auto newLhs = generateU64IdentifierNames(varDecl.variables[0].name);
 					vector<Statement> ret;
-					for (size_t i = 0; i < 4; i++)
+					for (size_t i = m_narrowVariables.count(varDecl.variables[0].name) ? 3 : 0; i < 4; i++)
 						ret.emplace_back(VariableDeclaration{
 								varDecl.debugData,
 								{TypedName{varDecl.debugData, newLhs[i], m_targetDialect.defaultType}},
@@ -207,7 +340,7 @@ void WordSizeTransform::operator()(Block& _block)
 					auto newRhs = expandValue(*assignment.value);
 					YulString lhsName = assignment.variableNames[0].name;
 					vector<Statement> ret;
-					for (size_t i = 0; i < 4; i++)
+					for (size_t i = m_narrowVariables.count(lhsName) ? 3 : 0; i < 4; i++)
 						ret.emplace_back(Assignment{
 								assignment.debugData,
 								{Identifier{assignment.debugData, m_variableMapping.at(lhsName)[i]}},
@@ -237,7 +370,9 @@ void WordSizeTransform::run(
 {
 	// Free the name `or_bool`.
 	NameDisplacer{_nameDispenser, {"or_bool"_yulstring}}(_ast);
-	WordSizeTransform{_inputDialect, _targetDialect, _nameDispenser}(_ast);
+	WordSizeTransform transform{_inputDialect, _targetDialect, _nameDispenser};
+	transform.m_narrowVariables = NarrowVariableFinder::run(_inputDialect, _ast);
+	transform(_ast);
 }
 
 WordSizeTransform::WordSizeTransform(
@@ -251,15 +386,16 @@ WordSizeTransform::WordSizeTransform(
 {
 }
 
-void WordSizeTransform::rewriteVarDeclList(TypedNameList& _nameList)
+void WordSizeTransform::rewriteVarDeclList(TypedNameList& _nameList, bool _onlyLowWordOfNarrow)
 {
 	iterateReplacing(
 		_nameList,
 		[&](TypedName const& _n) -> std::optional<TypedNameList>
 		{
 			TypedNameList ret;
-			for (auto newName: generateU64IdentifierNames(_n.name))
-				ret.emplace_back(TypedName{_n.debugData, newName, m_targetDialect.defaultType});
+			auto newNames = generateU64IdentifierNames(_n.name);
+			for (size_t i = _onlyLowWordOfNarrow && m_narrowVariables.count(_n.name) ? 3 : 0; i < 4; i++)
+				ret.emplace_back(TypedName{_n.debugData, newNames[i], m_targetDialect.defaultType});
 			return ret;
 		}
 	);
@@ -281,7 +417,7 @@ void WordSizeTransform::rewriteIdentifierList(vector<Identifier>& _ids)
 
 vector<Statement> WordSizeTransform::handleSwitchInternal(
 	shared_ptr<DebugData const> const& _debugData,
-	vector<YulString> const& _splitExpressions,
+	vector<Expression> const& _splitExpressions,
 	vector<Case> _cases,
 	YulString _runDefaultFlag,
 	size_t _depth
@@ -306,7 +442,7 @@ vector<Statement> WordSizeTransform::handleSwitchInternal(
 
 	Switch ret{
 		_debugData,
-		make_unique<Expression>(Identifier{_debugData, _splitExpressions.at(_depth)}),
+		make_unique<Expression>(_splitExpressions.at(_depth)),
 		{}
 	};
 
@@ -362,9 +498,7 @@ std::vector<Statement> WordSizeTransform::handleSwitch(Switch& _switch)
 			{}
 		});
 	}
-	vector<YulString> splitExpressions;
-	for (auto const& expr: expandValue(*_switch.expression))
-		splitExpressions.emplace_back(std::get<Identifier>(*expr).name);
+	vector<Expression> splitExpressions = expandValueToVector(*_switch.expression);
 
 	ret += handleSwitchInternal(
 		_switch.debugData,
@@ -398,7 +532,10 @@ array<unique_ptr<Expression>, 4> WordSizeTransform::expandValue(Expression const
 	{
 		auto const& id = std::get<Identifier>(_e);
 		for (size_t i = 0; i < 4; i++)
-			ret[i] = make_unique<Expression>(Identifier{id.debugData, m_variableMapping.at(id.name)[i]});
+			if (i < 3 && m_narrowVariables.count(id.name))
+				ret[i] = make_unique<Expression>(Literal{id.debugData, LiteralKind::Number, "0"_yulstring, m_targetDialect.defaultType});
+			else
+				ret[i] = make_unique<Expression>(Identifier{id.debugData, m_variableMapping.at(id.name)[i]});
 	}
 	else if (holds_alternative<Literal>(_e))
 	{
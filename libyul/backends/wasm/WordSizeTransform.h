@@ -27,6 +27,7 @@
 #include <liblangutil/SourceLocation.h>
 
 #include <array>
+#include <set>
 #include <vector>
 
 namespace solidity::yul
@@ -56,6 +57,10 @@ namespace solidity::yul
  * takes four u64 parameters and is supposed to return the logical disjunction
  * of them as a i32 value. If this name is already used somewhere, it is renamed.
  *
+ * Local variables whose values provably fit into 64 bits, e.g. flags set from comparisons
+ * or small constants, are only represented by their least significant word. The other
+ * words are replaced by zero wherever the variable is used.
+ *
  * Prerequisite: Disambiguator, ForLoopConditionIntoBody, ExpressionSplitter
  */
 class WordSizeTransform: public ASTModifier
@@ -82,13 +87,15 @@ private:
 		NameDispenser& _nameDispenser
 	);
 
-	void rewriteVarDeclList(std::vector<TypedName>&);
+	/// Replaces every variable by its four words or, if @a _onlyLowWordOfNarrow is set,
+	/// narrow variables by their least significant word only.
+	void rewriteVarDeclList(std::vector<TypedName>&, bool _onlyLowWordOfNarrow = false);
 	void rewriteIdentifierList(std::vector<Identifier>&);
 
 	std::vector<Statement> handleSwitch(Switch& _switch);
 	std::vector<Statement> handleSwitchInternal(
 		std::shared_ptr<DebugData const> const& _debugData,
-		std::vector<YulString> const& _splitExpressions,
+		std::vector<Expression> const& _splitExpressions,
 		std::vector<Case> _cases,
 		YulString _runDefaultFlag,
 		size_t _depth
@@ -103,6 +110,9 @@ private:
 	NameDispenser& m_nameDispenser;
 	/// maps original u256 variable's name to corresponding u64 variables' names
 	std::map<YulString, std::array<YulString, 4>> m_variableMapping;
+	/// Variables that always hold values fitting into 64 bits. Only their least significant word
+	/// is declared unless the variable is assigned from a function call.
+	std::set<YulString> m_narrowVariables;
 };
 
 }
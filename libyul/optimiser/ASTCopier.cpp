@@ -171,7 +171,7 @@ TypedName ASTCopier::translate(TypedName const& _typedName)
 
 YulString FunctionCopier::translateIdentifier(YulString _name)
 {
-	if (m_translations.count(_name))
-		return m_translations.at(_name);
+	if (auto it = m_translations.find(_name); it != m_translations.end())
+		return it->second;
 	return _name;
 }
@@ -0,0 +1,210 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/optimiser/ChangeTracker.h>
+
+#include <libyul/optimiser/NameDispenser.h>
+#include <libyul/AST.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+
+namespace
+{
+
+/// Serializes the AST such that two ASTs have the same serialization if and only if
+/// they are equal, including names and debug data.
+class Serializer
+{
+public:
+	explicit Serializer(ChangeTracker::Snapshot& _snapshot): m_snapshot(_snapshot) {}
+
+	enum class Tag: uint64_t
+	{
+		Literal, Identifier, FunctionCall, ExpressionStatement, Assignment, VariableDeclaration,
+		If, Switch, Case, FunctionDefinition, ForLoop, Break, Continue, Leave, Block
+	};
+
+	void operator()(Literal const& _literal)
+	{
+		node(Tag::Literal, _literal.debugData);
+		value(static_cast<uint64_t>(_literal.kind));
+		name(_literal.value);
+		name(_literal.type);
+	}
+	void operator()(Identifier const& _identifier)
+	{
+		node(Tag::Identifier, _identifier.debugData);
+		name(_identifier.name);
+	}
+	void operator()(FunctionCall const& _funCall)
+	{
+		node(Tag::FunctionCall, _funCall.debugData);
+		(*this)(_funCall.functionName);
+		value(_funCall.arguments.size());
+		for (Expression const& argument: _funCall.arguments)
+			visit(argument);
+	}
+	void operator()(ExpressionStatement const& _statement)
+	{
+		node(Tag::ExpressionStatement, _statement.debugData);
+		visit(_statement.expression);
+	}
+	void operator()(Assignment const& _assignment)
+	{
+		node(Tag::Assignment, _assignment.debugData);
+		value(_assignment.variableNames.size());
+		for (Identifier const& variable: _assignment.variableNames)
+			(*this)(variable);
+		optionalExpression(_assignment.value.get());
+	}
+	void operator()(VariableDeclaration const& _varDecl)
+	{
+		node(Tag::VariableDeclaration, _varDecl.debugData);
+		typedNames(_varDecl.variables);
+		optionalExpression(_varDecl.value.get());
+	}
+	void operator()(If const& _if)
+	{
+		node(Tag::If, _if.debugData);
+		optionalExpression(_if.condition.get());
+		(*this)(_if.body);
+	}
+	void operator()(Switch const& _switch)
+	{
+		node(Tag::Switch, _switch.debugData);
+		optionalExpression(_switch.expression.get());
+		value(_switch.cases.size());
+		for (Case const& switchCase: _switch.cases)
+		{
+			node(Tag::Case, switchCase.debugData);
+			value(switchCase.value ? 1 : 0);
+			if (switchCase.value)
+				(*this)(*switchCase.value);
+			(*this)(switchCase.body);
+		}
+	}
+	void operator()(FunctionDefinition const& _function)
+	{
+		node(Tag::FunctionDefinition, _function.debugData);
+		name(_function.name);
+		typedNames(_function.parameters);
+		typedNames(_function.returnVariables);
+		(*this)(_function.body);
+	}
+	void operator()(ForLoop const& _forLoop)
+	{
+		node(Tag::ForLoop, _forLoop.debugData);
+		(*this)(_forLoop.pre);
+		optionalExpression(_forLoop.condition.get());
+		(*this)(_forLoop.post);
+		(*this)(_forLoop.body);
+	}
+	void operator()(Break const& _break) { node(Tag::Break, _break.debugData); }
+	void operator()(Continue const& _continue) { node(Tag::Continue, _continue.debugData); }
+	void operator()(Leave const& _leave) { node(Tag::Leave, _leave.debugData); }
+	void operator()(Block const& _block)
+	{
+		node(Tag::Block, _block.debugData);
+		value(_block.statements.size());
+		for (Statement const& statement: _block.statements)
+			std::visit(*this, statement);
+	}
+
+private:
+	void visit(Expression const& _expression) { std::visit(*this, _expression); }
+	void optionalExpression(Expression const* _expression)
+	{
+		value(_expression ? 1 : 0);
+		if (_expression)
+			visit(*_expression);
+	}
+	void typedNames(TypedNameList const& _names)
+	{
+		value(_names.size());
+		for (TypedName const& typedName: _names)
+		{
+			debugData(typedName.debugData);
+			name(typedName.name);
+			name(typedName.type);
+		}
+	}
+	void node(Tag _tag, shared_ptr<DebugData const> const& _debugData)
+	{
+		value(static_cast<uint64_t>(_tag));
+		debugData(_debugData);
+	}
+	void debugData(shared_ptr<DebugData const> const& _debugData)
+	{
+		value(_debugData ? 1 : 0);
+		if (!_debugData)
+			return;
+		location(_debugData->nativeLocation);
+		location(_debugData->originLocation);
+		value(_debugData->astID ? 1 : 0);
+		if (_debugData->astID)
+			value(static_cast<uint64_t>(*_debugData->astID));
+	}
+	void location(langutil::SourceLocation const& _location)
+	{
+		// Source names are shared and not created by the optimiser, so their address identifies them.
+		value(reinterpret_cast<uintptr_t>(_location.sourceName.get()));
+		value(static_cast<uint64_t>(_location.start));
+		value(static_cast<uint64_t>(_location.end));
+	}
+	void value(uint64_t _value) { m_snapshot.values.emplace_back(_value); }
+	void name(YulString _name) { m_snapshot.names.emplace_back(_name); }
+
+	ChangeTracker::Snapshot& m_snapshot;
+};
+
+}
+
+ChangeTracker::ChangeTracker(Block const& _ast, NameDispenser& _dispenser):
+	m_snapshot(snapshot(_ast, _dispenser))
+{
+}
+
+bool ChangeTracker::unchanged(string const& _step) const
+{
+	auto it = m_unchangedAt.find(_step);
+	return it != m_unchangedAt.end() && it->second == m_generation;
+}
+
+bool ChangeTracker::stepRun(string const& _step, Block const& _ast, NameDispenser& _dispenser)
+{
+	Snapshot newSnapshot = snapshot(_ast, _dispenser);
+	if (newSnapshot == m_snapshot)
+	{
+		m_unchangedAt[_step] = m_generation;
+		return false;
+	}
+	m_snapshot = move(newSnapshot);
+	++m_generation;
+	return true;
+}
+
+ChangeTracker::Snapshot ChangeTracker::snapshot(Block const& _ast, NameDispenser& _dispenser)
+{
+	Snapshot result;
+	// The dispenser only ever adds names, so their number tells whether it was used.
+	result.values.emplace_back(_dispenser.usedNames().size());
+	Serializer{result}(_ast);
+	return result;
+}
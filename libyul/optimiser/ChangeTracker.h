@@ -0,0 +1,78 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Component that detects whether optimiser steps changed the code.
+ */
+
+#pragma once
+
+#include <libyul/ASTForward.h>
+#include <libyul/YulString.h>
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace solidity::yul
+{
+
+class NameDispenser;
+
+/**
+ * Keeps track of the changes optimiser steps make to an AST and to the name dispenser
+ * in order to find steps whose run would not change anything.
+ *
+ * Steps are deterministic, so a step that did not change the code and did not
+ * dispense any names will not do so again as long as no other step changed anything.
+ * Changes are detected by comparing an exact serialization of the AST, including the
+ * debug data, and the number of names used by the dispenser.
+ */
+class ChangeTracker
+{
+public:
+	ChangeTracker(Block const& _ast, NameDispenser& _dispenser);
+
+	/// @returns true if running @a _step would not change anything.
+	bool unchanged(std::string const& _step) const;
+	/// Records that @a _step was run, possibly changing @a _ast and @a _dispenser.
+	/// @returns true if the step changed anything.
+	bool stepRun(std::string const& _step, Block const& _ast, NameDispenser& _dispenser);
+
+	/// Serialization of an AST used to detect changes.
+	struct Snapshot
+	{
+		std::vector<std::uint64_t> values;
+		std::vector<YulString> names;
+
+		bool operator==(Snapshot const& _other) const
+		{
+			return values == _other.values && names == _other.names;
+		}
+	};
+	static Snapshot snapshot(Block const& _ast, NameDispenser& _dispenser);
+
+private:
+	Snapshot m_snapshot;
+	/// Incremented whenever a step changed anything.
+	size_t m_generation = 0;
+	/// Generation at which the steps were last run without changing anything.
+	std::map<std::string, size_t> m_unchangedAt;
+};
+
+}
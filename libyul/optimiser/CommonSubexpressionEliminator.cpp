@@ -22,8 +22,11 @@
 #include <libyul/optimiser/CommonSubexpressionEliminator.h>
 
 #include <libyul/optimiser/SyntacticalEquality.h>
-#include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/optimiser/BlockHasher.h>
 #include <libyul/optimiser/Semantics.h>
+#include <libyul/optimiser/SideEffectsCache.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/optimiser/OptimizerUtilities.h>
 #include <libyul/SideEffects.h>
 #include <libyul/Exceptions.h>
 #include <libyul/AST.h>
@@ -37,18 +40,18 @@ using namespace solidity::util;
 
 void CommonSubexpressionEliminator::run(OptimiserStepContext& _context, Block& _ast)
 {
-	CommonSubexpressionEliminator cse{
-		_context.dialect,
-		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast))
-	};
-	cse(_ast);
+	map<YulString, SideEffects> functionSideEffects =
+		SideEffectsCache::functionSideEffects(_context, _ast);
+	runOnFunctionsInParallel(_ast, _context.parallelism, [&]() {
+		return unique_ptr<ASTModifier>(new CommonSubexpressionEliminator{_context.dialect, functionSideEffects});
+	});
 }
 
 CommonSubexpressionEliminator::CommonSubexpressionEliminator(
 	Dialect const& _dialect,
 	map<YulString, SideEffects> _functionSideEffects
 ):
-	DataFlowAnalyzer(_dialect, std::move(_functionSideEffects))
+	DataFlowAnalyzer(_dialect, std::move(_functionSideEffects), ValueHashes::Track)
 {
 }
 
@@ -105,23 +108,25 @@ void CommonSubexpressionEliminator::visit(Expression& _e)
 	}
 	else
 	{
-		// TODO this search is rather inefficient.
-		for (auto const& [variable, value]: m_value)
-		{
-			assertThrow(value.value, OptimizerException, "");
-			// Prevent using the default value of return variables
-			// instead of literal zeros.
-			if (
-				m_returnVariables.count(variable) &&
-				holds_alternative<Literal>(*value.value) &&
-				valueOfLiteral(get<Literal>(*value.value)) == 0
-			)
-				continue;
-			if (SyntacticallyEqual{}(_e, *value.value) && inScope(variable))
+		// Only variables whose values have the same hash can be syntactically equal.
+		if (set<YulString> const* candidates = variablesWithValueHash(ExpressionHasher::run(_e)))
+			for (YulString variable: *candidates)
 			{
-				_e = Identifier{debugDataOf(_e), variable};
-				break;
+				Expression const* value = m_value.at(variable).value;
+				assertThrow(value, OptimizerException, "");
+				// Prevent using the default value of return variables
+				// instead of literal zeros.
+				if (
+					m_returnVariables.count(variable) &&
+					holds_alternative<Literal>(*value) &&
+					valueOfLiteral(get<Literal>(*value)) == 0
+				)
+					continue;
+				if (SyntacticallyEqual{}(_e, *value) && inScope(variable))
+				{
+					_e = Identifier{debugDataOf(_e), variable};
+					break;
+				}
 			}
-		}
 	}
 }
@@ -17,10 +17,10 @@
 // SPDX-License-Identifier: GPL-3.0
 #include <libyul/optimiser/ConditionalUnsimplifier.h>
 #include <libyul/optimiser/Semantics.h>
+#include <libyul/optimiser/SideEffectsCache.h>
 #include <libyul/AST.h>
 #include <libyul/Utilities.h>
 #include <libyul/optimiser/NameCollector.h>
-#include <libyul/ControlFlowSideEffectsCollector.h>
 #include <libsolutil/CommonData.h>
 
 using namespace std;
@@ -32,7 +32,7 @@ void ConditionalUnsimplifier::run(OptimiserStepContext& _context, Block& _ast)
 {
 	ConditionalUnsimplifier{
 		_context.dialect,
-		ControlFlowSideEffectsCollector{_context.dialect, _ast}.functionSideEffectsNamed()
+		SideEffectsCache::controlFlowSideEffects(_context, _ast)
 	}(_ast);
 }
 
@@ -22,6 +22,7 @@
 
 #include <libyul/optimiser/DataFlowAnalyzer.h>
 
+#include <libyul/optimiser/BlockHasher.h>
 #include <libyul/optimiser/NameCollector.h>
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/AST.h>
@@ -43,10 +44,14 @@ using namespace solidity::yul;
 
 DataFlowAnalyzer::DataFlowAnalyzer(
 	Dialect const& _dialect,
-	map<YulString, SideEffects> _functionSideEffects
+	map<YulString, SideEffects> _functionSideEffects,
+	ValueHashes _valueHashes,
+	map<YulString, set<u256>> _functionStorageWrites
 ):
 	m_dialect(_dialect),
 	m_functionSideEffects(std::move(_functionSideEffects)),
+	m_functionStorageWrites(std::move(_functionStorageWrites)),
+	m_trackValueHashes(_valueHashes == ValueHashes::Track),
 	m_knowledgeBase(_dialect, m_value)
 {
 	if (auto const* builtin = _dialect.memoryStoreFunction(YulString{}))
@@ -64,20 +69,20 @@ void DataFlowAnalyzer::operator()(ExpressionStatement& _statement)
 	if (auto vars = isSimpleStore(StoreLoadLocation::Storage, _statement))
 	{
 		ASTModifier::operator()(_statement);
-		cxx20::erase_if(m_storage, mapTuple([&](auto&& key, auto&& value) {
+		m_storage.eraseIf([&](YulString _key, YulString _value) {
 			return
-				!m_knowledgeBase.knownToBeDifferent(vars->first, key) &&
-				!m_knowledgeBase.knownToBeEqual(vars->second, value);
-		}));
-		m_storage[vars->first] = vars->second;
+				!m_knowledgeBase.knownToBeDifferent(vars->first, _key) &&
+				!m_knowledgeBase.knownToBeEqual(vars->second, _value);
+		});
+		m_storage.set(vars->first, vars->second);
 	}
 	else if (auto vars = isSimpleStore(StoreLoadLocation::Memory, _statement))
 	{
 		ASTModifier::operator()(_statement);
-		cxx20::erase_if(m_memory, mapTuple([&](auto&& key, auto&& /* value */) {
-			return !m_knowledgeBase.knownToBeDifferentByAtLeast32(vars->first, key);
-		}));
-		m_memory[vars->first] = vars->second;
+		m_memory.eraseIf([&](YulString _key, YulString /* _value */) {
+			return !m_knowledgeBase.knownToBeDifferentByAtLeast32(vars->first, _key);
+		});
+		m_memory.set(vars->first, vars->second);
 	}
 	else
 	{
@@ -116,12 +121,11 @@ void DataFlowAnalyzer::operator()(VariableDeclaration& _varDecl)
 void DataFlowAnalyzer::operator()(If& _if)
 {
 	clearKnowledgeIfInvalidated(*_if.condition);
-	unordered_map<YulString, YulString> storage = m_storage;
-	unordered_map<YulString, YulString> memory = m_memory;
+	branchKnowledge();
 
 	ASTModifier::operator()(_if);
 
-	joinKnowledge(storage, memory);
+	joinKnowledge();
 
 	clearValues(assignedVariableNames(_if.body));
 }
@@ -133,10 +137,9 @@ void DataFlowAnalyzer::operator()(Switch& _switch)
 	set<YulString> assignedVariables;
 	for (auto& _case: _switch.cases)
 	{
-		unordered_map<YulString, YulString> storage = m_storage;
-		unordered_map<YulString, YulString> memory = m_memory;
+		branchKnowledge();
 		(*this)(_case.body);
-		joinKnowledge(storage, memory);
+		joinKnowledge();
 
 		set<YulString> variables = assignedVariableNames(_case.body);
 		assignedVariables += variables;
@@ -154,10 +157,14 @@ void DataFlowAnalyzer::operator()(FunctionDefinition& _fun)
 	// Save all information. We might rather reinstantiate this class,
 	// but this could be difficult if it is subclassed.
 	ScopedSaveAndRestore valueResetter(m_value, {});
+	ScopedSaveAndRestore valueHashesResetter(m_valueHashes, {});
+	ScopedSaveAndRestore variablesByValueHashResetter(m_variablesByValueHash, {});
 	ScopedSaveAndRestore loopDepthResetter(m_loopDepth, 0u);
 	ScopedSaveAndRestore referencesResetter(m_references, {});
+	ScopedSaveAndRestore referencedByResetter(m_referencedBy, {});
 	ScopedSaveAndRestore storageResetter(m_storage, {});
 	ScopedSaveAndRestore memoryResetter(m_memory, {});
+	ScopedSaveAndRestore knownHashesResetter(m_knownHashes, {});
 	pushScope(true);
 
 	for (auto const& parameter: _fun.parameters)
@@ -242,17 +249,17 @@ void DataFlowAnalyzer::handleAssignment(set<YulString> const& _variables, Expres
 	auto const& referencedVariables = movableChecker.referencedVariables();
 	for (auto const& name: _variables)
 	{
-		m_references[name] = referencedVariables;
+		setReferences(name, referencedVariables);
 		if (!_isDeclaration)
 		{
 			// assignment to slot denoted by "name"
 			m_storage.erase(name);
 			// assignment to slot contents denoted by "name"
-			cxx20::erase_if(m_storage, mapTuple([&name](auto&& /* key */, auto&& value) { return value == name; }));
+			m_storage.eraseValue(name);
 			// assignment to slot denoted by "name"
 			m_memory.erase(name);
 			// assignment to slot contents denoted by "name"
-			cxx20::erase_if(m_memory, mapTuple([&name](auto&& /* key */, auto&& value) { return value == name; }));
+			m_memory.eraseValue(name);
 		}
 	}
 
@@ -265,9 +272,9 @@ void DataFlowAnalyzer::handleAssignment(set<YulString> const& _variables, Expres
 			// On the other hand, if we knew the value in the slot
 			// already, then the sload() / mload() would have been replaced by a variable anyway.
 			if (auto key = isSimpleLoad(StoreLoadLocation::Memory, *_value))
-				m_memory[*key] = variable;
+				m_memory.set(*key, variable);
 			else if (auto key = isSimpleLoad(StoreLoadLocation::Storage, *_value))
-				m_storage[*key] = variable;
+				m_storage.set(*key, variable);
 		}
 	}
 }
@@ -281,8 +288,8 @@ void DataFlowAnalyzer::popScope()
 {
 	for (auto const& name: m_variableScopes.back().variables)
 	{
-		m_value.erase(name);
-		m_references.erase(name);
+		clearValue(name);
+		eraseReferences(name);
 	}
 	m_variableScopes.pop_back();
 }
@@ -305,29 +312,96 @@ void DataFlowAnalyzer::clearValues(set<YulString> _variables)
 	// First clear storage knowledge, because we do not have to clear
 	// storage knowledge of variables whose expression has changed,
 	// since the value is still unchanged.
-	auto eraseCondition = mapTuple([&_variables](auto&& key, auto&& value) {
-		return _variables.count(key) || _variables.count(value);
-	});
-	cxx20::erase_if(m_storage, eraseCondition);
-	cxx20::erase_if(m_memory, eraseCondition);
+	for (auto const& name: _variables)
+	{
+		m_storage.erase(name);
+		m_storage.eraseValue(name);
+		m_memory.erase(name);
+		m_memory.eraseValue(name);
+	}
+	if (!m_knownHashes.empty())
+		cxx20::erase_if(m_knownHashes, [&](auto const& _entry) {
+			return
+				_variables.count(_entry.second) ||
+				util::contains_if(_entry.first.first, [&](YulString _word) { return _variables.count(_word); });
+		});
 
 	// Also clear variables that reference variables to be cleared.
 	for (auto const& variableToClear: _variables)
-		for (auto const& [ref, names]: m_references)
-			if (names.count(variableToClear))
+		if (auto const* referencingVariables = valueOrNullptr(m_referencedBy, variableToClear))
+			for (auto const& ref: *referencingVariables)
 				_variables.emplace(ref);
 
 	// Clear the value and update the reference relation.
 	for (auto const& name: _variables)
 	{
-		m_value.erase(name);
-		m_references.erase(name);
+		clearValue(name);
+		eraseReferences(name);
 	}
 }
 
+void DataFlowAnalyzer::setReferences(YulString _variable, set<YulString> const& _references)
+{
+	eraseReferences(_variable);
+	for (auto const& referencedVariable: _references)
+		m_referencedBy[referencedVariable].insert(_variable);
+	m_references[_variable] = _references;
+}
+
+void DataFlowAnalyzer::eraseReferences(YulString _variable)
+{
+	auto references = m_references.find(_variable);
+	if (references == m_references.end())
+		return;
+	for (auto const& referencedVariable: references->second)
+	{
+		auto referencingVariables = m_referencedBy.find(referencedVariable);
+		referencingVariables->second.erase(_variable);
+		if (referencingVariables->second.empty())
+			m_referencedBy.erase(referencingVariables);
+	}
+	m_references.erase(references);
+}
+
 void DataFlowAnalyzer::assignValue(YulString _variable, Expression const* _value)
 {
 	m_value[_variable] = {_value, m_loopDepth};
+	if (m_trackValueHashes)
+	{
+		uint64_t hash = ExpressionHasher::run(*_value);
+		auto [it, inserted] = m_valueHashes.emplace(_variable, hash);
+		if (!inserted)
+		{
+			eraseValueHash(_variable, it->second);
+			it->second = hash;
+		}
+		m_variablesByValueHash[hash].insert(_variable);
+	}
+}
+
+void DataFlowAnalyzer::clearValue(YulString _variable)
+{
+	m_value.erase(_variable);
+	if (m_trackValueHashes)
+		if (auto it = m_valueHashes.find(_variable); it != m_valueHashes.end())
+		{
+			eraseValueHash(_variable, it->second);
+			m_valueHashes.erase(it);
+		}
+}
+
+set<YulString> const* DataFlowAnalyzer::variablesWithValueHash(uint64_t _hash) const
+{
+	yulAssert(m_trackValueHashes, "");
+	return valueOrNullptr(m_variablesByValueHash, _hash);
+}
+
+void DataFlowAnalyzer::eraseValueHash(YulString _variable, uint64_t _hash)
+{
+	auto variables = m_variablesByValueHash.find(_hash);
+	variables->second.erase(_variable);
+	if (variables->second.empty())
+		m_variablesByValueHash.erase(variables);
 }
 
 void DataFlowAnalyzer::clearKnowledgeIfInvalidated(Block const& _block)
@@ -343,33 +417,36 @@ void DataFlowAnalyzer::clearKnowledgeIfInvalidated(Expression const& _expr)
 {
 	SideEffectsCollector sideEffects(m_dialect, _expr, &m_functionSideEffects);
 	if (sideEffects.invalidatesStorage())
-		m_storage.clear();
+	{
+		optional<set<u256>> writtenSlots;
+		if (!m_functionStorageWrites.empty())
+			writtenSlots = StorageWriteCollector::writtenSlots(m_dialect, _expr, m_functionStorageWrites);
+		if (writtenSlots)
+			m_storage.eraseIf([&](YulString _key, YulString /* _value */) {
+				optional<u256> slot = m_knowledgeBase.valueIfKnownConstant(_key);
+				return !slot || writtenSlots->count(*slot);
+			});
+		else
+			m_storage.clear();
+	}
 	if (sideEffects.invalidatesMemory())
 		m_memory.clear();
 }
 
-void DataFlowAnalyzer::joinKnowledge(
-	unordered_map<YulString, YulString> const& _olderStorage,
-	unordered_map<YulString, YulString> const& _olderMemory
-)
+void DataFlowAnalyzer::branchKnowledge()
 {
-	joinKnowledgeHelper(m_storage, _olderStorage);
-	joinKnowledgeHelper(m_memory, _olderMemory);
+	m_storage.branch();
+	m_memory.branch();
 }
 
-void DataFlowAnalyzer::joinKnowledgeHelper(
-	std::unordered_map<YulString, YulString>& _this,
-	std::unordered_map<YulString, YulString> const& _older
-)
+void DataFlowAnalyzer::joinKnowledge()
 {
-	// We clear if the key does not exist in the older map or if the value is different.
-	// This also works for memory because _older is an "older version"
+	// We clear if the key did not exist at the branch point or if the value is different.
+	// This also works for memory because the state at the branch point is an "older version"
 	// of m_memory and thus any overlapping write would have cleared the keys
 	// that are not known to be different inside m_memory already.
-	cxx20::erase_if(_this, mapTuple([&_older](auto&& key, auto&& currentValue){
-		YulString const* oldValue = valueOrNullptr(_older, key);
-		return !oldValue || *oldValue != currentValue;
-	}));
+	m_storage.join();
+	m_memory.join();
 }
 
 bool DataFlowAnalyzer::inScope(YulString _variableName) const
@@ -24,6 +24,7 @@
 #pragma once
 
 #include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/JournaledNameMap.h>
 #include <libyul/optimiser/KnowledgeBase.h>
 #include <libyul/YulString.h>
 #include <libyul/AST.h> // Needed for m_zero below.
@@ -33,6 +34,8 @@
 
 #include <map>
 #include <set>
+#include <unordered_map>
+#include <vector>
 
 namespace solidity::yul
 {
@@ -63,6 +66,8 @@ struct AssignedValue
  *   where we cannot prove x != t or y == m_storage[t] using the current values of the variables x and t.
  * Otherwise, determine if the statement invalidates storage/memory. If yes, clear all knowledge
  * about storage/memory before visiting the statement. Then visit the statement.
+ * If the storage slots written by the called functions are known, only the knowledge about the
+ * slots that are not known to be different from them is cleared.
  *
  * For forward-joining control flow, storage/memory information from the branches is combined.
  * If the keys or values are different or non-existent in one branch, the key is deleted.
@@ -79,13 +84,24 @@ struct AssignedValue
 class DataFlowAnalyzer: public ASTModifier
 {
 public:
+	/// Whether the variables are also indexed by the hashes of their values.
+	enum class ValueHashes { Ignore, Track };
+
 	/// @param _functionSideEffects
 	///            Side-effects of user-defined functions. Worst-case side-effects are assumed
 	///            if this is not provided or the function is not found.
 	///            The parameter is mostly used to determine movability of expressions.
+	/// @param _valueHashes
+	///            If set to Track, variablesWithValueHash() can be used to find the variables
+	///            whose values are likely syntactically equal to an expression.
+	/// @param _functionStorageWrites
+	///            Storage slots written by user-defined functions, as determined by
+	///            StorageWriteCollector. Calls to functions not listed invalidate all of storage.
 	explicit DataFlowAnalyzer(
 		Dialect const& _dialect,
-		std::map<YulString, SideEffects> _functionSideEffects = {}
+		std::map<YulString, SideEffects> _functionSideEffects = {},
+		ValueHashes _valueHashes = ValueHashes::Ignore,
+		std::map<YulString, std::set<u256>> _functionStorageWrites = {}
 	);
 
 	using ASTModifier::operator();
@@ -113,6 +129,20 @@ protected:
 	void clearValues(std::set<YulString> _names);
 
 	void assignValue(YulString _variable, Expression const* _value);
+	/// Removes the value of @a _variable from m_value.
+	void clearValue(YulString _variable);
+
+	/// @returns the variables whose values have the hash @a _hash (see ExpressionHasher),
+	/// or nullptr if there are none.
+	/// Requires the hashes to be tracked.
+	std::set<YulString> const* variablesWithValueHash(uint64_t _hash) const;
+
+	/// Sets the variables referenced by the value of @a _variable, keeping m_referencedBy in sync.
+	void setReferences(YulString _variable, std::set<YulString> const& _references);
+	/// Removes @a _variable from m_references, keeping m_referencedBy in sync.
+	void eraseReferences(YulString _variable);
+	/// Removes @a _variable from the entry of @a _hash in m_variablesByValueHash.
+	void eraseValueHash(YulString _variable, uint64_t _hash);
 
 	/// Clears knowledge about storage or memory if they may be modified inside the block.
 	void clearKnowledgeIfInvalidated(Block const& _block);
@@ -120,18 +150,15 @@ protected:
 	/// Clears knowledge about storage or memory if they may be modified inside the expression.
 	void clearKnowledgeIfInvalidated(Expression const& _expression);
 
-	/// Joins knowledge about storage and memory with an older point in the control-flow.
-	/// This only works if the current state is a direct successor of the older point,
-	/// i.e. `_otherStorage` and `_otherMemory` cannot have additional changes.
-	void joinKnowledge(
-		std::unordered_map<YulString, YulString> const& _olderStorage,
-		std::unordered_map<YulString, YulString> const& _olderMemory
-	);
+	/// Marks the current point in the control-flow as the one the knowledge about storage
+	/// and memory is joined with by the matching call to joinKnowledge().
+	/// This is constant-time, the changes made after this point are recorded instead.
+	void branchKnowledge();
 
-	static void joinKnowledgeHelper(
-		std::unordered_map<YulString, YulString>& _thisData,
-		std::unordered_map<YulString, YulString> const& _olderData
-	);
+	/// Joins knowledge about storage and memory with the point of the matching
+	/// call to branchKnowledge(). This only works if the current state is a direct
+	/// successor of that point. Only the keys changed since then are considered.
+	void joinKnowledge();
 
 	/// Returns true iff the variable is in scope.
 	bool inScope(YulString _variableName) const;
@@ -163,14 +190,30 @@ protected:
 	/// Side-effects of user-defined functions. Worst-case side-effects are assumed
 	/// if this is not provided or the function is not found.
 	std::map<YulString, SideEffects> m_functionSideEffects;
+	/// Storage slots written by user-defined functions, if known.
+	std::map<YulString, std::set<u256>> m_functionStorageWrites;
 
 	/// Current values of variables, always movable.
-	std::map<YulString, AssignedValue> m_value;
+	std::unordered_map<YulString, AssignedValue> m_value;
+	bool const m_trackValueHashes = false;
+	/// Hashes of the current values of variables, if they are tracked.
+	std::unordered_map<YulString, uint64_t> m_valueHashes;
+	/// Reverse of m_valueHashes.
+	std::unordered_map<uint64_t, std::set<YulString>> m_variablesByValueHash;
 	/// m_references[a].contains(b) <=> the current expression assigned to a references b
 	std::unordered_map<YulString, std::set<YulString>> m_references;
-
-	std::unordered_map<YulString, YulString> m_storage;
-	std::unordered_map<YulString, YulString> m_memory;
+	/// Reverse of m_references: m_referencedBy[b].contains(a) <=> m_references[a].contains(b)
+	std::unordered_map<YulString, std::set<YulString>> m_referencedBy;
+
+	JournaledNameMap m_storage;
+	JournaledNameMap m_memory;
+
+	/// Memory contents hashed by ``keccak256``: The variables holding the hashed words, the last of
+	/// which may only be hashed in part, and the number of bytes.
+	using HashedContent = std::pair<std::vector<YulString>, u256>;
+	/// Variables known to hold the hash of the given contents. Since this only depends on the values
+	/// of variables, it is kept when memory is written to. Only filled by the LoadResolver.
+	std::map<HashedContent, YulString> m_knownHashes;
 
 	KnowledgeBase m_knowledgeBase;
 
@@ -22,9 +22,9 @@
 
 #include <libyul/optimiser/EqualStoreEliminator.h>
 
-#include <libyul/optimiser/CallGraphGenerator.h>
 #include <libyul/optimiser/OptimizerUtilities.h>
 #include <libyul/optimiser/Semantics.h>
+#include <libyul/optimiser/SideEffectsCache.h>
 #include <libyul/AST.h>
 #include <libyul/Utilities.h>
 
@@ -38,7 +38,7 @@ void EqualStoreEliminator::run(OptimiserStepContext const& _context, Block& _ast
 {
 	EqualStoreEliminator eliminator{
 		_context.dialect,
-		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast))
+		SideEffectsCache::functionSideEffects(_context, _ast)
 	};
 	eliminator(_ast);
 
@@ -54,13 +54,13 @@ void EqualStoreEliminator::visit(Statement& _statement)
 	{
 		if (auto vars = isSimpleStore(StoreLoadLocation::Storage, *expression))
 		{
-			if (auto const* currentValue = valueOrNullptr(m_storage, vars->first))
+			if (auto const* currentValue = m_storage.get(vars->first))
 				if (*currentValue == vars->second)
 					m_pendingRemovals.insert(&_statement);
 		}
 		else if (auto vars = isSimpleStore(StoreLoadLocation::Memory, *expression))
 		{
-			if (auto const* currentValue = valueOrNullptr(m_memory, vars->first))
+			if (auto const* currentValue = m_memory.get(vars->first))
 				if (*currentValue == vars->second)
 					m_pendingRemovals.insert(&_statement);
 		}
@@ -23,7 +23,14 @@
 #include <libyul/optimiser/SyntacticalEquality.h>
 
 #include <libyul/AST.h>
+#include <libyul/Dialect.h>
+#include <libyul/Object.h>
 #include <libyul/optimiser/Metrics.h>
+#include <libyul/optimiser/NameCollector.h>
+
+#include <libsolutil/CommonData.h>
+
+#include <algorithm>
 
 using namespace std;
 using namespace solidity;
@@ -41,3 +48,123 @@ void EquivalentFunctionDetector::operator()(FunctionDefinition const& _fun)
 		}
 	candidates.push_back(&_fun);
 }
+
+namespace
+{
+
+void collectObjects(Object const& _object, string const& _prefix, vector<pair<string, Object const*>>& _objects)
+{
+	string name = _prefix.empty() ? _object.name.str() : _prefix + "." + _object.name.str();
+	_objects.emplace_back(name, &_object);
+	for (auto const& subNode: _object.subObjects)
+		if (auto const* subObject = dynamic_cast<Object const*>(subNode.get()))
+			collectObjects(*subObject, name, _objects);
+}
+
+}
+
+vector<vector<CrossObjectEquivalentFunctionDetector::Function>> CrossObjectEquivalentFunctionDetector::run(
+	Dialect const& _dialect,
+	Object const& _object
+)
+{
+	vector<pair<string, Object const*>> objects;
+	collectObjects(_object, "", objects);
+
+	struct Entry
+	{
+		size_t object = 0;
+		FunctionDefinition const* definition = nullptr;
+		/// The entries of the called functions by their names.
+		map<YulString, size_t> callees;
+		/// Whether the function accesses the data or immutables of its object.
+		bool objectSpecific = false;
+	};
+	vector<Entry> entries;
+	vector<map<Block const*, uint64_t>> blockHashes(objects.size());
+	for (size_t objectIndex = 0; objectIndex < objects.size(); ++objectIndex)
+	{
+		Object const& object = *objects[objectIndex].second;
+		if (!object.code)
+			continue;
+		blockHashes[objectIndex] = BlockHasher::run(*object.code);
+		map<YulString, FunctionDefinition const*> functions = allFunctionDefinitions(*object.code);
+		map<YulString, size_t> entryByName;
+		for (auto const& [name, function]: functions)
+		{
+			entryByName[name] = entries.size();
+			entries.push_back(Entry{objectIndex, function, {}, false});
+		}
+		for (auto const& [name, function]: functions)
+		{
+			Entry& entry = entries[entryByName.at(name)];
+			for (auto const& [reference, count]: ReferencesCounter::countReferences(*function))
+				if (BuiltinFunction const* builtin = _dialect.builtin(reference))
+					entry.objectSpecific = entry.objectSpecific || !builtin->literalArguments.empty();
+				else if (size_t const* callee = util::valueOrNullptr(entryByName, reference))
+					entry.callees[reference] = *callee;
+		}
+	}
+
+	// Initially, the functions are grouped by syntactical equality.
+	vector<size_t> classes(entries.size());
+	size_t classCount = 0;
+	map<uint64_t, vector<size_t>> candidates;
+	for (size_t i = 0; i < entries.size(); ++i)
+	{
+		Entry const& entry = entries[i];
+		if (entry.objectSpecific)
+		{
+			classes[i] = classCount++;
+			continue;
+		}
+		vector<size_t>& representatives = candidates[blockHashes[entry.object].at(&entry.definition->body)];
+		auto representative = find_if(representatives.begin(), representatives.end(), [&](size_t _other) {
+			return SyntacticallyEqual{}.statementEqual(*entry.definition, *entries[_other].definition);
+		});
+		if (representative != representatives.end())
+			classes[i] = classes[*representative];
+		else
+		{
+			classes[i] = classCount++;
+			representatives.push_back(i);
+		}
+	}
+
+	// The groups are split by the groups of the called functions until no group is split anymore.
+	// Functions that only call each other stay in the same group.
+	while (true)
+	{
+		map<pair<size_t, vector<size_t>>, size_t> newClassIds;
+		vector<size_t> newClasses(entries.size());
+		for (size_t i = 0; i < entries.size(); ++i)
+		{
+			vector<size_t> calleeClasses;
+			for (auto const& [name, callee]: entries[i].callees)
+				calleeClasses.push_back(classes[callee]);
+			size_t const nextId = newClassIds.size();
+			newClasses[i] = newClassIds.emplace(make_pair(classes[i], move(calleeClasses)), nextId).first->second;
+		}
+		bool const stable = newClassIds.size() == classCount;
+		classes = move(newClasses);
+		classCount = newClassIds.size();
+		if (stable)
+			break;
+	}
+
+	// The groups are numbered in the order of their first function.
+	vector<vector<size_t>> members(classCount);
+	for (size_t i = 0; i < entries.size(); ++i)
+		members[classes[i]].push_back(i);
+	vector<vector<Function>> groups;
+	for (vector<size_t> const& group: members)
+	{
+		size_t const firstObject = entries[group.front()].object;
+		if (all_of(group.begin(), group.end(), [&](size_t _i) { return entries[_i].object == firstObject; }))
+			continue;
+		vector<Function>& functions = groups.emplace_back();
+		for (size_t i: group)
+			functions.push_back(Function{objects[entries[i].object].first, entries[i].definition});
+	}
+	return groups;
+}
@@ -24,8 +24,13 @@
 #include <libyul/optimiser/BlockHasher.h>
 #include <libyul/ASTForward.h>
 
+#include <string>
+#include <vector>
+
 namespace solidity::yul
 {
+struct Dialect;
+struct Object;
 
 /**
  * Optimiser component that detects syntactically equivalent functions.
@@ -53,5 +58,35 @@ private:
 	std::map<YulString, FunctionDefinition const*> m_duplicates;
 };
 
+/**
+ * Detects syntactically equivalent functions in different objects of an object tree, e.g. in
+ * the runtime objects of several contracts deployed by the same factory.
+ *
+ * Unlike within one block, the names of the called functions refer to different functions in
+ * different objects, so functions are only considered equivalent if the functions they call are
+ * equivalent as well. Functions calling builtins with literal arguments, like ``datasize`` or
+ * ``loadimmutable``, are never considered equivalent, since these refer to the data and
+ * immutables of their objects.
+ *
+ * The code of an object cannot call a function of another object, so the functions found are
+ * only reported and not combined.
+ *
+ * Prerequisite: Disambiguator
+ */
+class CrossObjectEquivalentFunctionDetector
+{
+public:
+	struct Function
+	{
+		/// The qualified name of the object the function is defined in, e.g. ``A.A_deployed``.
+		std::string object;
+		FunctionDefinition const* definition = nullptr;
+	};
+
+	/// @returns the groups of equivalent functions of @a _object and its sub objects that are
+	/// defined in at least two different objects, ordered by object and function name.
+	static std::vector<std::vector<Function>> run(Dialect const& _dialect, Object const& _object);
+};
+
 
 }
@@ -23,6 +23,7 @@
 
 #include <libyul/optimiser/SimplificationRules.h>
 #include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/optimiser/OptimizerUtilities.h>
 #include <libyul/AST.h>
 
 using namespace std;
@@ -31,7 +32,9 @@ using namespace solidity::yul;
 
 void ExpressionSimplifier::run(OptimiserStepContext& _context, Block& _ast)
 {
-	ExpressionSimplifier{_context.dialect}(_ast);
+	runOnFunctionsInParallel(_ast, _context.parallelism, [&]() {
+		return unique_ptr<ASTModifier>(new ExpressionSimplifier{_context.dialect});
+	});
 }
 
 void ExpressionSimplifier::visit(Expression& _expression)
@@ -57,7 +57,7 @@ FullInliner::FullInliner(Block& _ast, NameDispenser& _dispenser, Dialect const&
 
 	// Store size of global statements.
 	m_functionSizes[YulString{}] = CodeSize::codeSize(_ast);
-	map<YulString, size_t> references = ReferencesCounter::countReferences(m_ast);
+	unordered_map<YulString, size_t> references = ReferencesCounter::countReferences(m_ast);
 	for (auto& statement: m_ast.statements)
 	{
 		if (!holds_alternative<FunctionDefinition>(statement))
@@ -71,6 +71,13 @@ FullInliner::FullInliner(Block& _ast, NameDispenser& _dispenser, Dialect const&
 			m_singleUse.emplace(fun.name);
 		updateCodeSize(fun);
 	}
+	for (auto const& [name, fun]: m_functions)
+	{
+		map<YulString, size_t>& functionReferences = m_functionReferences[name];
+		for (auto const& [referencedName, count]: ReferencesCounter::countReferences(*fun))
+			if (m_functions.count(referencedName))
+				functionReferences[referencedName] = count;
+	}
 }
 
 void FullInliner::run(Pass _pass)
@@ -204,6 +211,18 @@ void FullInliner::tentativelyUpdateCodeSize(YulString _function, YulString _call
 	m_functionSizes.at(_callSite) += m_functionSizes.at(_function);
 }
 
+void FullInliner::updateFunctionReferences(YulString _function, YulString _callSite)
+{
+	auto callSiteReferences = m_functionReferences.find(_callSite);
+	if (callSiteReferences == m_functionReferences.end())
+		return;
+	map<YulString, size_t>& references = callSiteReferences->second;
+	yulAssert(references[_function] > 0, "");
+	--references[_function];
+	for (auto const& [referencedName, count]: m_functionReferences.at(_function))
+		references[referencedName] += count;
+}
+
 void FullInliner::updateCodeSize(FunctionDefinition const& _fun)
 {
 	m_functionSizes[_fun.name] = CodeSize::codeSize(_fun.body);
@@ -216,8 +235,9 @@ void FullInliner::handleBlock(YulString _currentFunctionName, Block& _block)
 
 bool FullInliner::recursive(FunctionDefinition const& _fun) const
 {
-	map<YulString, size_t> references = ReferencesCounter::countReferences(_fun);
-	return references[_fun.name] > 0;
+	map<YulString, size_t> const& references = m_functionReferences.at(_fun.name);
+	auto it = references.find(_fun.name);
+	return it != references.end() && it->second > 0;
 }
 
 void InlineModifier::operator()(Block& _block)
@@ -260,6 +280,13 @@ vector<Statement> InlineModifier::performInline(Statement& _statement, FunctionC
 	assertThrow(!!function, OptimizerException, "Attempt to inline invalid function.");
 
 	m_driver.tentativelyUpdateCodeSize(function->name, m_currentFunction);
+	m_driver.updateFunctionReferences(function->name, m_currentFunction);
+
+	newStatements.reserve(
+		function->parameters.size() +
+		2 * function->returnVariables.size() +
+		function->body.statements.size()
+	);
 
 	// helper function to create a new variable that is supposed to model
 	// an existing variable.
@@ -279,8 +306,8 @@ vector<Statement> InlineModifier::performInline(Statement& _statement, FunctionC
 	for (auto const& var: function->returnVariables)
 		newVariable(var, nullptr);
 
-	Statement newBody = BodyCopier(m_nameDispenser, variableReplacements)(function->body);
-	newStatements += std::move(std::get<Block>(newBody).statements);
+	Block newBody = BodyCopier(m_nameDispenser, variableReplacements).translate(function->body);
+	newStatements += std::move(newBody.statements);
 
 	std::visit(util::GenericVisitor{
 		util::VisitorFallback<>{},
@@ -328,8 +355,8 @@ Statement BodyCopier::operator()(FunctionDefinition const&)
 
 YulString BodyCopier::translateIdentifier(YulString _name)
 {
-	if (m_variableReplacements.count(_name))
-		return m_variableReplacements.at(_name);
+	if (auto it = m_variableReplacements.find(_name); it != m_variableReplacements.end())
+		return it->second;
 	else
 		return _name;
 }
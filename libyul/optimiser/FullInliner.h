@@ -90,6 +90,10 @@ public:
 	/// should be determined after inlining is completed.
 	void tentativelyUpdateCodeSize(YulString _function, YulString _callSite);
 
+	/// Records that a call to _function inside _callSite is replaced by the body
+	/// of _function, in order to keep track of recursive functions.
+	void updateFunctionReferences(YulString _function, YulString _callSite);
+
 private:
 	enum Pass { InlineTiny, InlineRest };
 
@@ -116,6 +120,10 @@ private:
 	/// Variables that are constants (used for inlining heuristic)
 	std::set<YulString> m_constants;
 	std::map<YulString, size_t> m_functionSizes;
+	/// Number of references to each function from within each function (including itself).
+	/// Maintained during inlining, so that checking for recursion does not have to
+	/// walk the function body.
+	std::map<YulString, std::map<YulString, size_t>> m_functionReferences;
 	NameDispenser& m_nameDispenser;
 	Dialect const& m_dialect;
 };
@@ -45,10 +45,11 @@ public:
 
 	void operator()(Block& _block);
 
+	/// @returns true if @a _block is already of the form established by this step.
+	static bool alreadyGrouped(Block const& _block);
+
 private:
 	FunctionGrouper() = default;
-
-	bool alreadyGrouped(Block const& _block);
 };
 
 }
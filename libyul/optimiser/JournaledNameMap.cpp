@@ -0,0 +1,132 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Map between names that can be joined with an older version of itself.
+ */
+
+#include <libyul/optimiser/JournaledNameMap.h>
+
+#include <libyul/Exceptions.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+
+YulString const* JournaledNameMap::get(YulString _key) const
+{
+	auto it = m_values.find(_key);
+	return it == m_values.end() ? nullptr : &it->second;
+}
+
+void JournaledNameMap::set(YulString _key, YulString _value)
+{
+	auto it = m_values.find(_key);
+	if (it == m_values.end())
+	{
+		record(_key, nullopt);
+		m_values.emplace(_key, _value);
+		m_keysByValue[_value].insert(_key);
+	}
+	else if (it->second != _value)
+	{
+		record(_key, it->second);
+		removeFromIndex(_key, it->second);
+		it->second = _value;
+		m_keysByValue[_value].insert(_key);
+	}
+}
+
+void JournaledNameMap::erase(YulString _key)
+{
+	auto it = m_values.find(_key);
+	if (it != m_values.end())
+	{
+		record(_key, it->second);
+		removeFromIndex(_key, it->second);
+		m_values.erase(it);
+	}
+}
+
+void JournaledNameMap::eraseValue(YulString _value)
+{
+	auto keys = m_keysByValue.find(_value);
+	if (keys == m_keysByValue.end())
+		return;
+	for (YulString key: keys->second)
+	{
+		record(key, _value);
+		m_values.erase(key);
+	}
+	m_keysByValue.erase(keys);
+}
+
+void JournaledNameMap::clear()
+{
+	if (!m_branchStarts.empty())
+		for (auto const& [key, value]: m_values)
+			record(key, value);
+	m_values.clear();
+	m_keysByValue.clear();
+}
+
+void JournaledNameMap::branch()
+{
+	m_branchStarts.push_back(m_journal.size());
+}
+
+void JournaledNameMap::join()
+{
+	yulAssert(!m_branchStarts.empty(), "No branch to join.");
+	size_t start = m_branchStarts.back();
+	m_branchStarts.pop_back();
+	if (start == m_journal.size())
+		return;
+
+	// The first entry of a key since the start of the branch contains its value at that point.
+	unordered_map<YulString, optional<YulString>> valuesAtStart;
+	for (size_t i = start; i < m_journal.size(); ++i)
+		valuesAtStart.emplace(m_journal[i].first, m_journal[i].second);
+	m_journal.erase(m_journal.begin() + static_cast<ptrdiff_t>(start), m_journal.end());
+
+	for (auto const& [key, valueAtStart]: valuesAtStart)
+	{
+		// The enclosing branches only need the oldest value.
+		record(key, valueAtStart);
+		auto it = m_values.find(key);
+		if (it != m_values.end() && (!valueAtStart || *valueAtStart != it->second))
+		{
+			removeFromIndex(it->first, it->second);
+			m_values.erase(it);
+		}
+	}
+}
+
+void JournaledNameMap::record(YulString _key, optional<YulString> _oldValue)
+{
+	if (!m_branchStarts.empty())
+		m_journal.emplace_back(_key, move(_oldValue));
+}
+
+void JournaledNameMap::removeFromIndex(YulString _key, YulString _value)
+{
+	auto keys = m_keysByValue.find(_value);
+	yulAssert(keys != m_keysByValue.end(), "");
+	keys->second.erase(_key);
+	if (keys->second.empty())
+		m_keysByValue.erase(keys);
+}
@@ -0,0 +1,102 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Map between names that can be joined with an older version of itself.
+ */
+
+#pragma once
+
+#include <libyul/YulString.h>
+
+#include <optional>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace solidity::yul
+{
+
+/**
+ * Map from names to names that records the changes made since the start of every open branch
+ * instead of copying its contents there.
+ *
+ * Starting a branch is constant-time and ending it only looks at the keys that were
+ * changed inside the branch: A key is kept if and only if it has the same value as at
+ * the start of the branch, as if the map was joined with a copy taken at that point.
+ *
+ * The keys are also indexed by their values, so that removing all entries with a given value
+ * does not have to look at the other entries.
+ */
+class JournaledNameMap
+{
+public:
+	/// @returns the value of @a _key or nullptr if it is not present.
+	YulString const* get(YulString _key) const;
+	bool empty() const { return m_values.empty(); }
+
+	void set(YulString _key, YulString _value);
+	void erase(YulString _key);
+	/// Removes all entries whose value is @a _value.
+	void eraseValue(YulString _value);
+	void clear();
+
+	/// Removes all entries for which @a _predicate returns true when called with their key and value.
+	template <typename Predicate>
+	void eraseIf(Predicate const& _predicate)
+	{
+		for (auto it = m_values.begin(); it != m_values.end();)
+			if (_predicate(it->first, it->second))
+			{
+				record(it->first, it->second);
+				removeFromIndex(it->first, it->second);
+				it = m_values.erase(it);
+			}
+			else
+				++it;
+	}
+
+	/// Calls @a _visitor with the key and value of every entry.
+	template <typename Visitor>
+	void forEach(Visitor const& _visitor) const
+	{
+		for (auto const& [key, value]: m_values)
+			_visitor(key, value);
+	}
+
+	/// Starts a branch, i.e. a point in the control flow the current state is later joined with.
+	void branch();
+	/// Ends the innermost branch and removes the entries whose value differs from the one they had
+	/// at its start or that were not present then.
+	void join();
+
+private:
+	/// Records that @a _key is about to be changed from @a _oldValue, if a branch is open.
+	void record(YulString _key, std::optional<YulString> _oldValue);
+	void removeFromIndex(YulString _key, YulString _value);
+
+	std::unordered_map<YulString, YulString> m_values;
+	/// m_keysByValue[v].contains(k) <=> m_values[k] == v
+	std::unordered_map<YulString, std::set<YulString>> m_keysByValue;
+	/// Keys changed since the start of the outermost open branch, together with their previous values.
+	std::vector<std::pair<YulString, std::optional<YulString>>> m_journal;
+	/// Position in m_journal at which each open branch started.
+	std::vector<size_t> m_branchStarts;
+};
+
+}
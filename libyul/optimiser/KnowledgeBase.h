@@ -27,7 +27,7 @@
 #include <libsolutil/Common.h>
 #include <libsolutil/Numeric.h>
 
-#include <map>
+#include <unordered_map>
 
 namespace solidity::yul
 {
@@ -43,7 +43,7 @@ struct AssignedValue;
 class KnowledgeBase
 {
 public:
-	KnowledgeBase(Dialect const& _dialect, std::map<YulString, AssignedValue> const& _variableValues):
+	KnowledgeBase(Dialect const& _dialect, std::unordered_map<YulString, AssignedValue> const& _variableValues):
 		m_dialect(_dialect),
 		m_variableValues(_variableValues)
 	{}
@@ -60,7 +60,7 @@ private:
 	Expression simplifyRecursively(Expression _expression);
 
 	Dialect const& m_dialect;
-	std::map<YulString, AssignedValue> const& m_variableValues;
+	std::unordered_map<YulString, AssignedValue> const& m_variableValues;
 	size_t m_counter = 0;
 };
 
@@ -25,7 +25,9 @@
 #include <libyul/backends/evm/EVMDialect.h>
 #include <libyul/backends/evm/EVMMetrics.h>
 #include <libyul/optimiser/Semantics.h>
-#include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/optimiser/SideEffectsCache.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/optimiser/OptimizerUtilities.h>
 #include <libyul/SideEffects.h>
 #include <libyul/AST.h>
 #include <libyul/Utilities.h>
@@ -44,12 +46,18 @@ using namespace solidity::yul;
 void LoadResolver::run(OptimiserStepContext& _context, Block& _ast)
 {
 	bool containsMSize = MSizeFinder::containsMSize(_context.dialect, _ast);
-	LoadResolver{
-		_context.dialect,
-		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast)),
-		containsMSize,
-		_context.expectedExecutionsPerDeployment
-	}(_ast);
+	map<YulString, SideEffects> functionSideEffects =
+		SideEffectsCache::functionSideEffects(_context, _ast);
+	map<YulString, set<u256>> functionStorageWrites = StorageWriteCollector::writtenSlots(_context.dialect, _ast);
+	runOnFunctionsInParallel(_ast, _context.parallelism, [&]() {
+		return unique_ptr<ASTModifier>(new LoadResolver{
+			_context.dialect,
+			functionSideEffects,
+			functionStorageWrites,
+			containsMSize,
+			_context.expectedExecutionsPerDeployment
+		});
+	});
 }
 
 void LoadResolver::visit(Expression& _e)
@@ -66,10 +74,26 @@ void LoadResolver::visit(Expression& _e)
 			}
 
 		if (!m_containsMSize && funCall->functionName.name == m_dialect.hashFunction({}))
+		{
 			tryEvaluateKeccak(_e, funCall->arguments);
+			if (holds_alternative<FunctionCall>(_e))
+				tryResolveKeccak(_e, funCall->arguments);
+		}
 	}
 }
 
+void LoadResolver::operator()(VariableDeclaration& _varDecl)
+{
+	DataFlowAnalyzer::operator()(_varDecl);
+
+	if (m_containsMSize || _varDecl.variables.size() != 1 || !_varDecl.value)
+		return;
+	if (FunctionCall const* funCall = get_if<FunctionCall>(_varDecl.value.get()))
+		if (funCall->functionName.name == m_dialect.hashFunction({}))
+			if (optional<HashedContent> content = hashedContent(funCall->arguments))
+				m_knownHashes[move(*content)] = _varDecl.variables.front().name;
+}
+
 void LoadResolver::tryResolve(
 	Expression& _e,
 	StoreLoadLocation _location,
@@ -82,16 +106,63 @@ void LoadResolver::tryResolve(
 	YulString key = std::get<Identifier>(_arguments.at(0)).name;
 	if (_location == StoreLoadLocation::Storage)
 	{
-		if (auto value = util::valueOrNullptr(m_storage, key))
+		if (auto value = m_storage.get(key))
 			if (inScope(*value))
 				_e = Identifier{debugDataOf(_e), *value};
 	}
 	else if (!m_containsMSize && _location == StoreLoadLocation::Memory)
-		if (auto value = util::valueOrNullptr(m_memory, key))
+		if (auto value = m_memory.get(key))
 			if (inScope(*value))
 				_e = Identifier{debugDataOf(_e), *value};
 }
 
+void LoadResolver::tryResolveKeccak(
+	Expression& _e,
+	vector<Expression> const& _arguments
+)
+{
+	if (m_knownHashes.empty())
+		return;
+	if (optional<HashedContent> content = hashedContent(_arguments))
+		if (YulString const* hash = util::valueOrNullptr(m_knownHashes, *content))
+			if (inScope(*hash))
+				_e = Identifier{debugDataOf(_e), *hash};
+}
+
+optional<LoadResolver::HashedContent> LoadResolver::hashedContent(vector<Expression> const& _arguments)
+{
+	yulAssert(_arguments.size() == 2, "");
+	Identifier const* memoryKey = std::get_if<Identifier>(&_arguments.at(0));
+	Identifier const* length = std::get_if<Identifier>(&_arguments.at(1));
+	if (!memoryKey || !length)
+		return nullopt;
+
+	optional<u256> byteLength = valueOfIdentifier(length->name);
+	if (!byteLength || *byteLength == 0 || *byteLength > 32 * maxHashedWords)
+		return nullopt;
+	size_t wordCount = static_cast<size_t>((*byteLength + 31) / 32);
+
+	vector<optional<YulString>> words(wordCount);
+	if (YulString const* value = m_memory.get(memoryKey->name))
+		words.front() = *value;
+	if (optional<u256> start = valueOfIdentifier(memoryKey->name))
+		// The other words can only be found through keys with constant values.
+		m_memory.forEach([&](YulString _key, YulString _value) {
+			if (optional<u256> offset = valueOfIdentifier(_key))
+				if (*offset >= *start && (*offset - *start) % 32 == 0 && (*offset - *start) / 32 < wordCount)
+					words[static_cast<size_t>((*offset - *start) / 32)] = _value;
+		});
+
+	HashedContent content{{}, *byteLength};
+	for (optional<YulString> const& word: words)
+	{
+		if (!word)
+			return nullopt;
+		content.first.emplace_back(*word);
+	}
+	return content;
+}
+
 void LoadResolver::tryEvaluateKeccak(
 	Expression& _e,
 	std::vector<Expression> const& _arguments
@@ -129,7 +200,7 @@ void LoadResolver::tryEvaluateKeccak(
 	if (costOfLiteral > costOfKeccak)
 		return;
 
-	auto memoryValue = util::valueOrNullptr(m_memory, memoryKey->name);
+	auto memoryValue = m_memory.get(memoryKey->name);
 	if (memoryValue && inScope(*memoryValue))
 	{
 		optional<u256> memoryContent = valueOfIdentifier(*memoryValue);
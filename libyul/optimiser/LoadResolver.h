@@ -35,6 +35,12 @@ namespace solidity::yul
  * Also evaluates simple ``keccak256(a, c)`` when the value at memory location `a` is known and `c`
  * is a constant `<= 32`.
  *
+ * Variables declared as ``keccak256(a, c)`` are recorded together with the variables known to
+ * be stored in the hashed memory words, if `c` is a constant and `a` is a constant or the word at
+ * `a` is the only one hashed. A later ``keccak256`` call over words known to hold the same variables
+ * is replaced by the recorded variable, even if memory was written to in between, e.g. when
+ * computing the slot of the same mapping element several times.
+ *
  * Works best if the code is in SSA form.
  *
  * Prerequisite: Disambiguator, ForLoopInitRewriter.
@@ -50,15 +56,23 @@ private:
 	LoadResolver(
 		Dialect const& _dialect,
 		std::map<YulString, SideEffects> _functionSideEffects,
+		std::map<YulString, std::set<u256>> _functionStorageWrites,
 		bool _containsMSize,
 		std::optional<size_t> _expectedExecutionsPerDeployment
 	):
-		DataFlowAnalyzer(_dialect, std::move(_functionSideEffects)),
+		DataFlowAnalyzer(
+			_dialect,
+			std::move(_functionSideEffects),
+			ValueHashes::Ignore,
+			std::move(_functionStorageWrites)
+		),
 		m_containsMSize(_containsMSize),
 		m_expectedExecutionsPerDeployment(std::move(_expectedExecutionsPerDeployment))
 	{}
 
 protected:
+	using ASTModifier::operator();
+	void operator()(VariableDeclaration& _varDecl) override;
 	using ASTModifier::visit;
 	void visit(Expression& _e) override;
 
@@ -75,6 +89,18 @@ protected:
 		std::vector<Expression> const& _arguments
 	);
 
+	/// Replaces ``keccak256(a, c)`` by a variable known to hold the hash of the same contents.
+	void tryResolveKeccak(
+		Expression& _e,
+		std::vector<Expression> const& _arguments
+	);
+
+	/// @returns the variables stored in the memory words hashed by ``keccak256(a, c)`` and the
+	/// number of bytes, if they are known and at most ``maxHashedWords`` words are hashed.
+	std::optional<HashedContent> hashedContent(std::vector<Expression> const& _arguments);
+
+	static size_t constexpr maxHashedWords = 4;
+
 	/// If the AST contains `msize`, then we skip resolving `mload` and `keccak256`.
 	bool m_containsMSize = false;
 	/// The --optimize-runs parameter. Value `nullopt` represents creation code.
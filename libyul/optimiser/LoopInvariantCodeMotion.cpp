@@ -18,11 +18,13 @@
 
 #include <libyul/optimiser/LoopInvariantCodeMotion.h>
 
-#include <libyul/optimiser/CallGraphGenerator.h>
 #include <libyul/optimiser/NameCollector.h>
 #include <libyul/optimiser/Semantics.h>
+#include <libyul/optimiser/SideEffectsCache.h>
 #include <libyul/optimiser/SSAValueTracker.h>
 #include <libyul/AST.h>
+#include <libyul/Dialect.h>
+#include <libyul/Utilities.h>
 #include <libsolutil/CommonData.h>
 
 #include <utility>
@@ -34,10 +36,28 @@ using namespace solidity::yul;
 void LoopInvariantCodeMotion::run(OptimiserStepContext& _context, Block& _ast)
 {
 	map<YulString, SideEffects> functionSideEffects =
-		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast));
+		SideEffectsCache::functionSideEffects(_context, _ast);
 	bool containsMSize = MSizeFinder::containsMSize(_context.dialect, _ast);
-	set<YulString> ssaVars = SSAValueTracker::ssaVariables(_ast);
-	LoopInvariantCodeMotion{_context.dialect, ssaVars, functionSideEffects, containsMSize}(_ast);
+	SSAValueTracker ssaValues;
+	ssaValues(_ast);
+	set<YulString> ssaVars;
+	map<YulString, u256> ssaConstants;
+	for (auto const& [name, value]: ssaValues.values())
+	{
+		ssaVars.insert(name);
+		if (Literal const* literal = get_if<Literal>(value))
+			ssaConstants[name] = valueOfLiteral(*literal);
+	}
+	map<YulString, set<u256>> functionStorageWrites =
+		StorageWriteCollector::writtenSlots(_context.dialect, _ast);
+	LoopInvariantCodeMotion{
+		_context.dialect,
+		ssaVars,
+		functionSideEffects,
+		ssaConstants,
+		functionStorageWrites,
+		containsMSize
+	}(_ast);
 }
 
 void LoopInvariantCodeMotion::operator()(Block& _block)
@@ -58,7 +78,8 @@ void LoopInvariantCodeMotion::operator()(Block& _block)
 bool LoopInvariantCodeMotion::canBePromoted(
 	VariableDeclaration const& _varDecl,
 	set<YulString> const& _varsDefinedInCurrentScope,
-	SideEffects const& _forLoopSideEffects
+	SideEffects const& _forLoopSideEffects,
+	optional<set<u256>> const& _forLoopStorageWrites
 ) const
 {
 	// A declaration can be promoted iff
@@ -74,19 +95,55 @@ bool LoopInvariantCodeMotion::canBePromoted(
 		for (auto const& ref: ReferencesCounter::countReferences(*_varDecl.value, ReferencesCounter::OnlyVariables))
 			if (_varsDefinedInCurrentScope.count(ref.first) || !m_ssaVariables.count(ref.first))
 				return false;
+		SideEffects forLoopSideEffects = _forLoopSideEffects;
+		// The loop does not write the slot read by the declaration.
+		if (
+			forLoopSideEffects.storage == SideEffects::Write &&
+			loadsUnwrittenStorageSlot(*_varDecl.value, _forLoopStorageWrites)
+		)
+			forLoopSideEffects.storage = SideEffects::Read;
 		SideEffectsCollector sideEffects{m_dialect, *_varDecl.value, &m_functionSideEffects};
-		if (!sideEffects.movableRelativeTo(_forLoopSideEffects, m_containsMSize))
+		if (!sideEffects.movableRelativeTo(forLoopSideEffects, m_containsMSize))
 			return false;
 	}
 	return true;
 }
 
+bool LoopInvariantCodeMotion::loadsUnwrittenStorageSlot(
+	Expression const& _expression,
+	optional<set<u256>> const& _forLoopStorageWrites
+) const
+{
+	if (!_forLoopStorageWrites)
+		return false;
+	BuiltinFunction const* loadFunction = m_dialect.storageLoadFunction(YulString{});
+	FunctionCall const* funCall = get_if<FunctionCall>(&_expression);
+	if (!loadFunction || !funCall || funCall->functionName.name != loadFunction->name)
+		return false;
+
+	optional<u256> slot;
+	if (Literal const* literal = get_if<Literal>(&funCall->arguments.front()))
+		slot = valueOfLiteral(*literal);
+	else if (Identifier const* identifier = get_if<Identifier>(&funCall->arguments.front()))
+		if (m_ssaConstants.count(identifier->name))
+			slot = m_ssaConstants.at(identifier->name);
+	return slot && !_forLoopStorageWrites->count(*slot);
+}
+
 optional<vector<Statement>> LoopInvariantCodeMotion::rewriteLoop(ForLoop& _for)
 {
 	assertThrow(_for.pre.statements.empty(), OptimizerException, "");
 
 	auto forLoopSideEffects =
 		SideEffectsCollector{m_dialect, _for, &m_functionSideEffects}.sideEffects();
+	optional<set<u256>> forLoopStorageWrites;
+	if (forLoopSideEffects.storage == SideEffects::Write)
+		forLoopStorageWrites = StorageWriteCollector::writtenSlots(
+			m_dialect,
+			_for,
+			m_functionStorageWrites,
+			m_ssaConstants
+		);
 
 	vector<Statement> replacement;
 	for (Block* block: {&_for.post, &_for.body})
@@ -99,7 +156,7 @@ optional<vector<Statement>> LoopInvariantCodeMotion::rewriteLoop(ForLoop& _for)
 				if (holds_alternative<VariableDeclaration>(_s))
 				{
 					VariableDeclaration const& varDecl = std::get<VariableDeclaration>(_s);
-					if (canBePromoted(varDecl, varsDefinedInScope, forLoopSideEffects))
+					if (canBePromoted(varDecl, varsDefinedInScope, forLoopSideEffects, forLoopStorageWrites))
 					{
 						replacement.emplace_back(std::move(_s));
 						// Do not add the variables declared here to varsDefinedInScope because we are moving them.
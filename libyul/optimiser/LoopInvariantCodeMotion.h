@@ -29,6 +29,9 @@ namespace solidity::yul
  *
  * This optimization moves movable SSA variable declarations outside the loop.
  *
+ * Loads from constant storage slots are also moved if the loop only writes to other
+ * constant storage slots, including through the functions it calls.
+ *
  * Only statements at the top level in a loop's body or post block are considered, i.e variable
  * declarations inside conditional branches will not be moved out of the loop.
  *
@@ -50,19 +53,30 @@ private:
 		Dialect const& _dialect,
 		std::set<YulString> const& _ssaVariables,
 		std::map<YulString, SideEffects> const& _functionSideEffects,
+		std::map<YulString, u256> const& _ssaConstants,
+		std::map<YulString, std::set<u256>> const& _functionStorageWrites,
 		bool _containsMSize
 	):
 		m_containsMSize(_containsMSize),
 		m_dialect(_dialect),
 		m_ssaVariables(_ssaVariables),
-		m_functionSideEffects(_functionSideEffects)
+		m_functionSideEffects(_functionSideEffects),
+		m_ssaConstants(_ssaConstants),
+		m_functionStorageWrites(_functionStorageWrites)
 	{ }
 
 	/// @returns true if the given variable declaration can be moved to in front of the loop.
 	bool canBePromoted(
 		VariableDeclaration const& _varDecl,
 		std::set<YulString> const& _varsDefinedInCurrentScope,
-		SideEffects const& _forLoopSideEffects
+		SideEffects const& _forLoopSideEffects,
+		std::optional<std::set<u256>> const& _forLoopStorageWrites
+	) const;
+	/// @returns true if @a _expression is a storage load from a constant slot that is not
+	/// contained in @a _forLoopStorageWrites.
+	bool loadsUnwrittenStorageSlot(
+		Expression const& _expression,
+		std::optional<std::set<u256>> const& _forLoopStorageWrites
 	) const;
 	std::optional<std::vector<Statement>> rewriteLoop(ForLoop& _for);
 
@@ -70,6 +84,10 @@ private:
 	Dialect const& m_dialect;
 	std::set<YulString> const& m_ssaVariables;
 	std::map<YulString, SideEffects> const& m_functionSideEffects;
+	/// Values of the SSA variables that are declared with a literal value.
+	std::map<YulString, u256> const& m_ssaConstants;
+	/// Storage slots written by the functions that only write to constant slots.
+	std::map<YulString, std::set<u256>> const& m_functionStorageWrites;
 };
 
 }
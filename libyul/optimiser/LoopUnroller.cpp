@@ -0,0 +1,251 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimisation stage that unrolls loops with a constant number of iterations.
+ */
+
+#include <libyul/optimiser/LoopUnroller.h>
+
+#include <libyul/optimiser/FullInliner.h>
+#include <libyul/optimiser/Metrics.h>
+#include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/SimplificationRules.h>
+#include <libyul/optimiser/SSAValueTracker.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/AST.h>
+#include <libyul/Utilities.h>
+
+#include <libsolutil/CommonData.h>
+
+#include <libevmasm/Instruction.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+
+namespace
+{
+
+/// Maximum number of iterations of a loop that is fully unrolled.
+size_t constexpr maxFullyUnrolledIterations = 16;
+
+/// Finds the statements that prevent the body of a loop from being copied: ``break`` and
+/// ``continue`` statements of the loop itself and function definitions.
+class UnrollingBlocker: public ASTWalker
+{
+public:
+	/// @returns true if the statements of @a _body starting at @a _firstStatement cannot be copied.
+	static bool blocks(Block const& _body, size_t _firstStatement)
+	{
+		UnrollingBlocker blocker;
+		for (size_t i = _firstStatement; i < _body.statements.size(); ++i)
+			blocker.visit(_body.statements[i]);
+		return blocker.m_blocked;
+	}
+
+	using ASTWalker::operator();
+	void operator()(ForLoop const& _forLoop) override
+	{
+		++m_loopDepth;
+		ASTWalker::operator()(_forLoop);
+		--m_loopDepth;
+	}
+	void operator()(Break const&) override { m_blocked = m_blocked || m_loopDepth == 0; }
+	void operator()(Continue const&) override { m_blocked = m_blocked || m_loopDepth == 0; }
+	void operator()(FunctionDefinition const&) override { m_blocked = true; }
+
+private:
+	size_t m_loopDepth = 0;
+	bool m_blocked = false;
+};
+
+}
+
+void LoopUnroller::run(OptimiserStepContext& _context, Block& _ast)
+{
+	if (!dynamic_cast<EVMDialect const*>(&_context.dialect))
+		return;
+
+	// Keeps the value used for variables declared without one alive during the step.
+	SSAValueTracker ssaValueTracker;
+	ssaValueTracker(_ast);
+	LoopUnroller{
+		_context.dialect,
+		_context.dispenser,
+		_context.expectedExecutionsPerDeployment,
+		ssaValueTracker.values()
+	}(_ast);
+}
+
+void LoopUnroller::operator()(Block& _block)
+{
+	walkVector(_block.statements);
+	util::iterateReplacingWindow<2>(
+		_block.statements,
+		[&](Statement& _first, Statement& _second) -> optional<vector<Statement>>
+		{
+			if (auto* counter = get_if<VariableDeclaration>(&_first))
+				if (holds_alternative<ForLoop>(_second))
+					return unroll(*counter, _second);
+			return nullopt;
+		}
+	);
+}
+
+optional<vector<Statement>> LoopUnroller::unroll(VariableDeclaration& _counter, Statement& _loopStatement)
+{
+	ForLoop& loop = get<ForLoop>(_loopStatement);
+	if (_counter.variables.size() != 1 || !loop.pre.statements.empty())
+		return nullopt;
+	YulString const counter = _counter.variables.front().name;
+	optional<u256> const start = _counter.value ? constant(*_counter.value) : u256(0);
+	if (!start)
+		return nullopt;
+	auto isCounter = [&](Expression const& _expression) {
+		Identifier const* identifier = get_if<Identifier>(&_expression);
+		return identifier && identifier->name == counter;
+	};
+
+	// If the condition of the loop is constant, the actual condition is the one of the
+	// ``if`` leaving the loop at the start of its body, which is not copied.
+	Expression const* condition = loop.condition.get();
+	size_t firstBodyStatement = 0;
+	if (optional<u256> value = constant(*condition))
+	{
+		if (*value == 0 || loop.body.statements.empty())
+			return nullopt;
+		If const* exit = get_if<If>(&loop.body.statements.front());
+		if (!exit || exit->body.statements.size() != 1 || !holds_alternative<Break>(exit->body.statements.front()))
+			return nullopt;
+		auto negation = SimplificationRules::instructionAndArguments(m_dialect, *exit->condition);
+		if (!negation || negation->first != evmasm::Instruction::ISZERO)
+			return nullopt;
+		condition = &negation->second->front();
+		firstBodyStatement = 1;
+	}
+
+	// The loop continues while the counter is less than a constant bound.
+	auto comparison = SimplificationRules::instructionAndArguments(m_dialect, *condition);
+	if (!comparison || comparison->second->size() != 2)
+		return nullopt;
+	vector<Expression> const& operands = *comparison->second;
+	optional<u256> bound;
+	if (comparison->first == evmasm::Instruction::LT && isCounter(operands[0]))
+		bound = constant(operands[1]);
+	else if (comparison->first == evmasm::Instruction::GT && isCounter(operands[1]))
+		bound = constant(operands[0]);
+	if (!bound)
+		return nullopt;
+
+	// The post block adds a constant to the counter.
+	if (loop.post.statements.size() != 1)
+		return nullopt;
+	Assignment const* increment = get_if<Assignment>(&loop.post.statements.front());
+	if (!increment || increment->variableNames.size() != 1 || increment->variableNames.front().name != counter)
+		return nullopt;
+	auto addition = SimplificationRules::instructionAndArguments(m_dialect, *increment->value);
+	if (!addition || addition->first != evmasm::Instruction::ADD)
+		return nullopt;
+	vector<Expression> const& summands = *addition->second;
+	optional<u256> step;
+	if (isCounter(summands[0]))
+		step = constant(summands[1]);
+	else if (isCounter(summands[1]))
+		step = constant(summands[0]);
+	if (!step || *step == 0)
+		return nullopt;
+
+	if (assignedVariableNames(loop.body).count(counter) || UnrollingBlocker::blocks(loop.body, firstBodyStatement))
+		return nullopt;
+
+	size_t iterations = 0;
+	if (*start < *bound)
+	{
+		bigint const count = (bigint(*bound) - bigint(*start) + bigint(*step) - 1) / bigint(*step);
+		// The loop would not end if the counter overflowed in the last iteration.
+		if (
+			bigint(*start) + count * bigint(*step) > bigint(numeric_limits<u256>::max()) ||
+			count > numeric_limits<size_t>::max()
+		)
+			return nullopt;
+		iterations = static_cast<size_t>(count);
+	}
+
+	size_t iterationSize = CodeSize::codeSize(loop.post);
+	for (size_t i = firstBodyStatement; i < loop.body.statements.size(); ++i)
+		iterationSize += CodeSize::codeSize(loop.body.statements[i]);
+
+	if (
+		iterations <= maxFullyUnrolledIterations &&
+		iterations * iterationSize <= CodeSize::codeSize(_loopStatement) + additionalCodeSize()
+	)
+	{
+		vector<Statement> statements;
+		statements.emplace_back(move(_counter));
+		for (size_t i = 0; i < iterations; ++i)
+		{
+			statements.emplace_back(copy(loop.body, firstBodyStatement));
+			statements.emplace_back(copy(loop.post));
+		}
+		return statements;
+	}
+
+	// If the number of iterations is a multiple of the number of copies, the condition is
+	// known to be true between them and is only checked once for all of them.
+	for (size_t factor: {8u, 4u, 2u})
+		if (iterations % factor == 0 && (factor - 1) * iterationSize <= additionalCodeSize())
+		{
+			vector<Statement> copies;
+			for (size_t i = 1; i < factor; ++i)
+			{
+				copies.emplace_back(copy(loop.post));
+				copies.emplace_back(copy(loop.body, firstBodyStatement));
+			}
+			loop.body.statements += move(copies);
+			break;
+		}
+	return nullopt;
+}
+
+optional<u256> LoopUnroller::constant(Expression const& _expression) const
+{
+	Expression const* expression = &_expression;
+	if (Identifier const* identifier = get_if<Identifier>(expression))
+		if (Expression const* const* value = util::valueOrNullptr(m_ssaValues, identifier->name))
+			expression = *value;
+	if (Literal const* literal = get_if<Literal>(expression))
+		return valueOfLiteral(*literal);
+	return nullopt;
+}
+
+Block LoopUnroller::copy(Block const& _block, size_t _firstStatement) const
+{
+	BodyCopier copier{m_nameDispenser, {}};
+	Block result{_block.debugData, {}};
+	for (size_t i = _firstStatement; i < _block.statements.size(); ++i)
+		result.statements.emplace_back(copier.translate(_block.statements[i]));
+	return result;
+}
+
+size_t LoopUnroller::additionalCodeSize() const
+{
+	// Code that is only executed at deployment is not made larger.
+	if (!m_expectedExecutionsPerDeployment)
+		return 0;
+	return min<size_t>(*m_expectedExecutionsPerDeployment / 5, 200);
+}
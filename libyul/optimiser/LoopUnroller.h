@@ -0,0 +1,118 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimisation stage that unrolls loops with a constant number of iterations.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/OptimiserStep.h>
+
+#include <libsolutil/Numeric.h>
+
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace solidity::yul
+{
+struct Dialect;
+class NameDispenser;
+
+/**
+ * Optimisation stage that unrolls ``for`` loops whose number of iterations is known
+ * at compile time.
+ *
+ * A loop is considered if its counter is declared with a constant value directly before it,
+ * which is the form the ForLoopInitRewriter creates, the condition is ``lt(i, n)`` or
+ * ``gt(n, i)`` with a constant ``n`` and the post block consists of ``i := add(i, c)``
+ * with a constant ``c``. Constants can be literals or SSA variables with a literal value.
+ * The condition can also be the first statement of the body, as ``if iszero(lt(i, n)) { break }``
+ * with the condition of the loop being a nonzero constant, which is the form the
+ * ForLoopConditionIntoBody creates. The body must not assign to the counter and must not
+ * contain ``break`` or ``continue`` statements for the loop or function definitions.
+ *
+ * Loops with few iterations are fully unrolled, i.e. replaced by the copies of their body
+ * and post block for each iteration, if the code does not grow more than allowed by the
+ * expected number of executions. Other loops whose number of iterations is a multiple of two,
+ * four or eight get the copies of that many iterations in their body, which removes the
+ * condition and the jumps of the other iterations:
+ *
+ *   let i := 0
+ *   for { } lt(i, 2) { i := add(i, 1) } { sstore(i, 1) }
+ *
+ * is turned into
+ *
+ *   let i := 0
+ *   { sstore(i, 1) }
+ *   { i := add(i, 1) }
+ *   { sstore(i, 1) }
+ *   { i := add(i, 1) }
+ *
+ * The variables declared in the copies get new names. Without a number of expected executions,
+ * which is the case for code only executed at deployment, loops are only unrolled if this does
+ * not increase the code size.
+ *
+ * The counter is not replaced by its values, this is left to the SSATransform followed by the
+ * Rematerialiser or the ExpressionSimplifier.
+ *
+ * Prerequisite: Disambiguator, ForLoopInitRewriter.
+ */
+class LoopUnroller: public ASTModifier
+{
+public:
+	static constexpr char const* name{"LoopUnroller"};
+	static void run(OptimiserStepContext& _context, Block& _ast);
+
+	using ASTModifier::operator();
+	void operator()(Block& _block) override;
+
+private:
+	LoopUnroller(
+		Dialect const& _dialect,
+		NameDispenser& _nameDispenser,
+		std::optional<size_t> _expectedExecutionsPerDeployment,
+		std::unordered_map<YulString, Expression const*> _ssaValues
+	):
+		m_dialect(_dialect),
+		m_nameDispenser(_nameDispenser),
+		m_expectedExecutionsPerDeployment(_expectedExecutionsPerDeployment),
+		m_ssaValues(std::move(_ssaValues))
+	{}
+
+	/// Unrolls the loop @a _loop whose counter is declared by @a _counter.
+	/// @returns the statements replacing both if the loop is fully unrolled. A partially
+	/// unrolled loop is modified in place.
+	std::optional<std::vector<Statement>> unroll(VariableDeclaration& _counter, Statement& _loop);
+	/// @returns the value of @a _expression if it is a literal or an SSA variable with a literal value.
+	std::optional<u256> constant(Expression const& _expression) const;
+	/// @returns a copy of the statements of @a _block starting at @a _firstStatement, in which
+	/// the declared variables have new names.
+	Block copy(Block const& _block, size_t _firstStatement = 0) const;
+	/// @returns the code size the copies of the iterations may add to the size of a loop.
+	size_t additionalCodeSize() const;
+
+	Dialect const& m_dialect;
+	NameDispenser& m_nameDispenser;
+	std::optional<size_t> m_expectedExecutionsPerDeployment;
+	/// Values of the variables that are never assigned to.
+	std::unordered_map<YulString, Expression const*> m_ssaValues;
+};
+
+}
@@ -189,6 +189,68 @@ void CodeCost::addInstructionCost(evmasm::Instruction _instruction)
 		m_cost += 49;
 }
 
+namespace
+{
+
+class CodeFeatureCollector: public ASTWalker
+{
+public:
+	CodeFeatureCollector(Dialect const& _dialect, CodeFeatures& _features):
+		m_dialect(_dialect), m_features(_features) {}
+
+	using ASTWalker::operator();
+	void operator()(ForLoop const& _forLoop) override
+	{
+		++m_features.loopCount;
+		ASTWalker::operator()(_forLoop);
+	}
+	void operator()(Switch const& _switch) override
+	{
+		m_features.externalFunctions = max(m_features.externalFunctions, _switch.cases.size());
+		ASTWalker::operator()(_switch);
+	}
+	void operator()(FunctionCall const& _funCall) override
+	{
+		ASTWalker::operator()(_funCall);
+		auto instruction = toEVMInstruction(m_dialect, _funCall.functionName.name);
+		if (!instruction)
+			return;
+		switch (*instruction)
+		{
+		case evmasm::Instruction::SLOAD:
+		case evmasm::Instruction::SSTORE:
+			++m_features.storageAccesses;
+			break;
+		case evmasm::Instruction::MUL:
+		case evmasm::Instruction::DIV:
+		case evmasm::Instruction::SDIV:
+		case evmasm::Instruction::MOD:
+		case evmasm::Instruction::SMOD:
+		case evmasm::Instruction::ADDMOD:
+		case evmasm::Instruction::MULMOD:
+		case evmasm::Instruction::EXP:
+			++m_features.arithmeticOperations;
+			break;
+		default:
+			break;
+		}
+	}
+
+private:
+	Dialect const& m_dialect;
+	CodeFeatures& m_features;
+};
+
+}
+
+CodeFeatures CodeFeatures::of(Dialect const& _dialect, Block const& _block)
+{
+	CodeFeatures features;
+	features.codeSize = CodeSize::codeSizeIncludingFunctions(_block);
+	CodeFeatureCollector{_dialect, features}(_block);
+	return features;
+}
+
 void AssignmentCounter::operator()(Assignment const& _assignment)
 {
 	for (auto const& variable: _assignment.variableNames)
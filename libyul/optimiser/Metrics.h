@@ -130,6 +130,26 @@ private:
 	size_t m_cost = 0;
 };
 
+/**
+ * Coarse features of a piece of code, including its function definitions,
+ * used to select an optimisation sequence for it.
+ */
+struct CodeFeatures
+{
+	/// Number of AST nodes as counted by CodeSize with default weights.
+	size_t codeSize = 0;
+	size_t loopCount = 0;
+	/// Number of calls to sload and sstore.
+	size_t storageAccesses = 0;
+	/// Number of calls to the multiplicative and modular arithmetic instructions and exp.
+	size_t arithmeticOperations = 0;
+	/// Largest number of cases of a single switch statement, which is the number of external
+	/// functions for the dispatcher of a contract.
+	size_t externalFunctions = 0;
+
+	static CodeFeatures of(Dialect const& _dialect, Block const& _block);
+};
+
 /**
  * Counts the number of assignments to every variable.
  * Only works after running the Disambiguator.
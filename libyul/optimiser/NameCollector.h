@@ -25,6 +25,7 @@
 
 #include <map>
 #include <set>
+#include <unordered_map>
 
 namespace solidity::yul
 {
@@ -81,14 +82,14 @@ public:
 	void operator()(Identifier const& _identifier) override;
 	void operator()(FunctionCall const& _funCall) override;
 
-	static std::map<YulString, size_t> countReferences(Block const& _block, CountWhat _countWhat = VariablesAndFunctions);
-	static std::map<YulString, size_t> countReferences(FunctionDefinition const& _function, CountWhat _countWhat = VariablesAndFunctions);
-	static std::map<YulString, size_t> countReferences(Expression const& _expression, CountWhat _countWhat = VariablesAndFunctions);
+	static std::unordered_map<YulString, size_t> countReferences(Block const& _block, CountWhat _countWhat = VariablesAndFunctions);
+	static std::unordered_map<YulString, size_t> countReferences(FunctionDefinition const& _function, CountWhat _countWhat = VariablesAndFunctions);
+	static std::unordered_map<YulString, size_t> countReferences(Expression const& _expression, CountWhat _countWhat = VariablesAndFunctions);
 
-	std::map<YulString, size_t> const& references() const { return m_references; }
+	std::unordered_map<YulString, size_t> const& references() const { return m_references; }
 private:
 	CountWhat m_countWhat = CountWhat::VariablesAndFunctions;
-	std::map<YulString, size_t> m_references;
+	std::unordered_map<YulString, size_t> m_references;
 };
 
 /**
@@ -35,27 +35,43 @@ using namespace solidity::yul;
 using namespace solidity::util;
 
 NameDispenser::NameDispenser(Dialect const& _dialect, Block const& _ast, set<YulString> _reservedNames):
-	NameDispenser(_dialect, NameCollector(_ast).names() + _reservedNames)
+	m_dialect(_dialect),
+	m_reservedNames(move(_reservedNames))
 {
-	m_reservedNames = move(_reservedNames);
+	reset(_ast);
 }
 
 NameDispenser::NameDispenser(Dialect const& _dialect, set<YulString> _usedNames):
 	m_dialect(_dialect),
-	m_usedNames(std::move(_usedNames))
+	m_usedNames(_usedNames.begin(), _usedNames.end())
 {
 }
 
 YulString NameDispenser::newName(YulString _nameHint)
 {
-	YulString name = _nameHint;
-	while (illegalName(name))
+	if (!illegalName(_nameHint))
+	{
+		m_usedNames.emplace(_nameHint);
+		return _nameHint;
+	}
+
+	string candidate = _nameHint.str() + "_";
+	size_t const prefixLength = candidate.size();
+	while (true)
 	{
 		m_counter++;
-		name = YulString(_nameHint.str() + "_" + to_string(m_counter));
+		candidate.resize(prefixLength);
+		candidate += to_string(m_counter);
+		// A string that is not in the repository cannot be in use, so only the restrictions
+		// have to be checked for it.
+		optional<YulString> existing = YulString::find(candidate);
+		YulString name = existing ? *existing : YulString(candidate);
+		if (existing ? !illegalName(name) : !isRestrictedIdentifier(m_dialect, name))
+		{
+			m_usedNames.emplace(name);
+			return name;
+		}
 	}
-	m_usedNames.emplace(name);
-	return name;
 }
 
 bool NameDispenser::illegalName(YulString _name)
@@ -65,6 +81,10 @@ bool NameDispenser::illegalName(YulString _name)
 
 void NameDispenser::reset(Block const& _ast)
 {
-	m_usedNames = NameCollector(_ast).names() + m_reservedNames;
+	set<YulString> names = NameCollector(_ast).names();
+	m_usedNames.clear();
+	m_usedNames.reserve(names.size() + m_reservedNames.size());
+	m_usedNames.insert(names.begin(), names.end());
+	m_usedNames.insert(m_reservedNames.begin(), m_reservedNames.end());
 	m_counter = 0;
 }
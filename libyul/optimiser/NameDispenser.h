@@ -25,6 +25,7 @@
 #include <libyul/YulString.h>
 
 #include <set>
+#include <unordered_set>
 
 namespace solidity::yul
 {
@@ -35,6 +36,8 @@ struct Dialect;
  * do not conflict with existing names.
  *
  * Tries to keep names short and appends decimals to disambiguate.
+ * The decimals are taken from a single counter, so a candidate name is rarely
+ * in use already and does not have to be added to the YulString repository if it is.
  */
 class NameDispenser
 {
@@ -51,7 +54,7 @@ public:
 	/// return it.
 	void markUsed(YulString _name) { m_usedNames.insert(_name); }
 
-	std::set<YulString> const& usedNames() { return m_usedNames; }
+	std::unordered_set<YulString> const& usedNames() { return m_usedNames; }
 
 	/// Returns true if `_name` is either used or is a restricted identifier.
 	bool illegalName(YulString _name);
@@ -62,7 +65,7 @@ public:
 
 private:
 	Dialect const& m_dialect;
-	std::set<YulString> m_usedNames;
+	std::unordered_set<YulString> m_usedNames;
 	std::set<YulString> m_reservedNames;
 	size_t m_counter = 0;
 };
@@ -0,0 +1,52 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/optimiser/OptimisedCodeCache.h>
+
+#include <libyul/optimiser/ASTCopier.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+
+optional<Block> OptimisedCodeCache::find(util::h256 const& _key) const
+{
+	Block const* code = nullptr;
+	{
+		lock_guard<mutex> lock(m_mutex);
+		auto it = m_entries.find(_key);
+		if (it == m_entries.end())
+			return nullopt;
+		code = &it->second;
+	}
+	// Entries are never modified or removed, so they can be copied without holding the lock.
+	return ASTCopier{}.translate(*code);
+}
+
+void OptimisedCodeCache::store(util::h256 const& _key, Block const& _code)
+{
+	Block copy = ASTCopier{}.translate(_code);
+	lock_guard<mutex> lock(m_mutex);
+	m_entries.emplace(_key, move(copy));
+}
+
+size_t OptimisedCodeCache::size() const
+{
+	lock_guard<mutex> lock(m_mutex);
+	return m_entries.size();
+}
@@ -0,0 +1,58 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Store for the results of the optimiser suite.
+ */
+#pragma once
+
+#include <libyul/AST.h>
+
+#include <libsolutil/FixedHash.h>
+
+#include <map>
+#include <mutex>
+#include <optional>
+
+namespace solidity::yul
+{
+
+/**
+ * Stores the code produced by the optimiser suite, so that objects occurring several times
+ * during one compilation (for example the code of a contract that is also created by other
+ * contracts) are only optimised once.
+ *
+ * The keys are computed by OptimiserSuite::run. Entries are only valid as long as the
+ * YulStrings they contain, so a cache must not outlive the compilation that filled it.
+ * Can be used from multiple threads at the same time.
+ */
+class OptimisedCodeCache
+{
+public:
+	/// @returns a copy of the code stored under @a _key, if any.
+	std::optional<Block> find(util::h256 const& _key) const;
+	/// Stores @a _code under @a _key. Does nothing if there already is an entry for the key.
+	void store(util::h256 const& _key, Block const& _code);
+
+	size_t size() const;
+
+private:
+	mutable std::mutex m_mutex;
+	std::map<util::h256, Block> m_entries;
+};
+
+}
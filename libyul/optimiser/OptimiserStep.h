@@ -31,6 +31,7 @@ struct Dialect;
 struct Block;
 class YulString;
 class NameDispenser;
+class SideEffectsCache;
 
 struct OptimiserStepContext
 {
@@ -39,6 +40,10 @@ struct OptimiserStepContext
 	std::set<YulString> const& reservedIdentifiers;
 	/// The value nullopt represents creation code
 	std::optional<size_t> expectedExecutionsPerDeployment;
+	/// Maximum number of threads a step may use to process independent functions.
+	size_t parallelism = 1;
+	/// Side effects of the functions in the AST kept between steps, if available.
+	SideEffectsCache* sideEffectsCache = nullptr;
 };
 
 
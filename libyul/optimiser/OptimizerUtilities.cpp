@@ -21,6 +21,8 @@
 
 #include <libyul/optimiser/OptimizerUtilities.h>
 
+#include <libyul/optimiser/FunctionGrouper.h>
+
 #include <libyul/backends/evm/EVMDialect.h>
 
 #include <libyul/Dialect.h>
@@ -28,6 +30,7 @@
 
 #include <liblangutil/Token.h>
 #include <libsolutil/CommonData.h>
+#include <libsolutil/ThreadPool.h>
 
 #include <range/v3/action/remove_if.hpp>
 
@@ -58,6 +61,36 @@ optional<evmasm::Instruction> yul::toEVMInstruction(Dialect const& _dialect, Yul
 	return nullopt;
 }
 
+void yul::runOnFunctionsInParallel(
+	Block& _ast,
+	size_t _parallelism,
+	function<unique_ptr<ASTModifier>()> const& _createVisitor
+)
+{
+	vector<Statement>& statements = _ast.statements;
+	if (_parallelism <= 1 || statements.size() <= 2 || !FunctionGrouper::alreadyGrouped(_ast))
+	{
+		(*_createVisitor())(_ast);
+		return;
+	}
+
+	// Use more ranges than threads, since functions differ in size.
+	size_t rangeCount = min(statements.size(), 4 * _parallelism);
+	auto processRange = [&](size_t _begin, size_t _end) {
+		unique_ptr<ASTModifier> visitor = _createVisitor();
+		for (size_t i = _begin; i < _end; ++i)
+			if (Block* block = get_if<Block>(&statements[i]))
+				(*visitor)(*block);
+			else
+				(*visitor)(std::get<FunctionDefinition>(statements[i]));
+	};
+
+	// Rethrows the exception of the first failing range.
+	parallelFor(rangeCount, _parallelism, [&](size_t _range) {
+		processRange(_range * statements.size() / rangeCount, (_range + 1) * statements.size() / rangeCount);
+	});
+}
+
 void StatementRemover::operator()(Block& _block)
 {
 	util::iterateReplacing(
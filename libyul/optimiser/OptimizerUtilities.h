@@ -27,6 +27,8 @@
 #include <libyul/YulString.h>
 #include <libyul/optimiser/ASTWalker.h>
 
+#include <functional>
+#include <memory>
 #include <optional>
 
 namespace solidity::evmasm
@@ -49,6 +51,19 @@ bool isRestrictedIdentifier(Dialect const& _dialect, YulString const& _identifie
 /// Helper function that returns the instruction, if the `_name` is a BuiltinFunction
 std::optional<evmasm::Instruction> toEVMInstruction(Dialect const& _dialect, YulString const& _name);
 
+/// Runs the visitors created by @a _createVisitor on the main block and the functions of @a _ast
+/// using up to @a _parallelism threads, each visitor processing a range of consecutive top-level
+/// statements. This requires that @a _ast is in the form established by the FunctionGrouper and
+/// that the visitors process every function independently of the rest of the code and
+/// neither allocate names nor modify shared state. If any of these is not the case, or
+/// @a _parallelism is one, a single visitor is run on the whole of @a _ast.
+/// The result is the same regardless of the number of threads.
+void runOnFunctionsInParallel(
+	Block& _ast,
+	size_t _parallelism,
+	std::function<std::unique_ptr<ASTModifier>()> const& _createVisitor
+);
+
 class StatementRemover: public ASTModifier
 {
 public:
@@ -0,0 +1,129 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimisation stage that removes sstore operations whose value is overwritten
+ * before it can be read.
+ */
+
+#include <libyul/optimiser/OverwrittenStoreEliminator.h>
+
+#include <libyul/optimiser/OptimizerUtilities.h>
+#include <libyul/optimiser/Semantics.h>
+#include <libyul/optimiser/SideEffectsCache.h>
+#include <libyul/optimiser/SyntacticalEquality.h>
+#include <libyul/AST.h>
+#include <libyul/Dialect.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+
+void OverwrittenStoreEliminator::run(OptimiserStepContext const& _context, Block& _ast)
+{
+	OverwrittenStoreEliminator eliminator{
+		_context.dialect,
+		SideEffectsCache::functionSideEffects(_context, _ast),
+		SideEffectsCache::controlFlowSideEffects(_context, _ast)
+	};
+	eliminator(_ast);
+
+	StatementRemover remover{eliminator.m_pendingRemovals};
+	remover(_ast);
+}
+
+void OverwrittenStoreEliminator::operator()(Block const& _block)
+{
+	for (size_t i = 0; i < _block.statements.size(); ++i)
+	{
+		FunctionCall const* store = storageStore(_block.statements[i]);
+		if (!store)
+			continue;
+		Expression const& slot = store->arguments.front();
+		for (size_t j = i + 1; j < _block.statements.size(); ++j)
+		{
+			Statement const& statement = _block.statements[j];
+			if (FunctionCall const* laterStore = storageStore(statement))
+				if (SyntacticallyEqual{}(slot, laterStore->arguments.front()))
+				{
+					m_pendingRemovals.insert(&_block.statements[i]);
+					break;
+				}
+			if (!hidesNoStore(statement, slot))
+				break;
+		}
+	}
+
+	ASTWalker::operator()(_block);
+}
+
+FunctionCall const* OverwrittenStoreEliminator::storageStore(Statement const& _statement) const
+{
+	BuiltinFunction const* storeFunction = m_dialect.storageStoreFunction(YulString{});
+	if (!storeFunction)
+		return nullptr;
+	if (ExpressionStatement const* expression = get_if<ExpressionStatement>(&_statement))
+		if (FunctionCall const* funCall = get_if<FunctionCall>(&expression->expression))
+			if (funCall->functionName.name == storeFunction->name)
+			{
+				for (Expression const& argument: funCall->arguments)
+					if (!holds_alternative<Identifier>(argument) && !holds_alternative<Literal>(argument))
+						return nullptr;
+				return funCall;
+			}
+	return nullptr;
+}
+
+bool OverwrittenStoreEliminator::hidesNoStore(Statement const& _statement, Expression const& _slot) const
+{
+	if (holds_alternative<FunctionDefinition>(_statement) || storageStore(_statement))
+		return true;
+	else if (ExpressionStatement const* expression = get_if<ExpressionStatement>(&_statement))
+		return hidesNoStore(expression->expression);
+	else if (VariableDeclaration const* declaration = get_if<VariableDeclaration>(&_statement))
+		return !declaration->value || hidesNoStore(*declaration->value);
+	else if (Assignment const* assignment = get_if<Assignment>(&_statement))
+	{
+		if (Identifier const* slotVariable = get_if<Identifier>(&_slot))
+			for (Identifier const& variable: assignment->variableNames)
+				if (variable.name == slotVariable->name)
+					return false;
+		return hidesNoStore(*assignment->value);
+	}
+	return false;
+}
+
+bool OverwrittenStoreEliminator::hidesNoStore(Expression const& _expression) const
+{
+	return
+		SideEffectsCollector{m_dialect, _expression, &m_functionSideEffects}.sideEffects().storage == SideEffects::None &&
+		!canTerminate(_expression);
+}
+
+bool OverwrittenStoreEliminator::canTerminate(Expression const& _expression) const
+{
+	FunctionCall const* funCall = get_if<FunctionCall>(&_expression);
+	if (!funCall)
+		return false;
+	for (Expression const& argument: funCall->arguments)
+		if (canTerminate(argument))
+			return true;
+	if (BuiltinFunction const* builtin = m_dialect.builtin(funCall->functionName.name))
+		return builtin->controlFlowSideEffects.canTerminate;
+	auto it = m_controlFlowSideEffects.find(funCall->functionName.name);
+	return it == m_controlFlowSideEffects.end() || it->second.canTerminate;
+}
@@ -0,0 +1,88 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimisation stage that removes sstore operations whose value is overwritten
+ * before it can be read.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/ControlFlowSideEffects.h>
+#include <libyul/SideEffects.h>
+
+#include <map>
+#include <set>
+
+namespace solidity::yul
+{
+struct Dialect;
+struct FunctionCall;
+
+/**
+ * Optimisation stage that removes ``sstore(k, v)`` if it is followed by ``sstore(k, w)``
+ * in the same block and the statements in between can neither read storage, nor change ``k``,
+ * nor end the execution successfully.
+ *
+ * Together with the LoadResolver, which replaces the ``sload(k)`` of the second
+ * read-modify-write sequence by ``v``, this combines updates of several packed
+ * storage variables in the same slot into a single ``sload`` and a single ``sstore``.
+ *
+ * Works best if the code is in SSA form, after the CommonSubexpressionEliminator
+ * made equal slots use the same variable.
+ *
+ * Prerequisite: Disambiguator, ForLoopInitRewriter.
+ */
+class OverwrittenStoreEliminator: public ASTWalker
+{
+public:
+	static constexpr char const* name{"OverwrittenStoreEliminator"};
+	static void run(OptimiserStepContext const&, Block& _ast);
+
+	using ASTWalker::operator();
+	void operator()(Block const& _block) override;
+
+private:
+	OverwrittenStoreEliminator(
+		Dialect const& _dialect,
+		std::map<YulString, SideEffects> _functionSideEffects,
+		std::map<YulString, ControlFlowSideEffects> _controlFlowSideEffects
+	):
+		m_dialect(_dialect),
+		m_functionSideEffects(std::move(_functionSideEffects)),
+		m_controlFlowSideEffects(std::move(_controlFlowSideEffects))
+	{}
+
+	/// @returns the call if @a _statement is an sstore whose arguments are identifiers or literals.
+	FunctionCall const* storageStore(Statement const& _statement) const;
+	/// @returns true if @a _statement can be executed between two stores to @a _slot
+	/// without the first one being observable.
+	bool hidesNoStore(Statement const& _statement, Expression const& _slot) const;
+	/// @returns true if evaluating @a _expression does not access storage and cannot end the
+	/// execution successfully.
+	bool hidesNoStore(Expression const& _expression) const;
+	bool canTerminate(Expression const& _expression) const;
+
+	Dialect const& m_dialect;
+	std::map<YulString, SideEffects> m_functionSideEffects;
+	std::map<YulString, ControlFlowSideEffects> m_controlFlowSideEffects;
+	std::set<Statement const*> m_pendingRemovals;
+};
+
+}
@@ -0,0 +1,303 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimisation stage that evaluates calls of functions with literal arguments at compile time.
+ */
+
+#include <libyul/optimiser/PureCallEvaluator.h>
+
+#include <libyul/optimiser/NameCollector.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/AST.h>
+#include <libyul/Exceptions.h>
+#include <libyul/Utilities.h>
+
+#include <libsolutil/CommonData.h>
+#include <libsolutil/Visitor.h>
+
+#include <libevmasm/Instruction.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+
+namespace
+{
+
+/// Maximum number of statements, expressions and loop iterations executed for one call.
+size_t constexpr maxEvaluationSteps = 10000;
+/// Maximum number of nested calls of user-defined functions during the evaluation of a call.
+size_t constexpr maxCallDepth = 64;
+
+/// Stops an evaluation that needs a value not known at compile time or exceeds the limits.
+struct EvaluationAborted {};
+
+/// @returns the result of @a _instruction for the given arguments, the first argument first,
+/// if it only depends on its arguments.
+optional<u256> evaluateInstruction(evmasm::Instruction _instruction, vector<u256> const& _arguments)
+{
+	using evmasm::Instruction;
+	auto const& arg = _arguments;
+	switch (_instruction)
+	{
+	case Instruction::ADD: return u256(arg[0] + arg[1]);
+	case Instruction::SUB: return u256(arg[0] - arg[1]);
+	case Instruction::MUL: return u256(arg[0] * arg[1]);
+	case Instruction::DIV: return arg[1] == 0 ? 0 : u256(arg[0] / arg[1]);
+	case Instruction::SDIV: return arg[1] == 0 ? 0 : s2u(u2s(arg[0]) / u2s(arg[1]));
+	case Instruction::MOD: return arg[1] == 0 ? 0 : u256(arg[0] % arg[1]);
+	case Instruction::SMOD: return arg[1] == 0 ? 0 : s2u(u2s(arg[0]) % u2s(arg[1]));
+	case Instruction::EXP: return exp256(arg[0], arg[1]);
+	case Instruction::ADDMOD: return arg[2] == 0 ? 0 : u256((bigint(arg[0]) + bigint(arg[1])) % arg[2]);
+	case Instruction::MULMOD: return arg[2] == 0 ? 0 : u256((bigint(arg[0]) * bigint(arg[1])) % arg[2]);
+	case Instruction::SIGNEXTEND:
+	{
+		if (arg[0] >= 31)
+			return arg[1];
+		unsigned testBit = unsigned(arg[0]) * 8 + 7;
+		u256 mask = (u256(1) << testBit) - 1;
+		return boost::multiprecision::bit_test(arg[1], testBit) ? u256(arg[1] | ~mask) : u256(arg[1] & mask);
+	}
+	case Instruction::LT: return arg[0] < arg[1] ? 1 : 0;
+	case Instruction::GT: return arg[0] > arg[1] ? 1 : 0;
+	case Instruction::SLT: return u2s(arg[0]) < u2s(arg[1]) ? 1 : 0;
+	case Instruction::SGT: return u2s(arg[0]) > u2s(arg[1]) ? 1 : 0;
+	case Instruction::EQ: return arg[0] == arg[1] ? 1 : 0;
+	case Instruction::ISZERO: return arg[0] == 0 ? 1 : 0;
+	case Instruction::AND: return u256(arg[0] & arg[1]);
+	case Instruction::OR: return u256(arg[0] | arg[1]);
+	case Instruction::XOR: return u256(arg[0] ^ arg[1]);
+	case Instruction::NOT: return u256(~arg[0]);
+	case Instruction::BYTE: return arg[0] >= 32 ? 0 : u256((arg[1] >> unsigned(8 * (31 - arg[0]))) & 0xff);
+	case Instruction::SHL: return arg[0] >= 256 ? 0 : u256(arg[1] << unsigned(arg[0]));
+	case Instruction::SHR: return arg[0] >= 256 ? 0 : u256(arg[1] >> unsigned(arg[0]));
+	case Instruction::SAR:
+	{
+		bool negative = boost::multiprecision::bit_test(arg[1], 255);
+		if (arg[0] >= 256)
+			return negative ? ~u256(0) : 0;
+		unsigned amount = unsigned(arg[0]);
+		u256 shifted = arg[1] >> amount;
+		if (negative && amount > 0)
+			shifted |= ~u256(0) << (256 - amount);
+		return shifted;
+	}
+	default: return nullopt;
+	}
+}
+
+/// Executes user-defined functions as long as they only use values known at compile time.
+/// Relies on the names of all variables being unique, so that the variables of a call
+/// are kept in a single map regardless of the blocks they are declared in.
+class Evaluator
+{
+public:
+	Evaluator(EVMDialect const& _dialect, map<YulString, FunctionDefinition const*> const& _functions):
+		m_dialect(_dialect),
+		m_functions(_functions)
+	{}
+
+	/// @returns the values of the return variables of @a _function called with @a _arguments,
+	/// or nullopt if they cannot be computed at compile time within the limits.
+	optional<vector<u256>> evaluate(FunctionDefinition const& _function, vector<u256> const& _arguments)
+	{
+		try
+		{
+			return call(_function, _arguments);
+		}
+		catch (EvaluationAborted const&)
+		{
+			return nullopt;
+		}
+	}
+
+private:
+	enum class ControlFlow { FlowOut, Break, Continue, Leave };
+	using Variables = map<YulString, u256>;
+
+	vector<u256> call(FunctionDefinition const& _function, vector<u256> const& _arguments)
+	{
+		if (m_callDepth >= maxCallDepth)
+			throw EvaluationAborted{};
+		++m_callDepth;
+
+		yulAssert(_arguments.size() == _function.parameters.size(), "");
+		Variables variables;
+		for (size_t i = 0; i < _arguments.size(); ++i)
+			variables[_function.parameters[i].name] = _arguments[i];
+		for (TypedName const& returnVariable: _function.returnVariables)
+			variables[returnVariable.name] = 0;
+		execute(_function.body, variables);
+
+		vector<u256> results;
+		for (TypedName const& returnVariable: _function.returnVariables)
+			results.emplace_back(variables.at(returnVariable.name));
+		--m_callDepth;
+		return results;
+	}
+
+	ControlFlow execute(Block const& _block, Variables& _variables)
+	{
+		for (Statement const& statement: _block.statements)
+			if (ControlFlow flow = execute(statement, _variables); flow != ControlFlow::FlowOut)
+				return flow;
+		return ControlFlow::FlowOut;
+	}
+
+	ControlFlow execute(Statement const& _statement, Variables& _variables)
+	{
+		step();
+		return std::visit(util::GenericVisitor{
+			[&](ExpressionStatement const& _expressionStatement) -> ControlFlow {
+				evaluate(_expressionStatement.expression, _variables);
+				return ControlFlow::FlowOut;
+			},
+			[&](Assignment const& _assignment) -> ControlFlow {
+				vector<u256> values = evaluate(*_assignment.value, _variables);
+				yulAssert(values.size() == _assignment.variableNames.size(), "");
+				for (size_t i = 0; i < values.size(); ++i)
+					_variables[_assignment.variableNames[i].name] = values[i];
+				return ControlFlow::FlowOut;
+			},
+			[&](VariableDeclaration const& _declaration) -> ControlFlow {
+				vector<u256> values =
+					_declaration.value ?
+					evaluate(*_declaration.value, _variables) :
+					vector<u256>(_declaration.variables.size(), 0);
+				yulAssert(values.size() == _declaration.variables.size(), "");
+				for (size_t i = 0; i < values.size(); ++i)
+					_variables[_declaration.variables[i].name] = values[i];
+				return ControlFlow::FlowOut;
+			},
+			[&](If const& _if) -> ControlFlow {
+				if (evaluateSingle(*_if.condition, _variables) != 0)
+					return execute(_if.body, _variables);
+				return ControlFlow::FlowOut;
+			},
+			[&](Switch const& _switch) -> ControlFlow {
+				u256 value = evaluateSingle(*_switch.expression, _variables);
+				// The default case comes last, so it is only selected if no other case matches.
+				for (Case const& switchCase: _switch.cases)
+					if (!switchCase.value || valueOfLiteral(*switchCase.value) == value)
+						return execute(switchCase.body, _variables);
+				return ControlFlow::FlowOut;
+			},
+			[&](ForLoop const& _forLoop) -> ControlFlow {
+				execute(_forLoop.pre, _variables);
+				while (evaluateSingle(*_forLoop.condition, _variables) != 0)
+				{
+					ControlFlow flow = execute(_forLoop.body, _variables);
+					if (flow == ControlFlow::Break)
+						break;
+					if (flow == ControlFlow::Leave)
+						return flow;
+					execute(_forLoop.post, _variables);
+					step();
+				}
+				return ControlFlow::FlowOut;
+			},
+			[](Break const&) { return ControlFlow::Break; },
+			[](Continue const&) { return ControlFlow::Continue; },
+			[](Leave const&) { return ControlFlow::Leave; },
+			[](FunctionDefinition const&) { return ControlFlow::FlowOut; },
+			[&](Block const& _block) { return execute(_block, _variables); }
+		}, _statement);
+	}
+
+	vector<u256> evaluate(Expression const& _expression, Variables const& _variables)
+	{
+		step();
+		return std::visit(util::GenericVisitor{
+			[](Literal const& _literal) -> vector<u256> {
+				return {valueOfLiteral(_literal)};
+			},
+			[&](Identifier const& _identifier) -> vector<u256> {
+				return {_variables.at(_identifier.name)};
+			},
+			[&](FunctionCall const& _call) -> vector<u256> {
+				BuiltinFunctionForEVM const* builtin = m_dialect.builtin(_call.functionName.name);
+				FunctionDefinition const* function = util::valueOrDefault(m_functions, _call.functionName.name, nullptr, util::allow_copy);
+				if (builtin ? !builtin->instruction || !builtin->literalArguments.empty() : !function)
+					throw EvaluationAborted{};
+
+				// Arguments are evaluated from right to left.
+				vector<u256> arguments(_call.arguments.size());
+				for (size_t i = _call.arguments.size(); i > 0; --i)
+					arguments[i - 1] = evaluateSingle(_call.arguments[i - 1], _variables);
+
+				if (!builtin)
+					return call(*function, arguments);
+				optional<u256> result = evaluateInstruction(*builtin->instruction, arguments);
+				if (!result)
+					throw EvaluationAborted{};
+				return {*result};
+			}
+		}, _expression);
+	}
+
+	u256 evaluateSingle(Expression const& _expression, Variables const& _variables)
+	{
+		vector<u256> values = evaluate(_expression, _variables);
+		yulAssert(values.size() == 1, "");
+		return values.front();
+	}
+
+	void step()
+	{
+		if (++m_steps > maxEvaluationSteps)
+			throw EvaluationAborted{};
+	}
+
+	EVMDialect const& m_dialect;
+	map<YulString, FunctionDefinition const*> const& m_functions;
+	size_t m_steps = 0;
+	size_t m_callDepth = 0;
+};
+
+}
+
+void PureCallEvaluator::run(OptimiserStepContext& _context, Block& _ast)
+{
+	if (auto const* dialect = dynamic_cast<EVMDialect const*>(&_context.dialect))
+		PureCallEvaluator{*dialect, allFunctionDefinitions(_ast)}(_ast);
+}
+
+void PureCallEvaluator::visit(Expression& _expression)
+{
+	ASTModifier::visit(_expression);
+
+	FunctionCall const* call = get_if<FunctionCall>(&_expression);
+	if (!call)
+		return;
+	FunctionDefinition const* function = util::valueOrDefault(m_functions, call->functionName.name, nullptr, util::allow_copy);
+	if (!function || function->returnVariables.size() != 1)
+		return;
+	vector<u256> arguments;
+	for (Expression const& argument: call->arguments)
+		if (Literal const* literal = get_if<Literal>(&argument))
+			arguments.emplace_back(valueOfLiteral(*literal));
+		else
+			return;
+
+	auto [result, inserted] = m_results.try_emplace(make_pair(call->functionName.name, arguments));
+	if (inserted)
+		if (optional<vector<u256>> values = Evaluator{m_dialect, m_functions}.evaluate(*function, arguments))
+			result->second = values->front();
+	if (result->second)
+		_expression = Literal{debugDataOf(_expression), LiteralKind::Number, YulString{formatNumber(*result->second)}, {}};
+}
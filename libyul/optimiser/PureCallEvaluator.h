@@ -0,0 +1,91 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimisation stage that evaluates calls of functions with literal arguments at compile time.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/OptimiserStep.h>
+
+#include <libsolutil/Numeric.h>
+
+#include <map>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace solidity::yul
+{
+struct EVMDialect;
+
+/**
+ * Optimisation stage that replaces calls of user-defined functions with a single return
+ * variable and literal arguments by the value they return, if it can be computed at
+ * compile time.
+ *
+ * The value is computed by executing the function, where only the builtins of the EVM dialect
+ * whose result only depends on their arguments, i.e. arithmetic, bitwise and comparison
+ * instructions, and calls of other user-defined functions are allowed. The evaluation is
+ * aborted, and the call kept, if anything else is executed, e.g. an access to memory or
+ * storage or a ``revert``, or if it takes more than 10000 steps or 64 nested calls.
+ * Since only the branches taken for the given arguments are executed, this also evaluates
+ * checked arithmetic whose check does not fail:
+ *
+ *   function checked_add(x, y) -> sum {
+ *       sum := add(x, y)
+ *       if gt(x, sum) { revert(0, 0) }
+ *   }
+ *   sstore(0, checked_add(1, 2))
+ *
+ * is turned into
+ *
+ *   function checked_add(x, y) -> sum { ... }
+ *   sstore(0, 3)
+ *
+ * The result of each combination of function and arguments is only computed once.
+ *
+ * Only works for the EVM dialects.
+ *
+ * Works best after the LiteralRematerialiser replaced variables by their literal values.
+ *
+ * Prerequisite: Disambiguator.
+ */
+class PureCallEvaluator: public ASTModifier
+{
+public:
+	static constexpr char const* name{"PureCallEvaluator"};
+	static void run(OptimiserStepContext& _context, Block& _ast);
+
+	using ASTModifier::operator();
+	void visit(Expression& _expression) override;
+
+private:
+	PureCallEvaluator(EVMDialect const& _dialect, std::map<YulString, FunctionDefinition const*> _functions):
+		m_dialect(_dialect),
+		m_functions(std::move(_functions))
+	{}
+
+	EVMDialect const& m_dialect;
+	std::map<YulString, FunctionDefinition const*> m_functions;
+	/// Results of the calls evaluated so far, nullopt for the ones that could not be evaluated.
+	std::map<std::pair<YulString, std::vector<u256>>, std::optional<u256>> m_results;
+};
+
+}
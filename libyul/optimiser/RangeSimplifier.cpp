@@ -0,0 +1,484 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimisation stage that replaces comparisons by constants if the ranges of the
+ * compared values are known from the conditions of enclosing statements.
+ */
+
+#include <libyul/optimiser/RangeSimplifier.h>
+
+#include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/Semantics.h>
+#include <libyul/optimiser/SideEffectsCache.h>
+#include <libyul/optimiser/SimplificationRules.h>
+#include <libyul/optimiser/SSAValueTracker.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/AST.h>
+#include <libyul/Utilities.h>
+
+#include <libevmasm/Instruction.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+
+namespace
+{
+
+/// Maximum number of SSA variables followed to find the comparison a condition consists of.
+size_t constexpr maxConditionDepth = 16;
+
+}
+
+void RangeSimplifier::run(OptimiserStepContext& _context, Block& _ast)
+{
+	if (!dynamic_cast<EVMDialect const*>(&_context.dialect))
+		return;
+
+	// Keeps the value used for variables declared without one alive during the step.
+	SSAValueTracker ssaValueTracker;
+	ssaValueTracker(_ast);
+	RangeSimplifier{
+		_context.dialect,
+		ssaValueTracker.values(),
+		SideEffectsCache::controlFlowSideEffects(_context, _ast)
+	}(_ast);
+}
+
+RangeSimplifier::RangeSimplifier(
+	Dialect const& _dialect,
+	unordered_map<YulString, Expression const*> _ssaValues,
+	map<YulString, ControlFlowSideEffects> _controlFlowSideEffects
+):
+	m_dialect(_dialect),
+	m_ssaValues(move(_ssaValues)),
+	m_controlFlowSideEffects(move(_controlFlowSideEffects))
+{
+}
+
+void RangeSimplifier::operator()(VariableDeclaration& _varDecl)
+{
+	if (_varDecl.value)
+		visit(*_varDecl.value);
+
+	for (TypedName const& variable: _varDecl.variables)
+	{
+		m_facts.forget(variable.name);
+		if (!m_ssaValues.count(variable.name))
+			assigned(variable.name);
+	}
+
+	if (_varDecl.variables.size() == 1 && m_ssaValues.count(_varDecl.variables.front().name))
+	{
+		map<YulString, size_t>& references = m_ssaReferences[_varDecl.variables.front().name];
+		references.clear();
+		if (_varDecl.value)
+			for (auto const& reference: ReferencesCounter::countReferences(*_varDecl.value, ReferencesCounter::OnlyVariables))
+				if (!m_ssaValues.count(reference.first))
+					references[reference.first] = m_assignmentCounts[reference.first];
+	}
+}
+
+void RangeSimplifier::operator()(Assignment& _assignment)
+{
+	visit(*_assignment.value);
+	for (Identifier const& variable: _assignment.variableNames)
+		assigned(variable.name);
+}
+
+void RangeSimplifier::operator()(If& _if)
+{
+	visit(*_if.condition);
+
+	Facts before = m_facts;
+	addFacts(*_if.condition, true);
+	(*this)(_if.body);
+	if (flowsOut(_if.body))
+	{
+		Facts afterBody = move(m_facts);
+		m_facts = move(before);
+		m_facts.intersect(afterBody);
+	}
+	else
+	{
+		// The code after the if statement is only reached if the condition is false.
+		m_facts = move(before);
+		addFacts(*_if.condition, false);
+	}
+}
+
+void RangeSimplifier::operator()(Switch& _switch)
+{
+	visit(*_switch.expression);
+
+	optional<Term> expression = term(*_switch.expression);
+	Facts before = m_facts;
+	optional<Facts> after;
+	bool hasDefault = false;
+	for (Case& switchCase: _switch.cases)
+	{
+		m_facts = before;
+		if (!switchCase.value)
+			hasDefault = true;
+		else if (expression)
+		{
+			Term value = valueOfLiteral(*switchCase.value);
+			addLessOrEqual(*expression, value);
+			addLessOrEqual(value, *expression);
+		}
+		(*this)(switchCase.body);
+		if (flowsOut(switchCase.body))
+		{
+			if (after)
+				after->intersect(m_facts);
+			else
+				after = m_facts;
+		}
+	}
+	if (!hasDefault)
+	{
+		if (after)
+			after->intersect(before);
+		else
+			after = before;
+	}
+	m_facts = after ? move(*after) : move(before);
+}
+
+void RangeSimplifier::operator()(ForLoop& _forLoop)
+{
+	(*this)(_forLoop.pre);
+
+	// The facts valid at the start of each iteration are the ones about
+	// variables that are not assigned to inside of the loop.
+	for (YulString variable: assignedVariableNames(_forLoop.body) + assignedVariableNames(_forLoop.post))
+		assigned(variable);
+	Facts head = m_facts;
+
+	visit(*_forLoop.condition);
+	addFacts(*_forLoop.condition, true);
+
+	m_continueFacts.emplace_back();
+	(*this)(_forLoop.body);
+	optional<Facts> post = move(m_continueFacts.back());
+	m_continueFacts.pop_back();
+	if (flowsOut(_forLoop.body))
+	{
+		if (post)
+			post->intersect(m_facts);
+		else
+			post = m_facts;
+	}
+
+	m_facts = post ? move(*post) : head;
+	(*this)(_forLoop.post);
+
+	m_facts = move(head);
+}
+
+void RangeSimplifier::operator()(Continue&)
+{
+	if (m_continueFacts.empty())
+		return;
+	optional<Facts>& facts = m_continueFacts.back();
+	if (facts)
+		facts->intersect(m_facts);
+	else
+		facts = m_facts;
+}
+
+void RangeSimplifier::operator()(FunctionDefinition& _funDef)
+{
+	Facts outerFacts = move(m_facts);
+	vector<optional<Facts>> outerContinueFacts = move(m_continueFacts);
+	m_facts = {};
+	m_continueFacts.clear();
+
+	ASTModifier::operator()(_funDef);
+
+	m_facts = move(outerFacts);
+	m_continueFacts = move(outerContinueFacts);
+}
+
+void RangeSimplifier::visit(Expression& _expression)
+{
+	ASTModifier::visit(_expression);
+	if (optional<bool> value = evaluate(_expression))
+		_expression = Literal{debugDataOf(_expression), LiteralKind::Number, YulString{*value ? "1" : "0"}, {}};
+}
+
+void RangeSimplifier::Facts::forget(YulString _variable)
+{
+	for (auto it = lessThan.begin(); it != lessThan.end();)
+		if (it->first == _variable || it->second == _variable)
+			it = lessThan.erase(it);
+		else
+			++it;
+	lowerBounds.erase(_variable);
+	upperBounds.erase(_variable);
+}
+
+void RangeSimplifier::Facts::intersect(Facts const& _other)
+{
+	for (auto it = lessThan.begin(); it != lessThan.end();)
+		if (!_other.lessThan.count(*it))
+			it = lessThan.erase(it);
+		else
+			++it;
+	for (auto it = lowerBounds.begin(); it != lowerBounds.end();)
+		if (auto otherBound = _other.lowerBounds.find(it->first); otherBound != _other.lowerBounds.end())
+		{
+			it->second = min(it->second, otherBound->second);
+			++it;
+		}
+		else
+			it = lowerBounds.erase(it);
+	for (auto it = upperBounds.begin(); it != upperBounds.end();)
+		if (auto otherBound = _other.upperBounds.find(it->first); otherBound != _other.upperBounds.end())
+		{
+			it->second = max(it->second, otherBound->second);
+			++it;
+		}
+		else
+			it = upperBounds.erase(it);
+}
+
+void RangeSimplifier::addFacts(Expression const& _condition, bool _value, size_t _depth)
+{
+	if (_depth > maxConditionDepth)
+		return;
+
+	if (Identifier const* identifier = get_if<Identifier>(&_condition))
+	{
+		if (_value)
+			addLessThan(u256(0), identifier->name);
+		else
+			addLessOrEqual(identifier->name, u256(0));
+		if (Expression const* value = ssaValue(identifier->name))
+			addFacts(*value, _value, _depth + 1);
+		return;
+	}
+
+	auto instruction = SimplificationRules::instructionAndArguments(m_dialect, _condition);
+	if (!instruction)
+		return;
+	vector<Expression> const& arguments = *instruction->second;
+	if (instruction->first == evmasm::Instruction::ISZERO)
+	{
+		addFacts(arguments.front(), !_value, _depth + 1);
+		return;
+	}
+	if (arguments.size() != 2)
+		return;
+	optional<Term> a = term(arguments[0]);
+	optional<Term> b = term(arguments[1]);
+	if (!a || !b)
+		return;
+
+	switch (instruction->first)
+	{
+	case evmasm::Instruction::LT:
+		if (_value)
+			addLessThan(*a, *b);
+		else
+			addLessOrEqual(*b, *a);
+		break;
+	case evmasm::Instruction::GT:
+		if (_value)
+			addLessThan(*b, *a);
+		else
+			addLessOrEqual(*a, *b);
+		break;
+	case evmasm::Instruction::EQ:
+		if (_value)
+		{
+			addLessOrEqual(*a, *b);
+			addLessOrEqual(*b, *a);
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+void RangeSimplifier::addLessThan(Term const& _a, Term const& _b)
+{
+	YulString const* a = get_if<YulString>(&_a);
+	YulString const* b = get_if<YulString>(&_b);
+	if (a && b)
+	{
+		if (*a != *b)
+			m_facts.lessThan.emplace(*a, *b);
+	}
+	else if (a)
+	{
+		// Otherwise the code is unreachable.
+		if (get<u256>(_b) > 0)
+			addLessOrEqual(_a, u256(get<u256>(_b) - 1));
+	}
+	else if (b)
+	{
+		if (get<u256>(_a) < numeric_limits<u256>::max())
+			addLessOrEqual(u256(get<u256>(_a) + 1), _b);
+	}
+}
+
+void RangeSimplifier::addLessOrEqual(Term const& _a, Term const& _b)
+{
+	if (YulString const* a = get_if<YulString>(&_a))
+	{
+		if (u256 const* b = get_if<u256>(&_b))
+		{
+			auto [bound, inserted] = m_facts.upperBounds.emplace(*a, *b);
+			if (!inserted)
+				bound->second = min(bound->second, *b);
+		}
+	}
+	else if (YulString const* b = get_if<YulString>(&_b))
+	{
+		auto [bound, inserted] = m_facts.lowerBounds.emplace(*b, get<u256>(_a));
+		if (!inserted)
+			bound->second = max(bound->second, get<u256>(_a));
+	}
+}
+
+optional<bool> RangeSimplifier::evaluate(Expression const& _expression) const
+{
+	auto instruction = SimplificationRules::instructionAndArguments(m_dialect, _expression);
+	if (!instruction)
+		return nullopt;
+	vector<Term> terms;
+	for (Expression const& argument: *instruction->second)
+		if (optional<Term> argumentTerm = term(argument))
+			terms.emplace_back(move(*argumentTerm));
+		else
+			return nullopt;
+
+	switch (instruction->first)
+	{
+	case evmasm::Instruction::LT:
+		if (knownLessThan(terms[0], terms[1]))
+			return true;
+		if (knownLessOrEqual(terms[1], terms[0]))
+			return false;
+		break;
+	case evmasm::Instruction::GT:
+		if (knownLessThan(terms[1], terms[0]))
+			return true;
+		if (knownLessOrEqual(terms[0], terms[1]))
+			return false;
+		break;
+	case evmasm::Instruction::EQ:
+		if (knownLessThan(terms[0], terms[1]) || knownLessThan(terms[1], terms[0]))
+			return false;
+		break;
+	case evmasm::Instruction::ISZERO:
+		if (lowerBound(terms[0]) > 0)
+			return false;
+		if (upperBound(terms[0]) == 0)
+			return true;
+		break;
+	default:
+		break;
+	}
+	return nullopt;
+}
+
+bool RangeSimplifier::knownLessThan(Term const& _a, Term const& _b) const
+{
+	if (holds_alternative<YulString>(_a) && holds_alternative<YulString>(_b))
+	{
+		if (_a == _b)
+			return false;
+		if (m_facts.lessThan.count({get<YulString>(_a), get<YulString>(_b)}))
+			return true;
+	}
+	return upperBound(_a) < lowerBound(_b);
+}
+
+bool RangeSimplifier::knownLessOrEqual(Term const& _a, Term const& _b) const
+{
+	return _a == _b || knownLessThan(_a, _b) || upperBound(_a) <= lowerBound(_b);
+}
+
+u256 RangeSimplifier::lowerBound(Term const& _term) const
+{
+	if (u256 const* value = get_if<u256>(&_term))
+		return *value;
+	YulString variable = get<YulString>(_term);
+
+	u256 bound = util::valueOrDefault(m_facts.lowerBounds, variable, u256(0));
+	for (auto const& [smaller, larger]: m_facts.lessThan)
+		if (larger == variable)
+		{
+			u256 smallerBound = util::valueOrDefault(m_facts.lowerBounds, smaller, u256(0));
+			if (smallerBound < numeric_limits<u256>::max())
+				bound = max(bound, u256(smallerBound + 1));
+		}
+	return bound;
+}
+
+u256 RangeSimplifier::upperBound(Term const& _term) const
+{
+	if (u256 const* value = get_if<u256>(&_term))
+		return *value;
+	YulString variable = get<YulString>(_term);
+
+	u256 bound = util::valueOrDefault(m_facts.upperBounds, variable, numeric_limits<u256>::max());
+	for (auto const& [smaller, larger]: m_facts.lessThan)
+		if (smaller == variable)
+		{
+			u256 largerBound = util::valueOrDefault(m_facts.upperBounds, larger, numeric_limits<u256>::max());
+			if (largerBound > 0)
+				bound = min(bound, u256(largerBound - 1));
+		}
+	return bound;
+}
+
+optional<RangeSimplifier::Term> RangeSimplifier::term(Expression const& _expression)
+{
+	if (Identifier const* identifier = get_if<Identifier>(&_expression))
+		return Term{identifier->name};
+	if (Literal const* literal = get_if<Literal>(&_expression))
+		return Term{valueOfLiteral(*literal)};
+	return nullopt;
+}
+
+Expression const* RangeSimplifier::ssaValue(YulString _variable) const
+{
+	auto value = m_ssaValues.find(_variable);
+	auto references = m_ssaReferences.find(_variable);
+	if (value == m_ssaValues.end() || references == m_ssaReferences.end())
+		return nullptr;
+	for (auto const& [reference, count]: references->second)
+		if (util::valueOrDefault(m_assignmentCounts, reference, size_t(0)) != count)
+			return nullptr;
+	return value->second;
+}
+
+void RangeSimplifier::assigned(YulString _variable)
+{
+	m_facts.forget(_variable);
+	++m_assignmentCounts[_variable];
+}
+
+bool RangeSimplifier::flowsOut(Block const& _block) const
+{
+	TerminationFinder terminationFinder{m_dialect, &m_controlFlowSideEffects};
+	return terminationFinder.firstUnconditionalControlFlowChange(_block.statements).first == TerminationFinder::ControlFlow::FlowOut;
+}
@@ -0,0 +1,151 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimisation stage that replaces comparisons by constants if the ranges of the
+ * compared values are known from the conditions of enclosing statements.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/ControlFlowSideEffects.h>
+
+#include <libsolutil/Numeric.h>
+
+#include <map>
+#include <optional>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace solidity::yul
+{
+struct Dialect;
+
+/**
+ * Optimisation stage that replaces ``lt``, ``gt``, ``eq`` and ``iszero`` of variables and
+ * constants by ``1`` or ``0`` if their result follows from the conditions that hold
+ * at that point of the code.
+ *
+ * The conditions are collected from ``if``, ``switch`` and ``for`` statements:
+ * Inside of ``if lt(i, n) { ... }`` it is known that ``i < n``, and so it is after
+ * ``if iszero(lt(i, n)) { break }``, because the body of the ``if`` does not continue.
+ * The conditions of a ``for`` loop hold in its body and, unless the body changes the
+ * variables or continues before the condition is established, in its post block.
+ * A condition can also be given as an SSA variable whose value is such a comparison.
+ *
+ * From ``i < n`` the step concludes, for example, that ``eq(i, not(0))`` is false,
+ * which removes the overflow check of ``i := add(i, 1)``, and that the bounds check
+ * ``iszero(lt(i, n))`` of an access to an array of length ``n`` is false.
+ * The ExpressionSimplifier and the StructuralSimplifier then remove the checks.
+ *
+ * Facts about a variable are forgotten when it is assigned to. The facts valid at the
+ * beginning of a loop are the ones about variables not assigned to inside of it.
+ *
+ * Only works for the EVM dialects.
+ *
+ * Works best after the ExpressionSimplifier computed constant operands and the
+ * CommonSubexpressionEliminator made equal values use the same variable.
+ *
+ * Prerequisite: Disambiguator, ForLoopInitRewriter.
+ */
+class RangeSimplifier: public ASTModifier
+{
+public:
+	static constexpr char const* name{"RangeSimplifier"};
+	static void run(OptimiserStepContext& _context, Block& _ast);
+
+	using ASTModifier::operator();
+	void operator()(VariableDeclaration& _varDecl) override;
+	void operator()(Assignment& _assignment) override;
+	void operator()(If& _if) override;
+	void operator()(Switch& _switch) override;
+	void operator()(ForLoop& _forLoop) override;
+	void operator()(Continue&) override;
+	void operator()(FunctionDefinition& _funDef) override;
+	void visit(Expression& _expression) override;
+
+private:
+	/// Operand of a comparison: a variable or a constant.
+	using Term = std::variant<YulString, u256>;
+
+	/// Relations known to hold between the current values of variables.
+	struct Facts
+	{
+		/// Pairs (a, b) of variables with a < b.
+		std::set<std::pair<YulString, YulString>> lessThan;
+		/// Inclusive bounds of the values of variables.
+		std::map<YulString, u256> lowerBounds;
+		std::map<YulString, u256> upperBounds;
+
+		/// Removes all facts involving @a _variable.
+		void forget(YulString _variable);
+		/// Keeps only the facts that also hold according to @a _other, i.e. the ones
+		/// that are valid after two branches of control flow join.
+		void intersect(Facts const& _other);
+	};
+
+	RangeSimplifier(
+		Dialect const& _dialect,
+		std::unordered_map<YulString, Expression const*> _ssaValues,
+		std::map<YulString, ControlFlowSideEffects> _controlFlowSideEffects
+	);
+
+	/// Records the facts following from @a _condition having the truth value @a _value.
+	void addFacts(Expression const& _condition, bool _value, size_t _depth = 0);
+	/// Records that @a _a < @a _b.
+	void addLessThan(Term const& _a, Term const& _b);
+	/// Records that @a _a <= @a _b, which is only kept if one of them is a constant.
+	void addLessOrEqual(Term const& _a, Term const& _b);
+
+	/// @returns the value of @a _expression if it is a comparison decided by the facts.
+	std::optional<bool> evaluate(Expression const& _expression) const;
+	bool knownLessThan(Term const& _a, Term const& _b) const;
+	bool knownLessOrEqual(Term const& _a, Term const& _b) const;
+	u256 lowerBound(Term const& _term) const;
+	u256 upperBound(Term const& _term) const;
+
+	/// @returns the operand @a _expression as a term, if it is a variable or a literal.
+	static std::optional<Term> term(Expression const& _expression);
+	/// @returns the value of the SSA variable @a _variable, if the variables it references are
+	/// still the ones it was computed from.
+	Expression const* ssaValue(YulString _variable) const;
+	/// Marks @a _variable as assigned to at the current point of the code.
+	void assigned(YulString _variable);
+	/// @returns true if control flow can continue after @a _block.
+	bool flowsOut(Block const& _block) const;
+
+	Dialect const& m_dialect;
+	/// Values of the variables that are never assigned to.
+	std::unordered_map<YulString, Expression const*> m_ssaValues;
+	std::map<YulString, ControlFlowSideEffects> m_controlFlowSideEffects;
+
+	Facts m_facts;
+	/// Number of assignments visited so far for each variable that is not an SSA variable.
+	std::map<YulString, size_t> m_assignmentCounts;
+	/// Assignment counts of the other variables referenced by the value of each SSA variable
+	/// at the time of its declaration.
+	std::map<YulString, std::map<YulString, size_t>> m_ssaReferences;
+	/// Facts that hold at the ``continue`` statements of the enclosing loops, if there are any.
+	std::vector<std::optional<Facts>> m_continueFacts;
+};
+
+}
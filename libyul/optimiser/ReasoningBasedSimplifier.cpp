@@ -18,8 +18,11 @@
 #include <libyul/optimiser/ReasoningBasedSimplifier.h>
 #include <libyul/optimiser/SMTSolver.h>
 
+#include <libyul/optimiser/ASTCopier.h>
+#include <libyul/optimiser/BlockHasher.h>
 #include <libyul/optimiser/SSAValueTracker.h>
 #include <libyul/optimiser/Semantics.h>
+#include <libyul/optimiser/SyntacticalEquality.h>
 #include <libyul/AST.h>
 #include <libyul/Dialect.h>
 
@@ -63,41 +66,67 @@ void ReasoningBasedSimplifier::operator()(If& _if)
 		return;
 
 	smtutil::Expression condition = encodeExpression(*_if.condition);
-	m_solver->push();
-	m_solver->addAssertion(condition == constantValue(0));
-	CheckResult result = m_solver->check({}).first;
-	m_solver->pop();
-	if (result == CheckResult::UNSATISFIABLE)
+	ConditionValue value = conditionValue(*_if.condition, condition);
+	if (value == ConditionValue::AlwaysTrue)
 	{
 		Literal trueCondition = m_dialect.trueLiteral();
 		trueCondition.debugData = debugDataOf(*_if.condition);
 		_if.condition = make_unique<yul::Expression>(move(trueCondition));
 	}
-	else
+	else if (value == ConditionValue::AlwaysFalse)
 	{
-		m_solver->push();
-		m_solver->addAssertion(condition != constantValue(0));
-		CheckResult result2 = m_solver->check({}).first;
-		m_solver->pop();
-		if (result2 == CheckResult::UNSATISFIABLE)
-		{
-			Literal falseCondition = m_dialect.zeroLiteralForType(m_dialect.boolType);
-			falseCondition.debugData = debugDataOf(*_if.condition);
-			_if.condition = make_unique<yul::Expression>(move(falseCondition));
-			_if.body = yul::Block{};
-			// Nothing left to be done.
-			return;
-		}
+		Literal falseCondition = m_dialect.zeroLiteralForType(m_dialect.boolType);
+		falseCondition.debugData = debugDataOf(*_if.condition);
+		_if.condition = make_unique<yul::Expression>(move(falseCondition));
+		_if.body = yul::Block{};
+		// Nothing left to be done.
+		return;
 	}
 
 	m_solver->push();
 	m_solver->addAssertion(condition != constantValue(0));
+	++m_pathCount;
+	ScopedSaveAndRestore currentPath(m_currentPath, size_t{m_pathCount});
 
 	ASTModifier::operator()(_if.body);
 
 	m_solver->pop();
 }
 
+ReasoningBasedSimplifier::ConditionValue ReasoningBasedSimplifier::conditionValue(
+	yul::Expression const& _condition,
+	smtutil::Expression const& _encodedCondition
+)
+{
+	// Declarations only add constraints for new variables, so the value of a condition
+	// stays the same under the same path condition.
+	auto& cachedValues = m_conditionCache[{m_currentPath, ExpressionHasher::run(_condition)}];
+	for (auto const& [cachedCondition, cachedValue]: cachedValues)
+		if (SyntacticallyEqual{}(cachedCondition, _condition))
+			return cachedValue;
+
+	ConditionValue value = ConditionValue::Unknown;
+	if (check(_encodedCondition == constantValue(0)) == CheckResult::UNSATISFIABLE)
+		value = ConditionValue::AlwaysTrue;
+	else if (check(_encodedCondition != constantValue(0)) == CheckResult::UNSATISFIABLE)
+		value = ConditionValue::AlwaysFalse;
+	cachedValues.emplace_back(ASTCopier{}.translate(_condition), value);
+	return value;
+}
+
+CheckResult ReasoningBasedSimplifier::check(smtutil::Expression const& _assertion)
+{
+	if (m_remainingQueries == 0)
+		return CheckResult::UNKNOWN;
+	--m_remainingQueries;
+
+	m_solver->push();
+	m_solver->addAssertion(_assertion);
+	CheckResult result = m_solver->check({}).first;
+	m_solver->pop();
+	return result;
+}
+
 ReasoningBasedSimplifier::ReasoningBasedSimplifier(
 	Dialect const& _dialect,
 	set<YulString> const& _ssaVariables
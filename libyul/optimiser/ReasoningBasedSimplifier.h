@@ -25,6 +25,8 @@
 #include <libyul/backends/evm/EVMDialect.h>
 
 #include <map>
+#include <utility>
+#include <vector>
 
 namespace solidity::smtutil
 {
@@ -43,6 +45,10 @@ namespace solidity::yul
  * - If `constraints AND NOT condition` is UNSAT, the condition is always true and can be replaced by `1`.
  * The simplifications above can only be applied if the condition is movable.
  *
+ * The answers are cached for syntactically equal conditions under the same path condition,
+ * i.e. inside the same ``if`` body. At most ``maxSolverQueries`` queries are sent to the solver,
+ * the conditions after that are left unchanged.
+ *
  * It is only effective on the EVM dialect, but safe to use on other dialects.
  *
  * Prerequisite: Disambiguator, SSATransform.
@@ -51,6 +57,8 @@ class ReasoningBasedSimplifier: public ASTModifier, SMTSolver
 {
 public:
 	static constexpr char const* name{"ReasoningBasedSimplifier"};
+	/// Maximum number of solver queries per run of the step.
+	static constexpr size_t maxSolverQueries = 2000;
 	static void run(OptimiserStepContext& _context, Block& _ast);
 	static std::optional<std::string> invalidInCurrentEnvironment();
 
@@ -64,12 +72,27 @@ private:
 		std::set<YulString> const& _ssaVariables
 	);
 
+	enum class ConditionValue { AlwaysTrue, AlwaysFalse, Unknown };
+
+	/// @returns whether the condition @a _condition, encoded as @a _encodedCondition, is constant
+	/// under the current path condition.
+	ConditionValue conditionValue(Expression const& _condition, smtutil::Expression const& _encodedCondition);
+	/// @returns the result of the solver for @a _assertion under the current path condition,
+	/// or unknown if the query budget is exhausted.
+	smtutil::CheckResult check(smtutil::Expression const& _assertion);
+
 	smtutil::Expression encodeEVMBuiltin(
 		evmasm::Instruction _instruction,
 		std::vector<Expression> const& _arguments
 	) override;
 
 	Dialect const& m_dialect;
+	/// Identifier of the current path condition, i.e. of the innermost ``if`` body being visited.
+	size_t m_currentPath = 0;
+	size_t m_pathCount = 0;
+	/// Values of the conditions checked so far, by path and hash of the condition.
+	std::map<std::pair<size_t, uint64_t>, std::vector<std::pair<Expression, ConditionValue>>> m_conditionCache;
+	size_t m_remainingQueries = maxSolverQueries;
 };
 
 }
@@ -79,7 +79,7 @@ protected:
 	using ASTModifier::visit;
 	void visit(Expression& _e) override;
 
-	std::map<YulString, size_t> m_referenceCounts;
+	std::unordered_map<YulString, size_t> m_referenceCounts;
 	std::set<YulString> m_varsToAlwaysRematerialize;
 	bool m_onlySelectedVariables = false;
 };
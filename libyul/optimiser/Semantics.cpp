@@ -22,6 +22,7 @@
 #include <libyul/optimiser/Semantics.h>
 
 #include <libyul/optimiser/OptimizerUtilities.h>
+#include <libyul/Utilities.h>
 #include <libyul/Exceptions.h>
 #include <libyul/AST.h>
 #include <libyul/Dialect.h>
@@ -149,6 +150,152 @@ map<YulString, SideEffects> SideEffectsPropagator::sideEffects(
 	return ret;
 }
 
+map<YulString, set<u256>> StorageWriteCollector::writtenSlots(Dialect const& _dialect, Block const& _ast)
+{
+	Writes outsideOfFunctions;
+	StorageWriteCollector collector{_dialect, outsideOfFunctions};
+	collector(_ast);
+
+	map<YulString, Writes>& functionWrites = collector.m_functionWrites;
+	for (auto& [name, writes]: functionWrites)
+		collector.resolveSlotVariables(writes);
+
+	// Add the slots written by the called functions until nothing changes.
+	bool changed = true;
+	while (changed)
+	{
+		changed = false;
+		for (auto& [name, writes]: functionWrites)
+			if (!writes.unknown)
+				for (YulString callee: writes.calledFunctions)
+				{
+					auto calleeWrites = functionWrites.find(callee);
+					if (calleeWrites == functionWrites.end() || calleeWrites->second.unknown)
+					{
+						writes.unknown = true;
+						changed = true;
+						break;
+					}
+					for (u256 const& slot: calleeWrites->second.slots)
+						if (writes.slots.insert(slot).second)
+							changed = true;
+				}
+	}
+
+	map<YulString, set<u256>> result;
+	for (auto& [name, writes]: functionWrites)
+		if (!writes.unknown)
+			result[name] = move(writes.slots);
+	return result;
+}
+
+optional<set<u256>> StorageWriteCollector::writtenSlots(
+	Dialect const& _dialect,
+	Expression const& _expression,
+	map<YulString, set<u256>> const& _functionSlots
+)
+{
+	Writes writes;
+	StorageWriteCollector collector{_dialect, writes};
+	collector.visit(_expression);
+	// The values of the variables are not known here.
+	return collector.knownSlots(writes, _functionSlots);
+}
+
+optional<set<u256>> StorageWriteCollector::writtenSlots(
+	Dialect const& _dialect,
+	ForLoop const& _forLoop,
+	map<YulString, set<u256>> const& _functionSlots,
+	map<YulString, u256> const& _constantVariables
+)
+{
+	Writes writes;
+	StorageWriteCollector collector{_dialect, writes};
+	collector.m_literalValues = _constantVariables;
+	collector(_forLoop);
+	return collector.knownSlots(writes, _functionSlots);
+}
+
+void StorageWriteCollector::operator()(FunctionDefinition const& _function)
+{
+	ScopedSaveAndRestore currentWrites(m_currentWrites, &m_functionWrites[_function.name]);
+	ASTWalker::operator()(_function);
+}
+
+void StorageWriteCollector::operator()(VariableDeclaration const& _varDecl)
+{
+	if (_varDecl.variables.size() == 1 && _varDecl.value)
+		if (Literal const* literal = get_if<Literal>(_varDecl.value.get()))
+			m_literalValues[_varDecl.variables.front().name] = valueOfLiteral(*literal);
+	ASTWalker::operator()(_varDecl);
+}
+
+void StorageWriteCollector::operator()(Assignment const& _assignment)
+{
+	for (Identifier const& variable: _assignment.variableNames)
+		m_assignedVariables.insert(variable.name);
+	ASTWalker::operator()(_assignment);
+}
+
+void StorageWriteCollector::operator()(FunctionCall const& _functionCall)
+{
+	ASTWalker::operator()(_functionCall);
+
+	BuiltinFunction const* builtin = m_dialect.builtin(_functionCall.functionName.name);
+	if (!builtin)
+	{
+		m_currentWrites->calledFunctions.insert(_functionCall.functionName.name);
+		return;
+	}
+	if (builtin->sideEffects.storage != SideEffects::Write)
+		return;
+
+	if (builtin == m_dialect.storageStoreFunction(YulString{}))
+	{
+		Expression const& slot = _functionCall.arguments.front();
+		if (Literal const* literal = get_if<Literal>(&slot))
+		{
+			m_currentWrites->slots.insert(valueOfLiteral(*literal));
+			return;
+		}
+		else if (Identifier const* identifier = get_if<Identifier>(&slot))
+		{
+			m_currentWrites->slotVariables.insert(identifier->name);
+			return;
+		}
+	}
+	m_currentWrites->unknown = true;
+}
+
+void StorageWriteCollector::resolveSlotVariables(Writes& _writes) const
+{
+	for (YulString variable: _writes.slotVariables)
+		if (m_literalValues.count(variable) && !m_assignedVariables.count(variable))
+			_writes.slots.insert(m_literalValues.at(variable));
+		else
+			_writes.unknown = true;
+	_writes.slotVariables.clear();
+}
+
+optional<set<u256>> StorageWriteCollector::knownSlots(
+	Writes& _writes,
+	map<YulString, set<u256>> const& _functionSlots
+) const
+{
+	resolveSlotVariables(_writes);
+	if (_writes.unknown)
+		return nullopt;
+
+	for (YulString function: _writes.calledFunctions)
+	{
+		auto slots = _functionSlots.find(function);
+		if (slots == _functionSlots.end())
+			return nullopt;
+		_writes.slots += slots->second;
+	}
+	return _writes.slots;
+}
+
 MovableChecker::MovableChecker(Dialect const& _dialect, Expression const& _expression):
 	MovableChecker(_dialect)
 {
@@ -26,6 +26,10 @@
 #include <libyul/optimiser/CallGraphGenerator.h>
 #include <libyul/AST.h>
 
+#include <libsolutil/Numeric.h>
+
+#include <map>
+#include <optional>
 #include <set>
 
 namespace solidity::yul
@@ -130,6 +134,76 @@ public:
 	);
 };
 
+/**
+ * Class that can be used to determine the storage slots written by user-defined functions,
+ * including through the functions they call.
+ *
+ * The slots are only known for functions that write to storage exclusively through the
+ * storage store function of the dialect with constant slots, i.e. literals or variables
+ * that are only ever assigned a literal. This allows keeping the knowledge about other slots
+ * across calls to such functions.
+ *
+ * Prerequisite: Disambiguator
+ */
+class StorageWriteCollector: public ASTWalker
+{
+public:
+	/// @returns the slots written by the functions in @a _ast whose slots are known.
+	/// Functions that do not write to storage at all are contained with an empty set.
+	static std::map<YulString, std::set<u256>> writtenSlots(Dialect const& _dialect, Block const& _ast);
+	/// @returns the storage slots written by @a _expression, given the slots written by
+	/// functions as returned by the function above, or nullopt if they are not known.
+	static std::optional<std::set<u256>> writtenSlots(
+		Dialect const& _dialect,
+		Expression const& _expression,
+		std::map<YulString, std::set<u256>> const& _functionSlots
+	);
+	/// @returns the storage slots written by @a _forLoop, given the slots written by functions
+	/// and the values of the variables declared outside of it that are never re-assigned,
+	/// or nullopt if they are not known.
+	static std::optional<std::set<u256>> writtenSlots(
+		Dialect const& _dialect,
+		ForLoop const& _forLoop,
+		std::map<YulString, std::set<u256>> const& _functionSlots,
+		std::map<YulString, u256> const& _constantVariables
+	);
+
+	using ASTWalker::operator();
+	void operator()(FunctionDefinition const& _function) override;
+	void operator()(VariableDeclaration const& _varDecl) override;
+	void operator()(Assignment const& _assignment) override;
+	void operator()(FunctionCall const& _functionCall) override;
+
+private:
+	/// Storage writes of a piece of code, not taking the called functions into account.
+	struct Writes
+	{
+		std::set<u256> slots;
+		/// Variables used as slots, resolved once all assignments are known.
+		std::set<YulString> slotVariables;
+		std::set<YulString> calledFunctions;
+		bool unknown = false;
+	};
+
+	explicit StorageWriteCollector(Dialect const& _dialect, Writes& _writes):
+		m_dialect(_dialect), m_currentWrites(&_writes)
+	{}
+	/// Replaces the slot variables of @a _writes by their values, if they are constant.
+	void resolveSlotVariables(Writes& _writes) const;
+	/// @returns the slots of @a _writes including those written by the called functions,
+	/// or nullopt if they are not known.
+	std::optional<std::set<u256>> knownSlots(
+		Writes& _writes,
+		std::map<YulString, std::set<u256>> const& _functionSlots
+	) const;
+
+	Dialect const& m_dialect;
+	Writes* m_currentWrites = nullptr;
+	std::map<YulString, Writes> m_functionWrites;
+	std::map<YulString, u256> m_literalValues;
+	std::set<YulString> m_assignedVariables;
+};
+
 /**
  * Class that can be used to find out if certain code contains the MSize instruction
  * or a verbatim bytecode builtin (which is always assumed that it could contain MSize).
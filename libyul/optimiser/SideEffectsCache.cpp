@@ -0,0 +1,70 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Cache for the side effects of the functions in an AST during an optimiser sequence.
+ */
+
+#include <libyul/optimiser/SideEffectsCache.h>
+
+#include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/optimiser/Semantics.h>
+#include <libyul/ControlFlowSideEffectsCollector.h>
+#include <libyul/AST.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+
+map<YulString, SideEffects> SideEffectsCache::functionSideEffects(
+	OptimiserStepContext const& _context,
+	Block const& _ast
+)
+{
+	auto compute = [&]() {
+		return SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast));
+	};
+	if (!_context.sideEffectsCache)
+		return compute();
+	optional<map<YulString, SideEffects>>& cached = _context.sideEffectsCache->m_functionSideEffects;
+	if (!cached)
+		cached = compute();
+	return *cached;
+}
+
+map<YulString, ControlFlowSideEffects> SideEffectsCache::controlFlowSideEffects(
+	OptimiserStepContext const& _context,
+	Block const& _ast
+)
+{
+	auto compute = [&]() {
+		return ControlFlowSideEffectsCollector{_context.dialect, _ast}.functionSideEffectsNamed();
+	};
+	if (!_context.sideEffectsCache)
+		return compute();
+	optional<map<YulString, ControlFlowSideEffects>>& cached = _context.sideEffectsCache->m_controlFlowSideEffects;
+	if (!cached)
+		cached = compute();
+	return *cached;
+}
+
+void SideEffectsCache::invalidate()
+{
+	m_functionSideEffects.reset();
+	m_controlFlowSideEffects.reset();
+}
@@ -0,0 +1,69 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Cache for the side effects of the functions in an AST during an optimiser sequence.
+ */
+
+#pragma once
+
+#include <libyul/ASTForward.h>
+#include <libyul/ControlFlowSideEffects.h>
+#include <libyul/SideEffects.h>
+#include <libyul/YulString.h>
+
+#include <map>
+#include <optional>
+
+namespace solidity::yul
+{
+
+struct OptimiserStepContext;
+
+/**
+ * Keeps the side effects of the functions in the AST an optimiser sequence is run on,
+ * so that steps running one after the other without changing the code in between
+ * do not have to compute them again.
+ *
+ * The optimiser suite invalidates the cache whenever a step changed the AST.
+ * Steps may only query it before they modify the AST.
+ */
+class SideEffectsCache
+{
+public:
+	/// @returns the side effects of the user-defined functions in @a _ast as computed by the
+	/// SideEffectsPropagator, taking them from the cache of @a _context if it has one.
+	static std::map<YulString, SideEffects> functionSideEffects(
+		OptimiserStepContext const& _context,
+		Block const& _ast
+	);
+	/// @returns the control flow side effects of the user-defined functions in @a _ast as computed
+	/// by the ControlFlowSideEffectsCollector, taking them from the cache of @a _context if it has one.
+	static std::map<YulString, ControlFlowSideEffects> controlFlowSideEffects(
+		OptimiserStepContext const& _context,
+		Block const& _ast
+	);
+
+	/// Has to be called whenever the AST changed.
+	void invalidate();
+
+private:
+	std::optional<std::map<YulString, SideEffects>> m_functionSideEffects;
+	std::optional<std::map<YulString, ControlFlowSideEffects>> m_controlFlowSideEffects;
+};
+
+}
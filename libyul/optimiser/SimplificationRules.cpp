@@ -40,14 +40,15 @@ using namespace solidity::yul;
 SimplificationRules::Rule const* SimplificationRules::findFirstMatch(
 	Expression const& _expr,
 	Dialect const& _dialect,
-	map<YulString, AssignedValue> const& _ssaValues
+	unordered_map<YulString, AssignedValue> const& _ssaValues
 )
 {
 	auto instruction = instructionAndArguments(_dialect, _expr);
 	if (!instruction)
 		return nullptr;
 
-	static std::map<std::optional<EVMVersion>, std::unique_ptr<SimplificationRules>> evmRules;
+	// The rules store the state of the current match, so each thread needs its own copy.
+	static thread_local std::map<std::optional<EVMVersion>, std::unique_ptr<SimplificationRules>> evmRules;
 
 	std::optional<EVMVersion> version;
 	if (yul::EVMDialect const* evmDialect = dynamic_cast<yul::EVMDialect const*>(&_dialect))
@@ -59,8 +60,29 @@ SimplificationRules::Rule const* SimplificationRules::findFirstMatch(
 	SimplificationRules& rules = *evmRules[version];
 	assertThrow(rules.isInitialized(), OptimizerException, "Rule list not properly initialized.");
 
-	for (auto const& rule: rules.m_rules[uint8_t(instruction->first)])
+	vector<Rule> const& candidateRules = rules.m_rules[uint8_t(instruction->first)];
+	vector<ArgumentIndex> const& argumentIndices = rules.m_argumentIndices[uint8_t(instruction->first)];
+	if (candidateRules.empty())
+		return nullptr;
+	assertThrow(argumentIndices.size() == instruction->second->size(), OptimizerException, "");
+
+	boost::dynamic_bitset<> candidates(candidateRules.size());
+	candidates.set();
+	for (size_t i = 0; i < argumentIndices.size(); ++i)
+	{
+		Expression const& argument = instruction->second->at(i);
+		// Patterns reject direct function calls as arguments (see Pattern::matches).
+		if (holds_alternative<FunctionCall>(argument))
+			return nullptr;
+		candidates &= argumentIndices[i].acceptedBy(argument, _dialect, _ssaValues);
+		if (candidates.none())
+			return nullptr;
+	}
+
+	// The candidates are tried in the order of the rule list, so the first match stays the same.
+	for (size_t index = candidates.find_first(); index != boost::dynamic_bitset<>::npos; index = candidates.find_next(index))
 	{
+		Rule const& rule = candidateRules[index];
 		rules.resetMatchGroups();
 		if (rule.pattern.matches(_expr, _dialect, _ssaValues))
 			if (!rule.feasible || rule.feasible())
@@ -97,6 +119,73 @@ void SimplificationRules::addRule(Rule const& _rule)
 	m_rules[uint8_t(_rule.pattern.instruction())].push_back(_rule);
 }
 
+void SimplificationRules::buildArgumentIndices()
+{
+	for (size_t instruction = 0; instruction < 256; ++instruction)
+	{
+		vector<Rule> const& rules = m_rules[instruction];
+		if (rules.empty())
+			continue;
+
+		boost::dynamic_bitset<> const noRules(rules.size());
+		vector<ArgumentIndex>& indices = m_argumentIndices[instruction];
+		indices.resize(rules.front().pattern.arguments().size(), ArgumentIndex{noRules, noRules, {}, {}});
+		for (size_t ruleIndex = 0; ruleIndex < rules.size(); ++ruleIndex)
+		{
+			vector<Pattern> arguments = rules[ruleIndex].pattern.arguments();
+			assertThrow(arguments.size() == indices.size(), OptimizerException, "");
+			for (size_t i = 0; i < arguments.size(); ++i)
+			{
+				ArgumentIndex& index = indices[i];
+				switch (arguments[i].kind())
+				{
+				case PatternKind::Any:
+					index.any.set(ruleIndex);
+					break;
+				case PatternKind::Constant:
+					if (u256 const* value = arguments[i].constantValue())
+						index.constantValues.try_emplace(*value, noRules).first->second.set(ruleIndex);
+					else
+						index.constant.set(ruleIndex);
+					break;
+				case PatternKind::Operation:
+					index.operations.try_emplace(arguments[i].instruction(), noRules).first->second.set(ruleIndex);
+					break;
+				}
+			}
+		}
+	}
+}
+
+boost::dynamic_bitset<> SimplificationRules::ArgumentIndex::acceptedBy(
+	Expression const& _argument,
+	Dialect const& _dialect,
+	unordered_map<YulString, AssignedValue> const& _ssaValues
+) const
+{
+	// Resolves variables like Pattern::matches does for constants and operations.
+	Expression const* value = &_argument;
+	if (Identifier const* identifier = get_if<Identifier>(&_argument))
+		if (AssignedValue const* assignedValue = util::valueOrNullptr(_ssaValues, identifier->name))
+			if (assignedValue->value)
+				value = assignedValue->value;
+
+	boost::dynamic_bitset<> accepted = any;
+	if (Literal const* literal = get_if<Literal>(value))
+	{
+		if (literal->kind == LiteralKind::Number)
+		{
+			accepted |= constant;
+			if (auto const* rules = util::valueOrNullptr(constantValues, valueOfNumberLiteral(*literal)))
+				accepted |= *rules;
+		}
+	}
+	else if (auto operation = instructionAndArguments(_dialect, *value))
+		if (auto const* rules = util::valueOrNullptr(operations, operation->first))
+			accepted |= *rules;
+	return accepted;
+}
+
 SimplificationRules::SimplificationRules(std::optional<langutil::EVMVersion> _evmVersion)
 {
 	// Multiple occurrences of one of these inside one rule must match the same equivalence class.
@@ -119,6 +208,7 @@ SimplificationRules::SimplificationRules(std::optional<langutil::EVMVersion> _ev
 
 	addRules(simplificationRuleList(_evmVersion, A, B, C, W, X, Y, Z));
 	assertThrow(isInitialized(), OptimizerException, "Rule list not properly initialized.");
+	buildArgumentIndices();
 }
 
 yul::Pattern::Pattern(evmasm::Instruction _instruction, initializer_list<Pattern> _arguments):
@@ -137,7 +227,7 @@ void Pattern::setMatchGroup(unsigned _group, map<unsigned, Expression const*>& _
 bool Pattern::matches(
 	Expression const& _expr,
 	Dialect const& _dialect,
-	map<YulString, AssignedValue> const& _ssaValues
+	unordered_map<YulString, AssignedValue> const& _ssaValues
 ) const
 {
 	Expression const* expr = &_expr;
@@ -31,8 +31,12 @@
 #include <liblangutil/EVMVersion.h>
 #include <liblangutil/SourceLocation.h>
 
+#include <boost/dynamic_bitset.hpp>
+
 #include <functional>
+#include <map>
 #include <optional>
+#include <unordered_map>
 #include <vector>
 
 namespace solidity::yul
@@ -61,7 +65,7 @@ public:
 	static Rule const* findFirstMatch(
 		Expression const& _expr,
 		Dialect const& _dialect,
-		std::map<YulString, AssignedValue> const& _ssaValues
+		std::unordered_map<YulString, AssignedValue> const& _ssaValues
 	);
 
 	/// Checks whether the rulelist is non-empty. This is usually enforced
@@ -72,13 +76,40 @@ public:
 	instructionAndArguments(Dialect const& _dialect, Expression const& _expr);
 
 private:
+	/// The rules of one root instruction that accept an argument at one position, depending on
+	/// the argument. Classifying each argument of an expression once and intersecting the rules
+	/// accepting them avoids trying all rules of the instruction one after the other.
+	struct ArgumentIndex
+	{
+		/// @returns the rules whose pattern at this position can match @a _argument,
+		/// which must not be a function call.
+		boost::dynamic_bitset<> acceptedBy(
+			Expression const& _argument,
+			Dialect const& _dialect,
+			std::unordered_map<YulString, AssignedValue> const& _ssaValues
+		) const;
+
+		/// Rules accepting any argument.
+		boost::dynamic_bitset<> any;
+		/// Rules accepting any number literal.
+		boost::dynamic_bitset<> constant;
+		/// Rules accepting a number literal of a specific value.
+		std::map<u256, boost::dynamic_bitset<>> constantValues;
+		/// Rules accepting a call of a specific instruction.
+		std::map<evmasm::Instruction, boost::dynamic_bitset<>> operations;
+	};
+
 	void addRules(std::vector<Rule> const& _rules);
 	void addRule(Rule const& _rule);
+	/// Fills m_argumentIndices from m_rules.
+	void buildArgumentIndices();
 
 	void resetMatchGroups() { m_matchGroups.clear(); }
 
 	std::map<unsigned, Expression const*> m_matchGroups;
 	std::vector<evmasm::SimplificationRule<Pattern>> m_rules[256];
+	/// The index of the rules in m_rules for each argument position of each root instruction.
+	std::vector<ArgumentIndex> m_argumentIndices[256];
 };
 
 enum class PatternKind
@@ -118,10 +149,13 @@ public:
 	bool matches(
 		Expression const& _expr,
 		Dialect const& _dialect,
-		std::map<YulString, AssignedValue> const& _ssaValues
+		std::unordered_map<YulString, AssignedValue> const& _ssaValues
 	) const;
 
 	std::vector<Pattern> arguments() const { return m_arguments; }
+	PatternKind kind() const { return m_kind; }
+	/// @returns the value a constant pattern requires, or nullptr if it matches any constant.
+	u256 const* constantValue() const { return m_data.get(); }
 
 	/// @returns the data of the matched expression if this pattern is part of a match group.
 	u256 d() const;
@@ -28,6 +28,8 @@
 #include <libyul/optimiser/Semantics.h>
 
 #include <libyul/backends/evm/ControlFlowGraphBuilder.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/EVMMetrics.h>
 #include <libyul/backends/evm/StackHelpers.h>
 #include <libyul/backends/evm/StackLayoutGenerator.h>
 
@@ -40,6 +42,11 @@
 
 #include <libsolutil/CommonData.h>
 
+#include <range/v3/range/conversion.hpp>
+#include <range/v3/view/map.hpp>
+
+#include <limits>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
@@ -47,6 +54,26 @@ using namespace solidity::yul;
 namespace
 {
 
+/// Approximate number of iterations of a loop, by which the runtime costs of evaluating
+/// an expression inside instead of outside of the loop are multiplied.
+size_t constexpr loopIterationEstimate = 10;
+
+/// Costs of rematerialising a variable: The estimated runtime gas added by evaluating its value
+/// in loops it was declared outside of, and the code cost of its value times its number of references.
+/// Candidates are compared lexicographically, so variables whose rematerialisation does not move
+/// computations into loops are always preferred and otherwise ranked by their code cost.
+using RematCost = pair<size_t, size_t>;
+
+size_t saturatingAdd(size_t _a, size_t _b)
+{
+	return _a > numeric_limits<size_t>::max() - _b ? numeric_limits<size_t>::max() : _a + _b;
+}
+
+size_t saturatingMul(size_t _a, size_t _b)
+{
+	return _b != 0 && _a > numeric_limits<size_t>::max() / _b ? numeric_limits<size_t>::max() : _a * _b;
+}
+
 /**
  * Class that discovers all variables that can be fully eliminated by rematerialization,
  * and the corresponding approximate costs.
@@ -59,15 +86,19 @@ public:
 	/// @returns a map from rematerialisation costs to a vector of variables to rematerialise
 	/// and variables that occur in their expression.
 	/// While the map is sorted by cost, the contained vectors are sorted by the order of occurrence.
-	map<size_t, vector<tuple<YulString, set<YulString>>>> candidates()
+	map<RematCost, vector<tuple<YulString, set<YulString>>>> candidates()
 	{
-		map<size_t, vector<tuple<YulString, set<YulString>>>> cand;
+		map<RematCost, vector<tuple<YulString, set<YulString>>>> cand;
 		for (auto const& candidate: m_candidates)
 		{
 			if (size_t const* cost = util::valueOrNullptr(m_expressionCodeCost, candidate))
 			{
 				size_t numRef = m_numReferences[candidate];
-				cand[*cost * numRef].emplace_back(candidate, m_references[candidate]);
+				RematCost rematCost{
+					saturatingMul(m_expressionRuntimeCost[candidate], m_loopReferenceWeight[candidate]),
+					*cost * numRef
+				};
+				cand[rematCost].emplace_back(candidate, m_references[candidate]);
 			}
 		}
 		return cand;
@@ -84,11 +115,21 @@ public:
 			{
 				yulAssert(!m_expressionCodeCost.count(varName), "");
 				m_candidates.emplace_back(varName);
-				m_expressionCodeCost[varName] = CodeCost::codeCost(m_dialect, *m_value[varName].value);
+				Expression const& value = *m_value[varName].value;
+				m_expressionCodeCost[varName] = CodeCost::codeCost(m_dialect, value);
+				m_expressionRuntimeCost[varName] = runtimeCost(value);
+				m_declarationLoopDepth[varName] = m_loopDepth;
 			}
 		}
 	}
 
+	void operator()(ForLoop& _for) override
+	{
+		++m_loopDepth;
+		DataFlowAnalyzer::operator()(_for);
+		--m_loopDepth;
+	}
+
 	void operator()(Assignment& _assignment) override
 	{
 		for (auto const& var: _assignment.variableNames)
@@ -108,7 +149,17 @@ public:
 				if (!m_value.count(name))
 					rematImpossible(name);
 				else
+				{
 					++m_numReferences[name];
+					size_t declarationLoopDepth = m_declarationLoopDepth.at(name);
+					if (m_loopDepth > declarationLoopDepth)
+					{
+						size_t weight = 1;
+						for (size_t depth = declarationLoopDepth; depth < m_loopDepth; ++depth)
+							weight = saturatingMul(weight, loopIterationEstimate);
+						m_loopReferenceWeight[name] = saturatingAdd(m_loopReferenceWeight[name], weight);
+					}
+				}
 			}
 		}
 		DataFlowAnalyzer::visit(_e);
@@ -121,17 +172,38 @@ public:
 		m_expressionCodeCost.erase(_variable);
 	}
 
+	/// @returns the estimated gas for evaluating @a _value once, or its code cost for dialects
+	/// without gas costs.
+	size_t runtimeCost(Expression const& _value) const
+	{
+		if (auto const* evmDialect = dynamic_cast<EVMDialect const*>(&m_dialect))
+		{
+			bigint gas = GasMeterVisitor::costs(_value, *evmDialect, false, true).first;
+			return gas > numeric_limits<size_t>::max() ? numeric_limits<size_t>::max() : static_cast<size_t>(gas);
+		}
+		return CodeCost::codeCost(m_dialect, _value);
+	}
+
 	/// All candidate variables in order of occurrence.
 	vector<YulString> m_candidates;
 	/// Candidate variables and the code cost of their value.
 	map<YulString, size_t> m_expressionCodeCost;
+	/// Candidate variables and the estimated runtime cost of evaluating their value once.
+	map<YulString, size_t> m_expressionRuntimeCost;
 	/// Number of references to each candidate variable.
 	map<YulString, size_t> m_numReferences;
+	/// Sum of the estimated iterations per execution of the declaration over the references to
+	/// each candidate variable inside loops it was declared outside of.
+	map<YulString, size_t> m_loopReferenceWeight;
+	/// Number of loops around the declaration of each candidate variable.
+	map<YulString, size_t> m_declarationLoopDepth;
+	/// Number of loops around the current position.
+	size_t m_loopDepth = 0;
 };
 
 /// Selects at most @a _numVariables among @a _candidates.
 set<YulString> chooseVarsToEliminate(
-	map<size_t, vector<tuple<YulString, set<YulString>>>> const& _candidates,
+	map<RematCost, vector<tuple<YulString, set<YulString>>>> const& _candidates,
 	size_t _numVariables
 )
 {
@@ -178,7 +250,7 @@ void eliminateVariables(
 {
 	RematCandidateSelector selector{_dialect};
 	selector(_block);
-	std::map<YulString, size_t> candidates;
+	std::map<YulString, RematCost> candidates;
 	for (auto [cost, candidatesWithCost]: selector.candidates())
 		for (auto candidate: candidatesWithCost)
 			candidates[get<0>(candidate)] = cost;
@@ -188,13 +260,13 @@ void eliminateVariables(
 	// TODO: this currently ignores the fact that variables may reference other variables we want to eliminate.
 	for (auto const& unreachable: _unreachables)
 	{
-		map<size_t, vector<YulString>> suitableCandidates;
+		map<RematCost, vector<YulString>> suitableCandidates;
 		size_t neededSlots = unreachable.deficit;
 		for (auto varName: unreachable.variableChoices)
 		{
 			if (varsToEliminate.count(varName))
 				--neededSlots;
-			else if (size_t* cost = util::valueOrNullptr(candidates, varName))
+			else if (RematCost* cost = util::valueOrNullptr(candidates, varName))
 				if (!util::contains(suitableCandidates[*cost], varName))
 					suitableCandidates[*cost].emplace_back(varName);
 		}
@@ -235,31 +307,22 @@ bool StackCompressor::run(
 			evmDialect->providesObjectAccess();
 	bool allowMSizeOptimzation = !MSizeFinder::containsMSize(_dialect, *_object.code);
 	if (usesOptimizedCodeGenerator)
-	{
-		yul::AsmAnalysisInfo analysisInfo = yul::AsmAnalyzer::analyzeStrictAssertCorrect(_dialect, _object);
-		unique_ptr<CFG> cfg = ControlFlowGraphBuilder::build(analysisInfo, _dialect, *_object.code);
-		Block& mainBlock = std::get<Block>(_object.code->statements.at(0));
-		if (
-			auto stackTooDeepErrors = StackLayoutGenerator::reportStackTooDeep(*cfg, YulString{});
-			!stackTooDeepErrors.empty()
-		)
-			eliminateVariables(_dialect, mainBlock, stackTooDeepErrors, allowMSizeOptimzation);
-		for (size_t i = 1; i < _object.code->statements.size(); ++i)
-		{
-			auto& fun = std::get<FunctionDefinition>(_object.code->statements[i]);
-			if (
-				auto stackTooDeepErrors = StackLayoutGenerator::reportStackTooDeep(*cfg, fun.name);
-				!stackTooDeepErrors.empty()
-			)
-				eliminateVariables(_dialect, fun.body, stackTooDeepErrors, allowMSizeOptimzation);
-		}
-	}
+		runForOptimizedCodeGenerator(_dialect, _object);
 	else
+	{
+		// Only the functions changed in the previous iteration are checked again, since the
+		// others still compile.
+		optional<set<YulString>> changedFunctions;
 		for (size_t iterations = 0; iterations < _maxIterations; iterations++)
 		{
-			map<YulString, int> stackSurplus = CompilabilityChecker(_dialect, _object, _optimizeStackAllocation).stackDeficit;
+			map<YulString, int> stackSurplus = (
+				changedFunctions ?
+				CompilabilityChecker(_dialect, _object, _optimizeStackAllocation, *changedFunctions) :
+				CompilabilityChecker(_dialect, _object, _optimizeStackAllocation)
+			).stackDeficit;
 			if (stackSurplus.empty())
 				return true;
+			changedFunctions = stackSurplus | ranges::views::keys | ranges::to<set<YulString>>;
 
 			if (stackSurplus.count(YulString{}))
 			{
@@ -287,6 +350,58 @@ bool StackCompressor::run(
 				);
 			}
 		}
+	}
 	return false;
 }
 
+map<YulString, vector<StackLayoutGenerator::StackTooDeep>> StackCompressor::runForOptimizedCodeGenerator(
+	Dialect const& _dialect,
+	Object& _object
+)
+{
+	yulAssert(
+		_object.code &&
+		_object.code->statements.size() > 0 && holds_alternative<Block>(_object.code->statements.at(0)),
+		"Need to run the function grouper before the stack compressor."
+	);
+	bool allowMSizeOptimzation = !MSizeFinder::containsMSize(_dialect, *_object.code);
+	set<YulString> changedFunctions;
+	{
+		yul::AsmAnalysisInfo analysisInfo = yul::AsmAnalyzer::analyzeStrictAssertCorrect(_dialect, _object);
+		unique_ptr<CFG> cfg = ControlFlowGraphBuilder::build(analysisInfo, _dialect, *_object.code);
+		Block& mainBlock = std::get<Block>(_object.code->statements.at(0));
+		if (
+			auto stackTooDeepErrors = StackLayoutGenerator::reportStackTooDeep(*cfg, YulString{});
+			!stackTooDeepErrors.empty()
+		)
+		{
+			eliminateVariables(_dialect, mainBlock, stackTooDeepErrors, allowMSizeOptimzation);
+			changedFunctions.insert(YulString{});
+		}
+		for (size_t i = 1; i < _object.code->statements.size(); ++i)
+		{
+			auto& fun = std::get<FunctionDefinition>(_object.code->statements[i]);
+			if (
+				auto stackTooDeepErrors = StackLayoutGenerator::reportStackTooDeep(*cfg, fun.name);
+				!stackTooDeepErrors.empty()
+			)
+			{
+				eliminateVariables(_dialect, fun.body, stackTooDeepErrors, allowMSizeOptimzation);
+				changedFunctions.insert(fun.name);
+			}
+		}
+	}
+
+	map<YulString, vector<StackLayoutGenerator::StackTooDeep>> remainingErrors;
+	if (changedFunctions.empty())
+		return remainingErrors;
+	// The layouts of the functions are independent of each other, so only the changed ones need
+	// to be generated again.
+	yul::AsmAnalysisInfo analysisInfo = yul::AsmAnalyzer::analyzeStrictAssertCorrect(_dialect, _object);
+	unique_ptr<CFG> cfg = ControlFlowGraphBuilder::build(analysisInfo, _dialect, *_object.code);
+	for (YulString function: changedFunctions)
+		if (auto stackTooDeepErrors = StackLayoutGenerator::reportStackTooDeep(*cfg, function); !stackTooDeepErrors.empty())
+			remainingErrors[function] = move(stackTooDeepErrors);
+	return remainingErrors;
+}
+
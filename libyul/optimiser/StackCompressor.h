@@ -23,8 +23,11 @@
 #pragma once
 
 #include <libyul/Object.h>
+#include <libyul/backends/evm/StackLayoutGenerator.h>
 
+#include <map>
 #include <memory>
+#include <vector>
 
 namespace solidity::yul
 {
@@ -37,6 +40,10 @@ struct FunctionDefinition;
  * Optimisation stage that aggressively rematerializes certain variables in a function to free
  * space on the stack until it is compilable.
  *
+ * Variables whose rematerialisation does not move the evaluation of their value into loops are
+ * preferred; the others are ranked by the estimated runtime gas of their value and the number
+ * of loops between their declaration and their references.
+ *
  * Only runs on the code of the object itself, does not descend into sub-objects.
  *
  * Prerequisite: Disambiguator, Function Grouper
@@ -52,6 +59,15 @@ public:
 		bool _optimizeStackAllocation,
 		size_t _maxIterations
 	);
+
+	/// Removes local variables in the functions that have stack too deep errors when using the optimized
+	/// code generator and @returns the errors that remain afterwards, keyed by function name with the
+	/// empty name for the main block, in the format of StackLayoutGenerator::reportStackTooDeep.
+	/// Only the changed functions are checked again, since the others cannot have errors.
+	static std::map<YulString, std::vector<StackLayoutGenerator::StackTooDeep>> runForOptimizedCodeGenerator(
+		Dialect const& _dialect,
+		Object& _object
+	);
 };
 
 }
@@ -16,6 +16,7 @@
 */
 
 #include <libyul/optimiser/StackLimitEvader.h>
+#include <libyul/optimiser/ASTWalker.h>
 #include <libyul/optimiser/CallGraphGenerator.h>
 #include <libyul/optimiser/FunctionCallFinder.h>
 #include <libyul/optimiser/NameDispenser.h>
@@ -42,6 +43,102 @@ using namespace solidity::yul;
 
 namespace
 {
+/**
+ * Determines the range of the code of a function or of the outermost block during which each
+ * variable may hold a value that is still used.
+ *
+ * Positions are counted in evaluation order, increasing at every reference to a variable and after
+ * the value of every declaration and assignment. A variable is live from its declaration, or from
+ * the start for function parameters, to its last reference. Return variables are live until the
+ * end, as are variables referenced in a loop they are declared outside of until the end of that
+ * loop, since their value may be used in the next iteration. Variables that are declared anew in
+ * each iteration do not need this, since they are initialized by their declaration.
+ */
+class LiveRangeCollector: public ASTWalker
+{
+public:
+	struct LiveRange
+	{
+		size_t start = 0;
+		size_t end = 0;
+		bool overlaps(LiveRange const& _other) const { return start <= _other.end && _other.start <= end; }
+	};
+
+	static map<YulString, LiveRange> run(Block const& _block, FunctionDefinition const* _function)
+	{
+		LiveRangeCollector collector;
+		if (_function)
+			for (TypedName const& parameter: _function->parameters)
+				collector.declare(parameter.name);
+		collector(_block);
+		if (_function)
+			for (TypedName const& returnVariable: _function->returnVariables)
+				collector.m_liveRanges[returnVariable.name] = {0, collector.m_position};
+		return move(collector.m_liveRanges);
+	}
+
+	using ASTWalker::operator();
+	void operator()(Identifier const& _identifier) override
+	{
+		++m_position;
+		reference(_identifier.name);
+	}
+	void operator()(VariableDeclaration const& _varDecl) override
+	{
+		ASTWalker::operator()(_varDecl);
+		++m_position;
+		for (TypedName const& variable: _varDecl.variables)
+			declare(variable.name);
+	}
+	void operator()(Assignment const& _assignment) override
+	{
+		visit(*_assignment.value);
+		++m_position;
+		for (Identifier const& variable: _assignment.variableNames)
+			reference(variable.name);
+	}
+	void operator()(ForLoop const& _forLoop) override
+	{
+		// The initialisation part is only executed once, so it is outside of the loop.
+		(*this)(_forLoop.pre);
+		m_loops.emplace_back();
+		visit(*_forLoop.condition);
+		(*this)(_forLoop.body);
+		(*this)(_forLoop.post);
+		++m_position;
+		for (YulString variable: m_loops.back())
+			m_liveRanges[variable].end = m_position;
+		m_loops.pop_back();
+	}
+	/// Functions nested in the code are handled separately.
+	void operator()(FunctionDefinition const&) override {}
+
+private:
+	void declare(YulString _variable)
+	{
+		m_liveRanges[_variable] = {m_position, m_position};
+		m_loopDepth[_variable] = m_loops.size();
+	}
+	void reference(YulString _variable)
+	{
+		LiveRange* liveRange = util::valueOrNullptr(m_liveRanges, _variable);
+		if (!liveRange)
+			return;
+		liveRange->end = m_position;
+		// The outermost loop around the reference that does not contain the declaration.
+		if (size_t loopDepth = m_loopDepth.at(_variable); loopDepth < m_loops.size())
+			m_loops[loopDepth].emplace_back(_variable);
+	}
+
+	size_t m_position = 0;
+	map<YulString, LiveRange> m_liveRanges;
+	/// The number of loops around the declaration of each variable.
+	map<YulString, size_t> m_loopDepth;
+	/// The variables declared outside of each loop around the current position, which are
+	/// referenced inside of it, from the outermost to the innermost loop.
+	vector<vector<YulString>> m_loops;
+};
+
 /**
  * Walks the call graph using a Depth-First-Search assigning memory slots to variables.
  * - The leaves of the call graph will get the lowest slot, increasing towards the root.
@@ -52,8 +149,9 @@ namespace
  * - Determine the maximum value ``n`` of the values of ``slotsRequiredForFunction`` among the children.
  * - If the function itself contains variables that need memory slots, but is contained in a cycle,
  *   abort the process as failure.
- * - If not, assign each variable its slot starting from ``n`` (incrementing it).
- * - Assign ``n`` to ``slotsRequiredForFunction`` of the function.
+ * - If not, assign each variable the lowest slot starting from ``n`` that is not used by another variable
+ *   of the function that is live at the same time (see ``LiveRangeCollector``).
+ * - Assign the number of slots used to ``slotsRequiredForFunction`` of the function.
  */
 struct MemoryOffsetAllocator
 {
@@ -72,7 +170,31 @@ struct MemoryOffsetAllocator
 
 		if (auto const* unreachables = util::valueOrNullptr(unreachableVariables, _function))
 		{
-			if (FunctionDefinition const* functionDefinition = util::valueOrDefault(functionDefinitions, _function, nullptr, util::allow_copy))
+			FunctionDefinition const* functionDefinition = util::valueOrDefault(functionDefinitions, _function, nullptr, util::allow_copy);
+			map<YulString, LiveRangeCollector::LiveRange> liveRanges = LiveRangeCollector::run(
+				functionDefinition ? functionDefinition->body : code,
+				functionDefinition
+			);
+			uint64_t const firstSlot = requiredSlots;
+			vector<YulString> assignedVariables;
+			auto assignSlot = [&](YulString _variable) {
+				auto const* liveRange = util::valueOrNullptr(liveRanges, _variable);
+				set<uint64_t> usedSlots;
+				for (YulString other: assignedVariables)
+				{
+					auto const* otherLiveRange = util::valueOrNullptr(liveRanges, other);
+					if (!liveRange || !otherLiveRange || liveRange->overlaps(*otherLiveRange))
+						usedSlots.insert(slotAllocations.at(other));
+				}
+				uint64_t slot = firstSlot;
+				while (usedSlots.count(slot))
+					++slot;
+				slotAllocations[_variable] = slot;
+				requiredSlots = std::max(requiredSlots, slot + 1);
+				assignedVariables.emplace_back(_variable);
+			};
+
+			if (functionDefinition)
 				if (
 					size_t totalArgCount = functionDefinition->returnVariables.size() + functionDefinition->parameters.size();
 					totalArgCount > 16
@@ -81,7 +203,7 @@ struct MemoryOffsetAllocator
 						functionDefinition->parameters,
 						functionDefinition->returnVariables
 					) | ranges::views::take(totalArgCount - 16))
-						slotAllocations[var.name] = requiredSlots++;
+						assignSlot(var.name);
 
 			// Assign slots for all variables that become unreachable in the function body, if the above did not
 			// assign a slot for them already.
@@ -89,7 +211,7 @@ struct MemoryOffsetAllocator
 				// The empty case is a function with too many arguments or return values,
 				// which was already handled above.
 				if (!variable.empty() && !slotAllocations.count(variable))
-					slotAllocations[variable] = requiredSlots++;
+					assignSlot(variable);
 		}
 
 		return slotsRequiredForFunction[_function] = requiredSlots;
@@ -102,6 +224,8 @@ struct MemoryOffsetAllocator
 	map<YulString, set<YulString>> const& callGraph;
 	/// Maps the name of each user-defined function to its definition.
 	map<YulString, FunctionDefinition const*> const& functionDefinitions;
+	/// The code of the object, whose outermost block contains the variables outside of functions.
+	Block const& code;
 
 	/// Maps variable names to the memory slot the respective variable is assigned.
 	map<YulString, uint64_t> slotAllocations{};
@@ -195,7 +319,7 @@ void StackLimitEvader::run(
 
 	map<YulString, FunctionDefinition const*> functionDefinitions = allFunctionDefinitions(*_object.code);
 
-	MemoryOffsetAllocator memoryOffsetAllocator{_unreachableVariables, callGraph.functionCalls, functionDefinitions};
+	MemoryOffsetAllocator memoryOffsetAllocator{_unreachableVariables, callGraph.functionCalls, functionDefinitions, *_object.code};
 	uint64_t requiredSlots = memoryOffsetAllocator.run();
 	yulAssert(requiredSlots < (uint64_t(1) << 32) - 1, "");
 
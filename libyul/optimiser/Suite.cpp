@@ -25,6 +25,7 @@
 #include <libyul/optimiser/VarDeclInitializer.h>
 #include <libyul/optimiser/BlockFlattener.h>
 #include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/optimiser/ChangeTracker.h>
 #include <libyul/optimiser/CircularReferencesPruner.h>
 #include <libyul/optimiser/ControlFlowSimplifier.h>
 #include <libyul/optimiser/ConditionalSimplifier.h>
@@ -50,6 +51,7 @@
 #include <libyul/optimiser/ExpressionSimplifier.h>
 #include <libyul/optimiser/CommonSubexpressionEliminator.h>
 #include <libyul/optimiser/Semantics.h>
+#include <libyul/optimiser/SideEffectsCache.h>
 #include <libyul/optimiser/SSAReverser.h>
 #include <libyul/optimiser/SSATransform.h>
 #include <libyul/optimiser/StackCompressor.h>
@@ -60,8 +62,13 @@
 #include <libyul/optimiser/VarNameCleaner.h>
 #include <libyul/optimiser/LoadResolver.h>
 #include <libyul/optimiser/LoopInvariantCodeMotion.h>
+#include <libyul/optimiser/LoopUnroller.h>
 #include <libyul/optimiser/Metrics.h>
 #include <libyul/optimiser/NameSimplifier.h>
+#include <libyul/optimiser/OptimisedCodeCache.h>
+#include <libyul/optimiser/OverwrittenStoreEliminator.h>
+#include <libyul/optimiser/PureCallEvaluator.h>
+#include <libyul/optimiser/RangeSimplifier.h>
 #include <libyul/backends/evm/ConstantOptimiser.h>
 #include <libyul/AsmAnalysis.h>
 #include <libyul/AsmAnalysisInfo.h>
@@ -73,6 +80,8 @@
 #include <libyul/backends/evm/NoOutputAssembly.h>
 
 #include <libsolutil/CommonData.h>
+#include <libsolutil/Keccak256.h>
+#include <libsolutil/Profiler.h>
 
 #include <libyul/CompilabilityChecker.h>
 
@@ -93,9 +102,35 @@ void OptimiserSuite::run(
 	bool _optimizeStackAllocation,
 	string_view _optimisationSequence,
 	optional<size_t> _expectedExecutionsPerDeployment,
-	set<YulString> const& _externallyUsedIdentifiers
+	set<YulString> const& _externallyUsedIdentifiers,
+	OptimisedCodeCache* _cache,
+	size_t _parallelism,
+	optional<size_t> _stepBudget
 )
 {
+	util::Profiler::Scope profilerScope{"Yul optimiser"};
+	optional<util::h256> cacheKey;
+	if (_cache)
+	{
+		// Dialects are never destroyed while their code is in use, so their address identifies them.
+		string key = to_string(reinterpret_cast<uintptr_t>(&_dialect)) + "\n";
+		key += (_optimizeStackAllocation ? "stackAllocation\n" : "\n");
+		key += string(_optimisationSequence) + "\n";
+		key += (_expectedExecutionsPerDeployment ? to_string(*_expectedExecutionsPerDeployment) : "creation") + "\n";
+		key += (_stepBudget ? to_string(*_stepBudget) : "") + "\n";
+		for (YulString identifier: _externallyUsedIdentifiers)
+			key += identifier.str() + ",";
+		key += "\n" + _object.toString(&_dialect, langutil::DebugInfoSelection::All());
+		cacheKey = util::keccak256(key);
+
+		if (optional<Block> code = _cache->find(*cacheKey))
+		{
+			*_object.code = move(*code);
+			*_object.analysisInfo = AsmAnalyzer::analyzeStrictAssertCorrect(_dialect, _object);
+			return;
+		}
+	}
+
 	EVMDialect const* evmDialect = dynamic_cast<EVMDialect const*>(&_dialect);
 	bool usesOptimizedCodeGenerator =
 		_optimizeStackAllocation &&
@@ -113,7 +148,13 @@ void OptimiserSuite::run(
 	Block& ast = *_object.code;
 
 	NameDispenser dispenser{_dialect, ast, reservedIdentifiers};
-	OptimiserStepContext context{_dialect, dispenser, reservedIdentifiers, _expectedExecutionsPerDeployment};
+	OptimiserStepContext context{
+		_dialect,
+		dispenser,
+		reservedIdentifiers,
+		_expectedExecutionsPerDeployment,
+		_parallelism
+	};
 
 	OptimiserSuite suite(context, Debug::None);
 
@@ -123,7 +164,9 @@ void OptimiserSuite::run(
 
 	NameSimplifier::run(suite.m_context, ast);
 	// Now the user-supplied part
+	suite.m_remainingSteps = _stepBudget;
 	suite.runSequence(_optimisationSequence, ast);
+	suite.m_remainingSteps = nullopt;
 
 	// This is a tuning parameter, but actually just prevents infinite loops.
 	size_t stackCompressorMaxIterations = 16;
@@ -146,14 +189,10 @@ void OptimiserSuite::run(
 		ConstantOptimiser{*evmDialect, *_meter}(ast);
 		if (usesOptimizedCodeGenerator)
 		{
-			StackCompressor::run(
-				_dialect,
-				_object,
-				_optimizeStackAllocation,
-				stackCompressorMaxIterations
-			);
-			if (evmDialect->providesObjectAccess())
-				StackLimitEvader::run(suite.m_context, _object);
+			// Only the functions changed by the stack compressor can still have stack too deep errors,
+			// so they are not searched for in the whole object again.
+			auto stackTooDeepErrors = StackCompressor::runForOptimizedCodeGenerator(_dialect, _object);
+			StackLimitEvader::run(suite.m_context, _object, stackTooDeepErrors);
 		}
 		else if (evmDialect->providesObjectAccess() && _optimizeStackAllocation)
 			StackLimitEvader::run(suite.m_context, _object);
@@ -171,6 +210,9 @@ void OptimiserSuite::run(
 	VarNameCleaner::run(suite.m_context, ast);
 
 	*_object.analysisInfo = AsmAnalyzer::analyzeStrictAssertCorrect(_dialect, _object);
+
+	if (cacheKey)
+		_cache->store(*cacheKey, ast);
 }
 
 namespace
@@ -195,42 +237,44 @@ map<string, unique_ptr<OptimiserStep>> optimiserStepCollection()
 
 map<string, unique_ptr<OptimiserStep>> const& OptimiserSuite::allSteps()
 {
-	static map<string, unique_ptr<OptimiserStep>> instance;
-	if (instance.empty())
-		instance = optimiserStepCollection<
-			BlockFlattener,
-			CircularReferencesPruner,
-			CommonSubexpressionEliminator,
-			ConditionalSimplifier,
-			ConditionalUnsimplifier,
-			ControlFlowSimplifier,
-			DeadCodeEliminator,
-			EqualStoreEliminator,
-			EquivalentFunctionCombiner,
-			ExpressionInliner,
-			ExpressionJoiner,
-			ExpressionSimplifier,
-			ExpressionSplitter,
-			ForLoopConditionIntoBody,
-			ForLoopConditionOutOfBody,
-			ForLoopInitRewriter,
-			FullInliner,
-			FunctionGrouper,
-			FunctionHoister,
-			FunctionSpecializer,
-			LiteralRematerialiser,
-			LoadResolver,
-			LoopInvariantCodeMotion,
-			UnusedAssignEliminator,
-			ReasoningBasedSimplifier,
-			Rematerialiser,
-			SSAReverser,
-			SSATransform,
-			StructuralSimplifier,
-			UnusedFunctionParameterPruner,
-			UnusedPruner,
-			VarDeclInitializer
-		>();
+	static map<string, unique_ptr<OptimiserStep>> const instance = optimiserStepCollection<
+		BlockFlattener,
+		CircularReferencesPruner,
+		CommonSubexpressionEliminator,
+		ConditionalSimplifier,
+		ConditionalUnsimplifier,
+		ControlFlowSimplifier,
+		DeadCodeEliminator,
+		EqualStoreEliminator,
+		EquivalentFunctionCombiner,
+		ExpressionInliner,
+		ExpressionJoiner,
+		ExpressionSimplifier,
+		ExpressionSplitter,
+		ForLoopConditionIntoBody,
+		ForLoopConditionOutOfBody,
+		ForLoopInitRewriter,
+		FullInliner,
+		FunctionGrouper,
+		FunctionHoister,
+		FunctionSpecializer,
+		LiteralRematerialiser,
+		LoadResolver,
+		LoopInvariantCodeMotion,
+		LoopUnroller,
+		OverwrittenStoreEliminator,
+		PureCallEvaluator,
+		RangeSimplifier,
+		UnusedAssignEliminator,
+		ReasoningBasedSimplifier,
+		Rematerialiser,
+		SSAReverser,
+		SSATransform,
+		StructuralSimplifier,
+		UnusedFunctionParameterPruner,
+		UnusedPruner,
+		VarDeclInitializer
+	>();
 	// Does not include VarNameCleaner because it destroys the property of unique names.
 	// Does not include NameSimplifier.
 	return instance;
@@ -262,6 +306,10 @@ map<string, char> const& OptimiserSuite::stepNameToAbbreviationMap()
 		{LiteralRematerialiser::name,         'T'},
 		{LoadResolver::name,                  'L'},
 		{LoopInvariantCodeMotion::name,       'M'},
+		{LoopUnroller::name,                  'K'},
+		{OverwrittenStoreEliminator::name,    'W'},
+		{PureCallEvaluator::name,             'P'},
+		{RangeSimplifier::name,               'B'},
 		{ReasoningBasedSimplifier::name,      'R'},
 		{UnusedAssignEliminator::name,        'r'},
 		{Rematerialiser::name,                'm'},
@@ -290,6 +338,32 @@ map<char, string> const& OptimiserSuite::stepAbbreviationToNameMap()
 	return lookupTable;
 }
 
+OptimiserSuite::CodeClass OptimiserSuite::classify(Dialect const& _dialect, Block const& _block)
+{
+	// Below this size the choice of the sequence hardly makes a difference.
+	static constexpr size_t minimumCodeSize = 200;
+	// Percentages of the code size from which on code counts as dominated by these operations.
+	static constexpr size_t arithmeticPercentage = 2;
+	static constexpr size_t storagePercentage = 1;
+	// Storage accesses per external function from which on code counts as storage heavy.
+	static constexpr size_t storageAccessesPerFunction = 3;
+
+	CodeFeatures features = CodeFeatures::of(_dialect, _block);
+	if (features.codeSize < minimumCodeSize)
+		return CodeClass::General;
+	if (features.loopCount > 0 && features.arithmeticOperations * 100 >= features.codeSize * arithmeticPercentage)
+		return CodeClass::ComputationHeavy;
+	if (
+		features.storageAccesses * 100 >= features.codeSize * storagePercentage ||
+		(
+			features.externalFunctions > 0 &&
+			features.storageAccesses >= features.externalFunctions * storageAccessesPerFunction
+		)
+	)
+		return CodeClass::StorageHeavy;
+	return CodeClass::General;
+}
+
 void OptimiserSuite::validateSequence(string_view _stepAbbreviations)
 {
 	int8_t nestingLevel = 0;
@@ -333,6 +407,27 @@ void OptimiserSuite::runSequence(string_view _stepAbbreviations, Block& _ast, bo
 {
 	validateSequence(_stepAbbreviations);
 
+	// The AST can be changed from outside between calls, so the changes are only tracked
+	// during the outermost call.
+	// The side effects of functions can be reused by later steps until the change tracker
+	// detects a change.
+	unique_ptr<ChangeTracker> changeTracker;
+	unique_ptr<SideEffectsCache> sideEffectsCache;
+	if (!m_changeTracker && m_debug == Debug::None)
+	{
+		changeTracker = make_unique<ChangeTracker>(_ast, m_context.dispenser);
+		m_changeTracker = changeTracker.get();
+		sideEffectsCache = make_unique<SideEffectsCache>();
+		m_context.sideEffectsCache = sideEffectsCache.get();
+	}
+	ScopeGuard resetChangeTracker{[&]() {
+		if (changeTracker)
+		{
+			m_changeTracker = nullptr;
+			m_context.sideEffectsCache = nullptr;
+		}
+	}};
+
 	// This splits 'aaa[bbb]ccc...' into 'aaa' and '[bbb]ccc...'.
 	auto extractNonNestedPrefix = [](string_view _tail) -> tuple<string_view, string_view>
 	{
@@ -410,7 +505,7 @@ void OptimiserSuite::runSequence(string_view _stepAbbreviations, Block& _ast, bo
 				runSequence(abbreviationsToSteps(subsequence), _ast);
 		}
 
-		if (!_repeatUntilStable)
+		if (!_repeatUntilStable || m_remainingSteps == size_t(0))
 			break;
 
 		size_t newSize = CodeSize::codeSizeIncludingFunctions(_ast);
@@ -427,9 +522,23 @@ void OptimiserSuite::runSequence(std::vector<string> const& _steps, Block& _ast)
 		copy = make_unique<Block>(std::get<Block>(ASTCopier{}(_ast)));
 	for (string const& step: _steps)
 	{
+		// Steps are deterministic, so running them again before anything changed is a no-op.
+		if (m_changeTracker && m_changeTracker->unchanged(step))
+			continue;
+		if (m_remainingSteps)
+		{
+			if (*m_remainingSteps == 0)
+				break;
+			--*m_remainingSteps;
+		}
 		if (m_debug == Debug::PrintStep)
 			cout << "Running " << step << endl;
-		allSteps().at(step)->run(m_context, _ast);
+		{
+			util::Profiler::Scope stepScope{step};
+			allSteps().at(step)->run(m_context, _ast);
+		}
+		if (m_changeTracker && m_changeTracker->stepRun(step, _ast, m_context.dispenser))
+			m_context.sideEffectsCache->invalidate();
 		if (m_debug == Debug::PrintChanges)
 		{
 			// TODO should add switch to also compare variable names!
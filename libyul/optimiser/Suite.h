@@ -39,6 +39,8 @@ struct AsmAnalysisInfo;
 struct Dialect;
 class GasMeter;
 struct Object;
+class OptimisedCodeCache;
+class ChangeTracker;
 
 /**
  * Optimiser suite that combines all steps and also provides the settings for the heuristics.
@@ -62,6 +64,12 @@ public:
 	OptimiserSuite(OptimiserStepContext& _context, Debug _debug = Debug::None): m_context(_context), m_debug(_debug) {}
 
 	/// The value nullopt for `_expectedExecutionsPerDeployment` represents creation code.
+	/// If @a _cache is given, the result for an object that was already optimised with the same
+	/// settings is taken from there. This assumes that @a _meter is fully determined by the
+	/// dialect and @a _expectedExecutionsPerDeployment.
+	/// @a _parallelism is the maximum number of threads used by the steps that can process
+	/// functions independently of each other.
+	/// If @a _stepBudget is given, at most that many steps of @a _optimisationSequence are run.
 	static void run(
 		Dialect const& _dialect,
 		GasMeter const* _meter,
@@ -69,9 +77,25 @@ public:
 		bool _optimizeStackAllocation,
 		std::string_view _optimisationSequence,
 		std::optional<size_t> _expectedExecutionsPerDeployment,
-		std::set<YulString> const& _externallyUsedIdentifiers = {}
+		std::set<YulString> const& _externallyUsedIdentifiers = {},
+		OptimisedCodeCache* _cache = nullptr,
+		size_t _parallelism = 1,
+		std::optional<size_t> _stepBudget = std::nullopt
 	);
 
+	/// Kinds of code that profit from different optimisation sequences, see @a classify.
+	enum class CodeClass
+	{
+		General,
+		/// Code where a large part of the work is reading and writing storage, like tokens.
+		StorageHeavy,
+		/// Code with loops over multiplicative and modular arithmetic, like fixed point math libraries.
+		ComputationHeavy
+	};
+
+	/// Assigns @a _block to a class based on its CodeFeatures. Small code is always General.
+	static CodeClass classify(Dialect const& _dialect, Block const& _block);
+
 	/// Ensures that specified sequence of step abbreviations is well-formed and can be executed.
 	/// @throw OptimizerException if the sequence is invalid
 	static void validateSequence(std::string_view _stepAbbreviations);
@@ -86,6 +110,11 @@ public:
 private:
 	OptimiserStepContext& m_context;
 	Debug m_debug;
+	/// Skips the steps that would not change anything during the outermost call of runSequence.
+	/// Not used when debugging.
+	ChangeTracker* m_changeTracker = nullptr;
+	/// Number of steps that may still be run, unlimited if not set.
+	std::optional<size_t> m_remainingSteps;
 };
 
 }
@@ -25,6 +25,7 @@
 #include <libyul/optimiser/NameCollector.h>
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/optimiser/OptimizerUtilities.h>
+#include <libyul/optimiser/SideEffectsCache.h>
 #include <libyul/Exceptions.h>
 #include <libyul/AST.h>
 #include <libyul/Dialect.h>
@@ -36,7 +37,14 @@ using namespace solidity::yul;
 
 void UnusedPruner::run(OptimiserStepContext& _context, Block& _ast)
 {
-	UnusedPruner::runUntilStabilisedOnFullAST(_context.dialect, _ast, _context.reservedIdentifiers);
+	map<YulString, SideEffects> functionSideEffects = SideEffectsCache::functionSideEffects(_context, _ast);
+	runUntilStabilised(
+		_context.dialect,
+		_ast,
+		!MSizeFinder::containsMSize(_context.dialect, _ast),
+		&functionSideEffects,
+		_context.reservedIdentifiers
+	);
 	FunctionGrouper::run(_context, _ast);
 }
 
@@ -184,7 +192,7 @@ bool UnusedPruner::used(YulString _name) const
 	return m_references.count(_name) && m_references.at(_name) > 0;
 }
 
-void UnusedPruner::subtractReferences(map<YulString, size_t> const& _subtrahend)
+void UnusedPruner::subtractReferences(unordered_map<YulString, size_t> const& _subtrahend)
 {
 	for (auto const& ref: _subtrahend)
 	{
@@ -27,6 +27,7 @@
 
 #include <map>
 #include <set>
+#include <unordered_map>
 
 namespace solidity::yul
 {
@@ -115,13 +116,13 @@ private:
 	);
 
 	bool used(YulString _name) const;
-	void subtractReferences(std::map<YulString, size_t> const& _subtrahend);
+	void subtractReferences(std::unordered_map<YulString, size_t> const& _subtrahend);
 
 	Dialect const& m_dialect;
 	bool m_allowMSizeOptimization = false;
 	std::map<YulString, SideEffects> const* m_functionSideEffects = nullptr;
 	bool m_shouldRunAgain = false;
-	std::map<YulString, size_t> m_references;
+	std::unordered_map<YulString, size_t> m_references;
 };
 
 }
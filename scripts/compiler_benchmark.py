@@ -0,0 +1,268 @@
+#!/usr/bin/env python3
+
+"""Measures how fast the compiler compiles a fixed corpus of real-world projects.
+
+The projects are the ones used by the external tests (see ``test/externalTests/``) whose contracts
+compile without installing their dependencies. Each of them is compiled with the configurations
+in ``CONFIGURATIONS`` and the compiler's ``--profile`` option. The report contains the wall time and
+the peak memory of each compiler run and the measurements of each phase as JSON.
+
+Given a baseline, i.e. the report of an earlier run, e.g. for the last release, the report also
+contains the ratio of each measurement to the baseline.
+
+  scripts/compiler_benchmark.py build/solc/solc --store-baseline baseline.json
+  scripts/compiler_benchmark.py build/solc/solc --baseline baseline.json --output report.json
+
+The projects are cloned into the work directory (``--work-dir``), which is kept between runs.
+"""
+
+import json
+import os
+import re
+import statistics
+import subprocess
+import sys
+import time
+from argparse import ArgumentParser
+from dataclasses import dataclass
+from pathlib import Path
+from tempfile import TemporaryDirectory
+from typing import Dict, List, Optional
+
+
+@dataclass(frozen=True)
+class Project:
+    name: str
+    repo: str
+    ref: str
+    source_dir: str
+
+
+# Keep the repositories and refs in sync with the scripts in test/externalTests/.
+PROJECTS = [
+    Project('zeppelin', 'https://github.com/OpenZeppelin/openzeppelin-contracts.git', 'master', 'contracts'),
+    Project('uniswap', 'https://github.com/solidity-external-tests/uniswap-v3-core.git', 'main_080', 'contracts'),
+    Project('gnosis', 'https://github.com/solidity-external-tests/safe-contracts.git', 'development_080', 'contracts'),
+]
+
+CONFIGURATIONS = {
+    'legacy': ['--optimize', '--bin'],
+    'via-ir': ['--via-ir', '--optimize', '--bin'],
+    'model-checker': ['--model-checker-engine', 'bmc', '--model-checker-timeout', '1000'],
+}
+
+VERSION_PRAGMA_REGEX = re.compile(r'pragma solidity [^;]+;')
+
+
+class BenchmarkError(Exception):
+    pass
+
+
+def download_project(project: Project, work_dir: Path) -> Path:
+    project_dir = work_dir / project.name
+    if not project_dir.exists():
+        subprocess.run(
+            ['git', 'clone', '--depth', '1', '--branch', project.ref, project.repo, str(project_dir)],
+            check=True,
+        )
+        # Like replace_version_pragmas in test/externalTests/common.sh.
+        for source_file in project_dir.glob('**/*.sol'):
+            content = source_file.read_text(encoding='utf-8')
+            source_file.write_text(VERSION_PRAGMA_REGEX.sub('pragma solidity >=0.0;', content), encoding='utf-8')
+    return project_dir
+
+
+def flatten_phases(phases: List[dict], prefix: str = '') -> Dict[str, dict]:
+    """Converts the nested phases of the output of ``solc --profile`` into a dictionary
+    by the path of the phase, e.g. ``analysis/type checking``."""
+
+    result = {}
+    for phase in phases:
+        path = prefix + phase['name']
+        result[path] = {key: phase[key] for key in ('wallTime', 'cpuTime', 'peakMemory')}
+        result.update(flatten_phases(phase.get('phases', []), path + '/'))
+    return result
+
+
+def run_compiler(compiler_path: Path, project_dir: Path, source_dir: str, arguments: List[str]) -> dict:
+    """Compiles all the sources of the project once. Times are in microseconds, memory in kilobytes."""
+
+    source_files = sorted(str(path.relative_to(project_dir)) for path in (project_dir / source_dir).glob('**/*.sol'))
+    if len(source_files) == 0:
+        raise BenchmarkError(f"No sources found in {project_dir / source_dir}.")
+
+    with TemporaryDirectory(prefix='solc-benchmark-') as output_dir:
+        command = [str(compiler_path), *arguments, '--profile', '--overwrite', '-o', output_dir, '--base-path', '.', *source_files]
+        start = time.monotonic()
+        with subprocess.Popen(command, cwd=project_dir, stdout=subprocess.DEVNULL, stderr=subprocess.PIPE) as process:
+            stderr = process.stderr.read()
+            # Unlike Popen.wait(), wait4() returns the resource usage of the process alone.
+            _, status, usage = os.wait4(process.pid, 0)
+            process.returncode = os.waitstatus_to_exitcode(status)
+        wall_time = time.monotonic() - start
+        if process.returncode != 0:
+            raise BenchmarkError(f"Compilation failed:\n{' '.join(command)}\n{stderr.decode('utf-8', 'replace')}")
+        profile = json.loads((Path(output_dir) / 'profile.json').read_text(encoding='utf-8'))
+
+    return {
+        'wallTime': round(wall_time * 1000000),
+        # ru_maxrss is given in kilobytes on Linux.
+        'peakMemory': usage.ru_maxrss,
+        'phases': flatten_phases(profile['phases']),
+    }
+
+
+def combine_runs(runs: List[dict]) -> dict:
+    """Combines repeated measurements of the same benchmark into their medians."""
+
+    def median(values: List[int]) -> int:
+        return round(statistics.median(values))
+
+    combined = {
+        'wallTime': median([run['wallTime'] for run in runs]),
+        'peakMemory': median([run['peakMemory'] for run in runs]),
+        'phases': {},
+    }
+    for path in runs[0]['phases']:
+        if all(path in run['phases'] for run in runs):
+            combined['phases'][path] = {
+                key: median([run['phases'][path][key] for run in runs])
+                for key in runs[0]['phases'][path]
+            }
+    return combined
+
+
+def compare_with_baseline(results: Dict[str, dict], baseline: Dict[str, dict]) -> Dict[str, dict]:
+    """Adds the ratio of each measurement to the one in the baseline, if the baseline contains it.
+    The ratio of the totals is given as ``relative``, the ratio of each phase in the phase."""
+
+    def ratios(measurement: dict, baseline_measurement: dict) -> dict:
+        return {
+            key: round(measurement[key] / baseline_measurement[key], 4)
+            for key in ('wallTime', 'cpuTime', 'peakMemory')
+            if key in measurement and baseline_measurement.get(key)
+        }
+
+    compared = {}
+    for name, result in results.items():
+        compared[name] = dict(result)
+        if name not in baseline:
+            continue
+        compared[name]['relative'] = ratios(result, baseline[name])
+        compared[name]['phases'] = {
+            path: {**phase, 'relative': ratios(phase, baseline[name]['phases'][path])}
+            if path in baseline[name].get('phases', {}) else phase
+            for path, phase in result['phases'].items()
+        }
+    return compared
+
+
+def regressions(report: Dict[str, dict], threshold: float) -> List[str]:
+    """@returns the names of the benchmarks whose wall time or peak memory exceeds
+    the baseline by more than the fraction @a threshold."""
+
+    return [
+        name
+        for name, result in report.items()
+        if any(ratio > 1 + threshold for ratio in result.get('relative', {}).values())
+    ]
+
+
+def run_benchmarks(
+    compiler_path: Path,
+    work_dir: Path,
+    projects: List[Project],
+    configurations: List[str],
+    repetitions: int,
+) -> Dict[str, dict]:
+    results = {}
+    for project in projects:
+        project_dir = download_project(project, work_dir)
+        for configuration in configurations:
+            name = f'{project.name}/{configuration}'
+            print(f"Benchmarking {name}...", file=sys.stderr)
+            runs = [
+                run_compiler(compiler_path, project_dir, project.source_dir, CONFIGURATIONS[configuration])
+                for _ in range(repetitions)
+            ]
+            results[name] = combine_runs(runs)
+    return results
+
+
+def commandline_parser() -> ArgumentParser:
+    parser = ArgumentParser(description=__doc__.split('\n', maxsplit=1)[0])
+    parser.add_argument(dest='compiler_path', help="Solidity compiler executable")
+    parser.add_argument('--work-dir', dest='work_dir', default='benchmark-projects', help="Directory the projects are cloned into.")
+    parser.add_argument(
+        '--project',
+        dest='projects',
+        action='append',
+        choices=[project.name for project in PROJECTS],
+        help="Project to compile. Can be given several times. All projects by default.",
+    )
+    parser.add_argument(
+        '--configuration',
+        dest='configurations',
+        action='append',
+        choices=list(CONFIGURATIONS),
+        help="Compiler configuration to use. Can be given several times. All configurations by default.",
+    )
+    parser.add_argument('--repetitions', dest='repetitions', type=int, default=3, help="Number of compiler runs per benchmark, the median is reported.")
+    parser.add_argument('--baseline', dest='baseline', help="Report of an earlier run to compare the results with.")
+    parser.add_argument('--store-baseline', dest='store_baseline', help="Store the results as a baseline in this file.")
+    parser.add_argument('--output', dest='output', help="File to write the report to. Printed to the standard output by default.")
+    parser.add_argument(
+        '--max-regression',
+        dest='max_regression',
+        type=float,
+        help="Exit with an error if the wall time or peak memory of a benchmark exceeds the baseline by more than this fraction, e.g. 0.1.",
+    )
+    return parser
+
+
+def main(argv: Optional[List[str]] = None) -> int:
+    options = commandline_parser().parse_args(argv)
+    if options.repetitions < 1:
+        print("The number of repetitions has to be positive.", file=sys.stderr)
+        return 1
+    if options.max_regression is not None and options.baseline is None:
+        print("--max-regression requires --baseline.", file=sys.stderr)
+        return 1
+
+    work_dir = Path(options.work_dir)
+    work_dir.mkdir(parents=True, exist_ok=True)
+    try:
+        results = run_benchmarks(
+            Path(options.compiler_path).absolute(),
+            work_dir,
+            [project for project in PROJECTS if options.projects is None or project.name in options.projects],
+            options.configurations or list(CONFIGURATIONS),
+            options.repetitions,
+        )
+    except (BenchmarkError, subprocess.CalledProcessError) as error:
+        print(error, file=sys.stderr)
+        return 1
+
+    if options.store_baseline is not None:
+        Path(options.store_baseline).write_text(json.dumps(results, indent=4, sort_keys=True) + '\n', encoding='utf-8')
+
+    report = results
+    if options.baseline is not None:
+        report = compare_with_baseline(results, json.loads(Path(options.baseline).read_text(encoding='utf-8')))
+
+    report_json = json.dumps(report, indent=4, sort_keys=True) + '\n'
+    if options.output is not None:
+        Path(options.output).write_text(report_json, encoding='utf-8')
+    else:
+        print(report_json, end='')
+
+    if options.max_regression is not None:
+        regressed = regressions(report, options.max_regression)
+        if len(regressed) > 0:
+            print(f"Regressions of more than {options.max_regression:.0%}: {', '.join(regressed)}", file=sys.stderr)
+            return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
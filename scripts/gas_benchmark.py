@@ -0,0 +1,183 @@
+#!/usr/bin/env python3
+
+"""Compares the gas costs of the code generated for the semantic tests with different optimiser settings.
+
+Runs ``soltest`` on the semantic tests once for each optimiser configuration, with ``--gas-report``
+collecting the gas used by each deployment and function call of the tests, via the legacy and the
+IR pipeline. The report contains, as JSON, the total deployment and runtime gas of each configuration
+and pipeline and the tests whose gas differs the most from the reference configuration. The totals
+only include the transactions measured in all configurations, so that they stay comparable when
+some tests fail or are skipped with some of the settings.
+
+  scripts/gas_benchmark.py build/test/soltest --vm /path/to/libevmone.so
+  scripts/gas_benchmark.py build/test/soltest --vm libevmone.so --steps custom=dhfoDgvulfnTUtnIf --output gas.json
+
+Unlike ``scripts/gas_diff_stats.py``, which summarizes the changes to the gas expectations committed
+to the tests, this measures all transactions and does not depend on the expectations.
+"""
+
+import json
+import subprocess
+import sys
+from argparse import ArgumentParser
+from collections import defaultdict
+from pathlib import Path
+from tempfile import TemporaryDirectory
+from typing import Dict, List, Optional, Tuple
+
+CONFIGURATIONS = {
+    'unoptimized': [],
+    'optimized': ['--optimize'],
+    'optimized-runs-1': ['--optimize', '--optimizer-runs', '1'],
+    'optimized-runs-1000000': ['--optimize', '--optimizer-runs', '1000000'],
+}
+
+# A transaction of a test: (test, pipeline, index of the call, kind).
+TransactionKey = Tuple[str, str, int, str]
+
+
+def load_gas_report(report_file: Path, test_path: Path) -> Dict[TransactionKey, int]:
+    """Reads the lines written by soltest --gas-report. Test files are given relative to @a test_path."""
+
+    measurements = {}
+    with open(report_file, encoding='utf-8') as file:
+        for line in file:
+            if line.strip() == '':
+                continue
+            measurement = json.loads(line)
+            test = Path(measurement['test'])
+            if test.is_relative_to(test_path):
+                test = test.relative_to(test_path)
+            key = (test.as_posix(), measurement['pipeline'], measurement['call'], measurement['kind'])
+            measurements[key] = measurement['gas']
+    return measurements
+
+
+def summarize(
+    measurements: Dict[str, Dict[TransactionKey, int]],
+    reference: str,
+    top: int,
+) -> dict:
+    """Computes the totals of each configuration and pipeline over the transactions measured in all
+    configurations and the tests whose total gas differs the most from @a reference."""
+
+    common_keys = set.intersection(*(set(configuration.keys()) for configuration in measurements.values()))
+
+    totals = {}
+    per_test = {}
+    for name, configuration in measurements.items():
+        totals[name] = defaultdict(lambda: {'deployment': 0, 'runtime': 0})
+        per_test[name] = defaultdict(int)
+        for key in common_keys:
+            test, pipeline, _, kind = key
+            totals[name][pipeline][kind] += configuration[key]
+            per_test[name][(test, pipeline, kind)] += configuration[key]
+
+    report = {
+        'reference': reference,
+        'transactions': len(common_keys),
+        'totals': {name: dict(pipelines) for name, pipelines in totals.items()},
+        'differences': {},
+    }
+    for name in measurements:
+        if name == reference:
+            continue
+        differences = [
+            {
+                'test': test,
+                'pipeline': pipeline,
+                'kind': kind,
+                'gas': gas,
+                'referenceGas': per_test[reference][(test, pipeline, kind)],
+                'difference': gas - per_test[reference][(test, pipeline, kind)],
+            }
+            for (test, pipeline, kind), gas in per_test[name].items()
+            if gas != per_test[reference][(test, pipeline, kind)]
+        ]
+        differences.sort(key=lambda difference: (-abs(difference['difference']), difference['test'], difference['pipeline'], difference['kind']))
+        report['differences'][name] = differences[:top]
+    return report
+
+
+def run_soltest(soltest_path: Path, test_path: Path, vm_path: str, arguments: List[str], report_file: Path) -> None:
+    command = [
+        str(soltest_path),
+        '--run_test=semanticTests',
+        '--log_level=nothing',
+        '--report_level=no',
+        '--',
+        '--testpath', str(test_path),
+        '--vm', vm_path,
+        '--gas-report', str(report_file),
+        *arguments,
+    ]
+    result = subprocess.run(command, check=False)
+    # Failing tests still report the gas of the transactions they ran.
+    if result.returncode != 0:
+        print(f"Some tests failed with: {' '.join(arguments)}", file=sys.stderr)
+
+
+def commandline_parser() -> ArgumentParser:
+    parser = ArgumentParser(description=__doc__.split('\n', maxsplit=1)[0])
+    parser.add_argument(dest='soltest_path', help="soltest executable")
+    parser.add_argument('--vm', dest='vm_path', required=True, help="Path to the evmc library of the EVM, e.g. evmone.")
+    parser.add_argument('--testpath', dest='test_path', default=str(Path(__file__).parent.parent / 'test'), help="Path to the test files.")
+    parser.add_argument(
+        '--configuration',
+        dest='configurations',
+        action='append',
+        choices=list(CONFIGURATIONS),
+        help="Optimiser configuration to measure. Can be given several times. All configurations by default.",
+    )
+    parser.add_argument(
+        '--steps',
+        dest='steps',
+        action='append',
+        default=[],
+        metavar='NAME=SEQUENCE',
+        help="Additionally measure the optimized code with a custom Yul optimiser sequence. Can be given several times.",
+    )
+    parser.add_argument('--reference', dest='reference', help="Configuration to compare the others with. The first one by default.")
+    parser.add_argument('--top', dest='top', type=int, default=50, help="Number of differing tests to report per configuration.")
+    parser.add_argument('--output', dest='output', help="File to write the report to. Printed to the standard output by default.")
+    return parser
+
+
+def main(argv: Optional[List[str]] = None) -> int:
+    options = commandline_parser().parse_args(argv)
+
+    configurations = {name: CONFIGURATIONS[name] for name in (options.configurations or CONFIGURATIONS)}
+    for steps in options.steps:
+        name, separator, sequence = steps.partition('=')
+        if separator == '' or name == '' or name in configurations:
+            print(f"Invalid or duplicate custom sequence: {steps}", file=sys.stderr)
+            return 1
+        configurations[name] = ['--optimize', '--yul-optimizer-steps', sequence]
+
+    reference = options.reference or next(iter(configurations))
+    if reference not in configurations:
+        print(f"Unknown reference configuration: {reference}", file=sys.stderr)
+        return 1
+
+    test_path = Path(options.test_path).absolute()
+    measurements = {}
+    with TemporaryDirectory(prefix='solidity-gas-benchmark-') as report_dir:
+        for name, arguments in configurations.items():
+            print(f"Running the semantic tests with the configuration {name}...", file=sys.stderr)
+            report_file = Path(report_dir) / f'{name}.jsonl'
+            run_soltest(Path(options.soltest_path), test_path, options.vm_path, arguments, report_file)
+            if not report_file.exists():
+                print(f"No gas was reported with the configuration {name}.", file=sys.stderr)
+                return 1
+            measurements[name] = load_gas_report(report_file, test_path)
+
+    report_json = json.dumps(summarize(measurements, reference, options.top), indent=4, sort_keys=True) + '\n'
+    if options.output is not None:
+        Path(options.output).write_text(report_json, encoding='utf-8')
+    else:
+        print(report_json, end='')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,196 @@
+#!/usr/bin/env python3
+
+"""Compares the gas costs and code sizes of contracts compiled via the legacy and the IR pipeline.
+
+The calls to execute are given as a directory of semantic tests (see ``test/libsolidity/semanticTests/``),
+e.g. calls recorded from a project, whose sources the tests can include with ``==== ExternalSource:``.
+``soltest`` runs them with ``--enforce-via-yul`` and ``--gas-report``, so that every test is executed via
+both pipelines. The report lists, for each function and deployment, the gas used with both pipelines and,
+for deployments, the size of the deployed code. It is printed as a table and can be written as JSON.
+
+  scripts/ir_gas_comparison.py build/test/soltest --vm /path/to/libevmone.so traces/
+  scripts/ir_gas_comparison.py build/test/soltest --vm libevmone.so --optimize traces/ --output report.json
+
+Only the transactions that succeeded within the gas limit via both pipelines are compared.
+"""
+
+import json
+import subprocess
+import sys
+from argparse import ArgumentParser
+from pathlib import Path
+from tempfile import TemporaryDirectory
+from typing import Dict, List, Optional, Tuple
+
+# Name of the directory the traces are linked to in the semantic tests of the temporary test path.
+TRACE_SUITE = 'trace'
+
+# A transaction of a test: (test, index of the call, kind).
+TransactionKey = Tuple[str, int, str]
+
+
+def load_gas_report(report_file: Path, trace_path: Path) -> Dict[str, Dict[TransactionKey, dict]]:
+    """Reads the lines written by soltest --gas-report, by pipeline. Test files are given relative to @a trace_path."""
+
+    measurements: Dict[str, Dict[TransactionKey, dict]] = {}
+    with open(report_file, encoding='utf-8') as file:
+        for line in file:
+            if line.strip() == '':
+                continue
+            measurement = json.loads(line)
+            test = Path(measurement['test'])
+            if test.is_relative_to(trace_path):
+                test = test.relative_to(trace_path)
+            key = (test.as_posix(), measurement['call'], measurement['kind'])
+            measurements.setdefault(measurement['pipeline'], {})[key] = measurement
+    return measurements
+
+
+def compare(legacy: Dict[TransactionKey, dict], ir: Dict[TransactionKey, dict]) -> List[dict]:
+    """Sums up the gas of the transactions measured via both pipelines by test, kind and signature."""
+
+    rows: Dict[Tuple[str, str, str], dict] = {}
+    for key in sorted(set(legacy.keys()) & set(ir.keys())):
+        test, _, kind = key
+        signature = legacy[key]['signature']
+        row = rows.setdefault((test, kind, signature), {
+            'test': test,
+            'kind': kind,
+            'signature': signature,
+            'calls': 0,
+            'legacyGas': 0,
+            'irGas': 0,
+        })
+        row['calls'] += 1
+        row['legacyGas'] += legacy[key]['gas']
+        row['irGas'] += ir[key]['gas']
+        if 'codeSize' in legacy[key] and 'codeSize' in ir[key]:
+            row['legacyCodeSize'] = legacy[key]['codeSize']
+            row['irCodeSize'] = ir[key]['codeSize']
+
+    for row in rows.values():
+        row['gasDifference'] = row['irGas'] - row['legacyGas']
+        if 'legacyCodeSize' in row:
+            row['codeSizeDifference'] = row['irCodeSize'] - row['legacyCodeSize']
+    return sorted(rows.values(), key=lambda row: (row['test'], row['kind'] != 'deployment', row['signature']))
+
+
+def totals(rows: List[dict]) -> dict:
+    return {
+        kind: {
+            'legacyGas': sum(row['legacyGas'] for row in rows if row['kind'] == kind),
+            'irGas': sum(row['irGas'] for row in rows if row['kind'] == kind),
+        }
+        for kind in ('deployment', 'runtime')
+    }
+
+
+def format_percentage(difference: int, reference: int) -> str:
+    return f'{difference / reference:+.1%}' if reference != 0 else ''
+
+
+def format_table(rows: List[dict]) -> str:
+    header = ['Test', 'Function', 'Calls', 'Legacy gas', 'IR gas', 'Difference', '', 'Legacy size', 'IR size', 'Difference']
+    table = [header]
+    for row in rows:
+        table.append([
+            row['test'],
+            row['signature'] if row['kind'] == 'runtime' else f"deploy {row['signature']}",
+            str(row['calls']),
+            str(row['legacyGas']),
+            str(row['irGas']),
+            f"{row['gasDifference']:+}",
+            format_percentage(row['gasDifference'], row['legacyGas']),
+            str(row.get('legacyCodeSize', '')),
+            str(row.get('irCodeSize', '')),
+            f"{row['codeSizeDifference']:+}" if 'codeSizeDifference' in row else '',
+        ])
+    for kind, total in totals(rows).items():
+        difference = total['irGas'] - total['legacyGas']
+        table.append([
+            f'Total ({kind})', '', '',
+            str(total['legacyGas']),
+            str(total['irGas']),
+            f'{difference:+}',
+            format_percentage(difference, total['legacyGas']),
+            '', '', '',
+        ])
+
+    widths = [max(len(line[column]) for line in table) for column in range(len(header))]
+    return ''.join(
+        # Left-align the names, right-align the numbers.
+        '  '.join(
+            cell.ljust(width) if column < 2 else cell.rjust(width)
+            for column, (cell, width) in enumerate(zip(line, widths))
+        ).rstrip() + '\n'
+        for line in table
+    )
+
+
+def run_soltest(soltest_path: Path, test_path: Path, vm_path: str, arguments: List[str], report_file: Path) -> None:
+    command = [
+        str(soltest_path),
+        f'--run_test=semanticTests/{TRACE_SUITE}',
+        '--log_level=nothing',
+        '--report_level=no',
+        '--',
+        '--testpath', str(test_path),
+        '--vm', vm_path,
+        '--enforce-via-yul',
+        '--gas-report', str(report_file),
+        *arguments,
+    ]
+    result = subprocess.run(command, check=False)
+    # Failing tests still report the gas of the transactions they ran.
+    if result.returncode != 0:
+        print("Some of the traces failed.", file=sys.stderr)
+
+
+def commandline_parser() -> ArgumentParser:
+    parser = ArgumentParser(description=__doc__.split('\n', maxsplit=1)[0])
+    parser.add_argument(dest='soltest_path', help="soltest executable")
+    parser.add_argument(dest='trace_path', help="Directory of semantic tests with the calls to execute.")
+    parser.add_argument('--vm', dest='vm_path', required=True, help="Path to the evmc library of the EVM, e.g. evmone.")
+    parser.add_argument('--optimize', dest='optimize', action='store_true', help="Enable the optimiser.")
+    parser.add_argument('--optimizer-runs', dest='optimizer_runs', type=int, help="Number of runs the optimiser expects.")
+    parser.add_argument('--output', dest='output', help="File to write the report to as JSON.")
+    return parser
+
+
+def main(argv: Optional[List[str]] = None) -> int:
+    options = commandline_parser().parse_args(argv)
+    trace_path = Path(options.trace_path).absolute()
+    if not trace_path.is_dir():
+        print(f"Not a directory: {trace_path}", file=sys.stderr)
+        return 1
+
+    arguments = []
+    if options.optimize:
+        arguments.append('--optimize')
+    if options.optimizer_runs is not None:
+        arguments += ['--optimizer-runs', str(options.optimizer_runs)]
+
+    with TemporaryDirectory(prefix='solidity-ir-gas-comparison-') as directory:
+        # soltest only runs tests from the semantic tests directory of its test path. A link keeps
+        # the paths of the external sources relative to the traces valid.
+        semantic_tests_path = Path(directory) / 'libsolidity' / 'semanticTests'
+        semantic_tests_path.mkdir(parents=True)
+        (semantic_tests_path / TRACE_SUITE).symlink_to(trace_path, target_is_directory=True)
+
+        report_file = Path(directory) / 'report.jsonl'
+        run_soltest(Path(options.soltest_path), Path(directory), options.vm_path, arguments, report_file)
+        if not report_file.exists():
+            print("No gas was reported.", file=sys.stderr)
+            return 1
+        measurements = load_gas_report(report_file, semantic_tests_path / TRACE_SUITE)
+
+    rows = compare(measurements.get('legacy', {}), measurements.get('ir', {}))
+    print(format_table(rows), end='')
+    if options.output is not None:
+        report = {'functions': rows, 'totals': totals(rows)}
+        Path(options.output).write_text(json.dumps(report, indent=4, sort_keys=True) + '\n', encoding='utf-8')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -32,6 +32,7 @@
 #include <libsolidity/ast/ASTJsonConverter.h>
 #include <libsolidity/ast/ASTJsonImporter.h>
 #include <libsolidity/analysis/NameAndTypeResolver.h>
+#include <libsolidity/interface/ArtifactCache.h>
 #include <libsolidity/interface/CompilerStack.h>
 #include <libsolidity/interface/StandardCompiler.h>
 #include <libsolidity/interface/GasEstimator.h>
@@ -56,10 +57,16 @@
 #include <libsolutil/CommonData.h>
 #include <libsolutil/CommonIO.h>
 #include <libsolutil/JSON.h>
+#include <libsolutil/Profiler.h>
+#include <libsolutil/ThreadPool.h>
 
 #include <algorithm>
+#include <exception>
 #include <fstream>
 #include <memory>
+#include <set>
+#include <sstream>
+#include <string_view>
 
 #include <range/v3/view/map.hpp>
 
@@ -504,6 +511,7 @@ void CommandLineInterface::readInputFiles()
 
 	if (
 		m_options.input.mode != InputMode::LanguageServer &&
+		m_options.input.mode != InputMode::CompilerServer &&
 		m_fileReader.sourceUnits().empty() &&
 		!m_standardJsonInput.has_value()
 	)
@@ -520,7 +528,11 @@ map<string, Json::Value> CommandLineInterface::parseAstFromInput()
 	for (SourceCode const& sourceCode: m_fileReader.sourceUnits() | ranges::views::values)
 	{
 		Json::Value ast;
-		astAssert(jsonParseStrict(sourceCode, ast), "Input file could not be parsed to JSON");
+		// CBOR is much faster to decode and can be produced from the JSON output by any CBOR encoder.
+		if (isCBORObject(sourceCode))
+			astAssert(jsonParseCBOR(sourceCode, ast), "Input file could not be decoded from CBOR");
+		else
+			astAssert(jsonParseStrict(sourceCode, ast), "Input file could not be parsed to JSON");
 		astAssert(ast.isMember("sources"), "Invalid Format for import-JSON: Must have 'sources'-object");
 
 		for (auto& src: ast["sources"].getMemberNames())
@@ -541,6 +553,11 @@ map<string, Json::Value> CommandLineInterface::parseAstFromInput()
 }
 
 void CommandLineInterface::createFile(string const& _fileName, string const& _data)
+{
+	createFile(_fileName, [&](ostream& _stream) { _stream << _data; });
+}
+
+void CommandLineInterface::createFile(string const& _fileName, function<void(ostream&)> const& _write)
 {
 	namespace fs = boost::filesystem;
 
@@ -556,7 +573,7 @@ void CommandLineInterface::createFile(string const& _fileName, string const& _da
 		solThrow(CommandLineOutputError, "Refusing to overwrite existing file \"" + pathName + "\" (use --overwrite to force).");
 
 	ofstream outFile(pathName);
-	outFile << _data;
+	_write(outFile);
 	if (!outFile)
 		solThrow(CommandLineOutputError, "Could not write to file \"" + pathName + "\".");
 }
@@ -566,6 +583,11 @@ void CommandLineInterface::createJson(string const& _fileName, string const& _js
 	createFile(boost::filesystem::basename(_fileName) + string(".json"), _json);
 }
 
+void CommandLineInterface::createJson(string const& _fileName, function<void(ostream&)> const& _write)
+{
+	createFile(boost::filesystem::basename(_fileName) + string(".json"), _write);
+}
+
 bool CommandLineInterface::run(int _argc, char const* const* _argv)
 {
 	try
@@ -627,13 +649,17 @@ void CommandLineInterface::processInput()
 		solAssert(m_standardJsonInput.has_value(), "");
 
 		StandardCompiler compiler(m_fileReader.reader(), m_options.formatting.json);
-		sout() << compiler.compile(move(m_standardJsonInput.value())) << endl;
+		compiler.compile(m_standardJsonInput.value(), sout());
+		sout() << endl;
 		m_standardJsonInput.reset();
 		break;
 	}
 	case InputMode::LanguageServer:
 		serveLSP();
 		break;
+	case InputMode::CompilerServer:
+		serveCompiler();
+		break;
 	case InputMode::Assembler:
 		assemble(m_options.assembly.inputLanguage, m_options.assembly.targetMachine);
 		break;
@@ -679,6 +705,13 @@ void CommandLineInterface::compile()
 		m_compiler->setRemappings(m_options.input.remappings);
 		m_compiler->setLibraries(m_options.linker.libraries);
 		m_compiler->setViaIR(m_options.output.experimentalViaIR);
+		m_compiler->setParallelism(
+			m_options.output.jobs == 0 ?
+			util::ThreadPool::hardwareConcurrency() :
+			m_options.output.jobs
+		);
+		if (!m_options.output.cacheDir.empty())
+			m_compiler->setArtifactCache(make_shared<DirectoryArtifactCache>(m_options.output.cacheDir));
 		m_compiler->setEVMVersion(m_options.output.evmVersion);
 		m_compiler->setRevertStringBehaviour(m_options.output.revertStrings);
 		if (m_options.output.debugInfoSelection.has_value())
@@ -707,9 +740,31 @@ void CommandLineInterface::compile()
 				m_options.compiler.combinedJsonRequests->funDebugRuntime
 			))
 		);
+		m_compiler->enableDebugInfoGeneration(
+			m_options.compiler.estimateGas ||
+			m_options.compiler.outputs.asm_ ||
+			m_options.compiler.outputs.asmJson ||
+			m_options.compiler.outputs.ir ||
+			m_options.compiler.outputs.irOptimized ||
+			m_options.compiler.outputs.ewasm ||
+			m_options.compiler.outputs.ewasmIR ||
+			(m_options.compiler.combinedJsonRequests && (
+				m_options.compiler.combinedJsonRequests->asm_ ||
+				m_options.compiler.combinedJsonRequests->generatedSources ||
+				m_options.compiler.combinedJsonRequests->generatedSourcesRuntime ||
+				m_options.compiler.combinedJsonRequests->srcMap ||
+				m_options.compiler.combinedJsonRequests->srcMapRuntime ||
+				m_options.compiler.combinedJsonRequests->funDebug ||
+				m_options.compiler.combinedJsonRequests->funDebugRuntime
+			))
+		);
 
 		m_compiler->setOptimiserSettings(m_options.optimiserSettings());
 
+		if (m_options.output.profile)
+			util::Profiler::instance().enable();
+		ScopeGuard disableProfiler{[]() { util::Profiler::instance().disable(); }};
+
 		if (m_options.input.mode == InputMode::CompilerWithASTImport)
 		{
 			try
@@ -756,7 +811,7 @@ void CommandLineInterface::compile()
 	{
 		if (_error.type() == Error::Type::DocstringParsingError)
 		{
-			serr() << *boost::get_error_info<errinfo_comment>(_error);
+			serr() << *_error.comment();
 			solThrow(CommandLineExecutionError, "Documentation parsing failed.");
 		}
 		else
@@ -775,89 +830,109 @@ void CommandLineInterface::handleCombinedJSON()
 	if (!m_options.compiler.combinedJsonRequests.has_value())
 		return;
 
-	Json::Value output(Json::objectValue);
+	if (!m_options.output.dir.empty())
+		createJson("combined", [&](ostream& _stream) { writeCombinedJSON(_stream); });
+	else
+	{
+		writeCombinedJSON(sout());
+		sout() << endl;
+	}
+}
+
+void CommandLineInterface::writeCombinedJSON(ostream& _stream)
+{
+	CombinedJsonRequests const& requests = *m_options.compiler.combinedJsonRequests;
 
-	output[g_strVersion] = frontend::VersionString;
-	vector<string> contracts = m_compiler->contractNames();
+	// The members are written in the order in which jsoncpp sorts them. Every contract and every
+	// source is written as soon as its data is generated, so that only one of them is kept in memory.
+	JsonStreamWriter writer(_stream, m_options.formatting.json);
+	writer.beginObject();
 
+	vector<string> contracts = m_compiler->contractNames();
+	sort(contracts.begin(), contracts.end());
 	if (!contracts.empty())
-		output[g_strContracts] = Json::Value(Json::objectValue);
-	for (string const& contractName: contracts)
 	{
-		Json::Value& contractData = output[g_strContracts][contractName] = Json::objectValue;
-		if (m_options.compiler.combinedJsonRequests->abi)
-			contractData[g_strAbi] = m_compiler->contractABI(contractName);
-		if (m_options.compiler.combinedJsonRequests->metadata)
-			contractData["metadata"] = m_compiler->metadata(contractName);
-		if (m_options.compiler.combinedJsonRequests->binary && m_compiler->compilationSuccessful())
-			contractData[g_strBinary] = m_compiler->object(contractName).toHex();
-		if (m_options.compiler.combinedJsonRequests->binaryRuntime && m_compiler->compilationSuccessful())
-			contractData[g_strBinaryRuntime] = m_compiler->runtimeObject(contractName).toHex();
-		if (m_options.compiler.combinedJsonRequests->opcodes && m_compiler->compilationSuccessful())
-			contractData[g_strOpcodes] = evmasm::disassemble(m_compiler->object(contractName).bytecode);
-		if (m_options.compiler.combinedJsonRequests->asm_ && m_compiler->compilationSuccessful())
-			contractData[g_strAsm] = m_compiler->assemblyJSON(contractName);
-		if (m_options.compiler.combinedJsonRequests->storageLayout && m_compiler->compilationSuccessful())
-			contractData[g_strStorageLayout] = m_compiler->storageLayout(contractName);
-		if (m_options.compiler.combinedJsonRequests->generatedSources && m_compiler->compilationSuccessful())
-			contractData[g_strGeneratedSources] = m_compiler->generatedSources(contractName, false);
-		if (m_options.compiler.combinedJsonRequests->generatedSourcesRuntime && m_compiler->compilationSuccessful())
-			contractData[g_strGeneratedSourcesRuntime] = m_compiler->generatedSources(contractName, true);
-		if (m_options.compiler.combinedJsonRequests->srcMap && m_compiler->compilationSuccessful())
-		{
-			auto map = m_compiler->sourceMapping(contractName);
-			contractData[g_strSrcMap] = map ? *map : "";
-		}
-		if (m_options.compiler.combinedJsonRequests->srcMapRuntime && m_compiler->compilationSuccessful())
-		{
-			auto map = m_compiler->runtimeSourceMapping(contractName);
-			contractData[g_strSrcMapRuntime] = map ? *map : "";
-		}
-		if (m_options.compiler.combinedJsonRequests->funDebug && m_compiler->compilationSuccessful())
-			contractData[g_strFunDebug] = StandardCompiler::formatFunctionDebugData(
-				m_compiler->object(contractName).functionDebugData
-			);
-		if (m_options.compiler.combinedJsonRequests->funDebugRuntime && m_compiler->compilationSuccessful())
-			contractData[g_strFunDebugRuntime] = StandardCompiler::formatFunctionDebugData(
-				m_compiler->runtimeObject(contractName).functionDebugData
-			);
-		if (m_options.compiler.combinedJsonRequests->signatureHashes)
-			contractData[g_strSignatureHashes] = m_compiler->methodIdentifiers(contractName);
-		if (m_options.compiler.combinedJsonRequests->natspecDev)
-			contractData[g_strNatspecDev] = m_compiler->natspecDev(contractName);
-		if (m_options.compiler.combinedJsonRequests->natspecUser)
-			contractData[g_strNatspecUser] = m_compiler->natspecUser(contractName);
+		writer.beginObject(g_strContracts);
+		for (string const& contractName: contracts)
+			writer.writeMember(contractName, removeNullMembers(combinedJSONContractData(contractName)));
+		writer.endObject();
 	}
 
-	bool needsSourceList =
-		m_options.compiler.combinedJsonRequests->ast ||
-		m_options.compiler.combinedJsonRequests->srcMap ||
-		m_options.compiler.combinedJsonRequests->srcMapRuntime;
-	if (needsSourceList)
+	if (requests.ast || requests.srcMap || requests.srcMapRuntime)
 	{
 		// Indices into this array are used to abbreviate source names in source locations.
-		output[g_strSourceList] = Json::Value(Json::arrayValue);
-
+		Json::Value sourceList(Json::arrayValue);
 		for (auto const& source: m_compiler->sourceNames())
-			output[g_strSourceList].append(source);
+			sourceList.append(source);
+		writer.writeMember(g_strSourceList, sourceList);
 	}
 
-	if (m_options.compiler.combinedJsonRequests->ast)
+	if (requests.ast)
 	{
-		output[g_strSources] = Json::Value(Json::objectValue);
+		writer.beginObject(g_strSources);
 		for (auto const& sourceCode: m_fileReader.sourceUnits())
 		{
 			ASTJsonConverter converter(m_compiler->state(), m_compiler->sourceIndices());
-			output[g_strSources][sourceCode.first] = Json::Value(Json::objectValue);
-			output[g_strSources][sourceCode.first]["AST"] = converter.toJson(m_compiler->ast(sourceCode.first));
+			Json::Value source(Json::objectValue);
+			source["AST"] = converter.toJson(m_compiler->ast(sourceCode.first));
+			writer.writeMember(sourceCode.first, removeNullMembers(move(source)));
 		}
+		writer.endObject();
 	}
 
-	string json = jsonPrint(removeNullMembers(std::move(output)), m_options.formatting.json);
-	if (!m_options.output.dir.empty())
-		createJson("combined", json);
-	else
-		sout() << json << endl;
+	writer.writeMember(g_strVersion, frontend::VersionString);
+	writer.endObject();
+}
+
+Json::Value CommandLineInterface::combinedJSONContractData(string const& _contractName) const
+{
+	CombinedJsonRequests const& requests = *m_options.compiler.combinedJsonRequests;
+	bool const compilationSuccessful = m_compiler->compilationSuccessful();
+
+	Json::Value contractData(Json::objectValue);
+	if (requests.abi)
+		contractData[g_strAbi] = m_compiler->contractABI(_contractName);
+	if (requests.metadata)
+		contractData["metadata"] = m_compiler->metadata(_contractName);
+	if (requests.binary && compilationSuccessful)
+		contractData[g_strBinary] = m_compiler->object(_contractName).toHex();
+	if (requests.binaryRuntime && compilationSuccessful)
+		contractData[g_strBinaryRuntime] = m_compiler->runtimeObject(_contractName).toHex();
+	if (requests.opcodes && compilationSuccessful)
+		contractData[g_strOpcodes] = evmasm::disassemble(m_compiler->object(_contractName).bytecode);
+	if (requests.asm_ && compilationSuccessful)
+		contractData[g_strAsm] = m_compiler->assemblyJSON(_contractName);
+	if (requests.storageLayout && compilationSuccessful)
+		contractData[g_strStorageLayout] = m_compiler->storageLayout(_contractName);
+	if (requests.generatedSources && compilationSuccessful)
+		contractData[g_strGeneratedSources] = m_compiler->generatedSources(_contractName, false);
+	if (requests.generatedSourcesRuntime && compilationSuccessful)
+		contractData[g_strGeneratedSourcesRuntime] = m_compiler->generatedSources(_contractName, true);
+	if (requests.srcMap && compilationSuccessful)
+	{
+		auto map = m_compiler->sourceMapping(_contractName);
+		contractData[g_strSrcMap] = map ? *map : "";
+	}
+	if (requests.srcMapRuntime && compilationSuccessful)
+	{
+		auto map = m_compiler->runtimeSourceMapping(_contractName);
+		contractData[g_strSrcMapRuntime] = map ? *map : "";
+	}
+	if (requests.funDebug && compilationSuccessful)
+		contractData[g_strFunDebug] = StandardCompiler::formatFunctionDebugData(
+			m_compiler->object(_contractName).functionDebugData
+		);
+	if (requests.funDebugRuntime && compilationSuccessful)
+		contractData[g_strFunDebugRuntime] = StandardCompiler::formatFunctionDebugData(
+			m_compiler->runtimeObject(_contractName).functionDebugData
+		);
+	if (requests.signatureHashes)
+		contractData[g_strSignatureHashes] = m_compiler->methodIdentifiers(_contractName);
+	if (requests.natspecDev)
+		contractData[g_strNatspecDev] = m_compiler->natspecDev(_contractName);
+	if (requests.natspecUser)
+		contractData[g_strNatspecUser] = m_compiler->natspecUser(_contractName);
+	return contractData;
 }
 
 void CommandLineInterface::handleAst()
@@ -894,6 +969,20 @@ void CommandLineInterface::handleAst()
 	}
 }
 
+void CommandLineInterface::handleProfile()
+{
+	solAssert(m_options.input.mode == InputMode::Compiler || m_options.input.mode == InputMode::CompilerWithASTImport, "");
+
+	if (!m_options.output.profile)
+		return;
+
+	string data = jsonPrint(util::Profiler::instance().toJson(), m_options.formatting.json);
+	if (!m_options.output.dir.empty())
+		createJson("profile", data);
+	else
+		sout() << "Profile:" << endl << data << endl;
+}
+
 void CommandLineInterface::serveLSP()
 {
 	lsp::IOStreamTransport transport;
@@ -901,13 +990,110 @@ void CommandLineInterface::serveLSP()
 		solThrow(CommandLineExecutionError, "LSP terminated abnormally.");
 }
 
+void CommandLineInterface::serveCompiler()
+{
+	// The requests are compiled one after the other, since the compiler uses global state,
+	// but they share the code generation artifacts of unchanged contracts.
+	shared_ptr<ArtifactCache> artifactCache;
+	if (!m_options.output.cacheDir.empty())
+		artifactCache = make_shared<DirectoryArtifactCache>(m_options.output.cacheDir);
+	else
+		artifactCache = make_shared<MemoryArtifactCache>();
+
+	lsp::IOStreamTransport transport(m_sin, m_sout);
+	while (!transport.closed())
+	{
+		optional<Json::Value> message = transport.receive();
+		if (!message)
+			continue;
+
+		string const method = (*message)["method"].isString() ? (*message)["method"].asString() : "";
+		lsp::MessageID const id = (*message)["id"];
+		if (method == "exit")
+			break;
+		else if (method == "compile")
+		{
+			// The files are read from disk again, since they might have changed since the last request.
+			m_fileReader.setSourceUnits({});
+			StandardCompiler compiler(m_fileReader.reader(), m_options.formatting.json);
+			compiler.setArtifactCache(artifactCache);
+			transport.reply(id, compiler.compile((*message)["params"]));
+		}
+		else
+			transport.error(id, lsp::ErrorCode::MethodNotFound, "Unknown method " + method);
+	}
+}
+
+namespace
+{
+
+int const placeholderSize = 40; // 20 bytes or 40 hex characters
+
+/// Replaces the placeholders of the libraries in @a _libraryAddresses in the hex object @a _code
+/// and removes the lines in @a _resolvedHints, in a single pass each.
+/// Writes a message for every unresolved placeholder to @a _unresolved.
+void linkFile(
+	string const& _fileName,
+	string& _code,
+	map<string, h160> const& _libraryAddresses,
+	set<string, less<>> const& _resolvedHints,
+	ostream& _unresolved
+)
+{
+	auto end = _code.end();
+	for (auto it = _code.begin(); it != end;)
+	{
+		while (it != end && *it != '_') ++it;
+		if (it == end) break;
+		if (
+			end - it < placeholderSize ||
+			*(it + 1) != '_' ||
+			*(it + placeholderSize - 2) != '_' ||
+			*(it + placeholderSize - 1) != '_'
+		)
+			solThrow(
+				CommandLineExecutionError,
+				"Error in binary object file " + _fileName + " at position " + to_string(it - _code.begin()) + "\n" +
+				'"' + string(it, it + min(placeholderSize, static_cast<int>(end - it))) + "\" is not a valid link reference."
+			);
+
+		string foundPlaceholder(it, it + placeholderSize);
+		if (_libraryAddresses.count(foundPlaceholder))
+		{
+			string hexStr(toHex(_libraryAddresses.at(foundPlaceholder).asBytes()));
+			copy(hexStr.begin(), hexStr.end(), it);
+		}
+		else
+			_unresolved << "Reference \"" << foundPlaceholder << "\" in file \"" << _fileName << "\" still unresolved." << endl;
+		it += placeholderSize;
+	}
+
+	// Remove hints for resolved libraries, each of which is a line of its own, and trailing newlines.
+	string linked;
+	linked.reserve(_code.size());
+	for (size_t lineStart = 0; lineStart < _code.size();)
+	{
+		size_t lineEnd = min(_code.find('\n', lineStart + 1), _code.size());
+		// The line including the newline preceding it.
+		string_view line(_code.data() + lineStart, lineEnd - lineStart);
+		if (line.front() != '\n' || !_resolvedHints.count(line.substr(1)))
+			linked.append(line);
+		lineStart = lineEnd;
+	}
+	while (!linked.empty() && linked.back() == '\n')
+		linked.pop_back();
+	_code = move(linked);
+}
+
+}
+
 void CommandLineInterface::link()
 {
 	solAssert(m_options.input.mode == InputMode::Linker, "");
 
 	// Map from how the libraries will be named inside the bytecode to their addresses.
 	map<string, h160> librariesReplacements;
-	int const placeholderSize = 40; // 20 bytes or 40 hex characters
+	set<string, less<>> resolvedHints;
 	for (auto const& library: m_options.linker.libraries)
 	{
 		string const& name = library.first;
@@ -923,43 +1109,38 @@ void CommandLineInterface::link()
 			replacement.push_back(i < name.size() ? name[i] : '_');
 		replacement += "__";
 		librariesReplacements[replacement] = library.second;
+
+		resolvedHints.insert(libraryPlaceholderHint(name));
 	}
 
 	FileReader::StringMap sourceCodes = m_fileReader.sourceUnits();
+	vector<FileReader::StringMap::value_type*> files;
 	for (auto& src: sourceCodes)
-	{
-		auto end = src.second.end();
-		for (auto it = src.second.begin(); it != end;)
+		files.emplace_back(&src);
+
+	// The files are linked independently. Messages and errors are reported in the order of the
+	// files afterwards, so that the output does not depend on the number of jobs.
+	vector<ostringstream> unresolved(files.size());
+	vector<exception_ptr> errors(files.size());
+	auto linkFileAt = [&](size_t _index) {
+		try
 		{
-			while (it != end && *it != '_') ++it;
-			if (it == end) break;
-			if (
-				end - it < placeholderSize ||
-				*(it + 1) != '_' ||
-				*(it + placeholderSize - 2) != '_' ||
-				*(it + placeholderSize - 1) != '_'
-			)
-				solThrow(
-					CommandLineExecutionError,
-					"Error in binary object file " + src.first + " at position " + to_string(it - src.second.begin()) + "\n" +
-					'"' + string(it, it + min(placeholderSize, static_cast<int>(end - it))) + "\" is not a valid link reference."
-				);
-
-			string foundPlaceholder(it, it + placeholderSize);
-			if (librariesReplacements.count(foundPlaceholder))
-			{
-				string hexStr(toHex(librariesReplacements.at(foundPlaceholder).asBytes()));
-				copy(hexStr.begin(), hexStr.end(), it);
-			}
-			else
-				serr() << "Reference \"" << foundPlaceholder << "\" in file \"" << src.first << "\" still unresolved." << endl;
-			it += placeholderSize;
+			linkFile(files[_index]->first, files[_index]->second, librariesReplacements, resolvedHints, unresolved[_index]);
 		}
-		// Remove hints for resolved libraries.
-		for (auto const& library: m_options.linker.libraries)
-			boost::algorithm::erase_all(src.second, "\n" + libraryPlaceholderHint(library.first));
-		while (!src.second.empty() && *prev(src.second.end()) == '\n')
-			src.second.resize(src.second.size() - 1);
+		catch (...)
+		{
+			errors[_index] = current_exception();
+		}
+	};
+	size_t jobs = m_options.output.jobs == 0 ? util::ThreadPool::hardwareConcurrency() : m_options.output.jobs;
+	util::parallelFor(files.size(), jobs, linkFileAt);
+
+	for (size_t i = 0; i < files.size(); ++i)
+	{
+		if (!unresolved[i].str().empty())
+			serr() << unresolved[i].str();
+		if (errors[i])
+			rethrow_exception(errors[i]);
 	}
 	m_fileReader.setSourceUnits(move(sourceCodes));
 }
@@ -1113,6 +1294,8 @@ void CommandLineInterface::outputCompilationResults()
 	// do we need AST output?
 	handleAst();
 
+	handleProfile();
+
 	if (
 		!m_compiler->compilationSuccessful() &&
 		m_options.output.stopAfter == CompilerStack::State::CompilationSuccessful
@@ -1156,6 +1339,9 @@ void CommandLineInterface::outputCompilationResults()
 		handleStorageLayout(contract);
 		handleNatspec(true, contract);
 		handleNatspec(false, contract);
+
+		// All outputs of the contract are written, so its results do not have to be kept.
+		m_compiler->releaseContract(contract);
 	} // end of contracts iteration
 
 	if (!m_hasOutput)
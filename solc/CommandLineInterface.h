@@ -29,6 +29,7 @@
 #include <libsolidity/interface/FileReader.h>
 #include <libyul/AssemblyStack.h>
 
+#include <functional>
 #include <iostream>
 #include <memory>
 #include <string>
@@ -83,6 +84,8 @@ private:
 	void printLicense();
 	void compile();
 	void serveLSP();
+	/// Answers "compile" requests with Standard JSON inputs until the "exit" notification arrives.
+	void serveCompiler();
 	void link();
 	void writeLinkedFiles();
 	/// @returns the ``// <identifier> -> name`` hint for library placeholders.
@@ -95,7 +98,12 @@ private:
 	void outputCompilationResults();
 
 	void handleCombinedJSON();
+	/// Writes the combined JSON output to @a _stream contract by contract.
+	void writeCombinedJSON(std::ostream& _stream);
+	/// @returns the combined JSON output of the contract @a _contractName.
+	Json::Value combinedJSONContractData(std::string const& _contractName) const;
 	void handleAst();
+	void handleProfile();
 	void handleBinary(std::string const& _contract);
 	void handleOpcode(std::string const& _contract);
 	void handleIR(std::string const& _contract);
@@ -119,11 +127,15 @@ private:
 	/// @arg _fileName the name of the file
 	/// @arg _data to be written
 	void createFile(std::string const& _fileName, std::string const& _data);
+	/// Create a file in the given directory and write its content with @a _write
+	void createFile(std::string const& _fileName, std::function<void(std::ostream&)> const& _write);
 
 	/// Create a json file in the given directory
 	/// @arg _fileName the name of the file (the extension will be replaced with .json)
 	/// @arg _json json string to be written
 	void createJson(std::string const& _fileName, std::string const& _json);
+	/// Create a json file in the given directory and write its content with @a _write
+	void createJson(std::string const& _fileName, std::function<void(std::ostream&)> const& _write);
 
 	/// Returns the stream that should receive normal output. Sets m_hasOutput to true if the
 	/// stream has ever been used unless @arg _markAsUsed is set to false.
@@ -40,6 +40,8 @@ namespace solidity::frontend
 
 static string const g_strAllowPaths = "allow-paths";
 static string const g_strBasePath = "base-path";
+static string const g_strCacheDir = "cache-dir";
+static string const g_strProfile = "profile";
 static string const g_strIncludePath = "include-path";
 static string const g_strAssemble = "assemble";
 static string const g_strCombinedJson = "combined-json";
@@ -52,6 +54,7 @@ static string const g_strGas = "gas";
 static string const g_strHelp = "help";
 static string const g_strImportAst = "import-ast";
 static string const g_strInputFile = "input-file";
+static string const g_strJobs = "jobs";
 static string const g_strYul = "yul";
 static string const g_strYulDialect = "yul-dialect";
 static string const g_strDebugInfo = "debug-info";
@@ -66,17 +69,23 @@ static string const g_strMetadataLiteral = "metadata-literal";
 static string const g_strModelCheckerContracts = "model-checker-contracts";
 static string const g_strModelCheckerDivModNoSlacks = "model-checker-div-mod-no-slacks";
 static string const g_strModelCheckerEngine = "model-checker-engine";
+static string const g_strModelCheckerHideCounterexamples = "model-checker-hide-counterexamples";
 static string const g_strModelCheckerInvariants = "model-checker-invariants";
 static string const g_strModelCheckerShowUnproved = "model-checker-show-unproved";
+static string const g_strModelCheckerSMTLib2Command = "model-checker-smtlib2-command";
 static string const g_strModelCheckerSolvers = "model-checker-solvers";
 static string const g_strModelCheckerTargets = "model-checker-targets";
 static string const g_strModelCheckerTimeout = "model-checker-timeout";
+static string const g_strModelCheckerTotalTimeout = "model-checker-total-timeout";
 static string const g_strNone = "none";
 static string const g_strNoOptimizeYul = "no-optimize-yul";
 static string const g_strOptimize = "optimize";
+static string const g_strOptimizeAutotune = "optimize-autotune";
 static string const g_strOptimizeRuns = "optimize-runs";
+static string const g_strOptimizeSelectSteps = "optimize-select-steps";
 static string const g_strOptimizeYul = "optimize-yul";
 static string const g_strYulOptimizations = "yul-optimizations";
+static string const g_strYulOptimizerStepBudget = "yul-optimizer-step-budget";
 static string const g_strOutputDir = "output-dir";
 static string const g_strOverwrite = "overwrite";
 static string const g_strRevertStrings = "revert-strings";
@@ -92,6 +101,7 @@ static set<string> const g_revertStringsArgs
 	revertStringsToString(RevertStrings::VerboseDebug)
 };
 
+static string const g_strServer = "server";
 static string const g_strSources = "sources";
 static string const g_strSourceList = "sourceList";
 static string const g_strStandardJSON = "standard-json";
@@ -137,6 +147,7 @@ static map<InputMode, string> const g_inputModeName = {
 	{InputMode::StandardJson, "standard JSON"},
 	{InputMode::Linker, "linker"},
 	{InputMode::LanguageServer, "language server (LSP)"},
+	{InputMode::CompilerServer, "compiler server"},
 };
 
 void CommandLineParser::checkMutuallyExclusive(vector<string> const& _optionNames)
@@ -226,6 +237,9 @@ bool CommandLineOptions::operator==(CommandLineOptions const& _other) const noex
 		output.overwriteFiles == _other.output.overwriteFiles &&
 		output.evmVersion == _other.output.evmVersion &&
 		output.experimentalViaIR == _other.output.experimentalViaIR &&
+		output.jobs == _other.output.jobs &&
+		output.cacheDir == _other.output.cacheDir &&
+		output.profile == _other.output.profile &&
 		output.revertStrings == _other.output.revertStrings &&
 		output.debugInfoSelection == _other.output.debugInfoSelection &&
 		output.stopAfter == _other.output.stopAfter &&
@@ -245,6 +259,9 @@ bool CommandLineOptions::operator==(CommandLineOptions const& _other) const noex
 		optimizer.expectedExecutionsPerDeployment == _other.optimizer.expectedExecutionsPerDeployment &&
 		optimizer.noOptimizeYul == _other.optimizer.noOptimizeYul &&
 		optimizer.yulSteps == _other.optimizer.yulSteps &&
+		optimizer.yulStepBudget == _other.optimizer.yulStepBudget &&
+		optimizer.autotuneCandidates == _other.optimizer.autotuneCandidates &&
+		optimizer.selectSteps == _other.optimizer.selectSteps &&
 		modelChecker.initialize == _other.modelChecker.initialize &&
 		modelChecker.settings == _other.modelChecker.settings;
 }
@@ -267,6 +284,14 @@ OptimiserSettings CommandLineOptions::optimiserSettings() const
 	if (optimizer.yulSteps.has_value())
 		settings.yulOptimiserSteps = optimizer.yulSteps.value();
 
+	if (optimizer.yulStepBudget.has_value())
+		settings.yulOptimiserStepBudget = optimizer.yulStepBudget.value();
+
+	if (optimizer.autotuneCandidates.has_value())
+		settings.yulOptimiserAutotuneCandidates = optimizer.autotuneCandidates.value();
+
+	settings.selectYulOptimiserSteps = optimizer.selectSteps;
+
 	return settings;
 }
 
@@ -289,7 +314,7 @@ void CommandLineParser::parseInputPathsAndRemappings()
 				if (!remapping.has_value())
 					solThrow(CommandLineValidationError, "Invalid remapping: \"" + positionalArg + "\".");
 
-				if (m_options.input.mode == InputMode::StandardJson)
+				if (m_options.input.mode == InputMode::StandardJson || m_options.input.mode == InputMode::CompilerServer)
 					solThrow(
 						CommandLineValidationError,
 						"Import remappings are not accepted on the command line in Standard JSON mode.\n"
@@ -316,7 +341,16 @@ void CommandLineParser::parseInputPathsAndRemappings()
 				m_options.input.paths.insert(positionalArg);
 		}
 
-	if (m_options.input.mode == InputMode::StandardJson)
+	if (m_options.input.mode == InputMode::CompilerServer)
+	{
+		if (!m_options.input.paths.empty() || m_options.input.addStdin)
+			solThrow(
+				CommandLineValidationError,
+				"No input files are accepted for --" + g_strServer + ".\n"
+				"The sources are given in the Standard JSON input of each request."
+			);
+	}
+	else if (m_options.input.mode == InputMode::StandardJson)
 	{
 		if (m_options.input.paths.size() > 1 || (m_options.input.paths.size() == 1 && m_options.input.addStdin))
 			solThrow(
@@ -465,6 +499,7 @@ void CommandLineParser::parseOutputSelection()
 		case InputMode::Assembler:
 			return contains(assemblerModeOutputs, _outputName);
 		case InputMode::StandardJson:
+		case InputMode::CompilerServer:
 		case InputMode::Linker:
 			return false;
 		}
@@ -580,6 +615,29 @@ General Information)").c_str(),
 			g_strExperimentalViaIR.c_str(),
 			"Turn on experimental compilation mode via the IR (EXPERIMENTAL)."
 		)
+		(
+			g_strCacheDir.c_str(),
+			po::value<string>()->value_name("path"),
+			"Directory used to cache the IR of contracts between compiler runs. "
+			"Contracts whose metadata did not change since they were cached skip IR generation "
+			"and optimization when compiling via the IR. Contracts whose code only differs in "
+			"the embedded metadata reuse the optimized IR. "
+			"The answers of the SMT solvers to the queries of the BMC engine of the model checker "
+			"are cached there as well."
+		)
+		(
+			g_strProfile.c_str(),
+			"Measure the time and memory spent in the phases of the compilation and output "
+			"the measurements as JSON (written to profile.json if used together with -o)."
+		)
+		(
+			g_strJobs.c_str(),
+			po::value<unsigned>()->value_name("count"),
+			"Maximum number of threads used to parse and syntax check independent source files, to generate bytecode of independent contracts "
+			"and to optimize independent Yul objects when compiling via the IR, or to link independent files with --link. "
+			"Zero selects the number of available cores. "
+			"The output does not depend on this setting."
+		)
 		(
 			g_strRevertStrings.c_str(),
 			po::value<string>()->value_name(joinHumanReadable(g_revertStringsArgs, ",")),
@@ -632,7 +690,7 @@ General Information)").c_str(),
 		)
 		(
 			g_strImportAst.c_str(),
-			("Import ASTs to be compiled, assumes input holds the AST in compact JSON format. "
+			("Import ASTs to be compiled, assumes input holds the AST in compact JSON format or its CBOR encoding. "
 			"Supported Inputs is the output of the --" + g_strStandardJSON + " or the one produced by "
 			"--" + g_strCombinedJson + " " + CombinedJsonRequests::componentName(&CombinedJsonRequests::ast)).c_str()
 		)
@@ -641,6 +699,12 @@ General Information)").c_str(),
 			"Switch to language server mode (\"LSP\"). Allows the compiler to be used as an analysis backend "
 			"for your favourite IDE."
 		)
+		(
+			g_strServer.c_str(),
+			("Switch to compiler server mode. Reads Standard JSON inputs as \"compile\" requests in JSON-RPC messages "
+			"framed like in --" + g_strLSP + " mode from the standard input and replies with the Standard JSON outputs "
+			"until the \"exit\" notification arrives. Code generation artifacts are kept between the requests.").c_str()
+		)
 	;
 	desc.add(alternativeInputModes);
 
@@ -773,6 +837,27 @@ General Information)").c_str(),
 			po::value<string>()->value_name("steps"),
 			"Forces yul optimizer to use the specified sequence of optimization steps instead of the built-in one."
 		)
+		(
+			g_strYulOptimizerStepBudget.c_str(),
+			po::value<unsigned>()->value_name("n"),
+			"Stop the yul optimizer after running the given number of steps of the optimization sequence. "
+			"Trades the quality of the code for a shorter compilation time, e.g. for development builds."
+		)
+		(
+			g_strOptimizeAutotune.c_str(),
+			po::value<unsigned>()->value_name("n"),
+			"Run the yul optimizer with n different optimization sequences, starting with the "
+			"selected one, and keep the result with the lowest estimated deployment and runtime costs. "
+			"Trades compilation time for cheaper code."
+		)
+		(
+			g_strOptimizeSelectSteps.c_str(),
+			(
+				"Replace the default yul optimization sequence of each object by a built-in one suited "
+				"to its code, e.g. to code dominated by storage accesses or by arithmetic in loops. "
+				"Has no effect if --" + g_strYulOptimizations + " is given."
+			).c_str()
+		)
 	;
 	desc.add(optimizerOptions);
 
@@ -795,6 +880,10 @@ General Information)").c_str(),
 			po::value<string>()->value_name("all,bmc,chc,none")->default_value("none"),
 			"Select model checker engine."
 		)
+		(
+			g_strModelCheckerHideCounterexamples.c_str(),
+			"Report unsafe targets without a counterexample, which saves the time spent on computing it."
+		)
 		(
 			g_strModelCheckerInvariants.c_str(),
 			po::value<string>()->value_name("default,all,contract,reentrancy")->default_value("default"),
@@ -806,6 +895,15 @@ General Information)").c_str(),
 			g_strModelCheckerShowUnproved.c_str(),
 			"Show all unproved targets separately."
 		)
+		(
+			g_strModelCheckerSMTLib2Command.c_str(),
+			po::value<string>()->value_name("command"),
+			"Start an SMT solver with this command, e.g. \"z3 -in\", and keep it running to answer the "
+			"queries of the smtlib2 solver in the BMC engine. The solver has to read SMT-LIB2 from its "
+			"standard input and is only sent the commands that changed since its previous query. "
+			"The CHC engine starts the command for every query instead, on up to --jobs processes at a time, "
+			"so the command can also hand the queries to other machines."
+		)
 		(
 			g_strModelCheckerSolvers.c_str(),
 			po::value<string>()->value_name("all,cvc4,z3,smtlib2")->default_value("all"),
@@ -825,6 +923,13 @@ General Information)").c_str(),
 			"The default is a deterministic resource limit. "
 			"A timeout of 0 means no resource/time restrictions for any query."
 		)
+		(
+			g_strModelCheckerTotalTimeout.c_str(),
+			po::value<unsigned>()->value_name("ms"),
+			"Set a wall-clock budget in milliseconds for all model checker queries. "
+			"Each query gets an equal share of the time that is left, at most the timeout per query, "
+			"and the unproved targets of the CHC engine are tried again with the time that is left."
+		)
 	;
 	desc.add(smtCheckerOptions);
 
@@ -873,7 +978,8 @@ void CommandLineParser::processArgs()
 		g_strStrictAssembly,
 		g_strYul,
 		g_strImportAst,
-		g_strLSP
+		g_strLSP,
+		g_strServer
 	});
 
 	if (m_args.count(g_strHelp) > 0)
@@ -886,6 +992,8 @@ void CommandLineParser::processArgs()
 		m_options.input.mode = InputMode::StandardJson;
 	else if (m_args.count(g_strLSP))
 		m_options.input.mode = InputMode::LanguageServer;
+	else if (m_args.count(g_strServer))
+		m_options.input.mode = InputMode::CompilerServer;
 	else if (m_args.count(g_strAssemble) > 0 || m_args.count(g_strStrictAssembly) > 0 || m_args.count(g_strYul) > 0)
 		m_options.input.mode = InputMode::Assembler;
 	else if (m_args.count(g_strLink) > 0)
@@ -906,6 +1014,9 @@ void CommandLineParser::processArgs()
 		// TODO: This should eventually contain all options.
 		{g_strErrorRecovery, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strExperimentalViaIR, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strJobs, {InputMode::Compiler, InputMode::CompilerWithASTImport, InputMode::Linker}},
+		{g_strCacheDir, {InputMode::Compiler, InputMode::CompilerWithASTImport, InputMode::CompilerServer}},
+		{g_strProfile, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 	};
 	vector<string> invalidOptionsForCurrentInputMode;
 	for (auto const& [optionName, inputModes]: validOptionInputModeCombinations)
@@ -953,7 +1064,7 @@ void CommandLineParser::processArgs()
 				"Option --" + g_strOptimizeRuns + " is only valid in compiler and assembler modes."
 			);
 
-		for (string const& option: {g_strOptimize, g_strNoOptimizeYul, g_strOptimizeYul, g_strYulOptimizations})
+		for (string const& option: {g_strOptimize, g_strNoOptimizeYul, g_strOptimizeYul, g_strYulOptimizations, g_strYulOptimizerStepBudget, g_strOptimizeAutotune, g_strOptimizeSelectSteps})
 			if (m_args.count(option) > 0)
 				solThrow(
 					CommandLineValidationError,
@@ -1058,7 +1169,14 @@ void CommandLineParser::processArgs()
 
 	parseInputPathsAndRemappings();
 
-	if (m_options.input.mode == InputMode::StandardJson)
+	if (m_args.count(g_strCacheDir))
+	{
+		m_options.output.cacheDir = m_args[g_strCacheDir].as<string>();
+		if (m_options.output.cacheDir.empty())
+			solThrow(CommandLineValidationError, "Empty values are not allowed in --" + g_strCacheDir + ".");
+	}
+
+	if (m_options.input.mode == InputMode::StandardJson || m_options.input.mode == InputMode::CompilerServer)
 		return;
 
 	if (m_args.count(g_strLibraries))
@@ -1066,7 +1184,11 @@ void CommandLineParser::processArgs()
 			parseLibraryOption(library);
 
 	if (m_options.input.mode == InputMode::Linker)
+	{
+		if (m_args.count(g_strJobs))
+			m_options.output.jobs = m_args[g_strJobs].as<unsigned>();
 		return;
+	}
 
 	if (m_args.count(g_strEVMVersion))
 	{
@@ -1103,6 +1225,27 @@ void CommandLineParser::processArgs()
 		m_options.optimizer.yulSteps = m_args[g_strYulOptimizations].as<string>();
 	}
 
+	if (m_args.count(g_strYulOptimizerStepBudget))
+	{
+		if (!m_options.optimiserSettings().runYulOptimiser)
+			solThrow(CommandLineValidationError, "--" + g_strYulOptimizerStepBudget + " is invalid if Yul optimizer is disabled");
+		m_options.optimizer.yulStepBudget = m_args[g_strYulOptimizerStepBudget].as<unsigned>();
+	}
+
+	if (m_args.count(g_strOptimizeAutotune))
+	{
+		if (!m_options.optimiserSettings().runYulOptimiser)
+			solThrow(CommandLineValidationError, "--" + g_strOptimizeAutotune + " is invalid if Yul optimizer is disabled");
+		m_options.optimizer.autotuneCandidates = m_args[g_strOptimizeAutotune].as<unsigned>();
+	}
+
+	if (m_args.count(g_strOptimizeSelectSteps))
+	{
+		if (!m_options.optimiserSettings().runYulOptimiser)
+			solThrow(CommandLineValidationError, "--" + g_strOptimizeSelectSteps + " is invalid if Yul optimizer is disabled");
+		m_options.optimizer.selectSteps = true;
+	}
+
 	if (m_options.input.mode == InputMode::Assembler)
 	{
 		vector<string> const nonAssemblyModeOptions = {
@@ -1213,6 +1356,9 @@ void CommandLineParser::processArgs()
 		m_options.modelChecker.settings.engine = *engine;
 	}
 
+	if (m_args.count(g_strModelCheckerHideCounterexamples))
+		m_options.modelChecker.settings.showCounterexamples = false;
+
 	if (m_args.count(g_strModelCheckerInvariants))
 	{
 		string invsStr = m_args[g_strModelCheckerInvariants].as<string>();
@@ -1225,6 +1371,14 @@ void CommandLineParser::processArgs()
 	if (m_args.count(g_strModelCheckerShowUnproved))
 		m_options.modelChecker.settings.showUnproved = true;
 
+	if (m_args.count(g_strModelCheckerSMTLib2Command))
+	{
+		string command = m_args[g_strModelCheckerSMTLib2Command].as<string>();
+		if (command.find_first_not_of(" \t") == string::npos)
+			solThrow(CommandLineValidationError, "Empty command for --" + g_strModelCheckerSMTLib2Command + ".");
+		m_options.modelChecker.settings.smtlib2Command = command;
+	}
+
 	if (m_args.count(g_strModelCheckerSolvers))
 	{
 		string solversStr = m_args[g_strModelCheckerSolvers].as<string>();
@@ -1246,17 +1400,26 @@ void CommandLineParser::processArgs()
 	if (m_args.count(g_strModelCheckerTimeout))
 		m_options.modelChecker.settings.timeout = m_args[g_strModelCheckerTimeout].as<unsigned>();
 
+	if (m_args.count(g_strModelCheckerTotalTimeout))
+		m_options.modelChecker.settings.totalTimeout = m_args[g_strModelCheckerTotalTimeout].as<unsigned>();
+
 	m_options.metadata.literalSources = (m_args.count(g_strMetadataLiteral) > 0);
 	m_options.modelChecker.initialize =
 		m_args.count(g_strModelCheckerContracts) ||
 		m_args.count(g_strModelCheckerDivModNoSlacks) ||
 		m_args.count(g_strModelCheckerEngine) ||
+		m_args.count(g_strModelCheckerHideCounterexamples) ||
 		m_args.count(g_strModelCheckerInvariants) ||
 		m_args.count(g_strModelCheckerShowUnproved) ||
+		m_args.count(g_strModelCheckerSMTLib2Command) ||
 		m_args.count(g_strModelCheckerSolvers) ||
 		m_args.count(g_strModelCheckerTargets) ||
-		m_args.count(g_strModelCheckerTimeout);
+		m_args.count(g_strModelCheckerTimeout) ||
+		m_args.count(g_strModelCheckerTotalTimeout);
 	m_options.output.experimentalViaIR = (m_args.count(g_strExperimentalViaIR) > 0);
+	if (m_args.count(g_strJobs))
+		m_options.output.jobs = m_args[g_strJobs].as<unsigned>();
+	m_options.output.profile = (m_args.count(g_strProfile) > 0);
 	if (m_options.input.mode == InputMode::Compiler)
 		m_options.input.errorRecovery = (m_args.count(g_strErrorRecovery) > 0);
 
@@ -56,7 +56,8 @@ enum class InputMode
 	StandardJson,
 	Linker,
 	Assembler,
-	LanguageServer
+	LanguageServer,
+	CompilerServer
 };
 
 struct CompilerOutputs
@@ -183,6 +184,11 @@ struct CommandLineOptions
 		bool overwriteFiles = false;
 		langutil::EVMVersion evmVersion;
 		bool experimentalViaIR = false;
+		/// Maximum number of threads used for bytecode generation. Zero means one per available core.
+		unsigned jobs = 1;
+		boost::filesystem::path cacheDir;
+		/// Output timing and memory measurements of the compilation phases.
+		bool profile = false;
 		RevertStrings revertStrings = RevertStrings::Default;
 		std::optional<langutil::DebugInfoSelection> debugInfoSelection;
 		CompilerStack::State stopAfter = CompilerStack::State::CompilationSuccessful;
@@ -225,6 +231,9 @@ struct CommandLineOptions
 		std::optional<unsigned> expectedExecutionsPerDeployment;
 		bool noOptimizeYul = false;
 		std::optional<std::string> yulSteps;
+		std::optional<unsigned> yulStepBudget;
+		std::optional<unsigned> autotuneCandidates;
+		bool selectSteps = false;
 	} optimizer;
 
 	struct
@@ -21,6 +21,8 @@
 #include <test/Common.h>
 #include <test/EVMHost.h>
 
+#include <libyul/optimiser/Suite.h>
+
 #include <libsolutil/Assertions.h>
 #include <boost/algorithm/string.hpp>
 #include <boost/filesystem.hpp>
@@ -107,6 +109,17 @@ void CommonOptions::addOptions()
 		("no-semantic-tests", po::bool_switch(&disableSemanticTests)->default_value(disableSemanticTests), "disable semantic tests")
 		("no-smt", po::bool_switch(&disableSMT)->default_value(disableSMT), "disable SMT checker")
 		("optimize", po::bool_switch(&optimize)->default_value(optimize), "enables optimization")
+		(
+			"optimizer-runs",
+			po::value<size_t>()->notifier([this](size_t _runs) { optimizerRuns = _runs; }),
+			"sets the number of runs the optimizer expects for each deployed contract"
+		)
+		("yul-optimizer-steps", po::value<std::string>(&yulOptimizerSteps), "sets the Yul optimizer sequence to use")
+		(
+			"gas-report",
+			po::value<fs::path>(&gasReport),
+			"appends the gas used by the transactions of semantic tests to this file, one JSON object per line"
+		)
 		("enforce-via-yul", po::value<bool>(&enforceViaYul)->default_value(enforceViaYul)->implicit_value(true), "Enforce compiling all tests via yul to see if additional tests can be activated.")
 		("enforce-compile-to-ewasm", po::bool_switch(&enforceCompileToEwasm)->default_value(enforceCompileToEwasm), "Enforce compiling all tests to Ewasm to see if additional tests can be activated.")
 		("enforce-gas-cost", po::value<bool>(&enforceGasTest)->default_value(enforceGasTest)->implicit_value(true), "Enforce checking gas cost in semantic tests.")
@@ -139,6 +152,20 @@ void CommonOptions::validate() const
 		"Selected batch has to be less than number of batches."
 	);
 
+	if (!yulOptimizerSteps.empty())
+	{
+		try
+		{
+			yul::OptimiserSuite::validateSequence(yulOptimizerSteps);
+		}
+		catch (yul::OptimizerException const& _exception)
+		{
+			BOOST_THROW_EXCEPTION(ConfigException() << util::errinfo_comment(
+				std::string("Invalid Yul optimizer sequence: ") + _exception.what()
+			));
+		}
+	}
+
 	if (enforceGasTest)
 	{
 		assertThrow(
@@ -27,6 +27,9 @@
 #include <boost/filesystem/path.hpp>
 #include <boost/program_options.hpp>
 
+#include <optional>
+#include <string>
+
 namespace solidity::test
 {
 
@@ -59,6 +62,13 @@ struct CommonOptions
 	boost::filesystem::path testPath;
 	bool ewasm = false;
 	bool optimize = false;
+	/// If set, overrides the number of runs the optimiser expects for each deployed contract.
+	std::optional<size_t> optimizerRuns;
+	/// If non-empty, the Yul optimiser sequence to use instead of the default one.
+	std::string yulOptimizerSteps;
+	/// If non-empty, semantic tests append the gas used by their transactions to this file,
+	/// one JSON object per line.
+	boost::filesystem::path gasReport;
 	bool enforceViaYul = false;
 	bool enforceCompileToEwasm = false;
 	bool enforceGasTest = false;
@@ -61,6 +61,10 @@ ExecutionFramework::ExecutionFramework(langutil::EVMVersion _evmVersion, vector<
 {
 	if (solidity::test::CommonOptions::get().optimize)
 		m_optimiserSettings = solidity::frontend::OptimiserSettings::standard();
+	if (auto runs = solidity::test::CommonOptions::get().optimizerRuns)
+		m_optimiserSettings.expectedExecutionsPerDeployment = *runs;
+	if (!solidity::test::CommonOptions::get().yulOptimizerSteps.empty())
+		m_optimiserSettings.yulOptimiserSteps = solidity::test::CommonOptions::get().yulOptimizerSteps;
 
 	for (auto const& path: m_vmPaths)
 		if (EVMHost::getVM(path.string()).has_capability(EVMC_CAPABILITY_EWASM))
@@ -0,0 +1,7 @@
+// SPDX-License-Identifier: GPL-3.0
+pragma solidity >=0.0;
+contract test {
+    function f(uint x) public pure {
+		assert(x > 0);
+    }
+}
\ No newline at end of file
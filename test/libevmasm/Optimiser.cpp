@@ -29,6 +29,10 @@
 #include <libevmasm/JumpdestRemover.h>
 #include <libevmasm/ControlFlowGraph.h>
 #include <libevmasm/BlockDeduplicator.h>
+#include <libevmasm/BlockLayout.h>
+#include <libevmasm/ExecutionProfile.h>
+#include <libevmasm/FunctionInliner.h>
+#include <libevmasm/Superoptimiser.h>
 #include <libevmasm/Assembly.h>
 
 #include <boost/test/unit_test.hpp>
@@ -881,6 +885,50 @@ BOOST_AUTO_TEST_CASE(block_deduplicator)
 	BOOST_CHECK_EQUAL(pushTags.size(), 2);
 }
 
+BOOST_AUTO_TEST_CASE(block_deduplicator_repeated)
+{
+	// Blocks 3 and 4 only become equal once blocks 1 and 2 are unified.
+	AssemblyItems input{
+		AssemblyItem(PushTag, 3),
+		AssemblyItem(PushTag, 4),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 1),
+		u256(1),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 2),
+		u256(1),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 3),
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 4),
+		AssemblyItem(PushTag, 2),
+		Instruction::JUMP
+	};
+	AssemblyItems output{
+		AssemblyItem(PushTag, 3),
+		AssemblyItem(PushTag, 3),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 1),
+		u256(1),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 2),
+		u256(1),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 3),
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 4),
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMP
+	};
+	BlockDeduplicator deduplicator(input);
+	BOOST_CHECK(deduplicator.deduplicate());
+	BOOST_CHECK_EQUAL_COLLECTIONS(input.begin(), input.end(), output.begin(), output.end());
+	map<u256, u256> expectedReplacements{{2, 1}, {4, 3}};
+	BOOST_CHECK(deduplicator.replacedTags() == expectedReplacements);
+}
+
 BOOST_AUTO_TEST_CASE(block_deduplicator_assign_immutable_same)
 {
 	AssemblyItems blocks{
@@ -1310,6 +1358,79 @@ BOOST_AUTO_TEST_CASE(jumpdest_removal_subassemblies)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(jumpdest_removal_subassemblies_parallel)
+{
+	// Same as above, but with several subassemblies that are optimised in parallel.
+	Assembly main;
+	vector<AssemblyPointer> subs;
+	vector<AssemblyItem> t1s;
+	vector<AssemblyItem> t4s;
+	for (size_t i = 0; i < 3; ++i)
+	{
+		AssemblyPointer sub = make_shared<Assembly>();
+		sub->append(u256(1));
+		auto t1 = sub->newTag();
+		sub->append(t1);
+		sub->append(u256(2));
+		sub->append(Instruction::JUMP);
+		auto t2 = sub->newTag();
+		sub->append(t2); // Identical to T1, will be unified
+		sub->append(u256(2));
+		sub->append(Instruction::JUMP);
+		auto t3 = sub->newTag();
+		sub->append(t3);
+		auto t4 = sub->newTag();
+		sub->append(t4);
+		auto t5 = sub->newTag();
+		sub->append(t5); // This will be removed
+		sub->append(u256(7 + i));
+		sub->append(t4.pushTag());
+		sub->append(Instruction::JUMP);
+
+		size_t subId = static_cast<size_t>(main.appendSubroutine(sub).data());
+		BOOST_REQUIRE_EQUAL(subId, i);
+		main.append(t1.toSubAssemblyTag(subId));
+		subs.push_back(sub);
+		t1s.push_back(t1);
+		t4s.push_back(t4);
+	}
+
+	Assembly::OptimiserSettings settings;
+	settings.isCreation = false;
+	settings.runInliner = false;
+	settings.runJumpdestRemover = true;
+	settings.runPeephole = true;
+	settings.runDeduplicate = true;
+	settings.runCSE = true;
+	settings.runConstantOptimiser = true;
+	settings.evmVersion = solidity::test::CommonOptions::get().evmVersion();
+	settings.expectedExecutionsPerDeployment = OptimiserSettings{}.expectedExecutionsPerDeployment;
+	settings.parallelism = 4;
+	main.optimise(settings);
+
+	AssemblyItems expectationMain;
+	for (size_t subId = 0; subId < subs.size(); ++subId)
+	{
+		expectationMain.emplace_back(PushSubSize, subId);
+		expectationMain.emplace_back(t1s[subId].toSubAssemblyTag(subId).pushTag());
+	}
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		main.items().begin(), main.items().end(),
+		expectationMain.begin(), expectationMain.end()
+	);
+
+	for (size_t i = 0; i < subs.size(); ++i)
+	{
+		AssemblyItems expectationSub{
+			u256(1), t1s[i].tag(), u256(2), Instruction::JUMP, t4s[i].tag(), u256(7 + i), t4s[i].pushTag(), Instruction::JUMP
+		};
+		BOOST_CHECK_EQUAL_COLLECTIONS(
+			subs[i]->items().begin(), subs[i]->items().end(),
+			expectationSub.begin(), expectationSub.end()
+		);
+	}
+}
+
 BOOST_AUTO_TEST_CASE(cse_sub_zero)
 {
 	checkCSE({
@@ -1917,6 +2038,195 @@ BOOST_AUTO_TEST_CASE(inliner_invalid)
 }
 
 
+BOOST_AUTO_TEST_CASE(superoptimiser_stack_shuffles)
+{
+	using Window = vector<Instruction>;
+	auto shorter = Superoptimiser::cheaperStackShuffle({Instruction::DUP2, Instruction::SWAP1, Instruction::POP});
+	BOOST_REQUIRE(shorter);
+	BOOST_CHECK(*shorter == (Window{Instruction::POP, Instruction::DUP1}));
+	shorter = Superoptimiser::cheaperStackShuffle({Instruction::SWAP1, Instruction::POP, Instruction::POP});
+	BOOST_REQUIRE(shorter);
+	BOOST_CHECK(*shorter == (Window{Instruction::POP, Instruction::POP}));
+	// Already optimal.
+	BOOST_CHECK(!Superoptimiser::cheaperStackShuffle({Instruction::SWAP1, Instruction::SWAP2, Instruction::SWAP1}));
+
+	AssemblyItems items{
+		u256(1),
+		u256(2),
+		Instruction::DUP2,
+		Instruction::SWAP1,
+		Instruction::POP,
+		Instruction::ADD
+	};
+	AssemblyItems expectation{
+		u256(1),
+		u256(2),
+		Instruction::POP,
+		Instruction::DUP1,
+		Instruction::ADD
+	};
+	BOOST_REQUIRE(Superoptimiser(items).optimise());
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		items.begin(), items.end(),
+		expectation.begin(), expectation.end()
+	);
+	BOOST_CHECK(!Superoptimiser(items).optimise());
+}
+
+BOOST_AUTO_TEST_CASE(execution_profile_innermost_range)
+{
+	ExecutionProfile profile;
+	profile.add("a.sol", 0, 100, 1);
+	profile.add("a.sol", 10, 50, 1000);
+	profile.add("a.sol", 20, 30, 7);
+	auto source = make_shared<string const>("a.sol");
+	auto other = make_shared<string const>("b.sol");
+	BOOST_CHECK(profile.executions(SourceLocation{5, 8, source}) == size_t{1});
+	BOOST_CHECK(profile.executions(SourceLocation{10, 50, source}) == size_t{1000});
+	BOOST_CHECK(profile.executions(SourceLocation{31, 40, source}) == size_t{1000});
+	BOOST_CHECK(profile.executions(SourceLocation{22, 25, source}) == size_t{7});
+	BOOST_CHECK(profile.executions(SourceLocation{25, 60, source}) == size_t{1});
+	BOOST_CHECK(!profile.executions(SourceLocation{90, 110, source}));
+	BOOST_CHECK(!profile.executions(SourceLocation{22, 25, other}));
+	BOOST_CHECK(!profile.executions(SourceLocation{}));
+}
+
+BOOST_AUTO_TEST_CASE(block_layout_moves_reverting_code)
+{
+	Assembly assembly;
+	auto after = assembly.newTag();
+	assembly.append(Instruction::CALLVALUE);
+	assembly.append(Instruction::ISZERO);
+	assembly.append(after.pushTag());
+	assembly.append(Instruction::JUMPI);
+	assembly.append(u256(0));
+	assembly.append(Instruction::DUP1);
+	assembly.append(Instruction::REVERT);
+	assembly.append(after);
+	assembly.append(u256(1));
+	assembly.append(u256(0));
+	assembly.append(Instruction::SSTORE);
+	AssemblyItems const withoutStop = assembly.items();
+	assembly.append(Instruction::STOP);
+
+	BOOST_REQUIRE(BlockLayout(assembly).optimise());
+	// The tag for the moved code is the next one allocated.
+	AssemblyItem cold(Tag, after.data() + 1);
+	AssemblyItems expectation{
+		Instruction::CALLVALUE,
+		cold.pushTag(),
+		Instruction::JUMPI,
+		after,
+		u256(1),
+		u256(0),
+		Instruction::SSTORE,
+		Instruction::STOP,
+		cold,
+		u256(0),
+		Instruction::DUP1,
+		Instruction::REVERT
+	};
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		assembly.items().begin(), assembly.items().end(),
+		expectation.begin(), expectation.end()
+	);
+	BOOST_CHECK(!BlockLayout(assembly).optimise());
+
+	// The moved code would be reached by falling off the end.
+	assembly.items() = withoutStop;
+	BOOST_CHECK(!BlockLayout(assembly).optimise());
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		assembly.items().begin(), assembly.items().end(),
+		withoutStop.begin(), withoutStop.end()
+	);
+}
+
+BOOST_AUTO_TEST_CASE(function_inliner_single_call_site)
+{
+	AssemblyItem jumpIntoFunction(Instruction::JUMP);
+	jumpIntoFunction.setJumpType(AssemblyItem::JumpType::IntoFunction);
+	AssemblyItem jumpOutOfFunction(Instruction::JUMP);
+	jumpOutOfFunction.setJumpType(AssemblyItem::JumpType::OutOfFunction);
+	AssemblyItems items{
+		AssemblyItem(PushTag, 1),
+		u256(7),
+		AssemblyItem(PushTag, 2),
+		jumpIntoFunction,
+		AssemblyItem(Tag, 1),
+		Instruction::STOP,
+		AssemblyItem(Tag, 2),
+		u256(1),
+		Instruction::ADD,
+		AssemblyItem(Tag, 3),
+		Instruction::DUP1,
+		AssemblyItem(PushTag, 3),
+		Instruction::JUMPI,
+		Instruction::SWAP1,
+		jumpOutOfFunction
+	};
+	AssemblyItems const original = items;
+	AssemblyItems expectation{
+		AssemblyItem(PushTag, 1),
+		u256(7),
+		u256(1),
+		Instruction::ADD,
+		AssemblyItem(Tag, 3),
+		Instruction::DUP1,
+		AssemblyItem(PushTag, 3),
+		Instruction::JUMPI,
+		Instruction::SWAP1,
+		jumpOutOfFunction,
+		AssemblyItem(Tag, 1),
+		Instruction::STOP
+	};
+	BOOST_REQUIRE(FunctionInliner(items, {}).optimise());
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		items.begin(), items.end(),
+		expectation.begin(), expectation.end()
+	);
+	BOOST_CHECK(!FunctionInliner(items, {}).optimise());
+
+	// The function is also called from another assembly.
+	items = original;
+	BOOST_CHECK(!FunctionInliner(items, {2}).optimise());
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		items.begin(), items.end(),
+		original.begin(), original.end()
+	);
+}
+
+BOOST_AUTO_TEST_CASE(function_inliner_unreachable_loop)
+{
+	AssemblyItems items{
+		u256(1),
+		Instruction::STOP,
+		AssemblyItem(Tag, 4),
+		Instruction::DUP1,
+		AssemblyItem(PushTag, 5),
+		Instruction::JUMPI,
+		AssemblyItem(Tag, 5),
+		AssemblyItem(PushTag, 4),
+		Instruction::JUMP
+	};
+	AssemblyItems const original = items;
+	BOOST_CHECK(!FunctionInliner(items, {4}).optimise());
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		items.begin(), items.end(),
+		original.begin(), original.end()
+	);
+
+	// Both tags are only pushed by the unreachable code itself.
+	AssemblyItems expectation{
+		u256(1),
+		Instruction::STOP
+	};
+	BOOST_REQUIRE(FunctionInliner(items, {}).optimise());
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		items.begin(), items.end(),
+		expectation.begin(), expectation.end()
+	);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
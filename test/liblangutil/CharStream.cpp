@@ -129,6 +129,40 @@ BOOST_AUTO_TEST_CASE(translateLineColumnToPosition)
 	BOOST_CHECK_EQUAL(toPosition(2, 0, "ABC\nDEF\nGHI\n"), 8);
 	BOOST_CHECK_EQUAL(toPosition(2, 1, "ABC\nDEF\nGHI\n"), 9);
 	BOOST_CHECK_EQUAL(toPosition(2, 2, "ABC\nDEF\nGHI\n"), 10);
+
+	// Negative columns are rejected on every line.
+	BOOST_CHECK_EQUAL(toPosition(1, -1, "ABC\nDEF"), nullopt);
+}
+
+BOOST_AUTO_TEST_CASE(translatePositionToLineColumn)
+{
+	CharStream const stream{"ABC\nDE\n\nF", "source"};
+	auto const check = [&](int _position, int _line, int _column)
+	{
+		LineColumn const lineColumn = stream.translatePositionToLineColumn(_position);
+		BOOST_CHECK_EQUAL(lineColumn.line, _line);
+		BOOST_CHECK_EQUAL(lineColumn.column, _column);
+		if (_position <= static_cast<int>(stream.size()))
+			BOOST_CHECK_EQUAL(stream.translateLineColumnToPosition(lineColumn), _position);
+	};
+
+	check(0, 0, 0);
+	check(2, 0, 2);
+	check(3, 0, 3);
+	check(4, 1, 0);
+	check(6, 1, 2);
+	check(7, 2, 0);
+	check(8, 3, 0);
+	check(9, 3, 1);
+	// Positions past the end are clamped to the end.
+	check(100, 3, 1);
+
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(0), "ABC");
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(3), "ABC");
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(5), "DE");
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(7), "");
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(8), "F");
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(9), "F");
 }
 
 BOOST_AUTO_TEST_SUITE_END()
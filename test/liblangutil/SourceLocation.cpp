@@ -46,6 +46,18 @@ BOOST_AUTO_TEST_CASE(test_fail)
 	BOOST_CHECK((SourceLocation{3, 7, sourceA} < SourceLocation{4, 6, sourceB}));
 }
 
+BOOST_AUTO_TEST_CASE(interned_source_names)
+{
+	SourceLocation const location{0, 3, std::make_shared<std::string>("source")};
+	SourceLocation const sameName{0, 3, SourceName{std::string("source")}};
+
+	BOOST_CHECK(location == sameName);
+	BOOST_CHECK_EQUAL(location.sourceName.get(), sameName.sourceName.get());
+	BOOST_CHECK_EQUAL(*location.sourceName, "source");
+	BOOST_CHECK(SourceName{std::string("other")} != location.sourceName);
+	BOOST_CHECK(!SourceLocation{}.sourceName);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
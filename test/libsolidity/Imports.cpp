@@ -30,7 +30,9 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <map>
 #include <string>
+#include <vector>
 
 using namespace std;
 
@@ -113,6 +115,144 @@ BOOST_AUTO_TEST_CASE(context_dependent_remappings_order_independent_2)
 	BOOST_CHECK(c.compile());
 }
 
+BOOST_AUTO_TEST_CASE(remapping_precedence)
+{
+	ImportRemapper remapper;
+	remapper.setRemappings({
+		{"", "x", "short"},
+		{"", "x/y", "long"},
+		{"a", "x", "context"},
+		{"", "x/y", "later"},
+		{"a/b/", "z", "other"}
+	});
+	BOOST_CHECK_EQUAL(remapper.apply("x/y/f.sol", ""), "later/f.sol");
+	BOOST_CHECK_EQUAL(remapper.apply("x/f.sol", "c/main.sol"), "short/f.sol");
+	BOOST_CHECK_EQUAL(remapper.apply("x/y/f.sol", "a/main.sol"), "context/y/f.sol");
+	BOOST_CHECK_EQUAL(remapper.apply("x/y/f.sol", "a/b/main.sol"), "context/y/f.sol");
+	BOOST_CHECK_EQUAL(remapper.apply("z/f.sol", "a/b/main.sol"), "other/f.sol");
+	BOOST_CHECK_EQUAL(remapper.apply("z/f.sol", "a/main.sol"), "z/f.sol");
+	BOOST_CHECK_EQUAL(remapper.apply("y/f.sol", "a/main.sol"), "y/f.sol");
+}
+
+BOOST_AUTO_TEST_CASE(batch_read_callback)
+{
+	map<string, string> const files = {
+		{"x.sol", "pragma solidity >=0.0; import \"z.sol\"; contract X {}"},
+		{"y.sol", "pragma solidity >=0.0; import \"w.sol\"; import \"missing.sol\"; contract Y {}"},
+		{"z.sol", "pragma solidity >=0.0; contract Z {}"},
+		{"w.sol", "pragma solidity >=0.0; contract W {}"}
+	};
+
+	for (size_t parallelism: {1u, 2u})
+	{
+		vector<vector<string>> batches;
+		CompilerStack c;
+		c.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+		c.setParallelism(parallelism);
+		c.setBatchReadCallback([&](string const&, vector<string> const& _paths) {
+			batches.push_back(_paths);
+			vector<ReadCallback::Result> results;
+			for (string const& path: _paths)
+				if (files.count(path))
+					results.push_back({true, files.at(path)});
+				else
+					results.push_back({false, "Not found."});
+			return results;
+		});
+		c.setSources({{"main.sol", "pragma solidity >=0.0; import \"x.sol\"; import \"y.sol\"; contract M {}"}});
+		BOOST_CHECK(!c.parse());
+		BOOST_CHECK_EQUAL(c.sourceNames().size(), 5u);
+
+		// Parsed one after the other, each source is a batch of its own.
+		vector<vector<string>> const expectedBatches = parallelism == 1 ?
+			vector<vector<string>>{{"x.sol", "y.sol"}, {"z.sol"}, {"w.sol", "missing.sol"}} :
+			vector<vector<string>>{{"x.sol", "y.sol"}, {"z.sol", "w.sol", "missing.sol"}};
+		BOOST_CHECK(batches == expectedBatches);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(incremental_update_reuses_unchanged_sources)
+{
+	string const lib = "pragma solidity >=0.0; contract L { function f() public pure returns (uint) { uint x = 1; return x; } }";
+	string const a = "pragma solidity >=0.0; import \"lib.sol\"; contract A is L {}";
+	string const b = "pragma solidity >=0.0; contract B { function g() public { uint unused; } }";
+
+	CompilerStack c;
+	c.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	c.setSources({{"lib.sol", lib}, {"a.sol", a}, {"b.sol", b}});
+	BOOST_REQUIRE(c.compile());
+	SourceUnit const* libAST = &c.ast("lib.sol");
+	SourceUnit const* aAST = &c.ast("a.sol");
+	SourceUnit const* bAST = &c.ast("b.sol");
+	size_t const diagnostics = c.errors().size();
+
+	c.updateSources({
+		{"lib.sol", lib},
+		{"a.sol", "pragma solidity >=0.0; import \"lib.sol\"; contract A is L { uint y; }"},
+		{"b.sol", b}
+	});
+	BOOST_REQUIRE(c.compile());
+	BOOST_CHECK(&c.ast("lib.sol") == libAST);
+	BOOST_CHECK(&c.ast("a.sol") != aAST);
+	BOOST_CHECK(&c.ast("b.sol") == bAST);
+	// The warnings about b.sol are neither lost nor duplicated.
+	BOOST_CHECK_EQUAL(c.errors().size(), diagnostics);
+	BOOST_CHECK(!c.object("a.sol:A").bytecode.empty());
+
+	aAST = &c.ast("a.sol");
+	c.updateSources({
+		{"lib.sol", "pragma solidity >=0.0; contract L { function f() public pure returns (uint) { return 2; } }"},
+		{"a.sol", "pragma solidity >=0.0; import \"lib.sol\"; contract A is L { uint y; }"},
+		{"b.sol", b}
+	});
+	BOOST_REQUIRE(c.compile());
+	BOOST_CHECK(&c.ast("lib.sol") != libAST);
+	// Importers of changed sources are analysed again.
+	BOOST_CHECK(&c.ast("a.sol") != aAST);
+	BOOST_CHECK(&c.ast("b.sol") == bAST);
+}
+
+BOOST_AUTO_TEST_CASE(incremental_update_releases_replaced_asts)
+{
+	string const b = "pragma solidity >=0.0; contract B {}";
+
+	CompilerStack c;
+	c.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	c.setSources({{"a.sol", "pragma solidity >=0.0; contract A {}"}, {"b.sol", b}});
+	BOOST_REQUIRE(c.compile());
+
+	// Every update replaces the AST of a.sol. After enough of them, everything is analysed
+	// again, which releases the replaced ASTs and their types.
+	bool reanalysedAll = false;
+	for (size_t i = 0; i < 100 && !reanalysedAll; ++i)
+	{
+		c.updateSources({
+			{"a.sol", "pragma solidity >=0.0; contract A { uint x" + to_string(i) + "; }"},
+			{"b.sol", b}
+		});
+		BOOST_REQUIRE(c.compile());
+		reanalysedAll = !c.isReusedSource("b.sol");
+		if (i == 0)
+			BOOST_CHECK(!reanalysedAll);
+	}
+	BOOST_CHECK(reanalysedAll);
+}
+
+BOOST_AUTO_TEST_CASE(incremental_update_after_error)
+{
+	string const lib = "pragma solidity >=0.0; contract L {}";
+
+	CompilerStack c;
+	c.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	c.setSources({{"lib.sol", lib}, {"a.sol", "pragma solidity >=0.0; import \"lib.sol\"; contract A is X {}"}});
+	BOOST_CHECK(!c.compile());
+
+	// Nothing is reused after a failed analysis, but the stack is usable again.
+	c.updateSources({{"lib.sol", lib}, {"a.sol", "pragma solidity >=0.0; import \"lib.sol\"; contract A is L {}"}});
+	BOOST_REQUIRE(c.compile());
+	BOOST_CHECK(!langutil::Error::containsErrors(c.errors()));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
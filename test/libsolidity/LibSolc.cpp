@@ -21,6 +21,7 @@
  */
 
 #include <string>
+#include <vector>
 #include <boost/test/unit_test.hpp>
 #include <libsolutil/JSON.h>
 #include <libsolidity/interface/ReadFile.h>
@@ -111,6 +112,41 @@ BOOST_AUTO_TEST_CASE(standard_compilation)
 	BOOST_CHECK(!result.isMember("contracts"));
 }
 
+BOOST_AUTO_TEST_CASE(batch_compilation)
+{
+	vector<string> inputs = {
+		R"({"language": "Solidity", "sources": {"fileA": {"content": "contract A { }"}}})",
+		R"({"language": "Solidity", "sources": {"fileB": {"content": "contract B { function f() public {} "}}})",
+	};
+	vector<char const*> inputPointers;
+	for (string const& input: inputs)
+		inputPointers.push_back(input.c_str());
+
+	vector<pair<size_t, string>> outputs;
+	solidity_compile_batch(
+		inputPointers.data(),
+		inputPointers.size(),
+		nullptr,
+		nullptr,
+		[](void* _context, size_t _index, char const* _output) {
+			static_cast<vector<pair<size_t, string>>*>(_context)->emplace_back(_index, _output);
+		},
+		&outputs
+	);
+	solidity_reset();
+
+	BOOST_REQUIRE_EQUAL(outputs.size(), 2u);
+	Json::Value result;
+	BOOST_CHECK_EQUAL(outputs[0].first, 0u);
+	BOOST_REQUIRE(util::jsonParseStrict(outputs[0].second, result));
+	BOOST_CHECK(result["sources"].isMember("fileA"));
+	BOOST_CHECK(!result.isMember("errors"));
+	BOOST_CHECK_EQUAL(outputs[1].first, 1u);
+	BOOST_REQUIRE(util::jsonParseStrict(outputs[1].second, result));
+	BOOST_REQUIRE(result["errors"].isArray() && result["errors"].size() == 1);
+	BOOST_CHECK_EQUAL(result["errors"][0]["type"], "ParserError");
+}
+
 BOOST_AUTO_TEST_CASE(missing_callback)
 {
 	char const* input = R"(
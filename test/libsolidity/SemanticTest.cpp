@@ -16,6 +16,7 @@
 
 #include <libsolutil/Whiskers.h>
 #include <libyul/Exceptions.h>
+#include <libsolutil/JSON.h>
 #include <test/Common.h>
 #include <test/libsolidity/util/BytesUtils.h>
 
@@ -56,6 +57,7 @@ SemanticTest::SemanticTest(
 ):
 	SolidityExecutionFramework(_evmVersion, _vmPaths),
 	EVMVersionRestrictedTestCase(_filename),
+	m_filename(_filename),
 	m_sources(m_reader.sources()),
 	m_lineOffset(m_reader.lineNumber()),
 	m_builtins(makeBuiltins()),
@@ -118,7 +120,8 @@ SemanticTest::SemanticTest(
 	parseExpectations(m_reader.stream());
 	soltestAssert(!m_tests.empty(), "No tests specified in " + _filename);
 
-	if (m_enforceGasCost)
+	// The metadata would make the deployment costs depend on the compiler version and settings.
+	if (m_enforceGasCost || !solidity::test::CommonOptions::get().gasReport.empty())
 	{
 		m_compiler.setMetadataFormat(CompilerStack::MetadataFormat::NoMetadata);
 		m_compiler.setMetadataHash(CompilerStack::MetadataHash::None);
@@ -303,6 +306,7 @@ optional<AnnotatedEventSignature> SemanticTest::matchEvent(util::h256 const& has
 TestCase::TestResult SemanticTest::run(ostream& _stream, string const& _linePrefix, bool _formatted)
 {
 	TestResult result = TestResult::Success;
+	m_gasMeasurements.clear();
 
 	if (m_testCaseWantsLegacyRun)
 		result = runTest(_stream, _linePrefix, _formatted, false, false);
@@ -323,6 +327,9 @@ TestCase::TestResult SemanticTest::run(ostream& _stream, string const& _linePref
 				throw;
 		}
 	}
+
+	if (!solidity::test::CommonOptions::get().gasReport.empty())
+		writeGasReport();
 	return result;
 }
 
@@ -365,9 +372,11 @@ TestCase::TestResult SemanticTest::runTest(
 	map<string, solidity::test::Address> libraries;
 
 	bool constructed = false;
+	string const pipeline = _isEwasmRun ? "ewasm" : _isYulRun ? "ir" : "legacy";
 
 	for (TestFunctionCall& test: m_tests)
 	{
+		size_t const callIndex = static_cast<size_t>(&test - m_tests.data());
 		if (constructed)
 		{
 			soltestAssert(
@@ -384,6 +393,7 @@ TestCase::TestResult SemanticTest::runTest(
 			soltestAssert(
 				deploy(test.call().signature, 0, {}, libraries) && m_transactionSuccessful,
 				"Failed to deploy library " + test.call().signature);
+			recordGasUsed(pipeline, callIndex, test.call().signature, true);
 			// For convenience, in semantic tests we assume that an unqualified name like `L` is equivalent to one
 			// with an empty source unit name (`:L`). This is fine because the compiler never uses unqualified
 			// names in the Yul code it produces and does not allow `linkersymbol()` at all in inline assembly.
@@ -399,6 +409,7 @@ TestCase::TestResult SemanticTest::runTest(
 				deploy("", test.call().value.value, test.call().arguments.rawBytes(), libraries);
 			else
 				soltestAssert(deploy("", 0, bytes(), libraries), "Failed to deploy contract.");
+			recordGasUsed(pipeline, callIndex, "constructor", true);
 			constructed = true;
 		}
 
@@ -445,6 +456,8 @@ TestCase::TestResult SemanticTest::runTest(
 					test.call().arguments.rawBytes()
 				);
 			}
+			if (test.call().kind != FunctionCall::Kind::Builtin)
+				recordGasUsed(pipeline, callIndex, test.call().signature, false);
 
 			bool outputMismatch = (output != test.call().expectations.rawBytes());
 			if (!outputMismatch && !checkGasCostExpectation(test, _isYulRun))
@@ -556,6 +569,41 @@ TestCase::TestResult SemanticTest::runTest(
 	return TestResult::Success;
 }
 
+void SemanticTest::recordGasUsed(string const& _pipeline, size_t _call, string const& _signature, bool _deployment)
+{
+	// Transactions that ran out of gas are not comparable.
+	if (!solidity::test::CommonOptions::get().gasReport.empty() && m_gasUsed < InitialGas)
+	{
+		optional<size_t> codeSize;
+		if (_deployment && m_transactionSuccessful)
+			codeSize = m_evmcHost->get_code_size(solidity::test::EVMHost::convertToEVMC(m_contractAddress));
+		m_gasMeasurements.push_back({_pipeline, _call, _signature, _deployment, m_gasUsed, codeSize});
+	}
+}
+
+void SemanticTest::writeGasReport() const
+{
+	string report;
+	for (GasMeasurement const& measurement: m_gasMeasurements)
+	{
+		Json::Value line{Json::objectValue};
+		line["test"] = m_filename;
+		line["pipeline"] = measurement.pipeline;
+		line["call"] = Json::UInt64(measurement.call);
+		line["signature"] = measurement.signature;
+		line["kind"] = measurement.deployment ? "deployment" : "runtime";
+		line["gas"] = Json::UInt64(static_cast<uint64_t>(measurement.gas));
+		if (measurement.codeSize)
+			line["codeSize"] = Json::UInt64(*measurement.codeSize);
+		report += jsonCompactPrint(line) + "\n";
+	}
+
+	// Written at once, so that the lines of tests run in parallel processes are not mixed.
+	ofstream file(solidity::test::CommonOptions::get().gasReport.string(), ios::app | ios::binary);
+	file.write(report.data(), static_cast<streamsize>(report.size()));
+	soltestAssert(file, "Could not write the gas report.");
+}
+
 bool SemanticTest::checkGasCostExpectation(TestFunctionCall& io_test, bool _compileViaYul) const
 {
 	string setting =
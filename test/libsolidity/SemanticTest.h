@@ -85,13 +85,32 @@ public:
 	bool deploy(std::string const& _contractName, u256 const& _value, bytes const& _arguments, std::map<std::string, solidity::test::Address> const& _libraries = {});
 
 private:
+	/// Gas used by a transaction of the test, recorded for the gas report.
+	struct GasMeasurement
+	{
+		/// "legacy", "ir" or "ewasm".
+		std::string pipeline;
+		/// Index of the function call in the expectations that triggered the transaction.
+		size_t call = 0;
+		std::string signature;
+		bool deployment = false;
+		u256 gas;
+		/// Size of the deployed code, only for successful deployments.
+		std::optional<size_t> codeSize;
+	};
+
 	TestResult runTest(std::ostream& _stream, std::string const& _linePrefix, bool _formatted, bool _isYulRun, bool _isEwasmRun);
+	/// Records the gas used by the last transaction if a gas report was requested.
+	void recordGasUsed(std::string const& _pipeline, size_t _call, std::string const& _signature, bool _deployment);
+	/// Appends the measurements of the last run to the gas report.
+	void writeGasReport() const;
 	bool checkGasCostExpectation(TestFunctionCall& io_test, bool _compileViaYul) const;
 	std::map<std::string, Builtin> makeBuiltins();
 	std::vector<SideEffectHook> makeSideEffectHooks() const;
 	std::vector<std::string> eventSideEffectHook(FunctionCall const&) const;
 	std::optional<AnnotatedEventSignature> matchEvent(util::h256 const& hash) const;
 	static std::string formatEventParameter(std::optional<AnnotatedEventSignature> _signature, bool _indexed, size_t _index, bytes const& _data);
+	std::string m_filename;
 	SourceMap m_sources;
 	std::size_t m_lineOffset;
 	std::vector<TestFunctionCall> m_tests;
@@ -109,6 +128,7 @@ private:
 	bool m_gasCostFailure = false;
 	bool m_enforceGasCost = false;
 	u256 m_enforceGasCostMinValue;
+	std::vector<GasMeasurement> m_gasMeasurements;
 };
 
 }
@@ -31,6 +31,7 @@
 
 #include <cstdlib>
 #include <iostream>
+#include <tuple>
 
 using namespace solidity;
 using namespace solidity::frontend;
@@ -52,29 +53,53 @@ bytes SolidityExecutionFramework::multiSourceCompileContract(
 	for (auto& entry: sourcesWithPreamble)
 		entry.second = addPreamble(entry.second);
 
-	m_compiler.reset();
-	m_compiler.enableEwasmGeneration(m_compileToEwasm);
-	m_compiler.setSources(sourcesWithPreamble);
-	m_compiler.setLibraries(_libraryAddresses);
-	m_compiler.setRevertStringBehaviour(m_revertStrings);
-	m_compiler.setEVMVersion(m_evmVersion);
-	m_compiler.setOptimiserSettings(m_optimiserSettings);
-	m_compiler.enableEvmBytecodeGeneration(!m_compileViaYul);
-	m_compiler.enableIRGeneration(m_compileViaYul);
-	m_compiler.setRevertStringBehaviour(m_revertStrings);
-	if (!m_compiler.compile())
+	CompilationInput input{
+		sourcesWithPreamble,
+		_libraryAddresses,
+		m_evmVersion,
+		m_optimiserSettings,
+		m_revertStrings,
+		m_compileViaYul,
+		m_compileToEwasm
+	};
+	if (!m_lastCompilation || !(*m_lastCompilation == input) || !compilerHoldsLastCompilation())
 	{
-		// The testing framework expects an exception for
-		// "unimplemented" yul IR generation.
-		if (m_compileViaYul)
-			for (auto const& error: m_compiler.errors())
-				if (error->type() == langutil::Error::Type::CodeGenerationError)
-					BOOST_THROW_EXCEPTION(*error);
-		langutil::SourceReferenceFormatter{std::cerr, m_compiler, true, false}
-			.printErrorInformation(m_compiler.errors());
-		BOOST_ERROR("Compiling contract failed");
+		m_lastCompilation.reset();
+		m_lastCompilationBytecode.clear();
+
+		m_compiler.reset();
+		m_compiler.enableEwasmGeneration(m_compileToEwasm);
+		m_compiler.setSources(sourcesWithPreamble);
+		m_compiler.setLibraries(_libraryAddresses);
+		m_compiler.setRevertStringBehaviour(m_revertStrings);
+		m_compiler.setEVMVersion(m_evmVersion);
+		m_compiler.setOptimiserSettings(m_optimiserSettings);
+		m_compiler.enableEvmBytecodeGeneration(!m_compileViaYul);
+		m_compiler.enableIRGeneration(m_compileViaYul);
+		m_compiler.setRevertStringBehaviour(m_revertStrings);
+		if (!m_compiler.compile())
+		{
+			// The testing framework expects an exception for
+			// "unimplemented" yul IR generation.
+			if (m_compileViaYul)
+				for (auto const& error: m_compiler.errors())
+					if (error->type() == langutil::Error::Type::CodeGenerationError)
+						BOOST_THROW_EXCEPTION(*error);
+			langutil::SourceReferenceFormatter{std::cerr, m_compiler, true, false}
+				.printErrorInformation(m_compiler.errors());
+			BOOST_ERROR("Compiling contract failed");
+		}
+		else
+			m_lastCompilation = move(input);
 	}
 	string contractName(_contractName.empty() ? m_compiler.lastContractName(_mainSourceName) : _contractName);
+	if (auto bytecode = m_lastCompilationBytecode.find(contractName); bytecode != m_lastCompilationBytecode.end())
+	{
+		if (m_showMetadata)
+			cout << "metadata: " << m_compiler.metadata(contractName) << endl;
+		return bytecode->second;
+	}
+
 	evmasm::LinkerObject obj;
 	if (m_compileViaYul)
 	{
@@ -125,9 +150,35 @@ bytes SolidityExecutionFramework::multiSourceCompileContract(
 	BOOST_REQUIRE(obj.linkReferences.empty());
 	if (m_showMetadata)
 		cout << "metadata: " << m_compiler.metadata(contractName) << endl;
+	if (m_lastCompilation)
+		m_lastCompilationBytecode[contractName] = obj.bytecode;
 	return obj.bytecode;
 }
 
+bool SolidityExecutionFramework::CompilationInput::operator==(CompilationInput const& _other) const
+{
+	return
+		tie(sources, libraryAddresses, evmVersion, optimiserSettings, revertStrings, compileViaYul, compileToEwasm) ==
+		tie(_other.sources, _other.libraryAddresses, _other.evmVersion, _other.optimiserSettings, _other.revertStrings, _other.compileViaYul, _other.compileToEwasm);
+}
+
+bool SolidityExecutionFramework::compilerHoldsLastCompilation() const
+{
+	solAssert(m_lastCompilation, "");
+	if (m_compiler.state() != CompilerStack::State::CompilationSuccessful)
+		return false;
+	vector<string> sourceNames = m_compiler.sourceNames();
+	if (sourceNames.size() != m_lastCompilation->sources.size())
+		return false;
+	for (string const& name: sourceNames)
+	{
+		auto source = m_lastCompilation->sources.find(name);
+		if (source == m_lastCompilation->sources.end() || source->second != m_compiler.charStream(name).source())
+			return false;
+	}
+	return true;
+}
+
 bytes SolidityExecutionFramework::compileContract(
 	string const& _sourceCode,
 	string const& _contractName,
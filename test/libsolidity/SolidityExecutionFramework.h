@@ -24,6 +24,7 @@
 #pragma once
 
 #include <functional>
+#include <optional>
 
 #include <test/ExecutionFramework.h>
 
@@ -81,6 +82,31 @@ protected:
 	bool m_compileToEwasm = false;
 	bool m_showMetadata = false;
 	RevertStrings m_revertStrings = RevertStrings::Default;
+
+private:
+	/// Everything multiSourceCompileContract passes to the compiler.
+	struct CompilationInput
+	{
+		std::map<std::string, std::string> sources;
+		std::map<std::string, solidity::test::Address> libraryAddresses;
+		langutil::EVMVersion evmVersion;
+		OptimiserSettings optimiserSettings;
+		RevertStrings revertStrings;
+		bool compileViaYul;
+		bool compileToEwasm;
+
+		bool operator==(CompilationInput const& _other) const;
+	};
+
+	/// @returns true if m_compiler still holds the successful compilation of @a m_lastCompilation,
+	/// i.e. it was not reset or recompiled since.
+	bool compilerHoldsLastCompilation() const;
+
+	/// Input of the last successful compilation by multiSourceCompileContract. Deploying contracts
+	/// of the same sources with the same settings again reuses it instead of compiling again.
+	std::optional<CompilationInput> m_lastCompilation;
+	/// Bytecode of the contracts of the last compilation that were requested, by contract name.
+	std::map<std::string, bytes> m_lastCompilationBytecode;
 };
 
 } // end namespaces
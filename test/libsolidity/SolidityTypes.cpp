@@ -218,6 +218,42 @@ BOOST_AUTO_TEST_CASE(type_identifiers)
 	BOOST_CHECK_EQUAL(InaccessibleDynamicType().identifier(), "t_inaccessible");
 }
 
+BOOST_AUTO_TEST_CASE(interned_types)
+{
+	Type const* uint256 = TypeProvider::uint256();
+	BOOST_CHECK(TypeProvider::array(DataLocation::Memory, uint256) == TypeProvider::array(DataLocation::Memory, uint256));
+	BOOST_CHECK(TypeProvider::array(DataLocation::Memory, uint256) != TypeProvider::array(DataLocation::Storage, uint256));
+	BOOST_CHECK(TypeProvider::array(DataLocation::Memory, uint256, 3) == TypeProvider::array(DataLocation::Memory, uint256, 3));
+	BOOST_CHECK(TypeProvider::array(DataLocation::Memory, uint256, 3) != TypeProvider::array(DataLocation::Memory, uint256, 4));
+	BOOST_CHECK(TypeProvider::mapping(uint256, uint256) == TypeProvider::mapping(uint256, uint256));
+	BOOST_CHECK(TypeProvider::tuple({uint256, nullptr}) == TypeProvider::tuple({uint256, nullptr}));
+	BOOST_CHECK(TypeProvider::tuple({uint256, nullptr}) != TypeProvider::tuple({nullptr, uint256}));
+
+	ArrayType const* storageArray = TypeProvider::array(DataLocation::Storage, uint256);
+	BOOST_CHECK(
+		TypeProvider::withLocation(storageArray, DataLocation::Memory, true) ==
+		TypeProvider::array(DataLocation::Memory, uint256)
+	);
+
+	// Rational numbers carry more than their identifier, so types containing them are not shared.
+	Type const* rationalNumber = TypeProvider::rationalNumber(rational(1));
+	BOOST_CHECK(TypeProvider::tuple({rationalNumber}) != TypeProvider::tuple({rationalNumber}));
+	BOOST_CHECK(*TypeProvider::tuple({rationalNumber}) == *TypeProvider::tuple({rationalNumber}));
+}
+
+BOOST_AUTO_TEST_CASE(types_kept_by_reset)
+{
+	ArrayType const* array = TypeProvider::array(DataLocation::Storage, TypeProvider::uint256());
+	MappingType const* mapping = TypeProvider::mapping(TypeProvider::address(), array);
+	FixedPointType const* fixedPoint = TypeProvider::fixedPoint(128, 18, FixedPointType::Modifier::Signed);
+	TypeProvider::reset();
+
+	// Types only built from elementary types do not depend on the compilation and are not created again.
+	BOOST_CHECK(TypeProvider::array(DataLocation::Storage, TypeProvider::uint256()) == array);
+	BOOST_CHECK(TypeProvider::mapping(TypeProvider::address(), array) == mapping);
+	BOOST_CHECK(TypeProvider::fixedPoint(128, 18, FixedPointType::Modifier::Signed) == fixedPoint);
+}
+
 BOOST_AUTO_TEST_CASE(encoded_sizes)
 {
 	BOOST_CHECK_EQUAL(IntegerType(16).calldataEncodedSize(true), 32);
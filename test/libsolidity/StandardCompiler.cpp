@@ -29,8 +29,11 @@
 #include <libsolutil/CommonData.h>
 #include <test/Metadata.h>
 
+#include <boost/algorithm/string/replace.hpp>
+
 #include <algorithm>
 #include <set>
+#include <sstream>
 
 using namespace std;
 using namespace solidity::evmasm;
@@ -319,6 +322,211 @@ BOOST_AUTO_TEST_CASE(error_recovery_field)
 	BOOST_CHECK(containsAtMostWarnings(result));
 }
 
+BOOST_AUTO_TEST_CASE(parallelism_field)
+{
+	auto input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"parallelism": -1
+		},
+		"sources": {
+			"empty": {
+				"content": ""
+			}
+		}
+	}
+	)";
+
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsError(result, "JSONError", "\"settings.parallelism\" must be an unsigned integer."));
+}
+
+BOOST_AUTO_TEST_CASE(parallelism_does_not_affect_output)
+{
+	auto compileWithParallelism = [](unsigned _parallelism) {
+		Json::Value input;
+		input["language"] = "Solidity";
+		input["settings"]["viaIR"] = true;
+		input["settings"]["optimizer"]["enabled"] = true;
+		input["settings"]["parallelism"] = _parallelism;
+		input["settings"]["outputSelection"]["*"]["*"] = Json::arrayValue;
+		input["settings"]["outputSelection"]["*"]["*"].append("evm.bytecode.object");
+		input["settings"]["outputSelection"]["*"]["*"].append("evm.deployedBytecode.object");
+		input["sources"]["A.sol"]["content"] =
+			"// SPDX-License-Identifier: GPL-3.0\n"
+			"pragma solidity >=0.0;\n"
+			"contract C { function f(uint x) public pure returns (uint) { return x * 2; } }\n"
+			"contract D { function g() public returns (address) { return address(new C()); } }\n";
+		input["sources"]["B.sol"]["content"] =
+			"// SPDX-License-Identifier: GPL-3.0\n"
+			"pragma solidity >=0.0;\n"
+			"import \"A.sol\";\n"
+			"contract E is C { uint public y; function h() public { y = f(y) + 1; } }\n";
+		frontend::StandardCompiler compiler;
+		return compiler.compile(input);
+	};
+
+	Json::Value serial = compileWithParallelism(1);
+	BOOST_REQUIRE(containsAtMostWarnings(serial));
+	BOOST_CHECK(serial["contracts"] == compileWithParallelism(3)["contracts"]);
+}
+
+BOOST_AUTO_TEST_CASE(parallelism_does_not_affect_model_checker)
+{
+	// In the parallel pipeline, the model checker runs while the IR is optimised.
+	auto compileWithParallelism = [](unsigned _parallelism) {
+		Json::Value input;
+		input["language"] = "Solidity";
+		input["settings"]["viaIR"] = true;
+		input["settings"]["optimizer"]["enabled"] = true;
+		input["settings"]["parallelism"] = _parallelism;
+		input["settings"]["modelChecker"]["engine"] = "bmc";
+		input["settings"]["outputSelection"]["*"]["*"] = Json::arrayValue;
+		input["settings"]["outputSelection"]["*"]["*"].append("evm.bytecode.object");
+		input["sources"]["A.sol"]["content"] =
+			"// SPDX-License-Identifier: GPL-3.0\n"
+			"pragma solidity >=0.0;\n"
+			"contract C { function f(uint x) public pure returns (uint) { assert(x != 7); return x * 2; } }\n"
+			"contract D { function g(uint x) public pure returns (uint) { return 10 / x; } }\n";
+		frontend::StandardCompiler compiler;
+		return compiler.compile(input);
+	};
+
+	Json::Value serial = compileWithParallelism(1);
+	BOOST_REQUIRE(containsAtMostWarnings(serial));
+	BOOST_REQUIRE(serial["errors"].size() >= 1u);
+	BOOST_CHECK(serial == compileWithParallelism(3));
+}
+
+BOOST_AUTO_TEST_CASE(parallelism_does_not_affect_gas_estimates)
+{
+	auto compileWithParallelism = [](unsigned _parallelism) {
+		Json::Value input;
+		input["language"] = "Solidity";
+		input["settings"]["parallelism"] = _parallelism;
+		input["settings"]["outputSelection"]["*"]["*"] = Json::arrayValue;
+		input["settings"]["outputSelection"]["*"]["*"].append("evm.gasEstimates");
+		input["sources"]["A.sol"]["content"] =
+			"// SPDX-License-Identifier: GPL-3.0\n"
+			"pragma solidity >=0.0;\n"
+			"contract C {\n"
+			"	uint y;\n"
+			"	function f(uint x) public returns (uint) { y = g(x); return y; }\n"
+			"	function h(bytes memory b) external pure returns (uint) { return b.length; }\n"
+			"	function g(uint x) internal pure returns (uint) { return x * 2; }\n"
+			"	fallback() external { y = 1; }\n"
+			"}\n";
+		frontend::StandardCompiler compiler;
+		return compiler.compile(input);
+	};
+
+	Json::Value serial = compileWithParallelism(1);
+	BOOST_REQUIRE(containsAtMostWarnings(serial));
+	Json::Value const& gasEstimates = serial["contracts"]["A.sol"]["C"]["evm"]["gasEstimates"];
+	BOOST_CHECK(gasEstimates["creation"].isObject());
+	BOOST_CHECK_EQUAL(gasEstimates["external"].size(), 3);
+	BOOST_CHECK(gasEstimates["internal"].isMember("g(uint256)"));
+	BOOST_CHECK(serial["contracts"] == compileWithParallelism(4)["contracts"]);
+}
+
+BOOST_AUTO_TEST_CASE(parallelism_does_not_affect_parsing)
+{
+	auto compileWithParallelism = [](unsigned _parallelism, bool _withErrors) {
+		Json::Value input;
+		input["language"] = "Solidity";
+		input["settings"]["parallelism"] = _parallelism;
+		input["settings"]["outputSelection"]["*"][""] = Json::arrayValue;
+		input["settings"]["outputSelection"]["*"][""].append("ast");
+		string const header = "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\n";
+		input["sources"]["A.sol"]["content"] = header + "import \"B.sol\";\ncontract A is B { function f() public {} }\n";
+		input["sources"]["B.sol"]["content"] = header + "import \"C.sol\";\ncontract B is C { uint x; }\n";
+		input["sources"]["C.sol"]["content"] = header + "contract C { event E(uint); }\n";
+		input["sources"]["D.sol"]["content"] = header + "import \"C.sol\";\nfunction g() pure returns (uint) { return 1; }\n";
+		if (_withErrors)
+		{
+			input["sources"]["E.sol"]["content"] = header + "import \"missing.sol\";\ncontract E {}\n";
+			input["sources"]["F.sol"]["content"] = header + "contract F { function f( }\n";
+		}
+		frontend::StandardCompiler compiler;
+		return compiler.compile(input);
+	};
+
+	Json::Value serial = compileWithParallelism(1, false);
+	BOOST_REQUIRE(containsAtMostWarnings(serial));
+	BOOST_CHECK(serial == compileWithParallelism(4, false));
+
+	Json::Value serialWithErrors = compileWithParallelism(1, true);
+	BOOST_REQUIRE(serialWithErrors["errors"].size() >= 2u);
+	BOOST_CHECK(serialWithErrors == compileWithParallelism(4, true));
+}
+
+BOOST_AUTO_TEST_CASE(parallelism_does_not_affect_syntax_checks)
+{
+	auto compileWithParallelism = [](unsigned _parallelism) {
+		Json::Value input;
+		input["language"] = "Solidity";
+		input["settings"]["parallelism"] = _parallelism;
+		string const license = "// SPDX-License-Identifier: GPL-3.0\n";
+		// Missing version pragmas, statements outside of loops and invalid doc tags in several sources.
+		input["sources"]["A.sol"]["content"] = license + "contract A { function f() public { continue; } }\n";
+		input["sources"]["B.sol"]["content"] = license + "/// @unknown tag\ncontract B {}\n";
+		input["sources"]["C.sol"]["content"] = license + "contract C { function f() public { break; } }\n";
+		input["sources"]["D.sol"]["content"] = license + "/// @author x\nfunction g() pure returns (uint) { return 1; }\n";
+		frontend::StandardCompiler compiler;
+		return compiler.compile(input);
+	};
+
+	Json::Value serial = compileWithParallelism(1);
+	BOOST_REQUIRE(serial["errors"].size() >= 6u);
+	BOOST_CHECK(serial == compileWithParallelism(4));
+}
+
+BOOST_AUTO_TEST_CASE(analyze_only_requested_contracts)
+{
+	auto compile = [](bool _analyzeOnlyRequestedContracts) {
+		Json::Value input;
+		input["language"] = "Solidity";
+		input["settings"]["analyzeOnlyRequestedContracts"] = _analyzeOnlyRequestedContracts;
+		input["settings"]["outputSelection"]["A.sol"]["A"] = Json::arrayValue;
+		input["settings"]["outputSelection"]["A.sol"]["A"].append("evm.bytecode.object");
+		string const header = "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\n";
+		input["sources"]["A.sol"]["content"] = header +
+			"import \"L.sol\";\n"
+			"contract A is Base { function g() public returns (uint) { new Created(); return f(); } }\n";
+		input["sources"]["L.sol"]["content"] = header +
+			"contract Base { function f() public returns (uint) { return 1; } }\n"
+			"contract Created { function h() public returns (uint) { return 2; } }\n"
+			"contract Unused { function k() public returns (uint) { return 3; } }\n";
+		frontend::StandardCompiler compiler;
+		return compiler.compile(input);
+	};
+	auto warnedAbout = [](Json::Value const& _result, string const& _function) {
+		for (auto const& error: _result["errors"])
+			if (error["formattedMessage"].asString().find("function " + _function + "()") != string::npos)
+				return true;
+		return false;
+	};
+
+	Json::Value full = compile(false);
+	BOOST_REQUIRE(containsAtMostWarnings(full));
+	for (string function: {"f", "h", "k"})
+		BOOST_CHECK(warnedAbout(full, function));
+
+	Json::Value partial = compile(true);
+	BOOST_REQUIRE(containsAtMostWarnings(partial));
+	for (string function: {"f", "h"})
+		BOOST_CHECK(warnedAbout(partial, function));
+	BOOST_CHECK(!warnedAbout(partial, "k"));
+	BOOST_CHECK(partial["contracts"]["A.sol"]["A"]["evm"]["bytecode"]["object"] == full["contracts"]["A.sol"]["A"]["evm"]["bytecode"]["object"]);
+
+	Json::Value invalid;
+	invalid["language"] = "Solidity";
+	invalid["settings"]["analyzeOnlyRequestedContracts"] = 1;
+	invalid["sources"]["A.sol"]["content"] = "";
+	BOOST_CHECK(containsError(frontend::StandardCompiler{}.compile(invalid), "JSONError", "\"settings.analyzeOnlyRequestedContracts\" must be a Boolean."));
+}
+
 BOOST_AUTO_TEST_CASE(optimizer_enabled_not_boolean)
 {
 	char const* input = R"(
@@ -1252,6 +1460,429 @@ BOOST_AUTO_TEST_CASE(optimizer_settings_details_different)
 	BOOST_CHECK(optimizer["runs"].asUInt() == 600);
 }
 
+BOOST_AUTO_TEST_CASE(optimizer_settings_execution_profile)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"outputSelection": {
+				"fileA": { "A": [ "metadata" ] }
+			},
+			"optimizer": { "enabled": true, "executionProfile": {
+				"fileA": [
+					{ "start": 0, "length": 14, "count": 1 },
+					{ "start": 13, "length": 1, "count": 100000 }
+				]
+			} }
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value contract = getContractResult(result, "fileA", "A");
+	BOOST_CHECK(contract.isObject());
+	BOOST_CHECK(contract["metadata"].isString());
+	Json::Value metadata;
+	BOOST_CHECK(util::jsonParseStrict(contract["metadata"].asString(), metadata));
+
+	Json::Value const& optimizer = metadata["settings"]["optimizer"];
+	BOOST_CHECK(optimizer["enabled"].asBool() == true);
+	BOOST_CHECK(!optimizer.isMember("details"));
+	Json::Value const& ranges = optimizer["executionProfile"]["fileA"];
+	BOOST_REQUIRE(ranges.isArray() && ranges.size() == 2);
+	BOOST_CHECK(ranges[0]["start"].asUInt() == 0);
+	BOOST_CHECK(ranges[0]["length"].asUInt() == 14);
+	BOOST_CHECK(ranges[0]["count"].asUInt64() == 1);
+	BOOST_CHECK(ranges[1]["start"].asUInt() == 13);
+	BOOST_CHECK(ranges[1]["length"].asUInt() == 1);
+	BOOST_CHECK(ranges[1]["count"].asUInt64() == 100000);
+
+	char const* invalidInput = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"optimizer": { "executionProfile": { "fileA": [ { "start": 0, "count": 1 } ] } }
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { }"
+			}
+		}
+	}
+	)";
+	result = compile(invalidInput);
+	BOOST_CHECK(containsError(result, "JSONError", "Ranges in \"settings.optimizer.executionProfile\" must have unsigned \"start\", \"length\" and \"count\" fields."));
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_settings_step_budget)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"outputSelection": {
+				"fileA": { "A": [ "metadata" ] }
+			},
+			"optimizer": { "enabled": true, "details": { "yul": true, "yulDetails": { "stepBudget": 20 } } }
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value contract = getContractResult(result, "fileA", "A");
+	BOOST_CHECK(contract.isObject());
+	Json::Value metadata;
+	BOOST_CHECK(util::jsonParseStrict(contract["metadata"].asString(), metadata));
+	Json::Value const& yulDetails = metadata["settings"]["optimizer"]["details"]["yulDetails"];
+	BOOST_CHECK(yulDetails["stepBudget"].asUInt() == 20);
+	BOOST_CHECK(yulDetails["optimizerSteps"].asString() == OptimiserSettings::DefaultYulOptimiserSteps);
+
+	char const* invalidInput = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"optimizer": { "enabled": true, "details": { "yul": true, "yulDetails": { "stepBudget": "20" } } }
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { }"
+			}
+		}
+	}
+	)";
+	result = compile(invalidInput);
+	BOOST_CHECK(containsError(result, "JSONError", "\"settings.optimizer.details.yulDetails.stepBudget\" must be an unsigned integer."));
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_settings_autotune)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"viaIR": true,
+			"outputSelection": {
+				"fileA": { "A": [ "metadata", "evm.bytecode.object" ] }
+			},
+			"optimizer": { "enabled": true, "details": { "yul": true, "yulDetails": { "autotuneCandidates": 3 } } }
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { uint x; function f(uint a) public { for (uint i = 0; i < a; i++) x += i; } }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value contract = getContractResult(result, "fileA", "A");
+	BOOST_CHECK(contract.isObject());
+	BOOST_CHECK(!contract["evm"]["bytecode"]["object"].asString().empty());
+	Json::Value metadata;
+	BOOST_CHECK(util::jsonParseStrict(contract["metadata"].asString(), metadata));
+	Json::Value const& yulDetails = metadata["settings"]["optimizer"]["details"]["yulDetails"];
+	BOOST_CHECK(yulDetails["autotuneCandidates"].asUInt() == 3);
+
+	char const* invalidInput = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"optimizer": { "enabled": true, "details": { "yul": true, "yulDetails": { "autotuneCandidates": -1 } } }
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { }"
+			}
+		}
+	}
+	)";
+	result = compile(invalidInput);
+	BOOST_CHECK(containsError(result, "JSONError", "\"settings.optimizer.details.yulDetails.autotuneCandidates\" must be an unsigned integer."));
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_settings_stack_layout_effort)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"viaIR": true,
+			"outputSelection": {
+				"fileA": { "A": [ "metadata", "evm.bytecode.object" ] }
+			},
+			"optimizer": { "enabled": true, "details": { "stackLayoutEffort": 4 } }
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { function f(uint a, uint b, uint c) public pure returns (uint) { if (a > b) return c; return a + b; } }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value contract = getContractResult(result, "fileA", "A");
+	BOOST_CHECK(contract.isObject());
+	BOOST_CHECK(!contract["evm"]["bytecode"]["object"].asString().empty());
+	Json::Value metadata;
+	BOOST_CHECK(util::jsonParseStrict(contract["metadata"].asString(), metadata));
+	BOOST_CHECK(metadata["settings"]["optimizer"]["details"]["stackLayoutEffort"].asUInt() == 4);
+
+	char const* invalidInput = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"optimizer": { "enabled": true, "details": { "stackLayoutEffort": "high" } }
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { }"
+			}
+		}
+	}
+	)";
+	result = compile(invalidInput);
+	BOOST_CHECK(containsError(result, "JSONError", "\"settings.optimizer.details.stackLayoutEffort\" must be an unsigned integer."));
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_settings_selector_dispatch)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"viaIR": true,
+			"outputSelection": {
+				"fileA": { "A": [ "metadata", "ir", "evm.bytecode.object" ] }
+			},
+			"optimizer": { "enabled": true, "details": { "selectorDispatch": "binarySearch" } }
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { function a() public {} function b() public {} function c() public {} function d() public {} function e() public {} function f() public {} }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value contract = getContractResult(result, "fileA", "A");
+	BOOST_CHECK(contract.isObject());
+	BOOST_CHECK(!contract["evm"]["bytecode"]["object"].asString().empty());
+	BOOST_CHECK(contract["ir"].asString().find("switch lt(selector, ") != string::npos);
+	Json::Value metadata;
+	BOOST_CHECK(util::jsonParseStrict(contract["metadata"].asString(), metadata));
+	BOOST_CHECK(metadata["settings"]["optimizer"]["details"]["selectorDispatch"].asString() == "binarySearch");
+
+	char const* invalidInput = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"optimizer": { "enabled": true, "details": { "selectorDispatch": "jumpTable" } }
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { }"
+			}
+		}
+	}
+	)";
+	result = compile(invalidInput);
+	BOOST_CHECK(containsError(result, "JSONError", "\"settings.optimizer.details.selectorDispatch\" must be \"switch\", \"binarySearch\" or \"auto\"."));
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_settings_lazy_calldata_parameters)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"viaIR": true,
+			"outputSelection": {
+				"fileA": { "A": [ "metadata", "ir", "evm.bytecode.object" ] }
+			},
+			"optimizer": { "enabled": true, "details": { "lazyCalldataParameters": true } }
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { struct S { uint a; uint[] b; } function f(S memory s, uint i) external pure returns (uint) { return s.a + s.b[i] + s.b.length; } }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value contract = getContractResult(result, "fileA", "A");
+	BOOST_CHECK(contract.isObject());
+	BOOST_CHECK(!contract["evm"]["bytecode"]["object"].asString().empty());
+	BOOST_CHECK(contract["ir"].asString().find("_calldata_ptr") != string::npos);
+	BOOST_CHECK(contract["ir"].asString().find("_memory_ptr") == string::npos);
+	Json::Value metadata;
+	BOOST_CHECK(util::jsonParseStrict(contract["metadata"].asString(), metadata));
+	BOOST_CHECK(metadata["settings"]["optimizer"]["details"]["lazyCalldataParameters"].asBool());
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_settings_reclaim_temporary_memory)
+{
+	auto compileContract = [&](bool _reclaimTemporaryMemory) {
+		string input = R"(
+		{
+			"language": "Solidity",
+			"settings": {
+				"viaIR": true,
+				"outputSelection": {
+					"fileA": { "A": [ "metadata", "ir", "evm.bytecode.object" ] }
+				},
+				"optimizer": { "enabled": true, "details": { "reclaimTemporaryMemory": )" + string(_reclaimTemporaryMemory ? "true" : "false") + R"( } }
+			},
+			"sources": {
+				"fileA": {
+					"content": "contract A { function f(uint n) external pure returns (bytes32 h) { for (uint i = 0; i < n; i++) h = keccak256(abi.encode(h, i)); } }"
+				}
+			}
+		}
+		)";
+		Json::Value result = compile(input);
+		BOOST_CHECK(containsAtMostWarnings(result));
+		return getContractResult(result, "fileA", "A");
+	};
+	auto countAllocationResets = [](string const& _ir) {
+		size_t count = 0;
+		for (size_t pos = _ir.find("finalize_allocation("); pos != string::npos; pos = _ir.find("finalize_allocation(", pos + 1))
+			++count;
+		return count;
+	};
+
+	Json::Value contract = compileContract(true);
+	BOOST_CHECK(contract.isObject());
+	BOOST_CHECK(!contract["evm"]["bytecode"]["object"].asString().empty());
+	BOOST_CHECK(
+		countAllocationResets(contract["ir"].asString()) >
+		countAllocationResets(compileContract(false)["ir"].asString())
+	);
+	Json::Value metadata;
+	BOOST_CHECK(util::jsonParseStrict(contract["metadata"].asString(), metadata));
+	BOOST_CHECK(metadata["settings"]["optimizer"]["details"]["reclaimTemporaryMemory"].asBool());
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_settings_select_steps)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"viaIR": true,
+			"outputSelection": {
+				"fileA": { "A": [ "metadata", "evm.bytecode.object" ] }
+			},
+			"optimizer": { "enabled": true, "details": { "yul": true, "yulDetails": { "selectSteps": true } } }
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { uint x; uint y; function f(uint a) public { x = a; y = x + a; x = y; } }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value contract = getContractResult(result, "fileA", "A");
+	BOOST_CHECK(contract.isObject());
+	BOOST_CHECK(!contract["evm"]["bytecode"]["object"].asString().empty());
+	Json::Value metadata;
+	BOOST_CHECK(util::jsonParseStrict(contract["metadata"].asString(), metadata));
+	Json::Value const& yulDetails = metadata["settings"]["optimizer"]["details"]["yulDetails"];
+	BOOST_CHECK(yulDetails["selectSteps"].asBool());
+
+	char const* invalidInput = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"optimizer": { "enabled": true, "details": { "yul": true, "yulDetails": { "selectSteps": 1 } } }
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { }"
+			}
+		}
+	}
+	)";
+	result = compile(invalidInput);
+	BOOST_CHECK(containsError(result, "JSONError", "\"settings.optimizer.details.selectSteps\" must be Boolean"));
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_settings_overrides)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"outputSelection": {
+				"fileA": { "*": [ "metadata", "evm.bytecode.object" ] }
+			},
+			"optimizer": { "enabled": true, "overrides": {
+				"fileA": {
+					"A": { "runs": 1 },
+					"B": { "runs": 1000000, "optimizerSteps": "dhfoDgvulfnTUtnIf" }
+				}
+			} }
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { function f() public pure returns (uint) { return 0x1234567890; } } contract B { }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	for (string contractName: {"A", "B"})
+	{
+		Json::Value contract = getContractResult(result, "fileA", contractName);
+		BOOST_REQUIRE(contract.isObject());
+		BOOST_CHECK(!contract["evm"]["bytecode"]["object"].asString().empty());
+		Json::Value metadata;
+		BOOST_REQUIRE(util::jsonParseStrict(contract["metadata"].asString(), metadata));
+
+		// All overrides are part of the metadata of every contract, the other settings are unchanged.
+		Json::Value const& optimizer = metadata["settings"]["optimizer"];
+		BOOST_CHECK(optimizer["enabled"].asBool() == true);
+		BOOST_CHECK(optimizer["runs"].asUInt() == 200);
+		Json::Value const& overrides = optimizer["overrides"]["fileA"];
+		BOOST_CHECK(overrides["A"]["runs"].asUInt() == 1);
+		BOOST_CHECK(!overrides["A"].isMember("optimizerSteps"));
+		BOOST_CHECK(overrides["B"]["runs"].asUInt() == 1000000);
+		BOOST_CHECK(overrides["B"]["optimizerSteps"].asString() == "dhfoDgvulfnTUtnIf");
+	}
+
+	char const* invalidInput = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"optimizer": { "overrides": { "fileA": { "A": { "inliner": false } } } }
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { }"
+			}
+		}
+	}
+	)";
+	result = compile(invalidInput);
+	BOOST_CHECK(containsError(result, "JSONError", "Unknown key \"inliner\""));
+}
+
 BOOST_AUTO_TEST_CASE(metadata_without_compilation)
 {
 	// NOTE: the contract code here should fail to compile due to "out of stack"
@@ -1683,6 +2314,89 @@ BOOST_AUTO_TEST_CASE(stopAfter_ast_output)
 	BOOST_CHECK(result["sources"]["a.sol"]["ast"].isObject());
 }
 
+BOOST_AUTO_TEST_CASE(streamed_output)
+{
+	// Source names are chosen such that sorting by "file:name" and by file differ.
+	string const input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"a": { "content": "pragma solidity >=0.0; contract B { function f() public pure {} } contract A {}" },
+			"a.b": { "content": "pragma solidity >=0.0; contract C {}" },
+			"c": { "content": "pragma solidity >=0.0; contract D {} contract E {" }
+		},
+		"settings": {
+			"outputSelection": { "*": { "*": ["abi", "evm.bytecode.object"], "": ["ast"] } }
+		}
+	}
+	)";
+	for (string const& source: {input, boost::replace_all_copy(input, "contract E {", "contract E {}"), string("{")})
+		for (util::JsonFormat const& format: {util::JsonFormat{}, util::JsonFormat{util::JsonFormat::Pretty}})
+		{
+			frontend::StandardCompiler compiler(ReadCallback::Callback(), format);
+			stringstream streamed;
+			compiler.compile(source, streamed);
+			BOOST_CHECK_EQUAL(streamed.str(), compiler.compile(source));
+		}
+}
+
+BOOST_AUTO_TEST_CASE(profiling_invalid_type)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources":
+		{ "": { "content": "pragma solidity >=0.0; contract C { function f() public pure {} }" } },
+		"settings":
+		{
+			"profiling": 1
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsError(result, "JSONError", "\"settings.profiling\" must be a Boolean."));
+}
+
+BOOST_AUTO_TEST_CASE(profiling_output)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources":
+		{ "": { "content": "pragma solidity >=0.0; contract C { function f() public pure {} }" } },
+		"settings":
+		{
+			"profiling": true,
+			"outputSelection":
+			{
+				"*": { "C": ["evm.bytecode"] }
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	BOOST_REQUIRE(result["profiling"]["phases"].isArray());
+	set<string> phases;
+	for (Json::Value const& phase: result["profiling"]["phases"])
+	{
+		phases.insert(phase["name"].asString());
+		BOOST_CHECK(phase["count"].asUInt64() >= 1);
+	}
+	BOOST_CHECK(phases.count("parsing"));
+	BOOST_CHECK(phases.count("analysis"));
+	BOOST_CHECK(phases.count("EVM code generation"));
+
+	input = R"(
+	{
+		"language": "Solidity",
+		"sources":
+		{ "": { "content": "pragma solidity >=0.0; contract C { function f() public pure {} }" } }
+	}
+	)";
+	BOOST_CHECK(!compile(input).isMember("profiling"));
+}
+
 BOOST_AUTO_TEST_CASE(dependency_tracking_of_abstract_contract)
 {
 	char const* input = R"(
@@ -1810,6 +2524,75 @@ BOOST_AUTO_TEST_CASE(source_location_of_bare_block)
 	BOOST_REQUIRE(sourceMap.find(sourceRef) != string::npos);
 }
 
+BOOST_AUTO_TEST_CASE(bytecode_without_debug_info)
+{
+	auto compileContract = [&](string const& _outputs) {
+		string input = R"(
+		{
+			"language": "Solidity",
+			"settings": {
+				"viaIR": true,
+				"optimizer": { "enabled": true },
+				"outputSelection": {
+					"fileA": { "A": [ )" + _outputs + R"( ] }
+				}
+			},
+			"sources": {
+				"fileA": {
+					"content": "contract A { uint x; function f(uint a) public returns (uint) { require(a > 2, \"small\"); x += a; return x * a; } }"
+				}
+			}
+		}
+		)";
+		Json::Value result = compile(input);
+		BOOST_CHECK(containsAtMostWarnings(result));
+		return getContractResult(result, "fileA", "A");
+	};
+
+	// Only the bytecode is requested, so the IR is generated without source locations.
+	Json::Value withoutDebugInfo = compileContract(R"("evm.bytecode.object")");
+	Json::Value withDebugInfo = compileContract(R"("evm.bytecode.object", "evm.bytecode.sourceMap")");
+	BOOST_REQUIRE(withoutDebugInfo.isObject());
+	BOOST_REQUIRE(withDebugInfo.isObject());
+	BOOST_CHECK(!withoutDebugInfo["evm"]["bytecode"]["object"].asString().empty());
+	BOOST_CHECK_EQUAL(
+		withoutDebugInfo["evm"]["bytecode"]["object"].asString(),
+		withDebugInfo["evm"]["bytecode"]["object"].asString()
+	);
+	BOOST_CHECK(!withDebugInfo["evm"]["bytecode"]["sourceMap"].asString().empty());
+}
+
+BOOST_AUTO_TEST_CASE(outputs_of_creating_contract_after_release)
+{
+	// The results of A are released after its outputs are added, before the ones of B.
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"outputSelection": {
+				"fileA": { "*": [ "evm.bytecode.object", "evm.assembly", "evm.gasEstimates" ] }
+			}
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { uint x; } contract B { function f() public returns (A) { return new A(); } }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value contractA = getContractResult(result, "fileA", "A");
+	Json::Value contractB = getContractResult(result, "fileA", "B");
+	BOOST_REQUIRE(contractA.isObject());
+	BOOST_REQUIRE(contractB.isObject());
+	string objectA = contractA["evm"]["bytecode"]["object"].asString();
+	BOOST_CHECK(!objectA.empty());
+	BOOST_CHECK(!contractB["evm"]["assembly"].asString().empty());
+	BOOST_CHECK(contractB["evm"]["gasEstimates"].isObject());
+	BOOST_CHECK(contractB["evm"]["bytecode"]["object"].asString().find(objectA) != string::npos);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
@@ -0,0 +1,12 @@
+contract C {
+    uint[A] a;
+    uint[B] b;
+    uint[A + B] c;
+    uint[B / A] d;
+    uint[(B * 3) / 2] e;
+    uint constant A = 2;
+    uint constant B = A * 3;
+    uint constant D = (B / 4) * 4;
+    uint[D] f;
+}
+// ----
@@ -0,0 +1,80 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the memory arena.
+ */
+
+#include <libsolutil/Arena.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <string>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(ArenaTest)
+
+BOOST_AUTO_TEST_CASE(alignment)
+{
+	Arena arena;
+	for (size_t alignment: {1u, 2u, 4u, 8u, 16u})
+		for (size_t size: {1u, 3u, 8u, 17u})
+		{
+			void* memory = arena.allocate(size, alignment);
+			BOOST_CHECK_EQUAL(reinterpret_cast<uintptr_t>(memory) % alignment, 0u);
+		}
+}
+
+BOOST_AUTO_TEST_CASE(distinct_memory)
+{
+	Arena arena;
+	char* first = static_cast<char*>(arena.allocate(10, 1));
+	char* second = static_cast<char*>(arena.allocate(10, 1));
+	BOOST_CHECK(first + 10 <= second || second + 10 <= first);
+}
+
+BOOST_AUTO_TEST_CASE(large_allocation)
+{
+	Arena arena;
+	size_t const size = 10 * 1024 * 1024;
+	char* memory = static_cast<char*>(arena.allocate(size, 8));
+	memory[0] = 1;
+	memory[size - 1] = 1;
+	BOOST_CHECK(arena.reservedBytes() >= size);
+}
+
+BOOST_AUTO_TEST_CASE(allocator_keeps_arena_alive)
+{
+	auto arena = make_shared<Arena>();
+	shared_ptr<string> value = allocate_shared<string>(ArenaAllocator<string>{arena}, 100, 'x');
+	BOOST_CHECK(arena.use_count() > 1);
+	weak_ptr<Arena> weakArena = arena;
+	arena.reset();
+	BOOST_CHECK(!weakArena.expired());
+	BOOST_CHECK_EQUAL(*value, string(100, 'x'));
+	value.reset();
+	BOOST_CHECK(weakArena.expired());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
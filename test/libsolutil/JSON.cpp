@@ -21,11 +21,15 @@
  */
 
 #include <libsolutil/JSON.h>
+#include <libsolutil/CommonData.h>
+#include <libsolutil/Exceptions.h>
 
 #include <test/Common.h>
 
 #include <boost/test/unit_test.hpp>
 
+#include <sstream>
+
 using namespace std;
 
 namespace solidity::util::test
@@ -118,6 +122,164 @@ BOOST_AUTO_TEST_CASE(json_compact_print)
 	BOOST_CHECK("{\"1\":1,\"2\":\"2\",\"3\":{\"3.1\":\"3.1\",\"3.2\":2},\"4\":\"\\u0911 \\u0912 \\u0913 \\u0914 \\u0915 \\u0916\",\"5\":\"\\ufffd\"}" == jsonCompactPrint(json));
 }
 
+BOOST_AUTO_TEST_CASE(json_print_arrays_and_escapes)
+{
+	Json::Value json;
+	json["a"] = Json::arrayValue;
+	json["a"].append(1);
+	json["a"].append(Json::arrayValue);
+	json["a"].append(Json::objectValue);
+	json["a"].append(Json::Value(Json::arrayValue));
+	json["a"][3].append(-2);
+	json["b"] = string("\"\\/\b\f\n\r\t\x01\x7f\0", 11);
+	json["c"] = "\xf0\x9f\x98\x80";
+	json["d"] = 0.5;
+	json["e"] = 3.0;
+
+	BOOST_CHECK_EQUAL(
+		jsonCompactPrint(json),
+		"{\"a\":[1,[],{},[-2]],\"b\":\"\\\"\\\\/\\b\\f\\n\\r\\t\\u0001\x7f\\u0000\",\"c\":\"\\ud83d\\ude00\",\"d\":0.5,\"e\":3.0}"
+	);
+	BOOST_CHECK_EQUAL(
+		jsonPrint(json, JsonFormat{JsonFormat::Pretty, 4}),
+		"{\n"
+		"    \"a\":\n"
+		"    [\n"
+		"        1,\n"
+		"        [],\n"
+		"        {},\n"
+		"        [\n"
+		"            -2\n"
+		"        ]\n"
+		"    ],\n"
+		"    \"b\": \"\\\"\\\\/\\b\\f\\n\\r\\t\\u0001\x7f\\u0000\",\n"
+		"    \"c\": \"\\ud83d\\ude00\",\n"
+		"    \"d\": 0.5,\n"
+		"    \"e\": 3.0\n"
+		"}"
+	);
+}
+
+BOOST_AUTO_TEST_CASE(json_stream_writer)
+{
+	Json::Value json;
+	json["a"]["x"]["1"] = Json::arrayValue;
+	json["a"]["x"]["2"]["list"].append(1);
+	json["a"]["x"]["2"]["list"].append("\n");
+	json["a"]["y"]["3"] = "ऑ";
+	json["a"]["z"] = Json::objectValue;
+	json["b"] = 2;
+	json["c"]["d"]["e"] = Json::objectValue;
+
+	for (JsonFormat const& format: {JsonFormat{JsonFormat::Compact}, JsonFormat{JsonFormat::Pretty}, JsonFormat{JsonFormat::Pretty, 4}})
+	{
+		stringstream stream;
+		JsonStreamWriter writer(stream, format);
+		writer.beginObject();
+		writer.beginObject("a");
+		writer.beginObject("x");
+		writer.writeMember("1", json["a"]["x"]["1"]);
+		writer.writeMember("2", json["a"]["x"]["2"]);
+		writer.endObject();
+		writer.beginObject("y");
+		writer.writeMember("3", json["a"]["y"]["3"]);
+		writer.endObject();
+		writer.beginObject("z");
+		writer.endObject();
+		writer.endObject();
+		writer.writeMember("b", json["b"]);
+		writer.writeMember("c", json["c"]);
+		BOOST_CHECK_EQUAL(writer.depth(), 1u);
+		writer.endObject();
+		BOOST_CHECK_EQUAL(stream.str(), jsonPrint(json, format));
+	}
+
+	stringstream stream;
+	JsonStreamWriter writer(stream, JsonFormat{JsonFormat::Pretty});
+	writer.beginObject();
+	writer.endObject();
+	BOOST_CHECK_EQUAL(stream.str(), jsonPrettyPrint(Json::Value(Json::objectValue)));
+}
+
+BOOST_AUTO_TEST_CASE(json_stream_writer_key_order)
+{
+	stringstream stream;
+	JsonStreamWriter writer(stream, JsonFormat{});
+	writer.beginObject();
+	writer.writeMember("b", 1);
+	BOOST_CHECK_THROW(writer.writeMember("a", 1), Exception);
+}
+
+BOOST_AUTO_TEST_CASE(json_remove_null_members)
+{
+	Json::Value json;
+	BOOST_REQUIRE(jsonParseStrict(R"({"a":null,"b":{"c":null,"d":[null,{"e":null,"f":1}]},"g":2})", json));
+	BOOST_CHECK_EQUAL(jsonCompactPrint(removeNullMembers(json)), R"({"b":{"d":[null,{"f":1}]},"g":2})");
+}
+
+BOOST_AUTO_TEST_CASE(json_cbor_encoding)
+{
+	// Examples from Appendix A of RFC 8949.
+	Json::Value map;
+	map["a"] = 1;
+	map["b"] = Json::arrayValue;
+	map["b"].append(2);
+	map["b"].append(3);
+	BOOST_CHECK_EQUAL(toHex(asBytes(jsonToCBOR(map))), "a26161016162820203");
+	BOOST_CHECK_EQUAL(toHex(asBytes(jsonToCBOR(Json::Value(1000000)))), "1a000f4240");
+	BOOST_CHECK_EQUAL(toHex(asBytes(jsonToCBOR(Json::Value(-1000)))), "3903e7");
+	BOOST_CHECK_EQUAL(toHex(asBytes(jsonToCBOR(Json::Value(Json::UInt64(18446744073709551615u))))), "1bffffffffffffffff");
+	BOOST_CHECK_EQUAL(toHex(asBytes(jsonToCBOR(Json::Value(1.1)))), "fb3ff199999999999a");
+	BOOST_CHECK_EQUAL(toHex(asBytes(jsonToCBOR(Json::Value("IETF")))), "6449455446");
+	BOOST_CHECK_EQUAL(toHex(asBytes(jsonToCBOR(Json::Value(Json::nullValue)))), "f6");
+	BOOST_CHECK_EQUAL(toHex(asBytes(jsonToCBOR(Json::Value(true)))), "f5");
+	BOOST_CHECK(isCBORObject(jsonToCBOR(map)));
+	BOOST_CHECK(!isCBORObject(jsonCompactPrint(map)));
+}
+
+BOOST_AUTO_TEST_CASE(json_cbor_roundtrip)
+{
+	Json::Value json;
+	BOOST_REQUIRE(jsonParseStrict(R"({
+		"empty": {}, "list": [1, -2, 3.5, true, false, null, [], "x"], "long": "0123456789012345678901234567890123456789",
+		"numbers": [0, 23, 24, 255, 256, 65535, 65536, 4294967295, 4294967296, -24, -25, -9223372036854775808, 18446744073709551615]
+	})", json));
+	Json::Value decoded;
+	BOOST_REQUIRE(jsonParseCBOR(jsonToCBOR(json), decoded));
+	BOOST_CHECK(decoded == json);
+	BOOST_CHECK_EQUAL(jsonCompactPrint(decoded), jsonCompactPrint(json));
+}
+
+BOOST_AUTO_TEST_CASE(json_cbor_decoding)
+{
+	Json::Value json;
+	string errors;
+
+	// Indefinite lengths and smaller floats as produced by other encoders.
+	BOOST_REQUIRE(jsonParseCBOR(asString(fromHex("bf61610161629f0203ff7f6261626161fff6ff")), json, &errors));
+	BOOST_CHECK_EQUAL(jsonCompactPrint(json), R"({"a":1,"aba":null,"b":[2,3]})");
+	BOOST_REQUIRE(jsonParseCBOR(asString(fromHex("82f93e00fa47c35000")), json, &errors));
+	BOOST_CHECK_EQUAL(json[0].asDouble(), 1.5);
+	BOOST_CHECK_EQUAL(json[1].asDouble(), 100000.0);
+
+	BOOST_CHECK(!jsonParseCBOR("", json, &errors));
+	BOOST_CHECK_EQUAL(errors, "Unexpected end of CBOR data.");
+	BOOST_CHECK(!jsonParseCBOR(asString(fromHex("a161610102")), json, &errors));
+	BOOST_CHECK_EQUAL(errors, "Trailing data after the CBOR item.");
+	BOOST_CHECK(!jsonParseCBOR(asString(fromHex("a26161016161f6")), json, &errors));
+	BOOST_CHECK_EQUAL(errors, "Duplicate key in CBOR map: a");
+	BOOST_CHECK(!jsonParseCBOR(asString(fromHex("a10101")), json, &errors));
+	BOOST_CHECK_EQUAL(errors, "CBOR map keys have to be text strings.");
+	BOOST_CHECK(!jsonParseCBOR(asString(fromHex("4100")), json, &errors));
+	BOOST_CHECK_EQUAL(errors, "CBOR byte strings are not supported.");
+	BOOST_CHECK(!jsonParseCBOR(asString(fromHex("c11a514b67b0")), json, &errors));
+	BOOST_CHECK_EQUAL(errors, "CBOR tags are not supported.");
+	BOOST_CHECK(!jsonParseCBOR(asString(fromHex("9bffffffffffffffff")), json, &errors));
+	BOOST_CHECK_EQUAL(errors, "Unexpected end of CBOR data.");
+	BOOST_CHECK(!jsonParseCBOR(string(2000, static_cast<char>(0x81)) + "\x01", json, &errors));
+	BOOST_CHECK_EQUAL(errors, "CBOR data is nested too deeply.");
+}
+
 BOOST_AUTO_TEST_CASE(parse_json_strict)
 {
 	// In this test we check conformance against JSON.parse (https://tc39.es/ecma262/multipage/structured-data.html#sec-json.parse)
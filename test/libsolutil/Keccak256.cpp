@@ -69,6 +69,32 @@ BOOST_AUTO_TEST_CASE(strings)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(batch)
+{
+	BOOST_CHECK(keccak256Batch({}).empty());
+	BOOST_CHECK_EQUAL(keccak256Batch({bytesConstRef("test")}).at(0), keccak256("test"));
+
+	// Lengths around the block size of 136 bytes, in an order that mixes the number of blocks.
+	vector<size_t> const lengths{0, 300, 1, 135, 136, 137, 271, 2, 272, 273, 32, 1000, 64, 135, 4};
+	vector<bytes> inputs;
+	for (size_t length: lengths)
+	{
+		inputs.emplace_back(length);
+		for (size_t i = 0; i < length; ++i)
+			inputs.back()[i] = static_cast<uint8_t>(i * 7 + length);
+	}
+	for (size_t count = 0; count <= inputs.size(); ++count)
+	{
+		vector<bytesConstRef> refs;
+		for (size_t i = 0; i < count; ++i)
+			refs.emplace_back(&inputs[i]);
+		vector<h256> const hashes = keccak256Batch(refs);
+		BOOST_REQUIRE_EQUAL(hashes.size(), count);
+		for (size_t i = 0; i < count; ++i)
+			BOOST_CHECK_EQUAL(hashes[i], keccak256(inputs[i]));
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -96,6 +96,14 @@ BOOST_AUTO_TEST_CASE(encode_signed)
 	BOOST_REQUIRE(negative_larger[5] == 0x7C);
 }
 
+BOOST_AUTO_TEST_CASE(encode_appends)
+{
+	bytes out{0xAA};
+	solidity::util::lebEncodeTo(out, 624485);
+	solidity::util::lebEncodeSignedTo(out, -123456);
+	BOOST_REQUIRE(out == (bytes{0xAA, 0xE5, 0x8E, 0x26, 0xC0, 0xBB, 0x78}));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -0,0 +1,119 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the phase profiler.
+ */
+
+#include <libsolutil/Profiler.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <thread>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+namespace
+{
+
+struct ProfilerFixture
+{
+	ProfilerFixture() { Profiler::instance().enable(); }
+	~ProfilerFixture() { Profiler::instance().disable(); }
+};
+
+}
+
+BOOST_FIXTURE_TEST_SUITE(ProfilerTest, ProfilerFixture)
+
+BOOST_AUTO_TEST_CASE(disabled)
+{
+	Profiler::instance().disable();
+	{
+		Profiler::Scope scope{"a"};
+	}
+	BOOST_CHECK_EQUAL(Profiler::instance().toJson()["phases"].size(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(nested_scopes)
+{
+	for (size_t i = 0; i < 3; ++i)
+	{
+		Profiler::Scope outer{"outer"};
+		Profiler::Scope first{"first"};
+	}
+	{
+		Profiler::Scope outer{"outer"};
+		Profiler::Scope second{"second"};
+	}
+	{
+		Profiler::Scope other{"another"};
+	}
+
+	Json::Value phases = Profiler::instance().toJson()["phases"];
+	BOOST_REQUIRE_EQUAL(phases.size(), 2u);
+	BOOST_CHECK_EQUAL(phases[0]["name"], "another");
+	BOOST_CHECK_EQUAL(phases[0]["count"].asUInt(), 1u);
+	BOOST_CHECK(!phases[0].isMember("phases"));
+	BOOST_CHECK_EQUAL(phases[1]["name"], "outer");
+	BOOST_CHECK_EQUAL(phases[1]["count"].asUInt(), 4u);
+	BOOST_CHECK(phases[1]["wallTime"].isIntegral());
+	BOOST_CHECK(phases[1]["cpuTime"].isIntegral());
+	BOOST_CHECK(phases[1]["peakMemory"].isIntegral());
+
+	Json::Value const& subPhases = phases[1]["phases"];
+	BOOST_REQUIRE_EQUAL(subPhases.size(), 2u);
+	BOOST_CHECK_EQUAL(subPhases[0]["name"], "first");
+	BOOST_CHECK_EQUAL(subPhases[0]["count"].asUInt(), 3u);
+	BOOST_CHECK_EQUAL(subPhases[1]["name"], "second");
+	BOOST_CHECK_EQUAL(subPhases[1]["count"].asUInt(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(scopes_on_other_threads)
+{
+	thread worker([]() { Profiler::Scope scope{"worker"}; });
+	worker.join();
+
+	Json::Value phases = Profiler::instance().toJson()["phases"];
+	BOOST_REQUIRE_EQUAL(phases.size(), 1u);
+	BOOST_CHECK_EQUAL(phases[0]["name"], "worker");
+}
+
+BOOST_AUTO_TEST_CASE(enable_discards_measurements)
+{
+	{
+		Profiler::Scope scope{"a"};
+	}
+	Profiler::Scope open{"open"};
+	Profiler::instance().enable();
+	{
+		Profiler::Scope scope{"b"};
+	}
+
+	Json::Value phases = Profiler::instance().toJson()["phases"];
+	BOOST_REQUIRE_EQUAL(phases.size(), 1u);
+	// "b" is nested in the scope that was open before, but that one is not recorded.
+	BOOST_CHECK_EQUAL(phases[0]["name"], "open");
+	BOOST_CHECK_EQUAL(phases[0]["phases"][0]["name"], "b");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,104 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the thread pool.
+ */
+
+#include <libsolutil/ThreadPool.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <stdexcept>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(ThreadPoolTest)
+
+BOOST_AUTO_TEST_CASE(zero_threads)
+{
+	ThreadPool pool(0);
+	BOOST_CHECK_EQUAL(pool.threadCount(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(runs_all_tasks)
+{
+	atomic<size_t> counter{0};
+	vector<future<void>> results;
+	{
+		ThreadPool pool(4);
+		for (size_t i = 0; i < 100; ++i)
+			results.emplace_back(pool.enqueue([&]() { ++counter; }));
+		for (future<void>& result: results)
+			result.get();
+	}
+	BOOST_CHECK_EQUAL(counter, 100);
+}
+
+BOOST_AUTO_TEST_CASE(transports_exceptions)
+{
+	ThreadPool pool(2);
+	future<void> failing = pool.enqueue([]() { throw runtime_error("failure"); });
+	future<void> succeeding = pool.enqueue([]() {});
+	BOOST_CHECK_THROW(failing.get(), runtime_error);
+	BOOST_CHECK_NO_THROW(succeeding.get());
+}
+
+BOOST_AUTO_TEST_CASE(parallel_for_runs_all_indices)
+{
+	vector<size_t> values(100, 0);
+	parallelFor(values.size(), 4, [&](size_t _i) { values[_i] = _i + 1; });
+	for (size_t i = 0; i < values.size(); ++i)
+		BOOST_CHECK_EQUAL(values[i], i + 1);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_for_nested)
+{
+	atomic<size_t> counter{0};
+	parallelFor(8, 4, [&](size_t) {
+		parallelFor(8, 4, [&](size_t) { ++counter; });
+	});
+	BOOST_CHECK_EQUAL(counter, 64);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_for_rethrows_lowest_failure)
+{
+	for (size_t parallelism: vector<size_t>{1, 4})
+	{
+		string failure;
+		try
+		{
+			parallelFor(50, parallelism, [](size_t _i) {
+				if (_i % 10 == 7)
+					throw runtime_error(to_string(_i));
+			});
+		}
+		catch (runtime_error const& _exception)
+		{
+			failure = _exception.what();
+		}
+		BOOST_CHECK_EQUAL(failure, "7");
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
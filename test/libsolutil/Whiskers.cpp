@@ -208,6 +208,19 @@ BOOST_AUTO_TEST_CASE(invalid_param_rendered)
 	BOOST_CHECK_EQUAL(m.render(), templ);
 }
 
+BOOST_AUTO_TEST_CASE(same_template_different_values)
+{
+	string templ = "<?c><a><!c>-</c><#l>[<x>]</l><b >";
+	vector<map<string, string>> list(2);
+	list[0]["x"] = "1";
+	list[1]["x"] = "2";
+	BOOST_CHECK_EQUAL(Whiskers(templ)("a", "A")("c", true)("l", list).render(), "A[1][2]<b >");
+	BOOST_CHECK_EQUAL(Whiskers(templ)("a", "B")("c", false)("l", vector<map<string, string>>{}).render(), "-<b >");
+	Whiskers m(templ);
+	m("a", "A")("l", list);
+	BOOST_CHECK_THROW(m.render(), WhiskersError);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
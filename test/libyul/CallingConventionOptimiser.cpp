@@ -0,0 +1,143 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the choice of the calling conventions of functions in the optimized EVM code transform.
+ */
+
+#include <test/Common.h>
+#include <test/libyul/Common.h>
+
+#include <libyul/backends/evm/CallingConventionOptimiser.h>
+#include <libyul/backends/evm/ControlFlowGraphBuilder.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/AssemblyStack.h>
+#include <libyul/Object.h>
+
+#include <libevmasm/LinkerObject.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <range/v3/view/enumerate.hpp>
+
+#include <algorithm>
+
+using namespace std;
+using namespace solidity::frontend;
+using namespace solidity::langutil;
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+/// Functions whose callers have the arguments and use the return values in the opposite order of their declaration.
+string const source = R"(
+	{
+		function f(a, b, c) -> x, y {
+			x := add(a, calldataload(b))
+			y := mul(c, calldataload(x))
+			if lt(x, y) { x, y := f(c, b, a) }
+		}
+		function g(a, b) -> r {
+			r := sub(a, b)
+			sstore(r, a)
+		}
+		let p := calldataload(0)
+		let q := calldataload(32)
+		let s := calldataload(64)
+		let u, v := f(s, q, p)
+		sstore(g(v, u), g(u, v))
+		let w, z := f(v, u, s)
+		sstore(z, w)
+	}
+)";
+
+EVMDialect const& dialect()
+{
+	return EVMDialect::strictAssemblyForEVMObjects(solidity::test::CommonOptions::get().evmVersion());
+}
+
+string assemble(size_t _stackLayoutEffort)
+{
+	OptimiserSettings settings = OptimiserSettings::minimal();
+	settings.optimizeStackAllocation = true;
+	settings.stackLayoutEffort = _stackLayoutEffort;
+	AssemblyStack stack(
+		solidity::test::CommonOptions::get().evmVersion(),
+		AssemblyStack::Language::StrictAssembly,
+		settings,
+		DebugInfoSelection::All()
+	);
+	BOOST_REQUIRE(stack.parseAndAnalyze("", source));
+	MachineAssemblyObject object = stack.assemble(AssemblyStack::Machine::EVM);
+	BOOST_REQUIRE(object.bytecode);
+	return object.assembly + "\n" + object.bytecode->toHex();
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulCallingConventionOptimiser)
+
+BOOST_AUTO_TEST_CASE(calls_match_conventions)
+{
+	ErrorList errors;
+	auto [object, analysisInfo] = parse(source, dialect(), errors);
+	BOOST_REQUIRE(object && analysisInfo);
+	unique_ptr<CFG> cfg = ControlFlowGraphBuilder::build(*analysisInfo, dialect(), *object->code);
+	CallingConventionOptimiser::run(*cfg, 3);
+
+	for (auto const& [function, info]: cfg->functionInfo)
+	{
+		vector<size_t> argumentOrder = info.argumentOrder;
+		sort(argumentOrder.begin(), argumentOrder.end());
+		BOOST_REQUIRE_EQUAL(argumentOrder.size(), function->arguments.size());
+		for (size_t i = 0; i < argumentOrder.size(); ++i)
+			BOOST_CHECK_EQUAL(argumentOrder[i], i);
+		vector<size_t> returnOrder = info.returnOrder;
+		sort(returnOrder.begin(), returnOrder.end());
+		BOOST_REQUIRE_EQUAL(returnOrder.size(), function->returns.size());
+		for (size_t i = 0; i < returnOrder.size(); ++i)
+			BOOST_CHECK_EQUAL(returnOrder[i], i);
+	}
+
+	for (CFG::BasicBlock const& block: cfg->blocks)
+		for (CFG::Operation const& operation: block.operations)
+			if (auto const* call = get_if<CFG::FunctionCall>(&operation.operation))
+			{
+				CFG::FunctionInfo const& info = cfg->functionInfo.at(&call->function.get());
+				for (auto&& [position, index]: info.returnOrder | ranges::views::enumerate)
+				{
+					StackSlot expectedOutput = TemporarySlot{call->functionCall, index};
+					BOOST_CHECK(operation.output.at(position) == expectedOutput);
+				}
+				BOOST_CHECK(holds_alternative<FunctionCallReturnLabelSlot>(operation.input.front()));
+			}
+}
+
+BOOST_AUTO_TEST_CASE(code_generation_is_deterministic)
+{
+	// The code transform asserts that the arguments of each call are in the order of its convention.
+	string const result = assemble(2);
+	BOOST_CHECK_EQUAL(assemble(2), result);
+	BOOST_CHECK(!assemble(0).empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
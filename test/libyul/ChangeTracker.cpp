@@ -0,0 +1,96 @@
+/*
+    This file is part of solidity.
+
+    solidity is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    solidity is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for tracking the changes of optimiser steps.
+ */
+
+#include <test/Common.h>
+
+#include <test/libyul/Common.h>
+
+#include <libyul/optimiser/ChangeTracker.h>
+#include <libyul/optimiser/NameDispenser.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/AST.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace solidity::yul::test
+{
+
+BOOST_AUTO_TEST_SUITE(YulChangeTracker)
+
+BOOST_AUTO_TEST_CASE(unchanged_steps)
+{
+	shared_ptr<Block> ast = parse("{ let x := 1 sstore(x, 2) }", false).first;
+	BOOST_REQUIRE(ast);
+	NameDispenser dispenser(EVMDialect::strictAssemblyForEVM({}), *ast);
+	ChangeTracker tracker(*ast, dispenser);
+	BOOST_CHECK(!tracker.unchanged("a"));
+
+	BOOST_CHECK(!tracker.stepRun("a", *ast, dispenser));
+	BOOST_CHECK(tracker.unchanged("a"));
+	BOOST_CHECK(!tracker.unchanged("b"));
+	BOOST_CHECK(!tracker.stepRun("b", *ast, dispenser));
+	BOOST_CHECK(tracker.unchanged("a"));
+	BOOST_CHECK(tracker.unchanged("b"));
+
+	get<Literal>(*get<VariableDeclaration>(ast->statements.front()).value).value = "3"_yulstring;
+	BOOST_CHECK(tracker.stepRun("c", *ast, dispenser));
+	BOOST_CHECK(!tracker.unchanged("a"));
+	BOOST_CHECK(!tracker.unchanged("b"));
+	BOOST_CHECK(!tracker.unchanged("c"));
+
+	tracker.stepRun("a", *ast, dispenser);
+	BOOST_CHECK(tracker.unchanged("a"));
+}
+
+BOOST_AUTO_TEST_CASE(dispensed_names_are_changes)
+{
+	shared_ptr<Block> ast = parse("{ let x := 1 }", false).first;
+	BOOST_REQUIRE(ast);
+	NameDispenser dispenser(EVMDialect::strictAssemblyForEVM({}), *ast);
+	ChangeTracker tracker(*ast, dispenser);
+	tracker.stepRun("a", *ast, dispenser);
+	BOOST_CHECK(tracker.unchanged("a"));
+
+	dispenser.newName("x"_yulstring);
+	tracker.stepRun("b", *ast, dispenser);
+	BOOST_CHECK(!tracker.unchanged("a"));
+	BOOST_CHECK(!tracker.unchanged("b"));
+}
+
+BOOST_AUTO_TEST_CASE(debug_data_is_compared)
+{
+	shared_ptr<Block> ast = parse("{ let x := 1 }", false).first;
+	BOOST_REQUIRE(ast);
+	NameDispenser dispenser(EVMDialect::strictAssemblyForEVM({}), *ast);
+	ChangeTracker tracker(*ast, dispenser);
+	tracker.stepRun("a", *ast, dispenser);
+	BOOST_CHECK(tracker.unchanged("a"));
+
+	auto& declaration = get<VariableDeclaration>(ast->statements.front());
+	declaration.debugData = DebugData::create({}, {}, 42);
+	tracker.stepRun("b", *ast, dispenser);
+	BOOST_CHECK(!tracker.unchanged("a"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
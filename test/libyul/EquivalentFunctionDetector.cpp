@@ -0,0 +1,113 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for detecting equivalent functions in different Yul objects.
+ */
+
+#include <test/Common.h>
+
+#include <libyul/AST.h>
+#include <libyul/AssemblyStack.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/optimiser/EquivalentFunctionDetector.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace solidity::frontend;
+using namespace solidity::langutil;
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+vector<vector<string>> detect(string const& _source)
+{
+	AssemblyStack stack(
+		solidity::test::CommonOptions::get().evmVersion(),
+		AssemblyStack::Language::StrictAssembly,
+		OptimiserSettings::none(),
+		DebugInfoSelection::None()
+	);
+	BOOST_REQUIRE(stack.parseAndAnalyze("", _source));
+	vector<vector<string>> result;
+	for (auto const& group: CrossObjectEquivalentFunctionDetector::run(
+		EVMDialect::strictAssemblyForEVMObjects(solidity::test::CommonOptions::get().evmVersion()),
+		*stack.parserResult()
+	))
+	{
+		vector<string>& names = result.emplace_back();
+		for (auto const& function: group)
+			names.push_back(function.object + "." + function.definition->name.str());
+	}
+	return result;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(CrossObjectEquivalentFunctionDetectorTest)
+
+BOOST_AUTO_TEST_CASE(equivalent_functions)
+{
+	string const source = R"(
+		object "A" {
+			code {
+				function f(x) -> y { y := add(x, 1) }
+				function g() -> r { r := datasize("A") }
+				function k(a) -> b { b := f(a) }
+			}
+			object "B" {
+				code {
+					function f(x) -> y { y := add(x, 2) }
+					function g() -> r { r := datasize("B") }
+					function h(z) -> w { w := add(z, 1) }
+					function k(a) -> b { b := f(a) }
+				}
+			}
+		}
+	)";
+	vector<vector<string>> const expectation{{"A.f", "A.B.h"}};
+	BOOST_CHECK(detect(source) == expectation);
+}
+
+BOOST_AUTO_TEST_CASE(equivalent_callees)
+{
+	string const source = R"(
+		object "A" {
+			code {
+				function u(x) -> y { y := v(x) }
+				function v(x) -> y { y := mul(x, 2) }
+			}
+			object "B" {
+				code {
+					function u(x) -> y { y := v(x) }
+					function v(x) -> y { y := mul(x, 2) }
+					function w(x) -> y { y := mul(x, 2) }
+				}
+			}
+		}
+	)";
+	vector<vector<string>> const expectation{{"A.u", "A.B.u"}, {"A.v", "A.B.v", "A.B.w"}};
+	BOOST_CHECK(detect(source) == expectation);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,127 @@
+/*
+    This file is part of solidity.
+
+    solidity is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    solidity is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the map that joins the storage and memory knowledge of the DataFlowAnalyzer.
+ */
+
+#include <libyul/optimiser/JournaledNameMap.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+optional<YulString> valueOf(JournaledNameMap const& _map, YulString _key)
+{
+	if (YulString const* value = _map.get(_key))
+		return *value;
+	return nullopt;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulJournaledNameMap)
+
+BOOST_AUTO_TEST_CASE(join_keeps_unchanged_keys)
+{
+	JournaledNameMap map;
+	map.set("a"_yulstring, "x"_yulstring);
+	map.set("b"_yulstring, "y"_yulstring);
+	map.set("c"_yulstring, "z"_yulstring);
+
+	map.branch();
+	map.set("a"_yulstring, "w"_yulstring);
+	map.erase("b"_yulstring);
+	map.set("d"_yulstring, "x"_yulstring);
+	map.join();
+
+	BOOST_CHECK(!valueOf(map, "a"_yulstring));
+	BOOST_CHECK(!valueOf(map, "b"_yulstring));
+	BOOST_CHECK(valueOf(map, "c"_yulstring) == "z"_yulstring);
+	BOOST_CHECK(!valueOf(map, "d"_yulstring));
+}
+
+BOOST_AUTO_TEST_CASE(join_keeps_restored_values)
+{
+	JournaledNameMap map;
+	map.set("a"_yulstring, "x"_yulstring);
+	map.set("b"_yulstring, "y"_yulstring);
+
+	map.branch();
+	map.clear();
+	map.set("a"_yulstring, "x"_yulstring);
+	map.set("b"_yulstring, "z"_yulstring);
+	map.join();
+
+	BOOST_CHECK(valueOf(map, "a"_yulstring) == "x"_yulstring);
+	BOOST_CHECK(!valueOf(map, "b"_yulstring));
+}
+
+BOOST_AUTO_TEST_CASE(nested_branches)
+{
+	JournaledNameMap map;
+	map.set("a"_yulstring, "x"_yulstring);
+	map.set("b"_yulstring, "y"_yulstring);
+
+	map.branch();
+	map.set("c"_yulstring, "z"_yulstring);
+	map.branch();
+	map.eraseIf([](YulString, YulString _value) { return _value == "y"_yulstring; });
+	map.set("a"_yulstring, "w"_yulstring);
+	map.join();
+	// The inner join only removes the keys changed in the inner branch.
+	BOOST_CHECK(!valueOf(map, "a"_yulstring));
+	BOOST_CHECK(!valueOf(map, "b"_yulstring));
+	BOOST_CHECK(valueOf(map, "c"_yulstring) == "z"_yulstring);
+	map.set("a"_yulstring, "x"_yulstring);
+	map.join();
+
+	BOOST_CHECK(valueOf(map, "a"_yulstring) == "x"_yulstring);
+	BOOST_CHECK(!valueOf(map, "b"_yulstring));
+	BOOST_CHECK(!valueOf(map, "c"_yulstring));
+}
+
+BOOST_AUTO_TEST_CASE(erase_value)
+{
+	JournaledNameMap map;
+	map.set("a"_yulstring, "x"_yulstring);
+	map.set("b"_yulstring, "x"_yulstring);
+	map.set("c"_yulstring, "y"_yulstring);
+	map.set("b"_yulstring, "y"_yulstring);
+
+	map.branch();
+	map.eraseValue("y"_yulstring);
+	BOOST_CHECK(valueOf(map, "a"_yulstring) == "x"_yulstring);
+	BOOST_CHECK(!valueOf(map, "b"_yulstring));
+	BOOST_CHECK(!valueOf(map, "c"_yulstring));
+	map.set("c"_yulstring, "y"_yulstring);
+	map.join();
+	BOOST_CHECK(valueOf(map, "c"_yulstring) == "y"_yulstring);
+
+	map.eraseValue("x"_yulstring);
+	map.eraseValue("y"_yulstring);
+	BOOST_CHECK(map.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -65,7 +65,7 @@ protected:
 	EVMDialect m_dialect{EVMVersion{}, true};
 	shared_ptr<Object> m_object;
 	SSAValueTracker m_ssaValues;
-	map<YulString, AssignedValue> m_values;
+	unordered_map<YulString, AssignedValue> m_values;
 };
 
 BOOST_FIXTURE_TEST_SUITE(KnowledgeBase, KnowledgeBaseTest)
@@ -23,8 +23,13 @@
 #include <test/libyul/Common.h>
 
 #include <libyul/optimiser/Metrics.h>
+#include <libyul/optimiser/Suite.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/EVMMetrics.h>
 #include <libyul/AST.h>
 
+#include <libevmasm/GasMeter.h>
+
 #include <boost/test/unit_test.hpp>
 
 using namespace std;
@@ -43,6 +48,39 @@ size_t codeSize(string const& _source, CodeWeights const _weights = {})
 	return CodeSize::codeSize(*ast, _weights);
 }
 
+Dialect const& evmDialect()
+{
+	return EVMDialect::strictAssemblyForEVM(solidity::test::CommonOptions::get().evmVersion());
+}
+
+CodeFeatures codeFeatures(string const& _source)
+{
+	shared_ptr<Block> ast = parse(_source, false).first;
+	BOOST_REQUIRE(ast);
+	return CodeFeatures::of(evmDialect(), *ast);
+}
+
+OptimiserSuite::CodeClass codeClass(string const& _source)
+{
+	shared_ptr<Block> ast = parse(_source, false).first;
+	BOOST_REQUIRE(ast);
+	return OptimiserSuite::classify(evmDialect(), *ast);
+}
+
+/// @returns a block containing @a _count copies of @a _statement with "$" replaced by their index.
+string repeated(string const& _statement, size_t _count)
+{
+	string result;
+	for (size_t i = 0; i < _count; ++i)
+	{
+		string statement = _statement;
+		for (size_t pos = statement.find('$'); pos != string::npos; pos = statement.find('$'))
+			statement.replace(pos, 1, to_string(i + 1));
+		result += statement + "\n";
+	}
+	return result;
+}
+
 }
 
 class CustomWeightFixture
@@ -378,6 +416,79 @@ BOOST_FIXTURE_TEST_CASE(switch_statement_large_custom_weights, CustomWeightFixtu
 	);
 }
 
+BOOST_AUTO_TEST_CASE(code_features)
+{
+	string source = R"({
+		function f(a) -> r { r := mulmod(a, a, 7) }
+		switch shr(224, calldataload(0))
+		case 1 { sstore(0, f(sload(0))) }
+		case 2 { for { let i := 0 } lt(i, exp(2, 3)) { i := add(i, 1) } { sstore(i, div(i, 2)) } }
+		default { if calldatasize() { for {} 0 {} {} } }
+	})";
+	CodeFeatures features = codeFeatures(source);
+	BOOST_CHECK_EQUAL(features.codeSize, CodeSize::codeSizeIncludingFunctions(*parse(source, false).first));
+	BOOST_CHECK_EQUAL(features.loopCount, 2);
+	BOOST_CHECK_EQUAL(features.storageAccesses, 3);
+	BOOST_CHECK_EQUAL(features.arithmeticOperations, 3);
+	BOOST_CHECK_EQUAL(features.externalFunctions, 3);
+}
+
+BOOST_AUTO_TEST_CASE(classify_small_code)
+{
+	BOOST_CHECK(codeClass("{ sstore(0, sload(1)) }") == OptimiserSuite::CodeClass::General);
+}
+
+BOOST_AUTO_TEST_CASE(classify_storage_heavy)
+{
+	BOOST_CHECK(
+		codeClass("{" + repeated("sstore($, add(sload($), 1))", 60) + "}") ==
+		OptimiserSuite::CodeClass::StorageHeavy
+	);
+}
+
+BOOST_AUTO_TEST_CASE(classify_computation_heavy)
+{
+	BOOST_CHECK(
+		codeClass(
+			"{ let x := calldataload(0) for { let i := 0 } lt(i, 10) { i := add(i, 1) } {" +
+			repeated("x := mulmod(x, add(x, $), 7)", 60) +
+			"} sstore(0, x) }"
+		) == OptimiserSuite::CodeClass::ComputationHeavy
+	);
+	// Arithmetic without loops does not profit from loop optimisations.
+	BOOST_CHECK(
+		codeClass("{ let x := calldataload(0) " + repeated("x := mulmod(x, add(x, $), 7)", 60) + "}") ==
+		OptimiserSuite::CodeClass::General
+	);
+}
+
+BOOST_AUTO_TEST_CASE(classify_general)
+{
+	BOOST_CHECK(
+		codeClass("{" + repeated("mstore($, add(mload($), 1))", 60) + "}") ==
+		OptimiserSuite::CodeClass::General
+	);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(YulGasMeter)
+
+BOOST_AUTO_TEST_CASE(storage_and_account_access_costs)
+{
+	auto runCosts = [](evmasm::Instruction _instruction, EVMVersion _evmVersion) {
+		GasMeter meter{EVMDialect::strictAssemblyForEVM(_evmVersion), false, 1};
+		// Data costs of a single byte of runtime code.
+		return meter.instructionCosts(_instruction) - evmasm::GasCosts::createDataGas;
+	};
+	BOOST_CHECK_EQUAL(runCosts(evmasm::Instruction::SLOAD, EVMVersion::istanbul()), 800);
+	BOOST_CHECK_EQUAL(runCosts(evmasm::Instruction::SLOAD, EVMVersion::berlin()), evmasm::GasCosts::coldSloadCost);
+	BOOST_CHECK_EQUAL(runCosts(evmasm::Instruction::SSTORE, EVMVersion::berlin()), 20000 + evmasm::GasCosts::coldSloadCost);
+	BOOST_CHECK_EQUAL(runCosts(evmasm::Instruction::BALANCE, EVMVersion::istanbul()), 700);
+	BOOST_CHECK_EQUAL(runCosts(evmasm::Instruction::BALANCE, EVMVersion::berlin()), evmasm::GasCosts::coldAccountAccessCost);
+	BOOST_CHECK_EQUAL(runCosts(evmasm::Instruction::ADD, EVMVersion::berlin()), 3);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -31,6 +31,8 @@
 
 #include <libsolidity/interface/OptimiserSettings.h>
 
+#include <libsolutil/Keccak256.h>
+
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/replace.hpp>
 #include <boost/algorithm/string/split.hpp>
@@ -190,6 +192,34 @@ BOOST_AUTO_TEST_CASE(to_string)
 	BOOST_CHECK_EQUAL(asmStack.print(), expectation);
 }
 
+BOOST_AUTO_TEST_CASE(shares_equal_data)
+{
+	string code = R"(
+		object "O" {
+			code { }
+			object "i" { code { } data "j" hex"616263" }
+			data "j" "abc"
+			data "k" "abd"
+		}
+	)";
+	ErrorList errors;
+	ErrorReporter reporter(errors);
+	ObjectParser objectParser{reporter, yul::EVMDialect::strictAssemblyForEVM(EVMVersion::berlin())};
+	CharStream stream(move(code), "");
+	shared_ptr<Object> object = objectParser.parse(make_shared<Scanner>(stream), false);
+	BOOST_REQUIRE(object && errors.empty());
+	BOOST_REQUIRE_EQUAL(object->subObjects.size(), 3);
+	auto const& inner = dynamic_cast<Object const&>(*object->subObjects[0]);
+	auto const& innerData = dynamic_cast<Data const&>(*inner.subObjects[0]);
+	auto const& outerData = dynamic_cast<Data const&>(*object->subObjects[1]);
+	auto const& otherData = dynamic_cast<Data const&>(*object->subObjects[2]);
+	BOOST_CHECK(innerData.data == outerData.data);
+	BOOST_CHECK(innerData.hash == util::keccak256("abc"));
+	BOOST_CHECK(otherData.data != outerData.data);
+	BOOST_CHECK(*otherData.data == util::asBytes("abd"));
+	BOOST_CHECK(otherData.hash == util::keccak256("abd"));
+}
+
 BOOST_AUTO_TEST_CASE(use_src_empty)
 {
 	auto const [mapping, _] = tryGetSourceLocationMapping("");
@@ -0,0 +1,140 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the binary encoding of Yul objects.
+ */
+
+#include <test/Common.h>
+
+#include <libyul/AssemblyStack.h>
+#include <libyul/AST.h>
+#include <libyul/Object.h>
+#include <libyul/ObjectSerializer.h>
+#include <libyul/backends/evm/EVMDialect.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <memory>
+
+using namespace std;
+using namespace solidity::frontend;
+using namespace solidity::langutil;
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+string const source = R"(
+	/// @use-src 0:"a.sol", 1:"b.sol"
+	object "A" {
+		code {
+			/// @src 0:10:20
+			function f(x) -> y { y := add(x, 1) }
+			/// @ast-id 7 @src 1:5:8
+			for { let i := 0 } lt(i, 10) { i := add(i, 1) } {
+				switch calldataload(i)
+				case 0 { sstore(i, f(i)) }
+				default { leave_or_not() }
+			}
+			function leave_or_not() { if iszero(0) { leave } }
+			datacopy(0, dataoffset("B"), datasize("B"))
+			return(0, datasize("B"))
+		}
+		object "B" {
+			code {
+				let x, z := foo()
+				function foo() -> a, b { a := "abc" b := true }
+				sstore(x, z)
+			}
+			data "C" hex"0102ff"
+		}
+		data ".metadata" "meta"
+	}
+)";
+
+shared_ptr<Object> parse()
+{
+	AssemblyStack stack(
+		solidity::test::CommonOptions::get().evmVersion(),
+		AssemblyStack::Language::StrictAssembly,
+		OptimiserSettings::none(),
+		DebugInfoSelection::All()
+	);
+	BOOST_REQUIRE(stack.parseAndAnalyze("", source));
+	return stack.parserResult();
+}
+
+string print(Object const& _object)
+{
+	return _object.toString(
+		&EVMDialect::strictAssemblyForEVMObjects(solidity::test::CommonOptions::get().evmVersion()),
+		DebugInfoSelection::All()
+	);
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulObjectSerializer)
+
+BOOST_AUTO_TEST_CASE(round_trip)
+{
+	shared_ptr<Object> object = parse();
+	bytes const encoding = ObjectSerializer::serialize(*object);
+	shared_ptr<Object> decoded = ObjectSerializer::deserialize(&encoding);
+	BOOST_REQUIRE(decoded);
+	BOOST_CHECK_EQUAL(print(*decoded), print(*object));
+	BOOST_CHECK(ObjectSerializer::serialize(*decoded) == encoding);
+	BOOST_CHECK(decoded->qualifiedDataNames() == object->qualifiedDataNames());
+	BOOST_CHECK(decoded->pathToSubObject("B"_yulstring) == object->pathToSubObject("B"_yulstring));
+}
+
+BOOST_AUTO_TEST_CASE(shares_debug_data)
+{
+	shared_ptr<Object> decoded = parse();
+	bytes const encoding = ObjectSerializer::serialize(*decoded);
+	decoded = ObjectSerializer::deserialize(&encoding);
+	BOOST_REQUIRE(decoded);
+	// The parser creates one debug data object for the statement and the expression it consists of.
+	auto const& call = get<ExpressionStatement>(decoded->code->statements.back());
+	BOOST_CHECK(call.debugData == get<FunctionCall>(call.expression).debugData);
+	// The source names of the locations are the ones of the object.
+	auto const& function = get<FunctionDefinition>(decoded->code->statements.front());
+	BOOST_REQUIRE(function.debugData->originLocation.sourceName);
+	BOOST_CHECK(function.debugData->originLocation.sourceName == decoded->debugData->sourceNames->at(0));
+}
+
+BOOST_AUTO_TEST_CASE(rejects_invalid_encodings)
+{
+	bytes const encoding = ObjectSerializer::serialize(*parse());
+	BOOST_CHECK(!ObjectSerializer::deserialize({}));
+	for (size_t length: {size_t(1), size_t(5), size_t(20), encoding.size() / 2, encoding.size() - 1})
+		BOOST_CHECK(!ObjectSerializer::deserialize(bytesConstRef(encoding.data(), length)));
+
+	bytes withTrailingData = encoding + bytes{0};
+	BOOST_CHECK(!ObjectSerializer::deserialize(&withTrailingData));
+
+	bytes otherVersion = encoding;
+	otherVersion[4]++;
+	BOOST_CHECK(!ObjectSerializer::deserialize(&otherVersion));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
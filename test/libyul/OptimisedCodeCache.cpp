@@ -0,0 +1,109 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for reusing optimised Yul objects.
+ */
+
+#include <test/Common.h>
+
+#include <libyul/AssemblyStack.h>
+#include <libyul/optimiser/OptimisedCodeCache.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <memory>
+
+using namespace std;
+using namespace solidity::frontend;
+using namespace solidity::langutil;
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+string const source = R"(
+	object "A" {
+		code {
+			function f(x) -> y { y := add(x, 1) }
+			sstore(0, f(calldataload(0)))
+			datacopy(0, dataoffset("B"), datasize("B"))
+			return(0, datasize("B"))
+		}
+		object "B" {
+			code {
+				let x := calldataload(0)
+				let y := mul(x, 2)
+				sstore(x, y)
+			}
+		}
+	}
+)";
+
+string optimise(shared_ptr<OptimisedCodeCache> _cache)
+{
+	AssemblyStack stack(
+		solidity::test::CommonOptions::get().evmVersion(),
+		AssemblyStack::Language::StrictAssembly,
+		OptimiserSettings::full(),
+		DebugInfoSelection::All()
+	);
+	BOOST_REQUIRE(stack.parseAndAnalyze("", source));
+	stack.setOptimisedCodeCache(move(_cache));
+	stack.optimize();
+	return stack.print();
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(OptimisedCodeCacheTest)
+
+BOOST_AUTO_TEST_CASE(reuses_results)
+{
+	string const expectation = optimise(nullptr);
+
+	auto cache = make_shared<OptimisedCodeCache>();
+	BOOST_CHECK_EQUAL(optimise(cache), expectation);
+	BOOST_CHECK_EQUAL(cache->size(), 2u);
+	BOOST_CHECK_EQUAL(optimise(cache), expectation);
+	BOOST_CHECK_EQUAL(cache->size(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(settings_are_part_of_the_key)
+{
+	auto cache = make_shared<OptimisedCodeCache>();
+	optimise(cache);
+
+	OptimiserSettings settings = OptimiserSettings::full();
+	settings.optimizeStackAllocation = false;
+	AssemblyStack stack(
+		solidity::test::CommonOptions::get().evmVersion(),
+		AssemblyStack::Language::StrictAssembly,
+		settings,
+		DebugInfoSelection::All()
+	);
+	BOOST_REQUIRE(stack.parseAndAnalyze("", source));
+	stack.setOptimisedCodeCache(cache);
+	stack.optimize();
+	BOOST_CHECK_EQUAL(cache->size(), 4u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
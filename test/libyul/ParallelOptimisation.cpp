@@ -0,0 +1,198 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for optimising independent Yul objects and functions in parallel
+ * and for generating their stack layouts in parallel.
+ */
+
+#include <test/Common.h>
+
+#include <libyul/AssemblyStack.h>
+#include <libyul/optimiser/OptimisedCodeCache.h>
+
+#include <libevmasm/LinkerObject.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <memory>
+
+using namespace std;
+using namespace solidity::frontend;
+using namespace solidity::langutil;
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+/// Creation code of a factory with a runtime object and two created contracts,
+/// one of which has a runtime object itself.
+string const source = R"(
+	object "Factory" {
+		code {
+			datacopy(0, dataoffset("Factory_deployed"), datasize("Factory_deployed"))
+			return(0, datasize("Factory_deployed"))
+		}
+		object "Factory_deployed" {
+			code {
+				function create(offset, size) -> addr {
+					datacopy(0, offset, size)
+					addr := create(0, 0, size)
+				}
+				sstore(0, create(dataoffset("Child"), datasize("Child")))
+				sstore(1, create(dataoffset("Other"), datasize("Other")))
+			}
+			object "Child" {
+				code {
+					let x := calldataload(0)
+					sstore(x, mul(x, 2))
+					datacopy(0, dataoffset("Child_deployed"), datasize("Child_deployed"))
+					return(0, datasize("Child_deployed"))
+				}
+				object "Child_deployed" {
+					code {
+						for { let i := 0 } lt(i, calldataload(0)) { i := add(i, 1) } {
+							sstore(i, add(sload(i), 1))
+						}
+					}
+				}
+			}
+			object "Other" {
+				code {
+					function g(a, b) -> c { c := add(mul(a, b), sub(a, b)) }
+					sstore(0, g(calldataload(0), calldataload(32)))
+				}
+			}
+		}
+	}
+)";
+
+/// A single object with many functions that are not inlined, since they are recursive.
+string const functionsSource = R"(
+	{
+		function f(a, b) -> c {
+			if lt(a, 10) { leave }
+			mstore(a, b)
+			c := add(mload(a), f(sub(a, 1), keccak256(0, 32)))
+			sstore(a, mload(a))
+		}
+		function g(a) -> r {
+			let x := mul(a, 0)
+			let y := add(calldataload(x), calldataload(x))
+			if gt(a, 8) { r := g(sub(a, 1)) }
+			r := add(r, mul(y, 1))
+			sstore(y, sload(y))
+		}
+		function h(a) {
+			sstore(a, 1)
+			if iszero(sload(a)) { h(add(a, 1)) }
+			mstore(0, sload(a))
+			sstore(not(0), keccak256(0, 32))
+		}
+		function i(a, b) -> c {
+			for { } lt(a, b) { a := add(a, 1) } {
+				c := i(a, sub(b, 1))
+				c := add(c, and(c, c))
+			}
+		}
+		function j(a) -> b {
+			b := j(div(a, 2))
+			mstore(b, b)
+			b := mload(b)
+		}
+		sstore(0, f(calldataload(0), 2))
+		sstore(1, g(calldataload(1)))
+		h(calldataload(2))
+		sstore(2, i(calldataload(3), 5))
+		sstore(3, j(calldataload(4)))
+	}
+)";
+
+string optimise(size_t _parallelism, shared_ptr<OptimisedCodeCache> _cache = nullptr, string const& _source = source)
+{
+	AssemblyStack stack(
+		solidity::test::CommonOptions::get().evmVersion(),
+		AssemblyStack::Language::StrictAssembly,
+		OptimiserSettings::full(),
+		DebugInfoSelection::All()
+	);
+	BOOST_REQUIRE(stack.parseAndAnalyze("", _source));
+	stack.setParallelism(_parallelism);
+	stack.setOptimisedCodeCache(move(_cache));
+	stack.optimize();
+	return stack.print();
+}
+
+string assemble(size_t _parallelism, string const& _source)
+{
+	AssemblyStack stack(
+		solidity::test::CommonOptions::get().evmVersion(),
+		AssemblyStack::Language::StrictAssembly,
+		OptimiserSettings::full(),
+		DebugInfoSelection::All()
+	);
+	BOOST_REQUIRE(stack.parseAndAnalyze("", _source));
+	stack.setParallelism(_parallelism);
+	stack.optimize();
+	MachineAssemblyObject object = stack.assemble(AssemblyStack::Machine::EVM);
+	BOOST_REQUIRE(object.bytecode);
+	return object.assembly + "\n" + object.bytecode->toHex();
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulParallelOptimisation)
+
+BOOST_AUTO_TEST_CASE(same_result_as_serial)
+{
+	string const expectation = optimise(1);
+	for (size_t parallelism: {2u, 4u, 16u})
+		BOOST_CHECK_EQUAL(optimise(parallelism), expectation);
+}
+
+BOOST_AUTO_TEST_CASE(functions_same_result_as_serial)
+{
+	string const expectation = optimise(1, nullptr, functionsSource);
+	for (size_t parallelism: {2u, 3u, 16u})
+		BOOST_CHECK_EQUAL(optimise(parallelism, nullptr, functionsSource), expectation);
+}
+
+BOOST_AUTO_TEST_CASE(stack_layouts_same_result_as_serial)
+{
+	for (string const& input: {source, functionsSource})
+	{
+		string const expectation = assemble(1, input);
+		for (size_t parallelism: {2u, 3u, 16u})
+			BOOST_CHECK_EQUAL(assemble(parallelism, input), expectation);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(shared_cache)
+{
+	string const expectation = optimise(1);
+	auto cache = make_shared<OptimisedCodeCache>();
+	BOOST_CHECK_EQUAL(optimise(4, cache), expectation);
+	BOOST_CHECK_EQUAL(cache->size(), 5u);
+	BOOST_CHECK_EQUAL(optimise(4, cache), expectation);
+	BOOST_CHECK_EQUAL(cache->size(), 5u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,155 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the SSA form of the control flow graph and the constant propagation on it.
+ */
+
+#include <test/Common.h>
+#include <test/libyul/Common.h>
+
+#include <libyul/backends/evm/ControlFlowGraphBuilder.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/SSAConstantPropagator.h>
+#include <libyul/backends/evm/SSAControlFlowGraphBuilder.h>
+#include <libyul/AssemblyStack.h>
+#include <libyul/Object.h>
+
+#include <libevmasm/LinkerObject.h>
+
+#include <libsolutil/Algorithms.h>
+#include <libsolutil/Visitor.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace solidity::frontend;
+using namespace solidity::langutil;
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+/// The branch assigning 2 to x is never taken, so x is 1 in the loop and after it,
+/// while i is not constant.
+string const source = R"(
+	{
+		let x := 1
+		for { let i := 0 } lt(i, calldataload(0)) { i := add(i, 1) }
+		{
+			if iszero(x) { x := 2 }
+			sstore(i, x)
+		}
+		if eq(x, sub(3, 2)) { sstore(0, x) }
+		sstore(1, x)
+	}
+)";
+
+EVMDialect const& dialect()
+{
+	return EVMDialect::strictAssemblyForEVMObjects(solidity::test::CommonOptions::get().evmVersion());
+}
+
+unique_ptr<CFG> buildGraph()
+{
+	ErrorList errors;
+	auto [object, analysisInfo] = parse(source, dialect(), errors);
+	BOOST_REQUIRE(object && analysisInfo);
+	return ControlFlowGraphBuilder::build(*analysisInfo, dialect(), *object->code);
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulSSAConstantPropagator)
+
+BOOST_AUTO_TEST_CASE(phis_join_values_of_entries)
+{
+	unique_ptr<CFG> cfg = buildGraph();
+	unique_ptr<SSACFG> ssa = SSAControlFlowGraphBuilder::build(*cfg);
+	vector<optional<u256>> constants = SSAConstantPropagator::constants(*cfg, *ssa);
+
+	size_t constantPhis = 0;
+	size_t otherPhis = 0;
+	for (CFG::BasicBlock const* block: ssa->blocks)
+		for (SSACFG::ValueId phi: ssa->phis[block->index])
+		{
+			BOOST_CHECK_EQUAL(get<SSACFG::Phi>(ssa->values[phi]).arguments.size(), block->entries.size());
+			if (constants[phi] == u256(1))
+				++constantPhis;
+			else
+				++otherPhis;
+		}
+	// x at the loop condition and after the if statement, i at the loop condition.
+	BOOST_CHECK_EQUAL(constantPhis, 2);
+	BOOST_CHECK_EQUAL(otherPhis, 1);
+}
+
+BOOST_AUTO_TEST_CASE(constant_conditions_and_variables_are_replaced)
+{
+	unique_ptr<CFG> cfg = buildGraph();
+	SSAConstantPropagator::run(*cfg);
+
+	size_t conditionalJumps = 0;
+	size_t stores = 0;
+	util::BreadthFirstSearch<CFG::BasicBlock const*>{{cfg->entry}}.run([&](CFG::BasicBlock const* _block, auto&& _addChild) {
+		for (CFG::Operation const& operation: _block->operations)
+			if (auto const* builtinCall = get_if<CFG::BuiltinCall>(&operation.operation))
+				if (builtinCall->builtin.get().name.str() == "sstore")
+				{
+					// The stored value is the first input, since the first argument is at the stack top.
+					auto const* value = get_if<LiteralSlot>(&operation.input.front());
+					BOOST_REQUIRE(value);
+					BOOST_CHECK_EQUAL(value->value, 1);
+					++stores;
+				}
+		std::visit(util::GenericVisitor{
+			[&](CFG::BasicBlock::Jump const& _jump) { _addChild(_jump.target); },
+			[&](CFG::BasicBlock::ConditionalJump const& _jump) {
+				++conditionalJumps;
+				_addChild(_jump.nonZero);
+				_addChild(_jump.zero);
+			},
+			[](auto const&) {}
+		}, _block->exit);
+	});
+	// Only the condition of the loop is left.
+	BOOST_CHECK_EQUAL(conditionalJumps, 1);
+	BOOST_CHECK_EQUAL(stores, 3);
+}
+
+BOOST_AUTO_TEST_CASE(code_generation)
+{
+	OptimiserSettings settings = OptimiserSettings::minimal();
+	settings.optimizeStackAllocation = true;
+	settings.stackLayoutEffort = 1;
+	AssemblyStack stack(
+		solidity::test::CommonOptions::get().evmVersion(),
+		AssemblyStack::Language::StrictAssembly,
+		settings,
+		DebugInfoSelection::All()
+	);
+	BOOST_REQUIRE(stack.parseAndAnalyze("", source));
+	MachineAssemblyObject object = stack.assemble(AssemblyStack::Machine::EVM);
+	BOOST_REQUIRE(object.bytecode);
+	BOOST_CHECK(!object.bytecode->bytecode.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
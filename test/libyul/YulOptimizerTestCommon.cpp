@@ -40,7 +40,11 @@
 #include <libyul/optimiser/ForLoopInitRewriter.h>
 #include <libyul/optimiser/LoadResolver.h>
 #include <libyul/optimiser/LoopInvariantCodeMotion.h>
+#include <libyul/optimiser/LoopUnroller.h>
 #include <libyul/optimiser/MainFunction.h>
+#include <libyul/optimiser/OverwrittenStoreEliminator.h>
+#include <libyul/optimiser/PureCallEvaluator.h>
+#include <libyul/optimiser/RangeSimplifier.h>
 #include <libyul/optimiser/StackLimitEvader.h>
 #include <libyul/optimiser/NameDisplacer.h>
 #include <libyul/optimiser/Rematerialiser.h>
@@ -243,6 +247,21 @@ YulOptimizerTestCommon::YulOptimizerTestCommon(
 			ForLoopInitRewriter::run(*m_context, *m_ast);
 			EqualStoreEliminator::run(*m_context, *m_ast);
 		}},
+		{"overwrittenStoreEliminator", [&]() {
+			disambiguate();
+			FunctionHoister::run(*m_context, *m_ast);
+			ForLoopInitRewriter::run(*m_context, *m_ast);
+			OverwrittenStoreEliminator::run(*m_context, *m_ast);
+		}},
+		{"pureCallEvaluator", [&]() {
+			disambiguate();
+			PureCallEvaluator::run(*m_context, *m_ast);
+		}},
+		{"rangeSimplifier", [&]() {
+			disambiguate();
+			ForLoopInitRewriter::run(*m_context, *m_ast);
+			RangeSimplifier::run(*m_context, *m_ast);
+		}},
 		{"ssaPlusCleanup", [&]() {
 			disambiguate();
 			ForLoopInitRewriter::run(*m_context, *m_ast);
@@ -269,6 +288,11 @@ YulOptimizerTestCommon::YulOptimizerTestCommon(
 			FunctionHoister::run(*m_context, *m_ast);
 			LoopInvariantCodeMotion::run(*m_context, *m_ast);
 		}},
+		{"loopUnroller", [&]() {
+			disambiguate();
+			ForLoopInitRewriter::run(*m_context, *m_ast);
+			LoopUnroller::run(*m_context, *m_ast);
+		}},
 		{"controlFlowSimplifier", [&]() {
 			disambiguate();
 			ForLoopInitRewriter::run(*m_context, *m_ast);
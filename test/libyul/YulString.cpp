@@ -0,0 +1,79 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the YulString repository.
+ */
+
+#include <libyul/YulString.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <thread>
+
+using namespace std;
+
+namespace solidity::yul::test
+{
+
+BOOST_AUTO_TEST_SUITE(YulStringTest)
+
+BOOST_AUTO_TEST_CASE(empty)
+{
+	BOOST_CHECK(YulString().empty());
+	BOOST_CHECK(YulString("").empty());
+	BOOST_CHECK(YulString() == YulString(""));
+	BOOST_CHECK(YulString("").str().empty());
+	BOOST_CHECK(!YulString("x").empty());
+}
+
+BOOST_AUTO_TEST_CASE(identity)
+{
+	YulString a("yul_string_test_identity");
+	YulString b(string("yul_string_test_") + "identity");
+	BOOST_CHECK(a == b);
+	BOOST_CHECK(a != YulString("yul_string_test_other"));
+	BOOST_CHECK_EQUAL(a.str(), "yul_string_test_identity");
+	BOOST_CHECK_EQUAL(a.hash(), YulStringRepository::hash("yul_string_test_identity"));
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_insertion)
+{
+	size_t const threadCount = 4;
+	size_t const stringCount = 2000;
+	vector<vector<YulString>> results(threadCount);
+	vector<thread> threads;
+	for (size_t t = 0; t < threadCount; ++t)
+		threads.emplace_back([&, t]() {
+			for (size_t i = 0; i < stringCount; ++i)
+				results[t].emplace_back("yul_string_test_" + to_string((i * (t + 1)) % stringCount));
+		});
+	for (thread& t: threads)
+		t.join();
+
+	for (size_t t = 0; t < threadCount; ++t)
+		for (size_t i = 0; i < stringCount; ++i)
+		{
+			string expectation = "yul_string_test_" + to_string((i * (t + 1)) % stringCount);
+			BOOST_REQUIRE_EQUAL(results[t][i].str(), expectation);
+			BOOST_REQUIRE(results[t][i] == YulString(expectation));
+		}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
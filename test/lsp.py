@@ -6,6 +6,7 @@ import json
 import os
 import subprocess
 import sys
+import tempfile
 import traceback
 
 from typing import Any, List, Optional, Tuple, Union
@@ -223,7 +224,7 @@ class SolidityLSPTestSuite: # {{{
 
         return min(max(self.test_counter.failed, self.assertion_counter.failed), 127)
 
-    def setup_lsp(self, lsp: JsonRpcProcess, expose_project_root=True):
+    def setup_lsp(self, lsp: JsonRpcProcess, expose_project_root=True, initialization_options=None):
         """
         Prepares the solc LSP server by calling `initialize`,
         and `initialized` methods.
@@ -232,7 +233,7 @@ class SolidityLSPTestSuite: # {{{
             'processId': None,
             'rootUri': self.project_root_uri,
             'trace': 'off',
-            'initializationOptions': {},
+            'initializationOptions': initialization_options or {},
             'capabilities': {
                 'textDocument': {
                     'publishDiagnostics': {'relatedInformation': True}
@@ -439,7 +440,8 @@ class SolidityLSPTestSuite: # {{{
     def test_didChange_in_A_causing_error_in_B(self, solc: JsonRpcProcess) -> None:
         # Reusing another test but now change some file that generates an error in the other.
         self.test_textDocument_didOpen_with_relative_import(solc)
-        self.open_file_and_wait_for_diagnostics(solc, 'lib', 2)
+        # The diagnostics of the importing file did not change, so only the opened file gets a report.
+        self.open_file_and_wait_for_diagnostics(solc, 'lib', 1)
         solc.send_message(
             'textDocument/didChange',
             {
@@ -499,6 +501,90 @@ class SolidityLSPTestSuite: # {{{
         self.expect_equal(len(report['diagnostics']), 1, "one diagnostic")
         self.expect_diagnostic(report['diagnostics'][0], code=2072, lineNo=12, startEndColumns=(8, 19))
 
+    def test_textDocument_definition_and_references(self, solc: JsonRpcProcess) -> None:
+        self.setup_lsp(solc)
+        TEST_NAME = 'didOpen_with_import'
+        FILE_URI = self.get_test_file_uri(TEST_NAME)
+        self.open_file_and_wait_for_diagnostics(solc, TEST_NAME, 2)
+
+        def location(uri, line, start_column, end_column):
+            return {
+                'uri': uri,
+                'range': {
+                    'start': {'line': line, 'character': start_column},
+                    'end': {'line': line, 'character': end_column}
+                }
+            }
+
+        # `add` in `return Lib.add(2 * a, b);`
+        position = {'textDocument': {'uri': FILE_URI}, 'position': {'line': 9, 'character': 20}}
+        reply = solc.call_method('textDocument/definition', position)
+        self.expect_equal(reply['result'], location(self.get_test_file_uri('lib'), 5, 13, 16), "definition of Lib.add")
+
+        reply = solc.call_method('textDocument/references', {**position, 'context': {'includeDeclaration': True}})
+        self.expect_equal(
+            reply['result'],
+            [location(self.get_test_file_uri('lib'), 5, 13, 16), location(FILE_URI, 9, 19, 22)],
+            "references of Lib.add"
+        )
+
+        # The parameter `a` in `2 * a`.
+        reply = solc.call_method(
+            'textDocument/definition',
+            {'textDocument': {'uri': FILE_URI}, 'position': {'line': 9, 'character': 27}}
+        )
+        self.expect_equal(reply['result'], location(FILE_URI, 7, 20, 21), "definition of a")
+
+        reply = solc.call_method('workspace/symbol', {'query': 'add'})
+        self.expect_equal(
+            reply['result'],
+            [{
+                'name': 'add',
+                'kind': 6,
+                'containerName': 'Lib',
+                'location': location(self.get_test_file_uri('lib'), 5, 13, 16)
+            }],
+            "workspace symbols matching add"
+        )
+
+    def test_diagnostics_cache(self, solc: JsonRpcProcess) -> None:
+        TEST_NAME = 'didOpen_with_import'
+        with tempfile.TemporaryDirectory() as cache_dir:
+            self.setup_lsp(solc, initialization_options={'diagnosticsCache': cache_dir})
+            reports = self.open_file_and_wait_for_diagnostics(solc, TEST_NAME, 2)
+            self.expect_equal(len(reports), 2, "two reports")
+            solc.send_message('shutdown', None)
+            solc.send_notification('exit')
+            solc.process.wait(timeout=5.0)
+
+            # The diagnostics of the opened file are published before anything is compiled.
+            # Since they do not change, only the ones of the imported file follow.
+            with JsonRpcProcess(self.solc_path, ["--lsp"], trace_io=self.trace_io) as second_solc:
+                self.setup_lsp(second_solc, initialization_options={'diagnosticsCache': cache_dir})
+                cached_reports = self.open_file_and_wait_for_diagnostics(second_solc, TEST_NAME, 2)
+                self.expect_equal(cached_reports, reports, "same reports as without the cache")
+
+    def test_solidity_stats(self, solc: JsonRpcProcess) -> None:
+        self.setup_lsp(solc)
+        self.open_file_and_wait_for_diagnostics(solc, 'didOpen_with_import', 2)
+
+        reply = solc.call_method('$/solidity/stats', None)
+        stats = reply['result']
+        self.expect_equal(stats['messages']['textDocument/didOpen']['count'], 1, "one didOpen handled")
+        self.expect_equal(
+            sum(bucket['count'] for bucket in stats['messages']['textDocument/didOpen']['buckets']),
+            1,
+            "didOpen in one bucket"
+        )
+        self.expect_equal(stats['compilations']['duration']['count'], 1, "one compilation")
+        self.expect_equal(stats['compilations']['discarded'], 0, "no discarded compilation")
+        self.expect_equal(stats['cancelledRequests'], 0, "no cancelled request")
+        self.expect_equal(
+            [phase['name'] for phase in stats['phases']],
+            ['language server compilation', 'language server syntax check'],
+            "phases of the language server"
+        )
+
     def test_textDocument_didChange_updates_diagnostics(self, solc: JsonRpcProcess) -> None:
         self.setup_lsp(solc)
         TEST_NAME = 'publish_diagnostics_1'
@@ -541,7 +627,7 @@ class SolidityLSPTestSuite: # {{{
     def test_textDocument_didChange_delete_line_and_close(self, solc: JsonRpcProcess) -> None:
         # Reuse this test to prepare and ensure it is as expected
         self.test_textDocument_didOpen_with_relative_import(solc)
-        self.open_file_and_wait_for_diagnostics(solc, 'lib', 2)
+        self.open_file_and_wait_for_diagnostics(solc, 'lib', 1)
         # lib.sol: Fix the unused variable message by removing it.
         solc.send_message(
             'textDocument/didChange',
@@ -563,14 +649,12 @@ class SolidityLSPTestSuite: # {{{
                 ]
             }
         )
-        published_diagnostics = self.wait_for_diagnostics(solc, 2)
-        self.expect_equal(len(published_diagnostics), 2, "published diagnostics count")
-        report1 = published_diagnostics[0]
-        self.expect_equal(report1['uri'], self.get_test_file_uri('didOpen_with_import'), "Correct file URI")
-        self.expect_equal(len(report1['diagnostics']), 0, "no diagnostics in didOpen_with_import.sol")
-        report2 = published_diagnostics[1]
-        self.expect_equal(report2['uri'], self.get_test_file_uri('lib'), "Correct file URI")
-        self.expect_equal(len(report2['diagnostics']), 0, "no diagnostics in lib.sol")
+        # didOpen_with_import.sol still has no diagnostics, so it is not reported again.
+        published_diagnostics = self.wait_for_diagnostics(solc, 1)
+        self.expect_equal(len(published_diagnostics), 1, "published diagnostics count")
+        report = published_diagnostics[0]
+        self.expect_equal(report['uri'], self.get_test_file_uri('lib'), "Correct file URI")
+        self.expect_equal(len(report['diagnostics']), 0, "no diagnostics in lib.sol")
 
         # Now close the file and expect the warning to re-appear
         solc.send_message(
@@ -578,8 +662,12 @@ class SolidityLSPTestSuite: # {{{
             { 'textDocument': { 'uri': self.get_test_file_uri('lib') }}
         )
 
-        published_diagnostics = self.wait_for_diagnostics(solc, 2)
-        self.verify_didOpen_with_import_diagnostics(published_diagnostics)
+        published_diagnostics = self.wait_for_diagnostics(solc, 1)
+        self.expect_equal(len(published_diagnostics), 1, "published diagnostics count")
+        report = published_diagnostics[0]
+        self.expect_equal(report['uri'], self.get_test_file_uri('lib'), "Correct file URI")
+        self.expect_equal(len(report['diagnostics']), 1, "one diagnostic")
+        self.expect_diagnostic(report['diagnostics'][0], code=2072, lineNo=12, startEndColumns=(8, 19))
 
     def test_textDocument_opening_two_new_files_edit_and_close(self, solc: JsonRpcProcess) -> None:
         """
@@ -616,10 +704,11 @@ class SolidityLSPTestSuite: # {{{
                 ])
             }
         })
-        reports = self.wait_for_diagnostics(solc, 2)
-        self.expect_equal(len(reports), 2, "one publish diagnostics notification")
+        # a.sol was not changed and still has no diagnostics, so it is not reported again.
+        reports = self.wait_for_diagnostics(solc, 1)
+        self.expect_equal(len(reports), 1, "one publish diagnostics notification")
+        self.expect_equal(reports[0]['uri'], FILE_B_URI, "Correct uri")
         self.expect_equal(len(reports[0]['diagnostics']), 0, "should not contain diagnostics")
-        self.expect_equal(len(reports[1]['diagnostics']), 0, "should not contain diagnostics")
 
         solc.send_message('textDocument/didChange', {
             'textDocument': {
@@ -635,10 +724,10 @@ class SolidityLSPTestSuite: # {{{
                 }
             ]
         })
-        reports = self.wait_for_diagnostics(solc, 2)
-        self.expect_equal(len(reports), 2, "one publish diagnostics notification")
+        reports = self.wait_for_diagnostics(solc, 1)
+        self.expect_equal(len(reports), 1, "one publish diagnostics notification")
+        self.expect_equal(reports[0]['uri'], FILE_A_URI, "Correct uri")
         self.expect_equal(len(reports[0]['diagnostics']), 0, "should not contain diagnostics")
-        self.expect_equal(len(reports[1]['diagnostics']), 0, "should not contain diagnostics")
 
         solc.send_message(
             'textDocument/didClose',
@@ -744,6 +833,58 @@ class SolidityLSPTestSuite: # {{{
         self.expect_equal(len(report3['diagnostics']), 1, "one diagnostic")
         self.expect_diagnostic(report3['diagnostics'][0], 4126, 6, (1, 23))
 
+    def test_textDocument_didChange_burst(self, solc: JsonRpcProcess) -> None:
+        """
+        Sends two changes right after each other and expects
+        only the diagnostics of the sources after the second one.
+        """
+        self.setup_lsp(solc)
+        FILE_NAME = 'didChange_template'
+        FILE_URI = self.get_test_file_uri(FILE_NAME)
+        solc.send_message('textDocument/didOpen', {
+            'textDocument': {
+                'uri': FILE_URI,
+                'languageId': 'Solidity',
+                'version': 1,
+                'text': self.get_test_file_contents(FILE_NAME)
+            }
+        })
+        published_diagnostics = self.wait_for_diagnostics(solc, 1)
+        self.expect_equal(len(published_diagnostics), 1, "one publish diagnostics notification")
+        self.expect_equal(len(published_diagnostics[0]['diagnostics']), 0, "no diagnostics")
+
+        solc.send_message('textDocument/didChange', {
+            'textDocument': { 'uri': FILE_URI },
+            'contentChanges': [
+                {
+                    'range': {
+                        'start': { 'line': 6, 'character': 0 },
+                        'end': { 'line': 6, 'character': 0 }
+                    },
+                    'text': " f"
+                }
+            ]
+        })
+        solc.send_message('textDocument/didChange', {
+            'textDocument': { 'uri': FILE_URI },
+            'contentChanges': [
+                {
+                    'range': {
+                        'start': { 'line': 6, 'character': 2 },
+                        'end': { 'line': 6, 'character': 2 }
+                    },
+                    'text': 'unction f() public {}'
+                }
+            ]
+        })
+        # The first change alone would cause error 7858.
+        published_diagnostics = self.wait_for_diagnostics(solc, 1)
+        self.expect_equal(len(published_diagnostics), 1, "one publish diagnostics notification")
+        report = published_diagnostics[0]
+        self.expect_equal(report['uri'], FILE_URI, "Correct file URI")
+        self.expect_equal(len(report['diagnostics']), 1, "one diagnostic")
+        self.expect_diagnostic(report['diagnostics'][0], 4126, 6, (1, 23))
+
     def test_textDocument_didChange_empty_file(self, solc: JsonRpcProcess) -> None:
         """
         Starts with an empty file and changes it to look like
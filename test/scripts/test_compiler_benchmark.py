@@ -0,0 +1,63 @@
+#!/usr/bin/env python
+
+import unittest
+
+# NOTE: This test file file only works with scripts/ added to PYTHONPATH so pylint can't find the imports
+# pragma pylint: disable=import-error
+from compiler_benchmark import combine_runs, compare_with_baseline, flatten_phases, regressions
+# pragma pylint: enable=import-error
+
+
+def measurement(wall_time, cpu_time, peak_memory):
+    return {'wallTime': wall_time, 'cpuTime': cpu_time, 'peakMemory': peak_memory}
+
+
+class TestFlattenPhases(unittest.TestCase):
+    def test_nested_phases(self):
+        profile_phases = [
+            {
+                'name': 'analysis',
+                'count': 1,
+                **measurement(100, 90, 2000),
+                'phases': [{'name': 'type checking', 'count': 1, **measurement(40, 40, 1500)}],
+            },
+            {'name': 'parsing', 'count': 3, **measurement(10, 30, 1000), 'phases': []},
+        ]
+        self.assertEqual(flatten_phases(profile_phases), {
+            'analysis': measurement(100, 90, 2000),
+            'analysis/type checking': measurement(40, 40, 1500),
+            'parsing': measurement(10, 30, 1000),
+        })
+
+
+class TestCombineRuns(unittest.TestCase):
+    def test_median(self):
+        runs = [
+            {'wallTime': 30, 'peakMemory': 100, 'phases': {'parsing': measurement(3, 3, 10), 'analysis': measurement(1, 1, 1)}},
+            {'wallTime': 10, 'peakMemory': 120, 'phases': {'parsing': measurement(1, 2, 12)}},
+            {'wallTime': 20, 'peakMemory': 110, 'phases': {'parsing': measurement(2, 1, 11)}},
+        ]
+        self.assertEqual(combine_runs(runs), {'wallTime': 20, 'peakMemory': 110, 'phases': {'parsing': measurement(2, 2, 11)}})
+
+
+class TestCompareWithBaseline(unittest.TestCase):
+    def test_ratios(self):
+        results = {
+            'p/legacy': {'wallTime': 150, 'peakMemory': 100, 'phases': {'parsing': measurement(20, 10, 50), 'new': measurement(1, 1, 1)}},
+            'p/via-ir': {'wallTime': 10, 'peakMemory': 10, 'phases': {}},
+        }
+        baseline = {'p/legacy': {'wallTime': 100, 'peakMemory': 100, 'phases': {'parsing': measurement(10, 10, 0)}}}
+
+        report = compare_with_baseline(results, baseline)
+        self.assertEqual(report['p/legacy']['relative'], {'wallTime': 1.5, 'peakMemory': 1.0})
+        self.assertEqual(report['p/legacy']['phases']['parsing']['relative'], {'wallTime': 2.0, 'cpuTime': 1.0})
+        self.assertNotIn('relative', report['p/legacy']['phases']['new'])
+        self.assertNotIn('relative', report['p/via-ir'])
+        self.assertNotIn('relative', results['p/legacy'])
+
+        self.assertEqual(regressions(report, 0.2), ['p/legacy'])
+        self.assertEqual(regressions(report, 0.5), [])
+
+
+if __name__ == '__main__':
+    unittest.main()
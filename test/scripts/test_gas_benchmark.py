@@ -0,0 +1,62 @@
+#!/usr/bin/env python
+
+import json
+import unittest
+from pathlib import Path
+from tempfile import TemporaryDirectory
+
+# NOTE: This test file file only works with scripts/ added to PYTHONPATH so pylint can't find the imports
+# pragma pylint: disable=import-error
+from gas_benchmark import load_gas_report, summarize
+# pragma pylint: enable=import-error
+
+
+class TestLoadGasReport(unittest.TestCase):
+    def test_relative_test_names(self):
+        with TemporaryDirectory() as directory:
+            report_file = Path(directory) / 'report.jsonl'
+            lines = [
+                {'test': '/t/libsolidity/semanticTests/a.sol', 'pipeline': 'ir', 'call': 0, 'signature': 'constructor', 'kind': 'deployment', 'gas': 100},
+                {'test': '/t/libsolidity/semanticTests/a.sol', 'pipeline': 'ir', 'call': 1, 'signature': 'f()', 'kind': 'runtime', 'gas': 20},
+            ]
+            report_file.write_text(''.join(json.dumps(line) + '\n' for line in lines) + '\n', encoding='utf-8')
+
+            self.assertEqual(load_gas_report(report_file, Path('/t')), {
+                ('libsolidity/semanticTests/a.sol', 'ir', 0, 'deployment'): 100,
+                ('libsolidity/semanticTests/a.sol', 'ir', 1, 'runtime'): 20,
+            })
+
+
+class TestSummarize(unittest.TestCase):
+    def test_totals_and_differences(self):
+        measurements = {
+            'unoptimized': {
+                ('a.sol', 'legacy', 0, 'deployment'): 1000,
+                ('a.sol', 'legacy', 1, 'runtime'): 50,
+                ('a.sol', 'legacy', 2, 'runtime'): 60,
+                ('b.sol', 'ir', 0, 'deployment'): 500,
+                ('c.sol', 'ir', 0, 'deployment'): 7,
+            },
+            'optimized': {
+                ('a.sol', 'legacy', 0, 'deployment'): 800,
+                ('a.sol', 'legacy', 1, 'runtime'): 40,
+                ('a.sol', 'legacy', 2, 'runtime'): 60,
+                ('b.sol', 'ir', 0, 'deployment'): 500,
+            },
+        }
+
+        report = summarize(measurements, 'unoptimized', 10)
+        self.assertEqual(report['transactions'], 4)
+        self.assertEqual(report['totals'], {
+            'unoptimized': {'legacy': {'deployment': 1000, 'runtime': 110}, 'ir': {'deployment': 500, 'runtime': 0}},
+            'optimized': {'legacy': {'deployment': 800, 'runtime': 100}, 'ir': {'deployment': 500, 'runtime': 0}},
+        })
+        self.assertEqual(report['differences'], {'optimized': [
+            {'test': 'a.sol', 'pipeline': 'legacy', 'kind': 'deployment', 'gas': 800, 'referenceGas': 1000, 'difference': -200},
+            {'test': 'a.sol', 'pipeline': 'legacy', 'kind': 'runtime', 'gas': 100, 'referenceGas': 110, 'difference': -10},
+        ]})
+        self.assertEqual(len(summarize(measurements, 'unoptimized', 1)['differences']['optimized']), 1)
+
+
+if __name__ == '__main__':
+    unittest.main()
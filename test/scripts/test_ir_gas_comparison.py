@@ -0,0 +1,76 @@
+#!/usr/bin/env python
+
+import json
+import unittest
+from pathlib import Path
+from tempfile import TemporaryDirectory
+
+# NOTE: This test file file only works with scripts/ added to PYTHONPATH so pylint can't find the imports
+# pragma pylint: disable=import-error
+from ir_gas_comparison import compare, format_table, load_gas_report, totals
+# pragma pylint: enable=import-error
+
+
+def measurement(pipeline, call, signature, kind, gas, code_size=None):
+    line = {'test': '/t/trace/a.sol', 'pipeline': pipeline, 'call': call, 'signature': signature, 'kind': kind, 'gas': gas}
+    if code_size is not None:
+        line['codeSize'] = code_size
+    return line
+
+
+class TestLoadGasReport(unittest.TestCase):
+    def test_by_pipeline(self):
+        with TemporaryDirectory() as directory:
+            report_file = Path(directory) / 'report.jsonl'
+            lines = [
+                measurement('legacy', 0, 'constructor', 'deployment', 100, 20),
+                measurement('ir', 1, 'f()', 'runtime', 20),
+            ]
+            report_file.write_text(''.join(json.dumps(line) + '\n' for line in lines) + '\n', encoding='utf-8')
+
+            self.assertEqual(load_gas_report(report_file, Path('/t/trace')), {
+                'legacy': {('a.sol', 0, 'deployment'): lines[0]},
+                'ir': {('a.sol', 1, 'runtime'): lines[1]},
+            })
+
+
+class TestCompare(unittest.TestCase):
+    def test_functions_and_deployments(self):
+        legacy = {
+            ('a.sol', 0, 'deployment'): measurement('legacy', 0, 'constructor', 'deployment', 1000, 300),
+            ('a.sol', 1, 'runtime'): measurement('legacy', 1, 'f()', 'runtime', 50),
+            ('a.sol', 2, 'runtime'): measurement('legacy', 2, 'f()', 'runtime', 60),
+            ('a.sol', 3, 'runtime'): measurement('legacy', 3, 'g()', 'runtime', 70),
+        }
+        ir = {
+            ('a.sol', 0, 'deployment'): measurement('ir', 0, 'constructor', 'deployment', 900, 250),
+            ('a.sol', 1, 'runtime'): measurement('ir', 1, 'f()', 'runtime', 40),
+            ('a.sol', 2, 'runtime'): measurement('ir', 2, 'f()', 'runtime', 45),
+        }
+
+        rows = compare(legacy, ir)
+        self.assertEqual(rows, [
+            {
+                'test': 'a.sol', 'kind': 'deployment', 'signature': 'constructor', 'calls': 1,
+                'legacyGas': 1000, 'irGas': 900, 'gasDifference': -100,
+                'legacyCodeSize': 300, 'irCodeSize': 250, 'codeSizeDifference': -50,
+            },
+            {
+                'test': 'a.sol', 'kind': 'runtime', 'signature': 'f()', 'calls': 2,
+                'legacyGas': 110, 'irGas': 85, 'gasDifference': -25,
+            },
+        ])
+        self.assertEqual(totals(rows), {
+            'deployment': {'legacyGas': 1000, 'irGas': 900},
+            'runtime': {'legacyGas': 110, 'irGas': 85},
+        })
+
+        table = format_table(rows).splitlines()
+        self.assertEqual(len(table), 5)
+        self.assertEqual(table[1].split(), ['a.sol', 'deploy', 'constructor', '1', '1000', '900', '-100', '-10.0%', '300', '250', '-50'])
+        self.assertEqual(table[2].split(), ['a.sol', 'f()', '2', '110', '85', '-25', '-22.7%'])
+        self.assertEqual(table[4].split(), ['Total', '(runtime)', '110', '85', '-25', '-22.7%'])
+
+
+if __name__ == '__main__':
+    unittest.main()
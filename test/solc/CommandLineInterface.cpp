@@ -1323,6 +1323,29 @@ BOOST_AUTO_TEST_CASE(cli_include_paths_ambiguous_import)
 	BOOST_REQUIRE(!result.success);
 }
 
+BOOST_AUTO_TEST_CASE(cli_import_ast_from_cbor)
+{
+	TemporaryDirectory tempDir(TEST_CASE_NAME);
+	createFileWithContent(
+		tempDir.path() / "contract.sol",
+		"// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\ncontract C { function f() public pure returns (uint) { return 42; } }\n"
+	);
+
+	OptionsReaderAndMessages exported = runCLI({"solc", "--combined-json", "ast", (tempDir.path() / "contract.sol").string()});
+	BOOST_REQUIRE(exported.success);
+	Json::Value exportedJson;
+	BOOST_REQUIRE(util::jsonParseStrict(exported.stdoutContent, exportedJson));
+
+	createFileWithContent(tempDir.path() / "ast.json", util::jsonCompactPrint(exportedJson));
+	createFileWithContent(tempDir.path() / "ast.cbor", util::jsonToCBOR(exportedJson));
+	OptionsReaderAndMessages fromJson = runCLI({"solc", "--import-ast", "--bin", (tempDir.path() / "ast.json").string()});
+	OptionsReaderAndMessages fromCBOR = runCLI({"solc", "--import-ast", "--bin", (tempDir.path() / "ast.cbor").string()});
+	BOOST_REQUIRE(fromJson.success);
+	BOOST_REQUIRE(fromCBOR.success);
+	BOOST_TEST(fromCBOR.stdoutContent.find("Binary:") != string::npos);
+	BOOST_TEST(fromCBOR.stdoutContent == fromJson.stdoutContent);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace solidity::frontend::test
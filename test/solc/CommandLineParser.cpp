@@ -121,6 +121,9 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			"--overwrite",
 			"--evm-version=spuriousDragon",
 			"--experimental-via-ir",
+			"--jobs=4",
+			"--cache-dir=/tmp/cache",
+			"--profile",
 			"--revert-strings=strip",
 			"--debug-info=location",
 			"--pretty-json",
@@ -141,14 +144,20 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			"--optimize",
 			"--optimize-runs=1000",
 			"--yul-optimizations=agf",
+			"--yul-optimizer-step-budget=100",
+			"--optimize-autotune=3",
+			"--optimize-select-steps",
 			"--model-checker-contracts=contract1.yul:A,contract2.yul:B",
 			"--model-checker-div-mod-no-slacks",
 			"--model-checker-engine=bmc",
+			"--model-checker-hide-counterexamples",
 			"--model-checker-invariants=contract,reentrancy",
 			"--model-checker-show-unproved",
+			"--model-checker-smtlib2-command=z3 -in",
 			"--model-checker-solvers=z3,smtlib2",
 			"--model-checker-targets=underflow,divByZero",
 			"--model-checker-timeout=5",
+			"--model-checker-total-timeout=60000",
 		};
 
 		if (inputMode == InputMode::CompilerWithASTImport)
@@ -176,6 +185,9 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 		expectedOptions.output.overwriteFiles = true;
 		expectedOptions.output.evmVersion = EVMVersion::spuriousDragon();
 		expectedOptions.output.experimentalViaIR = true;
+		expectedOptions.output.jobs = 4;
+		expectedOptions.output.cacheDir = "/tmp/cache";
+		expectedOptions.output.profile = true;
 		expectedOptions.output.revertStrings = RevertStrings::Strip;
 		expectedOptions.output.debugInfoSelection = DebugInfoSelection::fromString("location");
 		expectedOptions.formatting.json = JsonFormat{JsonFormat::Pretty, 7};
@@ -204,17 +216,24 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 		expectedOptions.optimizer.enabled = true;
 		expectedOptions.optimizer.expectedExecutionsPerDeployment = 1000;
 		expectedOptions.optimizer.yulSteps = "agf";
+		expectedOptions.optimizer.yulStepBudget = 100;
+		expectedOptions.optimizer.autotuneCandidates = 3;
+		expectedOptions.optimizer.selectSteps = true;
 
 		expectedOptions.modelChecker.initialize = true;
 		expectedOptions.modelChecker.settings = {
 			{{{"contract1.yul", {"A"}}, {"contract2.yul", {"B"}}}},
 			true,
 			{true, false},
+			{},
 			{{InvariantType::Contract, InvariantType::Reentrancy}},
+			false,
 			true,
+			"z3 -in",
 			{false, true, true},
 			{{VerificationTargetType::Underflow, VerificationTargetType::DivByZero}},
 			5,
+			60000,
 		};
 
 		CommandLineOptions parsedOptions = parseCommandLine(commandLine);
@@ -410,6 +429,54 @@ BOOST_AUTO_TEST_CASE(standard_json_mode_options)
 	BOOST_TEST(parsedOptions == expectedOptions);
 }
 
+BOOST_AUTO_TEST_CASE(compiler_server_mode_options)
+{
+	vector<string> commandLine = {
+		"solc",
+		"--server",
+		"--base-path=/home/user/",
+		"--include-path=/usr/lib/include/",
+		"--allow-paths=/tmp",
+		"--cache-dir=/tmp/cache",
+	};
+
+	CommandLineOptions expectedOptions;
+	expectedOptions.input.mode = InputMode::CompilerServer;
+	expectedOptions.input.basePath = "/home/user/";
+	expectedOptions.input.includePaths = {"/usr/lib/include/"};
+	expectedOptions.input.allowedDirectories = {"/tmp"};
+	expectedOptions.output.cacheDir = "/tmp/cache";
+
+	BOOST_TEST(parseCommandLine(commandLine) == expectedOptions);
+
+	string expectedMessage =
+		"No input files are accepted for --server.\n"
+		"The sources are given in the Standard JSON input of each request.";
+	auto hasCorrectMessage = [&](CommandLineValidationError const& _exception) { return _exception.what() == expectedMessage; };
+	BOOST_CHECK_EXCEPTION(parseCommandLine({"solc", "--server", "contract.sol"}), CommandLineValidationError, hasCorrectMessage);
+}
+
+BOOST_AUTO_TEST_CASE(linker_mode_options)
+{
+	vector<string> commandLine = {
+		"solc",
+		"--link",
+		"--libraries=dir1/file1.sol:L=0x1234567890123456789012345678901234567890",
+		"--jobs=3",
+		"contract.bin",
+	};
+
+	CommandLineOptions expectedOptions;
+	expectedOptions.input.mode = InputMode::Linker;
+	expectedOptions.input.paths = {"contract.bin"};
+	expectedOptions.linker.libraries = {
+		{"dir1/file1.sol:L", h160("1234567890123456789012345678901234567890")},
+	};
+	expectedOptions.output.jobs = 3;
+
+	BOOST_TEST(parseCommandLine(commandLine) == expectedOptions);
+}
+
 BOOST_AUTO_TEST_CASE(invalid_options_input_modes_combinations)
 {
 	map<string, vector<string>> invalidOptionInputModeCombinations = {
@@ -70,6 +70,12 @@ void IsolTestOptions::addOptions()
 		("help", po::bool_switch(&showHelp)->default_value(showHelp), "Show this help screen.")
 		("no-color", po::bool_switch(&noColor)->default_value(noColor), "Don't use colors.")
 		("accept-updates", po::bool_switch(&acceptUpdates)->default_value(acceptUpdates), "Automatically accept expectation updates.")
+		(
+			"jobs,j",
+			po::value<size_t>(&jobs)->default_value(jobs),
+			"Number of test cases to run at the same time in separate processes. "
+			"The results and prompts are still shown one test case at a time, in order."
+		)
 		("test,t", po::value<std::string>(&testFilter)->default_value("*/*"), "Filters which test units to include.");
 }
 
@@ -98,6 +104,10 @@ void IsolTestOptions::validate() const
 		ConfigException,
 		"Invalid test unit filter - can only contain '" + filterString + ": " + testFilter
 	);
+	assertThrow(jobs > 0, ConfigException, "The number of jobs has to be positive.");
+#if defined(_WIN32)
+	assertThrow(jobs == 1, ConfigException, "Running test cases in parallel is not supported on Windows.");
+#endif
 }
 
 }
@@ -32,6 +32,8 @@ struct IsolTestOptions: CommonOptions
 	bool showHelp = false;
 	bool noColor = false;
 	bool acceptUpdates = false;
+	/// Number of worker processes running test cases at the same time.
+	size_t jobs = 1;
 	std::string testFilter = std::string{};
 	std::string editor = std::string{};
 
@@ -28,14 +28,22 @@
 #include <boost/algorithm/string/replace.hpp>
 #include <boost/filesystem.hpp>
 
+#include <cerrno>
 #include <cstdlib>
 #include <iostream>
+#include <limits>
+#include <map>
 #include <queue>
 #include <regex>
 #include <utility>
 
 #if defined(_WIN32)
 #include <windows.h>
+#else
+#include <poll.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
 #endif
 
 using namespace std;
@@ -113,7 +121,8 @@ public:
 		Skipped
 	};
 
-	Result process();
+	/// Runs the test case if it matches the filter and prints its results to @a _output.
+	Result process(ostream& _output = cout);
 
 	static TestStats processPath(
 		TestCreator _testCaseCreator,
@@ -130,6 +139,15 @@ private:
 		Quit
 	};
 
+	/// Like processPath, but the test cases are run by _options.jobs worker processes.
+	static TestStats processPathInParallel(
+		TestCreator _testCaseCreator,
+		TestOptions const& _options,
+		fs::path const& _basepath,
+		fs::path const& _path,
+		solidity::test::Batcher& _batcher
+	);
+
 	void updateTestCase();
 	Request handleResponse(bool _exception);
 
@@ -146,7 +164,277 @@ private:
 
 bool TestTool::m_exitRequested = false;
 
-TestTool::Result TestTool::process()
+#if !defined(_WIN32)
+
+/**
+ * Runs test cases in forked worker processes and collects their results, so that the calling
+ * process can print them and ask how to handle failures one test case after the other.
+ * The compiler keeps types and other state in globals that are not thread-safe, so the test
+ * cases are run in separate processes rather than threads. Each worker has its own VM instance.
+ * A worker that crashes is replaced and its test case is reported as an exception.
+ */
+class TestWorkers
+{
+public:
+	struct Outcome
+	{
+		TestTool::Result result = TestTool::Result::Exception;
+		string output;
+	};
+
+	/// Starts @a _options.jobs workers and hands @a _tests, given by path and name, out to them.
+	TestWorkers(TestCreator _testCaseCreator, TestOptions const& _options, vector<pair<fs::path, string>> _tests);
+	~TestWorkers();
+
+	TestWorkers(TestWorkers const&) = delete;
+	TestWorkers& operator=(TestWorkers const&) = delete;
+
+	/// Waits for the outcome of the test case with index @a _index in the list of test cases.
+	Outcome outcome(size_t _index);
+
+private:
+	struct Worker
+	{
+		pid_t pid = -1;
+		/// Pipe to send the indices of test cases to the worker.
+		int requests = -1;
+		/// Pipe to read the outcomes of the test cases from the worker.
+		int results = -1;
+		/// The test case the worker is running.
+		optional<size_t> test;
+	};
+
+	static uint64_t constexpr stopRequest = numeric_limits<uint64_t>::max();
+
+	void start(Worker& _worker);
+	void stop(Worker& _worker);
+	/// Sends the next test case to @a _worker, if there is one.
+	void dispatch(Worker& _worker);
+	/// Waits until at least one worker finished its test case and stores the outcomes.
+	void receive();
+	/// The loop of a worker process.
+	[[noreturn]] void serve(int _requests, int _results);
+
+	static bool readAll(int _fd, void* _data, size_t _size);
+	static bool writeAll(int _fd, void const* _data, size_t _size);
+
+	TestCreator m_testCaseCreator;
+	TestOptions const& m_options;
+	vector<pair<fs::path, string>> m_tests;
+	vector<Worker> m_workers;
+	size_t m_nextTest = 0;
+	map<size_t, Outcome> m_outcomes;
+};
+
+TestWorkers::TestWorkers(TestCreator _testCaseCreator, TestOptions const& _options, vector<pair<fs::path, string>> _tests):
+	m_testCaseCreator(_testCaseCreator),
+	m_options(_options),
+	m_tests(move(_tests)),
+	m_workers(min(_options.jobs, m_tests.size()))
+{
+	// Writing to a crashed worker has to fail instead of ending this process.
+	signal(SIGPIPE, SIG_IGN);
+	for (Worker& worker: m_workers)
+		start(worker);
+	for (Worker& worker: m_workers)
+		dispatch(worker);
+}
+
+TestWorkers::~TestWorkers()
+{
+	for (Worker& worker: m_workers)
+		stop(worker);
+}
+
+TestWorkers::Outcome TestWorkers::outcome(size_t _index)
+{
+	solAssert(_index < m_tests.size());
+	while (!m_outcomes.count(_index))
+		receive();
+	Outcome outcome = move(m_outcomes.at(_index));
+	m_outcomes.erase(_index);
+	return outcome;
+}
+
+void TestWorkers::start(Worker& _worker)
+{
+	int requests[2];
+	int results[2];
+	if (pipe(requests) != 0)
+		BOOST_THROW_EXCEPTION(runtime_error("Could not create a pipe for a test worker."));
+	if (pipe(results) != 0)
+	{
+		close(requests[0]);
+		close(requests[1]);
+		BOOST_THROW_EXCEPTION(runtime_error("Could not create a pipe for a test worker."));
+	}
+
+	// Buffered output would be printed by the worker again.
+	cout.flush();
+	cerr.flush();
+	pid_t pid = fork();
+	if (pid < 0)
+		BOOST_THROW_EXCEPTION(runtime_error("Could not start a test worker."));
+	if (pid == 0)
+	{
+		for (Worker const& other: m_workers)
+			if (other.pid > 0)
+			{
+				close(other.requests);
+				close(other.results);
+			}
+		close(requests[1]);
+		close(results[0]);
+		serve(requests[0], results[1]);
+	}
+
+	close(requests[0]);
+	close(results[1]);
+	_worker = Worker{pid, requests[1], results[0], nullopt};
+}
+
+void TestWorkers::stop(Worker& _worker)
+{
+	if (_worker.pid <= 0)
+		return;
+	if (_worker.test)
+		// Do not wait until the worker finishes a test case whose outcome is not needed anymore.
+		kill(_worker.pid, SIGKILL);
+	else
+		writeAll(_worker.requests, &stopRequest, sizeof(stopRequest));
+	close(_worker.requests);
+	close(_worker.results);
+	waitpid(_worker.pid, nullptr, 0);
+	_worker = Worker{};
+}
+
+void TestWorkers::dispatch(Worker& _worker)
+{
+	solAssert(!_worker.test);
+	if (m_nextTest == m_tests.size())
+		return;
+
+	uint64_t const index = m_nextTest++;
+	_worker.test = index;
+	// If the worker crashed, this fails and the test case is reported once its results pipe is closed.
+	writeAll(_worker.requests, &index, sizeof(index));
+}
+
+void TestWorkers::receive()
+{
+	vector<pollfd> descriptors;
+	vector<Worker*> busyWorkers;
+	for (Worker& worker: m_workers)
+		if (worker.test)
+		{
+			descriptors.push_back({worker.results, POLLIN, 0});
+			busyWorkers.push_back(&worker);
+		}
+	solAssert(!descriptors.empty(), "Waiting for a test case that was not started.");
+
+	while (poll(descriptors.data(), descriptors.size(), -1) < 0)
+		if (errno != EINTR)
+			BOOST_THROW_EXCEPTION(runtime_error("Could not wait for the test workers."));
+
+	for (size_t i = 0; i < descriptors.size(); ++i)
+	{
+		if (descriptors[i].revents == 0)
+			continue;
+
+		Worker& worker = *busyWorkers[i];
+		size_t const test = *worker.test;
+		uint64_t index = 0;
+		uint8_t result = 0;
+		uint64_t length = 0;
+		Outcome outcome;
+		bool received =
+			readAll(worker.results, &index, sizeof(index)) &&
+			readAll(worker.results, &result, sizeof(result)) &&
+			readAll(worker.results, &length, sizeof(length)) &&
+			index == test;
+		if (received)
+		{
+			outcome.output.resize(length);
+			received = readAll(worker.results, outcome.output.data(), length);
+		}
+
+		worker.test.reset();
+		if (received)
+			outcome.result = static_cast<TestTool::Result>(result);
+		else
+		{
+			ostringstream output;
+			bool const formatted = !m_options.noColor;
+			AnsiColorized(output, formatted, {BOLD}) << m_tests[test].second << ": ";
+			AnsiColorized(output, formatted, {BOLD, RED}) << "The test worker terminated unexpectedly." << endl;
+			outcome = {TestTool::Result::Exception, output.str()};
+			stop(worker);
+			start(worker);
+		}
+
+		m_outcomes[test] = move(outcome);
+		dispatch(worker);
+	}
+}
+
+void TestWorkers::serve(int _requests, int _results)
+{
+	while (true)
+	{
+		uint64_t index = 0;
+		if (!readAll(_requests, &index, sizeof(index)) || index == stopRequest || index >= m_tests.size())
+			_exit(0);
+
+		ostringstream output;
+		TestTool testTool(m_testCaseCreator, m_options, m_tests[index].first, m_tests[index].second);
+		uint8_t const result = static_cast<uint8_t>(testTool.process(output));
+		string const text = output.str();
+		uint64_t const length = text.size();
+		if (
+			!writeAll(_results, &index, sizeof(index)) ||
+			!writeAll(_results, &result, sizeof(result)) ||
+			!writeAll(_results, &length, sizeof(length)) ||
+			!writeAll(_results, text.data(), text.size())
+		)
+			_exit(1);
+	}
+}
+
+bool TestWorkers::readAll(int _fd, void* _data, size_t _size)
+{
+	auto* data = static_cast<char*>(_data);
+	while (_size > 0)
+	{
+		ssize_t const count = read(_fd, data, _size);
+		if (count < 0 && errno == EINTR)
+			continue;
+		if (count <= 0)
+			return false;
+		data += count;
+		_size -= static_cast<size_t>(count);
+	}
+	return true;
+}
+
+bool TestWorkers::writeAll(int _fd, void const* _data, size_t _size)
+{
+	auto const* data = static_cast<char const*>(_data);
+	while (_size > 0)
+	{
+		ssize_t const count = write(_fd, data, _size);
+		if (count < 0 && errno == EINTR)
+			continue;
+		if (count <= 0)
+			return false;
+		data += count;
+		_size -= static_cast<size_t>(count);
+	}
+	return true;
+}
+
+#endif
+
+TestTool::Result TestTool::process(ostream& _output)
 {
 	bool formatted{!m_options.noColor};
 
@@ -154,7 +442,7 @@ TestTool::Result TestTool::process()
 	{
 		if (m_filter.matches(m_path, m_name))
 		{
-			(AnsiColorized(cout, formatted, {BOLD}) << m_name << ": ").flush();
+			(AnsiColorized(_output, formatted, {BOLD}) << m_name << ": ").flush();
 
 			m_test = m_testCaseCreator(TestCase::Config{
 				m_path.string(),
@@ -171,22 +459,22 @@ TestTool::Result TestTool::process()
 				switch (TestCase::TestResult result = m_test->run(outputMessages, "  ", formatted))
 				{
 					case TestCase::TestResult::Success:
-						AnsiColorized(cout, formatted, {BOLD, GREEN}) << "OK" << endl;
+						AnsiColorized(_output, formatted, {BOLD, GREEN}) << "OK" << endl;
 						return Result::Success;
 					default:
-						AnsiColorized(cout, formatted, {BOLD, RED}) << "FAIL" << endl;
+						AnsiColorized(_output, formatted, {BOLD, RED}) << "FAIL" << endl;
 
-						AnsiColorized(cout, formatted, {BOLD, CYAN}) << "  Contract:" << endl;
-						m_test->printSource(cout, "    ", formatted);
-						m_test->printSettings(cout, "    ", formatted);
+						AnsiColorized(_output, formatted, {BOLD, CYAN}) << "  Contract:" << endl;
+						m_test->printSource(_output, "    ", formatted);
+						m_test->printSettings(_output, "    ", formatted);
 
-						cout << endl << outputMessages.str() << endl;
+						_output << endl << outputMessages.str() << endl;
 						return result == TestCase::TestResult::FatalError ? Result::Exception : Result::Failure;
 				}
 			}
 			else
 			{
-				AnsiColorized(cout, formatted, {BOLD, YELLOW}) << "NOT RUN" << endl;
+				AnsiColorized(_output, formatted, {BOLD, YELLOW}) << "NOT RUN" << endl;
 				return Result::Skipped;
 			}
 		}
@@ -195,19 +483,19 @@ TestTool::Result TestTool::process()
 	}
 	catch (boost::exception const& _e)
 	{
-		AnsiColorized(cout, formatted, {BOLD, RED}) <<
+		AnsiColorized(_output, formatted, {BOLD, RED}) <<
 			"Exception during test: " << boost::diagnostic_information(_e) << endl;
 		return Result::Exception;
 	}
 	catch (std::exception const& _e)
 	{
-		AnsiColorized(cout, formatted, {BOLD, RED}) <<
+		AnsiColorized(_output, formatted, {BOLD, RED}) <<
 			"Exception during test: " << boost::diagnostic_information(_e) << endl;
 		return Result::Exception;
 	}
 	catch (...)
 	{
-		AnsiColorized(cout, formatted, {BOLD, RED}) <<
+		AnsiColorized(_output, formatted, {BOLD, RED}) <<
 			"Unknown exception during test: " << boost::current_exception_diagnostic_information() << endl;
 		return Result::Exception;
 	}
@@ -274,6 +562,11 @@ TestStats TestTool::processPath(
 	solidity::test::Batcher& _batcher
 )
 {
+#if !defined(_WIN32)
+	if (_options.jobs > 1)
+		return processPathInParallel(_testCaseCreator, _options, _basepath, _path, _batcher);
+#endif
+
 	std::queue<fs::path> paths;
 	paths.push(_path);
 	int successCount = 0;
@@ -352,6 +645,113 @@ TestStats TestTool::processPath(
 
 }
 
+#if !defined(_WIN32)
+
+TestStats TestTool::processPathInParallel(
+	TestCreator _testCaseCreator,
+	TestOptions const& _options,
+	fs::path const& _basepath,
+	fs::path const& _path,
+	solidity::test::Batcher& _batcher
+)
+{
+	// For the test files in the order in which processPath visits them, the index in the list
+	// of test cases run by the workers, if they are in the selected batch.
+	vector<optional<size_t>> files;
+	vector<pair<fs::path, string>> tests;
+	std::queue<fs::path> paths;
+	paths.push(_path);
+	while (!paths.empty())
+	{
+		fs::path currentPath = paths.front();
+		paths.pop();
+
+		fs::path fullpath = _basepath / currentPath;
+		if (fs::is_directory(fullpath))
+		{
+			for (auto const& entry: boost::iterator_range<fs::directory_iterator>(
+				fs::directory_iterator(fullpath),
+				fs::directory_iterator()
+			))
+				if (fs::is_directory(entry.path()) || TestCase::isTestFilename(entry.path().filename()))
+					paths.push(currentPath / entry.path().filename());
+		}
+		else if (!m_exitRequested && _batcher.checkAndAdvance())
+		{
+			files.emplace_back(tests.size());
+			tests.emplace_back(fullpath, currentPath.generic_path().string());
+		}
+		else
+			files.emplace_back(nullopt);
+	}
+
+	int successCount = 0;
+	int testCount = 0;
+	int skippedCount = 0;
+
+	optional<TestWorkers> workers;
+	if (!tests.empty())
+		workers.emplace(_testCaseCreator, _options, tests);
+
+	for (optional<size_t> const& testIndex: files)
+	{
+		if (m_exitRequested)
+		{
+			++testCount;
+			continue;
+		}
+		if (!testIndex)
+		{
+			++skippedCount;
+			continue;
+		}
+
+		++testCount;
+		TestWorkers::Outcome outcome = workers->outcome(*testIndex);
+		cout << outcome.output;
+		cout.flush();
+
+		Result result = outcome.result;
+		TestTool testTool(_testCaseCreator, _options, tests[*testIndex].first, tests[*testIndex].second);
+		if (result == Result::Failure || result == Result::Exception)
+		{
+			// Run the test case again in this process without printing its results a second
+			// time, so that its expectations can be updated.
+			ostringstream ignoredOutput;
+			result = testTool.process(ignoredOutput);
+		}
+
+		bool handled = false;
+		while (!handled && (result == Result::Failure || result == Result::Exception))
+			switch (testTool.handleResponse(result == Result::Exception))
+			{
+			case Request::Quit:
+				m_exitRequested = true;
+				handled = true;
+				break;
+			case Request::Rerun:
+				cout << "Re-running test case..." << endl;
+				result = testTool.process();
+				break;
+			case Request::Skip:
+				++skippedCount;
+				handled = true;
+				break;
+			}
+
+		if (handled)
+			continue;
+		if (result == Result::Success)
+			++successCount;
+		else
+			++skippedCount;
+	}
+
+	return { successCount, testCount, skippedCount };
+}
+
+#endif
+
 namespace
 {
 
@@ -32,6 +32,12 @@ using namespace std;
 
 optional<CompilerOutput> SolidityCompilationFramework::compileContract()
 {
+	// All contracts of the sources are compiled at once, so a contract that is requested
+	// after another one, e.g. after the library it uses was deployed, only has to be linked.
+	if (m_compiler.state() == CompilerStack::State::CompilationSuccessful)
+		return contractOutput();
+
+	m_compiler.reset();
 	m_compiler.setSources(m_compilerInput.sourceCode);
 	m_compiler.setLibraries(m_compilerInput.libraryAddresses);
 	m_compiler.setEVMVersion(m_compilerInput.evmVersion);
@@ -51,16 +57,20 @@ optional<CompilerOutput> SolidityCompilationFramework::compileContract()
 		return {};
 	}
 	else
-	{
-		string contractName;
-		if (m_compilerInput.contractName.empty())
-			contractName = m_compiler.lastContractName();
-		else
-			contractName = m_compilerInput.contractName;
-		evmasm::LinkerObject obj = m_compiler.object(contractName);
-		Json::Value methodIdentifiers = m_compiler.methodIdentifiers(contractName);
-		return CompilerOutput{obj.bytecode, methodIdentifiers};
-	}
+		return contractOutput();
+}
+
+CompilerOutput SolidityCompilationFramework::contractOutput()
+{
+	string contractName;
+	if (m_compilerInput.contractName.empty())
+		contractName = m_compiler.lastContractName();
+	else
+		contractName = m_compilerInput.contractName;
+	evmasm::LinkerObject obj = m_compiler.object(contractName);
+	obj.link(m_compilerInput.libraryAddresses);
+	Json::Value methodIdentifiers = m_compiler.methodIdentifiers(contractName);
+	return CompilerOutput{obj.bytecode, methodIdentifiers};
 }
 
 bool EvmoneUtility::zeroWord(uint8_t const* _result, size_t _length)
@@ -95,9 +95,13 @@ public:
 	}
 	/// @returns Compilation output comprising EVM bytecode and list of
 	/// method identifiers in contract if compilation is successful,
-	/// null value otherwise.
+	/// null value otherwise. The sources are only compiled on the first call,
+	/// later calls link the requested contract with the current library addresses.
 	std::optional<CompilerOutput> compileContract();
 private:
+	/// @returns the output of the requested contract of the successful compilation.
+	CompilerOutput contractOutput();
+
 	frontend::CompilerStack m_compiler;
 	CompilerInput m_compilerInput;
 };
@@ -26,6 +26,7 @@
 #include <libyul/backends/evm/EVMDialect.h>
 #include <libyul/AST.h>
 
+#include <libevmasm/GasMeter.h>
 #include <libevmasm/Instruction.h>
 #include <libevmasm/SemanticInformation.h>
 
@@ -74,12 +75,14 @@ u256 readZeroExtended(bytes const& _data, u256 const& _offset)
 /// @a _target at offset @a _targetOffset. Behaves as if @a _source would
 /// continue with an infinite sequence of zero bytes beyond its end.
 void copyZeroExtended(
-	map<u256, uint8_t>& _target, bytes const& _source,
+	InterpreterMemory& _target, bytes const& _source,
 	size_t _targetOffset, size_t _sourceOffset, size_t _size
 )
 {
-	for (size_t i = 0; i < _size; ++i)
-		_target[_targetOffset + i] = _sourceOffset + i < _source.size() ? _source[_sourceOffset + i] : 0;
+	bytes data(_size, 0);
+	if (_sourceOffset < _source.size())
+		copy_n(_source.begin() + static_cast<ptrdiff_t>(_sourceOffset), min(_size, _source.size() - _sourceOffset), data.begin());
+	_target.write(_targetOffset, bytesConstRef(&data));
 }
 
 }
@@ -436,6 +439,75 @@ u256 EVMInstructionInterpreter::eval(
 	return 0;
 }
 
+u256 EVMInstructionInterpreter::gasCosts(
+	evmasm::Instruction _instruction,
+	vector<u256> const& _arguments,
+	langutil::EVMVersion _evmVersion
+) const
+{
+	using evmasm::Instruction;
+
+	auto words = [](u256 const& _size) { return (min(_size, u256(0xffffffff)) + 31) / 32; };
+	auto const& arg = _arguments;
+	switch (_instruction)
+	{
+	case Instruction::EXP:
+	{
+		u256 exponentBytes = 0;
+		for (u256 exponent = arg[1]; exponent > 0; exponent >>= 8)
+			++exponentBytes;
+		return GasCosts::expGas + GasCosts::expByteGas(_evmVersion) * exponentBytes;
+	}
+	case Instruction::KECCAK256:
+		return GasCosts::keccak256Gas + GasCosts::keccak256WordGas * words(arg[1]);
+	case Instruction::CALLDATACOPY:
+	case Instruction::CODECOPY:
+	case Instruction::RETURNDATACOPY:
+		return GasCosts::tier2Gas + GasCosts::copyGas * words(arg[2]);
+	case Instruction::EXTCODECOPY:
+		return GasCosts::extCodeGas(_evmVersion) + GasCosts::copyGas * words(arg[3]);
+	case Instruction::EXTCODESIZE:
+		return GasCosts::extCodeGas(_evmVersion);
+	case Instruction::BALANCE:
+	case Instruction::EXTCODEHASH:
+		return GasCosts::balanceGas(_evmVersion);
+	case Instruction::SLOAD:
+		return GasCosts::sloadGas(_evmVersion);
+	case Instruction::SSTORE:
+	{
+		auto slot = m_state.storage.find(h256(arg[0]));
+		bool isZero = slot == m_state.storage.end() || slot->second == h256{};
+		if (isZero && arg[1] != 0)
+			return GasCosts::totalSstoreSetGas(_evmVersion);
+		else
+			return GasCosts::totalSstoreResetGas(_evmVersion);
+	}
+	case Instruction::LOG0:
+	case Instruction::LOG1:
+	case Instruction::LOG2:
+	case Instruction::LOG3:
+	case Instruction::LOG4:
+	{
+		unsigned topics = static_cast<unsigned>(_instruction) - static_cast<unsigned>(Instruction::LOG0);
+		return GasCosts::logGas + GasCosts::logTopicGas * topics + GasCosts::logDataGas * min(arg[1], u256(0xffffffff));
+	}
+	case Instruction::CREATE:
+		return GasCosts::createGas;
+	case Instruction::CREATE2:
+		return GasCosts::createGas + GasCosts::keccak256WordGas * words(arg[2]);
+	case Instruction::CALL:
+	case Instruction::CALLCODE:
+		return GasCosts::callGas(_evmVersion) + (arg[2] != 0 ? GasCosts::callValueTransferGas : 0);
+	case Instruction::DELEGATECALL:
+	case Instruction::STATICCALL:
+		return GasCosts::callGas(_evmVersion);
+	case Instruction::SELFDESTRUCT:
+		return GasCosts::selfdestructGas(_evmVersion);
+	default:
+		return evmasm::GasMeter::runGas(_instruction);
+	}
+}
+
 u256 EVMInstructionInterpreter::evalBuiltin(
 	BuiltinFunctionForEVM const& _fun,
 	vector<Expression> const& _arguments,
@@ -500,10 +572,7 @@ bool EVMInstructionInterpreter::accessMemory(u256 const& _offset, u256 const& _s
 bytes EVMInstructionInterpreter::readMemory(u256 const& _offset, u256 const& _size)
 {
 	yulAssert(_size <= 0xffff, "Too large read.");
-	bytes data(size_t(_size), uint8_t(0));
-	for (size_t i = 0; i < data.size(); ++i)
-		data[i] = m_state.memory[_offset + i];
-	return data;
+	return m_state.memory.read(_offset, size_t(_size));
 }
 
 u256 EVMInstructionInterpreter::readMemoryWord(u256 const& _offset)
@@ -513,8 +582,8 @@ u256 EVMInstructionInterpreter::readMemoryWord(u256 const& _offset)
 
 void EVMInstructionInterpreter::writeMemoryWord(u256 const& _offset, u256 const& _value)
 {
-	for (size_t i = 0; i < 32; i++)
-		m_state.memory[_offset + i] = uint8_t((_value >> (8 * (31 - i))) & 0xff);
+	h256 const word(_value);
+	m_state.memory.write(_offset, word.ref());
 }
 
 
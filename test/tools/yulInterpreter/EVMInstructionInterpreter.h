@@ -23,6 +23,8 @@
 
 #include <libyul/ASTForward.h>
 
+#include <liblangutil/EVMVersion.h>
+
 #include <libsolutil/CommonData.h>
 #include <libsolutil/Numeric.h>
 
@@ -49,8 +51,8 @@ struct InterpreterState;
  * side-effects.
  *
  * Since this is mainly meant to be used for differential fuzz testing, it is focused
- * on a single contract only, does not do any gas counting and differs from the correct
- * implementation in many ways:
+ * on a single contract only, only estimates the gas costs (see @a gasCosts) and differs
+ * from the correct implementation in many ways:
  *
  * - If memory access to a "large" memory position is performed, a deterministic
  *   value is returned. Data that is stored in a "large" memory position is not
@@ -72,6 +74,14 @@ public:
 	{}
 	/// Evaluate instruction
 	u256 eval(evmasm::Instruction _instruction, std::vector<u256> const& _arguments);
+	/// @returns the gas costs of executing @a _instruction with @a _arguments, assuming cold
+	/// accesses to storage and accounts. Memory expansion, refunds and the gas used by
+	/// called contracts are not included.
+	u256 gasCosts(
+		evmasm::Instruction _instruction,
+		std::vector<u256> const& _arguments,
+		langutil::EVMVersion _evmVersion
+	) const;
 	/// Evaluate builtin function
 	u256 evalBuiltin(
 		BuiltinFunctionForEVM const& _fun,
@@ -30,6 +30,8 @@
 #include <libyul/backends/evm/EVMDialect.h>
 #include <libyul/backends/wasm/WasmDialect.h>
 
+#include <libevmasm/GasMeter.h>
+
 #include <liblangutil/Exceptions.h>
 
 #include <libsolutil/FixedHash.h>
@@ -38,6 +40,8 @@
 
 #include <range/v3/view/reverse.hpp>
 
+#include <algorithm>
+#include <cstring>
 #include <ostream>
 #include <variant>
 
@@ -48,9 +52,152 @@ using namespace solidity::yul::test;
 
 using solidity::util::h256;
 
+namespace
+{
+
+/**
+ * Assigns the slots of the variables, which are local to the frame of the enclosing function,
+ * and resolves the function calls, following the scoping rules of function names.
+ */
+class NameResolver: public ASTWalker
+{
+public:
+	NameResolver(Dialect const& _dialect, ResolvedNames& _names): m_dialect(_dialect), m_names(_names) {}
+
+	using ASTWalker::operator();
+
+	void operator()(Identifier const& _identifier) override
+	{
+		m_names.variables[&_identifier] = slot(_identifier.name);
+	}
+
+	void operator()(VariableDeclaration const& _declaration) override
+	{
+		ASTWalker::operator()(_declaration);
+		for (TypedName const& variable: _declaration.variables)
+			m_names.declarations[&variable] = slot(variable.name);
+	}
+
+	void operator()(Literal const& _literal) override
+	{
+		m_names.literals[&_literal] = valueOfLiteral(_literal);
+	}
+
+	void operator()(FunctionCall const& _call) override
+	{
+		if (BuiltinFunction const* builtin = m_dialect.builtin(_call.functionName.name))
+		{
+			m_names.builtins[&_call] = builtin;
+			// Literal arguments are not evaluated and need not be valid values.
+			for (size_t i = 0; i < _call.arguments.size(); ++i)
+				if (!builtin->literalArgument(i))
+					visit(_call.arguments.at(i));
+			return;
+		}
+		ASTWalker::operator()(_call);
+		for (auto const& scope: m_functionScopes | ranges::views::reverse)
+			if (auto function = scope.find(_call.functionName.name); function != scope.end())
+			{
+				m_names.calledFunctions[&_call] = function->second;
+				return;
+			}
+		yulAssert(false, "Function not found.");
+	}
+
+	void operator()(FunctionDefinition const& _function) override
+	{
+		map<YulString, size_t> outerSlots = std::move(m_slots);
+		m_slots.clear();
+
+		ResolvedNames::Frame frame;
+		for (TypedName const& parameter: _function.parameters)
+			frame.parameters.push_back(slot(parameter.name));
+		for (TypedName const& returnVariable: _function.returnVariables)
+			frame.returnVariables.push_back(slot(returnVariable.name));
+		(*this)(_function.body);
+		frame.size = m_slots.size();
+		m_names.frames[&_function] = std::move(frame);
+
+		m_slots = std::move(outerSlots);
+	}
+
+	void operator()(Block const& _block) override
+	{
+		// Functions are visible in the whole block they are defined in.
+		map<YulString, FunctionDefinition const*>& scope = m_functionScopes.emplace_back();
+		for (auto const& statement: _block.statements)
+			if (auto const* function = get_if<FunctionDefinition>(&statement))
+				scope.emplace(function->name, function);
+		ASTWalker::operator()(_block);
+		m_functionScopes.pop_back();
+	}
+
+	size_t frameSize() const { return m_slots.size(); }
+
+private:
+	size_t slot(YulString _name)
+	{
+		return m_slots.emplace(_name, m_slots.size()).first->second;
+	}
+
+	Dialect const& m_dialect;
+	ResolvedNames& m_names;
+	/// Slots of the variable names of the current frame.
+	map<YulString, size_t> m_slots;
+	vector<map<YulString, FunctionDefinition const*>> m_functionScopes;
+};
+
+}
+
+uint8_t& InterpreterMemory::operator[](u256 const& _offset)
+{
+	return m_pages[_offset / pageSize][static_cast<size_t>(_offset % pageSize)];
+}
+
+bytes InterpreterMemory::read(u256 const& _offset, size_t _size) const
+{
+	bytes data(_size, 0);
+	u256 offset = _offset;
+	for (size_t position = 0; position < _size;)
+	{
+		size_t pageOffset = static_cast<size_t>(offset % pageSize);
+		size_t length = min(_size - position, pageSize - pageOffset);
+		if (auto page = m_pages.find(offset / pageSize); page != m_pages.end())
+			memcpy(data.data() + position, page->second.data() + pageOffset, length);
+		position += length;
+		offset += length;
+	}
+	return data;
+}
+
+void InterpreterMemory::write(u256 const& _offset, bytesConstRef _data)
+{
+	u256 offset = _offset;
+	for (size_t position = 0; position < _data.size();)
+	{
+		size_t pageOffset = static_cast<size_t>(offset % pageSize);
+		size_t length = min(_data.size() - position, pageSize - pageOffset);
+		memcpy(m_pages[offset / pageSize].data() + pageOffset, _data.data() + position, length);
+		position += length;
+		offset += length;
+	}
+}
+
+map<u256, u256> InterpreterMemory::words() const
+{
+	map<u256, u256> words;
+	for (auto const& [number, page]: m_pages)
+		for (size_t offset = 0; offset < pageSize; offset += 0x20)
+			if (any_of(page.begin() + offset, page.begin() + offset + 0x20, [](uint8_t _byte) { return _byte != 0; }))
+				words.emplace(number * pageSize + offset, u256(h256(bytesConstRef(page.data() + offset, 0x20))));
+	return words;
+}
+
 void InterpreterState::dumpStorage(ostream& _out) const
 {
-	for (auto const& slot: storage)
+	vector<pair<h256, h256>> slots(storage.begin(), storage.end());
+	sort(slots.begin(), slots.end());
+	for (auto const& slot: slots)
 		if (slot.second != h256{})
 			_out << "  " << slot.first.hex() << ": " << slot.second.hex() << endl;
 }
@@ -63,12 +210,8 @@ void InterpreterState::dumpTraceAndState(ostream& _out, bool _disableMemoryTrace
 	if (!_disableMemoryTrace)
 	{
 		_out << "Memory dump:\n";
-		map<u256, u256> words;
-		for (auto const& [offset, value]: memory)
-			words[(offset / 0x20) * 0x20] |= u256(uint32_t(value)) << (256 - 8 - 8 * static_cast<size_t>(offset % 0x20));
-		for (auto const& [offset, value]: words)
-			if (value != 0)
-				_out << "  " << std::uppercase << std::hex << std::setw(4) << offset << ": " << h256(value).hex() << endl;
+		for (auto const& [offset, value]: memory.words())
+			_out << "  " << std::uppercase << std::hex << std::setw(4) << offset << ": " << h256(value).hex() << endl;
 	}
 	_out << "Storage dump:" << endl;
 	dumpStorage(_out);
@@ -81,8 +224,17 @@ void Interpreter::run(
 	bool _disableMemoryTrace
 )
 {
-	Scope scope;
-	Interpreter{_state, _dialect, scope, _disableMemoryTrace}(_ast);
+	ResolvedNames names = ResolvedNames::resolve(_dialect, _ast);
+	Interpreter{_state, _dialect, names, _disableMemoryTrace, vector<u256>(names.outermostFrameSize, 0)}(_ast);
+}
+
+ResolvedNames ResolvedNames::resolve(Dialect const& _dialect, Block const& _ast)
+{
+	ResolvedNames names;
+	NameResolver resolver{_dialect, names};
+	resolver(_ast);
+	names.outermostFrameSize = resolver.frameSize();
+	return names;
 }
 
 void Interpreter::operator()(ExpressionStatement const& _expressionStatement)
@@ -96,11 +248,7 @@ void Interpreter::operator()(Assignment const& _assignment)
 	vector<u256> values = evaluateMulti(*_assignment.value);
 	solAssert(values.size() == _assignment.variableNames.size(), "");
 	for (size_t i = 0; i < values.size(); ++i)
-	{
-		YulString varName = _assignment.variableNames.at(i).name;
-		solAssert(m_variables.count(varName), "");
-		m_variables[varName] = values.at(i);
-	}
+		m_variables[m_names.variables.at(&_assignment.variableNames.at(i))] = values.at(i);
 }
 
 void Interpreter::operator()(VariableDeclaration const& _declaration)
@@ -111,12 +259,7 @@ void Interpreter::operator()(VariableDeclaration const& _declaration)
 
 	solAssert(values.size() == _declaration.variables.size(), "");
 	for (size_t i = 0; i < values.size(); ++i)
-	{
-		YulString varName = _declaration.variables.at(i).name;
-		solAssert(!m_variables.count(varName), "");
-		m_variables[varName] = values.at(i);
-		m_scope->names.emplace(varName, nullptr);
-	}
+		m_variables[m_names.declarations.at(&_declaration.variables.at(i))] = values.at(i);
 }
 
 void Interpreter::operator()(If const& _if)
@@ -148,9 +291,6 @@ void Interpreter::operator()(ForLoop const& _forLoop)
 {
 	solAssert(_forLoop.condition, "");
 
-	enterScope(_forLoop.pre);
-	ScopeGuard g([this]{ leaveScope(); });
-
 	for (auto const& statement: _forLoop.pre.statements)
 	{
 		visit(statement);
@@ -195,15 +335,6 @@ void Interpreter::operator()(Leave const&)
 
 void Interpreter::operator()(Block const& _block)
 {
-	enterScope(_block);
-	// Register functions.
-	for (auto const& statement: _block.statements)
-		if (holds_alternative<FunctionDefinition>(statement))
-		{
-			FunctionDefinition const& funDef = std::get<FunctionDefinition>(statement);
-			m_scope->names.emplace(funDef.name, &funDef);
-		}
-
 	for (auto const& statement: _block.statements)
 	{
 		incrementStep();
@@ -211,44 +342,22 @@ void Interpreter::operator()(Block const& _block)
 		if (m_state.controlFlowState != ControlFlowState::Default)
 			break;
 	}
-
-	leaveScope();
 }
 
 u256 Interpreter::evaluate(Expression const& _expression)
 {
-	ExpressionEvaluator ev(m_state, m_dialect, *m_scope, m_variables, m_disableMemoryTrace);
+	ExpressionEvaluator ev(m_state, m_dialect, m_names, m_variables, m_disableMemoryTrace);
 	ev.visit(_expression);
 	return ev.value();
 }
 
 vector<u256> Interpreter::evaluateMulti(Expression const& _expression)
 {
-	ExpressionEvaluator ev(m_state, m_dialect, *m_scope, m_variables, m_disableMemoryTrace);
+	ExpressionEvaluator ev(m_state, m_dialect, m_names, m_variables, m_disableMemoryTrace);
 	ev.visit(_expression);
 	return ev.values();
 }
 
-void Interpreter::enterScope(Block const& _block)
-{
-	if (!m_scope->subScopes.count(&_block))
-		m_scope->subScopes[&_block] = make_unique<Scope>(Scope{
-			{},
-			{},
-			m_scope
-		});
-	m_scope = m_scope->subScopes[&_block].get();
-}
-
-void Interpreter::leaveScope()
-{
-	for (auto const& [var, funDeclaration]: m_scope->names)
-		if (!funDeclaration)
-			m_variables.erase(var);
-	m_scope = m_scope->parent;
-	yulAssert(m_scope, "");
-}
-
 void Interpreter::incrementStep()
 {
 	m_state.numSteps++;
@@ -259,70 +368,83 @@ void Interpreter::incrementStep()
 	}
 }
 
+ExpressionEvaluator::ExpressionEvaluator(
+	InterpreterState& _state,
+	Dialect const& _dialect,
+	ResolvedNames const& _names,
+	vector<u256> const& _variables,
+	bool _disableMemoryTrace
+):
+	m_state(_state),
+	m_dialect(_dialect),
+	m_evmDialect(dynamic_cast<EVMDialect const*>(&_dialect)),
+	m_names(_names),
+	m_variables(_variables),
+	m_disableMemoryTrace(_disableMemoryTrace)
+{
+}
+
 void ExpressionEvaluator::operator()(Literal const& _literal)
 {
 	incrementStep();
-	static YulString const trueString("true");
-	static YulString const falseString("false");
-
-	setValue(valueOfLiteral(_literal));
+	if (m_evmDialect)
+		m_state.gasUsed += evmasm::GasCosts::tier2Gas;
+	setValue(m_names.literals.at(&_literal));
 }
 
 void ExpressionEvaluator::operator()(Identifier const& _identifier)
 {
-	solAssert(m_variables.count(_identifier.name), "");
 	incrementStep();
-	setValue(m_variables.at(_identifier.name));
+	if (m_evmDialect)
+		m_state.gasUsed += evmasm::GasCosts::tier2Gas;
+	setValue(m_variables.at(m_names.variables.at(&_identifier)));
 }
 
 void ExpressionEvaluator::operator()(FunctionCall const& _funCall)
 {
-	vector<optional<LiteralKind>> const* literalArguments = nullptr;
-	if (BuiltinFunction const* builtin = m_dialect.builtin(_funCall.functionName.name))
-		if (!builtin->literalArguments.empty())
-			literalArguments = &builtin->literalArguments;
-	evaluateArgs(_funCall.arguments, literalArguments);
+	BuiltinFunction const* builtin = nullptr;
+	if (auto resolved = m_names.builtins.find(&_funCall); resolved != m_names.builtins.end())
+		builtin = resolved->second;
+	evaluateArgs(_funCall.arguments, builtin);
 
-	if (EVMDialect const* dialect = dynamic_cast<EVMDialect const*>(&m_dialect))
+	if (builtin && m_evmDialect)
 	{
-		if (BuiltinFunctionForEVM const* fun = dialect->builtin(_funCall.functionName.name))
-		{
-			EVMInstructionInterpreter interpreter(m_state, m_disableMemoryTrace);
-			setValue(interpreter.evalBuiltin(*fun, _funCall.arguments, values()));
-			return;
-		}
+		auto const& fun = static_cast<BuiltinFunctionForEVM const&>(*builtin);
+		EVMInstructionInterpreter interpreter(m_state, m_disableMemoryTrace);
+		if (fun.instruction)
+			m_state.gasUsed += interpreter.gasCosts(*fun.instruction, values(), m_evmDialect->evmVersion());
+		setValue(interpreter.evalBuiltin(fun, _funCall.arguments, values()));
+		return;
+	}
+	else if (builtin && dynamic_cast<WasmDialect const*>(&m_dialect))
+	{
+		EwasmBuiltinInterpreter interpreter(m_state);
+		setValue(interpreter.evalBuiltin(_funCall.functionName.name, _funCall.arguments, values()));
+		return;
 	}
-	else if (WasmDialect const* dialect = dynamic_cast<WasmDialect const*>(&m_dialect))
-		if (dialect->builtin(_funCall.functionName.name))
-		{
-			EwasmBuiltinInterpreter interpreter(m_state);
-			setValue(interpreter.evalBuiltin(_funCall.functionName.name, _funCall.arguments, values()));
-			return;
-		}
 
-	Scope* scope = &m_scope;
-	for (; scope; scope = scope->parent)
-		if (scope->names.count(_funCall.functionName.name))
-			break;
-	yulAssert(scope, "");
+	FunctionDefinition const* fun = m_names.calledFunctions.at(&_funCall);
+	ResolvedNames::Frame const& frame = m_names.frames.at(fun);
+	yulAssert(m_values.size() == frame.parameters.size(), "");
+	vector<u256> variables(frame.size, 0);
+	for (size_t i = 0; i < frame.parameters.size(); ++i)
+		variables[frame.parameters.at(i)] = m_values.at(i);
 
-	FunctionDefinition const* fun = scope->names.at(_funCall.functionName.name);
-	yulAssert(fun, "Function not found.");
-	yulAssert(m_values.size() == fun->parameters.size(), "");
-	map<YulString, u256> variables;
-	for (size_t i = 0; i < fun->parameters.size(); ++i)
-		variables[fun->parameters.at(i).name] = m_values.at(i);
-	for (size_t i = 0; i < fun->returnVariables.size(); ++i)
-		variables[fun->returnVariables.at(i).name] = 0;
+	if (m_evmDialect)
+		// Pushing the return label, jumping into and out of the function and the two jump destinations.
+		m_state.gasUsed +=
+			evmasm::GasCosts::tier2Gas +
+			2 * evmasm::GasMeter::runGas(evmasm::Instruction::JUMP) +
+			2 * evmasm::GasCosts::jumpdestGas;
 
 	m_state.controlFlowState = ControlFlowState::Default;
-	Interpreter interpreter(m_state, m_dialect, *scope, m_disableMemoryTrace, std::move(variables));
+	Interpreter interpreter(m_state, m_dialect, m_names, m_disableMemoryTrace, std::move(variables));
 	interpreter(fun->body);
 	m_state.controlFlowState = ControlFlowState::Default;
 
 	m_values.clear();
-	for (auto const& retVar: fun->returnVariables)
-		m_values.emplace_back(interpreter.valueOfVariable(retVar.name));
+	for (size_t slot: frame.returnVariables)
+		m_values.emplace_back(interpreter.valueOfVariable(slot));
 }
 
 u256 ExpressionEvaluator::value() const
@@ -339,7 +461,7 @@ void ExpressionEvaluator::setValue(u256 _value)
 
 void ExpressionEvaluator::evaluateArgs(
 	vector<Expression> const& _expr,
-	vector<optional<LiteralKind>> const* _literalArguments
+	BuiltinFunction const* _builtin
 )
 {
 	incrementStep();
@@ -348,7 +470,7 @@ void ExpressionEvaluator::evaluateArgs(
 	/// Function arguments are evaluated in reverse.
 	for (auto const& expr: _expr | ranges::views::reverse)
 	{
-		if (!_literalArguments || !_literalArguments->at(_expr.size() - i - 1))
+		if (!_builtin || !_builtin->literalArgument(_expr.size() - i - 1))
 			visit(expr);
 		else
 			m_values = {0};
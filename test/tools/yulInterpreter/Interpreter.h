@@ -29,11 +29,15 @@
 
 #include <libsolutil/Exceptions.h>
 
+#include <array>
 #include <map>
+#include <unordered_map>
 
 namespace solidity::yul
 {
+struct BuiltinFunction;
 struct Dialect;
+struct EVMDialect;
 }
 
 namespace solidity::yul::test
@@ -67,14 +71,52 @@ enum class ControlFlowState
 	Leave
 };
 
+/**
+ * Byte-addressed memory of the interpreter. It is stored in zero-initialized pages of
+ * contiguous bytes, which are allocated when they are first written to. Offsets wrap
+ * around at 2**256.
+ */
+class InterpreterMemory
+{
+public:
+	/// Size of the pages in bytes. It is a multiple of the word size, so words at offsets
+	/// that are multiples of 32 do not cross pages.
+	static constexpr size_t pageSize = 0x1000;
+
+	/// @returns the byte at @a _offset, allocating its page.
+	uint8_t& operator[](u256 const& _offset);
+	/// @returns the @a _size bytes starting at @a _offset. Does not allocate pages.
+	bytes read(u256 const& _offset, size_t _size) const;
+	/// Copies @a _data to the memory starting at @a _offset.
+	void write(u256 const& _offset, bytesConstRef _data);
+
+	/// @returns the non-zero words at offsets that are multiples of 32, by offset.
+	std::map<u256, u256> words() const;
+
+private:
+	using Page = std::array<uint8_t, pageSize>;
+
+	/// Pages by their number, i.e. the offset of their first byte divided by pageSize.
+	std::map<u256, Page> m_pages;
+};
+
+/// Hashes storage slots by all of their bytes.
+struct StorageSlotHash
+{
+	size_t operator()(util::h256 const& _slot) const
+	{
+		return boost::hash_range(_slot.data(), _slot.data() + util::h256::size);
+	}
+};
+
 struct InterpreterState
 {
 	bytes calldata;
 	bytes returndata;
-	std::map<u256, uint8_t> memory;
-	/// This is different than memory.size() because we ignore gas.
+	InterpreterMemory memory;
+	/// This is different than the size of the written memory because we ignore gas.
 	u256 msize;
-	std::map<util::h256, util::h256> storage;
+	std::unordered_map<util::h256, util::h256, StorageSlotHash> storage;
 	util::h160 address = util::h160("0x0000000000000000000000000000000011111111");
 	u256 balance = 0x22222222;
 	u256 selfbalance = 0x22223333;
@@ -99,6 +141,10 @@ struct InterpreterState
 	size_t maxSteps = 0;
 	size_t numSteps = 0;
 	size_t maxExprNesting = 0;
+	/// Estimated gas used by the execution, only counted for EVM dialects: The costs of the
+	/// instructions (see EVMInstructionInterpreter::gasCosts), of pushing every literal and
+	/// variable to the stack and of the jumps into and out of functions.
+	u256 gasUsed = 0;
 	ControlFlowState controlFlowState = ControlFlowState::Default;
 
 	/// Prints execution trace and non-zero storage to @param _out.
@@ -106,19 +152,42 @@ struct InterpreterState
 	/// avoids false positives reports by the fuzzer when certain optimizer steps are
 	/// activated e.g., Redundant store eliminator, Equal store eliminator.
 	void dumpTraceAndState(std::ostream& _out, bool _disableMemoryTrace) const;
-	/// Prints non-zero storage to @param _out.
+	/// Prints non-zero storage to @param _out, ordered by slot.
 	void dumpStorage(std::ostream& _out) const;
 };
 
 /**
- * Scope structure built and maintained during execution.
+ * Variable slots, called functions and literal values of a Yul AST, resolved once before
+ * it is executed, so that the interpreter does not look up names or parse literals.
+ * The outermost block and the body of each function have a frame with one slot for each
+ * distinct name of a variable declared in them outside of nested functions. Since variables
+ * cannot be shadowed, variables that are alive at the same time never share a slot.
  */
-struct Scope
+struct ResolvedNames
 {
-	/// Used for variables and functions. Value is nullptr for variables.
-	std::map<YulString, FunctionDefinition const*> names;
-	std::map<Block const*, std::unique_ptr<Scope>> subScopes;
-	Scope* parent = nullptr;
+	struct Frame
+	{
+		size_t size = 0;
+		std::vector<size_t> parameters;
+		std::vector<size_t> returnVariables;
+	};
+
+	/// Resolves the names in @a _ast, which has to be valid in @a _dialect.
+	static ResolvedNames resolve(Dialect const& _dialect, Block const& _ast);
+
+	/// Slots of the variables referenced by identifiers, including the ones that are assigned to.
+	std::unordered_map<Identifier const*, size_t> variables;
+	/// Slots of the variables declared in variable declarations.
+	std::unordered_map<TypedName const*, size_t> declarations;
+	/// Builtins called by function calls.
+	std::unordered_map<FunctionCall const*, BuiltinFunction const*> builtins;
+	/// Definitions of the functions called by function calls that are not builtins.
+	std::unordered_map<FunctionCall const*, FunctionDefinition const*> calledFunctions;
+	/// Values of the literals, except the ones that are literal arguments of builtins.
+	std::unordered_map<Literal const*, u256> literals;
+	std::unordered_map<FunctionDefinition const*, Frame> frames;
+	/// Number of slots of the frame of the outermost block.
+	size_t outermostFrameSize = 0;
 };
 
 /**
@@ -138,17 +207,19 @@ public:
 		bool _disableMemoryTracing
 	);
 
+	/// Executes code with the names resolved in @a _names, with the values of the variables
+	/// in the frame @a _variables.
 	Interpreter(
 		InterpreterState& _state,
 		Dialect const& _dialect,
-		Scope& _scope,
+		ResolvedNames const& _names,
 		bool _disableMemoryTracing,
-		std::map<YulString, u256> _variables = {}
+		std::vector<u256> _variables
 	):
 		m_dialect(_dialect),
 		m_state(_state),
+		m_names(_names),
 		m_variables(std::move(_variables)),
-		m_scope(&_scope),
 		m_disableMemoryTrace(_disableMemoryTracing)
 	{
 	}
@@ -167,7 +238,7 @@ public:
 
 	std::vector<std::string> const& trace() const { return m_state.trace; }
 
-	u256 valueOfVariable(YulString _name) const { return m_variables.at(_name); }
+	u256 valueOfVariable(size_t _slot) const { return m_variables.at(_slot); }
 
 private:
 	/// Asserts that the expression evaluates to exactly one value and returns it.
@@ -175,18 +246,15 @@ private:
 	/// Evaluates the expression and returns its value.
 	std::vector<u256> evaluateMulti(Expression const& _expression);
 
-	void enterScope(Block const& _block);
-	void leaveScope();
-
 	/// Increment interpreter step count, throwing exception if step limit
 	/// is reached.
 	void incrementStep();
 
 	Dialect const& m_dialect;
 	InterpreterState& m_state;
-	/// Values of variables.
-	std::map<YulString, u256> m_variables;
-	Scope* m_scope;
+	ResolvedNames const& m_names;
+	/// Values of variables, by their slots.
+	std::vector<u256> m_variables;
 	bool m_disableMemoryTrace;
 };
 
@@ -199,16 +267,10 @@ public:
 	ExpressionEvaluator(
 		InterpreterState& _state,
 		Dialect const& _dialect,
-		Scope& _scope,
-		std::map<YulString, u256> const& _variables,
+		ResolvedNames const& _names,
+		std::vector<u256> const& _variables,
 		bool _disableMemoryTrace
-	):
-		m_state(_state),
-		m_dialect(_dialect),
-		m_variables(_variables),
-		m_scope(_scope),
-		m_disableMemoryTrace(_disableMemoryTrace)
-	{}
+	);
 
 	void operator()(Literal const&) override;
 	void operator()(Identifier const&) override;
@@ -217,16 +279,16 @@ public:
 	/// Asserts that the expression has exactly one value and returns it.
 	u256 value() const;
 	/// Returns the list of values of the expression.
-	std::vector<u256> values() const { return m_values; }
+	std::vector<u256> const& values() const { return m_values; }
 
 private:
 	void setValue(u256 _value);
 
 	/// Evaluates the given expression from right to left and
-	/// stores it in m_value.
+	/// stores it in m_value. The literal arguments of @a _builtin are not evaluated.
 	void evaluateArgs(
 		std::vector<Expression> const& _expr,
-		std::vector<std::optional<LiteralKind>> const* _literalArguments
+		BuiltinFunction const* _builtin
 	);
 
 	/// Increment evaluation count, throwing exception if the
@@ -236,9 +298,11 @@ private:
 
 	InterpreterState& m_state;
 	Dialect const& m_dialect;
-	/// Values of variables.
-	std::map<YulString, u256> const& m_variables;
-	Scope& m_scope;
+	/// The dialect if it is an EVM dialect, nullptr otherwise.
+	EVMDialect const* m_evmDialect;
+	ResolvedNames const& m_names;
+	/// Values of variables, by their slots.
+	std::vector<u256> const& m_variables;
 	/// Current value of the expression
 	std::vector<u256> m_values;
 	/// Current expression nesting level
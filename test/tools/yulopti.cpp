@@ -19,6 +19,7 @@
  * Interactive yul optimizer
  */
 
+#include <libsolutil/AllocationStats.h>
 #include <libsolutil/CommonIO.h>
 #include <libsolutil/Exceptions.h>
 #include <liblangutil/ErrorReporter.h>
@@ -31,7 +32,9 @@
 #include <libyul/Object.h>
 #include <liblangutil/SourceReferenceFormatter.h>
 
+#include <libyul/optimiser/ASTCopier.h>
 #include <libyul/optimiser/Disambiguator.h>
+#include <libyul/optimiser/Metrics.h>
 #include <libyul/optimiser/OptimiserStep.h>
 #include <libyul/optimiser/StackCompressor.h>
 #include <libyul/optimiser/VarNameCleaner.h>
@@ -58,7 +61,12 @@
 #include <range/v3/view/stride.hpp>
 #include <range/v3/view/transform.hpp>
 
+#include <algorithm>
+#include <atomic>
 #include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <new>
 #include <string>
 #include <sstream>
 #include <iostream>
@@ -73,6 +81,55 @@ using namespace solidity::yul;
 
 namespace po = boost::program_options;
 
+#if defined(SOLC_ALLOC_STATS)
+
+namespace
+{
+
+/// @returns the number of calls of the global operator new so far, reported by the benchmark mode.
+size_t allocationCount()
+{
+	return threadAllocationStats().count;
+}
+
+}
+
+#else
+
+namespace
+{
+
+atomic<size_t> allocations = 0;
+
+/// @returns the number of calls of the global operator new so far, reported by the benchmark mode.
+size_t allocationCount()
+{
+	return allocations;
+}
+
+}
+
+// Unless libsolutil replaces the global operator new to count the allocations, yulopti does it itself.
+void* operator new(size_t _size)
+{
+	allocations.fetch_add(1, memory_order_relaxed);
+	if (void* pointer = malloc(_size == 0 ? 1 : _size))
+		return pointer;
+	throw bad_alloc();
+}
+
+void operator delete(void* _pointer) noexcept
+{
+	free(_pointer);
+}
+
+void operator delete(void* _pointer, size_t) noexcept
+{
+	free(_pointer);
+}
+
+#endif
+
 class YulOpti
 {
 public:
@@ -185,6 +242,60 @@ public:
 		cout << AsmPrinter{m_dialect}(*m_ast) << endl;
 	}
 
+	/// Runs the steps like OptimiserSuite::runSequence, but applies each step @a _repetitions times
+	/// to copies of the same AST and prints the time, the change of the size of the code and the
+	/// number of allocations of each step, summed up over all its runs.
+	void runBenchmark(string _source, string _steps, size_t _repetitions)
+	{
+		yulAssert(_repetitions > 0);
+		OptimiserSuite::validateSequence(_steps);
+		parse(_source);
+		disambiguate();
+
+		size_t codeSizeBefore = CodeSize::codeSizeIncludingFunctions(*m_ast);
+		size_t astSizeBefore = CodeSize::codeSizeIncludingFunctions(*m_ast, allNodes());
+		m_measurements.clear();
+		benchmarkSequence(_steps, false, _repetitions);
+
+		vector<pair<string, StepMeasurement>> measurements(m_measurements.begin(), m_measurements.end());
+		for (auto& [name, measurement]: measurements)
+			sort(measurement.times.begin(), measurement.times.end());
+		// The slowest steps first.
+		stable_sort(measurements.begin(), measurements.end(), [](auto const& _a, auto const& _b) {
+			return mean(_a.second.times) > mean(_b.second.times);
+		});
+
+		cout <<
+			setw(30) << left << "Step" << right <<
+			setw(6) << "Runs" <<
+			setw(12) << "Mean [us]" <<
+			setw(12) << "Median [us]" <<
+			setw(12) << "P90 [us]" <<
+			setw(11) << "Code size" <<
+			setw(10) << "AST size" <<
+			setw(13) << "Allocations" <<
+			endl;
+		chrono::nanoseconds totalTime{0};
+		for (auto const& [name, measurement]: measurements)
+		{
+			totalTime += mean(measurement.times);
+			cout <<
+				setw(30) << left << name << right <<
+				setw(6) << measurement.runs <<
+				setw(12) << microseconds(mean(measurement.times)) <<
+				setw(12) << microseconds(percentile(measurement.times, 50)) <<
+				setw(12) << microseconds(percentile(measurement.times, 90)) <<
+				setw(11) << signedString(measurement.codeSizeChange) <<
+				setw(10) << signedString(measurement.astSizeChange) <<
+				setw(13) << measurement.allocations / _repetitions <<
+				endl;
+		}
+		cout << endl;
+		cout << "Total time: " << microseconds(totalTime) << " us" << endl;
+		cout << "Code size: " << codeSizeBefore << " -> " << CodeSize::codeSizeIncludingFunctions(*m_ast) << endl;
+		cout << "AST size: " << astSizeBefore << " -> " << CodeSize::codeSizeIncludingFunctions(*m_ast, allNodes()) << endl;
+	}
+
 	void runInteractive(string _source, bool _disambiguated = false)
 	{
 		bool disambiguated = _disambiguated;
@@ -243,6 +354,109 @@ public:
 	}
 
 private:
+	struct StepMeasurement
+	{
+		size_t runs = 0;
+		/// Time of all runs of the step, for each repetition.
+		vector<chrono::nanoseconds> times;
+		long long codeSizeChange = 0;
+		long long astSizeChange = 0;
+		/// Allocations of all runs in all repetitions.
+		size_t allocations = 0;
+	};
+
+	/// Weights that count every node of the AST.
+	static CodeWeights allNodes()
+	{
+		return CodeWeights{1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1};
+	}
+
+	static chrono::nanoseconds mean(vector<chrono::nanoseconds> const& _times)
+	{
+		chrono::nanoseconds sum{0};
+		for (auto const& time: _times)
+			sum += time;
+		return sum / static_cast<long>(_times.size());
+	}
+
+	/// @returns the nearest-rank percentile of the sorted @a _times.
+	static chrono::nanoseconds percentile(vector<chrono::nanoseconds> const& _sortedTimes, size_t _percent)
+	{
+		size_t rank = (_percent * _sortedTimes.size() + 99) / 100;
+		return _sortedTimes[max<size_t>(rank, 1) - 1];
+	}
+
+	static long long microseconds(chrono::nanoseconds _time)
+	{
+		return chrono::duration_cast<chrono::microseconds>(_time).count();
+	}
+
+	static string signedString(long long _value)
+	{
+		return (_value > 0 ? "+" : "") + to_string(_value);
+	}
+
+	/// Runs the sequence with the same semantics as OptimiserSuite::runSequence, i.e. repeats the
+	/// bracketed parts until the code size does not change any more.
+	void benchmarkSequence(string_view _steps, bool _repeatUntilStable, size_t _repetitions)
+	{
+		size_t codeSize = 0;
+		for (size_t round = 0; round < OptimiserSuite::MaxRounds; ++round)
+		{
+			for (size_t i = 0; i < _steps.size(); ++i)
+				if (_steps[i] == '[')
+				{
+					size_t end = i + 1;
+					for (size_t nestingLevel = 1; nestingLevel > 0; ++end)
+						if (_steps[end] == '[')
+							++nestingLevel;
+						else if (_steps[end] == ']')
+							--nestingLevel;
+					benchmarkSequence(_steps.substr(i + 1, end - i - 2), true, _repetitions);
+					i = end - 1;
+				}
+				else if (_steps[i] != ' ' && _steps[i] != '\n')
+					benchmarkStep(OptimiserSuite::stepAbbreviationToNameMap().at(_steps[i]), _repetitions);
+
+			if (!_repeatUntilStable)
+				break;
+			size_t newSize = CodeSize::codeSizeIncludingFunctions(*m_ast);
+			if (newSize == codeSize)
+				break;
+			codeSize = newSize;
+		}
+	}
+
+	void benchmarkStep(string const& _name, size_t _repetitions)
+	{
+		OptimiserStep const& step = *OptimiserSuite::allSteps().at(_name);
+		StepMeasurement& measurement = m_measurements[_name];
+		measurement.times.resize(_repetitions);
+		++measurement.runs;
+		long long codeSizeBefore = static_cast<long long>(CodeSize::codeSizeIncludingFunctions(*m_ast));
+		long long astSizeBefore = static_cast<long long>(CodeSize::codeSizeIncludingFunctions(*m_ast, allNodes()));
+
+		yul::Block result;
+		for (size_t repetition = 0; repetition < _repetitions; ++repetition)
+		{
+			yul::Block ast = std::get<yul::Block>(ASTCopier{}(*m_ast));
+			// Makes all repetitions introduce the same names.
+			m_nameDispenser.reset(ast);
+			size_t allocationsBefore = allocationCount();
+			auto start = chrono::steady_clock::now();
+			step.run(m_context, ast);
+			measurement.times[repetition] += chrono::steady_clock::now() - start;
+			measurement.allocations += allocationCount() - allocationsBefore;
+			result = move(ast);
+		}
+		*m_ast = move(result);
+		m_nameDispenser.reset(*m_ast);
+
+		measurement.codeSizeChange += static_cast<long long>(CodeSize::codeSizeIncludingFunctions(*m_ast)) - codeSizeBefore;
+		measurement.astSizeChange += static_cast<long long>(CodeSize::codeSizeIncludingFunctions(*m_ast, allNodes())) - astSizeBefore;
+	}
+
+	map<string, StepMeasurement> m_measurements;
 	shared_ptr<yul::Block> m_ast;
 	Dialect const& m_dialect{EVMDialect::strictAssemblyForEVMObjects(EVMVersion{})};
 	unique_ptr<AsmAnalysisInfo> m_analysisInfo;
@@ -261,6 +475,7 @@ int main(int argc, char** argv)
 	try
 	{
 		bool nonInteractive = false;
+		bool benchmark = false;
 		po::options_description options(
 			R"(yulopti, yul optimizer exploration tool.
 	Usage: yulopti [Options] <file>
@@ -268,6 +483,8 @@ int main(int argc, char** argv)
 	interactively read from stdin.
 	In non-interactive mode a list of steps has to be provided.
 	If <file> is -, yul code is read from stdin and run non-interactively.
+	In benchmark mode the provided steps are applied repeatedly and
+	the time, code size change and allocations of each step are printed.
 
 	Allowed options)",
 			po::options_description::m_default_line_length,
@@ -288,6 +505,16 @@ int main(int argc, char** argv)
 				po::bool_switch(&nonInteractive)->default_value(false),
 				"stop after executing the provided steps"
 			)
+			(
+				"bench",
+				po::bool_switch(&benchmark)->default_value(false),
+				"measure the provided steps non-interactively instead of printing the result"
+			)
+			(
+				"repetitions",
+				po::value<size_t>()->default_value(10),
+				"number of times each step is applied in benchmark mode"
+			)
 			("help,h", "Show this help screen.");
 
 		// All positional options should be interpreted as input files
@@ -324,13 +551,24 @@ int main(int argc, char** argv)
 			return 1;
 		}
 
-		if (nonInteractive && !arguments.count("steps"))
+		if ((nonInteractive || benchmark) && !arguments.count("steps"))
 		{
 			cout << options;
 			return 1;
 		}
 
 		YulOpti yulOpti;
+		if (benchmark)
+		{
+			size_t repetitions = arguments["repetitions"].as<size_t>();
+			if (repetitions == 0)
+			{
+				cerr << "The number of repetitions has to be positive." << endl;
+				return 1;
+			}
+			yulOpti.runBenchmark(input, arguments["steps"].as<string>(), repetitions);
+			return 0;
+		}
 		bool disambiguated = false;
 		if (!nonInteractive)
 			cout << input << endl;
@@ -21,7 +21,9 @@
 
 #include <tools/yulPhaser/AlgorithmRunner.h>
 #include <tools/yulPhaser/Common.h>
+#include <tools/yulPhaser/Exceptions.h>
 #include <tools/yulPhaser/FitnessMetrics.h>
+#include <tools/yulPhaser/SimulationRNG.h>
 
 #include <liblangutil/CharStream.h>
 
@@ -31,6 +33,7 @@
 #include <boost/test/unit_test.hpp>
 #include <boost/test/tools/output_test_stream.hpp>
 
+#include <fstream>
 #include <regex>
 #include <sstream>
 
@@ -325,7 +328,9 @@ BOOST_FIXTURE_TEST_CASE(run_should_print_cache_stats_if_requested, AlgorithmRunn
 		BOOST_TEST(nextLineMatches(m_output, regex(R"(Round\d+:\d+entries)")));
 		BOOST_TEST(nextLineMatches(m_output, regex(R"(Totalhits:\d+)")));
 		BOOST_TEST(nextLineMatches(m_output, regex(R"(Totalmisses:\d+)")));
+		BOOST_TEST(nextLineMatches(m_output, regex(R"(Hitrate:\d+%)")));
 		BOOST_TEST(nextLineMatches(m_output, regex(R"(Sizeofcachedcode:\d+)")));
+		BOOST_TEST(nextLineMatches(m_output, regex(R"(Evictedentries:0)")));
 	}
 
 	BOOST_REQUIRE(stats.roundEntryCounts.size() == 2);
@@ -339,7 +344,9 @@ BOOST_FIXTURE_TEST_CASE(run_should_print_cache_stats_if_requested, AlgorithmRunn
 	BOOST_TEST(nextLineMatches(m_output, regex("Round" + toString(round) + ":" + toString(stats.roundEntryCounts[round]) + "entries")));
 	BOOST_TEST(nextLineMatches(m_output, regex("Totalhits:" + toString(stats.hits))));
 	BOOST_TEST(nextLineMatches(m_output, regex("Totalmisses:" + toString(stats.misses))));
+	BOOST_TEST(nextLineMatches(m_output, regex("Hitrate:" + toString(stats.hitRate()) + "%")));
 	BOOST_TEST(nextLineMatches(m_output, regex("Sizeofcachedcode:" + toString(stats.totalCodeSize))));
+	BOOST_TEST(nextLineMatches(m_output, regex("Evictedentries:0")));
 	BOOST_TEST(m_output.peek() == EOF);
 }
 
@@ -447,6 +454,70 @@ BOOST_FIXTURE_TEST_CASE(run_should_not_save_population_to_file_if_autosave_file_
 	BOOST_TEST(!fs::exists(m_autosavePath));
 }
 
+BOOST_FIXTURE_TEST_CASE(run_should_save_checkpoint_after_each_round_if_checkpoint_file_specified, AlgorithmRunnerAutosaveFixture)
+{
+	string checkpointPath = (m_tempDir.path() / "checkpoint.txt").string();
+	m_options.maxRounds = 2;
+	m_options.checkpointFile = checkpointPath;
+	AlgorithmRunner runner(m_population, {}, m_options, m_output);
+
+	SimulationRNG::reset(1);
+	runner.run(m_algorithm);
+
+	BOOST_TEST(fs::is_regular_file(checkpointPath));
+	BOOST_TEST(!fs::exists(checkpointPath + ".tmp"));
+	Checkpoint expectedCheckpoint{2, SimulationRNG::state(), chromosomeStrings(runner.population())};
+	BOOST_CHECK(Checkpoint::load(checkpointPath) == expectedCheckpoint);
+}
+
+BOOST_FIXTURE_TEST_CASE(run_should_continue_from_checkpoint_as_if_not_interrupted, AlgorithmRunnerAutosaveFixture)
+{
+	string checkpointPath = (m_tempDir.path() / "checkpoint.txt").string();
+
+	m_options.maxRounds = 4;
+	SimulationRNG::reset(1);
+	AlgorithmRunner uninterruptedRunner(m_population, {}, m_options, m_output);
+	uninterruptedRunner.run(m_algorithm);
+
+	m_options.maxRounds = 2;
+	m_options.checkpointFile = checkpointPath;
+	SimulationRNG::reset(1);
+	AlgorithmRunner interruptedRunner(m_population, {}, m_options, m_output);
+	interruptedRunner.run(m_algorithm);
+
+	SimulationRNG::reset(2);
+	Checkpoint checkpoint = Checkpoint::load(checkpointPath);
+	BOOST_TEST(checkpoint.round == 2);
+	BOOST_REQUIRE(SimulationRNG::restoreState(checkpoint.rngState));
+
+	vector<Chromosome> chromosomes;
+	for (string const& chromosome: checkpoint.chromosomes)
+		chromosomes.emplace_back(chromosome);
+	m_options.maxRounds = 4;
+	m_options.initialRound = checkpoint.round;
+	AlgorithmRunner resumedRunner(Population(m_fitnessMetric, move(chromosomes)), {}, m_options, m_output);
+	resumedRunner.run(m_algorithm);
+
+	BOOST_TEST(resumedRunner.population() == uninterruptedRunner.population());
+	BOOST_TEST(Checkpoint::load(checkpointPath).round == 4);
+}
+
+BOOST_FIXTURE_TEST_CASE(Checkpoint_load_should_reject_invalid_files, AlgorithmRunnerAutosaveFixture)
+{
+	string checkpointPath = (m_tempDir.path() / "checkpoint.txt").string();
+	{
+		ofstream file(checkpointPath);
+		file << "round: x" << endl << "rng: 1" << endl << "chromosomes:" << endl;
+	}
+	BOOST_CHECK_THROW(Checkpoint::load(checkpointPath), InvalidCheckpoint);
+
+	{
+		ofstream file(checkpointPath);
+		file << "abc" << endl;
+	}
+	BOOST_CHECK_THROW(Checkpoint::load(checkpointPath), InvalidCheckpoint);
+}
+
 BOOST_FIXTURE_TEST_CASE(run_should_randomise_duplicate_chromosomes_if_requested, AlgorithmRunnerFixture)
 {
 	Chromosome duplicate("afc");
@@ -19,6 +19,7 @@
 #include <tools/yulPhaser/FitnessMetrics.h>
 
 #include <libyul/optimiser/EquivalentFunctionCombiner.h>
+#include <libyul/optimiser/ExpressionSimplifier.h>
 #include <libyul/optimiser/UnusedPruner.h>
 
 #include <liblangutil/CharStream.h>
@@ -98,7 +99,36 @@ protected:
 
 BOOST_AUTO_TEST_SUITE(Phaser, *boost::unit_test::label("nooptions"))
 BOOST_AUTO_TEST_SUITE(FitnessMetricsTest)
-BOOST_AUTO_TEST_SUITE(ProgramBasedMetricTest)
+BOOST_AUTO_TEST_SUITE(FitnessMetricTest)
+
+BOOST_FIXTURE_TEST_CASE(evaluateAll_should_return_the_same_values_regardless_of_thread_count, ProgramBasedMetricFixture)
+{
+	vector<Chromosome> chromosomes = {
+		m_chromosome,
+		Chromosome("sxu"),
+		Chromosome("fDnTOc"),
+		Chromosome(""),
+		Chromosome("uuuu"),
+		Chromosome("sxuL"),
+	};
+
+	ProgramSize metric(m_program, nullptr, m_weights);
+	vector<size_t> expectedValues;
+	for (auto const& chromosome: chromosomes)
+		expectedValues.push_back(metric.evaluate(chromosome));
+
+	ProgramSize cachedMetric(nullopt, m_programCache, m_weights);
+	cachedMetric.setThreadCount(4);
+	BOOST_TEST(cachedMetric.threadCount() == 4);
+	BOOST_TEST(cachedMetric.evaluateAll(chromosomes) == expectedValues);
+	BOOST_TEST(m_programCache->contains("sxuL"));
+
+	metric.setThreadCount(0);
+	BOOST_TEST(metric.threadCount() == 1);
+	BOOST_TEST(metric.evaluateAll(chromosomes) == expectedValues);
+}
+
+BOOST_AUTO_TEST_SUITE_END()BOOST_AUTO_TEST_SUITE(ProgramBasedMetricTest)
 
 BOOST_FIXTURE_TEST_CASE(optimisedProgram_should_return_optimised_program_even_if_cache_not_available, ProgramBasedMetricFixture)
 {
@@ -238,6 +268,56 @@ BOOST_FIXTURE_TEST_CASE(evaluate_should_multiply_the_result_by_scaling_factor, P
 	BOOST_TEST(RelativeProgramSize(m_program, nullptr, 4, m_weights).evaluate(m_chromosome) == round(10000.0 * sizeRatio));
 }
 
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE(ExecutionGasTest)
+
+BOOST_FIXTURE_TEST_CASE(evaluate_should_return_less_gas_for_the_optimised_program, ProgramBasedMetricFixture)
+{
+	CharStream sourceStream = CharStream(
+		"{\n"
+		"    let x := calldataload(0)\n"
+		"    let y := add(x, 0)\n"
+		"    let unused := mul(y, 2)\n"
+		"    sstore(0, y)\n"
+		"}\n",
+		""
+	);
+	Program program = get<Program>(Program::load(sourceStream));
+
+	size_t unoptimisedGas = ExecutionGas(program, nullptr, {bytes{}}, m_weights).evaluate(Chromosome(""));
+	size_t optimisedGas = ExecutionGas(program, nullptr, {bytes{}}, m_weights).evaluate(
+		Chromosome(vector<string>{ExpressionSimplifier::name, UnusedPruner::name})
+	);
+
+	BOOST_TEST(unoptimisedGas > 0);
+	BOOST_TEST(optimisedGas < unoptimisedGas);
+}
+
+BOOST_FIXTURE_TEST_CASE(evaluate_should_add_up_gas_of_all_executions, ProgramBasedMetricFixture)
+{
+	CharStream sourceStream = CharStream("{ if calldataload(0) { sstore(0, 1) } }", "");
+	Program program = get<Program>(Program::load(sourceStream));
+
+	bytes nonZeroCalldata(32, 0);
+	nonZeroCalldata[31] = 1;
+	size_t gasWithoutStore = ExecutionGas(program, nullptr, {bytes{}}, m_weights).evaluate(Chromosome(""));
+	size_t gasWithStore = ExecutionGas(program, nullptr, {nonZeroCalldata}, m_weights).evaluate(Chromosome(""));
+
+	BOOST_TEST(gasWithStore > gasWithoutStore);
+	BOOST_TEST(
+		ExecutionGas(program, nullptr, {bytes{}, nonZeroCalldata}, m_weights).evaluate(Chromosome("")) ==
+		gasWithoutStore + gasWithStore
+	);
+}
+
+BOOST_FIXTURE_TEST_CASE(evaluate_should_stop_infinite_loops, ProgramBasedMetricFixture)
+{
+	CharStream sourceStream = CharStream("{ for {} 1 {} { sstore(0, 1) } }", "");
+	Program program = get<Program>(Program::load(sourceStream));
+
+	BOOST_TEST(ExecutionGas(program, nullptr, {bytes{}}, m_weights, 1, 100).evaluate(Chromosome("")) > 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE(FitnessMetricCombinationTest)
 
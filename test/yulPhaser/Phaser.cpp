@@ -89,6 +89,8 @@ protected:
 		/* metricAggregator = */ MetricAggregatorChoice::Average,
 		/* relativeMetricScale = */ 5,
 		/* chromosomeRepetitions = */ 1,
+		/* calldata = */ {bytes{}},
+		/* threadCount = */ 1,
 	};
 	CodeWeights const m_weights{};
 };
@@ -237,6 +239,32 @@ BOOST_FIXTURE_TEST_CASE(build_should_set_relative_metric_scale, FitnessMetricFac
 	BOOST_TEST(relativeProgramSizeMetric->fixedPointPrecision() == m_options.relativeMetricScale);
 }
 
+BOOST_FIXTURE_TEST_CASE(build_should_set_thread_count, FitnessMetricFactoryFixture)
+{
+	m_options.threadCount = 3;
+	unique_ptr<FitnessMetric> metric = FitnessMetricFactory::build(m_options, {m_programs[0]}, {nullptr}, m_weights);
+	BOOST_REQUIRE(metric != nullptr);
+	BOOST_TEST(metric->threadCount() == 3);
+}
+
+BOOST_FIXTURE_TEST_CASE(build_should_pass_calldata_to_execution_gas_metric, FitnessMetricFactoryFixture)
+{
+	m_options.metric = MetricChoice::ExecutionGas;
+	m_options.metricAggregator = MetricAggregatorChoice::Average;
+	m_options.calldata = {bytes{}, bytes{0x12, 0x34}};
+	unique_ptr<FitnessMetric> metric = FitnessMetricFactory::build(m_options, {m_programs[0]}, {nullptr}, m_weights);
+	BOOST_REQUIRE(metric != nullptr);
+
+	auto averageMetric = dynamic_cast<FitnessMetricAverage*>(metric.get());
+	BOOST_REQUIRE(averageMetric != nullptr);
+	BOOST_REQUIRE(averageMetric->metrics().size() == 1);
+	BOOST_REQUIRE(averageMetric->metrics()[0] != nullptr);
+
+	auto executionGasMetric = dynamic_cast<ExecutionGas*>(averageMetric->metrics()[0].get());
+	BOOST_REQUIRE(executionGasMetric != nullptr);
+	BOOST_TEST(executionGasMetric->calldata() == m_options.calldata);
+}
+
 BOOST_FIXTURE_TEST_CASE(build_should_create_metric_for_each_input_program, FitnessMetricFactoryFixture)
 {
 	unique_ptr<FitnessMetric> metric = FitnessMetricFactory::build(
@@ -387,7 +415,7 @@ BOOST_AUTO_TEST_SUITE(ProgramCacheFactoryTest)
 
 BOOST_FIXTURE_TEST_CASE(build_should_create_cache_for_each_input_program_if_cache_enabled, FixtureWithPrograms)
 {
-	ProgramCacheFactory::Options options{/* programCacheEnabled = */ true};
+	ProgramCacheFactory::Options options{/* programCacheEnabled = */ true, /* maxTotalCodeSize = */ nullopt};
 	vector<shared_ptr<ProgramCache>> caches = ProgramCacheFactory::build(options, m_programs);
 	assert(m_programs.size() >= 2 && "There must be at least 2 programs for this test to be meaningful");
 
@@ -399,9 +427,22 @@ BOOST_FIXTURE_TEST_CASE(build_should_create_cache_for_each_input_program_if_cach
 	}
 }
 
+BOOST_FIXTURE_TEST_CASE(build_should_pass_size_limit_to_caches, FixtureWithPrograms)
+{
+	ProgramCacheFactory::Options options{/* programCacheEnabled = */ true, /* maxTotalCodeSize = */ 1000};
+	vector<shared_ptr<ProgramCache>> caches = ProgramCacheFactory::build(options, m_programs);
+	BOOST_TEST(caches.size() == m_programs.size());
+
+	for (auto const& cache: caches)
+	{
+		BOOST_REQUIRE(cache != nullptr);
+		BOOST_CHECK(cache->maxTotalCodeSize() == 1000);
+	}
+}
+
 BOOST_FIXTURE_TEST_CASE(build_should_return_nullptr_for_each_input_program_if_cache_disabled, FixtureWithPrograms)
 {
-	ProgramCacheFactory::Options options{/* programCacheEnabled = */ false};
+	ProgramCacheFactory::Options options{/* programCacheEnabled = */ false, /* maxTotalCodeSize = */ nullopt};
 	vector<shared_ptr<ProgramCache>> caches = ProgramCacheFactory::build(options, m_programs);
 	assert(m_programs.size() >= 2 && "There must be at least 2 programs for this test to be meaningful");
 
@@ -27,6 +27,7 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <limits>
 #include <string>
 #include <set>
 
@@ -76,9 +77,9 @@ BOOST_AUTO_TEST_SUITE(ProgramCacheTest)
 
 BOOST_AUTO_TEST_CASE(CacheStats_operator_plus_should_add_stats_together)
 {
-	CacheStats statsA{11, 12, 13, {{1, 14}, {2, 15}}};
-	CacheStats statsB{21, 22, 23, {{2, 24}, {3, 25}}};
-	CacheStats statsC{32, 34, 36, {{1, 14}, {2, 39}, {3, 25}}};
+	CacheStats statsA{11, 12, 13, {{1, 14}, {2, 15}}, 16};
+	CacheStats statsB{21, 22, 23, {{2, 24}, {3, 25}}, 26};
+	CacheStats statsC{32, 34, 36, {{1, 14}, {2, 39}, {3, 25}}, 42};
 
 	BOOST_CHECK(statsA + statsB == statsC);
 }
@@ -213,6 +214,50 @@ BOOST_FIXTURE_TEST_CASE(startRound_should_remove_entries_older_than_two_rounds,
 	BOOST_TEST(m_programCache.size() == 0);
 }
 
+BOOST_FIXTURE_TEST_CASE(startRound_should_not_remove_old_entries_if_there_is_a_size_limit, ProgramCacheFixture)
+{
+	ProgramCache programCache(m_program, numeric_limits<size_t>::max());
+
+	programCache.optimiseProgram("Iu");
+	programCache.startRound(1);
+	programCache.optimiseProgram("a");
+	programCache.startRound(2);
+	programCache.startRound(3);
+
+	BOOST_TEST(programCache.currentRound() == 3);
+	BOOST_TEST((cachedKeys(programCache) == set<string>{"I", "Iu", "a"}));
+	BOOST_TEST(programCache.gatherStats().evictions == 0);
+}
+
+BOOST_FIXTURE_TEST_CASE(optimiseProgram_should_evict_least_recently_used_entries_longest_first, ProgramCacheFixture)
+{
+	size_t sizeI = optimisedProgram(m_program, "I").codeSize(CacheStats::StorageWeights);
+	size_t sizeIu = optimisedProgram(m_program, "Iu").codeSize(CacheStats::StorageWeights);
+	size_t sizeL = optimisedProgram(m_program, "L").codeSize(CacheStats::StorageWeights);
+	size_t sizeLimit = sizeI + sizeIu + sizeL;
+	ProgramCache programCache(m_program, sizeLimit);
+
+	programCache.optimiseProgram("Iu");
+	programCache.optimiseProgram("L");
+	BOOST_REQUIRE((cachedKeys(programCache) == set<string>{"I", "Iu", "L"}));
+	BOOST_TEST(programCache.gatherStats().totalCodeSize == sizeLimit);
+	BOOST_TEST(programCache.gatherStats().evictions == 0);
+
+	// Makes "L" the least recently used entry.
+	programCache.optimiseProgram("Iu");
+	programCache.optimiseProgram("IuO");
+	CacheStats stats = programCache.gatherStats();
+	BOOST_TEST(stats.totalCodeSize <= sizeLimit);
+	BOOST_TEST(stats.evictions > 0);
+	BOOST_TEST(!programCache.contains("L"));
+	// Entries are never evicted before the longer sequences they are a prefix of.
+	if (programCache.contains("IuO"))
+		BOOST_TEST(programCache.contains("Iu"));
+	if (programCache.contains("Iu"))
+		BOOST_TEST(programCache.contains("I"));
+	BOOST_TEST(toString(programCache.optimiseProgram("IuO")) == toString(optimisedProgram(m_program, "IuO")));
+}
+
 BOOST_FIXTURE_TEST_CASE(gatherStats_should_return_cache_statistics, ProgramCacheFixture)
 {
 	size_t sizeI = optimisedProgram(m_program, "I").codeSize(CacheStats::StorageWeights);
@@ -224,12 +269,12 @@ BOOST_FIXTURE_TEST_CASE(gatherStats_should_return_cache_statistics, ProgramCache
 	m_programCache.optimiseProgram("L");
 	m_programCache.optimiseProgram("Iu");
 	BOOST_REQUIRE((cachedKeys(m_programCache) == set<string>{"L", "I", "Iu"}));
-	CacheStats expectedStats1{0, 3, sizeL + sizeI + sizeIu, {{0, 3}}};
+	CacheStats expectedStats1{0, 3, sizeL + sizeI + sizeIu, {{0, 3}}, 0};
 	BOOST_CHECK(m_programCache.gatherStats() == expectedStats1);
 
 	m_programCache.optimiseProgram("IuO");
 	BOOST_REQUIRE((cachedKeys(m_programCache) == set<string>{"L", "I", "Iu", "IuO"}));
-	CacheStats expectedStats2{2, 4, sizeL + sizeI + sizeIu + sizeIuO, {{0, 4}}};
+	CacheStats expectedStats2{2, 4, sizeL + sizeI + sizeIu + sizeIuO, {{0, 4}}, 0};
 	BOOST_CHECK(m_programCache.gatherStats() == expectedStats2);
 
 	m_programCache.startRound(1);
@@ -238,17 +283,17 @@ BOOST_FIXTURE_TEST_CASE(gatherStats_should_return_cache_statistics, ProgramCache
 
 	m_programCache.optimiseProgram("IuO");
 	BOOST_REQUIRE((cachedKeys(m_programCache) == set<string>{"L", "I", "Iu", "IuO"}));
-	CacheStats expectedStats3{5, 4, sizeL + sizeI + sizeIu + sizeIuO, {{0, 1}, {1, 3}}};
+	CacheStats expectedStats3{5, 4, sizeL + sizeI + sizeIu + sizeIuO, {{0, 1}, {1, 3}}, 0};
 	BOOST_CHECK(m_programCache.gatherStats() == expectedStats3);
 
 	m_programCache.startRound(2);
 	BOOST_REQUIRE((cachedKeys(m_programCache) == set<string>{"I", "Iu", "IuO"}));
-	CacheStats expectedStats4{5, 4, sizeI + sizeIu + sizeIuO, {{1, 3}}};
+	CacheStats expectedStats4{5, 4, sizeI + sizeIu + sizeIuO, {{1, 3}}, 0};
 	BOOST_CHECK(m_programCache.gatherStats() == expectedStats4);
 
 	m_programCache.optimiseProgram("LT");
 	BOOST_REQUIRE((cachedKeys(m_programCache) == set<string>{"L", "LT", "I", "Iu", "IuO"}));
-	CacheStats expectedStats5{5, 6, sizeL + sizeLT + sizeI + sizeIu + sizeIuO, {{1, 3}, {2, 2}}};
+	CacheStats expectedStats5{5, 6, sizeL + sizeLT + sizeI + sizeIu + sizeIuO, {{1, 3}, {2, 2}}, 0};
 	BOOST_CHECK(m_programCache.gatherStats() == expectedStats5);
 }
 
@@ -136,6 +136,38 @@ BOOST_AUTO_TEST_CASE(uniformInt_can_be_reset)
 	BOOST_TEST(samples3 != samples4);
 }
 
+BOOST_AUTO_TEST_CASE(restoreState_should_continue_the_sequence_from_the_saved_state)
+{
+	constexpr size_t numSamples = 10;
+
+	SimulationRNG::reset(1);
+	SimulationRNG::uniformInt(0, 1000);
+	string state = SimulationRNG::state();
+
+	vector<size_t> samples1;
+	for (uint32_t i = 0; i < numSamples; ++i)
+		samples1.push_back(SimulationRNG::uniformInt(0, 1000));
+
+	SimulationRNG::reset(2);
+	BOOST_TEST(SimulationRNG::restoreState(state));
+	vector<size_t> samples2;
+	for (uint32_t i = 0; i < numSamples; ++i)
+		samples2.push_back(SimulationRNG::uniformInt(0, 1000));
+
+	BOOST_TEST(samples1 == samples2);
+}
+
+BOOST_AUTO_TEST_CASE(restoreState_should_reject_invalid_state)
+{
+	SimulationRNG::reset(1);
+	string state = SimulationRNG::state();
+
+	BOOST_TEST(!SimulationRNG::restoreState(""));
+	BOOST_TEST(!SimulationRNG::restoreState("1 2 3"));
+	BOOST_TEST(!SimulationRNG::restoreState(state + " x"));
+	BOOST_TEST(SimulationRNG::state() == state);
+}
+
 BOOST_AUTO_TEST_CASE(binomialInt_should_produce_samples_with_right_expected_value_and_variance)
 {
 	SimulationRNG::reset(1);
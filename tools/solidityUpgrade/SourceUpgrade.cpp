@@ -322,12 +322,11 @@ void SourceUpgrade::runUpgrade()
 
 	while (recompile && !m_compiler->errors().empty())
 	{
-		for (auto& sourceCode: m_sourceCodes)
-		{
-			recompile = analyzeAndUpgrade(sourceCode);
-			if (recompile)
-				break;
-		}
+		// The changes found by one analysis are applied to all sources before compiling again.
+		recompile = false;
+		for (auto const& sourceCode: m_sourceCodes)
+			if (analyzeAndUpgrade(sourceCode))
+				recompile = true;
 
 		if (recompile)
 		{
@@ -346,37 +345,40 @@ bool SourceUpgrade::analyzeAndUpgrade(pair<string, string> const& _sourceCode)
 	if (verbose)
 		log() << "Analyzing and upgrading " << _sourceCode.first << "." << endl;
 
+	m_suite.reset();
 	if (m_compiler->state() >= CompilerStack::State::AnalysisPerformed)
 		m_suite.analyze(*m_compiler, m_compiler->ast(_sourceCode.first));
 
-	if (!m_suite.changes().empty())
+	vector<UpgradeChange const*> changes;
+	for (UpgradeChange const& change: m_suite.changes())
+		if (change.level() == UpgradeChange::Level::Safe || applyUnsafe)
+			changes.emplace_back(&change);
+
+	// The changes are applied from the end of the source to its start, so that the locations of
+	// the remaining ones stay valid. Changes overlapping one that was applied, or starting at the
+	// same position, are left for the next analysis.
+	stable_sort(changes.begin(), changes.end(), [](UpgradeChange const* _a, UpgradeChange const* _b) {
+		return _a->location().start > _b->location().start;
+	});
+	optional<int> appliedStart;
+	for (UpgradeChange const* change: changes)
 	{
-		auto& change = m_suite.changes().front();
+		if (appliedStart && (change->location().end > *appliedStart || change->location().start == *appliedStart))
+			continue;
 
 		if (verbose)
-			change.log(*m_compiler, true);
+			change->log(*m_compiler, true);
 
-		if (change.level() == UpgradeChange::Level::Safe)
-		{
-			applyChange(_sourceCode, change);
-			return true;
-		}
-		else if (change.level() == UpgradeChange::Level::Unsafe)
-		{
-			if (applyUnsafe)
-			{
-				applyChange(_sourceCode, change);
-				return true;
-			}
-		}
+		applyChange(_sourceCode, *change);
+		appliedStart = change->location().start;
 	}
 
-	return false;
+	return appliedStart.has_value();
 }
 
 void SourceUpgrade::applyChange(
 	pair<string, string> const& _sourceCode,
-	UpgradeChange& _change
+	UpgradeChange const& _change
 )
 {
 	bool dryRun = m_args.count(g_argDryRun);
@@ -388,7 +390,7 @@ void SourceUpgrade::applyChange(
 		log() << _change.patch();
 	}
 
-	m_sourceCodes[_sourceCode.first] = _change.apply(_sourceCode.second);
+	m_sourceCodes[_sourceCode.first] = _change.apply(m_sourceCodes[_sourceCode.first]);
 
 	if (!dryRun)
 		writeInputFile(_sourceCode.first, m_sourceCodes[_sourceCode.first]);
@@ -526,8 +528,8 @@ ReadCallback::Callback SourceUpgrade::fileReader()
 
 void SourceUpgrade::resetCompiler()
 {
-	m_compiler->reset();
-	m_compiler->setSources(m_sourceCodes);
+	// Keeps the analysis of the sources that were not changed, if the previous one succeeded.
+	m_compiler->updateSources(m_sourceCodes);
 	m_compiler->setParserErrorRecovery(true);
 }
 
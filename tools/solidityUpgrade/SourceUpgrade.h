@@ -119,13 +119,13 @@ private:
 	/// them if parsing was successful.
 	void tryCompile() const;
 	/// Analyses and upgrades the sources given. The upgrade happens in a loop,
-	/// applying one change at a time, which is run until no applicable changes
-	/// are found any more. Only one change is done at a time and all sources
-	/// are being compiled again after each change.
+	/// which is run until no applicable changes are found any more. All
+	/// non-overlapping changes found by one analysis are applied to all sources
+	/// at once, before the sources are compiled again.
 	void runUpgrade();
-	/// Runs upgrade analysis on source and applies upgrades changes to it.
-	/// Returns `true` if there're still changes that can be applied,
-	/// `false` otherwise.
+	/// Runs upgrade analysis on source and applies all non-overlapping upgrade
+	/// changes to it.
+	/// Returns `true` if any change was applied, `false` otherwise.
 	bool analyzeAndUpgrade(
 		std::pair<std::string, std::string> const& _sourceCode
 	);
@@ -135,7 +135,7 @@ private:
 	/// to its file.
 	void applyChange(
 		std::pair<std::string, std::string> const& _sourceCode,
-		UpgradeChange& _change
+		UpgradeChange const& _change
 	);
 
 	/// Prints all errors (excluding warnings) the compiler currently reported.
@@ -151,8 +151,8 @@ private:
 	/// Returns a file reader function that fills `m_sources`.
 	frontend::ReadCallback::Callback fileReader();
 
-	/// Resets the compiler stack and configures sources to compile.
-	/// Also enables error recovery.
+	/// Replaces the sources of the compiler stack, so that the analysis of the
+	/// unchanged ones is reused if possible. Also enables error recovery.
 	void resetCompiler();
 	/// Resets the compiler stack and configures sources to compile.
 	/// Also enables error recovery. Passes read callback to the compiler stack.
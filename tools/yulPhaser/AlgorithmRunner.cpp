@@ -19,24 +19,108 @@
 #include <tools/yulPhaser/AlgorithmRunner.h>
 
 #include <tools/yulPhaser/Exceptions.h>
+#include <tools/yulPhaser/SimulationRNG.h>
 
 #include <libsolutil/Assertions.h>
+#include <libsolutil/CommonIO.h>
 
 #include <cerrno>
+#include <cstdio>
 #include <cstring>
 #include <fstream>
 
 using namespace std;
 using namespace solidity::phaser;
+using namespace solidity::util;
+
+void Checkpoint::save(string const& _path) const
+{
+	// Writing to a temporary file first ensures that an interruption while saving does not
+	// destroy the previous checkpoint.
+	string temporaryPath = _path + ".tmp";
+	{
+		ofstream outputStream(temporaryPath, ios::out | ios::trunc);
+		assertThrow(
+			outputStream.is_open(),
+			FileOpenError,
+			"Could not open file '" + temporaryPath + "': " + strerror(errno)
+		);
+
+		outputStream << "round: " << round << endl;
+		outputStream << "rng: " << rngState << endl;
+		outputStream << "chromosomes:" << endl;
+		for (string const& chromosome: chromosomes)
+			outputStream << chromosome << endl;
+
+		assertThrow(
+			!outputStream.bad(),
+			FileWriteError,
+			"Error while writing to file '" + temporaryPath + "': " + strerror(errno)
+		);
+	}
+
+	assertThrow(
+		rename(temporaryPath.c_str(), _path.c_str()) == 0,
+		FileWriteError,
+		"Could not replace file '" + _path + "': " + strerror(errno)
+	);
+}
+
+Checkpoint Checkpoint::load(string const& _path)
+{
+	ifstream inputStream(_path);
+	assertThrow(inputStream.is_open(), FileOpenError, "Could not open file '" + _path + "': " + strerror(errno));
+
+	auto readValue = [&](string const& _prefix) {
+		string line;
+		getline(inputStream, line);
+		assertThrow(
+			!inputStream.fail() && line.substr(0, _prefix.size()) == _prefix,
+			InvalidCheckpoint,
+			"Invalid checkpoint file '" + _path + "': expected '" + _prefix + "'."
+		);
+		return line.substr(_prefix.size());
+	};
+
+	Checkpoint checkpoint;
+	string round = readValue("round: ");
+	assertThrow(
+		!round.empty() && round.find_first_not_of("0123456789") == string::npos,
+		InvalidCheckpoint,
+		"Invalid checkpoint file '" + _path + "': invalid round number."
+	);
+	checkpoint.round = static_cast<size_t>(stoull(round));
+	checkpoint.rngState = readValue("rng: ");
+	readValue("chromosomes:");
+
+	string line;
+	while (getline(inputStream, line))
+		if (!line.empty())
+			checkpoint.chromosomes.push_back(line);
+
+	assertThrow(!inputStream.bad(), FileReadError, "Error while reading from file '" + _path + "': " + strerror(errno));
+
+	return checkpoint;
+}
+
+bool Checkpoint::operator==(Checkpoint const& _other) const
+{
+	return round == _other.round && rngState == _other.rngState && chromosomes == _other.chromosomes;
+}
 
 void AlgorithmRunner::run(GeneticAlgorithm& _algorithm)
 {
 	populationAutosave();
+	checkpointSave(m_options.initialRound);
 	printInitialPopulation();
 	cacheClear();
 
 	clock_t totalTimeStart = clock();
-	for (size_t round = 0; !m_options.maxRounds.has_value() || round < m_options.maxRounds.value(); ++round)
+	for (
+		size_t round = m_options.initialRound;
+		!m_options.maxRounds.has_value() || round < m_options.maxRounds.value();
+		++round
+	)
 	{
 		clock_t roundTimeStart = clock();
 		cacheStartRound(round + 1);
@@ -47,6 +131,7 @@ void AlgorithmRunner::run(GeneticAlgorithm& _algorithm)
 		printRoundSummary(round, roundTimeStart, totalTimeStart);
 		printCacheStats();
 		populationAutosave();
+		checkpointSave(round + 1);
 	}
 }
 
@@ -116,7 +201,9 @@ void AlgorithmRunner::printCacheStats() const
 			m_outputStream << "Round " << round << ": " << count << " entries" << endl;
 		m_outputStream << "Total hits: " << totalStats.hits << endl;
 		m_outputStream << "Total misses: " << totalStats.misses << endl;
+		m_outputStream << "Hit rate: " << totalStats.hitRate() << "%" << endl;
 		m_outputStream << "Size of cached code: " << totalStats.totalCodeSize << endl;
+		m_outputStream << "Evicted entries: " << totalStats.evictions << endl;
 	}
 
 	if (disabledCacheCount == m_programCaches.size())
@@ -150,6 +237,18 @@ void AlgorithmRunner::populationAutosave() const
 	);
 }
 
+void AlgorithmRunner::checkpointSave(size_t _completedRounds) const
+{
+	if (!m_options.checkpointFile.has_value())
+		return;
+
+	vector<string> chromosomes;
+	for (auto& individual: m_population.individuals())
+		chromosomes.push_back(toString(individual.chromosome));
+
+	Checkpoint{_completedRounds, SimulationRNG::state(), move(chromosomes)}.save(m_options.checkpointFile.value());
+}
+
 void AlgorithmRunner::cacheClear()
 {
 	for (auto& cache: m_programCaches)
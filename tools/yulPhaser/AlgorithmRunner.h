@@ -29,10 +29,33 @@
 #include <ctime>
 #include <optional>
 #include <ostream>
+#include <string>
+#include <vector>
 
 namespace solidity::phaser
 {
 
+/**
+ * State of a run of @a AlgorithmRunner at the end of a round. Together with the same options
+ * and input programs it is enough to continue the run exactly as if it had not been interrupted:
+ * the fitness of the chromosomes is recomputed and the program cache, which does not affect
+ * the results, starts empty.
+ */
+struct Checkpoint
+{
+	/// Number of rounds completed so far.
+	size_t round;
+	/// State of @a SimulationRNG, as returned by @a SimulationRNG::state().
+	std::string rngState;
+	std::vector<std::string> chromosomes;
+
+	void save(std::string const& _path) const;
+	static Checkpoint load(std::string const& _path);
+
+	bool operator==(Checkpoint const& _other) const;
+	bool operator!=(Checkpoint const& _other) const { return !(*this == _other); }
+};
+
 /**
  * Manages a population and executes a genetic algorithm on it. It's independent of the
  * implementation details of a specific algorithm which is pluggable via @a GeneticAlgorithm class.
@@ -54,6 +77,10 @@ public:
 		bool showOnlyTopChromosome = false;
 		bool showRoundInfo = true;
 		bool showCacheStats = false;
+		std::optional<std::string> checkpointFile = std::nullopt;
+		/// Number of rounds already completed before the run, e.g. when resuming from a checkpoint.
+		/// Counts towards @a maxRounds.
+		size_t initialRound = 0;
 	};
 
 	AlgorithmRunner(
@@ -81,6 +108,7 @@ private:
 	void printInitialPopulation() const;
 	void printCacheStats() const;
 	void populationAutosave() const;
+	void checkpointSave(size_t _completedRounds) const;
 	void randomiseDuplicates();
 	void cacheClear();
 	void cacheStartRound(size_t _roundNumber);
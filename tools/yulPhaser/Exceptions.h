@@ -27,6 +27,7 @@ struct BadInput: virtual util::Exception {};
 struct InvalidProgram: virtual BadInput {};
 struct NoInputFiles: virtual BadInput {};
 struct MissingFile: virtual BadInput {};
+struct InvalidCheckpoint: virtual BadInput {};
 
 struct FileOpenError: virtual util::Exception {};
 struct FileReadError: virtual util::Exception {};
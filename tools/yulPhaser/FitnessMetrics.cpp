@@ -18,15 +18,26 @@
 
 #include <tools/yulPhaser/FitnessMetrics.h>
 
+#include <test/tools/yulInterpreter/Interpreter.h>
+
 #include <libsolutil/CommonIO.h>
+#include <libsolutil/ThreadPool.h>
 
 #include <cmath>
+#include <limits>
 
 using namespace std;
 using namespace solidity::util;
 using namespace solidity::yul;
 using namespace solidity::phaser;
 
+vector<size_t> FitnessMetric::evaluateAll(vector<Chromosome> const& _chromosomes)
+{
+	vector<size_t> values(_chromosomes.size());
+	parallelFor(_chromosomes.size(), m_threadCount, [&](size_t _i) { values[_i] = evaluate(_chromosomes[_i]); });
+	return values;
+}
+
 Program const& ProgramBasedMetric::program() const
 {
 	if (m_programCache == nullptr)
@@ -75,6 +86,29 @@ size_t RelativeProgramSize::evaluate(Chromosome const& _chromosome)
 	));
 }
 
+size_t ExecutionGas::evaluate(Chromosome const& _chromosome)
+{
+	Program optimisedProgram = this->optimisedProgram(_chromosome);
+
+	solidity::u256 totalGas = 0;
+	for (bytes const& calldata: m_calldata)
+	{
+		yul::test::InterpreterState state;
+		state.calldata = calldata;
+		state.maxSteps = m_maxSteps;
+		try
+		{
+			yul::test::Interpreter::run(state, optimisedProgram.dialect(), optimisedProgram.ast(), /*disableMemoryTracing=*/true);
+		}
+		catch (yul::test::InterpreterTerminatedGeneric const&)
+		{
+		}
+		totalGas += state.gasUsed;
+	}
+
+	return static_cast<size_t>(min(totalGas, solidity::u256(numeric_limits<size_t>::max())));
+}
+
 size_t FitnessMetricAverage::evaluate(Chromosome const& _chromosome)
 {
 	assert(m_metrics.size() > 0);
@@ -27,8 +27,12 @@
 
 #include <libyul/optimiser/Metrics.h>
 
+#include <libsolutil/Common.h>
+
+#include <algorithm>
 #include <cstddef>
 #include <optional>
+#include <vector>
 
 namespace solidity::phaser
 {
@@ -39,6 +43,10 @@ namespace solidity::phaser
  * The main feature is the @a evaluate() method that can tell how good a given chromosome is.
  * The lower the value, the better the fitness is. The result should be deterministic and depend
  * only on the chromosome and metric's state (which is constant).
+ *
+ * Implementations must allow @a evaluate() to be called from multiple threads at the same time
+ * so that whole batches of chromosomes can be evaluated concurrently. They must not use
+ * @a SimulationRNG because its state is per thread and the results would depend on scheduling.
  */
 class FitnessMetric
 {
@@ -49,6 +57,16 @@ public:
 	virtual ~FitnessMetric() = default;
 
 	virtual size_t evaluate(Chromosome const& _chromosome) = 0;
+
+	/// Evaluates all @a _chromosomes using up to @a threadCount() threads.
+	/// @returns the values in the same order as the chromosomes.
+	std::vector<size_t> evaluateAll(std::vector<Chromosome> const& _chromosomes);
+
+	size_t threadCount() const { return m_threadCount; }
+	void setThreadCount(size_t _threadCount) { m_threadCount = std::max<size_t>(_threadCount, 1); }
+
+private:
+	size_t m_threadCount = 1;
 };
 
 /**
@@ -132,6 +150,40 @@ private:
 	size_t m_fixedPointPrecision;
 };
 
+/**
+ * Fitness metric based on the gas used when executing a specific program, after applying the
+ * optimisations from the chromosome to it, once for each of the given calldata values.
+ *
+ * The programs are run in the Yul interpreter, which only estimates the gas costs:
+ * Memory expansion and refunds are not taken into account and stack operations other than
+ * pushing literals and variables are not counted. Executions that exceed @a _maxSteps
+ * statements or loop iterations are stopped and only the gas used until then is counted.
+ */
+class ExecutionGas: public ProgramBasedMetric
+{
+public:
+	explicit ExecutionGas(
+		std::optional<Program> _program,
+		std::shared_ptr<ProgramCache> _programCache,
+		std::vector<bytes> _calldata,
+		yul::CodeWeights const& _weights,
+		size_t _repetitionCount = 1,
+		size_t _maxSteps = 100000
+	):
+		ProgramBasedMetric(std::move(_program), std::move(_programCache), _weights, _repetitionCount),
+		m_calldata(std::move(_calldata)),
+		m_maxSteps(_maxSteps) {}
+
+	std::vector<bytes> const& calldata() const { return m_calldata; }
+	size_t maxSteps() const { return m_maxSteps; }
+
+	size_t evaluate(Chromosome const& _chromosome) override;
+
+private:
+	std::vector<bytes> m_calldata;
+	size_t m_maxSteps;
+};
+
 /**
  * Abstract base class for fitness metrics that compute their value based on values of multiple
  * other, nested metrics.
@@ -34,6 +34,7 @@
 #include <libsolutil/Assertions.h>
 #include <libsolutil/CommonData.h>
 #include <libsolutil/CommonIO.h>
+#include <libsolutil/ThreadPool.h>
 
 #include <iostream>
 
@@ -69,6 +70,7 @@ map<MetricChoice, string> MetricChoiceToStringMap =
 {
 	{MetricChoice::CodeSize, "code-size"},
 	{MetricChoice::RelativeCodeSize, "relative-code-size"},
+	{MetricChoice::ExecutionGas, "execution-gas"},
 };
 map<string, MetricChoice> const StringToMetricChoiceMap = invertMap(MetricChoiceToStringMap);
 
@@ -89,6 +91,20 @@ map<CrossoverChoice, string> const CrossoverChoiceToStringMap =
 };
 map<string, CrossoverChoice> const StringToCrossoverChoiceMap = invertMap(CrossoverChoiceToStringMap);
 
+vector<bytes> parseCalldata(vector<string> const& _hexValues)
+{
+	if (_hexValues.empty())
+		return {bytes{}};
+
+	vector<bytes> calldata;
+	for (string const& hexValue: _hexValues)
+	{
+		assertThrow(isValidHex(hexValue), BadInput, "Invalid calldata: " + hexValue + ". Expected a hex string starting with 0x.");
+		calldata.push_back(fromHex(hexValue));
+	}
+	return calldata;
+}
+
 }
 
 istream& phaser::operator>>(istream& _inputStream, PhaserMode& _phaserMode) { return deserializeChoice(_inputStream, _phaserMode, StringToPhaserModeMap); }
@@ -219,6 +235,14 @@ FitnessMetricFactory::Options FitnessMetricFactory::Options::fromCommandLine(po:
 		_arguments["metric-aggregator"].as<MetricAggregatorChoice>(),
 		_arguments["relative-metric-scale"].as<size_t>(),
 		_arguments["chromosome-repetitions"].as<size_t>(),
+		parseCalldata(
+			_arguments.count("calldata") > 0 ?
+				_arguments["calldata"].as<vector<string>>() :
+				vector<string>{}
+		),
+		_arguments["threads"].as<size_t>() > 0 ?
+			_arguments["threads"].as<size_t>() :
+			ThreadPool::hardwareConcurrency(),
 	};
 }
 
@@ -259,23 +283,43 @@ unique_ptr<FitnessMetric> FitnessMetricFactory::build(
 				));
 			break;
 		}
+		case MetricChoice::ExecutionGas:
+		{
+			for (size_t i = 0; i < _programs.size(); ++i)
+				metrics.push_back(make_unique<ExecutionGas>(
+					_programCaches[i] != nullptr ? optional<Program>{} : move(_programs[i]),
+					move(_programCaches[i]),
+					_options.calldata,
+					_weights,
+					_options.chromosomeRepetitions
+				));
+			break;
+		}
 		default:
 			assertThrow(false, solidity::util::Exception, "Invalid MetricChoice value.");
 	}
 
+	unique_ptr<FitnessMetric> metric;
 	switch (_options.metricAggregator)
 	{
 		case MetricAggregatorChoice::Average:
-			return make_unique<FitnessMetricAverage>(move(metrics));
+			metric = make_unique<FitnessMetricAverage>(move(metrics));
+			break;
 		case MetricAggregatorChoice::Sum:
-			return make_unique<FitnessMetricSum>(move(metrics));
+			metric = make_unique<FitnessMetricSum>(move(metrics));
+			break;
 		case MetricAggregatorChoice::Maximum:
-			return make_unique<FitnessMetricMaximum>(move(metrics));
+			metric = make_unique<FitnessMetricMaximum>(move(metrics));
+			break;
 		case MetricAggregatorChoice::Minimum:
-			return make_unique<FitnessMetricMinimum>(move(metrics));
+			metric = make_unique<FitnessMetricMinimum>(move(metrics));
+			break;
 		default:
 			assertThrow(false, solidity::util::Exception, "Invalid MetricAggregatorChoice value.");
 	}
+
+	metric->setThreadCount(_options.threadCount);
+	return metric;
 }
 
 PopulationFactory::Options PopulationFactory::Options::fromCommandLine(po::variables_map const& _arguments)
@@ -358,6 +402,9 @@ ProgramCacheFactory::Options ProgramCacheFactory::Options::fromCommandLine(po::v
 {
 	return {
 		_arguments["program-cache"].as<bool>(),
+		_arguments.count("program-cache-size-limit") > 0 ?
+			_arguments["program-cache-size-limit"].as<size_t>() :
+			optional<size_t>{},
 	};
 }
 
@@ -368,7 +415,11 @@ vector<shared_ptr<ProgramCache>> ProgramCacheFactory::build(
 {
 	vector<shared_ptr<ProgramCache>> programCaches;
 	for (Program& program: _programs)
-		programCaches.push_back(_options.programCacheEnabled ? make_shared<ProgramCache>(move(program)) : nullptr);
+		programCaches.push_back(
+			_options.programCacheEnabled ?
+			make_shared<ProgramCache>(move(program), _options.maxTotalCodeSize) :
+			nullptr
+		);
 
 	return programCaches;
 }
@@ -632,6 +683,14 @@ Phaser::CommandLineDescription Phaser::buildCommandLineDescription()
 			po::value<string>()->value_name("<FILE>"),
 			"If specified, the population is saved in the specified file after each round. (default=autosave disabled)"
 		)
+		(
+			"checkpoint",
+			po::value<string>()->value_name("<FILE>"),
+			"If specified, the state of the run (round number, population and random number generator state) "
+			"is saved in the specified file after each round. If the file already exists, the run is resumed "
+			"from it instead of building a new population and continues exactly as the interrupted run would have, "
+			"provided that the other options and the input files are the same. (default=checkpoints disabled)"
+		)
 	;
 	keywordDescription.add(populationDescription);
 
@@ -645,7 +704,8 @@ Phaser::CommandLineDescription Phaser::buildCommandLineDescription()
 				"\n"
 				"AVAILABLE METRICS:\n"
 				"* " + toString(MetricChoice::CodeSize) + "\n" +
-				"* " + toString(MetricChoice::RelativeCodeSize)
+				"* " + toString(MetricChoice::RelativeCodeSize) + "\n" +
+				"* " + toString(MetricChoice::ExecutionGas)
 			).c_str()
 		)
 		(
@@ -679,6 +739,22 @@ Phaser::CommandLineDescription Phaser::buildCommandLineDescription()
 			po::value<size_t>()->value_name("<COUNT>")->default_value(1),
 			"Number of times to repeat the sequence optimisation steps represented by a chromosome."
 		)
+		(
+			"calldata",
+			po::value<vector<string>>()->multitoken()->value_name("<HEX>"),
+			(
+				"Calldata the programs are executed with by the " + toString(MetricChoice::ExecutionGas) + " metric, "
+				"as a hex string starting with 0x. The programs are executed once for every value and the gas is added up. "
+				"(default=one execution with empty calldata)"
+			).c_str()
+		)
+		(
+			"threads",
+			po::value<size_t>()->value_name("<COUNT>")->default_value(1),
+			"Number of threads used to evaluate the fitness of chromosomes. "
+			"0 means one thread per available core. "
+			"The results do not depend on the number of threads but the cache statistics may."
+		)
 	;
 	keywordDescription.add(metricsDescription);
 
@@ -711,9 +787,16 @@ Phaser::CommandLineDescription Phaser::buildCommandLineDescription()
 			po::bool_switch(),
 			"Enables caching of intermediate programs corresponding to chromosome prefixes.\n"
 			"This speeds up fitness evaluation by a lot but eats tons of memory if the chromosomes are long. "
-			"Disabled by default since there's currently no way to set an upper limit on memory usage but "
+			"Disabled by default since the memory usage is only bounded if program-cache-size-limit is set but "
 			"highly recommended if your computer has enough RAM."
 		)
+		(
+			"program-cache-size-limit",
+			po::value<size_t>()->value_name("<SIZE>"),
+			"Upper limit on the total size of the programs cached for each input program, measured in AST nodes. "
+			"With a limit the cache is kept across rounds and the least recently used entries are evicted "
+			"when it gets too big. Without it the cache only keeps the entries used in the current and the previous round."
+		)
 	;
 	keywordDescription.add(cacheDescription);
 
@@ -801,6 +884,7 @@ AlgorithmRunner::Options Phaser::buildAlgorithmRunnerOptions(po::variables_map c
 		_arguments["show-only-top-chromosome"].as<bool>(),
 		!_arguments["hide-round"].as<bool>(),
 		_arguments["show-cache-stats"].as<bool>(),
+		_arguments.count("checkpoint") > 0 ? static_cast<optional<string>>(_arguments["checkpoint"].as<string>()) : nullopt,
 	};
 }
 
@@ -820,10 +904,29 @@ void Phaser::runPhaser(po::variables_map const& _arguments)
 		programCaches,
 		codeWeights
 	);
-	Population population = PopulationFactory::build(populationOptions, move(fitnessMetric));
+
+	optional<Checkpoint> checkpoint;
+	if (_arguments.count("checkpoint") > 0 && boost::filesystem::exists(_arguments["checkpoint"].as<string>()))
+		checkpoint = Checkpoint::load(_arguments["checkpoint"].as<string>());
+
+	Population population = (
+		checkpoint.has_value() ?
+		PopulationFactory::buildFromStrings(checkpoint->chromosomes, move(fitnessMetric)) :
+		PopulationFactory::build(populationOptions, move(fitnessMetric))
+	);
+	if (checkpoint.has_value())
+	{
+		// Restored only after building the population because the population options may use the generator.
+		assertThrow(
+			SimulationRNG::restoreState(checkpoint->rngState),
+			InvalidCheckpoint,
+			"Invalid random number generator state in checkpoint file '" + _arguments["checkpoint"].as<string>() + "'."
+		);
+		cout << "Resuming from checkpoint after round " << checkpoint->round << endl;
+	}
 
 	if (_arguments["mode"].as<PhaserMode>() == PhaserMode::RunAlgorithm)
-		runAlgorithm(_arguments, move(population), move(programCaches));
+		runAlgorithm(_arguments, move(population), move(programCaches), checkpoint.has_value() ? checkpoint->round : 0);
 	else
 		printOptimisedProgramsOrASTs(_arguments, population, move(programs), _arguments["mode"].as<PhaserMode>());
 }
@@ -831,7 +934,8 @@ void Phaser::runPhaser(po::variables_map const& _arguments)
 void Phaser::runAlgorithm(
 	po::variables_map const& _arguments,
 	Population _population,
-	vector<shared_ptr<ProgramCache>> _programCaches
+	vector<shared_ptr<ProgramCache>> _programCaches,
+	size_t _initialRound
 )
 {
 	auto algorithmOptions = GeneticAlgorithmFactory::Options::fromCommandLine(_arguments);
@@ -841,7 +945,10 @@ void Phaser::runAlgorithm(
 		_population.individuals().size()
 	);
 
-	AlgorithmRunner algorithmRunner(move(_population), move(_programCaches), buildAlgorithmRunnerOptions(_arguments), cout);
+	AlgorithmRunner::Options runnerOptions = buildAlgorithmRunnerOptions(_arguments);
+	runnerOptions.initialRound = _initialRound;
+
+	AlgorithmRunner algorithmRunner(move(_population), move(_programCaches), move(runnerOptions), cout);
 	algorithmRunner.run(*geneticAlgorithm);
 }
 
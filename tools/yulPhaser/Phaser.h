@@ -76,6 +76,7 @@ enum class MetricChoice
 {
 	CodeSize,
 	RelativeCodeSize,
+	ExecutionGas,
 };
 
 enum class MetricAggregatorChoice
@@ -158,6 +159,8 @@ public:
 		MetricAggregatorChoice metricAggregator;
 		size_t relativeMetricScale;
 		size_t chromosomeRepetitions;
+		std::vector<bytes> calldata;
+		size_t threadCount;
 
 		static Options fromCommandLine(boost::program_options::variables_map const& _arguments);
 	};
@@ -216,6 +219,7 @@ public:
 	struct Options
 	{
 		bool programCacheEnabled;
+		std::optional<size_t> maxTotalCodeSize;
 
 		static Options fromCommandLine(boost::program_options::variables_map const& _arguments);
 	};
@@ -272,7 +276,8 @@ private:
 	static void runAlgorithm(
 		boost::program_options::variables_map const& _arguments,
 		Population _population,
-		std::vector<std::shared_ptr<ProgramCache>> _programCaches
+		std::vector<std::shared_ptr<ProgramCache>> _programCaches,
+		size_t _initialRound
 	);
 	static void printOptimisedProgramsOrASTs(
 		boost::program_options::variables_map const& _arguments,
@@ -22,6 +22,8 @@
 
 #include <libyul/optimiser/Suite.h>
 
+#include <limits>
+
 using namespace std;
 using namespace solidity::yul;
 using namespace solidity::phaser;
@@ -37,6 +39,7 @@ CacheStats& CacheStats::operator+=(CacheStats const& _other)
 			roundEntryCounts.at(round) += count;
 		else
 			roundEntryCounts.insert({round, count});
+	evictions += _other.evictions;
 
 	return *this;
 }
@@ -47,7 +50,8 @@ bool CacheStats::operator==(CacheStats const& _other) const
 		hits == _other.hits &&
 		misses == _other.misses &&
 		totalCodeSize == _other.totalCodeSize &&
-		roundEntryCounts == _other.roundEntryCounts;
+		roundEntryCounts == _other.roundEntryCounts &&
+		evictions == _other.evictions;
 }
 
 Program ProgramCache::optimiseProgram(
@@ -59,6 +63,8 @@ Program ProgramCache::optimiseProgram(
 	for (size_t i = 1; i < _repetitionCount; ++i)
 		targetOptimisations += _abbreviatedOptimisationSteps;
 
+	unique_lock<mutex> lock(m_mutex);
+	++m_useCounter;
 	size_t prefixSize = 0;
 	for (size_t i = 1; i <= targetOptimisations.size(); ++i)
 	{
@@ -66,6 +72,7 @@ Program ProgramCache::optimiseProgram(
 		if (pair != m_entries.end())
 		{
 			pair->second.roundNumber = m_currentRound;
+			touch(pair);
 			++prefixSize;
 			++m_hits;
 		}
@@ -82,11 +89,15 @@ Program ProgramCache::optimiseProgram(
 	for (size_t i = prefixSize + 1; i <= targetOptimisations.size(); ++i)
 	{
 		string stepName = OptimiserSuite::stepAbbreviationToNameMap().at(targetOptimisations[i - 1]);
+		// The optimisation is the expensive part, other threads can use the cache in the meantime.
+		lock.unlock();
 		intermediateProgram.optimise({stepName});
+		lock.lock();
 
-		m_entries.insert({targetOptimisations.substr(0, i), {intermediateProgram, m_currentRound}});
+		insert(targetOptimisations.substr(0, i), intermediateProgram);
 		++m_misses;
 	}
+	evict();
 
 	return intermediateProgram;
 }
@@ -96,12 +107,16 @@ void ProgramCache::startRound(size_t _roundNumber)
 	assert(_roundNumber > m_currentRound);
 	m_currentRound = _roundNumber;
 
+	// With a size limit the entries are only removed when the cache gets too big.
+	if (m_maxTotalCodeSize.has_value())
+		return;
+
 	for (auto pair = m_entries.begin(); pair != m_entries.end();)
 	{
 		assert(pair->second.roundNumber < m_currentRound);
 
 		if (pair->second.roundNumber < m_currentRound - 1)
-			m_entries.erase(pair++);
+			erase(pair++);
 		else
 			++pair;
 	}
@@ -110,6 +125,8 @@ void ProgramCache::startRound(size_t _roundNumber)
 void ProgramCache::clear()
 {
 	m_entries.clear();
+	m_evictionOrder.clear();
+	m_totalCodeSize = 0;
 	m_currentRound = 0;
 }
 
@@ -127,18 +144,67 @@ CacheStats ProgramCache::gatherStats() const
 	return {
 		/* hits = */ m_hits,
 		/* misses = */ m_misses,
-		/* totalCodeSize = */ calculateTotalCachedCodeSize(),
+		/* totalCodeSize = */ m_totalCodeSize,
 		/* roundEntryCounts = */ countRoundEntries(),
+		/* evictions = */ m_evictions,
 	};
 }
 
-size_t ProgramCache::calculateTotalCachedCodeSize() const
+ProgramCache::EvictionKey ProgramCache::evictionKey(string const& _key, CacheEntry const& _entry)
+{
+	return {_entry.lastUse, numeric_limits<size_t>::max() - _key.size(), _key};
+}
+
+void ProgramCache::touch(map<string, CacheEntry>::iterator _entry)
+{
+	if (m_maxTotalCodeSize.has_value())
+		m_evictionOrder.erase(evictionKey(_entry->first, _entry->second));
+	_entry->second.lastUse = m_useCounter;
+	if (m_maxTotalCodeSize.has_value())
+		m_evictionOrder.insert(evictionKey(_entry->first, _entry->second));
+}
+
+void ProgramCache::insert(string _key, Program const& _program)
+{
+	auto [entry, inserted] = m_entries.try_emplace(
+		move(_key),
+		_program,
+		m_currentRound,
+		_program.codeSize(CacheStats::StorageWeights),
+		m_useCounter
+	);
+	if (!inserted)
+	{
+		// Another thread has optimised the same prefix in the meantime.
+		touch(entry);
+		return;
+	}
+
+	m_totalCodeSize += entry->second.codeSize;
+	if (m_maxTotalCodeSize.has_value())
+		m_evictionOrder.insert(evictionKey(entry->first, entry->second));
+}
+
+void ProgramCache::erase(map<string, CacheEntry>::iterator _entry)
 {
-	size_t size = 0;
-	for (auto const& pair: m_entries)
-		size += pair.second.program.codeSize(CacheStats::StorageWeights);
+	m_totalCodeSize -= _entry->second.codeSize;
+	if (m_maxTotalCodeSize.has_value())
+		m_evictionOrder.erase(evictionKey(_entry->first, _entry->second));
+	m_entries.erase(_entry);
+}
+
+void ProgramCache::evict()
+{
+	if (!m_maxTotalCodeSize.has_value())
+		return;
 
-	return size;
+	while (m_totalCodeSize > m_maxTotalCodeSize.value() && !m_evictionOrder.empty())
+	{
+		auto entry = m_entries.find(get<2>(*m_evictionOrder.begin()));
+		assert(entry != m_entries.end());
+		erase(entry);
+		++m_evictions;
+	}
 }
 
 map<size_t, size_t> ProgramCache::countRoundEntries() const
@@ -24,7 +24,11 @@
 
 #include <cstddef>
 #include <map>
+#include <mutex>
+#include <optional>
+#include <set>
 #include <string>
+#include <tuple>
 
 namespace solidity::phaser
 {
@@ -37,10 +41,16 @@ struct CacheEntry
 {
 	Program program;
 	size_t roundNumber;
+	/// Size of the program according to @a CacheStats::StorageWeights.
+	size_t codeSize;
+	/// Value of the use counter of the cache when the entry was last created or looked up.
+	size_t lastUse;
 
-	CacheEntry(Program _program, size_t _roundNumber):
+	CacheEntry(Program _program, size_t _roundNumber, size_t _codeSize = 0, size_t _lastUse = 0):
 		program(std::move(_program)),
-		roundNumber(_roundNumber) {}
+		roundNumber(_roundNumber),
+		codeSize(_codeSize),
+		lastUse(_lastUse) {}
 };
 
 /**
@@ -75,6 +85,10 @@ struct CacheStats
 	size_t misses;
 	size_t totalCodeSize;
 	std::map<size_t, size_t> roundEntryCounts;
+	size_t evictions;
+
+	/// @returns the percentage of optimisation steps that were found in the cache.
+	size_t hitRate() const { return hits + misses == 0 ? 0 : hits * 100 / (hits + misses); }
 
 	CacheStats& operator+=(CacheStats const& _other);
 	CacheStats operator+(CacheStats const& _other) const { return CacheStats(*this) += _other; }
@@ -89,25 +103,35 @@ struct CacheStats
  *
  * The cache keeps track of the current round number and associates newly created entries with it.
  * @a startRound() must be called at the beginning of a round so that entries that are too old
- * can be purged. The current strategy is to store programs corresponding to all possible prefixes
+ * can be purged. By default the cache stores programs corresponding to all possible prefixes
  * encountered in the current and the previous rounds. Entries older than that get removed to
  * conserve memory.
  *
+ * Alternatively the cache can be given an upper limit on the total size of the cached programs
+ * (measured with @a CacheStats::StorageWeights). Then the entries are kept across rounds and the
+ * least recently used ones are evicted whenever the limit is exceeded. An entry is never evicted
+ * before the entries for the longer sequences it is a prefix of, so that these stay reachable.
+ *
  * @a gatherStats() allows getting statistics useful for determining cache effectiveness.
  *
  * The current strategy does speed things up (about 4:1 hit:miss ratio observed in my limited
  * experiments) but there's room for improvement. We could fit more useful programs in
  * the cache by being more picky about which ones we choose.
  *
- * There is currently no way to purge entries without starting a new round. Since the programs
- * take a lot of memory, this may lead to the cache eating up all the available RAM if sequences are
- * long and programs large. A limiter based on entry count or total program size would be useful.
+ * @a optimiseProgram() can be called from multiple threads at the same time. The other member
+ * functions must not be called while it is running. Two threads missing the same prefix at
+ * the same time both optimise it, so the hit and miss counts may depend on scheduling.
+ *
+ * Without a size limit there is no way to purge entries without starting a new round. Since the
+ * programs take a lot of memory, this may lead to the cache eating up all the available RAM if
+ * sequences are long and programs large.
  */
 class ProgramCache
 {
 public:
-	explicit ProgramCache(Program _program):
-		m_program(std::move(_program)) {}
+	explicit ProgramCache(Program _program, std::optional<size_t> _maxTotalCodeSize = std::nullopt):
+		m_program(std::move(_program)),
+		m_maxTotalCodeSize(_maxTotalCodeSize) {}
 
 	Program optimiseProgram(
 		std::string const& _abbreviatedOptimisationSteps,
@@ -125,9 +149,19 @@ public:
 	std::map<std::string, CacheEntry> const& entries() const { return m_entries; }
 	Program const& program() const { return m_program; }
 	size_t currentRound() const { return m_currentRound; }
+	std::optional<size_t> maxTotalCodeSize() const { return m_maxTotalCodeSize; }
 
 private:
-	size_t calculateTotalCachedCodeSize() const;
+	/// Key of an entry in m_evictionOrder. Entries used less recently come first and among the
+	/// entries used at the same time the ones for longer sequences come first.
+	using EvictionKey = std::tuple<size_t, size_t, std::string>;
+	static EvictionKey evictionKey(std::string const& _key, CacheEntry const& _entry);
+
+	void touch(std::map<std::string, CacheEntry>::iterator _entry);
+	void insert(std::string _key, Program const& _program);
+	void erase(std::map<std::string, CacheEntry>::iterator _entry);
+	void evict();
+
 	std::map<size_t, size_t> countRoundEntries() const;
 
 	// The best matching data structure here would be a trie of chromosome prefixes but since
@@ -136,9 +170,17 @@ private:
 	std::map<std::string, CacheEntry> m_entries;
 
 	Program m_program;
+	std::optional<size_t> m_maxTotalCodeSize;
+	/// Entries ordered by the time of their last use. Only maintained if there is a size limit.
+	std::set<EvictionKey> m_evictionOrder;
+	size_t m_totalCodeSize = 0;
+	size_t m_useCounter = 0;
 	size_t m_currentRound = 0;
 	size_t m_hits = 0;
 	size_t m_misses = 0;
+	size_t m_evictions = 0;
+	/// Guards the entries and the counters in @a optimiseProgram().
+	std::mutex m_mutex;
 };
 
 }
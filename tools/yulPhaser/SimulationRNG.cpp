@@ -27,6 +27,7 @@
 
 #include <ctime>
 #include <limits>
+#include <sstream>
 
 using namespace std;
 using namespace solidity;
@@ -57,6 +58,25 @@ size_t SimulationRNG::binomialInt(size_t _numTrials, double _successProbability)
 	return static_cast<size_t>(distribution(s_generator));
 }
 
+string SimulationRNG::state()
+{
+	ostringstream output;
+	output << s_generator;
+	return output.str();
+}
+
+bool SimulationRNG::restoreState(string const& _state)
+{
+	boost::random::mt19937 generator;
+	istringstream input(_state);
+	input >> generator;
+	if (input.fail() || !(input >> ws).eof())
+		return false;
+
+	s_generator = generator;
+	return true;
+}
+
 uint32_t SimulationRNG::generateSeed()
 {
 	// This is not a secure way to seed the generator but it's good enough for simulation purposes.
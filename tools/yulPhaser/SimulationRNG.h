@@ -22,6 +22,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <string>
 
 namespace solidity::phaser
 {
@@ -48,6 +49,13 @@ public:
 	/// same results.
 	static void reset(uint32_t seed) { s_generator = boost::random::mt19937(seed); }
 
+	/// @returns the complete state of the generator as a single line of text.
+	static std::string state();
+	/// Puts the generator back into a state returned by @a state(), so that it continues with
+	/// the same sequence of numbers.
+	/// @returns false if @a _state is not a valid state. The generator is not modified then.
+	static bool restoreState(std::string const& _state);
+
 	/// Generates a seed that's different on each run of the program.
 	/// Does **not** use the generator and is not affected by @a reset().
 	static uint32_t generateSeed();